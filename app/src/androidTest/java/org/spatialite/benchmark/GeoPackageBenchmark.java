@@ -0,0 +1,100 @@
+package org.spatialite.benchmark;
+
+import android.database.Cursor;
+import android.util.Log;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.spatialite.database.SQLiteDatabase;
+
+import java.util.concurrent.TimeUnit;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+
+/**
+ * Timings of inserting 1M features into a GeoPackage: maintaining the
+ * rtree_&lt;t&gt;_&lt;c&gt; Spatial Index by the standard triggers, versus
+ * loading the table first and then bulk loading the index by
+ * gpkgRebuildSpatialIndex().
+ */
+@RunWith(AndroidJUnit4.class)
+public class GeoPackageBenchmark {
+
+    private static final String TAG = "SQLite";
+    private static final int FEATURES = 1000000;
+
+    private SQLiteDatabase mDatabase;
+
+    static {
+        System.loadLibrary("android_spatialite");
+    }
+
+    @Before
+    public void setUp() {
+        mDatabase = SQLiteDatabase.openOrCreateDatabase(":memory:", null);
+        assertNotNull(mDatabase);
+        mDatabase.execSQL("SELECT gpkgCreateBaseTables()");
+    }
+
+    @After
+    public void tearDown() {
+        mDatabase.close();
+    }
+
+    @LargeTest
+    @Test
+    public void runBenchmark() {
+        createTable("feats_triggers");
+        measure("SELECT gpkgAddSpatialIndex('feats_triggers', 'geom')");
+        long triggers = measure(insertFeatures("feats_triggers"));
+        Log.i(TAG, "GeoPackage insert " + FEATURES + " (triggers) " + triggers + "ms");
+
+        createTable("feats_bulk");
+        long bulk = measure(insertFeatures("feats_bulk"));
+        bulk += measure("SELECT gpkgAddSpatialIndex('feats_bulk', 'geom')");
+        bulk += measure("SELECT gpkgRebuildSpatialIndex('feats_bulk', 'geom')");
+        Log.i(TAG, "GeoPackage insert " + FEATURES + " (bulk loader) " + bulk + "ms");
+
+        assertEquals(count("rtree_feats_triggers_geom"), count("rtree_feats_bulk_geom"));
+        assertEquals(FEATURES, count("rtree_feats_bulk_geom"));
+    }
+
+    private void createTable(String table) {
+        mDatabase.execSQL("CREATE TABLE " + table + " (id INTEGER PRIMARY KEY, name TEXT)");
+        mDatabase.execSQL("SELECT gpkgAddGeometryColumn('" + table +
+            "', 'geom', 'POLYGON', 0, 0, 4326)");
+    }
+
+    private String insertFeatures(String table) {
+        return "INSERT INTO " + table + " (name, geom) " +
+            "WITH RECURSIVE c(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM c WHERE i < " +
+            (FEATURES - 1) + ") " +
+            "SELECT 'f' || i, AsGPB(BuildMbr(i % 1000 * 0.01, i / 1000 * 0.01, " +
+            "i % 1000 * 0.01 + 0.005, i / 1000 * 0.01 + 0.005, 4326)) FROM c";
+    }
+
+    private long measure(String sql) {
+        long start = System.nanoTime();
+        mDatabase.beginTransaction();
+        try {
+            mDatabase.execSQL(sql);
+            mDatabase.setTransactionSuccessful();
+        } finally {
+            mDatabase.endTransaction();
+        }
+        return TimeUnit.NANOSECONDS.toMillis(System.nanoTime() - start);
+    }
+
+    private int count(String table) {
+        try (Cursor c = mDatabase.rawQuery("SELECT Count(*) FROM " + table, new String[]{})) {
+            c.moveToFirst();
+            return c.getInt(0);
+        }
+    }
+}
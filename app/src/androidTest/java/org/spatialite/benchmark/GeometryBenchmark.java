@@ -0,0 +1,81 @@
+package org.spatialite.benchmark;
+
+import android.database.Cursor;
+import android.util.Log;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.spatialite.database.SQLiteDatabase;
+
+import java.util.concurrent.TimeUnit;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+
+/**
+ * Timings of the Delaunay based geometry functions (DelaunayTriangulation,
+ * VoronojDiagram and ConcaveHull) on random point clouds of growing size.
+ */
+@RunWith(AndroidJUnit4.class)
+public class GeometryBenchmark {
+
+    private static final String TAG = "SQLite";
+    private static final int[] SIZES = {10000, 100000, 1000000};
+
+    private SQLiteDatabase mDatabase;
+
+    static {
+        System.loadLibrary("android_spatialite");
+    }
+
+    @Before
+    public void setUp() {
+        mDatabase = SQLiteDatabase.openOrCreateDatabase(":memory:", null);
+        assertNotNull(mDatabase);
+        mDatabase.execSQL("SELECT InitSpatialMetaData(1)");
+    }
+
+    @After
+    public void tearDown() {
+        mDatabase.close();
+    }
+
+    @LargeTest
+    @Test
+    public void runBenchmark() {
+        for (int size : SIZES) {
+            createPoints(size);
+            measure("DelaunayTriangulation " + size,
+                "SELECT ST_NumGeometries(DelaunayTriangulation(geom)) FROM mp");
+            measure("VoronojDiagram " + size,
+                "SELECT ST_NumGeometries(VoronojDiagram(geom)) FROM mp");
+            measure("ConcaveHull " + size,
+                "SELECT ST_Area(ConcaveHull(geom)) FROM mp");
+        }
+    }
+
+    private void createPoints(int size) {
+        mDatabase.execSQL("DROP TABLE IF EXISTS mp");
+        mDatabase.execSQL("CREATE TABLE mp AS " +
+            "WITH RECURSIVE c(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM c WHERE i < " +
+            (size - 1) + ") " +
+            "SELECT ST_Collect(MakePoint(abs(random() % 10000000) / 100.0, " +
+            "abs(random() % 10000000) / 100.0)) AS geom FROM c");
+    }
+
+    private void measure(String source, String query) {
+        long start = System.nanoTime();
+        try (Cursor c = mDatabase.rawQuery(query, new String[]{})) {
+            assertEquals(1, c.getCount());
+            c.moveToFirst();
+            assertEquals(false, c.isNull(0));
+        }
+        long elapsedMS = TimeUnit.NANOSECONDS.toMillis(System.nanoTime() - start);
+        Log.i(TAG, source + " " + elapsedMS + "ms");
+    }
+}
@@ -0,0 +1,78 @@
+package org.spatialite.benchmark;
+
+import android.database.Cursor;
+import android.util.Log;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.spatialite.database.SQLiteDatabase;
+
+import java.util.concurrent.TimeUnit;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+
+/**
+ * Storage size and decode timings of the same polygons stored as plain
+ * SpatiaLite BLOBs, as CompressGeometry() BLOBs and as TWKB compressed
+ * BLOBs (CompressGeometry(geom, precision)).
+ */
+@RunWith(AndroidJUnit4.class)
+public class GeometryBlobBenchmark {
+
+    private static final String TAG = "SQLite";
+    private static final int FEATURES = 100000;
+    private static final int PRECISION = 6;
+
+    private SQLiteDatabase mDatabase;
+
+    static {
+        System.loadLibrary("android_spatialite");
+    }
+
+    @Before
+    public void setUp() {
+        mDatabase = SQLiteDatabase.openOrCreateDatabase(":memory:", null);
+        assertNotNull(mDatabase);
+        mDatabase.execSQL("CREATE TABLE feats (id INTEGER PRIMARY KEY, " +
+            "plain BLOB, compressed BLOB, twkb BLOB)");
+        mDatabase.execSQL("INSERT INTO feats (plain) " +
+            "WITH RECURSIVE c(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM c WHERE i < " +
+            (FEATURES - 1) + ") " +
+            "SELECT ST_Buffer(MakePoint(11 + i % 1000 * 0.01, 43 + i / 1000 * 0.01, 4326), " +
+            "0.004, 16) FROM c");
+        mDatabase.execSQL("UPDATE feats SET compressed = CompressGeometry(plain), " +
+            "twkb = CompressGeometry(plain, " + PRECISION + ")");
+    }
+
+    @After
+    public void tearDown() {
+        mDatabase.close();
+    }
+
+    @LargeTest
+    @Test
+    public void runBenchmark() {
+        for (String column : new String[]{"plain", "compressed", "twkb"}) {
+            long size = queryLong("SELECT Sum(Length(" + column + ")) FROM feats");
+            long start = System.nanoTime();
+            long points = queryLong("SELECT Sum(ST_NPoints(" + column + ")) FROM feats");
+            long elapsed = TimeUnit.NANOSECONDS.toMillis(System.nanoTime() - start);
+            Log.i(TAG, "Geometry BLOB (" + column + ") " + size + " bytes, decode " +
+                FEATURES + " " + elapsed + "ms");
+            assertEquals(queryLong("SELECT Sum(ST_NPoints(plain)) FROM feats"), points);
+        }
+    }
+
+    private long queryLong(String sql) {
+        try (Cursor c = mDatabase.rawQuery(sql, new String[]{})) {
+            c.moveToFirst();
+            return c.getLong(0);
+        }
+    }
+}
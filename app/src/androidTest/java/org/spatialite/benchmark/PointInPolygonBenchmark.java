@@ -0,0 +1,88 @@
+package org.spatialite.benchmark;
+
+import android.database.Cursor;
+import android.util.Log;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.spatialite.database.SQLiteDatabase;
+
+import java.util.concurrent.TimeUnit;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+
+/**
+ * GPS fixes per second tested against a single zone by ST_Contains,
+ * ST_Within, ST_Intersects, ST_Covers and ST_CoveredBy (the zone is
+ * held by the internal GEOS cache as a Prepared Geometry).
+ */
+@RunWith(AndroidJUnit4.class)
+public class PointInPolygonBenchmark {
+
+    private static final String TAG = "SQLite";
+    private static final int FIXES = 200000;
+    private static final String ZONE =
+        "ST_Buffer(MakePoint(11.5, 43.5, 4326), 0.4, 64)";
+
+    private SQLiteDatabase mDatabase;
+
+    static {
+        System.loadLibrary("android_spatialite");
+    }
+
+    @Before
+    public void setUp() {
+        mDatabase = SQLiteDatabase.openOrCreateDatabase(":memory:", null);
+        assertNotNull(mDatabase);
+        mDatabase.execSQL("CREATE TABLE zone (id INTEGER PRIMARY KEY, geom BLOB)");
+        mDatabase.execSQL("INSERT INTO zone (id, geom) VALUES (1, " + ZONE + ")");
+        mDatabase.execSQL("CREATE TABLE fixes (id INTEGER PRIMARY KEY, x DOUBLE, y DOUBLE)");
+        mDatabase.execSQL("INSERT INTO fixes (x, y) " +
+            "WITH RECURSIVE c(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM c WHERE i < " +
+            (FIXES - 1) + ") " +
+            "SELECT 11 + (i % 1000) * 0.001, 43 + (i / 1000) * 0.005 FROM c");
+    }
+
+    @After
+    public void tearDown() {
+        mDatabase.close();
+    }
+
+    @LargeTest
+    @Test
+    public void runBenchmark() {
+        String[] predicates = new String[]{
+            "ST_Contains(z.geom, MakePoint(f.x, f.y, 4326))",
+            "ST_Within(MakePoint(f.x, f.y, 4326), z.geom)",
+            "ST_Intersects(z.geom, MakePoint(f.x, f.y, 4326))",
+            "ST_Covers(z.geom, MakePoint(f.x, f.y, 4326))",
+            "ST_CoveredBy(MakePoint(f.x, f.y, 4326), z.geom)"
+        };
+        long expected = -1;
+        for (String predicate : predicates) {
+            long start = System.nanoTime();
+            long inside = queryLong("SELECT Sum(" + predicate + ") " +
+                "FROM zone AS z, fixes AS f WHERE z.id = 1");
+            long elapsed = TimeUnit.NANOSECONDS.toMillis(System.nanoTime() - start);
+            Log.i(TAG, "Point-in-Polygon " + predicate + " " + inside + "/" + FIXES +
+                " inside, " + (FIXES * 1000L / Math.max(elapsed, 1)) + " fixes/s");
+            if (expected < 0) {
+                expected = inside;
+            }
+            assertEquals(expected, inside);
+        }
+    }
+
+    private long queryLong(String sql) {
+        try (Cursor c = mDatabase.rawQuery(sql, new String[]{})) {
+            c.moveToFirst();
+            return c.getLong(0);
+        }
+    }
+}
@@ -0,0 +1,256 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/export.h>
+#include <geos/geom/Envelope.h>
+#include <geos/index/strtree/TemplateSTRtree.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace geos {
+namespace index {
+namespace strtree {
+
+/**
+ * \brief
+ * A read-only STR tree stored in a flat byte buffer.
+ *
+ * The buffer is produced by serialize() from a built TemplateSTRtree and
+ * holds the node envelopes and an integer id for each item. It contains
+ * no pointers, so it can be written to a file or a BLOB and queried later,
+ * in place, from a memory mapping or any other copy: opening it only
+ * checks the header, and a query reads the nodes it visits.
+ *
+ * Layout, in the byte order of the writer (a reader with another byte
+ * order rejects the buffer):
+ *
+ * - a 32 byte header: the magic `GSTR`, the format version, a byte order
+ *   mark, a reserved word, then the number of nodes and of items as
+ *   64 bit integers;
+ * - the nodes, 48 bytes each: the envelope as min x, max x, min y, max y
+ *   doubles, then two 64 bit integers, which are the index of the first
+ *   child and the number of children of a branch, or the item id and zero
+ *   for a leaf.
+ *
+ * The root is node 0, and children always follow their parent.
+ * The buffer needs no particular alignment.
+ */
+class GEOS_DLL FlatSTRtree {
+
+public:
+
+    using ItemId = std::uint64_t;
+
+    static constexpr std::size_t HEADER_SIZE = 32;
+    static constexpr std::size_t NODE_SIZE = 48;
+
+    /**
+     * Serializes a tree, building it first if needed.
+     *
+     * @param tree the tree to serialize; removed items are left out
+     * @param itemId a function returning the ItemId of an item of the tree
+     * @return the serialized tree
+     */
+    template<typename ItemType, typename IdFunction>
+    static std::vector<unsigned char>
+    serialize(TemplateSTRtreeImpl<ItemType, EnvelopeTraits>& tree, IdFunction&& itemId)
+    {
+        using TreeNode = typename TemplateSTRtreeImpl<ItemType, EnvelopeTraits>::Node;
+
+        // breadth first, so that the children of a node are contiguous
+        std::vector<const TreeNode*> order;
+        std::vector<Node> nodes;
+        const TreeNode* root = tree.getRoot();
+        if (root != nullptr && hasItems(*root)) {
+            order.push_back(root);
+        }
+        for (std::size_t i = 0; i < order.size(); i++) {
+            const TreeNode* treeNode = order[i];
+            const geom::Envelope& env = treeNode->getBounds();
+            Node node { env.getMinX(), env.getMaxX(), env.getMinY(), env.getMaxY(), 0, 0 };
+
+            if (treeNode->isLeaf()) {
+                node.first = itemId(treeNode->getItem());
+            }
+            else {
+                node.first = order.size();
+                for (const auto* child = treeNode->beginChildren(); child < treeNode->endChildren(); ++child) {
+                    if (hasItems(*child)) {
+                        order.push_back(child);
+                        node.count++;
+                    }
+                }
+            }
+            nodes.push_back(node);
+        }
+
+        std::vector<unsigned char> buf(HEADER_SIZE + NODE_SIZE * nodes.size());
+        writeHeader(buf.data(), nodes.size(), countItems(nodes));
+        if (!nodes.empty()) {
+            std::memcpy(buf.data() + HEADER_SIZE, nodes.data(), NODE_SIZE * nodes.size());
+        }
+        return buf;
+    }
+
+    /**
+     * Opens a serialized tree. The buffer is not copied, and must outlive
+     * the FlatSTRtree.
+     *
+     * @throws util::IllegalArgumentException if the buffer does not hold
+     *         a tree written by serialize() on a host of the same byte order
+     */
+    FlatSTRtree(const void* data, std::size_t size);
+
+    std::size_t getNumNodes() const {
+        return numNodes;
+    }
+
+    std::size_t getNumItems() const {
+        return numItems;
+    }
+
+    /// Returns the bounds of all the items, null for an empty tree.
+    geom::Envelope getBounds() const;
+
+    /**
+     * Visits the ids of the items whose envelope intersects `queryEnv`,
+     * in the order TemplateSTRtree::query() would visit the items.
+     *
+     * The visitor takes an ItemId. If it returns a value, false stops
+     * the query.
+     *
+     * @throws util::IllegalArgumentException if a corrupt node is reached
+     */
+    template<typename Visitor>
+    void query(const geom::Envelope& queryEnv, Visitor&& visitor) const {
+        if (numNodes == 0 || queryEnv.isNull()) {
+            return;
+        }
+
+        Node root = readNode(0);
+        if (root.intersects(queryEnv)) {
+            if (root.count == 0) {
+                visit(visitor, root.first);
+            }
+            else {
+                query(queryEnv, 0, root, 0, visitor);
+            }
+        }
+    }
+
+    /// Collects the ids of the items whose envelope intersects `queryEnv`.
+    void query(const geom::Envelope& queryEnv, std::vector<ItemId>& results) const;
+
+private:
+
+    struct Node {
+        double minX;
+        double maxX;
+        double minY;
+        double maxY;
+        std::uint64_t first;
+        std::uint64_t count;
+
+        bool intersects(const geom::Envelope& env) const {
+            return env.getMinX() <= maxX && env.getMaxX() >= minX &&
+                   env.getMinY() <= maxY && env.getMaxY() >= minY;
+        }
+    };
+
+    static_assert(sizeof(Node) == NODE_SIZE, "unexpected padding in FlatSTRtree::Node");
+
+    const unsigned char* data;
+    std::size_t numNodes;
+    std::size_t numItems;
+
+    Node readNode(std::size_t index) const {
+        Node node;
+        std::memcpy(&node, data + HEADER_SIZE + NODE_SIZE * index, NODE_SIZE);
+        return node;
+    }
+
+    // deeper than any tree of node capacity 2 or more
+    static constexpr std::size_t MAX_DEPTH = 64;
+
+    template<typename Visitor>
+    bool query(const geom::Envelope& queryEnv, std::size_t index, const Node& node,
+               std::size_t depth, Visitor&& visitor) const {
+        if (node.first <= index || node.first > numNodes || node.count > numNodes - node.first ||
+                depth >= MAX_DEPTH) {
+            throwCorrupt();
+        }
+
+        auto end = static_cast<std::size_t>(node.first + node.count);
+        for (auto i = static_cast<std::size_t>(node.first); i < end; i++) {
+            Node child = readNode(i);
+            if (!child.intersects(queryEnv)) {
+                continue;
+            }
+            if (child.count == 0) {
+                if (!visit(visitor, child.first)) {
+                    return false; // abort query
+                }
+            }
+            else if (!query(queryEnv, i, child, depth + 1, visitor)) {
+                return false; // abort query
+            }
+        }
+        return true; // continue searching
+    }
+
+    [[noreturn]] static void throwCorrupt();
+
+    static void writeHeader(unsigned char* buf, std::size_t numNodes, std::size_t numItems);
+
+    static std::size_t countItems(const std::vector<Node>& nodes) {
+        std::size_t n = 0;
+        for (const Node& node : nodes) {
+            n += node.count == 0;
+        }
+        return n;
+    }
+
+    template<typename TreeNode>
+    static bool hasItems(const TreeNode& node) {
+        if (node.isLeaf()) {
+            return !node.isDeleted();
+        }
+        for (const auto* child = node.beginChildren(); child < node.endChildren(); ++child) {
+            if (hasItems(*child)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<typename Visitor,
+             typename std::enable_if<std::is_void<decltype(std::declval<Visitor>()(std::declval<ItemId>()))>::value, std::nullptr_t>::type = nullptr>
+    static bool visit(Visitor&& visitor, ItemId id) {
+        visitor(id);
+        return true;
+    }
+
+    template<typename Visitor,
+             typename std::enable_if<!std::is_void<decltype(std::declval<Visitor>()(std::declval<ItemId>()))>::value, std::nullptr_t>::type = nullptr>
+    static bool visit(Visitor&& visitor, ItemId id) {
+        return visitor(id);
+    }
+};
+
+}
+}
+}
@@ -19,6 +19,7 @@
 #include <geos/operation/overlayng/OverlayEdge.h>
 #include <geos/operation/overlayng/OverlayLabel.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/util/Arena.h>
 
 #include <unordered_map>
 #include <vector>
@@ -56,12 +57,16 @@ class GEOS_DLL OverlayGraph {
 private:
 
     // Members
-    std::unordered_map<Coordinate, OverlayEdge*, geom::Coordinate::HashCode> nodeMap;
+    // Transient storage of the graph, freed as a whole
+    geos::util::Arena arena;
+    std::unordered_map<Coordinate, OverlayEdge*, geom::Coordinate::HashCode,
+        std::equal_to<Coordinate>,
+        geos::util::ArenaAllocator<std::pair<const Coordinate, OverlayEdge*>>> nodeMap;
     std::vector<OverlayEdge*> edges;
 
     // Locally store the OverlayEdge and OverlayLabel
-    std::deque<OverlayEdge> ovEdgeQue;
-    std::deque<OverlayLabel> ovLabelQue;
+    std::deque<OverlayEdge, geos::util::ArenaAllocator<OverlayEdge>> ovEdgeQue;
+    std::deque<OverlayLabel, geos::util::ArenaAllocator<OverlayLabel>> ovLabelQue;
 
     std::vector<std::unique_ptr<const geom::CoordinateSequence>> csQue;
 
@@ -101,6 +106,12 @@ public:
     */
     OverlayEdge* addEdge(Edge* edge);
 
+    /**
+    * Pre-allocates the storage for the given number of
+    * edges to be added by addEdge().
+    */
+    void reserve(std::size_t numEdges);
+
     /**
     * Gets the set of edges in this graph.
     * Only one of each symmetric pair of OverlayEdges is included.
@@ -127,6 +127,7 @@ private:
     const geom::GeometryFactory* geomFact;
     int opCode;
     noding::Noder* noder;
+    std::size_t numThreads;
     bool isStrictMode;
     bool isOptimized;
     bool isAreaResultOnly;
@@ -185,6 +186,7 @@ public:
         , geomFact(p_geomFact)
         , opCode(p_opCode)
         , noder(nullptr)
+        , numThreads(1)
         , isStrictMode(STRICT_MODE_DEFAULT)
         , isOptimized(true)
         , isAreaResultOnly(false)
@@ -204,6 +206,7 @@ public:
         , geomFact(geom0->getFactory())
         , opCode(p_opCode)
         , noder(nullptr)
+        , numThreads(1)
         , isStrictMode(STRICT_MODE_DEFAULT)
         , isOptimized(true)
         , isAreaResultOnly(false)
@@ -248,6 +251,18 @@ public:
     void setOutputResultEdges(bool p_isOutputResultEdges) { isOutputResultEdges = p_isOutputResultEdges; }
     void setNoder(noding::Noder* p_noder) { noder = p_noder; }
 
+    /**
+    * Sets the number of threads used to node the edges
+    * when no custom noder is set and the precision model is floating
+    * (see {@link noding::ParallelMCIndexNoder});
+    * 0 uses the number of hardware threads.
+    * Default is 1.
+    * The result does not depend on this setting.
+    *
+    * @param p_numThreads the number of threads
+    */
+    void setNumThreads(std::size_t p_numThreads) { numThreads = p_numThreads; }
+
     void setOutputNodedEdges(bool p_isOutputNodedEdges)
     {
         isOutputEdges = true;
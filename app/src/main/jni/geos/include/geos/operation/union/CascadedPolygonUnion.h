@@ -24,6 +24,8 @@
 
 #include <geos/operation/union/UnionStrategy.h>
 
+#include <cstddef>
+
 // Forward declarations
 namespace geos {
 namespace geom {
@@ -97,6 +99,11 @@ private:
  * many segments at each stage of processing.
  * The best case for buffer(0) is the trivial case where there is `no` overlap
  * between the input geometries. However, this case is likely rare in practice.
+ *
+ * The two halves of each section of the binary union are independent, so
+ * with setNumThreads() the upper levels of the recursion run their halves
+ * on separate threads. The unions computed are the same whatever the
+ * number of threads, and so is the result.
  */
 class GEOS_DLL CascadedPolygonUnion {
 private:
@@ -112,6 +119,12 @@ private:
      */
     static int const STRTREE_NODE_CAPACITY = 4;
 
+    /**
+     * Sections with fewer geometries are unioned on the current thread,
+     * as a new thread would cost more than it saves.
+     */
+    static std::size_t const MIN_PARALLEL_GEOMS = 16;
+
     /** \brief
      * Computes a [Geometry](@ref geom::Geometry) containing only polygonal components.
      *
@@ -147,17 +160,20 @@ public:
      * @param start start iterator
      * @param end end iterator
      * @param unionStrategy strategy to apply
+     * @param numThreads number of threads to use, see setNumThreads()
      */
     template <class T>
     static std::unique_ptr<geom::Geometry>
-    Union(T start, T end, UnionStrategy *unionStrategy)
+    Union(T start, T end, UnionStrategy *unionStrategy, std::size_t numThreads = 1)
     {
         std::vector<geom::Polygon*> polys;
         for(T i = start; i != end; ++i) {
             const geom::Polygon* p = dynamic_cast<const geom::Polygon*>(*i);
             polys.push_back(const_cast<geom::Polygon*>(p));
         }
-        return Union(&polys, unionStrategy);
+        CascadedPolygonUnion op(&polys, unionStrategy);
+        op.setNumThreads(numThreads);
+        return op.Union();
     }
 
     /** \brief
@@ -179,14 +195,27 @@ public:
         : inputPolys(polys)
         , geomFactory(nullptr)
         , unionFunction(&defaultUnionFunction)
+        , numThreads(1)
     {}
 
     CascadedPolygonUnion(std::vector<geom::Polygon*>* polys, UnionStrategy* unionFun)
         : inputPolys(polys)
         , geomFactory(nullptr)
         , unionFunction(unionFun)
+        , numThreads(1)
     {}
 
+    /**
+     * Sets the number of threads unioning the input; 0 uses the number
+     * of hardware threads. Default is 1.
+     * The result does not depend on this setting. With more than one
+     * thread the union strategy is called concurrently, on distinct
+     * geometries, and must support it.
+     *
+     * @param p_numThreads the number of threads
+     */
+    void setNumThreads(std::size_t p_numThreads);
+
     /** \brief
      * Computes the union of the input geometries.
      *
@@ -199,6 +228,7 @@ private:
 
     UnionStrategy* unionFunction;
     ClassicUnionStrategy defaultUnionFunction;
+    std::size_t numThreads;
 
     /**
      * Unions a section of a list using a recursive binary union on each half
@@ -211,6 +241,15 @@ private:
      */
     std::unique_ptr<geom::Geometry> binaryUnion(const std::vector<const geom::Geometry*> & geoms, std::size_t start, std::size_t end);
 
+    /**
+     * Unions a section of a list like binaryUnion(), using up to
+     * `nThreads` threads including the current one: the first half of
+     * the section goes to a new thread with half of them, while the
+     * current thread keeps the others for the second half.
+     */
+    std::unique_ptr<geom::Geometry> binaryUnionParallel(const std::vector<const geom::Geometry*> & geoms,
+                                                        std::size_t start, std::size_t end, std::size_t nThreads);
+
     /**
      * Computes the union of two geometries,
      * either of both of which may be null.
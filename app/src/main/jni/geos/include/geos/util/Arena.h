@@ -0,0 +1,171 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/export.h>
+
+#include <cstddef>
+
+namespace geos {
+namespace util { // geos::util
+
+/** \brief
+ * A monotonic memory arena.
+ *
+ * Memory is carved sequentially out of blocks obtained on demand, each
+ * twice as large as the previous one up to MAX_BLOCK_SIZE.
+ * Individual deallocations are no-ops: all the memory is returned at once
+ * by release() or by the destructor.
+ *
+ * This suits the transient containers of a single operation (graph nodes,
+ * map entries) which are all discarded together, replacing one heap
+ * allocation per element with a pointer bump.
+ * Objects placed in the arena must still be destroyed (normally by the
+ * container owning them) before the arena goes away.
+ *
+ * An Arena is not thread-safe.
+ */
+class GEOS_DLL Arena {
+
+public:
+
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 4096;
+    static constexpr std::size_t MAX_BLOCK_SIZE = 1024 * 1024;
+
+    explicit Arena(std::size_t initialBlockSize = DEFAULT_BLOCK_SIZE);
+
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * Returns storage for `bytes` bytes aligned to `alignment`
+     * (a power of two). The storage stays valid until release().
+     */
+    void*
+    allocate(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t offset = alignmentOffset(cur, alignment);
+        if (cur != nullptr && bytes + offset <= static_cast<std::size_t>(end - cur)) {
+            void* p = cur + offset;
+            cur += offset + bytes;
+            bytesAllocated += bytes;
+            return p;
+        }
+        return allocateSlow(bytes, alignment);
+    }
+
+    /**
+     * Frees all the blocks. Storage returned so far becomes invalid.
+     */
+    void release();
+
+    /// Number of blocks currently held
+    std::size_t getNumBlocks() const
+    {
+        return numBlocks;
+    }
+
+    /// Bytes handed out since construction or the last release()
+    std::size_t getBytesAllocated() const
+    {
+        return bytesAllocated;
+    }
+
+private:
+
+    struct Block {
+        Block* prev;
+    };
+
+    Block* head;
+    char* cur;
+    char* end;
+    std::size_t nextBlockSize;
+    std::size_t initialBlockSize;
+    std::size_t numBlocks;
+    std::size_t bytesAllocated;
+
+    static std::size_t
+    alignmentOffset(const char* p, std::size_t alignment)
+    {
+        std::size_t misalign = reinterpret_cast<std::size_t>(p) & (alignment - 1);
+        return misalign == 0 ? 0 : alignment - misalign;
+    }
+
+    void* allocateSlow(std::size_t bytes, std::size_t alignment);
+
+};
+
+/** \brief
+ * An STL allocator drawing from an Arena, for containers whose elements
+ * are all freed together with the arena.
+ */
+template<typename T>
+class ArenaAllocator {
+
+public:
+
+    typedef T value_type;
+
+    explicit ArenaAllocator(Arena& p_arena) noexcept
+        : arena(&p_arena)
+    {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : arena(other.getArena())
+    {}
+
+    T*
+    allocate(std::size_t n)
+    {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void
+    deallocate(T*, std::size_t) noexcept
+    {
+        // released with the arena
+    }
+
+    Arena*
+    getArena() const noexcept
+    {
+        return arena;
+    }
+
+private:
+
+    Arena* arena;
+
+};
+
+template<typename T, typename U>
+bool
+operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept
+{
+    return a.getArena() == b.getArena();
+}
+
+template<typename T, typename U>
+bool
+operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept
+{
+    return a.getArena() != b.getArena();
+}
+
+} // namespace geos::util
+} // namespace geos
+
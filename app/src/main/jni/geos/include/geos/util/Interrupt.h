@@ -15,12 +15,20 @@
 #pragma once
 
 #include <geos/export.h>
+#include <geos/util/GEOSException.h>
 
 namespace geos {
 namespace util { // geos::util
 
 #define GEOS_CHECK_FOR_INTERRUPTS() geos::util::Interrupt::process()
 
+/** \brief Thrown by Interrupt::interrupt() to abort an operation. */
+class GEOS_DLL InterruptedException: public GEOSException {
+public:
+    InterruptedException() :
+        GEOSException("InterruptedException", "Interrupted!") {}
+};
+
 /** \brief Used to manage interruption requests and callbacks. */
 class GEOS_DLL Interrupt {
 
@@ -160,6 +160,14 @@ typedef struct GEOSCoordSeq_t GEOSCoordSequence;
 */
 typedef struct GEOSSTRtree_t GEOSSTRtree;
 
+/**
+* Read-only view of a serialized STRtree index.
+* \see GEOSSTRtree_serialize()
+* \see GEOSSTRtree_view()
+* \see GEOSSTRtree_destroyView()
+*/
+typedef struct GEOSSTRtreeView_t GEOSSTRtreeView;
+
 /**
 * Parameter object for buffering.
 * \see GEOSBufferParams_create()
@@ -251,6 +259,14 @@ enum GEOSWKBFlavors {
 */
 typedef void (*GEOSQueryCallback)(void *item, void *userdata);
 
+/**
+* Callback function returning the id under which an item of a
+* \ref GEOSSTRtree is serialized.
+*
+* \see GEOSSTRtree_serialize
+*/
+typedef size_t (*GEOSSTRtreeItemIdCallback)(const void *item, void *userdata);
+
 /**
 * Callback function for use in spatial index nearest neighbor calculations.
 * Allows custom distance to be calculated between items in the
@@ -668,6 +684,14 @@ extern GEOSGeometry GEOS_DLL *GEOSBufferWithParams_r(
     const GEOSBufferParams* p,
     double width);
 
+/** \see GEOSBufferParallel */
+extern GEOSGeometry GEOS_DLL *GEOSBufferParallel_r(
+    GEOSContextHandle_t handle,
+    const GEOSGeometry* g,
+    const GEOSBufferParams* p,
+    double width,
+    unsigned int numThreads);
+
 /** \see GEOSBufferWithStyle */
 extern GEOSGeometry GEOS_DLL *GEOSBufferWithStyle_r(
     GEOSContextHandle_t handle,
@@ -939,6 +963,12 @@ extern GEOSGeometry GEOS_DLL *GEOSUnaryUnionPrec_r(
     const GEOSGeometry* g,
     double gridSize);
 
+/** \see GEOSUnaryUnionParallel */
+extern GEOSGeometry GEOS_DLL *GEOSUnaryUnionParallel_r(
+    GEOSContextHandle_t handle,
+    const GEOSGeometry* g,
+    unsigned int numThreads);
+
 /** \see GEOSDisjointSubsetUnion */
 extern GEOSGeometry GEOS_DLL *GEOSDisjointSubsetUnion_r(
     GEOSContextHandle_t handle,
@@ -1324,6 +1354,93 @@ extern void GEOS_DLL GEOSSTRtree_destroy_r(
     GEOSContextHandle_t handle,
     GEOSSTRtree *tree);
 
+/** \see GEOSSTRtree_serialize */
+extern unsigned char GEOS_DLL *GEOSSTRtree_serialize_r(
+    GEOSContextHandle_t handle,
+    GEOSSTRtree *tree,
+    GEOSSTRtreeItemIdCallback idfn,
+    void *userdata,
+    size_t *size);
+
+/** \see GEOSSTRtree_view */
+extern GEOSSTRtreeView GEOS_DLL *GEOSSTRtree_view_r(
+    GEOSContextHandle_t handle,
+    const unsigned char *data,
+    size_t size);
+
+/** \see GEOSSTRtree_queryView */
+extern int GEOS_DLL GEOSSTRtree_queryView_r(
+    GEOSContextHandle_t handle,
+    const GEOSSTRtreeView *view,
+    const GEOSGeometry *g,
+    GEOSQueryCallback callback,
+    void *userdata);
+
+/** \see GEOSSTRtree_destroyView */
+extern void GEOS_DLL GEOSSTRtree_destroyView_r(
+    GEOSContextHandle_t handle,
+    GEOSSTRtreeView *view);
+
+/* ========== Batch operations ========== */
+
+/**
+* Predicate evaluated by \ref GEOSBatchPreparedPredicate
+* and \ref GEOSRelatePredicateFast
+*/
+enum GEOSPreparedPredicates {
+    GEOS_PREP_CONTAINS = 1,
+    GEOS_PREP_CONTAINSPROPERLY = 2,
+    GEOS_PREP_COVEREDBY = 3,
+    GEOS_PREP_COVERS = 4,
+    GEOS_PREP_CROSSES = 5,
+    GEOS_PREP_DISJOINT = 6,
+    GEOS_PREP_INTERSECTS = 7,
+    GEOS_PREP_OVERLAPS = 8,
+    GEOS_PREP_TOUCHES = 9,
+    GEOS_PREP_WITHIN = 10
+};
+
+/** \see GEOSBatchBuffer */
+extern int GEOS_DLL GEOSBatchBuffer_r(
+    GEOSContextHandle_t handle,
+    const GEOSGeometry* const* geoms,
+    unsigned int ngeoms,
+    double width,
+    int quadsegs,
+    unsigned int numThreads,
+    GEOSGeometry** results,
+    char* status);
+
+/** \see GEOSBatchIntersection */
+extern int GEOS_DLL GEOSBatchIntersection_r(
+    GEOSContextHandle_t handle,
+    const GEOSGeometry* const* geomsA,
+    const GEOSGeometry* const* geomsB,
+    unsigned int ngeoms,
+    unsigned int numThreads,
+    GEOSGeometry** results,
+    char* status);
+
+/** \see GEOSBatchPreparedPredicate */
+extern int GEOS_DLL GEOSBatchPreparedPredicate_r(
+    GEOSContextHandle_t handle,
+    const GEOSPreparedGeometry* pg,
+    enum GEOSPreparedPredicates predicate,
+    const GEOSGeometry* const* geoms,
+    unsigned int ngeoms,
+    unsigned int numThreads,
+    char* results);
+
+/** \see GEOSBatchDistance */
+extern int GEOS_DLL GEOSBatchDistance_r(
+    GEOSContextHandle_t handle,
+    const GEOSGeometry* const* geomsA,
+    const GEOSGeometry* const* geomsB,
+    unsigned int ngeoms,
+    unsigned int numThreads,
+    double* distances,
+    char* status);
+
 
 /* ========= Unary predicate ========= */
 
@@ -1402,6 +1519,20 @@ extern char GEOS_DLL *GEOSRelateBoundaryNodeRule_r(
     const GEOSGeometry* g2,
     int bnr);
 
+/** \see GEOSRelatePatternFast */
+extern char GEOS_DLL GEOSRelatePatternFast_r(
+    GEOSContextHandle_t handle,
+    const GEOSGeometry* g1,
+    const GEOSGeometry* g2,
+    const char *pat);
+
+/** \see GEOSRelatePredicateFast */
+extern char GEOS_DLL GEOSRelatePredicateFast_r(
+    GEOSContextHandle_t handle,
+    const GEOSGeometry* g1,
+    const GEOSGeometry* g2,
+    enum GEOSPreparedPredicates predicate);
+
 /* ========= Validity checking ========= */
 
 /** Change behaviour of validity testing in \ref GEOSisValidDetail */
@@ -3548,6 +3679,26 @@ extern GEOSGeometry GEOS_DLL *GEOSUnaryUnionPrec(
     const GEOSGeometry* g,
     double gridSize);
 
+/**
+* Returns the union of all components of a single geometry, as
+* GEOSUnaryUnion() does, unioning the polygonal components on
+* several threads. The result is the same as that of GEOSUnaryUnion(),
+* whatever the number of threads.
+* Note that an interruption callback is also invoked from the worker
+* threads, as by any concurrent use of GEOS.
+* \param g The input geometry
+* \param numThreads The number of threads to use, 0 for all hardware threads
+* \return A newly allocated geometry of the union. NULL on exception.
+* Caller is responsible for freeing with GEOSGeom_destroy().
+* \see GEOSUnaryUnion
+* \see geos::operation::geounion::CascadedPolygonUnion
+*
+* \since 3.12
+*/
+extern GEOSGeometry GEOS_DLL *GEOSUnaryUnionParallel(
+    const GEOSGeometry* g,
+    unsigned int numThreads);
+
 /**
 * Optimized union algorithm for inputs that can be divided into subsets
 * that do not intersect. If there is only one such subset, performance
@@ -3722,6 +3873,30 @@ extern GEOSGeometry GEOS_DLL *GEOSBufferWithParams(
     const GEOSBufferParams* p,
     double width);
 
+/**
+* Generates a buffer like GEOSBufferWithParams(), buffering separately,
+* on several threads, the groups of parts of a multi-part geometry or
+* collection whose buffers cannot interact. The result covers the same
+* area as that of GEOSBufferWithParams(), but its polygons may come in
+* another order. It does not depend on the number of threads.
+* Note that an interruption callback is also invoked from the worker
+* threads, as by any concurrent use of GEOS.
+* \param g The geometry to buffer
+* \param p The parameters to apply to the buffer process
+* \param width The buffer distance
+* \param numThreads The number of threads to use, 0 for all hardware threads
+* \return The buffered geometry, or NULL on exception.
+* Caller is responsible for freeing with GEOSGeom_destroy().
+* \see geos::operation::buffer::ParallelBufferOp
+*
+* \since 3.12
+*/
+extern GEOSGeometry GEOS_DLL *GEOSBufferParallel(
+    const GEOSGeometry* g,
+    const GEOSBufferParams* p,
+    double width,
+    unsigned int numThreads);
+
 /**
 * Generate a buffer using the provided style parameters.
 * \param g The geometry to buffer
@@ -4848,6 +5023,40 @@ extern char GEOS_DLL *GEOSRelateBoundaryNodeRule(
     const GEOSGeometry* g2,
     int bnr);
 
+/**
+* Same as \ref GEOSRelatePattern, but the matrix is only computed as far
+* as needed to decide the pattern, which is much faster when the outcome
+* is known early.
+* Polygonal inputs are assumed to be valid.
+* \see geos::operation::relate::RelatePredicateOp
+* \param g1 First geometry in pair
+* \param g2 Second geometry in pair
+* \param pat DE9IM pattern to check
+* \return 1 on true, 0 on false, 2 on exception
+* \since 3.12
+*/
+extern char GEOS_DLL GEOSRelatePatternFast(
+    const GEOSGeometry* g1,
+    const GEOSGeometry* g2,
+    const char *pat);
+
+/**
+* Evaluate a named predicate between two geometries, stopping as soon as
+* its outcome is known.
+* The results are those of the predicate functions, such as
+* \ref GEOSContains, for valid polygonal inputs.
+* \see geos::operation::relate::RelatePredicateOp
+* \param g1 First geometry in pair
+* \param g2 Second geometry in pair
+* \param predicate The predicate to evaluate
+* \return 1 on true, 0 on false, 2 on exception
+* \since 3.12
+*/
+extern char GEOS_DLL GEOSRelatePredicateFast(
+    const GEOSGeometry* g1,
+    const GEOSGeometry* g2,
+    enum GEOSPreparedPredicates predicate);
+
 ///@}
 
 /* ========== Prepared Geometry Binary predicates ========== */
@@ -5276,6 +5485,191 @@ extern char GEOS_DLL GEOSSTRtree_remove(
 */
 extern void GEOS_DLL GEOSSTRtree_destroy(GEOSSTRtree *tree);
 
+/**
+* Serialize a \ref GEOSSTRtree to a flat byte buffer, building the tree
+* first if needed. The buffer holds the node envelopes and an id for each
+* item, and no pointers: it can be saved to a file or a BLOB and queried
+* later, in place, with \ref GEOSSTRtree_view.
+* The buffer is only readable on hosts with the same byte order.
+*
+* \param tree the \ref GEOSSTRtree to serialize
+* \param idfn function returning the id of an item. If NULL, the item
+*        pointer itself is converted to the id, as when integer ids are
+*        inserted cast to pointers.
+* \param userdata optional pointer to pass to `idfn`
+* \param[out] size the size of the buffer
+* \return the buffer, to be freed with GEOSFree(), or NULL on exception
+*
+* \since 3.12
+*/
+extern unsigned char GEOS_DLL *GEOSSTRtree_serialize(
+    GEOSSTRtree *tree,
+    GEOSSTRtreeItemIdCallback idfn,
+    void *userdata,
+    size_t *size);
+
+/**
+* Open a buffer produced by \ref GEOSSTRtree_serialize, for example a
+* memory mapped file or a BLOB. The buffer is neither copied nor read
+* beyond its header: it must stay valid until the view is destroyed.
+*
+* \param data the serialized tree
+* \param size the size of `data`
+* \return the view, to be freed with \ref GEOSSTRtree_destroyView,
+*         or NULL if `data` does not hold a serialized tree
+*
+* \since 3.12
+*/
+extern GEOSSTRtreeView GEOS_DLL *GEOSSTRtree_view(
+    const unsigned char *data,
+    size_t size);
+
+/**
+* Query a serialized tree for items intersecting the envelope of a
+* geometry. The callback is passed the id of each item, cast to a pointer.
+*
+* \param view the \ref GEOSSTRtreeView to search
+* \param g the geometry whose envelope is the query envelope
+* \param callback function called for each item found
+* \param userdata optional pointer to pass to `callback`
+* \return 1 on success, 0 if the view is corrupt or on exception
+*
+* \since 3.12
+*/
+extern int GEOS_DLL GEOSSTRtree_queryView(
+    const GEOSSTRtreeView *view,
+    const GEOSGeometry *g,
+    GEOSQueryCallback callback,
+    void *userdata);
+
+/**
+* Frees a \ref GEOSSTRtreeView. The buffer it was opened on is left
+* to the caller.
+*
+* \since 3.12
+*/
+extern void GEOS_DLL GEOSSTRtree_destroyView(GEOSSTRtreeView *view);
+
+///@}
+
+/* ========== Batch operations ========== */
+/** @name Batch operations
+* Apply one operation to arrays of geometries, spreading the items
+* over several threads. Each item is computed exactly as by the
+* corresponding single geometry function.
+*
+* The input geometries are only read, and the same geometry may appear
+* several times in the arrays. A failure of one item does not stop the
+* others: its status is set to 0 and the message of the first failed
+* item is passed to the error handler once the batch is done.
+* An interruption (see GEOS_interruptRequest()) aborts the whole batch.
+* Note that an interruption callback is also invoked from the worker
+* threads, as by any concurrent use of GEOS.
+*
+* The thread count `numThreads` may be 0 to use one thread per
+* hardware thread. It is capped at the number of items.
+*/
+///@{
+
+/**
+* Buffer every geometry of an array.
+* \param geoms The input geometries
+* \param ngeoms The number of input geometries
+* \param width The buffer distance
+* \param quadsegs The number of segments per quadrant, as for GEOSBuffer()
+* \param numThreads The number of threads to use, 0 for all hardware threads
+* \param[out] results Array of ngeoms buffered geometries, NULL for the
+*        failed items. Caller is responsible for freeing them with
+*        GEOSGeom_destroy().
+* \param[out] status Optional array of ngeoms flags, 1 for the items
+*        computed and 0 for the failed ones. May be NULL.
+* \return 1 if every item succeeded, 0 otherwise
+* \see GEOSBuffer
+*
+* \since 3.12
+*/
+extern int GEOS_DLL GEOSBatchBuffer(
+    const GEOSGeometry* const* geoms,
+    unsigned int ngeoms,
+    double width,
+    int quadsegs,
+    unsigned int numThreads,
+    GEOSGeometry** results,
+    char* status);
+
+/**
+* Intersect pairs of geometries: `results[i]` is the intersection
+* of `geomsA[i]` and `geomsB[i]`.
+* \param geomsA The first geometries of the pairs
+* \param geomsB The second geometries of the pairs
+* \param ngeoms The number of pairs
+* \param numThreads The number of threads to use, 0 for all hardware threads
+* \param[out] results Array of ngeoms intersections, NULL for the
+*        failed items. Caller is responsible for freeing them with
+*        GEOSGeom_destroy().
+* \param[out] status Optional array of ngeoms flags, 1 for the items
+*        computed and 0 for the failed ones. May be NULL.
+* \return 1 if every item succeeded, 0 otherwise
+* \see GEOSIntersection
+*
+* \since 3.12
+*/
+extern int GEOS_DLL GEOSBatchIntersection(
+    const GEOSGeometry* const* geomsA,
+    const GEOSGeometry* const* geomsB,
+    unsigned int ngeoms,
+    unsigned int numThreads,
+    GEOSGeometry** results,
+    char* status);
+
+/**
+* Test a prepared geometry against every geometry of an array.
+* Each extra thread prepares its own copy of the base geometry, as
+* the indexes of a \ref GEOSPreparedGeometry are built on first use.
+* \param pg The prepared geometry
+* \param predicate The predicate to evaluate
+* \param geoms The geometries to test
+* \param ngeoms The number of geometries to test
+* \param numThreads The number of threads to use, 0 for all hardware threads
+* \param[out] results Array of ngeoms predicate values, 1 on true,
+*        0 on false, 2 on exception
+* \return 1 if every item succeeded, 0 otherwise
+* \see GEOSPreparedContains and the other prepared predicates
+*
+* \since 3.12
+*/
+extern int GEOS_DLL GEOSBatchPreparedPredicate(
+    const GEOSPreparedGeometry* pg,
+    enum GEOSPreparedPredicates predicate,
+    const GEOSGeometry* const* geoms,
+    unsigned int ngeoms,
+    unsigned int numThreads,
+    char* results);
+
+/**
+* Compute the distance between pairs of geometries: `distances[i]`
+* is the distance between `geomsA[i]` and `geomsB[i]`.
+* \param geomsA The first geometries of the pairs
+* \param geomsB The second geometries of the pairs
+* \param ngeoms The number of pairs
+* \param numThreads The number of threads to use, 0 for all hardware threads
+* \param[out] distances Array of ngeoms distances, left unchanged
+*        for the failed items
+* \param[out] status Optional array of ngeoms flags, 1 for the items
+*        computed and 0 for the failed ones. May be NULL.
+* \return 1 if every item succeeded, 0 otherwise
+* \see GEOSDistance
+*
+* \since 3.12
+*/
+extern int GEOS_DLL GEOSBatchDistance(
+    const GEOSGeometry* const* geomsA,
+    const GEOSGeometry* const* geomsB,
+    unsigned int ngeoms,
+    unsigned int numThreads,
+    double* distances,
+    char* status);
+
 ///@}
 
 /* ========== Algorithms ====================================================== */
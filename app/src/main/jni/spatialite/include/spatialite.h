@@ -981,10 +981,14 @@ extern "C"
  \param name_col column to be used for KML "name" (may be null)
  \param desc_col column to be used for KML "description" (may be null)
  \param precision number of decimal digits for coordinates
+ (a negative value selects the shortest round-trip representation)
  \param rows on completion will contain the total number of exported rows
  
  \sa dump_kml
 
+ \note the output file will be gzip-compressed if \e kml_path ends
+ with ".gz".
+
  \return 0 on failure, any other value on success
  */
     SPATIALITE_DECLARE int dump_kml_ex (sqlite3 * sqlite, char *table,
@@ -1236,6 +1240,7 @@ extern "C"
  \param geom_col the name of the geometry column
  \param outfile_path pathname for the GeoJSON file to be written to
  \param precision number of decimal digits for coordinates
+ (a negative value selects the shortest round-trip representation)
  \param lon_lat TRUE if all coordinates are expressed as WGS84 longitudes
   and latitudes (as required by RFC 7946); FALSE if they are in some
   other (undefined) CRS
@@ -1254,6 +1259,9 @@ extern "C"
 
  \return 0 on failure, any other value on success
  
+ \note the output file will be gzip-compressed if \e outfile_path ends
+ with ".gz".
+ 
  \note you are expected to free before or later an eventual error
  message by calling sqlite3_free()
  */
@@ -1857,6 +1865,99 @@ extern "C"
 						       int *n_failures,
 						       char **err_msg);
 
+/**
+ Checks a whole table for validity (parallel mode)
+
+ \param p_cache a memory pointer returned by spatialite_alloc_connection()
+ \param sqlite handle to current DB connection
+ \param table name of the table 
+ \param geom name of the column to be checked
+ \param report_table name of the Report table to be created
+ \param threads number of worker threads (zero or negative: as many
+ threads as the available CPU cores)
+ \param n_rows if this variable is not NULL on successful completion will
+ contain the total number of not-NULL Geometries found into the checked table
+ \param n_invalids if this variable is not NULL on successful completion will
+ contain the total number of invalid Geometries found into the checked table
+ \param err_msg if this variable is not NULL and the return status is ZERO
+ (failure), an appropriate error message will be returned
+
+ \sa check_geometry_column_r, sanitize_geometry_table_r
+
+ \note this function will check a Geometry Column for validity, splitting
+ the work across several threads each one owning a private connection cache.
+ \n the Report table will be created into the MAIN database and will
+ contain a row for each invalid Geometry: origin_rowid, valid, reason
+ (as in IsValidReason) and location (as in IsValidDetail).
+ \n an eventual error message returned via err_msg requires to be deallocated
+ by invoking free()\n
+ reentrant and thread-safe.
+
+ \return 0 on failure, any other value on success
+ */
+    SPATIALITE_DECLARE int check_geometry_table_r (const void *p_cache,
+						   sqlite3 * sqlite,
+						   const char *table,
+						   const char *geom,
+						   const char *report_table,
+						   int threads, int *n_rows,
+						   int *n_invalids,
+						   char **err_msg);
+
+/**
+ Repairs all invalid geometries of a whole table (parallel mode)
+
+ \param p_cache a memory pointer returned by spatialite_alloc_connection()
+ \param sqlite handle to current DB connection
+ \param table name of the table 
+ \param geom name of the column to be sanitized
+ \param report_table name of the Report table to be created
+ \param method the MakeValid method: "LINEWORK" (RTTOPO), "STRUCTURE"
+ or "STRUCTURE_KEEP_COLLAPSED" (GEOS 3.10.0 or later); NULL for default
+ \param fix_in_place if TRUE all repaired Geometries will be written back
+ into the input table
+ \param threads number of worker threads (zero or negative: as many
+ threads as the available CPU cores)
+ \param n_invalids if this variable is not NULL on successful completion will
+ contain the total number of invalid Geometries found into the input table
+ \param n_repaired if this variable is not NULL on successful completion will
+ contain the total number of repaired Geometries
+ \param n_failures if this variable is not NULL on successful completion will
+ contain the total number of repair failures
+ \param err_msg if this variable is not NULL and the return status is ZERO
+ (failure), an appropriate error message will be returned
+
+ \sa sanitize_geometry_column_r, check_geometry_table_r
+
+ \note this function will attempt to make valid all invalid geometries
+ found within a Geometry Column, splitting the work across several threads
+ each one owning a private connection cache.
+ \n the Report table will be created into the MAIN database and will
+ contain a row for each invalid Geometry: origin_rowid, valid, reason,
+ location, repaired (the valid Geometry, or NULL) and updated.
+ \n when fix_in_place is set any repaired Geometry not fitting the
+ declared type of the Geometry Column will not be written back and
+ will be counted as a repair failure.
+ \n an eventual error message returned via err_msg requires to be deallocated
+ by invoking free()\n
+ reentrant and thread-safe.
+
+ \return 0 on failure, any other value on success
+ */
+    SPATIALITE_DECLARE int sanitize_geometry_table_r (const void *p_cache,
+						      sqlite3 * sqlite,
+						      const char *table,
+						      const char *geom,
+						      const char
+						      *report_table,
+						      const char *method,
+						      int fix_in_place,
+						      int threads,
+						      int *n_invalids,
+						      int *n_repaired,
+						      int *n_failures,
+						      char **err_msg);
+
 /**
  Sanitizes all Geometry Columns making all invalid geometries to be valid
 
@@ -1975,6 +2076,55 @@ extern "C"
 				       int transaction, int ram_tmp_store,
 				       char **message);
 
+/**
+  Will precisely cut the input dataset against polygonal blade(s)
+  using several parallel threads
+
+ \param db_handle handle to the current SQLite connection
+ \param cache a memory pointer returned by spatialite_alloc_connection()
+ \param in_db_prefix prefix of the database where the input table
+ is expected to be found. if NULL then "MAIN" will be assumed.
+ \param input_table name of the input table to be processed.
+ \param input_geometry name of the input table Geometry column.
+ \param blade_db_prefix prefix of the database where the "blade" table
+ is expected to be found. if NULL then "MAIN" will be assumed.
+ \param blade_table name of the table expected to contain Polygons
+ or MultiPolygon Geometries acting as blades.
+ \param blade_geometry name of the "blade" table Geometry column.
+ \param output_table name to assinged to the destination table intended
+ to permanently store all results. this table must non exists.
+ \param transaction boolean; if set to TRUE will internally handle
+ a SQL Transaction.
+ \param ram_tmp_store boolean: if set to TRUE all TEMPORARY tables
+ and indices will be created in RAM, otherwise in a file.
+ \param threads max number of concurrent threads; zero or any negative
+ value will select the number of available CPU cores.
+ \param message pointer to a string buffer; if not NULL it will point
+ on completion an eventual error message.
+ 
+ \return 0 on failure, any other value on success
+ 
+ \sa gaiaCutter
+
+ \note same as gaiaCutter(), but all Blades will be loaded in memory
+ and Input Polygons will be cut by several threads, each one using its
+ own GEOS context. the Output table will be exactly the same produced
+ by gaiaCutter(). Input Points and Linestrings, as well as Input tables
+ lacking a Primary Key, will be always processed in serial mode.
+ */
+    SPATIALITE_DECLARE int gaiaCutterParallel (sqlite3 * db_handle,
+					       const void *cache,
+					       const char *in_db_prefix,
+					       const char *input_table,
+					       const char *input_geom,
+					       const char *blade_db_prefix,
+					       const char *blade_table,
+					       const char *blade_geom,
+					       const char *output_table,
+					       int transaction,
+					       int ram_tmp_store, int threads,
+					       char **message);
+
 /**
   Will attempt to create the Routing Nodes columns for a spatial table
   
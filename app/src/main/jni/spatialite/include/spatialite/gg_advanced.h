@@ -4323,6 +4323,60 @@ extern "C"
 
 #endif				/* end GEOS_3110 features */
 
+#ifndef DOXYGEN_SHOULD_IGNORE_THIS
+#ifdef GEOS_3120
+#endif
+
+/** point-in-polygon predicate: Intersects */
+#define GAIA_PREPARED_INTERSECTS	1
+/** point-in-polygon predicate: Contains */
+#define GAIA_PREPARED_CONTAINS		2
+/** point-in-polygon predicate: Within */
+#define GAIA_PREPARED_WITHIN		3
+/** point-in-polygon predicate: Covers */
+#define GAIA_PREPARED_COVERS		4
+/** point-in-polygon predicate: CoveredBy */
+#define GAIA_PREPARED_COVEREDBY		5
+
+/**
+ Point-in-Polygon fast path for Prepared spatial predicates
+
+ \param p_cache a memory pointer returned by spatialite_alloc_connection()
+ \param blob1 the BLOB corresponding to the first Geometry
+ \param size1 the size (in bytes) of the first BLOB
+ \param blob2 the BLOB corresponding to the second Geometry
+ \param size2 the size (in bytes) of the second BLOB
+ \param predicate one of GAIA_PREPARED_INTERSECTS, GAIA_PREPARED_CONTAINS,
+ GAIA_PREPARED_WITHIN, GAIA_PREPARED_COVERS or GAIA_PREPARED_COVEREDBY
+ \param result on success will point to the predicate result (1 TRUE,
+ 0 FALSE, -1 on error)
+
+ \return 1 if the fast path was applied, 0 otherwise.
+
+ \sa gaiaGeomCollPreparedContains, gaiaGeomCollPreparedWithin,
+ gaiaGeomCollPreparedIntersects, gaiaGeomCollPreparedCovers,
+ gaiaGeomCollPreparedCoveredBy
+
+ \note the fast path only applies when one of the BLOBs is a POINT (or
+ TinyPoint) and the other one is already held by the internal GEOS cache
+ as a Prepared Geometry; X and Y are directly read from the POINT BLOB
+ and no Geometry is ever built.
+ \n when 0 is returned the caller is expected to evaluate the predicate
+ the usual way (e.g. by calling gaiaGeomCollPreparedContains).
+ \n reentrant and thread-safe.
+
+ \remark \b GEOS_3120 support required.
+ */
+    GAIAGEO_DECLARE int gaiaGeomCollPreparedPointXY (const void *p_cache,
+						     const unsigned char
+						     *blob1, int size1,
+						     const unsigned char
+						     *blob2, int size2,
+						     int predicate,
+						     int *result);
+
+#endif				/* end GEOS_3120 features */
+
 #ifndef DOXYGEN_SHOULD_IGNORE_THIS
 #ifdef GEOS_TRUNK
 #endif
@@ -229,6 +229,11 @@ extern "C"
 /** BLOB-Geometry CLASS: compressed POLYGON ZM */
 #define GAIA_COMPRESSED_POLYGONZM		1003003
 
+/* constant that defines TWKB compressed GEOMETRY CLASSes */
+/** BLOB-Geometry CLASS: TWKB compressed; the actual CLASS is
+ GAIA_TWKB_BLOB + the Geometry CLASS (e.g. 2003006 for a MULTIPOLYGON ZM) */
+#define GAIA_TWKB_BLOB				2000000
+
 /* constants that defines GEOS-WKB 3D CLASSes */
 /** GEOS-WKB 3D CLASS: POINT Z */
 #define GAIA_GEOSWKB_POINTZ			-2147483647
@@ -661,6 +661,32 @@ extern "C"
 						  unsigned char **result,
 						  int *size);
 
+/**
+ Creates a TWKB compressed BLOB-Geometry corresponding to a Geometry object
+
+ \param geom pointer to the Geometry object.
+ \param precision_xy number of decimal digits to be preserved for X and Y
+ (-7 to 7; negative values will round to tens, hundreds and so on).
+ \param precision_z number of decimal digits to be preserved for Z (0 to 7).
+ \param precision_m number of decimal digits to be preserved for M (0 to 7).
+ \param result on completion will containt a pointer to Compressed BLOB-Geometry:
+ NULL on failure.
+ \param size on completion this variable will contain the BLOB's size (in bytes)
+
+ \sa gaiaFromSpatiaLiteBlobWkb, gaiaToCompressedBlobWkb
+
+ \note the BLOB keeps the same header (SRID and MBR) of any other
+ BLOB-Geometry, but all coordinates are rounded to the declared precision
+ and stored as varint/zigzag encoded integer deltas in TWKB notation.
+ \n the returned BLOB buffer corresponds to dynamically allocated memory:
+ so you are responsible to free() it [unless SQLite will take care
+ of memory cleanup via buffer binding].
+ */
+    GAIAGEO_DECLARE void gaiaToTwkbBlobWkb (gaiaGeomCollPtr geom,
+					    int precision_xy, int precision_z,
+					    int precision_m,
+					    unsigned char **result, int *size);
+
 /**
  Creates a Geometry object from WKB notation
 
@@ -1095,6 +1121,7 @@ extern "C"
  \param out_buf pointer to dynamically growing Text buffer
  \param geom pointer to Geometry object 
  \param precision decimal digits to be used for coordinates
+ (a negative value selects the shortest round-trip representation)
 
  \sa gaiaParseKml, gaiaOutFullKml
 
@@ -1111,6 +1138,7 @@ extern "C"
  \param desc text string to se set as KML \e description 
  \param geom pointer to Geometry object
  \param precision decimal digits to be used for coordinates
+ (a negative value selects the shortest round-trip representation)
 
  \sa gaiaParseKml, gaiaOutBareKml
 
@@ -1218,6 +1246,7 @@ extern "C"
  \param out_buf pointer to dynamically growing Text buffer
  \param geom pointer to Geometry object
  \param precision decimal digits to be used for coordinates
+ (a negative value selects the shortest round-trip representation)
  \param options GeoJSON specific options
 
  \sa gaiaParseGeoJSON
@@ -55,7 +55,8 @@ SPATIALITE_PRIVATE int virtualbbox_extension_init (void *db,
 						   const void *p_cache);
 SPATIALITE_PRIVATE int mbrcache_extension_init (void *db);
 SPATIALITE_PRIVATE int virtual_spatialindex_extension_init (void *db);
-SPATIALITE_PRIVATE int virtual_elementary_extension_init (void *db);
+SPATIALITE_PRIVATE int virtual_elementary_extension_init (void *db,
+							  const void *p_cache);
 SPATIALITE_PRIVATE int virtual_knn_extension_init (void *db);
 SPATIALITE_PRIVATE int virtual_knn2_extension_init (void *db);
 SPATIALITE_PRIVATE int virtual_xpath_extension_init (void *db,
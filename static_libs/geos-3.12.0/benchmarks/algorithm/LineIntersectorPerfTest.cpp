@@ -14,6 +14,7 @@
 
 #include <benchmark/benchmark.h>
 
+#include <geos/algorithm/BatchPredicates.h>
 #include <geos/algorithm/LineIntersector.h>
 #include <geos/geom/Envelope.h>
 
@@ -21,6 +22,7 @@
 
 #include <array>
 #include <random>
+#include <vector>
 
 using geos::geom::Coordinate;
 using geos::geom::CoordinateXY;
@@ -28,6 +30,7 @@ using geos::geom::CoordinateXYM;
 using geos::geom::CoordinateXYZM;
 using geos::geom::CoordinateSequence;
 using geos::geom::Envelope;
+using geos::algorithm::BatchPredicates;
 using geos::algorithm::LineIntersector;
 
 template<typename CoordType>
@@ -86,12 +89,63 @@ static void BM_Collinear(benchmark::State& state) {
         li.computeIntersection(p1, p2, q1, q2);
     }
 }
+// Envelope pre-check of random segment pairs, one pair at a time
+static void BM_SegmentEnvelopes(benchmark::State& state) {
+    std::size_t n = 1024;
+    std::default_random_engine e(12345);
+    auto pts = geos::benchmark::createRandomCoords(Envelope{0, 100, 0, 100}, 4 * n, e);
+
+    for (auto _ : state) {
+        unsigned hits = 0;
+        for (std::size_t i = 0; i < 4 * n; i += 4) {
+            hits += Envelope::intersects(pts->getAt<CoordinateXY>(i), pts->getAt<CoordinateXY>(i + 1),
+                                         pts->getAt<CoordinateXY>(i + 2), pts->getAt<CoordinateXY>(i + 3));
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Same pairs, BatchPredicates::BATCH_SIZE at a time
+static void BM_BatchSegmentEnvelopes(benchmark::State& state) {
+    constexpr std::size_t N = BatchPredicates::BATCH_SIZE;
+    std::size_t n = 1024;
+    std::default_random_engine e(12345);
+    auto pts = geos::benchmark::createRandomCoords(Envelope{0, 100, 0, 100}, 4 * n, e);
+
+    std::vector<double> ord(8 * n);
+    for (std::size_t i = 0; i < n; i++) {
+        std::size_t base = (i / N) * 8 * N + i % N;
+        for (std::size_t k = 0; k < 4; k++) {
+            const CoordinateXY& c = pts->getAt<CoordinateXY>(4 * i + k);
+            ord[base + (2 * k) * N] = c.x;
+            ord[base + (2 * k + 1) * N] = c.y;
+        }
+    }
+
+    for (auto _ : state) {
+        unsigned hits = 0;
+        for (std::size_t i = 0; i < 8 * n; i += 8 * N) {
+            const double* o = &ord[i];
+            unsigned mask = BatchPredicates::segmentEnvelopesIntersect(
+                                o, o + N, o + 2 * N, o + 3 * N, o + 4 * N, o + 5 * N, o + 6 * N, o + 7 * N, 0.0);
+            for (; mask; mask >>= 1) {
+                hits += mask & 1u;
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
 BENCHMARK_TEMPLATE(BM_PointIntersection, CoordinateXY);
 BENCHMARK_TEMPLATE(BM_PointIntersection, Coordinate);
 BENCHMARK_TEMPLATE(BM_PointIntersection, CoordinateXYZM);
 BENCHMARK_TEMPLATE(BM_Collinear, CoordinateXY);
 BENCHMARK_TEMPLATE(BM_Collinear, Coordinate);
 BENCHMARK_TEMPLATE(BM_Collinear, CoordinateXYZM);
+BENCHMARK(BM_SegmentEnvelopes);
+BENCHMARK(BM_BatchSegmentEnvelopes);
 
 BENCHMARK_MAIN();
 
@@ -15,11 +15,32 @@
 #include <benchmark/benchmark.h>
 
 #include <geos/geom/Coordinate.h>
+#include <geos/algorithm/BatchPredicates.h>
 #include <geos/algorithm/CGAlgorithmsDD.h>
 
+#include <random>
+#include <vector>
+
 using geos::geom::Coordinate;
+using geos::algorithm::BatchPredicates;
 using geos::algorithm::CGAlgorithmsDD;
 
+// Random triples, stored as one array per ordinate
+struct Triples {
+    explicit Triples(std::size_t n) {
+        std::default_random_engine e(12345);
+        std::uniform_real_distribution<double> dist(-1000, 1000);
+        for (auto* v : { &p1x, &p1y, &p2x, &p2y, &qx, &qy }) {
+            v->resize(n);
+            for (double& d : *v) {
+                d = dist(e);
+            }
+        }
+    }
+
+    std::vector<double> p1x, p1y, p2x, p2y, qx, qy;
+};
+
 static void BM_OrientationIndexFilter(benchmark::State& state) {
     Coordinate p0(219.3649559090992, 140.84159161824724);
     Coordinate p1(168.9018919682399, -5.713787599646864);
@@ -40,8 +61,55 @@ static void BM_OrientationIndex(benchmark::State& state) {
     }
 }
 
+static void BM_OrientationIndexArray(benchmark::State& state) {
+    const std::size_t n = 1024;
+    Triples t(n);
+    std::vector<int> orient(n);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i++) {
+            orient[i] = CGAlgorithmsDD::orientationIndex(t.p1x[i], t.p1y[i], t.p2x[i], t.p2y[i], t.qx[i], t.qy[i]);
+        }
+        benchmark::DoNotOptimize(orient.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+static void BM_BatchOrientationIndexFilter(benchmark::State& state) {
+    const std::size_t n = 1024;
+    Triples t(n);
+    std::vector<int> orient(n);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i += BatchPredicates::BATCH_SIZE) {
+            BatchPredicates::orientationIndexFilter(&t.p1x[i], &t.p1y[i], &t.p2x[i], &t.p2y[i],
+                                                    &t.qx[i], &t.qy[i], &orient[i]);
+        }
+        benchmark::DoNotOptimize(orient.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+static void BM_BatchOrientationIndex(benchmark::State& state) {
+    const std::size_t n = 1024;
+    Triples t(n);
+    std::vector<int> orient(n);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i += BatchPredicates::BATCH_SIZE) {
+            BatchPredicates::orientationIndex(&t.p1x[i], &t.p1y[i], &t.p2x[i], &t.p2y[i],
+                                              &t.qx[i], &t.qy[i], &orient[i]);
+        }
+        benchmark::DoNotOptimize(orient.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
 BENCHMARK(BM_OrientationIndexFilter);
 BENCHMARK(BM_OrientationIndex);
+BENCHMARK(BM_OrientationIndexArray);
+BENCHMARK(BM_BatchOrientationIndexFilter);
+BENCHMARK(BM_BatchOrientationIndex);
 
 BENCHMARK_MAIN();
 
@@ -0,0 +1,128 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Scaling of the batch C API functions with the number of threads.
+ *
+ **********************************************************************/
+
+#include <geos_c.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static GEOSGeometry*
+createStar(double cx, double cy, double radius, unsigned int npts)
+{
+    GEOSCoordSequence* cs = GEOSCoordSeq_create(npts + 1, 2);
+    for (unsigned int i = 0; i < npts; i++) {
+        double angle = 2 * M_PI * i / npts;
+        double r = radius * (i % 2 ? 0.6 : 1.0);
+        GEOSCoordSeq_setXY(cs, i, cx + r * std::cos(angle), cy + r * std::sin(angle));
+    }
+    GEOSCoordSeq_setXY(cs, npts, cx + radius, cy);
+    return GEOSGeom_createPolygon(GEOSGeom_createLinearRing(cs), nullptr, 0);
+}
+
+static void
+run(const std::string& name, unsigned int ngeoms, const std::vector<unsigned int>& threadCounts,
+    const std::function<void(unsigned int)>& op)
+{
+    double base = 0;
+    for (unsigned int numThreads : threadCounts) {
+        auto t0 = std::chrono::steady_clock::now();
+        op(numThreads);
+        auto t1 = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        if (numThreads == 1) {
+            base = ms;
+        }
+        std::cout << std::left << std::setw(20) << name
+                  << std::right << std::setw(4) << numThreads << " threads"
+                  << std::setw(12) << std::fixed << std::setprecision(1) << ms << " ms"
+                  << std::setw(10) << std::setprecision(0) << ngeoms / ms * 1000 << " items/s"
+                  << std::setw(8) << std::setprecision(2) << base / ms << "x"
+                  << std::endl;
+    }
+}
+
+int
+main(int argc, char** argv)
+{
+    unsigned int ngeoms = 5000;
+    if (argc > 1) {
+        ngeoms = static_cast<unsigned int>(std::atol(argv[1]));
+    }
+
+    initGEOS(nullptr, nullptr);
+
+    std::vector<unsigned int> threadCounts;
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int t = 1; t < maxThreads; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::vector<GEOSGeometry*> geomsA;
+    std::vector<GEOSGeometry*> geomsB;
+    for (unsigned int i = 0; i < ngeoms; i++) {
+        double x = (i % 200) * 10.0;
+        double y = (i / 200) * 10.0;
+        geomsA.push_back(createStar(x, y, 8, 64));
+        geomsB.push_back(createStar(x + 4, y + 3, 8, 64));
+    }
+    GEOSGeometry* area = createStar(1000, 500, 900, 4096);
+    const GEOSPreparedGeometry* pg = GEOSPrepare(area);
+
+    std::vector<GEOSGeometry*> results(ngeoms);
+    std::vector<char> flags(ngeoms);
+    std::vector<double> distances(ngeoms);
+
+    auto freeResults = [&results]() {
+        for (GEOSGeometry*& g : results) {
+            GEOSGeom_destroy(g);
+            g = nullptr;
+        }
+    };
+
+    std::cout << ngeoms << " items, up to " << maxThreads << " threads" << std::endl;
+
+    run("buffer", ngeoms, threadCounts, [&](unsigned int numThreads) {
+        GEOSBatchBuffer(geomsA.data(), ngeoms, 2, 8, numThreads, results.data(), flags.data());
+        freeResults();
+    });
+    run("intersection", ngeoms, threadCounts, [&](unsigned int numThreads) {
+        GEOSBatchIntersection(geomsA.data(), geomsB.data(), ngeoms, numThreads, results.data(), flags.data());
+        freeResults();
+    });
+    run("prepared intersects", ngeoms, threadCounts, [&](unsigned int numThreads) {
+        GEOSBatchPreparedPredicate(pg, GEOS_PREP_INTERSECTS, geomsA.data(), ngeoms, numThreads, flags.data());
+    });
+    run("distance", ngeoms, threadCounts, [&](unsigned int numThreads) {
+        GEOSBatchDistance(geomsA.data(), geomsB.data(), ngeoms, numThreads, distances.data(), flags.data());
+    });
+
+    GEOSPreparedGeom_destroy(pg);
+    GEOSGeom_destroy(area);
+    for (unsigned int i = 0; i < ngeoms; i++) {
+        GEOSGeom_destroy(geomsA[i]);
+        GEOSGeom_destroy(geomsB[i]);
+    }
+    finishGEOS();
+
+    return 0;
+}
@@ -16,6 +16,7 @@
 
 #include <benchmark/benchmark.h>
 
+#include <geos/index/strtree/FlatSTRtree.h>
 #include <geos/index/strtree/STRtree.h>
 #include <geos/index/strtree/SimpleSTRtree.h>
 #include <geos/index/strtree/TemplateSTRtree.h>
@@ -26,6 +27,7 @@ using geos::geom::CoordinateXY;
 using geos::geom::Envelope;
 using geos::index::intervalrtree::SortedPackedIntervalRTree;
 using geos::index::quadtree::Quadtree;
+using geos::index::strtree::FlatSTRtree;
 using geos::index::strtree::STRtree;
 using geos::index::strtree::SimpleSTRtree;
 using geos::index::strtree::TemplateSTRtree;
@@ -304,6 +306,46 @@ static void BM_STRtree2DQueryPairsNaive(benchmark::State& state) {
     }
 }
 
+static std::vector<unsigned char> serialize_envelopes(const std::vector<Envelope>& envelopes) {
+    TemplateSTRtree<std::size_t> tree;
+    for (std::size_t i = 0; i < envelopes.size(); i++) {
+        tree.insert(envelopes[i], i);
+    }
+    return FlatSTRtree::serialize(tree, [](std::size_t i) {
+        return static_cast<FlatSTRtree::ItemId>(i);
+    });
+}
+
+// Opening a serialized tree, against building it from scratch
+static void BM_STRtree2DFlatOpen(benchmark::State& state) {
+    std::default_random_engine eng(12345);
+    Envelope extent(0, 1, 0, 1);
+    auto envelopes = generate_envelopes(eng, extent, 10000);
+    auto buf = serialize_envelopes(envelopes);
+    Envelope empty_env;
+
+    for (auto _ : state) {
+        FlatSTRtree tree(buf.data(), buf.size());
+        Counter<FlatSTRtree::ItemId> c;
+        tree.query(empty_env, c);
+    }
+}
+
+static void BM_STRtree2DFlatQuery(benchmark::State& state) {
+    std::default_random_engine eng(12345);
+    Envelope extent(0, 1, 0, 1);
+    auto envelopes = generate_envelopes(eng, extent, 10000);
+    auto buf = serialize_envelopes(envelopes);
+    FlatSTRtree tree(buf.data(), buf.size());
+
+    for (auto _ : state) {
+        Counter<FlatSTRtree::ItemId> c;
+        for (auto& e : envelopes) {
+            tree.query(e, c);
+        }
+    }
+}
+
 template<class Tree>
 static void BM_STRtree2DNearest(benchmark::State& state) {
     std::default_random_engine eng(12345);
@@ -344,6 +386,7 @@ BENCHMARK_TEMPLATE(BM_STRtree2DConstruct, Quadtree);
 BENCHMARK_TEMPLATE(BM_STRtree2DConstruct, STRtree);
 BENCHMARK_TEMPLATE(BM_STRtree2DConstruct, SimpleSTRtree);
 BENCHMARK_TEMPLATE(BM_STRtree2DConstruct, TemplateSTRtree<const Envelope*>);
+BENCHMARK(BM_STRtree2DFlatOpen);
 
 BENCHMARK_TEMPLATE(BM_STRtree2DNearest, STRtree);
 BENCHMARK_TEMPLATE(BM_STRtree2DNearest, SimpleSTRtree);
@@ -353,6 +396,7 @@ BENCHMARK_TEMPLATE(BM_STRtree2DQuery, Quadtree);
 BENCHMARK_TEMPLATE(BM_STRtree2DQuery, STRtree);
 BENCHMARK_TEMPLATE(BM_STRtree2DQuery, SimpleSTRtree);
 BENCHMARK_TEMPLATE(BM_STRtree2DQuery, TemplateSTRtree<const Envelope*>);
+BENCHMARK(BM_STRtree2DFlatQuery);
 
 BENCHMARK(BM_STRtree2DQueryPairs);
 BENCHMARK(BM_STRtree2DQueryPairsNaive);
@@ -0,0 +1,88 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/Polygon.h>
+#include <geos/io/ByteOrderValues.h>
+#include <geos/io/WKBReader.h>
+#include <geos/io/WKBWriter.h>
+
+#include <BenchmarkUtils.h>
+
+#include <sstream>
+#include <string>
+
+using geos::geom::CoordinateSequence;
+using geos::geom::Geometry;
+using geos::geom::GeometryFactory;
+using geos::io::ByteOrderValues;
+using geos::io::WKBReader;
+using geos::io::WKBWriter;
+
+// A multipolygon of nParts sine stars of npts points each, with Z
+// values if dim is 3
+static std::unique_ptr<Geometry>
+createStars(std::size_t nParts, std::size_t npts, int dim)
+{
+    auto gfact = GeometryFactory::getDefaultInstance();
+    auto stars = geos::benchmark::createGeometriesOnGrid({0, 1000, 0, 1000}, nParts,
+    [npts, dim, gfact](const geos::geom::CoordinateXY& base) -> std::unique_ptr<Geometry> {
+        auto star = geos::benchmark::createSineStar(base, 10, npts);
+        if (dim == 2) {
+            return std::unique_ptr<Geometry>(star.release());
+        }
+        const CoordinateSequence* xy = star->getExteriorRing()->getCoordinatesRO();
+        auto xyz = geos::detail::make_unique<CoordinateSequence>(xy->size(), true, false);
+        for (std::size_t i = 0; i < xy->size(); i++) {
+            xyz->setAt(geos::geom::Coordinate(xy->getX(i), xy->getY(i), xy->getX(i) + xy->getY(i)), i);
+        }
+        return gfact->createPolygon(gfact->createLinearRing(std::move(xyz)));
+    });
+    return gfact->createMultiPolygon(std::move(stars));
+}
+
+static std::string
+toWKB(const Geometry& g, int dim, int byteOrder)
+{
+    WKBWriter writer(static_cast<uint8_t>(dim), byteOrder);
+    std::stringstream os;
+    writer.write(g, os);
+    return os.str();
+}
+
+// Arguments: number of polygons, points per polygon, dimension
+template<int ByteOrder>
+static void BM_WKBRead(benchmark::State& state) {
+    auto nParts = static_cast<std::size_t>(state.range(0));
+    auto npts = static_cast<std::size_t>(state.range(1));
+    auto dim = static_cast<int>(state.range(2));
+    auto wkb = toWKB(*createStars(nParts, npts, dim), dim, ByteOrder);
+
+    WKBReader reader;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reader.read(reinterpret_cast<const unsigned char*>(wkb.data()), wkb.size()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * wkb.size()));
+}
+
+// Little endian is the host order on the usual platforms, and is read
+// in blocks; big endian goes through the byte swapping path
+BENCHMARK_TEMPLATE(BM_WKBRead, ByteOrderValues::ENDIAN_LITTLE)->ArgsProduct({{1}, {1000, 100000}, {2, 3}});
+BENCHMARK_TEMPLATE(BM_WKBRead, ByteOrderValues::ENDIAN_BIG)->ArgsProduct({{1}, {1000, 100000}, {2, 3}});
+BENCHMARK_TEMPLATE(BM_WKBRead, ByteOrderValues::ENDIAN_LITTLE)->ArgsProduct({{10000}, {50}, {2, 3}});
+BENCHMARK_TEMPLATE(BM_WKBRead, ByteOrderValues::ENDIAN_BIG)->ArgsProduct({{10000}, {50}, {2, 3}});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,119 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Heap allocations and wall time per call of buffer and overlay
+ * operations on small polygons, as issued once per row by SQL
+ * functions.
+ *
+ **********************************************************************/
+
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/util/SineStarFactory.h>
+#include <geos/operation/overlayng/OverlayNGRobust.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <vector>
+
+using namespace geos::geom;
+using geos::operation::overlayng::OverlayNGRobust;
+
+static std::size_t numAllocs = 0;
+
+void*
+operator new(std::size_t size)
+{
+    numAllocs++;
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+static std::unique_ptr<Polygon>
+createStar(double x, double y, std::uint32_t npts)
+{
+    geos::geom::util::SineStarFactory gsf(GeometryFactory::getDefaultInstance());
+    gsf.setCentre(CoordinateXY(x, y));
+    gsf.setSize(100);
+    gsf.setNumPoints(npts);
+    gsf.setNumArms(5);
+    gsf.setArmLengthRatio(0.3);
+    return gsf.createSineStar();
+}
+
+static void
+run(const std::string& name, std::size_t iterations,
+    const std::function<std::unique_ptr<Geometry>()>& op)
+{
+    std::size_t allocs0 = numAllocs;
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; i++) {
+        op();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1)
+              << static_cast<double>(numAllocs - allocs0) / static_cast<double>(iterations)
+              << " allocs/op"
+              << std::setw(10) << us / static_cast<double>(iterations) << " us/op"
+              << std::endl;
+}
+
+int
+main(int argc, char** argv)
+{
+    std::size_t iterations = 20000;
+    if (argc > 1) {
+        iterations = static_cast<std::size_t>(std::atol(argv[1]));
+    }
+
+    for (std::uint32_t npts : { 16u, 64u, 256u }) {
+        auto a = createStar(0, 0, npts);
+        auto b = createStar(40, 30, npts);
+
+        std::cout << "--- " << npts << " vertices" << std::endl;
+        run("buffer", iterations, [&a]() {
+            return a->buffer(5);
+        });
+        run("intersection", iterations, [&a, &b]() {
+            return OverlayNGRobust::Intersection(a.get(), b.get());
+        });
+        run("union", iterations, [&a, &b]() {
+            return OverlayNGRobust::Union(a.get(), b.get());
+        });
+        run("difference", iterations, [&a, &b]() {
+            return OverlayNGRobust::Difference(a.get(), b.get());
+        });
+    }
+
+    return 0;
+}
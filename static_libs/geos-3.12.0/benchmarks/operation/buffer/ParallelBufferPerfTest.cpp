@@ -0,0 +1,95 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <geos/geom/Envelope.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/operation/buffer/BufferOp.h>
+#include <geos/operation/buffer/BufferParameters.h>
+#include <geos/operation/buffer/ParallelBufferOp.h>
+
+#include <BenchmarkUtils.h>
+
+#include <cmath>
+
+using geos::geom::Envelope;
+using geos::geom::Geometry;
+using geos::geom::GeometryFactory;
+using geos::operation::buffer::BufferOp;
+using geos::operation::buffer::BufferParameters;
+using geos::operation::buffer::ParallelBufferOp;
+
+auto nPartsRange = benchmark::CreateRange(16, 1024, 4);
+
+// Separate sine stars on a grid of cells of side 10; a buffer distance
+// of 1 keeps them apart, 3 merges the neighbouring ones
+static std::unique_ptr<Geometry>
+createStars(std::size_t nParts)
+{
+    double extent = 10 * std::sqrt(static_cast<double>(nParts));
+    auto stars = geos::benchmark::createGeometriesOnGrid(Envelope(0, extent, 0, extent), nParts,
+    [](const geos::geom::CoordinateXY& base) -> std::unique_ptr<Geometry> {
+        return geos::benchmark::createSineStar(base, 6, 100);
+    });
+    return GeometryFactory::getDefaultInstance()->createMultiPolygon(std::move(stars));
+}
+
+static std::unique_ptr<Geometry>
+createLines(std::size_t nParts)
+{
+    double extent = 10 * std::sqrt(static_cast<double>(nParts));
+    auto lines = geos::benchmark::createLines(Envelope(0, extent, 0, extent), nParts, 6, 100);
+    return GeometryFactory::getDefaultInstance()->createMultiLineString(std::move(lines));
+}
+
+struct SerialBuffer {
+    static std::unique_ptr<Geometry> buffer(const Geometry* g, double distance, std::size_t) {
+        return BufferOp::bufferOp(g, distance);
+    }
+};
+
+struct ClusteredBuffer {
+    static std::unique_ptr<Geometry> buffer(const Geometry* g, double distance, std::size_t numThreads) {
+        return ParallelBufferOp::bufferOp(g, distance, BufferParameters(), numThreads);
+    }
+};
+
+// Arguments: number of parts, buffer distance, number of threads
+template<class Op>
+static void BM_BufferMultiPolygon(benchmark::State& state) {
+    auto g = createStars(static_cast<std::size_t>(state.range(0)));
+    auto distance = static_cast<double>(state.range(1));
+    auto numThreads = static_cast<std::size_t>(state.range(2));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Op::buffer(g.get(), distance, numThreads));
+    }
+}
+
+template<class Op>
+static void BM_BufferMultiLineString(benchmark::State& state) {
+    auto g = createLines(static_cast<std::size_t>(state.range(0)));
+    auto distance = static_cast<double>(state.range(1));
+    auto numThreads = static_cast<std::size_t>(state.range(2));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Op::buffer(g.get(), distance, numThreads));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_BufferMultiPolygon, SerialBuffer)->ArgsProduct({nPartsRange, {1, 3}, {1}});
+BENCHMARK_TEMPLATE(BM_BufferMultiPolygon, ClusteredBuffer)->ArgsProduct({nPartsRange, {1, 3}, {1, 0}});
+BENCHMARK_TEMPLATE(BM_BufferMultiLineString, SerialBuffer)->ArgsProduct({nPartsRange, {1, 3}, {1}});
+BENCHMARK_TEMPLATE(BM_BufferMultiLineString, ClusteredBuffer)->ArgsProduct({nPartsRange, {1, 3}, {1, 0}});
+
+BENCHMARK_MAIN();
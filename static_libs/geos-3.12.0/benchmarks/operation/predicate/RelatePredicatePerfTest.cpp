@@ -0,0 +1,105 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <geos/geom/LinearRing.h>
+#include <geos/operation/relate/RelatePredicateOp.h>
+
+#include <BenchmarkUtils.h>
+
+using geos::geom::Geometry;
+using geos::geom::GeometryFactory;
+using geos::geom::LinearRing;
+using geos::geom::Polygon;
+using geos::operation::relate::RelatePredicateOp;
+
+auto nPtsRange = benchmark::CreateRange(64, 4096, 4);
+
+// A sine star with a sine star shaped hole
+static std::unique_ptr<Polygon>
+createStarWithHole(std::size_t npts)
+{
+    auto shell = geos::benchmark::createSineStar({0, 0}, 200, npts);
+    auto hole = geos::benchmark::createSineStar({0, 0}, 100, npts);
+
+    std::vector<std::unique_ptr<LinearRing>> holes;
+    holes.push_back(hole->getExteriorRing()->clone());
+    return GeometryFactory::getDefaultInstance()->createPolygon(
+               shell->getExteriorRing()->clone(), std::move(holes));
+}
+
+struct GeometryMethods {
+    static bool intersects(const Geometry* a, const Geometry* b) { return a->intersects(b); }
+    static bool contains(const Geometry* a, const Geometry* b) { return a->contains(b); }
+    static bool touches(const Geometry* a, const Geometry* b) { return a->touches(b); }
+    static bool disjoint(const Geometry* a, const Geometry* b) { return a->disjoint(b); }
+};
+
+// Overlapping stars: intersects is decided by the first crossing
+template<class Op>
+static void BM_IntersectsOverlapping(benchmark::State& state) {
+    auto npts = static_cast<std::size_t>(state.range(0));
+    auto a = geos::benchmark::createSineStar({0, 0}, 100, npts);
+    auto b = geos::benchmark::createSineStar({50, 0}, 100, npts);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Op::intersects(a.get(), b.get()));
+    }
+}
+
+// A star nested in another one
+template<class Op>
+static void BM_ContainsNested(benchmark::State& state) {
+    auto npts = static_cast<std::size_t>(state.range(0));
+    auto a = geos::benchmark::createSineStar({0, 0}, 100, npts);
+    auto b = geos::benchmark::createSineStar({0, 0}, 50, npts);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Op::contains(a.get(), b.get()));
+    }
+}
+
+// A star filling the hole of a polygon exactly
+template<class Op>
+static void BM_TouchesAdjacent(benchmark::State& state) {
+    auto npts = static_cast<std::size_t>(state.range(0));
+    auto a = createStarWithHole(npts);
+    auto b = geos::benchmark::createSineStar({0, 0}, 100, npts);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Op::touches(a.get(), b.get()));
+    }
+}
+
+// A star inside the hole of a polygon, with intersecting envelopes
+template<class Op>
+static void BM_DisjointInHole(benchmark::State& state) {
+    auto npts = static_cast<std::size_t>(state.range(0));
+    auto a = createStarWithHole(npts);
+    auto b = geos::benchmark::createSineStar({0, 0}, 50, npts);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Op::disjoint(a.get(), b.get()));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_IntersectsOverlapping, GeometryMethods)->ArgsProduct({nPtsRange});
+BENCHMARK_TEMPLATE(BM_IntersectsOverlapping, RelatePredicateOp)->ArgsProduct({nPtsRange});
+BENCHMARK_TEMPLATE(BM_ContainsNested, GeometryMethods)->ArgsProduct({nPtsRange});
+BENCHMARK_TEMPLATE(BM_ContainsNested, RelatePredicateOp)->ArgsProduct({nPtsRange});
+BENCHMARK_TEMPLATE(BM_TouchesAdjacent, GeometryMethods)->ArgsProduct({nPtsRange});
+BENCHMARK_TEMPLATE(BM_TouchesAdjacent, RelatePredicateOp)->ArgsProduct({nPtsRange});
+BENCHMARK_TEMPLATE(BM_DisjointInHole, GeometryMethods)->ArgsProduct({nPtsRange});
+BENCHMARK_TEMPLATE(BM_DisjointInHole, RelatePredicateOp)->ArgsProduct({nPtsRange});
+
+BENCHMARK_MAIN();
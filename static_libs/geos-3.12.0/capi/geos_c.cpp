@@ -16,6 +16,7 @@
  ***********************************************************************/
 
 #include <geos/geom/prep/PreparedGeometryFactory.h>
+#include <geos/index/strtree/FlatSTRtree.h>
 #include <geos/index/strtree/TemplateSTRtree.h>
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKBReader.h>
@@ -37,6 +38,7 @@
 #define GEOSPreparedGeometry geos::geom::prep::PreparedGeometry
 #define GEOSCoordSequence geos::geom::CoordinateSequence
 #define GEOSSTRtree geos::index::strtree::TemplateSTRtree<void*>
+#define GEOSSTRtreeView geos::index::strtree::FlatSTRtree
 #define GEOSWKTReader geos::io::WKTReader
 #define GEOSWKTWriter geos::io::WKTWriter
 #define GEOSWKBReader geos::io::WKBReader
@@ -226,6 +228,19 @@ extern "C" {
         return GEOSRelateBoundaryNodeRule_r(handle, g1, g2, bnr);
     }
 
+    char
+    GEOSRelatePatternFast(const Geometry* g1, const Geometry* g2, const char* pat)
+    {
+        return GEOSRelatePatternFast_r(handle, g1, g2, pat);
+    }
+
+    char
+    GEOSRelatePredicateFast(const Geometry* g1, const Geometry* g2,
+                            enum GEOSPreparedPredicates predicate)
+    {
+        return GEOSRelatePredicateFast_r(handle, g1, g2, predicate);
+    }
+
 
 //-----------------------------------------------------------------
 // isValid
@@ -603,6 +618,12 @@ extern "C" {
         return GEOSUnaryUnion_r(handle, g);
     }
 
+    Geometry*
+    GEOSUnaryUnionParallel(const Geometry* g, unsigned int numThreads)
+    {
+        return GEOSUnaryUnionParallel_r(handle, g, numThreads);
+    }
+
     Geometry*
     GEOSUnaryUnionPrec(const Geometry* g, double gridSize)
     {
@@ -1655,6 +1676,65 @@ extern "C" {
         GEOSSTRtree_destroy_r(handle, tree);
     }
 
+    unsigned char*
+    GEOSSTRtree_serialize(GEOSSTRtree* tree, GEOSSTRtreeItemIdCallback idfn,
+                          void* userdata, std::size_t* size)
+    {
+        return GEOSSTRtree_serialize_r(handle, tree, idfn, userdata, size);
+    }
+
+    GEOSSTRtreeView*
+    GEOSSTRtree_view(const unsigned char* data, std::size_t size)
+    {
+        return GEOSSTRtree_view_r(handle, data, size);
+    }
+
+    int
+    GEOSSTRtree_queryView(const GEOSSTRtreeView* view, const Geometry* g,
+                          GEOSQueryCallback callback, void* userdata)
+    {
+        return GEOSSTRtree_queryView_r(handle, view, g, callback, userdata);
+    }
+
+    void
+    GEOSSTRtree_destroyView(GEOSSTRtreeView* view)
+    {
+        GEOSSTRtree_destroyView_r(handle, view);
+    }
+
+    int
+    GEOSBatchBuffer(const Geometry* const* geoms, unsigned int ngeoms,
+                    double width, int quadsegs, unsigned int numThreads,
+                    Geometry** results, char* status)
+    {
+        return GEOSBatchBuffer_r(handle, geoms, ngeoms, width, quadsegs, numThreads, results, status);
+    }
+
+    int
+    GEOSBatchIntersection(const Geometry* const* geomsA, const Geometry* const* geomsB,
+                          unsigned int ngeoms, unsigned int numThreads,
+                          Geometry** results, char* status)
+    {
+        return GEOSBatchIntersection_r(handle, geomsA, geomsB, ngeoms, numThreads, results, status);
+    }
+
+    int
+    GEOSBatchPreparedPredicate(const geos::geom::prep::PreparedGeometry* pg,
+                               enum GEOSPreparedPredicates predicate,
+                               const Geometry* const* geoms, unsigned int ngeoms,
+                               unsigned int numThreads, char* results)
+    {
+        return GEOSBatchPreparedPredicate_r(handle, pg, predicate, geoms, ngeoms, numThreads, results);
+    }
+
+    int
+    GEOSBatchDistance(const Geometry* const* geomsA, const Geometry* const* geomsB,
+                      unsigned int ngeoms, unsigned int numThreads,
+                      double* distances, char* status)
+    {
+        return GEOSBatchDistance_r(handle, geomsA, geomsB, ngeoms, numThreads, distances, status);
+    }
+
     double
     GEOSProject(const geos::geom::Geometry* g,
                 const geos::geom::Geometry* p)
@@ -1787,6 +1867,12 @@ extern "C" {
         return GEOSBufferWithParams_r(handle, g, p, w);
     }
 
+    Geometry*
+    GEOSBufferParallel(const Geometry* g, const GEOSBufferParams* p, double w, unsigned int numThreads)
+    {
+        return GEOSBufferParallel_r(handle, g, p, w, numThreads);
+    }
+
     Geometry*
     GEOSDelaunayTriangulation(const Geometry* g, double tolerance, int onlyEdges)
     {
@@ -52,6 +52,7 @@
 #include <geos/geom/util/Densifier.h>
 #include <geos/geom/util/GeometryFixer.h>
 #include <geos/index/ItemVisitor.h>
+#include <geos/index/strtree/FlatSTRtree.h>
 #include <geos/index/strtree/TemplateSTRtree.h>
 #include <geos/io/WKBReader.h>
 #include <geos/io/WKBWriter.h>
@@ -64,6 +65,7 @@
 #include <geos/noding/Noder.h>
 #include <geos/operation/buffer/BufferBuilder.h>
 #include <geos/operation/buffer/BufferOp.h>
+#include <geos/operation/buffer/ParallelBufferOp.h>
 #include <geos/operation/buffer/BufferParameters.h>
 #include <geos/operation/buffer/OffsetCurve.h>
 #include <geos/operation/distance/DistanceOp.h>
@@ -79,9 +81,11 @@
 #include <geos/operation/polygonize/Polygonizer.h>
 #include <geos/operation/polygonize/BuildArea.h>
 #include <geos/operation/relate/RelateOp.h>
+#include <geos/operation/relate/RelatePredicateOp.h>
 #include <geos/operation/sharedpaths/SharedPathsOp.h>
 #include <geos/operation/union/CascadedPolygonUnion.h>
 #include <geos/operation/union/DisjointSubsetUnion.h>
+#include <geos/operation/union/UnaryUnionOp.h>
 #include <geos/operation/valid/IsValidOp.h>
 #include <geos/operation/valid/MakeValid.h>
 #include <geos/operation/valid/RepeatedPointRemover.h>
@@ -104,14 +108,21 @@
 #include <cmath> // finite
 #include <cstdarg>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
 #include <memory>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(disable : 4099)
@@ -124,6 +135,7 @@
 #define GEOSCoordSequence geos::geom::CoordinateSequence
 #define GEOSBufferParams geos::operation::buffer::BufferParameters
 #define GEOSSTRtree geos::index::strtree::TemplateSTRtree<void*>
+#define GEOSSTRtreeView geos::index::strtree::FlatSTRtree
 #define GEOSWKTReader geos::io::WKTReader
 #define GEOSWKTWriter geos::io::WKTWriter
 #define GEOSWKBReader geos::io::WKBReader
@@ -448,6 +460,162 @@ inline void execute(GEOSContextHandle_t extHandle, F&& f) {
     }
 }
 
+// Number of threads used by a batch of n items, numThreads == 0
+// meaning one per hardware thread.
+inline std::size_t batchNumThreads(std::size_t n, unsigned int numThreads) {
+    std::size_t nThreads = numThreads;
+    if (nThreads == 0) {
+        nThreads = std::thread::hardware_concurrency();
+    }
+    return std::max<std::size_t>(1, std::min(nThreads, n));
+}
+
+// Execute f(worker, i) for every item i of a batch of n items, on
+// nThreads threads (worker 0 being the calling thread). Idle threads
+// claim the next chunk of items from a shared cursor, so uneven items
+// balance out. A failing item does not stop the batch: its status
+// is set to 0 and the message of the first failed item is reported
+// through the context handle once all threads are done. Interruption
+// aborts the whole batch. Return 1 if every item succeeded, 0 otherwise.
+template<typename F>
+inline int executeBatch(GEOSContextHandle_t extHandle, std::size_t n,
+                        std::size_t nThreads, char* status, F&& f) {
+    if (extHandle == nullptr) {
+        throw std::runtime_error("GEOS context handle is uninitialized, call initGEOS");
+    }
+
+    GEOSContextHandleInternal_t* handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if (!handle->initialized) {
+        return 0;
+    }
+
+    if (status != nullptr) {
+        std::fill(status, status + n, 0);
+    }
+
+    // small chunks at the end of the batch, to keep all threads busy
+    std::size_t chunkSize = std::max<std::size_t>(1, std::min<std::size_t>(64, n / (nThreads * 8)));
+    std::atomic<std::size_t> nextItem(0);
+    std::atomic<bool> interrupted(false);
+
+    // first failed item and its message, per worker
+    std::vector<std::size_t> failedItem(nThreads, n);
+    std::vector<std::string> failedMessage(nThreads);
+    std::vector<std::string> interruptMessage(nThreads);
+
+    auto fail = [&](std::size_t worker, std::size_t i, const char* msg) {
+        if (i < failedItem[worker]) {
+            failedItem[worker] = i;
+            failedMessage[worker] = msg;
+        }
+    };
+
+    auto work = [&](std::size_t worker) {
+        while (!interrupted) {
+            std::size_t begin = nextItem.fetch_add(chunkSize);
+            if (begin >= n) {
+                return;
+            }
+            std::size_t end = std::min(begin + chunkSize, n);
+            for (std::size_t i = begin; i < end && !interrupted; i++) {
+                try {
+                    f(worker, i);
+                    if (status != nullptr) {
+                        status[i] = 1;
+                    }
+                } catch (const geos::util::InterruptedException& e) {
+                    interruptMessage[worker] = e.what();
+                    interrupted = true;
+                } catch (const std::exception& e) {
+                    fail(worker, i, e.what());
+                } catch (...) {
+                    fail(worker, i, "Unknown exception thrown");
+                }
+            }
+            // interruption callbacks are only safe on the calling thread
+            if (worker == 0) {
+                try {
+                    GEOS_CHECK_FOR_INTERRUPTS();
+                } catch (const std::exception& e) {
+                    interruptMessage[worker] = e.what();
+                    interrupted = true;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(nThreads - 1);
+    for (std::size_t w = 1; w < nThreads; w++) {
+        try {
+            workers.emplace_back(work, w);
+        } catch (const std::system_error&) {
+            // out of threads: the running ones take the remaining items
+            break;
+        }
+    }
+    work(0);
+    for (auto& t : workers) {
+        t.join();
+    }
+
+    if (interrupted) {
+        for (const auto& msg : interruptMessage) {
+            if (!msg.empty()) {
+                handle->ERROR_MESSAGE("%s", msg.c_str());
+                break;
+            }
+        }
+        return 0;
+    }
+
+    auto first = std::min_element(failedItem.begin(), failedItem.end());
+    if (*first == n) {
+        return 1;
+    }
+    std::size_t worker = static_cast<std::size_t>(first - failedItem.begin());
+    handle->ERROR_MESSAGE("Batch item %zu: %s", *first, failedMessage[worker].c_str());
+    return 0;
+}
+
+typedef bool (*PreparedPredicate)(const geos::geom::prep::PreparedGeometry&, const Geometry*);
+
+// Map a GEOSPreparedPredicates value to the PreparedGeometry method
+inline PreparedPredicate getPreparedPredicate(int predicate) {
+    using geos::geom::prep::PreparedGeometry;
+    switch (predicate) {
+    case GEOS_PREP_CONTAINS:
+        return [](const PreparedGeometry& pg, const Geometry* g) { return pg.contains(g); };
+    case GEOS_PREP_CONTAINSPROPERLY:
+        return [](const PreparedGeometry& pg, const Geometry* g) { return pg.containsProperly(g); };
+    case GEOS_PREP_COVEREDBY:
+        return [](const PreparedGeometry& pg, const Geometry* g) { return pg.coveredBy(g); };
+    case GEOS_PREP_COVERS:
+        return [](const PreparedGeometry& pg, const Geometry* g) { return pg.covers(g); };
+    case GEOS_PREP_CROSSES:
+        return [](const PreparedGeometry& pg, const Geometry* g) { return pg.crosses(g); };
+    case GEOS_PREP_DISJOINT:
+        return [](const PreparedGeometry& pg, const Geometry* g) { return pg.disjoint(g); };
+    case GEOS_PREP_INTERSECTS:
+        return [](const PreparedGeometry& pg, const Geometry* g) { return pg.intersects(g); };
+    case GEOS_PREP_OVERLAPS:
+        return [](const PreparedGeometry& pg, const Geometry* g) { return pg.overlaps(g); };
+    case GEOS_PREP_TOUCHES:
+        return [](const PreparedGeometry& pg, const Geometry* g) { return pg.touches(g); };
+    case GEOS_PREP_WITHIN:
+        return [](const PreparedGeometry& pg, const Geometry* g) { return pg.within(g); };
+    default:
+        throw IllegalArgumentException("Unknown prepared predicate");
+    }
+}
+
+inline const Geometry* batchItem(const Geometry* const* geoms, std::size_t i) {
+    if (geoms[i] == nullptr) {
+        throw IllegalArgumentException("Null geometry");
+    }
+    return geoms[i];
+}
+
 extern "C" {
 
     GEOSContextHandle_t
@@ -704,6 +872,49 @@ extern "C" {
         });
     }
 
+    char
+    GEOSRelatePatternFast_r(GEOSContextHandle_t extHandle, const Geometry* g1, const Geometry* g2, const char* pat)
+    {
+        return execute(extHandle, 2, [&]() {
+            std::string s(pat);
+            return geos::operation::relate::RelatePredicateOp::relate(g1, g2, s);
+        });
+    }
+
+    char
+    GEOSRelatePredicateFast_r(GEOSContextHandle_t extHandle, const Geometry* g1, const Geometry* g2,
+                              enum GEOSPreparedPredicates predicate)
+    {
+        return execute(extHandle, 2, [&]() {
+            using geos::operation::relate::RelatePredicateOp;
+
+            switch (predicate) {
+            case GEOS_PREP_CONTAINS:
+                return RelatePredicateOp::contains(g1, g2);
+            case GEOS_PREP_CONTAINSPROPERLY:
+                return RelatePredicateOp::containsProperly(g1, g2);
+            case GEOS_PREP_COVEREDBY:
+                return RelatePredicateOp::coveredBy(g1, g2);
+            case GEOS_PREP_COVERS:
+                return RelatePredicateOp::covers(g1, g2);
+            case GEOS_PREP_CROSSES:
+                return RelatePredicateOp::crosses(g1, g2);
+            case GEOS_PREP_DISJOINT:
+                return RelatePredicateOp::disjoint(g1, g2);
+            case GEOS_PREP_INTERSECTS:
+                return RelatePredicateOp::intersects(g1, g2);
+            case GEOS_PREP_OVERLAPS:
+                return RelatePredicateOp::overlaps(g1, g2);
+            case GEOS_PREP_TOUCHES:
+                return RelatePredicateOp::touches(g1, g2);
+            case GEOS_PREP_WITHIN:
+                return RelatePredicateOp::within(g1, g2);
+            default:
+                throw IllegalArgumentException("Unknown predicate");
+            }
+        });
+    }
+
 
 
 //-----------------------------------------------------------------
@@ -1526,6 +1737,18 @@ extern "C" {
         });
     }
 
+    Geometry*
+    GEOSUnaryUnionParallel_r(GEOSContextHandle_t extHandle, const Geometry* g, unsigned int numThreads)
+    {
+        return execute(extHandle, [&]() {
+            geos::operation::geounion::UnaryUnionOp op(*g);
+            op.setNumThreads(numThreads);
+            std::unique_ptr<Geometry> g3(op.Union());
+            g3->setSRID(g->getSRID());
+            return g3.release();
+        });
+    }
+
     Geometry*
     GEOSUnaryUnionPrec_r(GEOSContextHandle_t extHandle, const Geometry* g1, double gridSize)
     {
@@ -3628,6 +3851,87 @@ extern "C" {
         });
     }
 
+//-----------------------------------------------------------------
+// Batch operations
+//-----------------------------------------------------------------
+
+    int
+    GEOSBatchBuffer_r(GEOSContextHandle_t extHandle,
+                      const Geometry* const* geoms, unsigned int ngeoms,
+                      double width, int quadsegs, unsigned int numThreads,
+                      Geometry** results, char* status)
+    {
+        std::fill(results, results + ngeoms, nullptr);
+        std::size_t nThreads = batchNumThreads(ngeoms, numThreads);
+
+        return executeBatch(extHandle, ngeoms, nThreads, status, [&](std::size_t, std::size_t i) {
+            const Geometry* g = batchItem(geoms, i);
+            auto g3 = g->buffer(width, quadsegs);
+            g3->setSRID(g->getSRID());
+            results[i] = g3.release();
+        });
+    }
+
+    int
+    GEOSBatchIntersection_r(GEOSContextHandle_t extHandle,
+                            const Geometry* const* geomsA, const Geometry* const* geomsB,
+                            unsigned int ngeoms, unsigned int numThreads,
+                            Geometry** results, char* status)
+    {
+        std::fill(results, results + ngeoms, nullptr);
+        std::size_t nThreads = batchNumThreads(ngeoms, numThreads);
+
+        return executeBatch(extHandle, ngeoms, nThreads, status, [&](std::size_t, std::size_t i) {
+            const Geometry* g1 = batchItem(geomsA, i);
+            auto g3 = g1->intersection(batchItem(geomsB, i));
+            g3->setSRID(g1->getSRID());
+            results[i] = g3.release();
+        });
+    }
+
+    int
+    GEOSBatchPreparedPredicate_r(GEOSContextHandle_t extHandle,
+                                 const geos::geom::prep::PreparedGeometry* pg,
+                                 enum GEOSPreparedPredicates predicate,
+                                 const Geometry* const* geoms, unsigned int ngeoms,
+                                 unsigned int numThreads, char* results)
+    {
+        std::fill(results, results + ngeoms, 2);
+
+        return execute(extHandle, 0, [&]() {
+            PreparedPredicate test = getPreparedPredicate(predicate);
+            std::size_t nThreads = batchNumThreads(ngeoms, numThreads);
+
+            // the lazily built indexes of a PreparedGeometry are not
+            // thread-safe: every other worker prepares its own copy
+            std::vector<std::unique_ptr<geos::geom::prep::PreparedGeometry>> prepared(nThreads);
+
+            return executeBatch(extHandle, ngeoms, nThreads, nullptr, [&](std::size_t worker, std::size_t i) {
+                const geos::geom::prep::PreparedGeometry* wpg = pg;
+                if (worker > 0) {
+                    if (!prepared[worker]) {
+                        prepared[worker] = geos::geom::prep::PreparedGeometryFactory::prepare(&pg->getGeometry());
+                    }
+                    wpg = prepared[worker].get();
+                }
+                results[i] = test(*wpg, batchItem(geoms, i));
+            });
+        });
+    }
+
+    int
+    GEOSBatchDistance_r(GEOSContextHandle_t extHandle,
+                        const Geometry* const* geomsA, const Geometry* const* geomsB,
+                        unsigned int ngeoms, unsigned int numThreads,
+                        double* distances, char* status)
+    {
+        std::size_t nThreads = batchNumThreads(ngeoms, numThreads);
+
+        return executeBatch(extHandle, ngeoms, nThreads, status, [&](std::size_t, std::size_t i) {
+            distances[i] = batchItem(geomsA, i)->distance(batchItem(geomsB, i));
+        });
+    }
+
 //-----------------------------------------------------------------
 // STRtree
 //-----------------------------------------------------------------
@@ -3760,6 +4064,67 @@ extern "C" {
         });
     }
 
+    unsigned char*
+    GEOSSTRtree_serialize_r(GEOSContextHandle_t extHandle,
+                            GEOSSTRtree* tree,
+                            GEOSSTRtreeItemIdCallback idfn,
+                            void* userdata,
+                            std::size_t* size)
+    {
+        using geos::index::strtree::FlatSTRtree;
+
+        return execute(extHandle, [&]() {
+            std::vector<unsigned char> buf = FlatSTRtree::serialize(*tree, [idfn, userdata](const void* item) {
+                if (idfn) {
+                    return static_cast<FlatSTRtree::ItemId>(idfn(item, userdata));
+                }
+                return static_cast<FlatSTRtree::ItemId>(reinterpret_cast<std::uintptr_t>(item));
+            });
+
+            unsigned char* result = static_cast<unsigned char*>(malloc(buf.size()));
+            if (result == nullptr) {
+                throw std::bad_alloc();
+            }
+            std::memcpy(result, buf.data(), buf.size());
+            *size = buf.size();
+            return result;
+        });
+    }
+
+    GEOSSTRtreeView*
+    GEOSSTRtree_view_r(GEOSContextHandle_t extHandle,
+                       const unsigned char* data,
+                       std::size_t size)
+    {
+        return execute(extHandle, [&]() {
+            return new GEOSSTRtreeView(data, size);
+        });
+    }
+
+    int
+    GEOSSTRtree_queryView_r(GEOSContextHandle_t extHandle,
+                            const GEOSSTRtreeView* view,
+                            const geos::geom::Geometry* g,
+                            GEOSQueryCallback callback,
+                            void* userdata)
+    {
+        return execute(extHandle, 0, [&]() {
+            view->query(*g->getEnvelopeInternal(), [callback, userdata](std::uint64_t id) {
+                callback(reinterpret_cast<void*>(static_cast<std::uintptr_t>(id)), userdata);
+            });
+            return 1;
+        });
+    }
+
+    void
+    GEOSSTRtree_destroyView_r(GEOSContextHandle_t extHandle,
+                              GEOSSTRtreeView* view)
+    {
+        return execute(extHandle, [&]() {
+            delete view;
+        });
+    }
+
     double
     GEOSProject_r(GEOSContextHandle_t extHandle,
                   const Geometry* g,
@@ -4042,6 +4407,19 @@ extern "C" {
         });
     }
 
+    Geometry*
+    GEOSBufferParallel_r(GEOSContextHandle_t extHandle, const Geometry* g1, const BufferParameters* bp,
+                         double width, unsigned int numThreads)
+    {
+        using geos::operation::buffer::ParallelBufferOp;
+
+        return execute(extHandle, [&]() {
+            std::unique_ptr<Geometry> g3 = ParallelBufferOp::bufferOp(g1, width, *bp, numThreads);
+            g3->setSRID(g1->getSRID());
+            return g3.release();
+        });
+    }
+
     Geometry*
     GEOSDelaunayTriangulation_r(GEOSContextHandle_t extHandle, const Geometry* g1, double tolerance, int onlyEdges)
     {
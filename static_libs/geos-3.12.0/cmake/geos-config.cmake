@@ -8,4 +8,6 @@
 # by the Free Software Foundation.
 # See the COPYING file for more information.
 ################################################################################
+include(CMakeFindDependencyMacro)
+find_dependency(Threads)
 include("${CMAKE_CURRENT_LIST_DIR}/geos-targets.cmake")
@@ -0,0 +1,100 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/export.h>
+
+#include <cstddef>
+
+namespace geos {
+namespace algorithm { // geos::algorithm
+
+/** \brief
+ * Screening predicates evaluated on BATCH_SIZE inputs at once.
+ *
+ * The inputs are passed as separate arrays of BATCH_SIZE x and y values.
+ * The kernels use SIMD instructions where the target has them
+ * (SSE2 or AVX on x86-64, NEON on arm64) and plain loops otherwise.
+ *
+ * They only compute what can be decided with the fast double precision
+ * filters: lanes which need more are reported as such, so that callers
+ * resolve them with the exact scalar code, in the same order as before.
+ */
+class GEOS_DLL BatchPredicates {
+
+public:
+
+    static constexpr std::size_t BATCH_SIZE = 4;
+
+    /// Tests whether the kernels were compiled with SIMD instructions.
+    static bool isVectorized();
+
+    /** \brief
+     * Computes CGAlgorithmsDD::orientationIndexFilter() of the
+     * triples (`p1[i]`, `p2[i]`, `q[i]`).
+     *
+     * Lanes which cannot be decided safely in double precision, or
+     * whose `q` is not finite, are set to CGAlgorithmsDD::FAILURE.
+     *
+     * @return true if any lane is set to CGAlgorithmsDD::FAILURE
+     */
+    static bool orientationIndexFilter(
+        const double* p1x, const double* p1y,
+        const double* p2x, const double* p2y,
+        const double* qx, const double* qy,
+        int* orient);
+
+    /** \brief
+     * Computes CGAlgorithmsDD::orientationIndex() of the triples
+     * (`p1[i]`, `p2[i]`, `q[i]`), using extended precision for the
+     * ambiguous lanes only.
+     *
+     * @throws util::IllegalArgumentException if a `q` is not finite
+     */
+    static void orientationIndex(
+        const double* p1x, const double* p1y,
+        const double* p2x, const double* p2y,
+        const double* qx, const double* qy,
+        int* orient);
+
+    /** \brief
+     * Tests the envelopes of the segments `p1[i]-p2[i]` and `q1[i]-q2[i]`
+     * for intersection, each allowed to be `tolerance` apart.
+     *
+     * @return a mask with bit `i` set when the envelopes of pair `i` intersect
+     */
+    static unsigned segmentEnvelopesIntersect(
+        const double* p1x, const double* p1y,
+        const double* p2x, const double* p2y,
+        const double* q1x, const double* q1y,
+        const double* q2x, const double* q2y,
+        double tolerance);
+
+    /** \brief
+     * Screens consecutive ring segments against the horizontal ray
+     * extending to the right of (`px`, `py`).
+     *
+     * Segment `i` runs from vertex `i` to vertex `i + 1`, so the arrays
+     * hold BATCH_SIZE + 1 vertices.
+     *
+     * @return a mask with bit `i` set unless segment `i` is known to leave
+     *         RayCrossingCounter::countSegment() without effect
+     */
+    static unsigned rayCrossingCandidates(const double* x, const double* y,
+                                          double px, double py);
+
+};
+
+} // namespace geos::algorithm
+} // namespace geos
+
@@ -29,6 +29,7 @@
 #include <geos/util/IllegalArgumentException.h>
 #include <geos/export.h>
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <cassert>
@@ -463,7 +464,8 @@ private:
     PrecisionModel precisionModel;
     int SRID;
 
-    mutable int _refCount;
+    // geometries of one factory may be created and destroyed concurrently
+    mutable std::atomic<int> _refCount;
     bool _autoDestroy;
 
     friend class Geometry;
@@ -193,6 +193,16 @@ public:
         }
     }
 
+    /**
+     * Pre-allocate storage for a tree of `itemCapacity` items, so that
+     * neither the insertions nor the build reallocate the node storage.
+     */
+    void reserve(std::size_t itemCapacity) {
+        if (!built()) {
+            nodes.reserve(treeSize(itemCapacity));
+        }
+    }
+
     /// @}
     /// \defgroup NN Nearest-neighbor
     /// @{
@@ -307,6 +317,26 @@ public:
         }
     }
 
+    // Query the tree for all pairs whose bounds intersect, restricted to the
+    // pairs whose first item is held by a leaf in the range [begin, end) of
+    // the packed leaf order (0 <= begin <= end <= size()).
+    // Visiting consecutive ranges in order produces exactly the sequence of
+    // pairs produced by queryPairs(visitor). The tree must already be built;
+    // it is not modified, so disjoint ranges may be visited concurrently.
+    template<typename Visitor>
+    void queryPairs(std::size_t begin, std::size_t end, Visitor&& visitor) {
+        assert(built() || nodes.empty());
+
+        if (numItems < 2) {
+            return;
+        }
+
+        end = std::min(end, numItems);
+        for (std::size_t i = begin; i < end; i++) {
+            queryPairs(nodes[i], *root, visitor);
+        }
+    }
+
     // Query the tree and collect items in the provided vector.
     void query(const BoundsType& queryEnv, std::vector<ItemType>& results) {
         query(queryEnv, [&results](const ItemType& x) {
@@ -367,6 +397,11 @@ public:
         return root != nullptr;
     }
 
+    /** Return the number of items held by the tree (the leaves once built). */
+    std::size_t size() const {
+        return built() ? numItems : nodes.size();
+    }
+
     /** Determine whether the tree has been built, and no more items may be added. */
     const Node* getRoot() {
         build();
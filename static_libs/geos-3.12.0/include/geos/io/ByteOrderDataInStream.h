@@ -25,6 +25,7 @@
 #include <geos/util/Machine.h> // for getMachineByteOrder
 
 #include <cstdint>
+#include <cstring>
 #include <iosfwd> // ostream, istream (if we remove inlines)
 
 namespace geos {
@@ -108,6 +109,29 @@ public:
         return ret;
     };
 
+    /**
+     * Reads `n` doubles into `out`. When the stream is in the byte order
+     * of the machine, they are copied in a single block.
+     */
+    void readDoubles(double* out, size_t n)
+    {
+        if(n > size() / 8) {
+            throw  ParseException("Unexpected EOF parsing WKB");
+        }
+        if(n == 0) {
+            return;
+        }
+        if(byteOrder == getMachineByteOrder()) {
+            std::memcpy(out, buf, n * 8);
+            buf += n * 8;
+            return;
+        }
+        for(size_t i = 0; i < n; i++) {
+            out[i] = ByteOrderValues::getDouble(buf, byteOrder);
+            buf += 8;
+        }
+    };
+
     size_t size() const
     {
         return static_cast<size_t>(end - buf);
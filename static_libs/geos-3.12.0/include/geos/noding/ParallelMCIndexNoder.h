@@ -0,0 +1,125 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/export.h>
+
+#include <geos/index/chain/MonotoneChain.h>
+#include <geos/index/strtree/TemplateSTRtree.h> // for composition
+#include <geos/noding/NodedSegmentString.h>
+#include <geos/noding/SegmentString.h>
+#include <geos/noding/SinglePassNoder.h> // for inheritance
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+namespace noding {
+class SegmentIntersector;
+}
+}
+
+namespace geos {
+namespace noding { // geos.noding
+
+/** \brief
+ * Nodes a set of SegmentString like MCIndexNoder, searching for
+ * overlapping [MonotoneChains](@ref index::chain::MonotoneChain)
+ * on several threads.
+ *
+ * The chains are packed into a STRtree as usual.  The packed leaf order
+ * groups them into spatially compact tiles of TILE_SIZE chains; each tile
+ * is queried against the whole index (so chains overlapping a neighbouring
+ * tile are found as well) on a pool of worker threads, which only collect
+ * the candidate segment pairs.
+ *
+ * The candidates are then handed to the SegmentIntersector on the calling
+ * thread, tile after tile, in exactly the order MCIndexNoder would have
+ * produced them: the SegmentIntersector itself does not need to be
+ * thread-safe, and the computed nodes are bit-identical to the serial noder.
+ * When the SegmentIntersector is an IntersectionAdder the workers also
+ * discard the candidate pairs which do not intersect at all (which
+ * IntersectionAdder would ignore anyway, apart from its test counter).
+ *
+ * Inputs having fewer than MIN_PARALLEL_CHAINS chains, or a thread count
+ * of 1, are noded serially.
+ */
+class GEOS_DLL ParallelMCIndexNoder : public SinglePassNoder {
+
+public:
+
+    /// Number of packed chains making up one unit of work
+    static constexpr std::size_t TILE_SIZE = 256;
+
+    /// Below this number of chains the noding runs on the calling thread
+    static constexpr std::size_t MIN_PARALLEL_CHAINS = 4 * TILE_SIZE;
+
+    /**
+     * Creates a noder.
+     *
+     * @param nSegInt the SegmentIntersector to use
+     * @param p_overlapTolerance expansion of the chain envelopes
+     * @param p_numThreads number of threads to use, including the
+     *        calling one; 0 uses the number of hardware threads
+     */
+    ParallelMCIndexNoder(SegmentIntersector* nSegInt = nullptr,
+                         double p_overlapTolerance = 0.0,
+                         std::size_t p_numThreads = 0);
+
+    ~ParallelMCIndexNoder() override {};
+
+    void setNumThreads(std::size_t p_numThreads);
+
+    std::size_t getNumThreads() const
+    {
+        return numThreads;
+    }
+
+    std::vector<SegmentString*>* getNodedSubstrings() const override
+    {
+        assert(nodedSegStrings); // must have called computeNodes before!
+        return NodedSegmentString::getNodedSubstrings(*nodedSegStrings);
+    }
+
+    void computeNodes(std::vector<SegmentString*>* inputSegmentStrings) override;
+
+private:
+
+    std::vector<index::chain::MonotoneChain> monoChains;
+    index::strtree::TemplateSTRtree<const index::chain::MonotoneChain*> index;
+    std::vector<SegmentString*>* nodedSegStrings;
+    double overlapTolerance;
+    std::size_t numThreads;
+
+    void intersectChains();
+
+    void intersectChainsParallel(std::size_t nThreads);
+
+    // Declare type as noncopyable
+    ParallelMCIndexNoder(const ParallelMCIndexNoder& other) = delete;
+    ParallelMCIndexNoder& operator=(const ParallelMCIndexNoder& rhs) = delete;
+};
+
+} // namespace geos.noding
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
@@ -0,0 +1,150 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/export.h>
+#include <geos/operation/buffer/BufferParameters.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+namespace geom {
+class Geometry;
+class GeometryFactory;
+}
+}
+
+namespace geos {
+namespace operation { // geos.operation
+namespace buffer { // geos.operation.buffer
+
+/** \brief
+ * Computes the buffer of a multi-part geometry, or of an array of
+ * geometries, by buffering independent groups of parts separately,
+ * on several threads.
+ *
+ * The parts whose buffers cannot interact are found from their envelopes:
+ * no point of a buffer is further from the envelope of its part than the
+ * buffer distance (times the mitre limit for mitred joins, or times
+ * sqrt(2) for square end caps), so parts whose envelopes are further apart
+ * than twice that reach have disjoint buffers. The parts are clustered
+ * accordingly (see cluster::EnvelopeDistanceClusterFinder), and each
+ * cluster is buffered with BufferOp, which unions the buffers of the parts
+ * that do interact. The polygons of the cluster buffers are then collected
+ * into the result, in cluster order, with no further overlay.
+ *
+ * When the parts are widely separated this noding and polygonizing of
+ * many small inputs is much cheaper than that of the whole geometry, even
+ * on a single thread. When they all form a single cluster, the input is
+ * buffered by BufferOp as usual.
+ *
+ * The result covers the same area as the buffer computed by BufferOp,
+ * but its polygons may be ordered differently.
+ */
+class GEOS_DLL ParallelBufferOp {
+
+public:
+
+    /**
+     * Initializes a buffer computation for the given geometry.
+     *
+     * @param g the geometry to buffer
+     * @param params the buffer parameters to use
+     */
+    ParallelBufferOp(const geom::Geometry* g, const BufferParameters& params);
+
+    /**
+     * Initializes a computation of the union of the buffers of an array
+     * of geometries.
+     *
+     * @param geoms the geometries to buffer
+     * @param geomFact the factory of the result
+     * @param params the buffer parameters to use
+     */
+    ParallelBufferOp(const std::vector<const geom::Geometry*>& geoms,
+                     const geom::GeometryFactory& geomFact,
+                     const BufferParameters& params);
+
+    /**
+     * Sets the number of threads buffering the clusters; 0 uses the
+     * number of hardware threads. Default is 1.
+     * The result does not depend on this setting.
+     *
+     * @param p_numThreads the number of threads
+     */
+    void setNumThreads(std::size_t p_numThreads);
+
+    /** \brief
+     * Returns the buffer computed for the input for a given buffer
+     * distance.
+     *
+     * @param distance the buffer distance
+     * @return the buffer of the input
+     */
+    std::unique_ptr<geom::Geometry> getResultGeometry(double distance);
+
+    /**
+     * Computes the buffer of a geometry, see getResultGeometry().
+     *
+     * @param g the geometry to buffer
+     * @param distance the buffer distance
+     * @param params the buffer parameters to use
+     * @param numThreads the number of threads, 0 for all hardware threads
+     * @return the buffer of the input geometry
+     */
+    static std::unique_ptr<geom::Geometry> bufferOp(const geom::Geometry* g,
+            double distance, const BufferParameters& params, std::size_t numThreads);
+
+private:
+
+    std::vector<const geom::Geometry*> inputGeoms;
+    const geom::GeometryFactory* geomFact;
+    BufferParameters bufParams;
+    std::size_t numThreads;
+
+    /**
+     * Returns how far from the envelope of a part its buffer may extend.
+     */
+    double bufferReach(double distance) const;
+
+    static void extractComponents(const geom::Geometry* g,
+                                  std::vector<const geom::Geometry*>& components);
+
+    std::unique_ptr<geom::Geometry> bufferInput(double distance) const;
+
+    std::unique_ptr<geom::Geometry> bufferCluster(
+        const std::vector<const geom::Geometry*>& clusterGeoms, double distance) const;
+
+    std::vector<std::unique_ptr<geom::Geometry>> bufferClusters(
+        const std::vector<std::vector<const geom::Geometry*>>& clusters, double distance) const;
+
+    // Declare type as noncopyable
+    ParallelBufferOp(const ParallelBufferOp& other) = delete;
+    ParallelBufferOp& operator=(const ParallelBufferOp& rhs) = delete;
+};
+
+} // namespace geos.operation.buffer
+} // namespace geos.operation
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
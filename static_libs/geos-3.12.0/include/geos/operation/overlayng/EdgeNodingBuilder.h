@@ -35,6 +35,7 @@
 #include <geos/noding/MCIndexNoder.h>
 #include <geos/noding/Noder.h>
 #include <geos/noding/NodedSegmentString.h>
+#include <geos/noding/ParallelMCIndexNoder.h>
 #include <geos/noding/SegmentString.h>
 #include <geos/noding/ValidatingNoder.h>
 #include <geos/noding/snapround/SnapRoundingNoder.h>
@@ -45,6 +46,7 @@
 #include <geos/operation/overlayng/OverlayUtil.h>
 #include <geos/operation/overlayng/RingClipper.h>
 #include <geos/operation/valid/RepeatedPointRemover.h>
+#include <geos/util/Arena.h>
 
 
 #include <geos/export.h>
@@ -100,10 +102,13 @@ private:
     std::unique_ptr<Noder> internalNoder;
     std::unique_ptr<Noder> spareInternalNoder;
     // EdgeSourceInfo*, Edge* owned by EdgeNodingBuilder, stored in deque
-    std::deque<EdgeSourceInfo> edgeSourceInfoQue;
-    std::deque<Edge> edgeQue;
+    // drawing from an arena freed with the builder
+    geos::util::Arena arena;
+    std::deque<EdgeSourceInfo, geos::util::ArenaAllocator<EdgeSourceInfo>> edgeSourceInfoQue;
+    std::deque<Edge, geos::util::ArenaAllocator<Edge>> edgeQue;
     bool inputHasZ;
     bool inputHasM;
+    std::size_t numThreads;
 
     /**
     * Gets a noder appropriate for the precision model supplied.
@@ -203,8 +208,11 @@ public:
         , hasEdges{{false,false}}
         , clipEnv(nullptr)
         , intAdder(lineInt)
+        , edgeSourceInfoQue(geos::util::ArenaAllocator<EdgeSourceInfo>(arena))
+        , edgeQue(geos::util::ArenaAllocator<Edge>(arena))
         , inputHasZ(false)
         , inputHasM(false)
+        , numThreads(1)
         {};
 
     ~EdgeNodingBuilder()
@@ -216,6 +224,15 @@ public:
 
     void setClipEnvelope(const Envelope* clipEnv);
 
+    /**
+    * Sets the number of threads used by the floating precision noder
+    * (see {@link noding::ParallelMCIndexNoder}); 0 uses the number of
+    * hardware threads.
+    * Default is 1 (serial {@link noding::MCIndexNoder}).
+    * The noded edges do not depend on this setting.
+    */
+    void setNumThreads(std::size_t p_numThreads) { numThreads = p_numThreads; }
+
     // returns newly allocated vector and segmentstrings
     // std::vector<SegmentString*>* node();
 
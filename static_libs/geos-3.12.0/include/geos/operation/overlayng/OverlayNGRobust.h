@@ -153,6 +153,19 @@ public:
     static std::unique_ptr<Geometry> Overlay(
         const Geometry* geom0, const Geometry* geom1, int opCode);
 
+    /**
+    * Overlays two geometries like Overlay(geom0, geom1, opCode),
+    * noding the edges of the initial floating precision attempt on
+    * several threads (see {@link noding::ParallelMCIndexNoder}).
+    * The result is identical to the serial one.
+    *
+    * @param numThreads the number of threads; 0 uses the number of
+    *        hardware threads, 1 is the same as the serial overlay
+    */
+    static std::unique_ptr<Geometry> Overlay(
+        const Geometry* geom0, const Geometry* geom1, int opCode,
+        std::size_t numThreads);
+
     static std::unique_ptr<Geometry> overlaySnapTries(
         const Geometry* geom0, const Geometry* geom1, int opCode);
 
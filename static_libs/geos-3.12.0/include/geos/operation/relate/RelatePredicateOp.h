@@ -0,0 +1,111 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#pragma once
+
+#include <geos/export.h>
+
+#include <string>
+
+// Forward declarations
+namespace geos {
+namespace geom {
+class Geometry;
+}
+}
+
+namespace geos {
+namespace operation { // geos::operation
+namespace relate { // geos::operation::relate
+
+/** \brief
+ * Evaluates a DE-9IM predicate between two geometries, stopping as soon
+ * as its outcome is known.
+ *
+ * Unlike RelateOp, which builds both geometry graphs and labels them fully
+ * before the predicate is looked at, the matrix is refined step by step
+ * from cheap to expensive evidence, and the evaluation stops as soon as
+ * every cell the predicate depends on is decided:
+ *
+ * - the envelopes and the dimensions of the inputs,
+ * - the location of points and line endpoints in the other geometry,
+ * - the intersections between the segments of the two geometries,
+ *   found with a monotone chain index and without self-noding,
+ * - the location of the pieces of segments between these intersections.
+ *
+ * The results are the same as those of the corresponding
+ * geom::Geometry methods, under the Mod-2 boundary node rule.
+ * Polygonal inputs are assumed to be valid.
+ * Empty geometries and geometry collections are passed to RelateOp.
+ */
+class GEOS_DLL RelatePredicateOp {
+
+public:
+
+    /** \brief
+     * Tests whether the DE-9IM matrix of `a` and `b` matches a pattern.
+     *
+     * @param a a Geometry
+     * @param b a Geometry
+     * @param pattern a pattern of nine characters among `T`, `F`, `*`,
+     *        `0`, `1` and `2`
+     * @return true if the matrix matches the pattern
+     * @throws util::IllegalArgumentException if the pattern is not
+     *         nine characters long
+     */
+    static bool relate(const geom::Geometry* a, const geom::Geometry* b,
+                       const std::string& pattern);
+
+    /// \see geom::Geometry::intersects()
+    static bool intersects(const geom::Geometry* a, const geom::Geometry* b);
+
+    /// \see geom::Geometry::disjoint()
+    static bool disjoint(const geom::Geometry* a, const geom::Geometry* b);
+
+    /// \see geom::Geometry::touches()
+    static bool touches(const geom::Geometry* a, const geom::Geometry* b);
+
+    /// \see geom::Geometry::crosses()
+    static bool crosses(const geom::Geometry* a, const geom::Geometry* b);
+
+    /// \see geom::Geometry::within()
+    static bool within(const geom::Geometry* a, const geom::Geometry* b);
+
+    /// \see geom::Geometry::contains()
+    static bool contains(const geom::Geometry* a, const geom::Geometry* b);
+
+    /// \see geom::Geometry::overlaps()
+    static bool overlaps(const geom::Geometry* a, const geom::Geometry* b);
+
+    /// \see geom::Geometry::covers()
+    static bool covers(const geom::Geometry* a, const geom::Geometry* b);
+
+    /// \see geom::Geometry::coveredBy()
+    static bool coveredBy(const geom::Geometry* a, const geom::Geometry* b);
+
+    /// \see geom::Geometry::equals()
+    static bool equals(const geom::Geometry* a, const geom::Geometry* b);
+
+    /** \brief
+     * Tests whether `b` lies in the interior of `a`, so that the boundaries
+     * do not meet (DE-9IM pattern `T**FF*FF*`).
+     *
+     * \see geom::prep::PreparedGeometry::containsProperly()
+     */
+    static bool containsProperly(const geom::Geometry* a, const geom::Geometry* b);
+
+};
+
+} // namespace geos::operation::relate
+} // namespace geos::operation
+} // namespace geos
+
@@ -114,6 +114,7 @@ public:
     UnaryUnionOp(const T& geoms, geom::GeometryFactory& geomFactIn)
         : geomFact(&geomFactIn)
         , unionFunction(&defaultUnionFunction)
+        , numThreads(1)
     {
         extractGeoms(geoms);
     }
@@ -122,6 +123,7 @@ public:
     UnaryUnionOp(const T& geoms)
         : geomFact(nullptr)
         , unionFunction(&defaultUnionFunction)
+        , numThreads(1)
     {
         extractGeoms(geoms);
     }
@@ -129,6 +131,7 @@ public:
     UnaryUnionOp(const geom::Geometry& geom)
         : geomFact(geom.getFactory())
         , unionFunction(&defaultUnionFunction)
+        , numThreads(1)
     {
         extract(geom);
     }
@@ -138,6 +141,19 @@ public:
         unionFunction = unionFun;
     }
 
+    /**
+     * Sets the number of threads unioning the polygonal components
+     * (see CascadedPolygonUnion::setNumThreads()); 0 uses the number
+     * of hardware threads. Default is 1.
+     * The result does not depend on this setting.
+     *
+     * @param p_numThreads the number of threads
+     */
+    void setNumThreads(std::size_t p_numThreads)
+    {
+        numThreads = p_numThreads;
+    }
+
     /**
      * \brief
      * Gets the union of the input geometries.
@@ -225,6 +241,7 @@ private:
 
     UnionStrategy* unionFunction;
     ClassicUnionStrategy defaultUnionFunction;
+    std::size_t numThreads;
 
 };
 
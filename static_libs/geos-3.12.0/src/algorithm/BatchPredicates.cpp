@@ -0,0 +1,284 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/algorithm/BatchPredicates.h>
+#include <geos/algorithm/CGAlgorithmsDD.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GEOS_BATCH_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOS_BATCH_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define GEOS_BATCH_NEON 1
+#endif
+
+namespace geos {
+namespace algorithm { // geos::algorithm
+
+namespace {
+
+/*
+ * A few lane-wise operations on doubles, with the same names on every
+ * target. Comparisons are ordered: they are false when a lane is NaN,
+ * like the scalar ones. min(b, a) and max(b, a) return the same lane
+ * values as std::min(a, b) and std::max(a, b).
+ */
+#if defined(GEOS_BATCH_AVX)
+
+constexpr std::size_t WIDTH = 4;
+typedef __m256d Vec;
+typedef __m256d Mask;
+
+inline Vec load(const double* p) { return _mm256_loadu_pd(p); }
+inline Vec set1(double d) { return _mm256_set1_pd(d); }
+inline Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+inline Vec sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+inline Vec mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+inline Vec vmin(Vec a, Vec b) { return _mm256_min_pd(a, b); }
+inline Vec vmax(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+inline Vec vabs(Vec a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+inline Mask gt(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+inline Mask ge(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+inline Mask lt(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+inline Mask le(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+inline Mask eq(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+inline Mask mand(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+inline Mask mor(Mask a, Mask b) { return _mm256_or_pd(a, b); }
+inline Mask mxor(Mask a, Mask b) { return _mm256_xor_pd(a, b); }
+inline Mask mandnot(Mask a, Mask b) { return _mm256_andnot_pd(a, b); }
+inline unsigned bits(Mask m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+
+#elif defined(GEOS_BATCH_SSE2)
+
+constexpr std::size_t WIDTH = 2;
+typedef __m128d Vec;
+typedef __m128d Mask;
+
+inline Vec load(const double* p) { return _mm_loadu_pd(p); }
+inline Vec set1(double d) { return _mm_set1_pd(d); }
+inline Vec add(Vec a, Vec b) { return _mm_add_pd(a, b); }
+inline Vec sub(Vec a, Vec b) { return _mm_sub_pd(a, b); }
+inline Vec mul(Vec a, Vec b) { return _mm_mul_pd(a, b); }
+inline Vec vmin(Vec a, Vec b) { return _mm_min_pd(a, b); }
+inline Vec vmax(Vec a, Vec b) { return _mm_max_pd(a, b); }
+inline Vec vabs(Vec a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+inline Mask gt(Vec a, Vec b) { return _mm_cmpgt_pd(a, b); }
+inline Mask ge(Vec a, Vec b) { return _mm_cmpge_pd(a, b); }
+inline Mask lt(Vec a, Vec b) { return _mm_cmplt_pd(a, b); }
+inline Mask le(Vec a, Vec b) { return _mm_cmple_pd(a, b); }
+inline Mask eq(Vec a, Vec b) { return _mm_cmpeq_pd(a, b); }
+inline Mask mand(Mask a, Mask b) { return _mm_and_pd(a, b); }
+inline Mask mor(Mask a, Mask b) { return _mm_or_pd(a, b); }
+inline Mask mxor(Mask a, Mask b) { return _mm_xor_pd(a, b); }
+inline Mask mandnot(Mask a, Mask b) { return _mm_andnot_pd(a, b); }
+inline unsigned bits(Mask m) { return static_cast<unsigned>(_mm_movemask_pd(m)); }
+
+#elif defined(GEOS_BATCH_NEON)
+
+constexpr std::size_t WIDTH = 2;
+typedef float64x2_t Vec;
+typedef uint64x2_t Mask;
+
+inline Vec load(const double* p) { return vld1q_f64(p); }
+inline Vec set1(double d) { return vdupq_n_f64(d); }
+inline Vec add(Vec a, Vec b) { return vaddq_f64(a, b); }
+inline Vec sub(Vec a, Vec b) { return vsubq_f64(a, b); }
+inline Vec mul(Vec a, Vec b) { return vmulq_f64(a, b); }
+// NaN lanes propagate: the screens only get less selective
+inline Vec vmin(Vec a, Vec b) { return vminq_f64(a, b); }
+inline Vec vmax(Vec a, Vec b) { return vmaxq_f64(a, b); }
+inline Vec vabs(Vec a) { return vabsq_f64(a); }
+inline Mask gt(Vec a, Vec b) { return vcgtq_f64(a, b); }
+inline Mask ge(Vec a, Vec b) { return vcgeq_f64(a, b); }
+inline Mask lt(Vec a, Vec b) { return vcltq_f64(a, b); }
+inline Mask le(Vec a, Vec b) { return vcleq_f64(a, b); }
+inline Mask eq(Vec a, Vec b) { return vceqq_f64(a, b); }
+inline Mask mand(Mask a, Mask b) { return vandq_u64(a, b); }
+inline Mask mor(Mask a, Mask b) { return vorrq_u64(a, b); }
+inline Mask mxor(Mask a, Mask b) { return veorq_u64(a, b); }
+inline Mask mandnot(Mask a, Mask b) { return vbicq_u64(b, a); }
+inline unsigned bits(Mask m)
+{
+    return static_cast<unsigned>((vgetq_lane_u64(m, 0) >> 63) | ((vgetq_lane_u64(m, 1) >> 63) << 1));
+}
+
+#else
+
+constexpr std::size_t WIDTH = 1;
+typedef double Vec;
+typedef bool Mask;
+
+inline Vec load(const double* p) { return *p; }
+inline Vec set1(double d) { return d; }
+inline Vec add(Vec a, Vec b) { return a + b; }
+inline Vec sub(Vec a, Vec b) { return a - b; }
+inline Vec mul(Vec a, Vec b) { return a * b; }
+inline Vec vmin(Vec a, Vec b) { return a < b ? a : b; }
+inline Vec vmax(Vec a, Vec b) { return a > b ? a : b; }
+inline Vec vabs(Vec a) { return a < 0 ? -a : a; }
+inline Mask gt(Vec a, Vec b) { return a > b; }
+inline Mask ge(Vec a, Vec b) { return a >= b; }
+inline Mask lt(Vec a, Vec b) { return a < b; }
+inline Mask le(Vec a, Vec b) { return a <= b; }
+inline Mask eq(Vec a, Vec b) { return a == b; }
+inline Mask mand(Mask a, Mask b) { return a && b; }
+inline Mask mor(Mask a, Mask b) { return a || b; }
+inline Mask mxor(Mask a, Mask b) { return a != b; }
+inline Mask mandnot(Mask a, Mask b) { return !a && b; }
+inline unsigned bits(Mask m) { return m ? 1u : 0u; }
+
+#endif
+
+static_assert(BatchPredicates::BATCH_SIZE % WIDTH == 0, "batch must be a whole number of vectors");
+
+} // anonymous namespace
+
+/*public static*/
+bool
+BatchPredicates::isVectorized()
+{
+    return WIDTH > 1;
+}
+
+/*public static*/
+bool
+BatchPredicates::orientationIndexFilter(
+    const double* p1x, const double* p1y,
+    const double* p2x, const double* p2y,
+    const double* qx, const double* qy,
+    int* orient)
+{
+    // same bound as CGAlgorithmsDD::orientationIndexFilter
+    const Vec eps = set1(1e-15);
+    const Vec zero = set1(0.0);
+    bool anyFailed = false;
+
+    for (std::size_t k = 0; k < BATCH_SIZE; k += WIDTH) {
+        Vec pax = load(p1x + k);
+        Vec pay = load(p1y + k);
+        Vec pbx = load(p2x + k);
+        Vec pby = load(p2y + k);
+        Vec pcx = load(qx + k);
+        Vec pcy = load(qy + k);
+
+        Vec detleft = mul(sub(pax, pcx), sub(pby, pcy));
+        Vec detright = mul(sub(pay, pcy), sub(pbx, pcx));
+        Vec det = sub(detleft, detright);
+
+        // the sign of det is safe when the two products have
+        // different signs, or when det exceeds the error bound
+        Mask decided = mor(mor(mand(gt(detleft, zero), le(detright, zero)),
+                               mand(lt(detleft, zero), ge(detright, zero))),
+                           mor(eq(detleft, zero),
+                               ge(vabs(det), mul(eps, add(vabs(detleft), vabs(detright))))));
+        // non finite points are left to the scalar code, which rejects them
+        Mask finite = mand(eq(sub(pcx, pcx), zero), eq(sub(pcy, pcy), zero));
+
+        unsigned ok = bits(mand(decided, finite));
+        unsigned pos = bits(gt(det, zero));
+        unsigned neg = bits(lt(det, zero));
+        for (std::size_t j = 0; j < WIDTH; j++) {
+            if (ok & (1u << j)) {
+                orient[k + j] = static_cast<int>((pos >> j) & 1u) - static_cast<int>((neg >> j) & 1u);
+            }
+            else {
+                orient[k + j] = CGAlgorithmsDD::FAILURE;
+                anyFailed = true;
+            }
+        }
+    }
+    return anyFailed;
+}
+
+/*public static*/
+void
+BatchPredicates::orientationIndex(
+    const double* p1x, const double* p1y,
+    const double* p2x, const double* p2y,
+    const double* qx, const double* qy,
+    int* orient)
+{
+    if (!orientationIndexFilter(p1x, p1y, p2x, p2y, qx, qy, orient)) {
+        return;
+    }
+    for (std::size_t i = 0; i < BATCH_SIZE; i++) {
+        if (orient[i] == CGAlgorithmsDD::FAILURE) {
+            orient[i] = CGAlgorithmsDD::orientationIndex(p1x[i], p1y[i], p2x[i], p2y[i], qx[i], qy[i]);
+        }
+    }
+}
+
+/*public static*/
+unsigned
+BatchPredicates::segmentEnvelopesIntersect(
+    const double* p1x, const double* p1y,
+    const double* p2x, const double* p2y,
+    const double* q1x, const double* q1y,
+    const double* q2x, const double* q2y,
+    double tolerance)
+{
+    const Vec tol = set1(tolerance);
+    unsigned result = 0;
+
+    for (std::size_t k = 0; k < BATCH_SIZE; k += WIDTH) {
+        Vec ax = load(p1x + k);
+        Vec bx = load(p2x + k);
+        Vec cx = load(q1x + k);
+        Vec dx = load(q2x + k);
+        Vec ay = load(p1y + k);
+        Vec by = load(p2y + k);
+        Vec cy = load(q1y + k);
+        Vec dy = load(q2y + k);
+
+        Mask apartX = mor(gt(vmin(bx, ax), add(vmax(dx, cx), tol)),
+                          lt(vmax(bx, ax), sub(vmin(dx, cx), tol)));
+        Mask apartY = mor(gt(vmin(by, ay), add(vmax(dy, cy), tol)),
+                          lt(vmax(by, ay), sub(vmin(dy, cy), tol)));
+
+        unsigned apart = bits(mor(apartX, apartY));
+        result |= (~apart & ((1u << WIDTH) - 1)) << k;
+    }
+    return result;
+}
+
+/*public static*/
+unsigned
+BatchPredicates::rayCrossingCandidates(const double* x, const double* y,
+                                       double px, double py)
+{
+    const Vec vpx = set1(px);
+    const Vec vpy = set1(py);
+    unsigned result = 0;
+
+    for (std::size_t k = 0; k < BATCH_SIZE; k += WIDTH) {
+        Vec x1 = load(x + k);
+        Vec x2 = load(x + k + 1);
+        Vec y1 = load(y + k);
+        Vec y2 = load(y + k + 1);
+
+        // strictly left of the point: never counted
+        Mask left = mand(lt(x1, vpx), lt(x2, vpx));
+        // crosses the ray line, or touches it at a vertex or along
+        // a horizontal segment
+        Mask straddles = mxor(gt(y1, vpy), gt(y2, vpy));
+        Mask touches = mor(eq(y1, vpy), eq(y2, vpy));
+
+        result |= bits(mandnot(left, mor(straddles, touches))) << k;
+    }
+    return result;
+}
+
+} // namespace geos::algorithm
+} // namespace geos
@@ -16,6 +16,7 @@
  *
  **********************************************************************/
 
+#include <geos/algorithm/BatchPredicates.h>
 #include <geos/algorithm/CGAlgorithmsDD.h>
 #include <geos/algorithm/RayCrossingCounter.h>
 #include <geos/geom/Geometry.h>
@@ -43,7 +44,35 @@ RayCrossingCounter::locatePointInRing(const geom::CoordinateXY& point,
 {
     RayCrossingCounter rcc(point);
 
-    for(std::size_t i = 1, ni = ring.size(); i < ni; i++) {
+    constexpr std::size_t N = BatchPredicates::BATCH_SIZE;
+    double x[N + 1];
+    double y[N + 1];
+
+    // screen the segments a batch at a time, and count
+    // the ones which may affect the location in ring order
+    std::size_t i = 1;
+    for(std::size_t ni = ring.size(); i + N <= ni; i += N) {
+        for(std::size_t k = 0; k <= N; k++) {
+            const geom::CoordinateXY& p = ring.getAt<geom::CoordinateXY>(i - 1 + k);
+            x[k] = p.x;
+            y[k] = p.y;
+        }
+
+        unsigned candidates = BatchPredicates::rayCrossingCandidates(x, y, point.x, point.y);
+        for(std::size_t k = 0; candidates != 0; k++, candidates >>= 1) {
+            if(!(candidates & 1u)) {
+                continue;
+            }
+            rcc.countSegment(ring.getAt<geom::CoordinateXY>(i - 1 + k),
+                             ring.getAt<geom::CoordinateXY>(i + k));
+
+            if(rcc.isOnSegment()) {
+                return rcc.getLocation();
+            }
+        }
+    }
+
+    for(std::size_t ni = ring.size(); i < ni; i++) {
         const geom::CoordinateXY& p1 = ring.getAt<geom::CoordinateXY>(i-1);;
         const geom::CoordinateXY& p2 = ring.getAt<geom::CoordinateXY>(i);
 
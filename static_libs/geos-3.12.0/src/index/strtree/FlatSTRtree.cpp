@@ -0,0 +1,111 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/FlatSTRtree.h>
+#include <geos/util/IllegalArgumentException.h>
+
+namespace geos {
+namespace index { // geos.index
+namespace strtree { // geos.index.strtree
+
+namespace {
+
+const unsigned char MAGIC[4] = { 'G', 'S', 'T', 'R' };
+const std::uint32_t VERSION = 1;
+const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct Header {
+    unsigned char magic[4];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t reserved;
+    std::uint64_t numNodes;
+    std::uint64_t numItems;
+};
+
+static_assert(sizeof(Header) == FlatSTRtree::HEADER_SIZE, "unexpected padding in FlatSTRtree header");
+
+}
+
+/*public*/
+FlatSTRtree::FlatSTRtree(const void* p_data, std::size_t size)
+    : data(static_cast<const unsigned char*>(p_data))
+    , numNodes(0)
+    , numItems(0)
+{
+    if (data == nullptr || size < HEADER_SIZE) {
+        throw util::IllegalArgumentException("Serialized STRtree is truncated");
+    }
+
+    Header header;
+    std::memcpy(&header, data, HEADER_SIZE);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw util::IllegalArgumentException("Not a serialized STRtree");
+    }
+    if (header.version != VERSION) {
+        throw util::IllegalArgumentException("Unsupported serialized STRtree version");
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        throw util::IllegalArgumentException("Serialized STRtree has another byte order");
+    }
+    if (header.numNodes > (size - HEADER_SIZE) / NODE_SIZE || header.numItems > header.numNodes) {
+        throw util::IllegalArgumentException("Serialized STRtree is truncated");
+    }
+
+    numNodes = static_cast<std::size_t>(header.numNodes);
+    numItems = static_cast<std::size_t>(header.numItems);
+}
+
+/*public*/
+geom::Envelope
+FlatSTRtree::getBounds() const
+{
+    if (numNodes == 0) {
+        return geom::Envelope();
+    }
+    Node root = readNode(0);
+    return geom::Envelope(root.minX, root.maxX, root.minY, root.maxY);
+}
+
+/*public*/
+void
+FlatSTRtree::query(const geom::Envelope& queryEnv, std::vector<ItemId>& results) const
+{
+    query(queryEnv, [&results](ItemId id) {
+        results.push_back(id);
+    });
+}
+
+/*private static*/
+void
+FlatSTRtree::throwCorrupt()
+{
+    throw util::IllegalArgumentException("Serialized STRtree is corrupt");
+}
+
+/*private static*/
+void
+FlatSTRtree::writeHeader(unsigned char* buf, std::size_t p_numNodes, std::size_t p_numItems)
+{
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.reserved = 0;
+    header.numNodes = p_numNodes;
+    header.numItems = p_numItems;
+    std::memcpy(buf, &header, HEADER_SIZE);
+}
+
+} // namespace geos.index.strtree
+} // namespace geos.index
+} // namespace geos
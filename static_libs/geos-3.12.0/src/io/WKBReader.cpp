@@ -482,6 +482,22 @@ WKBReader::readCoordinateSequence(uint32_t size)
     minMemSize(GEOS_LINESTRING, size);
     auto seq = detail::make_unique<CoordinateSequence>(size, hasZ, hasM, false);
 
+    // Fast path: the WKB ordinates are laid out as the sequence stores
+    // them, so read them in one block and round X and Y afterwards
+    if (seq->stride() == inputDimension) {
+        dis.readDoubles(seq->data(), static_cast<std::size_t>(size) * inputDimension);
+
+        const PrecisionModel& pm = *factory.getPrecisionModel();
+        if (pm.getType() != PrecisionModel::FLOATING) {
+            double* ords = seq->data();
+            for (uint32_t i = 0; i < size; i++, ords += inputDimension) {
+                ords[0] = pm.makePrecise(ords[0]);
+                ords[1] = pm.makePrecise(ords[1]);
+            }
+        }
+        return seq;
+    }
+
     CoordinateXYZM coord(0, 0, DoubleNotANumber, DoubleNotANumber);
     for(uint32_t i = 0; i < size; i++) {
         readCoordinate();
@@ -50,6 +50,7 @@ MCIndexNoder::computeNodes(SegmentString::NonConstVect* inputSegStrings)
     }
 
     if (!indexBuilt) {
+        index.reserve(monoChains.size());
         for(const auto& mc : monoChains) {
             index.insert(mc.getEnvelope(overlapTolerance), &mc);
         }
@@ -0,0 +1,242 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/noding/ParallelMCIndexNoder.h>
+#include <geos/noding/IntersectionAdder.h>
+#include <geos/noding/MCIndexNoder.h>
+#include <geos/noding/SegmentIntersector.h>
+#include <geos/noding/NodedSegmentString.h>
+#include <geos/index/chain/MonotoneChain.h>
+#include <geos/index/chain/MonotoneChainBuilder.h>
+#include <geos/index/chain/MonotoneChainOverlapAction.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/util/Interrupt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <system_error>
+#include <thread>
+
+using geos::index::chain::MonotoneChain;
+using geos::index::chain::MonotoneChainBuilder;
+using geos::index::chain::MonotoneChainOverlapAction;
+
+namespace geos {
+namespace noding { // geos.noding
+
+namespace {
+
+struct SegmentPair {
+    SegmentString* ss0;
+    std::size_t segIndex0;
+    SegmentString* ss1;
+    std::size_t segIndex1;
+};
+
+/*
+ * Records the overlapping segments of two chains instead of
+ * intersecting them, optionally dropping the pairs which do not
+ * intersect at all.
+ */
+class SegmentPairCollector : public MonotoneChainOverlapAction {
+public:
+    SegmentPairCollector(bool p_filterDisjoint)
+        : pairs(nullptr)
+        , filterDisjoint(p_filterDisjoint)
+    {}
+
+    void overlap(const MonotoneChain& mc1, std::size_t start1,
+                 const MonotoneChain& mc2, std::size_t start2) override
+    {
+        SegmentString* ss1 = const_cast<SegmentString*>(
+                                 static_cast<const SegmentString*>(mc1.getContext()));
+        SegmentString* ss2 = const_cast<SegmentString*>(
+                                 static_cast<const SegmentString*>(mc2.getContext()));
+        assert(ss1);
+        assert(ss2);
+
+        if (filterDisjoint) {
+            if (ss1 == ss2 && start1 == start2) {
+                return;
+            }
+            li.computeIntersection(*ss1->getCoordinates(), start1,
+                                   *ss2->getCoordinates(), start2);
+            if (!li.hasIntersection()) {
+                return;
+            }
+        }
+        pairs->push_back({ss1, start1, ss2, start2});
+    }
+
+    std::vector<SegmentPair>* pairs;
+
+private:
+    bool filterDisjoint;
+    algorithm::LineIntersector li;
+};
+
+} // anonymous namespace
+
+/*public*/
+ParallelMCIndexNoder::ParallelMCIndexNoder(SegmentIntersector* nSegInt,
+        double p_overlapTolerance, std::size_t p_numThreads)
+    : SinglePassNoder(nSegInt)
+    , nodedSegStrings(nullptr)
+    , overlapTolerance(p_overlapTolerance)
+    , numThreads(1)
+{
+    setNumThreads(p_numThreads);
+}
+
+/*public*/
+void
+ParallelMCIndexNoder::setNumThreads(std::size_t p_numThreads)
+{
+    if (p_numThreads == 0) {
+        p_numThreads = std::thread::hardware_concurrency();
+    }
+    numThreads = std::max<std::size_t>(p_numThreads, 1);
+}
+
+/*public*/
+void
+ParallelMCIndexNoder::computeNodes(SegmentString::NonConstVect* inputSegStrings)
+{
+    nodedSegStrings = inputSegStrings;
+    assert(nodedSegStrings);
+
+    for (const auto& s : *nodedSegStrings) {
+        MonotoneChainBuilder::getChains(s->getCoordinates(), s, monoChains);
+    }
+
+    index.reserve(monoChains.size());
+    for (const auto& mc : monoChains) {
+        index.insert(mc.getEnvelope(overlapTolerance), &mc);
+    }
+    // pack the tree now, the workers only read it
+    index.build();
+
+    intersectChains();
+}
+
+/*private*/
+void
+ParallelMCIndexNoder::intersectChains()
+{
+    assert(segInt);
+
+    std::size_t numChains = index.size();
+    std::size_t numTiles = (numChains + TILE_SIZE - 1) / TILE_SIZE;
+    std::size_t nThreads = std::min(numThreads, numTiles);
+
+    if (nThreads > 1 && numChains >= MIN_PARALLEL_CHAINS) {
+        intersectChainsParallel(nThreads);
+        return;
+    }
+
+    // same as MCIndexNoder
+    MCIndexNoder::SegmentOverlapAction overlapAction(*segInt);
+    std::size_t nOverlaps = 0;
+
+    index.queryPairs([this, &overlapAction, &nOverlaps](const MonotoneChain* queryChain, const MonotoneChain* testChain) {
+        queryChain->computeOverlaps(testChain, overlapTolerance, &overlapAction);
+        nOverlaps++;
+        if ( nOverlaps % 100000 == 0 ) GEOS_CHECK_FOR_INTERRUPTS();
+
+        return !segInt->isDone(); // abort early if segInt->isDone()
+    });
+}
+
+/*private*/
+void
+ParallelMCIndexNoder::intersectChainsParallel(std::size_t nThreads)
+{
+    std::size_t numChains = index.size();
+    std::size_t numTiles = (numChains + TILE_SIZE - 1) / TILE_SIZE;
+    std::vector<std::vector<SegmentPair>> tilePairs(numTiles);
+
+    bool filterDisjoint = dynamic_cast<IntersectionAdder*>(segInt) != nullptr;
+    std::atomic<std::size_t> nextTile(0);
+    std::atomic<bool> aborted(false);
+
+    auto collectTiles = [&](bool isCaller) {
+        SegmentPairCollector collector(filterDisjoint);
+        while (!aborted) {
+            std::size_t tile = nextTile++;
+            if (tile >= numTiles) {
+                return;
+            }
+            collector.pairs = &tilePairs[tile];
+            index.queryPairs(tile * TILE_SIZE, (tile + 1) * TILE_SIZE,
+                [this, &collector](const MonotoneChain* queryChain, const MonotoneChain* testChain) {
+                    queryChain->computeOverlaps(testChain, overlapTolerance, &collector);
+                });
+            // interruption callbacks are only safe on the calling thread
+            if (isCaller) GEOS_CHECK_FOR_INTERRUPTS();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(nThreads);
+    workers.reserve(nThreads - 1);
+    for (std::size_t i = 1; i < nThreads; i++) {
+        try {
+            workers.emplace_back([&collectTiles, &errors, &aborted, i]() {
+                try {
+                    collectTiles(false);
+                }
+                catch (...) {
+                    errors[i] = std::current_exception();
+                    aborted = true;
+                }
+            });
+        }
+        catch (const std::system_error&) {
+            // out of threads: the running ones take the remaining tiles
+            break;
+        }
+    }
+    try {
+        collectTiles(true);
+    }
+    catch (...) {
+        errors[0] = std::current_exception();
+        aborted = true;
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    for (const auto& err : errors) {
+        if (err) {
+            std::rethrow_exception(err);
+        }
+    }
+
+    // replay the candidates in serial order
+    for (auto& pairs : tilePairs) {
+        for (const SegmentPair& p : pairs) {
+            segInt->processIntersections(p.ss0, p.segIndex0, p.ss1, p.segIndex1);
+            if (segInt->isDone()) {
+                return;
+            }
+        }
+        std::vector<SegmentPair>().swap(pairs);
+        GEOS_CHECK_FOR_INTERRUPTS();
+    }
+}
+
+
+} // namespace geos.noding
+} // namespace geos
@@ -128,6 +128,7 @@ std::unique_ptr<geom::CoordinateSequence>
 BufferInputLineSimplifier::collapseLine() const
 {
     auto coordList = new CoordinateSequence();
+    coordList->reserve(inputLine.size());
 
     for(std::size_t i = 0, n = inputLine.size(); i < n; ++i) {
         if(isDeleted[i] != DELETE) {
@@ -0,0 +1,257 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/operation/buffer/ParallelBufferOp.h>
+#include <geos/operation/buffer/BufferOp.h>
+#include <geos/operation/cluster/EnvelopeDistanceClusterFinder.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryCollection.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <numeric>
+#include <system_error>
+#include <thread>
+
+using geos::geom::Geometry;
+using geos::geom::GeometryCollection;
+
+namespace geos {
+namespace operation { // geos.operation
+namespace buffer { // geos.operation.buffer
+
+/*public*/
+ParallelBufferOp::ParallelBufferOp(const Geometry* g, const BufferParameters& params)
+    : inputGeoms(1, g)
+    , geomFact(g->getFactory())
+    , bufParams(params)
+    , numThreads(1)
+{
+}
+
+/*public*/
+ParallelBufferOp::ParallelBufferOp(const std::vector<const Geometry*>& geoms,
+                                   const geom::GeometryFactory& p_geomFact,
+                                   const BufferParameters& params)
+    : inputGeoms(geoms)
+    , geomFact(&p_geomFact)
+    , bufParams(params)
+    , numThreads(1)
+{
+}
+
+/*public*/
+void
+ParallelBufferOp::setNumThreads(std::size_t p_numThreads)
+{
+    if (p_numThreads == 0) {
+        p_numThreads = std::thread::hardware_concurrency();
+    }
+    numThreads = std::max<std::size_t>(p_numThreads, 1);
+}
+
+/*public static*/
+std::unique_ptr<Geometry>
+ParallelBufferOp::bufferOp(const Geometry* g, double distance,
+                           const BufferParameters& params, std::size_t p_numThreads)
+{
+    ParallelBufferOp op(g, params);
+    op.setNumThreads(p_numThreads);
+    return op.getResultGeometry(distance);
+}
+
+/*public*/
+std::unique_ptr<Geometry>
+ParallelBufferOp::getResultGeometry(double distance)
+{
+    if (!std::isfinite(distance)) {
+        throw util::IllegalArgumentException("ParallelBufferOp::getResultGeometry distance must be a finite value");
+    }
+
+    std::vector<const Geometry*> components;
+    for (const Geometry* g : inputGeoms) {
+        extractComponents(g, components);
+    }
+    if (components.size() < 2) {
+        return bufferInput(distance);
+    }
+
+    // parts further apart than this have disjoint buffers
+    cluster::EnvelopeDistanceClusterFinder finder(2 * bufferReach(distance));
+    auto clusters = finder.cluster(components);
+    if (clusters.getNumClusters() < 2) {
+        return bufferInput(distance);
+    }
+
+    std::vector<std::vector<const Geometry*>> clusterGeoms(clusters.getNumClusters());
+    for (std::size_t i = 0; i < clusters.getNumClusters(); i++) {
+        for (auto it = clusters.begin(i); it != clusters.end(i); ++it) {
+            clusterGeoms[i].push_back(components[*it]);
+        }
+    }
+
+    auto buffers = bufferClusters(clusterGeoms, distance);
+
+    std::vector<std::unique_ptr<Geometry>> polys;
+    for (auto& buf : buffers) {
+        if (buf->isEmpty()) {
+            continue;
+        }
+        if (buf->getGeometryTypeId() == geom::GEOS_POLYGON) {
+            polys.push_back(std::move(buf));
+        }
+        else {
+            for (auto& poly : static_cast<GeometryCollection*>(buf.get())->releaseGeometries()) {
+                polys.push_back(std::move(poly));
+            }
+        }
+    }
+
+    if (polys.empty()) {
+        return geomFact->createPolygon();
+    }
+    if (polys.size() == 1) {
+        return std::move(polys[0]);
+    }
+    return geomFact->createMultiPolygon(std::move(polys));
+}
+
+/*private*/
+double
+ParallelBufferOp::bufferReach(double distance) const
+{
+    // a negative buffer lies inside the input, except on the right of
+    // a single-sided line buffer
+    double reach = bufParams.isSingleSided() ? std::fabs(distance) : std::max(distance, 0.0);
+
+    // square caps reach the corner of a square of side 2 * distance,
+    // mitred joins up to the mitre limit times distance
+    double factor = std::sqrt(2.0);
+    if (bufParams.getJoinStyle() == BufferParameters::JOIN_MITRE) {
+        factor = std::max(factor, bufParams.getMitreLimit());
+    }
+    return reach * factor;
+}
+
+/*private static*/
+void
+ParallelBufferOp::extractComponents(const Geometry* g, std::vector<const Geometry*>& components)
+{
+    if (g->isEmpty()) {
+        return;
+    }
+    if (!g->isCollection()) {
+        components.push_back(g);
+        return;
+    }
+    for (std::size_t i = 0; i < g->getNumGeometries(); i++) {
+        extractComponents(g->getGeometryN(i), components);
+    }
+}
+
+/*private*/
+std::unique_ptr<Geometry>
+ParallelBufferOp::bufferInput(double distance) const
+{
+    if (inputGeoms.size() == 1) {
+        BufferOp op(inputGeoms[0], bufParams);
+        return op.getResultGeometry(distance);
+    }
+    return bufferCluster(inputGeoms, distance);
+}
+
+/*private*/
+std::unique_ptr<Geometry>
+ParallelBufferOp::bufferCluster(const std::vector<const Geometry*>& clusterGeoms, double distance) const
+{
+    if (clusterGeoms.size() == 1) {
+        BufferOp op(clusterGeoms[0], bufParams);
+        return op.getResultGeometry(distance);
+    }
+    auto coll = geomFact->createGeometryCollection(clusterGeoms);
+    BufferOp op(coll.get(), bufParams);
+    return op.getResultGeometry(distance);
+}
+
+/*private*/
+std::vector<std::unique_ptr<Geometry>>
+ParallelBufferOp::bufferClusters(const std::vector<std::vector<const Geometry*>>& clusters, double distance) const
+{
+    std::size_t numClusters = clusters.size();
+    std::vector<std::unique_ptr<Geometry>> buffers(numClusters);
+    std::vector<std::exception_ptr> errors(numClusters);
+
+    // largest clusters first, so that they do not end up last on one thread
+    std::vector<std::size_t> weights(numClusters, 0);
+    for (std::size_t i = 0; i < numClusters; i++) {
+        for (const Geometry* g : clusters[i]) {
+            weights[i] += g->getNumPoints();
+        }
+    }
+    std::vector<std::size_t> order(numClusters);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&weights](std::size_t a, std::size_t b) {
+        return weights[a] > weights[b];
+    });
+
+    std::atomic<std::size_t> next(0);
+    std::atomic<bool> aborted(false);
+
+    auto work = [&]() {
+        while (!aborted) {
+            std::size_t k = next++;
+            if (k >= numClusters) {
+                return;
+            }
+            std::size_t i = order[k];
+            try {
+                buffers[i] = bufferCluster(clusters[i], distance);
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+                aborted = true;
+            }
+        }
+    };
+
+    std::size_t nThreads = std::min(numThreads, numClusters);
+    std::vector<std::thread> workers;
+    workers.reserve(nThreads - 1);
+    for (std::size_t i = 1; i < nThreads; i++) {
+        try {
+            workers.emplace_back(work);
+        }
+        catch (const std::system_error&) {
+            // out of threads: the running ones take the remaining clusters
+            break;
+        }
+    }
+    work();
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    for (const auto& err : errors) {
+        if (err) {
+            std::rethrow_exception(err);
+        }
+    }
+    return buffers;
+}
+
+} // namespace geos.operation.buffer
+} // namespace geos.operation
+} // namespace geos
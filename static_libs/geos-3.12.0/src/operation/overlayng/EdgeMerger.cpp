@@ -16,8 +16,12 @@
 #include <geos/geom/Dimension.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/util/Arena.h>
 #include <geos/util/Assert.h>
 
+#include <functional>
+#include <map>
+
 
 namespace geos {      // geos
 namespace operation { // geos.operation
@@ -28,7 +32,10 @@ std::vector<Edge*>
 EdgeMerger::merge(std::vector<Edge*>& edges)
 {
     std::vector<Edge*> mergedEdges;
-    std::map<EdgeKey, Edge*> edgeMap;
+    mergedEdges.reserve(edges.size());
+    typedef util::ArenaAllocator<std::pair<const EdgeKey, Edge*>> EdgeMapAllocator;
+    util::Arena arena;
+    std::map<EdgeKey, Edge*, std::less<EdgeKey>, EdgeMapAllocator> edgeMap{EdgeMapAllocator(arena)};
 
     for (Edge* edge : edges) {
         EdgeKey edgeKey(edge);
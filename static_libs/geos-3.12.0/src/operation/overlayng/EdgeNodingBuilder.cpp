@@ -55,7 +55,13 @@ EdgeNodingBuilder::createFixedPrecisionNoder(const PrecisionModel* p_pm)
 std::unique_ptr<Noder>
 EdgeNodingBuilder::createFloatingPrecisionNoder(bool doValidation)
 {
-    std::unique_ptr<MCIndexNoder> mcNoder(new MCIndexNoder());
+    std::unique_ptr<SinglePassNoder> mcNoder;
+    if (numThreads == 1) {
+        mcNoder.reset(new MCIndexNoder());
+    }
+    else {
+        mcNoder.reset(new ParallelMCIndexNoder(nullptr, 0.0, numThreads));
+    }
     mcNoder->setSegmentIntersector(&intAdder);
 
     if (doValidation) {
@@ -120,6 +126,7 @@ std::vector<Edge*>
 EdgeNodingBuilder::createEdges(std::vector<SegmentString*>* segStrings)
 {
     std::vector<Edge*> createdEdges;
+    createdEdges.reserve(segStrings->size());
 
     for (SegmentString* ss : *segStrings) {
         const CoordinateSequence* pts = ss->getCoordinates();
@@ -33,6 +33,9 @@ using namespace geos::geom;
 */
 //std::vector<std::unique_ptr<Edge>> && edges
 OverlayGraph::OverlayGraph()
+    : nodeMap(geos::util::ArenaAllocator<std::pair<const Coordinate, OverlayEdge*>>(arena))
+    , ovEdgeQue(geos::util::ArenaAllocator<OverlayEdge>(arena))
+    , ovLabelQue(geos::util::ArenaAllocator<OverlayLabel>(arena))
 {}
 
 /*public*/
@@ -70,6 +73,7 @@ std::vector<OverlayEdge*>
 OverlayGraph::getResultAreaEdges()
 {
     std::vector<OverlayEdge*> resultEdges;
+    resultEdges.reserve(edges.size());
     for (OverlayEdge* edge : getEdges()) {
         if (edge->isInResultArea()) {
             resultEdges.push_back(edge);
@@ -78,6 +82,14 @@ OverlayGraph::getResultAreaEdges()
     return resultEdges;
 }
 
+/*public*/
+void
+OverlayGraph::reserve(std::size_t numEdges)
+{
+    edges.reserve(2 * numEdges);
+    csQue.reserve(numEdges);
+}
+
 /*public*/
 OverlayEdge*
 OverlayGraph::addEdge(Edge* edge)
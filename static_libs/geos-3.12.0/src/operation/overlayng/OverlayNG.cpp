@@ -211,6 +211,7 @@ OverlayNG::computeEdgeOverlay()
      * Formerly in nodeEdges())
      */
     EdgeNodingBuilder nodingBuilder(pm, noder);
+    nodingBuilder.setNumThreads(numThreads);
     // clipEnv not always used, but needs to remain in scope
     // as long as nodingBuilder when it is.
     Envelope clipEnv;
@@ -246,6 +247,7 @@ OverlayNG::computeEdgeOverlay()
     // Sort the edges first, for comparison with JTS results
     // std::sort(edges.begin(), edges.end(), EdgeComparator);
     OverlayGraph graph;
+    graph.reserve(edges.size());
     for (Edge* e : edges) {
         // Write out edge coordinates
         // std::cout << *e->getCoordinatesRO() << std::endl;
@@ -82,6 +82,14 @@ OverlayNGRobust::Union(const Geometry* a)
 /*public static*/
 std::unique_ptr<Geometry>
 OverlayNGRobust::Overlay(const Geometry* geom0, const Geometry* geom1, int opCode)
+{
+    return Overlay(geom0, geom1, opCode, 1);
+}
+
+/*public static*/
+std::unique_ptr<Geometry>
+OverlayNGRobust::Overlay(const Geometry* geom0, const Geometry* geom1, int opCode,
+                         std::size_t numThreads)
 {
     std::unique_ptr<Geometry> result;
     std::runtime_error exOriginal("");
@@ -107,7 +115,9 @@ OverlayNGRobust::Overlay(const Geometry* geom0, const Geometry* geom1, int opCod
     try {
         geom::PrecisionModel PM_FLOAT;
         // std::cerr << "Using floating point overlay." << std::endl;
-        result = OverlayNG::overlay(geom0, geom1, opCode, &PM_FLOAT);
+        OverlayNG ov(geom0, geom1, &PM_FLOAT, opCode);
+        ov.setNumThreads(numThreads);
+        result = ov.getResult();
 
         // Simple noding with no validation
         // There are cases where this succeeds with invalid noding (e.g. STMLF 1608).
@@ -0,0 +1,1200 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/operation/relate/RelatePredicateOp.h>
+#include <geos/operation/relate/RelateOp.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/algorithm/Orientation.h>
+#include <geos/algorithm/locate/IndexedPointInAreaLocator.h>
+#include <geos/algorithm/locate/SimplePointInAreaLocator.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Dimension.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/IntersectionMatrix.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/Location.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/Polygon.h>
+#include <geos/index/strtree/TemplateSTRtree.h>
+#include <geos/noding/BasicSegmentString.h>
+#include <geos/noding/MCIndexSegmentSetMutualIntersector.h>
+#include <geos/noding/SegmentIntersector.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using geos::algorithm::LineIntersector;
+using geos::algorithm::locate::IndexedPointInAreaLocator;
+using geos::algorithm::locate::SimplePointInAreaLocator;
+using geos::geom::CoordinateSequence;
+using geos::geom::CoordinateXY;
+using geos::geom::Dimension;
+using geos::geom::Envelope;
+using geos::geom::Geometry;
+using geos::geom::GeometryTypeId;
+using geos::geom::LineString;
+using geos::geom::Location;
+using geos::geom::Point;
+using geos::geom::Polygon;
+using geos::noding::SegmentString;
+
+namespace geos {
+namespace operation { // geos.operation
+namespace relate { // geos.operation.relate
+
+namespace {
+
+enum class PredicateKind {
+    PATTERN,
+    INTERSECTS,
+    DISJOINT,
+    TOUCHES,
+    CROSSES,
+    WITHIN,
+    CONTAINS,
+    OVERLAPS,
+    COVERS,
+    COVERED_BY,
+    EQUALS,
+    CONTAINS_PROPERLY
+};
+
+/*
+ * A predicate is true when the matrix matches any of its patterns
+ * (false if it has none), inverted if negate is set. It can only be
+ * true when the envelope condition holds.
+ */
+struct Predicate {
+    enum EnvelopeTest { ANY, INTERSECTS, A_COVERS_B, B_COVERS_A, EQUAL };
+
+    PredicateKind kind;
+    std::array<const char*, 4> patterns;
+    std::size_t numPatterns;
+    bool negate;
+    EnvelopeTest envelopeTest;
+};
+
+Predicate
+makePredicate(PredicateKind kind, int dimA, int dimB)
+{
+    Predicate p{kind, {{nullptr, nullptr, nullptr, nullptr}}, 0, false, Predicate::INTERSECTS};
+    auto add = [&p](const char* pattern) {
+        p.patterns[p.numPatterns++] = pattern;
+    };
+
+    switch(kind) {
+    case PredicateKind::PATTERN:
+        p.envelopeTest = Predicate::ANY;
+        break;
+    case PredicateKind::INTERSECTS:
+        add("FF*FF****");
+        p.negate = true;
+        break;
+    case PredicateKind::DISJOINT:
+        add("FF*FF****");
+        p.envelopeTest = Predicate::ANY;
+        break;
+    case PredicateKind::TOUCHES:
+        if(dimA != Dimension::P || dimB != Dimension::P) {
+            add("FT*******");
+            add("F**T*****");
+            add("F***T****");
+        }
+        break;
+    case PredicateKind::CROSSES:
+        if(dimA < dimB) {
+            add("T*T******");
+        }
+        else if(dimA > dimB) {
+            add("T*****T**");
+        }
+        else if(dimA == Dimension::L) {
+            add("0********");
+        }
+        break;
+    case PredicateKind::WITHIN:
+        add("T*F**F***");
+        p.envelopeTest = Predicate::B_COVERS_A;
+        break;
+    case PredicateKind::CONTAINS:
+        add("T*****FF*");
+        p.envelopeTest = Predicate::A_COVERS_B;
+        break;
+    case PredicateKind::OVERLAPS:
+        if(dimA == dimB && dimA != Dimension::L) {
+            add("T*T***T**");
+        }
+        else if(dimA == dimB) {
+            add("1*T***T**");
+        }
+        break;
+    case PredicateKind::COVERS:
+        add("T*****FF*");
+        add("*T****FF*");
+        add("***T**FF*");
+        add("****T*FF*");
+        p.envelopeTest = Predicate::A_COVERS_B;
+        break;
+    case PredicateKind::COVERED_BY:
+        add("T*F**F***");
+        add("*TF**F***");
+        add("**FT*F***");
+        add("**F*TF***");
+        p.envelopeTest = Predicate::B_COVERS_A;
+        break;
+    case PredicateKind::EQUALS:
+        if(dimA == dimB) {
+            add("T*F**FFF*");
+        }
+        p.envelopeTest = Predicate::EQUAL;
+        break;
+    case PredicateKind::CONTAINS_PROPERLY:
+        add("T**FF*FF*");
+        p.envelopeTest = Predicate::A_COVERS_B;
+        break;
+    }
+    return p;
+}
+
+/*
+ * The dimension of the part of a geometry at location loc, in the
+ * neighbourhood of a point of a geometry of dimension dim.
+ */
+struct LocalPart {
+    Location loc;
+    int dim;
+};
+
+std::size_t
+localParts(int dim, Location loc, LocalPart* parts)
+{
+    if(loc == Location::EXTERIOR) {
+        parts[0] = {Location::EXTERIOR, Dimension::A};
+        return 1;
+    }
+    if(dim == Dimension::A) {
+        if(loc == Location::INTERIOR) {
+            parts[0] = {Location::INTERIOR, Dimension::A};
+            return 1;
+        }
+        parts[0] = {Location::BOUNDARY, Dimension::L};
+        parts[1] = {Location::INTERIOR, Dimension::A};
+        parts[2] = {Location::EXTERIOR, Dimension::A};
+        return 3;
+    }
+    std::size_t n = 0;
+    if(loc == Location::BOUNDARY) {
+        parts[n++] = {Location::BOUNDARY, Dimension::P};
+    }
+    parts[n++] = {Location::INTERIOR, dim};
+    parts[n++] = {Location::EXTERIOR, Dimension::A};
+    return n;
+}
+
+/*
+ * A location is open when it contains a neighbourhood of each of its points.
+ */
+bool
+isOpen(int dim, Location loc)
+{
+    return loc == Location::EXTERIOR || (loc == Location::INTERIOR && dim == Dimension::A);
+}
+
+std::size_t
+idx(Location loc)
+{
+    return static_cast<std::size_t>(loc);
+}
+
+/*
+ * An input geometry, with what the evaluation needs to know about it.
+ */
+class RelateGeometry {
+
+public:
+
+    // Segment string context
+    struct EdgeInfo {
+        bool isA;
+        std::size_t index;
+        bool interiorOnLeft;
+    };
+
+    RelateGeometry(const Geometry& g, bool p_isA)
+        : geom(g)
+        , isA(p_isA)
+        , dim(g.getDimension())
+        , boundaryDim(Dimension::False)
+        , supported(false)
+        , numAreaLocates(0)
+    {
+        if(g.isEmpty()) {
+            return;
+        }
+        switch(g.getGeometryTypeId()) {
+        case GeometryTypeId::GEOS_POINT:
+        case GeometryTypeId::GEOS_MULTIPOINT:
+            supported = initPoints();
+            break;
+        case GeometryTypeId::GEOS_LINESTRING:
+        case GeometryTypeId::GEOS_LINEARRING:
+        case GeometryTypeId::GEOS_MULTILINESTRING:
+            supported = initLines();
+            break;
+        case GeometryTypeId::GEOS_POLYGON:
+        case GeometryTypeId::GEOS_MULTIPOLYGON:
+            supported = initPolygons();
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool
+    isSupported() const
+    {
+        return supported;
+    }
+
+    /// Dimension of the interior, boundary and exterior
+    int
+    getDimension(Location loc) const
+    {
+        switch(loc) {
+        case Location::INTERIOR:
+            return dim;
+        case Location::BOUNDARY:
+            return boundaryDim;
+        default:
+            return Dimension::A;
+        }
+    }
+
+    bool
+    isBoundaryPoint(const CoordinateXY& p) const
+    {
+        return std::binary_search(boundaryPoints.begin(), boundaryPoints.end(), p);
+    }
+
+    /// Location of a point known to lie on the geometry
+    Location
+    locateOnGeometry(const CoordinateXY& p) const
+    {
+        if(dim == Dimension::A || (dim == Dimension::L && isBoundaryPoint(p))) {
+            return Location::BOUNDARY;
+        }
+        return Location::INTERIOR;
+    }
+
+    /// Location of the points of an edge, away from its vertices
+    Location
+    edgeLocation() const
+    {
+        return dim == Dimension::A ? Location::BOUNDARY : Location::INTERIOR;
+    }
+
+    Location
+    locate(const CoordinateXY& p)
+    {
+        if(dim == Dimension::A) {
+            // building the index only pays off over many points
+            if(numAreaLocates < MAX_SIMPLE_LOCATES) {
+                numAreaLocates++;
+                return SimplePointInAreaLocator::locate(p, &geom);
+            }
+            if(!areaLocator) {
+                areaLocator.reset(new IndexedPointInAreaLocator(geom));
+            }
+            return areaLocator->locate(&p);
+        }
+        if(dim == Dimension::P) {
+            return std::binary_search(points.begin(), points.end(), p) ? Location::INTERIOR : Location::EXTERIOR;
+        }
+        if(isBoundaryPoint(p)) {
+            return Location::BOUNDARY;
+        }
+        return isOnLine(p) ? Location::INTERIOR : Location::EXTERIOR;
+    }
+
+    const Geometry& geom;
+    const bool isA;
+    const int dim;
+    int boundaryDim;
+
+    std::vector<CoordinateXY> points;
+    std::vector<CoordinateXY> boundaryPoints;
+    std::vector<EdgeInfo> edgeInfo;
+    std::vector<std::unique_ptr<noding::BasicSegmentString>> edges;
+    SegmentString::ConstVect edgeVect;
+
+private:
+
+    struct Segment {
+        const CoordinateXY* p0;
+        const CoordinateXY* p1;
+    };
+
+    bool
+    initPoints()
+    {
+        for(std::size_t i = 0; i < geom.getNumGeometries(); i++) {
+            const Point* pt = static_cast<const Point*>(geom.getGeometryN(i));
+            if(pt->isEmpty()) {
+                return false;
+            }
+            points.push_back(*pt->getCoordinate());
+        }
+        std::sort(points.begin(), points.end());
+        return true;
+    }
+
+    bool
+    initLines()
+    {
+        std::vector<CoordinateXY> endpoints;
+        std::vector<const CoordinateSequence*> lines;
+        for(std::size_t i = 0; i < geom.getNumGeometries(); i++) {
+            const LineString* line = static_cast<const LineString*>(geom.getGeometryN(i));
+            const CoordinateSequence* pts = line->getCoordinatesRO();
+            // zero length lines are left to RelateOp
+            if(pts->size() < 2 || !hasDistinctPoints(*pts)) {
+                return false;
+            }
+            endpoints.push_back(pts->getAt<CoordinateXY>(0));
+            endpoints.push_back(pts->getAt<CoordinateXY>(pts->size() - 1));
+            lines.push_back(pts);
+        }
+
+        // Mod-2 rule: endpoints shared by an odd number of line ends
+        std::sort(endpoints.begin(), endpoints.end());
+        for(std::size_t i = 0; i < endpoints.size();) {
+            std::size_t j = i + 1;
+            while(j < endpoints.size() && endpoints[j].equals2D(endpoints[i])) {
+                j++;
+            }
+            if((j - i) % 2 == 1) {
+                boundaryPoints.push_back(endpoints[i]);
+            }
+            i = j;
+        }
+        boundaryDim = boundaryPoints.empty() ? Dimension::False : Dimension::P;
+
+        for(std::size_t i = 0; i < lines.size(); i++) {
+            edgeInfo.push_back({isA, i, false});
+        }
+        createEdges(lines);
+        return true;
+    }
+
+    bool
+    initPolygons()
+    {
+        std::vector<const CoordinateSequence*> rings;
+        for(std::size_t i = 0; i < geom.getNumGeometries(); i++) {
+            const Polygon* poly = static_cast<const Polygon*>(geom.getGeometryN(i));
+            if(poly->isEmpty()) {
+                return false;
+            }
+            for(std::size_t j = 0; j <= poly->getNumInteriorRing(); j++) {
+                const CoordinateSequence* pts = j == 0 ? poly->getExteriorRing()->getCoordinatesRO()
+                                                : poly->getInteriorRingN(j - 1)->getCoordinatesRO();
+                if(pts->size() < 4) {
+                    return false;
+                }
+                // the interior lies left of counter-clockwise shells
+                // and right of counter-clockwise holes
+                bool isCCW = algorithm::Orientation::isCCW(pts);
+                edgeInfo.push_back({isA, edgeInfo.size(), isCCW == (j == 0)});
+                rings.push_back(pts);
+            }
+        }
+        boundaryDim = Dimension::L;
+        createEdges(rings);
+        return true;
+    }
+
+    void
+    createEdges(const std::vector<const CoordinateSequence*>& lines)
+    {
+        for(std::size_t i = 0; i < lines.size(); i++) {
+            edges.emplace_back(new noding::BasicSegmentString(
+                                   const_cast<CoordinateSequence*>(lines[i]), &edgeInfo[i]));
+            edgeVect.push_back(edges.back().get());
+        }
+    }
+
+    static bool
+    hasDistinctPoints(const CoordinateSequence& pts)
+    {
+        const CoordinateXY& p0 = pts.getAt<CoordinateXY>(0);
+        for(std::size_t i = 1; i < pts.size(); i++) {
+            if(!pts.getAt<CoordinateXY>(i).equals2D(p0)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool
+    isOnLine(const CoordinateXY& p)
+    {
+        if(!lineIndex) {
+            lineIndex.reset(new index::strtree::TemplateSTRtree<Segment>());
+            for(const auto& edge : edges) {
+                for(std::size_t i = 1; i < edge->size(); i++) {
+                    const CoordinateXY& p0 = edge->getCoordinate<CoordinateXY>(i - 1);
+                    const CoordinateXY& p1 = edge->getCoordinate<CoordinateXY>(i);
+                    lineIndex->insert(Envelope(p0, p1), Segment{&p0, &p1});
+                }
+            }
+        }
+        bool found = false;
+        LineIntersector li;
+        lineIndex->query(Envelope(p), [&p, &li, &found](const Segment& seg) {
+            li.computeIntersection(p, *seg.p0, *seg.p1);
+            found = li.hasIntersection();
+            return !found;
+        });
+        return found;
+    }
+
+    static constexpr std::size_t MAX_SIMPLE_LOCATES = 16;
+
+    bool supported;
+    std::size_t numAreaLocates;
+    std::unique_ptr<IndexedPointInAreaLocator> areaLocator;
+    std::unique_ptr<index::strtree::TemplateSTRtree<Segment>> lineIndex;
+};
+
+/*
+ * Refines lower and upper bounds of the dimensions in the matrix until
+ * the predicate is decided.
+ */
+class RelateEvaluator {
+
+public:
+
+    RelateEvaluator(const Geometry& a, const Geometry& b)
+        : geomA(a, true)
+        , geomB(b, false)
+        , predicate(nullptr)
+        , outcome(UNKNOWN)
+        , inconsistent(false)
+    {}
+
+    bool
+    isSupported() const
+    {
+        return geomA.isSupported() && geomB.isSupported();
+    }
+
+    int
+    getDimensionA() const
+    {
+        return geomA.dim;
+    }
+
+    int
+    getDimensionB() const
+    {
+        return geomB.dim;
+    }
+
+    /*
+     * Returns the outcome of the predicate, or UNKNOWN if it could not
+     * be decided consistently.
+     */
+    int
+    evaluate(const Predicate& p, const char* pattern)
+    {
+        predicate = &p;
+        userPattern = pattern;
+
+        const Envelope& envA = *geomA.geom.getEnvelopeInternal();
+        const Envelope& envB = *geomB.geom.getEnvelopeInternal();
+        if(!isEnvelopeTestPassed(envA, envB)) {
+            return FALSE;
+        }
+
+        for(Location la : { Location::INTERIOR, Location::BOUNDARY, Location::EXTERIOR }) {
+            for(Location lb : { Location::INTERIOR, Location::BOUNDARY, Location::EXTERIOR }) {
+                lower[idx(la)][idx(lb)] = Dimension::False;
+                upper[idx(la)][idx(lb)] = std::min(geomA.getDimension(la), geomB.getDimension(lb));
+            }
+        }
+        lower[idx(Location::EXTERIOR)][idx(Location::EXTERIOR)] = Dimension::A;
+        outcome = evaluateBounds();
+        if(isDone()) {
+            return finish();
+        }
+
+        if(!envA.intersects(envB)) {
+            update(Location::INTERIOR, Location::EXTERIOR, geomA.dim);
+            update(Location::BOUNDARY, Location::EXTERIOR, geomA.boundaryDim);
+            update(Location::EXTERIOR, Location::INTERIOR, geomB.dim);
+            update(Location::EXTERIOR, Location::BOUNDARY, geomB.boundaryDim);
+            return complete();
+        }
+
+        // a geometry cannot cover parts of higher dimension
+        for(Location loc : { Location::INTERIOR, Location::BOUNDARY }) {
+            if(geomB.getDimension(loc) > geomA.dim) {
+                update(Location::EXTERIOR, loc, geomB.getDimension(loc));
+            }
+            if(geomA.getDimension(loc) > geomB.dim) {
+                update(loc, Location::EXTERIOR, geomA.getDimension(loc));
+            }
+        }
+        if(isDone()) {
+            return finish();
+        }
+
+        // points and line endpoints
+        locatePoints(geomA, geomB);
+        locatePoints(geomB, geomA);
+        if(isDone()) {
+            return finish();
+        }
+        if(geomA.dim == Dimension::P || geomB.dim == Dimension::P) {
+            return complete();
+        }
+
+        // segment intersections, then the pieces in between
+        computeNodes();
+        if(isDone()) {
+            return finish();
+        }
+        if(geomA.dim == Dimension::L && geomB.dim == Dimension::L) {
+            locateBoundaryOnNodes(geomA, nodesA, geomB);
+            locateBoundaryOnNodes(geomB, nodesB, geomA);
+        }
+        locateEdges(geomA, nodesA, overlapsA, geomB);
+        locateEdges(geomB, nodesB, overlapsB, geomA);
+        if(isDone()) {
+            return finish();
+        }
+        return complete();
+    }
+
+    void
+    addIntersections(SegmentString* e0, std::size_t i0, SegmentString* e1, std::size_t i1)
+    {
+        const auto* info0 = static_cast<const RelateGeometry::EdgeInfo*>(e0->getData());
+        const auto* info1 = static_cast<const RelateGeometry::EdgeInfo*>(e1->getData());
+        if(!info0->isA) {
+            std::swap(e0, e1);
+            std::swap(i0, i1);
+            std::swap(info0, info1);
+        }
+
+        const CoordinateXY& p0 = e0->getCoordinate<CoordinateXY>(i0);
+        const CoordinateXY& p1 = e0->getCoordinate<CoordinateXY>(i0 + 1);
+        const CoordinateXY& q0 = e1->getCoordinate<CoordinateXY>(i1);
+        const CoordinateXY& q1 = e1->getCoordinate<CoordinateXY>(i1 + 1);
+        if(p0.equals2D(p1) || q0.equals2D(q1)) {
+            return;
+        }
+
+        li.computeIntersection(p0, p1, q0, q1);
+        if(!li.hasIntersection()) {
+            return;
+        }
+
+        for(std::size_t k = 0; k < li.getIntersectionNum(); k++) {
+            const CoordinateXY& x = li.getIntersection(k);
+            nodesA.push_back({info0->index, i0, x});
+            nodesB.push_back({info1->index, i1, x});
+            update(geomA.locateOnGeometry(x), geomB.locateOnGeometry(x), Dimension::P);
+        }
+
+        if(li.getIntersectionNum() == 2) {
+            const CoordinateXY& x0 = li.getIntersection(0);
+            const CoordinateXY& x1 = li.getIntersection(1);
+            overlapsA.push_back({info0->index, i0, x0, x1});
+            overlapsB.push_back({info1->index, i1, x0, x1});
+            update(geomA.edgeLocation(), geomB.edgeLocation(), Dimension::L);
+
+            if(geomA.dim == Dimension::A && geomB.dim == Dimension::A) {
+                // the interiors are on the same side of the shared piece, or not
+                bool sameDirection = (p1.x - p0.x) * (q1.x - q0.x) + (p1.y - p0.y) * (q1.y - q0.y) > 0;
+                bool interiorBOnLeft = sameDirection == info1->interiorOnLeft;
+                if(info0->interiorOnLeft == interiorBOnLeft) {
+                    update(Location::INTERIOR, Location::INTERIOR, Dimension::A);
+                }
+                else {
+                    update(Location::INTERIOR, Location::EXTERIOR, Dimension::A);
+                    update(Location::EXTERIOR, Location::INTERIOR, Dimension::A);
+                }
+            }
+        }
+    }
+
+    bool
+    isDone() const
+    {
+        return outcome != UNKNOWN || inconsistent;
+    }
+
+    static constexpr int UNKNOWN = -1;
+    static constexpr int FALSE = 0;
+    static constexpr int TRUE = 1;
+
+private:
+
+    struct Node {
+        std::size_t edge;
+        std::size_t segment;
+        CoordinateXY pt;
+    };
+
+    struct Overlap {
+        std::size_t edge;
+        std::size_t segment;
+        CoordinateXY p0;
+        CoordinateXY p1;
+    };
+
+    template<typename T>
+    static bool
+    segmentLess(const T& a, const T& b)
+    {
+        return a.edge < b.edge || (a.edge == b.edge && a.segment < b.segment);
+    }
+
+    class NodeFinder : public noding::SegmentIntersector {
+    public:
+        explicit NodeFinder(RelateEvaluator& p_evaluator)
+            : evaluator(p_evaluator)
+        {}
+
+        void
+        processIntersections(SegmentString* e0, std::size_t i0,
+                             SegmentString* e1, std::size_t i1) override
+        {
+            if(!evaluator.isDone()) {
+                evaluator.addIntersections(e0, i0, e1, i1);
+            }
+        }
+
+        bool
+        isDone() const override
+        {
+            return evaluator.isDone();
+        }
+
+    private:
+        RelateEvaluator& evaluator;
+    };
+
+    bool
+    isEnvelopeTestPassed(const Envelope& envA, const Envelope& envB) const
+    {
+        switch(predicate->envelopeTest) {
+        case Predicate::INTERSECTS:
+            return envA.intersects(envB);
+        case Predicate::A_COVERS_B:
+            return envA.covers(envB);
+        case Predicate::B_COVERS_A:
+            return envB.covers(envA);
+        case Predicate::EQUAL:
+            return envA.equals(&envB);
+        default:
+            return true;
+        }
+    }
+
+    static int
+    matchCell(char required, int lo, int hi)
+    {
+        switch(required) {
+        case '*':
+            return TRUE;
+        case 'T':
+            return lo >= 0 ? TRUE : (hi < 0 ? FALSE : UNKNOWN);
+        case 'F':
+            return hi < 0 ? TRUE : (lo >= 0 ? FALSE : UNKNOWN);
+        case '0':
+        case '1':
+        case '2': {
+            int d = required - '0';
+            if(lo > d || hi < d) {
+                return FALSE;
+            }
+            return lo == d && hi == d ? TRUE : UNKNOWN;
+        }
+        default:
+            return FALSE;
+        }
+    }
+
+    int
+    matchPattern(const char* pattern) const
+    {
+        int result = TRUE;
+        for(std::size_t i = 0; i < 9; i++) {
+            int cell = matchCell(pattern[i], lower[i / 3][i % 3], upper[i / 3][i % 3]);
+            if(cell == FALSE) {
+                return FALSE;
+            }
+            if(cell == UNKNOWN) {
+                result = UNKNOWN;
+            }
+        }
+        return result;
+    }
+
+    int
+    evaluateBounds() const
+    {
+        int result = FALSE;
+        if(predicate->kind == PredicateKind::PATTERN) {
+            result = matchPattern(userPattern);
+        }
+        for(std::size_t i = 0; i < predicate->numPatterns && result != TRUE; i++) {
+            int match = matchPattern(predicate->patterns[i]);
+            if(match != FALSE) {
+                result = match;
+            }
+        }
+        if(result == UNKNOWN || !predicate->negate) {
+            return result;
+        }
+        return result == TRUE ? FALSE : TRUE;
+    }
+
+    void
+    update(Location la, Location lb, int dim)
+    {
+        int& lo = lower[idx(la)][idx(lb)];
+        if(lo >= dim) {
+            return;
+        }
+        if(dim > upper[idx(la)][idx(lb)]) {
+            // only possible with invalid input
+            inconsistent = true;
+            return;
+        }
+        lo = dim;
+        if(outcome == UNKNOWN) {
+            outcome = evaluateBounds();
+        }
+    }
+
+    // update() with the locations of g and of the other geometry
+    void
+    update(const RelateGeometry& g, Location loc, Location otherLoc, int dim)
+    {
+        if(g.isA) {
+            update(loc, otherLoc, dim);
+        }
+        else {
+            update(otherLoc, loc, dim);
+        }
+    }
+
+    /*
+     * Records that a part of g of dimension dim, at location loc in g,
+     * lies at location otherLoc in the other geometry.
+     */
+    void
+    addEvidence(const RelateGeometry& g, Location loc,
+                const RelateGeometry& other, Location otherLoc, int dim)
+    {
+        update(g, loc, otherLoc, dim);
+
+        LocalPart parts[3];
+        if(isOpen(other.dim, otherLoc)) {
+            std::size_t n = localParts(g.dim, loc, parts);
+            for(std::size_t i = 0; i < n; i++) {
+                update(g, parts[i].loc, otherLoc, parts[i].dim);
+            }
+        }
+        if(isOpen(g.dim, loc)) {
+            std::size_t n = localParts(other.dim, otherLoc, parts);
+            for(std::size_t i = 0; i < n; i++) {
+                update(g, loc, parts[i].loc, parts[i].dim);
+            }
+        }
+    }
+
+    int
+    finish() const
+    {
+        return inconsistent ? UNKNOWN : outcome;
+    }
+
+    // Once all the evidence is in, the lower bounds are exact
+    int
+    complete()
+    {
+        if(inconsistent) {
+            return UNKNOWN;
+        }
+        for(std::size_t i = 0; i < 3; i++) {
+            for(std::size_t j = 0; j < 3; j++) {
+                upper[i][j] = lower[i][j];
+            }
+        }
+        outcome = evaluateBounds();
+        return outcome;
+    }
+
+    /*
+     * Locates the points of a puntal geometry, and the boundary points of
+     * a lineal one. Boundary points on lines are found with the nodes.
+     */
+    void
+    locatePoints(RelateGeometry& g, RelateGeometry& other)
+    {
+        if(g.dim == Dimension::P) {
+            for(const CoordinateXY& p : g.points) {
+                addEvidence(g, Location::INTERIOR, other, other.locate(p), Dimension::P);
+                if(isDone()) {
+                    return;
+                }
+            }
+        }
+        else if(g.dim == Dimension::L && other.dim != Dimension::L) {
+            for(const CoordinateXY& p : g.boundaryPoints) {
+                addEvidence(g, Location::BOUNDARY, other, other.locate(p), Dimension::P);
+                if(isDone()) {
+                    return;
+                }
+            }
+        }
+    }
+
+    void
+    computeNodes()
+    {
+        NodeFinder finder(*this);
+        noding::MCIndexSegmentSetMutualIntersector intersector;
+        intersector.setBaseSegments(&geomA.edgeVect);
+        intersector.setSegmentIntersector(&finder);
+        intersector.process(&geomB.edgeVect);
+    }
+
+    // Boundary points of lines not found among the nodes are in the exterior
+    void
+    locateBoundaryOnNodes(RelateGeometry& g, const std::vector<Node>& nodes, RelateGeometry& other)
+    {
+        std::vector<CoordinateXY> nodePts;
+        nodePts.reserve(nodes.size());
+        for(const Node& node : nodes) {
+            nodePts.push_back(node.pt);
+        }
+        std::sort(nodePts.begin(), nodePts.end());
+
+        for(const CoordinateXY& p : g.boundaryPoints) {
+            if(!std::binary_search(nodePts.begin(), nodePts.end(), p)) {
+                addEvidence(g, Location::BOUNDARY, other, Location::EXTERIOR, Dimension::P);
+            }
+        }
+    }
+
+    /*
+     * Locates the pieces of the edges of g between the nodes.
+     *
+     * A piece either lies on an edge of the other geometry or meets it
+     * at its ends only, so one location holds for all of its points, and
+     * for all the following pieces up to the next node: each run of such
+     * pieces is located once.
+     */
+    void
+    locateEdges(RelateGeometry& g, std::vector<Node>& nodes, std::vector<Overlap>& overlaps,
+                RelateGeometry& other)
+    {
+        std::sort(nodes.begin(), nodes.end(), segmentLess<Node>);
+        std::sort(overlaps.begin(), overlaps.end(), segmentLess<Overlap>);
+        auto nodeIt = nodes.begin();
+        auto overlapIt = overlaps.begin();
+
+        struct Vertex {
+            double t;
+            CoordinateXY pt;
+            bool isNode;
+        };
+        std::vector<Vertex> vertices;
+
+        for(std::size_t e = 0; e < g.edges.size(); e++) {
+            const SegmentString& edge = *g.edges[e];
+            Location runLoc = Location::NONE;
+
+            for(std::size_t i = 0; i + 1 < edge.size(); i++) {
+                const CoordinateXY& p0 = edge.getCoordinate<CoordinateXY>(i);
+                const CoordinateXY& p1 = edge.getCoordinate<CoordinateXY>(i + 1);
+
+                auto nodeEnd = nodeIt;
+                while(nodeEnd != nodes.end() && nodeEnd->edge == e && nodeEnd->segment == i) {
+                    ++nodeEnd;
+                }
+                auto overlapEnd = overlapIt;
+                while(overlapEnd != overlaps.end() && overlapEnd->edge == e && overlapEnd->segment == i) {
+                    ++overlapEnd;
+                }
+
+                if(p0.equals2D(p1)) {
+                    nodeIt = nodeEnd;
+                    overlapIt = overlapEnd;
+                    continue;
+                }
+
+                if(nodeIt == nodeEnd) {
+                    if(runLoc == Location::NONE) {
+                        runLoc = locatePiece(p0, p1, other);
+                        addEvidence(g, g.edgeLocation(), other, runLoc, Dimension::L);
+                        if(isDone()) {
+                            return;
+                        }
+                    }
+                    continue;
+                }
+
+                // split the segment at its nodes
+                double dx = p1.x - p0.x;
+                double dy = p1.y - p0.y;
+                double len2 = dx * dx + dy * dy;
+                auto param = [&p0, dx, dy, len2](const CoordinateXY& p) {
+                    return ((p.x - p0.x) * dx + (p.y - p0.y) * dy) / len2;
+                };
+
+                vertices.clear();
+                vertices.push_back({0.0, p0, false});
+                vertices.push_back({1.0, p1, false});
+                for(auto it = nodeIt; it != nodeEnd; ++it) {
+                    vertices.push_back({param(it->pt), it->pt, true});
+                }
+                std::sort(vertices.begin(), vertices.end(), [](const Vertex& a, const Vertex& b) {
+                    return a.t < b.t;
+                });
+
+                for(std::size_t k = 0; k + 1 < vertices.size(); k++) {
+                    Vertex& start = vertices[k];
+                    const Vertex& end = vertices[k + 1];
+                    if(start.pt.equals2D(end.pt)) {
+                        vertices[k + 1].isNode |= start.isNode;
+                        continue;
+                    }
+                    if(start.isNode) {
+                        runLoc = Location::NONE;
+                    }
+
+                    double tMid = (start.t + end.t) / 2;
+                    bool isShared = false;
+                    for(auto it = overlapIt; it != overlapEnd && !isShared; ++it) {
+                        double t0 = param(it->p0);
+                        double t1 = param(it->p1);
+                        isShared = std::min(t0, t1) <= tMid && tMid <= std::max(t0, t1);
+                    }
+
+                    if(isShared) {
+                        addEvidence(g, g.edgeLocation(), other, other.edgeLocation(), Dimension::L);
+                        runLoc = Location::NONE;
+                    }
+                    else if(runLoc == Location::NONE) {
+                        runLoc = locatePiece(start.pt, end.pt, other);
+                        addEvidence(g, g.edgeLocation(), other, runLoc, Dimension::L);
+                    }
+                    if(isDone()) {
+                        return;
+                    }
+                }
+                if(vertices.back().isNode) {
+                    runLoc = Location::NONE;
+                }
+
+                nodeIt = nodeEnd;
+                overlapIt = overlapEnd;
+            }
+        }
+    }
+
+    // Location of a piece of edge which meets the other geometry at its ends only
+    Location
+    locatePiece(const CoordinateXY& p0, const CoordinateXY& p1, RelateGeometry& other)
+    {
+        if(other.dim != Dimension::A) {
+            return Location::EXTERIOR;
+        }
+        CoordinateXY mid((p0.x + p1.x) / 2, (p0.y + p1.y) / 2);
+        Location loc = other.locate(mid);
+        if(loc == Location::BOUNDARY) {
+            // the midpoint was rounded onto the boundary
+            inconsistent = true;
+        }
+        return loc;
+    }
+
+    RelateGeometry geomA;
+    RelateGeometry geomB;
+    const Predicate* predicate;
+    const char* userPattern;
+
+    int lower[3][3];
+    int upper[3][3];
+    int outcome;
+    bool inconsistent;
+
+    LineIntersector li;
+    std::vector<Node> nodesA;
+    std::vector<Node> nodesB;
+    std::vector<Overlap> overlapsA;
+    std::vector<Overlap> overlapsB;
+};
+
+bool
+evaluateWithRelateOp(PredicateKind kind, const Geometry* a, const Geometry* b, const std::string* pattern)
+{
+    switch(kind) {
+    case PredicateKind::PATTERN:
+        return a->relate(b, *pattern);
+    case PredicateKind::INTERSECTS:
+        return a->intersects(b);
+    case PredicateKind::DISJOINT:
+        return a->disjoint(b);
+    case PredicateKind::TOUCHES:
+        return a->touches(b);
+    case PredicateKind::CROSSES:
+        return a->crosses(b);
+    case PredicateKind::WITHIN:
+        return a->within(b);
+    case PredicateKind::CONTAINS:
+        return a->contains(b);
+    case PredicateKind::OVERLAPS:
+        return a->overlaps(b);
+    case PredicateKind::COVERS:
+        return a->covers(b);
+    case PredicateKind::COVERED_BY:
+        return a->coveredBy(b);
+    case PredicateKind::EQUALS:
+        return a->equals(b);
+    case PredicateKind::CONTAINS_PROPERLY:
+        return a->relate(b, "T**FF*FF*");
+    }
+    return false;
+}
+
+bool
+evaluate(PredicateKind kind, const Geometry* a, const Geometry* b, const std::string* pattern = nullptr)
+{
+    RelateEvaluator evaluator(*a, *b);
+    if(evaluator.isSupported()) {
+        Predicate predicate = makePredicate(kind, evaluator.getDimensionA(), evaluator.getDimensionB());
+        int outcome = evaluator.evaluate(predicate, pattern ? pattern->c_str() : nullptr);
+        if(outcome != RelateEvaluator::UNKNOWN) {
+            return outcome == RelateEvaluator::TRUE;
+        }
+    }
+    return evaluateWithRelateOp(kind, a, b, pattern);
+}
+
+} // anonymous namespace
+
+/*public static*/
+bool
+RelatePredicateOp::relate(const Geometry* a, const Geometry* b, const std::string& pattern)
+{
+    if(pattern.length() != 9) {
+        std::ostringstream s;
+        s << "IllegalArgumentException: Should be length 9, is "
+          << "[" << pattern << "] instead" << std::endl;
+        throw util::IllegalArgumentException(s.str());
+    }
+    return evaluate(PredicateKind::PATTERN, a, b, &pattern);
+}
+
+/*public static*/
+bool
+RelatePredicateOp::intersects(const Geometry* a, const Geometry* b)
+{
+    return evaluate(PredicateKind::INTERSECTS, a, b);
+}
+
+/*public static*/
+bool
+RelatePredicateOp::disjoint(const Geometry* a, const Geometry* b)
+{
+    return evaluate(PredicateKind::DISJOINT, a, b);
+}
+
+/*public static*/
+bool
+RelatePredicateOp::touches(const Geometry* a, const Geometry* b)
+{
+    return evaluate(PredicateKind::TOUCHES, a, b);
+}
+
+/*public static*/
+bool
+RelatePredicateOp::crosses(const Geometry* a, const Geometry* b)
+{
+    return evaluate(PredicateKind::CROSSES, a, b);
+}
+
+/*public static*/
+bool
+RelatePredicateOp::within(const Geometry* a, const Geometry* b)
+{
+    return evaluate(PredicateKind::WITHIN, a, b);
+}
+
+/*public static*/
+bool
+RelatePredicateOp::contains(const Geometry* a, const Geometry* b)
+{
+    return evaluate(PredicateKind::CONTAINS, a, b);
+}
+
+/*public static*/
+bool
+RelatePredicateOp::overlaps(const Geometry* a, const Geometry* b)
+{
+    return evaluate(PredicateKind::OVERLAPS, a, b);
+}
+
+/*public static*/
+bool
+RelatePredicateOp::covers(const Geometry* a, const Geometry* b)
+{
+    return evaluate(PredicateKind::COVERS, a, b);
+}
+
+/*public static*/
+bool
+RelatePredicateOp::coveredBy(const Geometry* a, const Geometry* b)
+{
+    return evaluate(PredicateKind::COVERED_BY, a, b);
+}
+
+/*public static*/
+bool
+RelatePredicateOp::equals(const Geometry* a, const Geometry* b)
+{
+    return evaluate(PredicateKind::EQUALS, a, b);
+}
+
+/*public static*/
+bool
+RelatePredicateOp::containsProperly(const Geometry* a, const Geometry* b)
+{
+    return evaluate(PredicateKind::CONTAINS_PROPERLY, a, b);
+}
+
+} // namespace geos.operation.relate
+} // namespace geos.operation
+} // namespace geos
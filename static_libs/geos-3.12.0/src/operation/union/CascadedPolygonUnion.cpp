@@ -31,10 +31,14 @@
 #include <geos/util/TopologyException.h>
 
 // std
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <exception>
 #include <sstream>
 #include <string>
+#include <system_error>
+#include <thread>
 
 
 namespace geos {
@@ -70,6 +74,15 @@ CascadedPolygonUnion::Union(const geom::MultiPolygon* multipoly)
     return op.Union();
 }
 
+void
+CascadedPolygonUnion::setNumThreads(std::size_t p_numThreads)
+{
+    if(p_numThreads == 0) {
+        p_numThreads = std::thread::hardware_concurrency();
+    }
+    numThreads = std::max<std::size_t>(p_numThreads, 1);
+}
+
 std::unique_ptr<geom::Geometry>
 CascadedPolygonUnion::Union()
 {
@@ -94,9 +107,62 @@ CascadedPolygonUnion::Union()
     // TODO avoid creating this vector and run binaryUnion off the iterators directly
     std::vector<const geom::Geometry*> geoms(index.items().begin(), index.items().end());
 
+    if(numThreads > 1) {
+        return binaryUnionParallel(geoms, 0, geoms.size(), numThreads);
+    }
     return binaryUnion(geoms, 0, geoms.size());
 }
 
+std::unique_ptr<geom::Geometry>
+CascadedPolygonUnion::binaryUnionParallel(const std::vector<const geom::Geometry*> & geoms,
+                                          std::size_t start, std::size_t end, std::size_t nThreads)
+{
+    // sections split exactly as in binaryUnion, so the same unions are computed
+    if(nThreads < 2 || end - start < MIN_PARALLEL_GEOMS) {
+        return binaryUnion(geoms, start, end);
+    }
+
+    std::size_t mid = (end + start) / 2;
+    std::size_t nThreads0 = nThreads / 2;
+    std::unique_ptr<geom::Geometry> g0;
+    std::exception_ptr error0;
+
+    std::thread worker;
+    try {
+        worker = std::thread([&]() {
+            try {
+                g0 = binaryUnionParallel(geoms, start, mid, nThreads0);
+            }
+            catch(...) {
+                error0 = std::current_exception();
+            }
+        });
+    }
+    catch(const std::system_error&) {
+        // out of threads: union the first half here too
+        g0 = binaryUnion(geoms, start, mid);
+    }
+
+    std::unique_ptr<geom::Geometry> g1;
+    try {
+        g1 = binaryUnionParallel(geoms, mid, end, nThreads - nThreads0);
+    }
+    catch(...) {
+        if(worker.joinable()) {
+            worker.join();
+        }
+        throw;
+    }
+    if(worker.joinable()) {
+        worker.join();
+    }
+    if(error0) {
+        std::rethrow_exception(error0);
+    }
+
+    return unionSafe(std::move(g0), std::move(g1));
+}
+
 
 std::unique_ptr<geom::Geometry>
 CascadedPolygonUnion::binaryUnion(const std::vector<const geom::Geometry*> & geoms,
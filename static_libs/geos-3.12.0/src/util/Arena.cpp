@@ -0,0 +1,90 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/util/Arena.h>
+
+#include <algorithm>
+#include <new>
+
+namespace geos {
+namespace util { // geos::util
+
+/*public*/
+Arena::Arena(std::size_t p_initialBlockSize)
+    : head(nullptr)
+    , cur(nullptr)
+    , end(nullptr)
+    , nextBlockSize(std::max<std::size_t>(p_initialBlockSize, 64))
+    , initialBlockSize(nextBlockSize)
+    , numBlocks(0)
+    , bytesAllocated(0)
+{}
+
+/*public*/
+Arena::~Arena()
+{
+    release();
+}
+
+/*public*/
+void
+Arena::release()
+{
+    while (head != nullptr) {
+        Block* prev = head->prev;
+        ::operator delete(head);
+        head = prev;
+    }
+    cur = nullptr;
+    end = nullptr;
+    nextBlockSize = initialBlockSize;
+    numBlocks = 0;
+    bytesAllocated = 0;
+}
+
+/*private*/
+void*
+Arena::allocateSlow(std::size_t bytes, std::size_t alignment)
+{
+    // block header, then enough room for the worst misalignment
+    std::size_t headerSize = sizeof(Block);
+    std::size_t needed = headerSize + alignment + bytes;
+    std::size_t blockSize = std::max(nextBlockSize, needed);
+
+    Block* block = static_cast<Block*>(::operator new(blockSize));
+    block->prev = head;
+    head = block;
+    numBlocks++;
+
+    char* start = reinterpret_cast<char*>(block) + headerSize;
+    char* blockEnd = reinterpret_cast<char*>(block) + blockSize;
+
+    // an oversized request gets a block of its own, so that the
+    // current block keeps serving the small ones
+    if (blockSize > nextBlockSize && cur != nullptr) {
+        bytesAllocated += bytes;
+        return start + alignmentOffset(start, alignment);
+    }
+
+    cur = start;
+    end = blockEnd;
+    nextBlockSize = std::min(nextBlockSize * 2, MAX_BLOCK_SIZE);
+
+    std::size_t offset = alignmentOffset(cur, alignment);
+    void* p = cur + offset;
+    cur += offset + bytes;
+    bytesAllocated += bytes;
+    return p;
+}
+
+} // namespace geos::util
+} // namespace geos
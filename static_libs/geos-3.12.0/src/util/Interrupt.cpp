@@ -13,7 +13,6 @@
  **********************************************************************/
 
 #include <geos/util/Interrupt.h>
-#include <geos/util/GEOSException.h> // for inheritance
 
 namespace {
 /* Could these be portably stored in thread-specific space ? */
@@ -25,12 +24,6 @@ geos::util::Interrupt::Callback* callback = nullptr;
 namespace geos {
 namespace util { // geos::util
 
-class GEOS_DLL InterruptedException: public GEOSException {
-public:
-    InterruptedException() :
-        GEOSException("InterruptedException", "Interrupted!") {}
-};
-
 void
 Interrupt::request()
 {
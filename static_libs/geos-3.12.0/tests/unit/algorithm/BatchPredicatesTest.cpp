@@ -0,0 +1,252 @@
+//
+// Test Suite for geos::algorithm::BatchPredicates
+
+#include <tut/tut.hpp>
+// geos
+#include <geos/algorithm/BatchPredicates.h>
+#include <geos/algorithm/CGAlgorithmsDD.h>
+#include <geos/algorithm/RayCrossingCounter.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <cmath>
+#include <limits>
+#include <random>
+
+using geos::algorithm::BatchPredicates;
+using geos::algorithm::CGAlgorithmsDD;
+using geos::algorithm::RayCrossingCounter;
+using geos::geom::CoordinateSequence;
+using geos::geom::CoordinateXY;
+using geos::geom::Envelope;
+using geos::geom::Location;
+
+namespace tut {
+//
+// Test Group
+//
+
+struct test_batchpredicates_data {
+    static constexpr std::size_t N = BatchPredicates::BATCH_SIZE;
+
+    std::default_random_engine e;
+    std::uniform_int_distribution<int> grid;
+
+    test_batchpredicates_data() : e(12345), grid(-4, 4) {}
+
+    // Small integer coordinates give plenty of collinear
+    // and touching cases
+    double
+    coord()
+    {
+        return grid(e);
+    }
+
+    void
+    checkOrientation(const double* p1x, const double* p1y,
+                     const double* p2x, const double* p2y,
+                     const double* qx, const double* qy)
+    {
+        int filtered[N];
+        int orient[N];
+        BatchPredicates::orientationIndexFilter(p1x, p1y, p2x, p2y, qx, qy, filtered);
+        BatchPredicates::orientationIndex(p1x, p1y, p2x, p2y, qx, qy, orient);
+
+        for (std::size_t i = 0; i < N; i++) {
+            int expected = CGAlgorithmsDD::orientationIndex(p1x[i], p1y[i], p2x[i], p2y[i], qx[i], qy[i]);
+            ensure_equals(orient[i], expected);
+            if (filtered[i] != CGAlgorithmsDD::FAILURE) {
+                ensure_equals(filtered[i], expected);
+            }
+        }
+    }
+
+    // Counts the ring segments against the point, as the
+    // scalar loop does
+    static Location
+    locateScalar(const CoordinateXY& p, const CoordinateSequence& ring)
+    {
+        RayCrossingCounter rcc(p);
+        for (std::size_t i = 1; i < ring.size(); i++) {
+            rcc.countSegment(ring.getAt<CoordinateXY>(i - 1), ring.getAt<CoordinateXY>(i));
+            if (rcc.isOnSegment()) {
+                break;
+            }
+        }
+        return rcc.getLocation();
+    }
+};
+
+typedef test_group<test_batchpredicates_data> group;
+typedef group::object object;
+
+group test_batchpredicates_group("geos::algorithm::BatchPredicates");
+
+//
+// Test Cases
+//
+
+// Orientation of random triples matches CGAlgorithmsDD
+template<>
+template<>
+void object::test<1>
+()
+{
+    std::uniform_real_distribution<double> real(-1000, 1000);
+    double v[6][N];
+
+    for (int iter = 0; iter < 2000; iter++) {
+        for (auto& ord : v) {
+            for (double& d : ord) {
+                d = iter % 2 ? coord() : real(e);
+            }
+        }
+        checkOrientation(v[0], v[1], v[2], v[3], v[4], v[5]);
+    }
+}
+
+// Nearly collinear triples need the extended precision fallback
+template<>
+template<>
+void object::test<2>
+()
+{
+    // from OrientationIndexFailureTest
+    double p1x[N], p1y[N], p2x[N], p2y[N], qx[N], qy[N];
+    for (std::size_t i = 0; i < N; i++) {
+        p1x[i] = 219.3649559090992;
+        p1y[i] = 140.84159161824724;
+        p2x[i] = 168.9018919682399;
+        p2y[i] = -5.713787599646864;
+        qx[i] = 186.80814046338352 + static_cast<double>(i) * 1e-14;
+        qy[i] = 46.28973405831556;
+    }
+
+    int filtered[N];
+    ensure(BatchPredicates::orientationIndexFilter(p1x, p1y, p2x, p2y, qx, qy, filtered));
+    ensure_equals(filtered[0], CGAlgorithmsDD::FAILURE);
+
+    checkOrientation(p1x, p1y, p2x, p2y, qx, qy);
+}
+
+// Non finite points are left to the scalar code
+template<>
+template<>
+void object::test<3>
+()
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    double p1x[N], p1y[N], p2x[N], p2y[N], qx[N], qy[N];
+    for (std::size_t i = 0; i < N; i++) {
+        p1x[i] = 0;
+        p1y[i] = 0;
+        p2x[i] = 10;
+        p2y[i] = 0;
+        qx[i] = 5;
+        qy[i] = 1;
+    }
+    qy[N - 1] = inf;
+
+    int orient[N];
+    ensure(BatchPredicates::orientationIndexFilter(p1x, p1y, p2x, p2y, qx, qy, orient));
+    ensure_equals(orient[0], 1);
+    ensure_equals(orient[N - 1], CGAlgorithmsDD::FAILURE);
+
+    try {
+        BatchPredicates::orientationIndex(p1x, p1y, p2x, p2y, qx, qy, orient);
+        fail("IllegalArgumentException expected");
+    }
+    catch (const geos::util::IllegalArgumentException&) {
+    }
+
+    qy[N - 1] = 1;
+    p2y[1] = nan;
+    checkOrientation(p1x, p1y, p2x, p2y, qx, qy);
+}
+
+// Segment envelopes match Envelope::intersects, with and without tolerance
+template<>
+template<>
+void object::test<4>
+()
+{
+    double v[8][N];
+    for (double tolerance : { 0.0, 0.5, 1.0 }) {
+        for (int iter = 0; iter < 2000; iter++) {
+            for (auto& ord : v) {
+                for (double& d : ord) {
+                    d = coord();
+                }
+            }
+
+            unsigned mask = BatchPredicates::segmentEnvelopesIntersect(
+                                v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], tolerance);
+            for (std::size_t i = 0; i < N; i++) {
+                Envelope envP(v[0][i], v[2][i], v[1][i], v[3][i]);
+                Envelope envQ(v[4][i], v[6][i], v[5][i], v[7][i]);
+                envP.expandBy(tolerance);
+                ensure_equals(((mask >> i) & 1u) != 0, envP.intersects(envQ));
+            }
+        }
+    }
+}
+
+// Segments screened out by rayCrossingCandidates leave the counter unchanged
+template<>
+template<>
+void object::test<5>
+()
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    double x[N + 1];
+    double y[N + 1];
+
+    for (int iter = 0; iter < 5000; iter++) {
+        for (std::size_t k = 0; k <= N; k++) {
+            x[k] = coord();
+            y[k] = coord();
+        }
+        if (iter % 100 == 0) {
+            y[iter % N] = nan;
+        }
+        CoordinateXY p(coord(), coord());
+
+        unsigned mask = BatchPredicates::rayCrossingCandidates(x, y, p.x, p.y);
+        for (std::size_t i = 0; i < N; i++) {
+            if (mask & (1u << i)) {
+                continue;
+            }
+            RayCrossingCounter rcc(p);
+            rcc.countSegment(CoordinateXY(x[i], y[i]), CoordinateXY(x[i + 1], y[i + 1]));
+            ensure(!rcc.isOnSegment());
+            ensure_equals(rcc.getLocation(), Location::EXTERIOR);
+        }
+    }
+}
+
+// Batched point in ring matches the segment by segment count
+template<>
+template<>
+void object::test<6>
+()
+{
+    for (std::size_t size : { 4u, 5u, 9u, 12u, 31u }) {
+        for (int iter = 0; iter < 200; iter++) {
+            CoordinateSequence ring;
+            for (std::size_t i = 0; i + 1 < size; i++) {
+                ring.add(CoordinateXY(coord(), coord()));
+            }
+            ring.closeRing();
+
+            for (int j = 0; j < 20; j++) {
+                CoordinateXY p(coord() / 2, coord() / 2);
+                ensure_equals(RayCrossingCounter::locatePointInRing(p, ring), locateScalar(p, ring));
+            }
+        }
+    }
+}
+
+} // namespace tut
@@ -0,0 +1,264 @@
+//
+// Test Suite for C-API batch operations
+
+#include <tut/tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cmath>
+#include <vector>
+
+#include "capi_test_utils.h"
+
+namespace tut {
+//
+// Test Group
+//
+
+// Common data used in test cases.
+struct test_capigeosbatch_data : public capitest::utility {
+    std::vector<GEOSGeometry*> geoms_;
+    std::vector<GEOSGeometry*> results_;
+
+    ~test_capigeosbatch_data()
+    {
+        for (GEOSGeometry* g : geoms_) {
+            GEOSGeom_destroy(g);
+        }
+        for (GEOSGeometry* g : results_) {
+            if (g) {
+                GEOSGeom_destroy(g);
+            }
+        }
+    }
+
+    // Mix of points, lines and polygons spread over a grid
+    void
+    createGeoms(unsigned int n)
+    {
+        for (unsigned int i = 0; i < n; i++) {
+            double x = (i % 20) * 10.0;
+            double y = (i / 20) * 10.0;
+            GEOSGeometry* g;
+            switch (i % 3) {
+            case 0:
+                g = GEOSGeom_createPointFromXY(x, y);
+                break;
+            case 1: {
+                GEOSCoordSequence* cs = GEOSCoordSeq_create(2, 2);
+                GEOSCoordSeq_setXY(cs, 0, x, y);
+                GEOSCoordSeq_setXY(cs, 1, x + 15, y + 7);
+                g = GEOSGeom_createLineString(cs);
+                break;
+            }
+            default:
+                g = GEOSGeom_createRectangle(x, y, x + 12, y + 8);
+                break;
+            }
+            GEOSSetSRID(g, 4326);
+            geoms_.push_back(g);
+        }
+    }
+
+    std::vector<const GEOSGeometry*>
+    repeated(const GEOSGeometry* g, std::size_t n)
+    {
+        return std::vector<const GEOSGeometry*>(n, g);
+    }
+};
+
+typedef test_group<test_capigeosbatch_data> group;
+typedef group::object object;
+
+group test_capigeosbatch_group("capi::GEOSBatch");
+
+//
+// Test Cases
+//
+
+// Buffer results match GEOSBuffer, whatever the number of threads
+template<>
+template<>
+void object::test<1>
+()
+{
+    createGeoms(300);
+    const unsigned int n = static_cast<unsigned int>(geoms_.size());
+
+    for (unsigned int numThreads : { 1u, 4u, 0u }) {
+        results_.assign(n, nullptr);
+        std::vector<char> status(n, 0);
+        int ret = GEOSBatchBuffer(geoms_.data(), n, 2.5, 8, numThreads,
+                                  results_.data(), status.data());
+        ensure_equals(ret, 1);
+
+        for (unsigned int i = 0; i < n; i++) {
+            ensure_equals(status[i], 1);
+            GEOSGeometry* expected = GEOSBuffer(geoms_[i], 2.5, 8);
+            ensure_equals(GEOSEqualsIdentical(results_[i], expected), 1);
+            ensure_equals(GEOSGetSRID(results_[i]), 4326);
+            GEOSGeom_destroy(expected);
+            GEOSGeom_destroy(results_[i]);
+        }
+        results_.clear();
+    }
+}
+
+// A failing item is reported without stopping the others
+template<>
+template<>
+void object::test<2>
+()
+{
+    createGeoms(100);
+    const unsigned int n = static_cast<unsigned int>(geoms_.size());
+
+    geom1_ = fromWKT("POLYGON ((0 0, 100 0, 100 100, 0 100, 0 0))");
+    std::vector<const GEOSGeometry*> geomsB = repeated(geom1_, n);
+    geomsB[42] = nullptr;
+
+    results_.assign(n, nullptr);
+    std::vector<char> status(n, 1);
+    int ret = GEOSBatchIntersection(geoms_.data(), geomsB.data(), n, 3,
+                                    results_.data(), status.data());
+    ensure_equals(ret, 0);
+    ensure_equals(status[42], 0);
+    ensure(results_[42] == nullptr);
+
+    for (unsigned int i = 0; i < n; i++) {
+        if (i == 42) continue;
+        ensure_equals(status[i], 1);
+        GEOSGeometry* expected = GEOSIntersection(geoms_[i], geom1_);
+        ensure_equals(GEOSEqualsIdentical(results_[i], expected), 1);
+        GEOSGeom_destroy(expected);
+    }
+
+    // status is optional
+    for (GEOSGeometry*& g : results_) {
+        if (g) GEOSGeom_destroy(g);
+        g = nullptr;
+    }
+    geomsB[42] = geom1_;
+    ensure_equals(GEOSBatchIntersection(geoms_.data(), geomsB.data(), n, 2,
+                                        results_.data(), nullptr), 1);
+}
+
+// Prepared predicates match the single geometry ones
+template<>
+template<>
+void object::test<3>
+()
+{
+    createGeoms(200);
+    const unsigned int n = static_cast<unsigned int>(geoms_.size());
+
+    geom1_ = fromWKT("POLYGON ((5 5, 95 5, 95 55, 60 55, 60 95, 5 95, 5 5))");
+    const GEOSPreparedGeometry* pg = GEOSPrepare(geom1_);
+
+    typedef char (*Predicate)(const GEOSPreparedGeometry*, const GEOSGeometry*);
+    struct {
+        GEOSPreparedPredicates predicate;
+        Predicate single;
+    } cases[] = {
+        { GEOS_PREP_CONTAINS, GEOSPreparedContains },
+        { GEOS_PREP_CONTAINSPROPERLY, GEOSPreparedContainsProperly },
+        { GEOS_PREP_COVEREDBY, GEOSPreparedCoveredBy },
+        { GEOS_PREP_COVERS, GEOSPreparedCovers },
+        { GEOS_PREP_CROSSES, GEOSPreparedCrosses },
+        { GEOS_PREP_DISJOINT, GEOSPreparedDisjoint },
+        { GEOS_PREP_INTERSECTS, GEOSPreparedIntersects },
+        { GEOS_PREP_OVERLAPS, GEOSPreparedOverlaps },
+        { GEOS_PREP_TOUCHES, GEOSPreparedTouches },
+        { GEOS_PREP_WITHIN, GEOSPreparedWithin },
+    };
+
+    for (const auto& c : cases) {
+        std::vector<char> results(n, 3);
+        ensure_equals(GEOSBatchPreparedPredicate(pg, c.predicate, geoms_.data(), n, 4,
+                                                 results.data()), 1);
+        for (unsigned int i = 0; i < n; i++) {
+            ensure_equals(results[i], c.single(pg, geoms_[i]));
+        }
+    }
+
+    // unknown predicate
+    std::vector<char> results(n, 0);
+    ensure_equals(GEOSBatchPreparedPredicate(pg, static_cast<GEOSPreparedPredicates>(99),
+                                             geoms_.data(), n, 4, results.data()), 0);
+    for (char r : results) {
+        ensure_equals(r, 2);
+    }
+
+    GEOSPreparedGeom_destroy(pg);
+}
+
+// Distances match GEOSDistance
+template<>
+template<>
+void object::test<4>
+()
+{
+    createGeoms(150);
+    const unsigned int n = static_cast<unsigned int>(geoms_.size());
+
+    geom1_ = fromWKT("LINESTRING (-50 -50, 250 -20)");
+    std::vector<const GEOSGeometry*> geomsB = repeated(geom1_, n);
+
+    std::vector<double> distances(n, -1);
+    std::vector<char> status(n, 0);
+    ensure_equals(GEOSBatchDistance(geoms_.data(), geomsB.data(), n, 0,
+                                    distances.data(), status.data()), 1);
+
+    for (unsigned int i = 0; i < n; i++) {
+        double expected;
+        ensure_equals(GEOSDistance(geoms_[i], geom1_, &expected), 1);
+        ensure_equals(status[i], 1);
+        ensure_equals(distances[i], expected);
+    }
+}
+
+// Empty batches
+template<>
+template<>
+void object::test<5>
+()
+{
+    ensure_equals(GEOSBatchBuffer(nullptr, 0, 1, 8, 4, nullptr, nullptr), 1);
+    ensure_equals(GEOSBatchDistance(nullptr, nullptr, 0, 0, nullptr, nullptr), 1);
+}
+
+// Interruption aborts the whole batch
+template<>
+template<>
+void object::test<6>
+()
+{
+    createGeoms(300);
+    const unsigned int n = static_cast<unsigned int>(geoms_.size());
+
+    struct InterruptAll {
+        static void
+        callback()
+        {
+            GEOS_interruptRequest();
+        }
+    };
+    GEOSInterruptCallback* prev = GEOS_interruptRegisterCallback(InterruptAll::callback);
+
+    results_.assign(n, nullptr);
+    std::vector<char> status(n, 1);
+    int ret = GEOSBatchBuffer(geoms_.data(), n, 2.5, 8, 4, results_.data(), status.data());
+
+    GEOS_interruptRegisterCallback(prev);
+    GEOS_interruptCancel();
+
+    ensure_equals(ret, 0);
+    std::size_t numDone = 0;
+    for (unsigned int i = 0; i < n; i++) {
+        ensure_equals(status[i] == 1, results_[i] != nullptr);
+        numDone += status[i];
+    }
+    ensure(numDone < n);
+}
+
+} // namespace tut
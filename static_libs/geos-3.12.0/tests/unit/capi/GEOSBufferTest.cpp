@@ -615,4 +615,24 @@ void object::test<24>
     ensure(result_ == nullptr);
 }
 
+// Parallel buffer of a multi-part geometry
+template<>
+template<>
+void object::test<25>
+()
+{
+    geom1_ = GEOSGeomFromWKT("MULTIPOLYGON (((0 0, 10 0, 10 10, 0 10, 0 0)), ((11 0, 20 0, 20 10, 11 10, 11 0)), "
+                             "((100 0, 110 0, 110 10, 100 10, 100 0)))");
+    GEOSSetSRID(geom1_, 4326);
+    bp_ = GEOSBufferParams_create();
+    GEOSBufferParams_setJoinStyle(bp_, GEOSBUF_JOIN_MITRE);
+
+    expected_ = GEOSBufferWithParams(geom1_, bp_, 2);
+    result_ = GEOSBufferParallel(geom1_, bp_, 2, 0);
+    ensure(result_ != nullptr);
+    ensure_equals(GEOSGetNumGeometries(result_), 2);
+    ensure_equals(GEOSGetSRID(result_), 4326);
+    ensure_geometry_equals(result_, expected_);
+}
+
 } // namespace tut
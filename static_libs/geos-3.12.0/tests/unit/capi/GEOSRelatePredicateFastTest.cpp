@@ -0,0 +1,49 @@
+#include <tut/tut.hpp>
+// geos
+#include <geos_c.h>
+
+#include "capi_test_utils.h"
+
+namespace tut {
+//
+// Test Group
+//
+
+struct test_geosrelatepredicatefast_data : public capitest::utility {};
+
+typedef test_group<test_geosrelatepredicatefast_data> group;
+typedef group::object object;
+
+group test_geosrelatepredicatefast("capi::GEOSRelatePredicateFast");
+
+template<>
+template<>
+void object::test<1>()
+{
+    geom1_ = fromWKT("POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))");
+    geom2_ = fromWKT("POLYGON ((10 0, 20 0, 20 10, 10 10, 10 0))");
+    geom3_ = fromWKT("POINT (5 5)");
+
+    ensure_equals(GEOSRelatePredicateFast(geom1_, geom2_, GEOS_PREP_TOUCHES), 1);
+    ensure_equals(GEOSRelatePredicateFast(geom1_, geom2_, GEOS_PREP_OVERLAPS), 0);
+    ensure_equals(GEOSRelatePredicateFast(geom1_, geom3_, GEOS_PREP_CONTAINSPROPERLY), 1);
+    ensure_equals(GEOSRelatePredicateFast(geom3_, geom1_, GEOS_PREP_WITHIN), 1);
+    ensure_equals(GEOSRelatePredicateFast(geom2_, geom3_, GEOS_PREP_DISJOINT), 1);
+
+    ensure_equals(GEOSRelatePatternFast(geom1_, geom2_, "FF2F11212"), 1);
+    ensure_equals(GEOSRelatePatternFast(geom1_, geom3_, "0********"), 1);
+    ensure_equals(GEOSRelatePatternFast(geom1_, geom3_, "1********"), 0);
+}
+
+// Errors
+template<>
+template<>
+void object::test<2>()
+{
+    geom1_ = fromWKT("POINT (1 1)");
+
+    ensure_equals(GEOSRelatePatternFast(geom1_, geom1_, "0FF"), 2);
+    ensure_equals(GEOSRelatePredicateFast(geom1_, geom1_, static_cast<GEOSPreparedPredicates>(0)), 2);
+}
+
+} // namespace tut
@@ -6,11 +6,13 @@
 #include <geos_c.h>
 #include <geos/constants.h>
 // std
+#include <algorithm>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
 #include <cmath>
 #include <thread>
+#include <vector>
 
 #include "capi_test_utils.h"
 
@@ -507,6 +509,88 @@ void object::test<14>()
 }
 
 
+// Serialized trees find the ids of the items
+template<>
+template<>
+void object::test<15>()
+{
+    GEOSSTRtree* tree = GEOSSTRtree_create(4);
+    std::vector<GEOSGeometry*> geoms;
+
+    for (std::size_t i = 0; i < 100; i++) {
+        geoms.push_back(GEOSGeom_createPointFromXY((double) i, (double) i));
+        GEOSSTRtree_insert(tree, geoms.back(), reinterpret_cast<void*>(i + 1));
+    }
+
+    std::size_t size = 0;
+    unsigned char* buf = GEOSSTRtree_serialize(tree, nullptr, nullptr, &size);
+    ensure(buf != nullptr);
+    GEOSSTRtree_destroy(tree);
+
+    GEOSSTRtreeView* view = GEOSSTRtree_view(buf, size);
+    ensure(view != nullptr);
+
+    GEOSGeometry* query = fromWKT("LINESTRING (9.5 9.5, 20.5 20.5)");
+    std::vector<std::size_t> hits;
+    ensure_equals(GEOSSTRtree_queryView(view, query, [](void* item, void* userdata) {
+        static_cast<std::vector<std::size_t>*>(userdata)->push_back(reinterpret_cast<std::size_t>(item));
+    }, &hits), 1);
+    std::sort(hits.begin(), hits.end());
+
+    ensure_equals(hits.size(), 11u);
+    ensure_equals(hits.front(), 11u);
+    ensure_equals(hits.back(), 21u);
+
+    ensure(GEOSSTRtree_view(buf, size - 1) == nullptr);
+
+    GEOSGeom_destroy(query);
+    GEOSSTRtree_destroyView(view);
+    GEOSFree(buf);
+    for (auto& g : geoms) {
+        GEOSGeom_destroy(g);
+    }
+}
+
+// Item ids can be given by a callback
+template<>
+template<>
+void object::test<16>()
+{
+    GEOSSTRtree* tree = GEOSSTRtree_create(10);
+    std::vector<INTPOINT> points;
+    for (int i = 0; i < 20; i++) {
+        points.emplace_back(i, 0);
+    }
+    std::vector<GEOSGeometry*> geoms;
+    for (auto& p : points) {
+        geoms.push_back(INTPOINT2GEOS(&p));
+        GEOSSTRtree_insert(tree, geoms.back(), &p);
+    }
+
+    std::size_t size = 0;
+    unsigned char* buf = GEOSSTRtree_serialize(tree, [](const void* item, void*) {
+        return static_cast<std::size_t>(static_cast<const INTPOINT*>(item)->x * 10);
+    }, nullptr, &size);
+    GEOSSTRtree_destroy(tree);
+
+    GEOSSTRtreeView* view = GEOSSTRtree_view(buf, size);
+    GEOSGeometry* query = GEOSGeom_createPointFromXY(7, 0);
+    std::vector<std::size_t> hits;
+    GEOSSTRtree_queryView(view, query, [](void* item, void* userdata) {
+        static_cast<std::vector<std::size_t>*>(userdata)->push_back(reinterpret_cast<std::size_t>(item));
+    }, &hits);
+
+    ensure_equals(hits.size(), 1u);
+    ensure_equals(hits[0], 70u);
+
+    GEOSGeom_destroy(query);
+    GEOSSTRtree_destroyView(view);
+    GEOSFree(buf);
+    for (auto& g : geoms) {
+        GEOSGeom_destroy(g);
+    }
+}
+
 } // namespace tut
 
 
@@ -9,6 +9,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string>
 
 #include "capi_test_utils.h"
 
@@ -219,6 +220,38 @@ void object::test<11>
 }
 
 
+// Parallel union gives the same result as GEOSUnaryUnion
+template<>
+template<>
+void object::test<12>
+()
+{
+    std::string wkt = "MULTIPOLYGON (";
+    for(int i = 0; i < 30; i++) {
+        for(int j = 0; j < 30; j++) {
+            wkt += (i || j) ? ", " : "";
+            wkt += "((" + std::to_string(i) + " " + std::to_string(j) + ", " +
+                   std::to_string(i + 1.5) + " " + std::to_string(j) + ", " +
+                   std::to_string(i + 1.5) + " " + std::to_string(j + 1.5) + ", " +
+                   std::to_string(i) + " " + std::to_string(j + 1.5) + ", " +
+                   std::to_string(i) + " " + std::to_string(j) + "))";
+        }
+    }
+    wkt += ")";
+    input_ = GEOSGeomFromWKT(wkt.c_str());
+    GEOSSetSRID(input_, 4326);
+
+    expected_ = GEOSUnaryUnion(input_);
+    for(unsigned int numThreads : { 0u, 1u, 4u }) {
+        result_ = GEOSUnaryUnionParallel(input_, numThreads);
+        ensure(result_ != nullptr);
+        ensure_equals(GEOSEqualsExact(result_, expected_, 0), 1);
+        ensure_equals(GEOSGetSRID(result_), 4326);
+        GEOSGeom_destroy(result_);
+        result_ = nullptr;
+    }
+}
+
 } // namespace tut
 
 
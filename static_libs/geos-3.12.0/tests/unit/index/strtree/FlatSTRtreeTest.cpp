@@ -0,0 +1,214 @@
+//
+// Test Suite for geos::index::strtree::FlatSTRtree
+
+#include <tut/tut.hpp>
+// geos
+#include <geos/geom/Envelope.h>
+#include <geos/index/strtree/FlatSTRtree.h>
+#include <geos/index/strtree/TemplateSTRtree.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using geos::geom::Envelope;
+using geos::index::strtree::FlatSTRtree;
+using geos::index::strtree::TemplateSTRtree;
+
+namespace tut {
+//
+// Test Group
+//
+
+struct test_flatstrtree_data {
+    std::default_random_engine e;
+    std::uniform_real_distribution<double> coord;
+
+    test_flatstrtree_data() : e(2024), coord(0, 100) {}
+
+    Envelope
+    randomEnvelope(double maxSize)
+    {
+        double x = coord(e);
+        double y = coord(e);
+        return Envelope(x, x + coord(e) * maxSize / 100, y, y + coord(e) * maxSize / 100);
+    }
+
+    static std::vector<unsigned char>
+    serialize(TemplateSTRtree<std::size_t>& tree)
+    {
+        return FlatSTRtree::serialize(tree, [](std::size_t item) {
+            return static_cast<FlatSTRtree::ItemId>(item * 3 + 1);
+        });
+    }
+
+    // Checks that the flat tree finds what the tree finds, in the same order
+    void
+    checkQueries(TemplateSTRtree<std::size_t>& tree, const FlatSTRtree& flat)
+    {
+        for (int i = 0; i < 200; i++) {
+            Envelope env = randomEnvelope(20);
+
+            std::vector<FlatSTRtree::ItemId> expected;
+            tree.query(env, [&expected](std::size_t item) {
+                expected.push_back(item * 3 + 1);
+            });
+
+            std::vector<FlatSTRtree::ItemId> actual;
+            flat.query(env, actual);
+            ensure(actual == expected);
+        }
+    }
+
+    static void
+    ensureRejected(const std::vector<unsigned char>& buf, std::size_t size)
+    {
+        try {
+            FlatSTRtree flat(buf.data(), size);
+            fail("IllegalArgumentException expected");
+        }
+        catch (const geos::util::IllegalArgumentException&) {
+        }
+    }
+};
+
+typedef test_group<test_flatstrtree_data> group;
+typedef group::object object;
+
+group test_flatstrtree_group("geos::index::strtree::FlatSTRtree");
+
+//
+// Test Cases
+//
+
+// Queries match the source tree
+template<>
+template<>
+void object::test<1>
+()
+{
+    for (std::size_t n : { 1u, 2u, 10u, 11u, 1000u, 5000u }) {
+        TemplateSTRtree<std::size_t> tree(10);
+        for (std::size_t i = 0; i < n; i++) {
+            tree.insert(randomEnvelope(5), i);
+        }
+
+        auto buf = serialize(tree);
+        FlatSTRtree flat(buf.data(), buf.size());
+        ensure_equals(flat.getNumItems(), n);
+        ensure_equals(buf.size(), FlatSTRtree::HEADER_SIZE + flat.getNumNodes() * FlatSTRtree::NODE_SIZE);
+        ensure(flat.getBounds() == tree.getRoot()->getBounds());
+
+        checkQueries(tree, flat);
+    }
+}
+
+// The buffer can be copied anywhere, unaligned
+template<>
+template<>
+void object::test<2>
+()
+{
+    TemplateSTRtree<std::size_t> tree(4);
+    for (std::size_t i = 0; i < 500; i++) {
+        tree.insert(randomEnvelope(5), i);
+    }
+    auto buf = serialize(tree);
+
+    std::vector<unsigned char> copy(buf.size() + 1);
+    std::copy(buf.begin(), buf.end(), copy.begin() + 1);
+    FlatSTRtree flat(copy.data() + 1, buf.size());
+
+    checkQueries(tree, flat);
+}
+
+// Removed items are left out, and an empty tree serializes
+template<>
+template<>
+void object::test<3>
+()
+{
+    TemplateSTRtree<std::size_t> tree(4);
+    std::vector<Envelope> envs;
+    for (std::size_t i = 0; i < 100; i++) {
+        envs.push_back(randomEnvelope(5));
+        tree.insert(envs.back(), i);
+    }
+    for (std::size_t i = 0; i < 100; i += 2) {
+        ensure(tree.remove(envs[i], i));
+    }
+
+    auto buf = serialize(tree);
+    FlatSTRtree flat(buf.data(), buf.size());
+    ensure_equals(flat.getNumItems(), 50u);
+    checkQueries(tree, flat);
+
+    TemplateSTRtree<std::size_t> empty;
+    auto emptyBuf = serialize(empty);
+    FlatSTRtree emptyFlat(emptyBuf.data(), emptyBuf.size());
+    ensure_equals(emptyFlat.getNumNodes(), 0u);
+    ensure(emptyFlat.getBounds().isNull());
+
+    std::vector<FlatSTRtree::ItemId> hits;
+    emptyFlat.query(Envelope(0, 100, 0, 100), hits);
+    ensure(hits.empty());
+}
+
+// Queries stop when the visitor returns false
+template<>
+template<>
+void object::test<4>
+()
+{
+    TemplateSTRtree<std::size_t> tree(4);
+    for (std::size_t i = 0; i < 100; i++) {
+        tree.insert(Envelope(0, 1, 0, 1), i);
+    }
+    auto buf = serialize(tree);
+    FlatSTRtree flat(buf.data(), buf.size());
+
+    std::size_t visited = 0;
+    flat.query(Envelope(0, 1, 0, 1), [&visited](FlatSTRtree::ItemId) {
+        return ++visited < 10;
+    });
+    ensure_equals(visited, 10u);
+}
+
+// Invalid buffers are rejected
+template<>
+template<>
+void object::test<5>
+()
+{
+    TemplateSTRtree<std::size_t> tree(4);
+    for (std::size_t i = 0; i < 100; i++) {
+        tree.insert(randomEnvelope(5), i);
+    }
+    auto buf = serialize(tree);
+
+    ensureRejected(buf, FlatSTRtree::HEADER_SIZE - 1);
+    ensureRejected(buf, buf.size() - 1);
+
+    auto badMagic = buf;
+    badMagic[0] = 'X';
+    ensureRejected(badMagic, badMagic.size());
+
+    auto badOrder = buf;
+    std::reverse(badOrder.begin() + 8, badOrder.begin() + 12);
+    ensureRejected(badOrder, badOrder.size());
+
+    // a branch pointing back to the root
+    auto cycle = buf;
+    std::fill(cycle.begin() + FlatSTRtree::HEADER_SIZE + 32, cycle.begin() + FlatSTRtree::HEADER_SIZE + 40, 0);
+    FlatSTRtree flat(cycle.data(), cycle.size());
+    try {
+        std::vector<FlatSTRtree::ItemId> hits;
+        flat.query(Envelope(0, 200, 0, 200), hits);
+        fail("IllegalArgumentException expected");
+    }
+    catch (const geos::util::IllegalArgumentException&) {
+    }
+}
+
+} // namespace tut
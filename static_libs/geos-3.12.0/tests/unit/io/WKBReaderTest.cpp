@@ -12,9 +12,12 @@
 #include <geos/io/WKBConstants.h>
 #include <geos/io/WKBWriter.h>
 #include <geos/io/WKTReader.h>
+#include <geos/io/ParseException.h>
 #include <geos/geom/PrecisionModel.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Geometry.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/LineString.h>
 #include <geos/util/GEOSException.h>
 // std
 #include <sstream>
@@ -741,5 +744,65 @@ void object::test<30>
     );
 }
 
+// Long sequences of every dimension read the same in both byte orders,
+// with X and Y rounded to the precision model
+template<>
+template<>
+void object::test<31>
+()
+{
+    using geos::geom::CoordinateSequence;
+
+    auto floating = geos::geom::GeometryFactory::create();
+    geos::io::WKBReader floatingReader(*floating);
+
+    for(int dim = 0; dim < 4; dim++) {
+        bool hasZ = dim & 1;
+        bool hasM = dim & 2;
+        auto seq = geos::detail::make_unique<CoordinateSequence>(1000u, hasZ, hasM);
+        for(std::size_t i = 0; i < seq->size(); i++) {
+            seq->setAt(CoordinateXYZM(i * 0.37, i * -1.61, i * 2.5, i * 0.25), i);
+        }
+        auto line = floating->createLineString(std::move(seq));
+
+        for(int byteOrder : { geos::io::WKBConstants::wkbNDR, geos::io::WKBConstants::wkbXDR }) {
+            geos::io::WKBWriter writer(4, byteOrder);
+            std::stringstream wkb;
+            writer.write(*line, wkb);
+            std::string buf = wkb.str();
+            auto data = reinterpret_cast<const unsigned char*>(buf.data());
+
+            auto g = floatingReader.read(data, buf.size());
+            ensure(g->equalsIdentical(line.get()));
+
+            // fixed precision, scale 1
+            auto rounded = wkbreader.read(data, buf.size());
+            const CoordinateSequence* coords = static_cast<geos::geom::LineString*>(rounded.get())->getCoordinatesRO();
+            ensure_equals(coords->hasZ(), hasZ);
+            ensure_equals(coords->hasM(), hasM);
+            for(std::size_t i = 0; i < coords->size(); i++) {
+                CoordinateXYZM c;
+                coords->getAt(i, c);
+                ensure_equals(c.x, pm.makePrecise(i * 0.37));
+                ensure_equals(c.y, pm.makePrecise(i * -1.61));
+                if(hasZ) {
+                    ensure_equals(c.z, i * 2.5);
+                }
+                if(hasM) {
+                    ensure_equals(c.m, i * 0.25);
+                }
+            }
+
+            // truncated ordinates
+            try {
+                floatingReader.read(data, buf.size() - 1);
+                fail("ParseException expected");
+            }
+            catch(const geos::io::ParseException&) {
+            }
+        }
+    }
+}
+
 } // namespace tut
 
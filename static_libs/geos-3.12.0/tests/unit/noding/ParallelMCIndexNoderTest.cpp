@@ -0,0 +1,236 @@
+//
+// Test Suite for geos::noding::ParallelMCIndexNoder class.
+
+#include <tut/tut.hpp>
+#include <utility.h>
+
+// geos
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/LineString.h>
+#include <geos/noding/IntersectionAdder.h>
+#include <geos/noding/MCIndexNoder.h>
+#include <geos/noding/NodedSegmentString.h>
+#include <geos/noding/ParallelMCIndexNoder.h>
+#include <geos/noding/SegmentIntersector.h>
+#include <geos/operation/overlayng/OverlayNG.h>
+#include <geos/operation/overlayng/OverlayNGRobust.h>
+
+// std
+#include <cmath>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+using namespace geos::geom;
+using namespace geos::noding;
+using geos::algorithm::LineIntersector;
+using geos::operation::overlayng::OverlayNG;
+using geos::operation::overlayng::OverlayNGRobust;
+
+namespace tut {
+//
+// Test Group
+//
+
+// Common data used by all tests
+struct test_parallelmcindexnoder_data {
+
+    typedef std::tuple<const SegmentString*, std::size_t, const SegmentString*, std::size_t> Call;
+
+    // Records the sequence of segment pairs it is handed
+    class CallRecorder : public SegmentIntersector {
+    public:
+        std::vector<Call> calls;
+
+        void processIntersections(SegmentString* e0, std::size_t segIndex0,
+                                  SegmentString* e1, std::size_t segIndex1) override
+        {
+            calls.emplace_back(e0, segIndex0, e1, segIndex1);
+        }
+    };
+
+    GeometryFactory::Ptr factory = GeometryFactory::create();
+    unsigned int seed = 12345;
+
+    double
+    random()
+    {
+        seed = seed * 1103515245 + 12345;
+        return static_cast<double>((seed >> 8) & 0xFFFF) / 65536.0;
+    }
+
+    // Random walks crossing each other and themselves
+    std::vector<std::unique_ptr<CoordinateSequence>>
+    randomLines(std::size_t numLines, std::size_t numPts)
+    {
+        std::vector<std::unique_ptr<CoordinateSequence>> lines;
+        for (std::size_t i = 0; i < numLines; i++) {
+            std::unique_ptr<CoordinateSequence> cs(new CoordinateSequence());
+            double x = random() * 1000;
+            double y = random() * 1000;
+            for (std::size_t j = 0; j < numPts; j++) {
+                cs->add(CoordinateXY(x, y));
+                x += random() * 20 - 10;
+                y += random() * 20 - 10;
+            }
+            lines.push_back(std::move(cs));
+        }
+        return lines;
+    }
+
+    std::vector<SegmentString*>
+    toSegmentStrings(const std::vector<std::unique_ptr<CoordinateSequence>>& lines)
+    {
+        std::vector<SegmentString*> segStrings;
+        for (const auto& cs : lines) {
+            segStrings.push_back(new NodedSegmentString(cs->clone().release(), false, false, nullptr));
+        }
+        return segStrings;
+    }
+
+    static void
+    freeSegmentStrings(std::vector<SegmentString*>& segStrings)
+    {
+        for (SegmentString* ss : segStrings) {
+            delete ss;
+        }
+    }
+
+    // Noded substrings must match vertex by vertex, bit for bit
+    static void
+    checkIdentical(std::vector<SegmentString*>* expected, std::vector<SegmentString*>* actual)
+    {
+        ensure_equals("number of noded substrings", actual->size(), expected->size());
+        for (std::size_t i = 0; i < expected->size(); i++) {
+            const CoordinateSequence* e = (*expected)[i]->getCoordinates();
+            const CoordinateSequence* a = (*actual)[i]->getCoordinates();
+            ensure_equals("substring size", a->size(), e->size());
+            for (std::size_t j = 0; j < e->size(); j++) {
+                ensure(a->getAt<CoordinateXY>(j).equals2D(e->getAt<CoordinateXY>(j)));
+            }
+        }
+    }
+
+    // Wavy ring, so that two of them cross many times
+    std::unique_ptr<Geometry>
+    wavyPolygon(double cx, double cy, std::size_t numPts)
+    {
+        CoordinateSequence cs;
+        for (std::size_t i = 0; i < numPts; i++) {
+            double angle = 2 * geos::MATH_PI * static_cast<double>(i) / static_cast<double>(numPts);
+            double r = 100 + 2 * std::sin(angle * 1000);
+            cs.add(CoordinateXY(cx + r * std::cos(angle), cy + r * std::sin(angle)));
+        }
+        cs.closeRing();
+        return factory->createPolygon(std::move(cs));
+    }
+};
+
+typedef test_group<test_parallelmcindexnoder_data> group;
+typedef group::object object;
+
+group test_parallelmcindexnoder_group("geos::noding::ParallelMCIndexNoder");
+
+//
+// Test Cases
+//
+
+// Same noded substrings as MCIndexNoder with an IntersectionAdder
+template<>
+template<>
+void object::test<1> ()
+{
+    auto lines = randomLines(400, 100);
+
+    std::vector<SegmentString*> serialInput = toSegmentStrings(lines);
+    LineIntersector li0;
+    IntersectionAdder adder0(li0);
+    MCIndexNoder serial(&adder0);
+    serial.computeNodes(&serialInput);
+    std::unique_ptr<std::vector<SegmentString*>> expected(serial.getNodedSubstrings());
+
+    std::vector<SegmentString*> parallelInput = toSegmentStrings(lines);
+    LineIntersector li1;
+    IntersectionAdder adder1(li1);
+    ParallelMCIndexNoder parallel(&adder1, 0.0, 4);
+    parallel.computeNodes(&parallelInput);
+    std::unique_ptr<std::vector<SegmentString*>> actual(parallel.getNodedSubstrings());
+
+    ensure(expected->size() > serialInput.size());
+    ensure_equals(adder1.numIntersections, adder0.numIntersections);
+    ensure_equals(adder1.numProperIntersections, adder0.numProperIntersections);
+    checkIdentical(expected.get(), actual.get());
+
+    freeSegmentStrings(*expected);
+    freeSegmentStrings(*actual);
+    freeSegmentStrings(serialInput);
+    freeSegmentStrings(parallelInput);
+}
+
+// Any other SegmentIntersector sees exactly the serial sequence of calls
+template<>
+template<>
+void object::test<2> ()
+{
+    auto lines = randomLines(200, 100);
+    std::vector<SegmentString*> input = toSegmentStrings(lines);
+
+    CallRecorder serialCalls;
+    MCIndexNoder serial(&serialCalls);
+    serial.computeNodes(&input);
+
+    CallRecorder parallelCalls;
+    ParallelMCIndexNoder parallel(&parallelCalls, 0.0, 3);
+    parallel.computeNodes(&input);
+
+    ensure(serialCalls.calls.size() > 0);
+    ensure(serialCalls.calls == parallelCalls.calls);
+
+    freeSegmentStrings(input);
+}
+
+// Small inputs and a single thread run serially
+template<>
+template<>
+void object::test<3> ()
+{
+    auto lines = randomLines(3, 20);
+    std::vector<SegmentString*> input = toSegmentStrings(lines);
+
+    CallRecorder serialCalls;
+    MCIndexNoder serial(&serialCalls);
+    serial.computeNodes(&input);
+
+    CallRecorder parallelCalls;
+    ParallelMCIndexNoder parallel(&parallelCalls, 0.0, 1);
+    ensure_equals(parallel.getNumThreads(), 1u);
+    parallel.computeNodes(&input);
+
+    ensure(serialCalls.calls == parallelCalls.calls);
+
+    ParallelMCIndexNoder defaultThreads;
+    ensure(defaultThreads.getNumThreads() >= 1);
+
+    freeSegmentStrings(input);
+}
+
+// Overlay results are identical to the serial overlay
+template<>
+template<>
+void object::test<4> ()
+{
+    auto a = wavyPolygon(0, 0, 20000);
+    auto b = wavyPolygon(30, 20, 20000);
+
+    for (int opCode : { OverlayNG::INTERSECTION, OverlayNG::UNION,
+                        OverlayNG::DIFFERENCE, OverlayNG::SYMDIFFERENCE }) {
+        auto expected = OverlayNGRobust::Overlay(a.get(), b.get(), opCode);
+        auto actual = OverlayNGRobust::Overlay(a.get(), b.get(), opCode, 4);
+        ensure(expected->equalsIdentical(actual.get()));
+    }
+}
+
+} // namespace tut
@@ -0,0 +1,217 @@
+//
+// Test Suite for geos::operation::buffer::ParallelBufferOp class.
+
+// tut
+#include <tut/tut.hpp>
+#include <utility.h>
+// geos
+#include <geos/operation/buffer/BufferOp.h>
+#include <geos/operation/buffer/BufferParameters.h>
+#include <geos/operation/buffer/ParallelBufferOp.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/io/WKTReader.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using geos::geom::Geometry;
+using geos::operation::buffer::BufferOp;
+using geos::operation::buffer::BufferParameters;
+using geos::operation::buffer::ParallelBufferOp;
+
+namespace tut {
+//
+// Test Group
+//
+
+// Common data used by tests
+struct test_parallelbufferop_data {
+    geos::io::WKTReader wktreader;
+    std::default_random_engine e;
+
+    typedef geos::geom::Geometry::Ptr GeomPtr;
+
+    test_parallelbufferop_data() : e(1234) {}
+
+    // Parts scattered over a 100x100 square, many of them close enough
+    // for their buffers to merge
+    GeomPtr
+    scattered(const std::string& type, int n)
+    {
+        std::uniform_real_distribution<double> pos(0, 100);
+        std::uniform_real_distribution<double> size(0.5, 3);
+        std::ostringstream wkt;
+        wkt << "MULTI" << type << " (";
+        for(int i = 0; i < n; i++) {
+            double x = pos(e);
+            double y = pos(e);
+            double s = size(e);
+            wkt << (i ? ", " : "");
+            if(type == "POINT") {
+                wkt << "(" << x << " " << y << ")";
+            }
+            else if(type == "LINESTRING") {
+                wkt << "(" << x << " " << y << ", " << x + s << " " << y + s / 2 << ", " << x + s << " " << y - s << ")";
+            }
+            else {
+                wkt << "((" << x << " " << y << ", " << x + s << " " << y << ", " << x + s << " " << y + s
+                    << ", " << x << " " << y << "))";
+            }
+        }
+        wkt << ")";
+        return wktreader.read(wkt.str());
+    }
+
+    // Checks the result covers the same area as BufferOp, whatever
+    // the number of threads
+    void
+    checkBuffer(const Geometry* g, double distance, const BufferParameters& params)
+    {
+        BufferOp serialOp(g, params);
+        auto expected = serialOp.getResultGeometry(distance);
+
+        GeomPtr first;
+        for(std::size_t numThreads : { 1u, 3u, 8u }) {
+            ParallelBufferOp op(g, params);
+            op.setNumThreads(numThreads);
+            auto result = op.getResultGeometry(distance);
+
+            ensure(result->isValid());
+            ensure_equals(result->isEmpty(), expected->isEmpty());
+            double diff = result->symDifference(expected.get())->getArea();
+            ensure(diff <= 1e-9 * std::max(1.0, expected->getArea()));
+
+            if(first) {
+                ensure(result->equalsExact(first.get()));
+            }
+            else {
+                first = std::move(result);
+            }
+        }
+    }
+};
+
+typedef test_group<test_parallelbufferop_data> group;
+typedef group::object object;
+
+group test_parallelbufferop_group("geos::operation::buffer::ParallelBufferOp");
+
+//
+// Test Cases
+//
+
+// Polygons, lines and points, at distances which merge some of the parts
+template<>
+template<>
+void object::test<1>
+()
+{
+    BufferParameters params;
+    for(const char* type : { "POINT", "LINESTRING", "POLYGON" }) {
+        auto g = scattered(type, 200);
+        for(double distance : { 0.0, 0.5, 2.0, 5.0 }) {
+            checkBuffer(g.get(), distance, params);
+        }
+    }
+
+    auto polys = scattered("POLYGON", 200);
+    checkBuffer(polys.get(), -0.2, params);
+}
+
+// End caps, joins and single-sided buffers which reach further than
+// the buffer distance
+template<>
+template<>
+void object::test<2>
+()
+{
+    auto lines = scattered("LINESTRING", 100);
+    auto polys = scattered("POLYGON", 100);
+
+    BufferParameters square;
+    square.setEndCapStyle(BufferParameters::CAP_SQUARE);
+    checkBuffer(lines.get(), 1.5, square);
+
+    BufferParameters mitre;
+    mitre.setJoinStyle(BufferParameters::JOIN_MITRE);
+    mitre.setMitreLimit(10);
+    checkBuffer(lines.get(), 1.5, mitre);
+    checkBuffer(polys.get(), 1.5, mitre);
+
+    BufferParameters singleSided;
+    singleSided.setSingleSided(true);
+    checkBuffer(lines.get(), 1.5, singleSided);
+    checkBuffer(lines.get(), -1.5, singleSided);
+}
+
+// Parts whose buffers overlap are unioned, separate ones are not
+template<>
+template<>
+void object::test<3>
+()
+{
+    auto g = wktreader.read("MULTIPOINT ((0 0), (3 0), (100 0))");
+    auto result = ParallelBufferOp::bufferOp(g.get(), 2, BufferParameters(), 2);
+    ensure_equals(result->getGeometryTypeId(), geos::geom::GEOS_MULTIPOLYGON);
+    ensure_equals(result->getNumGeometries(), 2u);
+
+    auto single = ParallelBufferOp::bufferOp(g.get(), 60, BufferParameters(), 2);
+    ensure_equals(single->getGeometryTypeId(), geos::geom::GEOS_POLYGON);
+}
+
+// An array of geometries buffers as their collection
+template<>
+template<>
+void object::test<4>
+()
+{
+    auto a = wktreader.read("POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))");
+    auto b = wktreader.read("LINESTRING (20 0, 30 10)");
+    auto c = wktreader.read("MULTIPOINT ((12 5), (50 50))");
+    auto coll = wktreader.read("GEOMETRYCOLLECTION (POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0)), "
+                               "LINESTRING (20 0, 30 10), MULTIPOINT ((12 5), (50 50)))");
+
+    std::vector<const Geometry*> geoms { a.get(), b.get(), c.get() };
+    ParallelBufferOp op(geoms, *a->getFactory(), BufferParameters());
+    op.setNumThreads(0);
+    auto result = op.getResultGeometry(2);
+
+    auto expected = coll->buffer(2);
+    ensure(result->symDifference(expected.get())->getArea() < 1e-9);
+    ensure_equals(result->getNumGeometries(), 3u);
+}
+
+// Empty inputs and invalid distances
+template<>
+template<>
+void object::test<5>
+()
+{
+    auto empty = wktreader.read("MULTIPOLYGON EMPTY");
+    auto result = ParallelBufferOp::bufferOp(empty.get(), 1, BufferParameters(), 4);
+    ensure(result->isEmpty());
+    ensure_equals(result->getGeometryTypeId(), geos::geom::GEOS_POLYGON);
+
+    auto lines = wktreader.read("MULTILINESTRING ((0 0, 1 1), (10 10, 11 11))");
+    ensure(ParallelBufferOp::bufferOp(lines.get(), -1, BufferParameters(), 4)->isEmpty());
+
+    std::vector<const Geometry*> none;
+    ParallelBufferOp op(none, *lines->getFactory(), BufferParameters());
+    ensure(op.getResultGeometry(1)->isEmpty());
+
+    try {
+        ParallelBufferOp::bufferOp(lines.get(), std::numeric_limits<double>::infinity(), BufferParameters(), 4);
+        fail("IllegalArgumentException expected");
+    }
+    catch(const geos::util::IllegalArgumentException&) {
+    }
+}
+
+} // namespace tut
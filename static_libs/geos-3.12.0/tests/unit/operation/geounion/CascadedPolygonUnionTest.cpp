@@ -12,7 +12,9 @@
 #include <geos/geom/Point.h>
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKTWriter.h>
+#include <geos/util/GEOSException.h>
 // std
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -155,5 +157,70 @@ create_discs(geos::geom::GeometryFactory& gf, int num, double radius,
 //         std::for_each(g.begin(), g.end(), delete_geometry);
 //     }
 
+// The parallel union gives exactly the serial result
+template<>
+template<>
+void object::test<4>
+()
+{
+    using geos::operation::geounion::CascadedPolygonUnion;
+
+    // a factory which is not shared by other tests, and is released last
+    auto factory = geos::geom::GeometryFactory::create();
+    std::vector<geos::geom::Polygon*> g;
+    create_discs(*factory, 20, 0.7, &g);
+
+    CascadedPolygonUnion serialOp(&g);
+    auto expected = serialOp.Union();
+
+    for(std::size_t numThreads : { 0u, 2u, 3u, 4u, 8u, 64u }) {
+        CascadedPolygonUnion op(&g);
+        op.setNumThreads(numThreads);
+        auto result = op.Union();
+        ensure(result->equalsExact(expected.get()));
+    }
+
+    std::for_each(g.begin(), g.end(), delete_geometry);
+}
+
+// A failure on a worker thread reaches the caller
+template<>
+template<>
+void object::test<5>
+()
+{
+    using geos::operation::geounion::CascadedPolygonUnion;
+    using geos::operation::geounion::ClassicUnionStrategy;
+
+    struct FailingUnionStrategy : public ClassicUnionStrategy {
+        using ClassicUnionStrategy::Union;
+
+        std::unique_ptr<geos::geom::Geometry>
+        Union(const geos::geom::Geometry* g0, const geos::geom::Geometry* g1) override
+        {
+            if(g0->getEnvelopeInternal()->getMinX() < 0) {
+                throw geos::util::GEOSException("failing union");
+            }
+            return ClassicUnionStrategy::Union(g0, g1);
+        }
+    } strategy;
+
+    auto factory = geos::geom::GeometryFactory::create();
+    std::vector<geos::geom::Polygon*> g;
+    create_discs(*factory, 10, 0.7, &g);
+
+    CascadedPolygonUnion op(&g, &strategy);
+    op.setNumThreads(4);
+    try {
+        op.Union();
+        fail("GEOSException expected");
+    }
+    catch(const geos::util::GEOSException& e) {
+        ensure_equals(std::string(e.what()), std::string("failing union"));
+    }
+
+    std::for_each(g.begin(), g.end(), delete_geometry);
+}
+
 } // namespace tut
 
@@ -0,0 +1,279 @@
+//
+// Test Suite for geos::operation::relate::RelatePredicateOp
+
+#include <tut/tut.hpp>
+// geos
+#include <geos/geom/Geometry.h>
+#include <geos/geom/IntersectionMatrix.h>
+#include <geos/io/WKTReader.h>
+#include <geos/operation/relate/RelatePredicateOp.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using geos::geom::Geometry;
+using geos::operation::relate::RelatePredicateOp;
+
+namespace tut {
+//
+// Test Group
+//
+
+struct test_relatepredicateop_data {
+    geos::io::WKTReader reader;
+    std::default_random_engine e;
+    std::uniform_int_distribution<int> grid;
+
+    test_relatepredicateop_data() : e(4321), grid(0, 6) {}
+
+    std::string
+    point()
+    {
+        std::ostringstream s;
+        s << grid(e) << " " << grid(e);
+        return s.str();
+    }
+
+    // Lines are kept simple, as RelateOp can mislabel a self-crossing
+    // which falls on the boundary of a polygon
+    std::string
+    line(int xmin, int xmax, bool transpose = false)
+    {
+        std::vector<int> xs;
+        for(int x = xmin; x <= xmax; x++) {
+            if(xs.size() < 2 || grid(e) % 2) {
+                xs.push_back(x);
+            }
+        }
+        std::ostringstream s;
+        s << "(";
+        for(std::size_t i = 0; i < xs.size(); i++) {
+            int y = grid(e);
+            s << (i ? ", " : "") << (transpose ? y : xs[i]) << " " << (transpose ? xs[i] : y);
+        }
+        s << ")";
+        return s.str();
+    }
+
+    std::string
+    box(int x0, int y0, int x1, int y1)
+    {
+        std::ostringstream s;
+        s << "((" << x0 << " " << y0 << ", " << x1 << " " << y0 << ", " << x1 << " " << y1
+          << ", " << x0 << " " << y1 << ", " << x0 << " " << y0 << ")";
+        return s.str();
+    }
+
+    std::string
+    randomBox()
+    {
+        int x0 = grid(e) % 5;
+        int y0 = grid(e) % 5;
+        return box(x0, y0, x0 + 1 + grid(e) % 3, y0 + 1 + grid(e) % 3) + ")";
+    }
+
+    std::unique_ptr<Geometry>
+    randomGeometry()
+    {
+        std::string wkt;
+        switch(grid(e) % 8) {
+        case 0:
+            wkt = "POINT (" + point() + ")";
+            break;
+        case 1:
+            wkt = "MULTIPOINT ((" + point() + "), (" + point() + "), (" + point() + "))";
+            break;
+        case 2:
+            wkt = "LINESTRING " + line(grid(e) % 3, 3 + grid(e) % 4, grid(e) % 2);
+            break;
+        case 3:
+            wkt = "MULTILINESTRING (" + line(grid(e) % 3, 3) + ", " + line(3, 4 + grid(e) % 3) + ")";
+            break;
+        case 4:
+            wkt = "POLYGON " + randomBox();
+            break;
+        case 5: {
+            std::unique_ptr<Geometry> g;
+            do {
+                std::string p0 = point();
+                wkt = "POLYGON ((" + p0 + ", " + point() + ", " + point() + ", " + p0 + "))";
+                g = reader.read(wkt);
+            }
+            while(g->getArea() == 0);
+            return g;
+        }
+        case 6:
+            wkt = "POLYGON " + box(0, 0, 6, 6) + ", (2 2, 2 4, 4 4, 4 2, 2 2))";
+            break;
+        default: {
+            int x = grid(e) % 3;
+            wkt = "MULTIPOLYGON (" + box(x, 0, x + 1, 2 + x) + "), " + box(x + 2, 1, 6, 3) + "))";
+            break;
+        }
+        }
+        return reader.read(wkt);
+    }
+
+    void
+    checkPredicates(const Geometry* a, const Geometry* b)
+    {
+        std::string msg = a->toString() + " / " + b->toString();
+        ensure_equals(msg + " intersects", RelatePredicateOp::intersects(a, b), a->intersects(b));
+        ensure_equals(msg + " disjoint", RelatePredicateOp::disjoint(a, b), a->disjoint(b));
+        ensure_equals(msg + " touches", RelatePredicateOp::touches(a, b), a->touches(b));
+        ensure_equals(msg + " crosses", RelatePredicateOp::crosses(a, b), a->crosses(b));
+        ensure_equals(msg + " within", RelatePredicateOp::within(a, b), a->within(b));
+        ensure_equals(msg + " contains", RelatePredicateOp::contains(a, b), a->contains(b));
+        ensure_equals(msg + " overlaps", RelatePredicateOp::overlaps(a, b), a->overlaps(b));
+        ensure_equals(msg + " covers", RelatePredicateOp::covers(a, b), a->covers(b));
+        ensure_equals(msg + " coveredBy", RelatePredicateOp::coveredBy(a, b), a->coveredBy(b));
+        ensure_equals(msg + " equals", RelatePredicateOp::equals(a, b), a->equals(b));
+        ensure_equals(msg + " containsProperly", RelatePredicateOp::containsProperly(a, b),
+                      a->relate(b, "T**FF*FF*"));
+    }
+
+    // Checks every cell of the matrix on its own
+    void
+    checkMatrix(const Geometry* a, const Geometry* b)
+    {
+        auto im = a->relate(b);
+        for(std::size_t i = 0; i < 9; i++) {
+            for(char c : { 'F', '0', '1', '2' }) {
+                std::string pattern(9, '*');
+                pattern[i] = c;
+                ensure_equals(a->toString() + " / " + b->toString() + " " + pattern,
+                              RelatePredicateOp::relate(a, b, pattern), im->matches(pattern));
+            }
+        }
+    }
+};
+
+typedef test_group<test_relatepredicateop_data> group;
+typedef group::object object;
+
+group test_relatepredicateop_group("geos::operation::relate::RelatePredicateOp");
+
+//
+// Test Cases
+//
+
+// Named predicates on simple cases
+template<>
+template<>
+void object::test<1>
+()
+{
+    auto a = reader.read("POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))");
+    auto b = reader.read("POLYGON ((10 0, 20 0, 20 10, 10 10, 10 0))");
+    auto c = reader.read("POLYGON ((2 2, 8 2, 8 8, 2 8, 2 2))");
+    auto l = reader.read("LINESTRING (5 5, 15 5)");
+
+    ensure(RelatePredicateOp::touches(a.get(), b.get()));
+    ensure(!RelatePredicateOp::overlaps(a.get(), b.get()));
+    ensure(RelatePredicateOp::contains(a.get(), c.get()));
+    ensure(RelatePredicateOp::containsProperly(a.get(), c.get()));
+    ensure(RelatePredicateOp::within(c.get(), a.get()));
+    ensure(RelatePredicateOp::disjoint(b.get(), c.get()));
+    ensure(RelatePredicateOp::crosses(l.get(), a.get()));
+    ensure(RelatePredicateOp::crosses(l.get(), b.get()));
+    ensure(RelatePredicateOp::intersects(l.get(), c.get()));
+    ensure(RelatePredicateOp::relate(a.get(), b.get(), "FF2F11212"));
+    ensure(!RelatePredicateOp::relate(a.get(), b.get(), "FF2F01212"));
+}
+
+// Shells and holes given in either orientation
+template<>
+template<>
+void object::test<2>
+()
+{
+    auto ccw = reader.read("POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0), (2 2, 2 8, 8 8, 8 2, 2 2))");
+    auto cw = reader.read("POLYGON ((0 0, 0 10, 10 10, 10 0, 0 0), (2 2, 8 2, 8 8, 2 8, 2 2))");
+    auto hole = reader.read("POLYGON ((2 2, 8 2, 8 5, 2 5, 2 2))");
+    auto shell = reader.read("POLYGON ((0 0, 5 0, 5 2, 0 2, 0 0))");
+
+    for(const Geometry* g : { ccw.get(), cw.get() }) {
+        checkPredicates(g, hole.get());
+        checkPredicates(hole.get(), g);
+        checkPredicates(g, shell.get());
+        checkPredicates(shell.get(), g);
+        checkMatrix(g, hole.get());
+        checkMatrix(g, shell.get());
+    }
+}
+
+// Lines sharing endpoints, under the Mod-2 rule
+template<>
+template<>
+void object::test<3>
+()
+{
+    auto a = reader.read("MULTILINESTRING ((0 0, 5 0), (5 0, 10 0))");
+    auto b = reader.read("LINESTRING (5 -5, 5 0)");
+    auto c = reader.read("LINESTRING (0 0, 10 0)");
+
+    ensure(RelatePredicateOp::touches(a.get(), b.get()));
+    ensure_equals(RelatePredicateOp::touches(a.get(), b.get()), a->touches(b.get()));
+    ensure(RelatePredicateOp::equals(a.get(), c.get()));
+    checkMatrix(a.get(), b.get());
+    checkMatrix(a.get(), c.get());
+}
+
+// Random geometries on a small grid agree with RelateOp
+template<>
+template<>
+void object::test<4>
+()
+{
+    for(int iter = 0; iter < 1500; iter++) {
+        auto a = randomGeometry();
+        auto b = randomGeometry();
+        checkPredicates(a.get(), b.get());
+        checkMatrix(a.get(), b.get());
+    }
+}
+
+// Inputs which are left to RelateOp
+template<>
+template<>
+void object::test<5>
+()
+{
+    std::vector<std::unique_ptr<Geometry>> geoms;
+    geoms.push_back(reader.read("POLYGON EMPTY"));
+    geoms.push_back(reader.read("MULTIPOINT ((1 1), EMPTY)"));
+    geoms.push_back(reader.read("LINESTRING (1 1, 1 1)"));
+    geoms.push_back(reader.read("POLYGON ((0 0, 2 0, 2 2, 0 2, 0 0))"));
+
+    for(const auto& a : geoms) {
+        for(const auto& b : geoms) {
+            checkPredicates(a.get(), b.get());
+        }
+    }
+    ensure(RelatePredicateOp::equals(geoms[0].get(), geoms[0].get()));
+
+    auto gc = reader.read("GEOMETRYCOLLECTION (POINT (1 1), LINESTRING (0 0, 2 2))");
+    ensure(RelatePredicateOp::intersects(gc.get(), geoms[3].get()));
+    ensure(!RelatePredicateOp::disjoint(geoms[3].get(), gc.get()));
+}
+
+// Patterns must be nine characters long
+template<>
+template<>
+void object::test<6>
+()
+{
+    auto a = reader.read("POINT (0 0)");
+    try {
+        RelatePredicateOp::relate(a.get(), a.get(), "T*F**F**");
+        fail("IllegalArgumentException expected");
+    }
+    catch(const geos::util::IllegalArgumentException&) {
+    }
+}
+
+} // namespace tut
@@ -0,0 +1,114 @@
+//
+// Test Suite for geos::util::Arena class.
+
+// tut
+#include <tut/tut.hpp>
+// geos
+#include <geos/util/Arena.h>
+// std
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+using geos::util::Arena;
+using geos::util::ArenaAllocator;
+
+namespace tut {
+//
+// Test Group
+//
+
+struct test_arena_data {
+    static bool
+    isAligned(const void* p, std::size_t alignment)
+    {
+        return (reinterpret_cast<std::uintptr_t>(p) & (alignment - 1)) == 0;
+    }
+};
+
+typedef test_group<test_arena_data> group;
+typedef group::object object;
+
+group test_arena_group("geos::util::Arena");
+
+//
+// Test Cases
+//
+
+// Allocations are aligned and do not overlap
+template<>
+template<>
+void object::test<1> ()
+{
+    Arena arena;
+    char* a = static_cast<char*>(arena.allocate(3, 1));
+    double* b = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+    char* c = static_cast<char*>(arena.allocate(5, 1));
+
+    ensure(isAligned(b, alignof(double)));
+    ensure(reinterpret_cast<char*>(b) >= a + 3);
+    ensure(c >= reinterpret_cast<char*>(b + 1));
+    ensure_equals(arena.getNumBlocks(), 1u);
+    ensure_equals(arena.getBytesAllocated(), 3u + sizeof(double) + 5u);
+}
+
+// Blocks are added on demand, oversized requests included
+template<>
+template<>
+void object::test<2> ()
+{
+    Arena arena(256);
+    for (int i = 0; i < 100; i++) {
+        arena.allocate(64, 8);
+    }
+    std::size_t numBlocks = arena.getNumBlocks();
+    ensure(numBlocks > 1);
+
+    void* big = arena.allocate(10 * Arena::MAX_BLOCK_SIZE, 16);
+    ensure(big != nullptr);
+    ensure(isAligned(big, 16));
+    ensure_equals(arena.getNumBlocks(), numBlocks + 1);
+
+    // the current block keeps serving small requests
+    arena.allocate(8, 8);
+    ensure_equals(arena.getNumBlocks(), numBlocks + 1);
+
+    arena.release();
+    ensure_equals(arena.getNumBlocks(), 0u);
+    ensure_equals(arena.getBytesAllocated(), 0u);
+
+    arena.allocate(8, 8);
+    ensure_equals(arena.getNumBlocks(), 1u);
+}
+
+// Standard containers work on top of an ArenaAllocator
+template<>
+template<>
+void object::test<3> ()
+{
+    Arena arena;
+
+    typedef ArenaAllocator<std::pair<const int, int>> MapAllocator;
+    std::map<int, int, std::less<int>, MapAllocator> map{MapAllocator(arena)};
+    std::deque<int, ArenaAllocator<int>> que{ArenaAllocator<int>(arena)};
+    std::vector<int, ArenaAllocator<int>> vec{ArenaAllocator<int>(arena)};
+
+    for (int i = 0; i < 1000; i++) {
+        map[i] = 2 * i;
+        que.push_back(i);
+        vec.push_back(i);
+    }
+
+    ensure_equals(map.size(), 1000u);
+    ensure_equals(map[500], 1000);
+    ensure_equals(que[999], 999);
+    ensure_equals(vec[123], 123);
+    ensure(arena.getBytesAllocated() >= 1000 * 3 * sizeof(int));
+    ensure(ArenaAllocator<int>(arena) == MapAllocator(arena));
+
+    Arena other;
+    ensure(ArenaAllocator<int>(arena) != ArenaAllocator<int>(other));
+}
+
+} // namespace tut
@@ -22,6 +22,9 @@
 /* Should be defined in order to enable GEOS_3110 support. */
 #define GEOS_3110 1
 
+/* Should be defined in order to enable GEOS_3120 support. */
+#define GEOS_3120 1
+
 /* Should be defined in order to enable GEOS_370 support. */
 #define GEOS_370 1
 
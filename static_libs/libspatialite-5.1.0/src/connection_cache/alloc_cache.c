@@ -55,6 +55,7 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include <windows.h>
 #else
 #include <pthread.h>
+#include <unistd.h>
 #endif
 
 #if defined(_WIN32) && !defined(__MINGW32__)
@@ -1324,6 +1325,114 @@ splite_cache_semaphore_unlock (void)
 #endif
 }
 
+SPATIALITE_PRIVATE int
+splite_get_cpu_count (void)
+{
+/* returns the number of currently available CPU cores */
+    int count;
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo (&info);
+    count = info.dwNumberOfProcessors;
+#else
+    count = sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+    if (count < 1)
+	count = 1;
+    return count;
+}
+
+struct splite_thread_args
+{
+/* helper struct for starting a worker thread */
+    void (*worker) (void *arg);
+    void *arg;
+};
+
+#if defined(_WIN32)
+static DWORD WINAPI
+splite_thread_start (LPVOID arg)
+#else
+static void *
+splite_thread_start (void *arg)
+#endif
+{
+/* a worker thread just started */
+    struct splite_thread_args *p = (struct splite_thread_args *) arg;
+    p->worker (p->arg);
+#if defined(_WIN32)
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+SPATIALITE_PRIVATE void
+splite_run_threads (int count, void (*worker) (void *arg), void **args)
+{
+/*
+/ running worker(args[i]) on COUNT concurrent threads and
+/ waiting for all of them to complete
+/ the first worker always runs on the calling thread; any
+/ thread failing to start is executed on the calling thread
+*/
+    int i;
+    struct splite_thread_args *params;
+#if defined(_WIN32)
+    HANDLE *threads;
+#else
+    pthread_t *threads;
+#endif
+    char *started;
+
+    if (count <= 0)
+	return;
+    if (count == 1)
+      {
+	  worker (args[0]);
+	  return;
+      }
+    params = malloc (sizeof (struct splite_thread_args) * count);
+#if defined(_WIN32)
+    threads = malloc (sizeof (HANDLE) * count);
+#else
+    threads = malloc (sizeof (pthread_t) * count);
+#endif
+    started = malloc (count);
+    for (i = 1; i < count; i++)
+      {
+	  params[i].worker = worker;
+	  params[i].arg = args[i];
+#if defined(_WIN32)
+	  threads[i] =
+	      CreateThread (NULL, 0, splite_thread_start, params + i, 0, NULL);
+	  started[i] = (threads[i] != NULL) ? 1 : 0;
+#else
+	  started[i] =
+	      (pthread_create
+	       (threads + i, NULL, splite_thread_start, params + i) == 0) ? 1 : 0;
+#endif
+      }
+    worker (args[0]);
+    for (i = 1; i < count; i++)
+      {
+	  if (!started[i])
+	    {
+		worker (args[i]);
+		continue;
+	    }
+#if defined(_WIN32)
+	  WaitForSingleObject (threads[i], INFINITE);
+	  CloseHandle (threads[i]);
+#else
+	  pthread_join (threads[i], NULL);
+#endif
+      }
+    free (started);
+    free (threads);
+    free (params);
+}
+
 SPATIALITE_DECLARE void
 spatialite_initialize (void)
 {
@@ -96,6 +96,11 @@ CIG: 6038019AE5
 #define GAIA_CUTTER_LINESTRING	2
 #define GAIA_CUTTER_POLYGON		3
 
+#define GAIA_CUTTER_STR_NODE		16
+#define GAIA_CUTTER_STR_MAX_LEVELS	32
+#define GAIA_CUTTER_BATCH_ROWS	256
+#define GAIA_CUTTER_MAX_THREADS	64
+
 struct output_column
 {
 /* a struct wrapping an Output Table Column */
@@ -175,6 +180,79 @@ struct cut_solution
     struct cut_item *last;
 };
 
+struct cutter_str_item
+{
+/* an entry of the STR packed Blade index - parallel mode */
+    double minx;
+    double miny;
+    double maxx;
+    double maxy;
+    int first;
+    int count;
+};
+
+struct cutter_blade
+{
+/* a Blade loaded in memory - parallel mode */
+    struct temporary_row row;
+    unsigned char *blob;
+    int blob_sz;
+    gaiaGeomCollPtr geom;
+};
+
+struct cutter_blades
+{
+/* all Blades loaded in memory (shared read-only) - parallel mode */
+    struct cutter_blade *blades;
+    int count;
+    struct cutter_str_item *levels[GAIA_CUTTER_STR_MAX_LEVELS];
+    int level_items[GAIA_CUTTER_STR_MAX_LEVELS];
+    int n_levels;
+    struct temporary_row null_blade;
+};
+
+struct cutter_piece
+{
+/* a cut fragment of some Input Polygon - parallel mode */
+    int blade;
+    int n_geom;
+    int pending;
+    int seq;
+    unsigned char *blob;
+    int blob_sz;
+    gaiaGeomCollPtr geom;
+};
+
+struct cutter_input
+{
+/* an Input Polygon to be cut - parallel mode */
+    struct temporary_row row;
+    unsigned char *blob;
+    int blob_sz;
+    struct cutter_piece *pieces;
+    int n_pieces;
+    int max_pieces;
+    int error;
+};
+
+struct cutter_worker
+{
+/* a worker thread cutting Input Polygons - parallel mode */
+    struct cutter_blades *blades;
+    struct cutter_input *inputs;
+    int n_inputs;
+    int first;
+    int step;
+    void *cache;
+    int gpkg_mode;
+    int gpkg_amphibious;
+    int tiny_point;
+    double snap_tolerance;
+    int *candidates;
+    int n_candidates;
+    int max_candidates;
+};
+
 static struct multivar *
 alloc_multivar (void)
 {
@@ -7484,14 +7562,1091 @@ do_cut_polygons (struct output_table *tbl, sqlite3 * handle,
     return 1;
 }
 
-SPATIALITE_DECLARE int
-gaiaCutter (sqlite3 * handle, const void *cache, const char *xin_db_prefix,
-	    const char *input_table, const char *xinput_geom,
-	    const char *xblade_db_prefix, const char *blade_table,
-	    const char *xblade_geom, const char *out_table, int transaction,
-	    int ram_tmp_store, char **message)
+static int
+has_input_pk (struct output_table *tbl)
 {
-/* main Cutter tool implementation */
+/* testing if the Input table declares a Primary Key */
+    struct output_column *col = tbl->first;
+    while (col != NULL)
+      {
+	  if (col->role == GAIA_CUTTER_INPUT_PK)
+	      return 1;
+	  col = col->next;
+      }
+    return 0;
+}
+
+static int
+do_fetch_pk_values (struct output_table *tbl, sqlite3_stmt * stmt,
+		    char table, struct temporary_row *row)
+{
+/* 
+/ fetching all Input or Blade PK values from the current resultset row
+/ (expected to be placed in the leading columns)
+/ returns the index of the first column following the PK values
+*/
+    int icol = 0;
+    int role = (table == 'B') ? GAIA_CUTTER_BLADE_PK : GAIA_CUTTER_INPUT_PK;
+    struct output_column *col = tbl->first;
+    while (col != NULL)
+      {
+	  if (col->role == role)
+	    {
+		switch (sqlite3_column_type (stmt, icol))
+		  {
+		  case SQLITE_INTEGER:
+		      add_int_pk_value (row, table, icol,
+					sqlite3_column_int64 (stmt, icol));
+		      break;
+		  case SQLITE_FLOAT:
+		      add_double_pk_value (row, table, icol,
+					   sqlite3_column_double (stmt, icol));
+		      break;
+		  case SQLITE_TEXT:
+		      add_text_pk_value (row, table, icol,
+					 (const char *)
+					 sqlite3_column_text (stmt, icol));
+		      break;
+		  default:
+		      add_null_pk_value (row, table, icol);
+		  };
+		icol++;
+	    }
+	  col = col->next;
+      }
+    return icol;
+}
+
+static char *
+do_compose_parallel_select (struct output_table *tbl, char table,
+			    const char *db_prefix, const char *table_name,
+			    const char *geom)
+{
+/* composing the SQL statement loading Input or Blade rows - parallel mode */
+    char *xprefix;
+    char *xtable;
+    char *xcolumn;
+    char *sql;
+    char *prev;
+    struct output_column *col;
+    int comma = 0;
+    int role = (table == 'B') ? GAIA_CUTTER_BLADE_PK : GAIA_CUTTER_INPUT_PK;
+
+    sql = sqlite3_mprintf ("SELECT");
+    prev = sql;
+    col = tbl->first;
+    while (col != NULL)
+      {
+	  /* Primary Key Column(s) */
+	  if (col->role == role)
+	    {
+		xcolumn = gaiaDoubleQuotedSql (col->base_name);
+		sql = sqlite3_mprintf ("%s \"%s\",", prev, xcolumn);
+		free (xcolumn);
+		sqlite3_free (prev);
+		prev = sql;
+	    }
+	  col = col->next;
+      }
+    xcolumn = gaiaDoubleQuotedSql (geom);
+    xprefix = gaiaDoubleQuotedSql (db_prefix);
+    xtable = gaiaDoubleQuotedSql (table_name);
+    sql =
+	sqlite3_mprintf ("%s \"%s\" FROM \"%s\".\"%s\" ORDER BY", prev, xcolumn,
+			 xprefix, xtable);
+    free (xcolumn);
+    free (xprefix);
+    free (xtable);
+    sqlite3_free (prev);
+    prev = sql;
+    if (table == 'B')
+      {
+	  /* Blades are sorted by ROWID, just as the Spatial Index does */
+	  sql = sqlite3_mprintf ("%s ROWID", prev);
+	  sqlite3_free (prev);
+	  return sql;
+      }
+    col = tbl->first;
+    while (col != NULL)
+      {
+	  /* Input Primary Key Column(s) */
+	  if (col->role == role)
+	    {
+		xcolumn = gaiaDoubleQuotedSql (col->base_name);
+		if (comma)
+		    sql = sqlite3_mprintf ("%s, \"%s\"", prev, xcolumn);
+		else
+		    sql = sqlite3_mprintf ("%s \"%s\"", prev, xcolumn);
+		free (xcolumn);
+		comma = 1;
+		sqlite3_free (prev);
+		prev = sql;
+	    }
+	  col = col->next;
+      }
+    return sql;
+}
+
+static int
+cmp_str_center_x (const void *p1, const void *p2)
+{
+/* comparing two STR items by the X coordinate of their center */
+    const struct cutter_str_item *item1 = (const struct cutter_str_item *) p1;
+    const struct cutter_str_item *item2 = (const struct cutter_str_item *) p2;
+    double x1 = item1->minx + item1->maxx;
+    double x2 = item2->minx + item2->maxx;
+    if (x1 < x2)
+	return -1;
+    if (x1 > x2)
+	return 1;
+    return 0;
+}
+
+static int
+cmp_str_center_y (const void *p1, const void *p2)
+{
+/* comparing two STR items by the Y coordinate of their center */
+    const struct cutter_str_item *item1 = (const struct cutter_str_item *) p1;
+    const struct cutter_str_item *item2 = (const struct cutter_str_item *) p2;
+    double y1 = item1->miny + item1->maxy;
+    double y2 = item2->miny + item2->maxy;
+    if (y1 < y2)
+	return -1;
+    if (y1 > y2)
+	return 1;
+    return 0;
+}
+
+static struct cutter_str_item *
+do_str_pack (struct cutter_str_item *items, int count, int *n_nodes)
+{
+/* 
+/ Sort-Tile-Recursive packing of a level of the Blade index:
+/ the items will be reordered, and their parent level will be returned
+*/
+    struct cutter_str_item *nodes;
+    struct cutter_str_item *node;
+    int leaves = (count + GAIA_CUTTER_STR_NODE - 1) / GAIA_CUTTER_STR_NODE;
+    int slices = 1;
+    int slice_sz;
+    int i;
+    int j;
+    int k;
+    int n = 0;
+
+    while (slices * slices < leaves)
+	slices++;
+    slice_sz = slices * GAIA_CUTTER_STR_NODE;
+    nodes = malloc (sizeof (struct cutter_str_item) * leaves);
+    qsort (items, count, sizeof (struct cutter_str_item), cmp_str_center_x);
+    for (i = 0; i < count; i += slice_sz)
+      {
+	  /* each vertical slice is then sorted by Y */
+	  int sz = count - i;
+	  if (sz > slice_sz)
+	      sz = slice_sz;
+	  qsort (items + i, sz, sizeof (struct cutter_str_item),
+		 cmp_str_center_y);
+	  for (j = 0; j < sz; j += GAIA_CUTTER_STR_NODE)
+	    {
+		struct cutter_str_item *item = items + i + j;
+		node = nodes + n++;
+		node->first = i + j;
+		node->count = sz - j;
+		if (node->count > GAIA_CUTTER_STR_NODE)
+		    node->count = GAIA_CUTTER_STR_NODE;
+		node->minx = item->minx;
+		node->miny = item->miny;
+		node->maxx = item->maxx;
+		node->maxy = item->maxy;
+		for (k = 1; k < node->count; k++)
+		  {
+		      item = items + i + j + k;
+		      if (item->minx < node->minx)
+			  node->minx = item->minx;
+		      if (item->miny < node->miny)
+			  node->miny = item->miny;
+		      if (item->maxx > node->maxx)
+			  node->maxx = item->maxx;
+		      if (item->maxy > node->maxy)
+			  node->maxy = item->maxy;
+		  }
+	    }
+      }
+    *n_nodes = n;
+    return nodes;
+}
+
+static void
+do_build_blade_index (struct cutter_blades *blades)
+{
+/* building the STR packed index supporting all Blades */
+    struct cutter_str_item *items;
+    int count = blades->count;
+    int n_nodes;
+    int i;
+
+    blades->n_levels = 0;
+    if (count <= 0)
+	return;
+    items = malloc (sizeof (struct cutter_str_item) * count);
+    for (i = 0; i < count; i++)
+      {
+	  gaiaGeomCollPtr geom = (blades->blades + i)->geom;
+	  struct cutter_str_item *item = items + i;
+	  item->minx = geom->MinX;
+	  item->miny = geom->MinY;
+	  item->maxx = geom->MaxX;
+	  item->maxy = geom->MaxY;
+	  item->first = i;
+	  item->count = 0;
+      }
+    blades->levels[0] = items;
+    blades->level_items[0] = count;
+    blades->n_levels = 1;
+    while (count > GAIA_CUTTER_STR_NODE
+	   && blades->n_levels < GAIA_CUTTER_STR_MAX_LEVELS)
+      {
+	  items = do_str_pack (items, count, &n_nodes);
+	  count = n_nodes;
+	  blades->levels[blades->n_levels] = items;
+	  blades->level_items[blades->n_levels] = count;
+	  blades->n_levels += 1;
+      }
+}
+
+static void
+do_str_search (struct cutter_worker *worker, int level, int first, int count,
+	       gaiaGeomCollPtr geom)
+{
+/* recursively searching the Blade index for all candidate Blades */
+    struct cutter_str_item *items = worker->blades->levels[level];
+    int i;
+    for (i = first; i < first + count; i++)
+      {
+	  struct cutter_str_item *item = items + i;
+	  if (item->minx > geom->MaxX || item->maxx < geom->MinX
+	      || item->miny > geom->MaxY || item->maxy < geom->MinY)
+	      continue;
+	  if (level > 0)
+	    {
+		do_str_search (worker, level - 1, item->first, item->count,
+			       geom);
+		continue;
+	    }
+	  if (worker->n_candidates >= worker->max_candidates)
+	    {
+		worker->max_candidates += 1024;
+		worker->candidates =
+		    realloc (worker->candidates,
+			     sizeof (int) * worker->max_candidates);
+	    }
+	  worker->candidates[worker->n_candidates++] = item->first;
+      }
+}
+
+static int
+cmp_candidates (const void *p1, const void *p2)
+{
+/* comparing two candidate Blades by their relative position */
+    int idx1 = *((const int *) p1);
+    int idx2 = *((const int *) p2);
+    if (idx1 < idx2)
+	return -1;
+    if (idx1 > idx2)
+	return 1;
+    return 0;
+}
+
+static void
+do_free_blades (struct cutter_blades *blades)
+{
+/* memory cleanup - destroying all Blades loaded in memory */
+    int i;
+    for (i = 0; i < blades->count; i++)
+      {
+	  struct cutter_blade *blade = blades->blades + i;
+	  reset_temporary_row (&(blade->row));
+	  if (blade->blob != NULL)
+	      free (blade->blob);
+	  if (blade->geom != NULL)
+	      gaiaFreeGeomColl (blade->geom);
+      }
+    if (blades->blades != NULL)
+	free (blades->blades);
+    for (i = 0; i < blades->n_levels; i++)
+	free (blades->levels[i]);
+    reset_temporary_row (&(blades->null_blade));
+}
+
+static int
+do_load_blades (struct output_table *tbl, sqlite3 * handle,
+		const char *blade_db_prefix, const char *blade_table,
+		const char *blade_geom, int gpkg_mode, int gpkg_amphibious,
+		struct cutter_blades *blades, char **message)
+{
+/* loading all Blades in memory - parallel mode */
+    int ret;
+    sqlite3_stmt *stmt = NULL;
+    char *sql;
+    struct output_column *col;
+    int max_blades = 0;
+    int icol2 = 0;
+
+    col = tbl->first;
+    while (col != NULL)
+      {
+	  /* preparing the conventional NULL Blade */
+	  if (col->role == GAIA_CUTTER_BLADE_PK)
+	      add_null_pk_value (&(blades->null_blade), 'B', icol2++);
+	  col = col->next;
+      }
+
+    sql =
+	do_compose_parallel_select (tbl, 'B', blade_db_prefix, blade_table,
+				    blade_geom);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  do_update_sql_error (message, "SELECT FROM BLADE",
+			       sqlite3_errmsg (handle));
+	  goto error;
+      }
+
+    while (1)
+      {
+	  /* scrolling the result set rows */
+	  struct cutter_blade *blade;
+	  const unsigned char *blob;
+	  int icol;
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;		/* end of result set */
+	  if (ret != SQLITE_ROW)
+	    {
+		do_update_sql_error (message, "step: SELECT FROM BLADE",
+				     sqlite3_errmsg (handle));
+		goto error;
+	    }
+	  if (blades->count >= max_blades)
+	    {
+		max_blades += 1024;
+		blades->blades =
+		    realloc (blades->blades,
+			     sizeof (struct cutter_blade) * max_blades);
+	    }
+	  blade = blades->blades + blades->count;
+	  blade->row.first_input = NULL;
+	  blade->row.last_input = NULL;
+	  blade->row.first_blade = NULL;
+	  blade->row.last_blade = NULL;
+	  blade->blob = NULL;
+	  blade->blob_sz = 0;
+	  blade->geom = NULL;
+	  blades->count += 1;
+	  icol = do_fetch_pk_values (tbl, stmt, 'B', &(blade->row));
+	  if (sqlite3_column_type (stmt, icol) == SQLITE_BLOB)
+	    {
+		blob = sqlite3_column_blob (stmt, icol);
+		blade->blob_sz = sqlite3_column_bytes (stmt, icol);
+		blade->blob = malloc (blade->blob_sz);
+		memcpy (blade->blob, blob, blade->blob_sz);
+		blade->geom =
+		    gaiaFromSpatiaLiteBlobWkbEx (blade->blob, blade->blob_sz,
+						 gpkg_mode, gpkg_amphibious);
+	    }
+	  if (blade->geom == NULL)
+	    {
+		do_update_message (message,
+				   "found unexpected NULL Blade Geometry");
+		goto error;
+	    }
+      }
+
+    sqlite3_finalize (stmt);
+    return 1;
+
+  error:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    return 0;
+}
+
+static void
+do_add_cutter_piece (struct cutter_input *input, int blade, int n_geom,
+		     int pending, unsigned char *blob, int blob_sz)
+{
+/* appending a cut fragment to an Input Polygon */
+    struct cutter_piece *piece;
+    if (input->n_pieces >= input->max_pieces)
+      {
+	  input->max_pieces += 16;
+	  input->pieces =
+	      realloc (input->pieces,
+		       sizeof (struct cutter_piece) * input->max_pieces);
+      }
+    piece = input->pieces + input->n_pieces;
+    piece->blade = blade;
+    piece->n_geom = n_geom;
+    piece->pending = pending;
+    piece->seq = input->n_pieces;
+    piece->blob = blob;
+    piece->blob_sz = blob_sz;
+    piece->geom = NULL;
+    input->n_pieces += 1;
+}
+
+static gaiaGeomCollPtr
+do_blob_round_trip (struct cutter_worker *worker, gaiaGeomCollPtr geom)
+{
+/* 
+/ encoding a Geometry as a BLOB and then decoding it again, exactly
+/ as it happens when passing values to SQL functions in serial mode
+/ the original Geometry will always be destroyed
+*/
+    unsigned char *blob;
+    int blob_sz;
+    gaiaGeomCollPtr result;
+    if (geom == NULL)
+	return NULL;
+    gaiaToSpatiaLiteBlobWkbEx2 (geom, &blob, &blob_sz, worker->gpkg_mode,
+				worker->tiny_point);
+    gaiaFreeGeomColl (geom);
+    if (blob == NULL)
+	return NULL;
+    result =
+	gaiaFromSpatiaLiteBlobWkbEx (blob, blob_sz, worker->gpkg_mode,
+				     worker->gpkg_amphibious);
+    free (blob);
+    return result;
+}
+
+static void
+do_add_cutter_polygons (struct cutter_worker *worker,
+			struct cutter_input *input, int blade,
+			gaiaGeomCollPtr geom, int ngeom)
+{
+/* adding all Polygons from a Geometry - same as do_insert_temporary_polygons */
+    gaiaPolygonPtr pg;
+    int n_geom = (ngeom < 0) ? 0 : ngeom;
+
+    pg = geom->FirstPolygon;
+    while (pg != NULL)
+      {
+	  unsigned char *blob;
+	  int blob_sz;
+	  gaiaGeomCollPtr g;
+	  if (ngeom < 0)
+	      n_geom++;
+	  g = do_prepare_polygon (pg, geom->Srid);
+	  gaiaToSpatiaLiteBlobWkbEx2 (g, &blob, &blob_sz, worker->gpkg_mode,
+				      worker->tiny_point);
+	  gaiaFreeGeomColl (g);
+	  if (blob != NULL)
+	      do_add_cutter_piece (input, blade, n_geom, 0, blob, blob_sz);
+	  pg = pg->Next;
+      }
+}
+
+static gaiaGeomCollPtr
+do_get_nth_polygon (gaiaGeomCollPtr geom, int n_geom)
+{
+/* extracting the Nth Polygon - same as ST_GeometryN() */
+    gaiaGeomCollPtr result;
+    gaiaPolygonPtr pg;
+    gaiaPolygonPtr new_pg;
+    gaiaRingPtr rng;
+    gaiaRingPtr new_rng;
+    int cnt = 0;
+    int ib;
+
+    pg = geom->FirstPolygon;
+    while (pg != NULL)
+      {
+	  cnt++;
+	  if (cnt == n_geom)
+	      break;
+	  pg = pg->Next;
+      }
+    if (pg == NULL)
+	return NULL;
+
+    if (pg->DimensionModel == GAIA_XY_Z)
+	result = gaiaAllocGeomCollXYZ ();
+    else if (pg->DimensionModel == GAIA_XY_M)
+	result = gaiaAllocGeomCollXYM ();
+    else if (pg->DimensionModel == GAIA_XY_Z_M)
+	result = gaiaAllocGeomCollXYZM ();
+    else
+	result = gaiaAllocGeomColl ();
+    result->Srid = geom->Srid;
+    rng = pg->Exterior;
+    new_pg = gaiaAddPolygonToGeomColl (result, rng->Points, pg->NumInteriors);
+    gaiaCopyRingCoords (new_pg->Exterior, rng);
+    for (ib = 0; ib < pg->NumInteriors; ib++)
+      {
+	  rng = pg->Interiors + ib;
+	  new_rng = gaiaAddInteriorRing (new_pg, ib, rng->Points);
+	  gaiaCopyRingCoords (new_rng, rng);
+      }
+    return result;
+}
+
+static gaiaGeomCollPtr
+do_get_cutter_union (struct cutter_worker *worker, struct cutter_input *input)
+{
+/* 
+/ union of all already assigned portions of an Input Polygon
+/ same as ST_UnaryUnion(ST_Collect(...)) in serial mode
+*/
+    gaiaGeomCollPtr merged = NULL;
+    gaiaGeomCollPtr result;
+    gaiaGeomCollPtr g;
+    int i;
+
+    for (i = 0; i < input->n_pieces; i++)
+      {
+	  struct cutter_piece *piece = input->pieces + i;
+	  if (piece->blob == NULL)
+	      continue;
+	  g = gaiaFromSpatiaLiteBlobWkbEx (piece->blob, piece->blob_sz,
+					   worker->gpkg_mode,
+					   worker->gpkg_amphibious);
+	  if (g == NULL)
+	      continue;
+	  if (merged == NULL)
+	      merged = g;
+	  else
+	    {
+		merged = gaiaMergeGeometries_r (worker->cache, merged, g);
+		gaiaFreeGeomColl (g);
+	    }
+      }
+    if (merged == NULL)
+	return NULL;
+    if (gaiaIsEmpty (merged))
+      {
+	  gaiaFreeGeomColl (merged);
+	  return NULL;
+      }
+    merged = do_blob_round_trip (worker, merged);
+    if (merged == NULL)
+	return NULL;
+    result = gaiaUnaryUnion_r (worker->cache, merged);
+    if (result != NULL)
+	result->Srid = merged->Srid;
+    gaiaFreeGeomColl (merged);
+    return do_blob_round_trip (worker, result);
+}
+
+static gaiaGeomCollPtr
+do_get_cutter_difference (struct cutter_worker *worker, gaiaPolygonPtr pg,
+			  int srid, gaiaGeomCollPtr union_g)
+{
+/* 
+/ computing the uncovered portion of an Input Polygon
+/ same as ST_Difference(ST_Snap(?, ?, 0.000000001), ?) in serial mode
+*/
+    gaiaGeomCollPtr input_g;
+    gaiaGeomCollPtr snap_g;
+    gaiaGeomCollPtr result;
+
+    input_g = do_blob_round_trip (worker, do_prepare_polygon (pg, srid));
+    if (input_g == NULL)
+	return NULL;
+    snap_g =
+	gaiaSnap_r (worker->cache, input_g, union_g, worker->snap_tolerance);
+    if (snap_g != NULL)
+	snap_g->Srid = input_g->Srid;
+    gaiaFreeGeomColl (input_g);
+    snap_g = do_blob_round_trip (worker, snap_g);
+    if (snap_g == NULL)
+	return NULL;
+    result = gaiaGeometryDifference_r (worker->cache, snap_g, union_g);
+    gaiaFreeGeomColl (snap_g);
+    if (result == NULL)
+	return NULL;
+    if (gaiaIsEmpty (result))
+      {
+	  gaiaFreeGeomColl (result);
+	  return NULL;
+      }
+    return do_blob_round_trip (worker, result);
+}
+
+static int
+cmp_cutter_pieces (const void *p1, const void *p2)
+{
+/* 
+/ sorting the cut fragments of an Input Polygon
+/ same as ORDER BY n_geom, MbrMinY(geom) DESC, MbrMinX(geom)
+*/
+    const struct cutter_piece *piece1 = (const struct cutter_piece *) p1;
+    const struct cutter_piece *piece2 = (const struct cutter_piece *) p2;
+    if (piece1->geom == NULL || piece2->geom == NULL)
+      {
+	  if (piece1->geom != NULL)
+	      return -1;
+	  if (piece2->geom != NULL)
+	      return 1;
+	  return piece1->seq - piece2->seq;
+      }
+    if (piece1->n_geom != piece2->n_geom)
+	return (piece1->n_geom < piece2->n_geom) ? -1 : 1;
+    if (piece1->geom->MinY != piece2->geom->MinY)
+	return (piece1->geom->MinY > piece2->geom->MinY) ? -1 : 1;
+    if (piece1->geom->MinX != piece2->geom->MinX)
+	return (piece1->geom->MinX < piece2->geom->MinX) ? -1 : 1;
+    return piece1->seq - piece2->seq;
+}
+
+static void
+do_cut_input_polygon (struct cutter_worker *worker, struct cutter_input *input)
+{
+/* cutting a single Input Polygon - parallel mode */
+    struct cutter_blades *blades = worker->blades;
+    const void *cache = worker->cache;
+    gaiaGeomCollPtr input_g;
+    gaiaGeomCollPtr union_g;
+    gaiaGeomCollPtr g;
+    gaiaPolygonPtr pg;
+    int n_geom;
+    int i;
+
+    input_g =
+	gaiaFromSpatiaLiteBlobWkbEx (input->blob, input->blob_sz,
+				     worker->gpkg_mode,
+				     worker->gpkg_amphibious);
+    if (input_g == NULL)
+      {
+	  input->error = 1;
+	  return;
+      }
+
+/* step #1 - checking all Input/Blade pairs (in ROWID order) */
+    worker->n_candidates = 0;
+    if (blades->n_levels > 0)
+	do_str_search (worker, blades->n_levels - 1, 0,
+		       blades->level_items[blades->n_levels - 1], input_g);
+    qsort (worker->candidates, worker->n_candidates, sizeof (int),
+	   cmp_candidates);
+    for (i = 0; i < worker->n_candidates; i++)
+      {
+	  int idx = worker->candidates[i];
+	  struct cutter_blade *blade = blades->blades + idx;
+	  if (is_covered_by
+	      (cache, input_g, input->blob, input->blob_sz, blade->geom,
+	       blade->blob, blade->blob_sz))
+	    {
+		/* Input is completely Covered By Blade */
+		do_add_cutter_polygons (worker, input, idx, input_g, -1);
+		continue;
+	    }
+	  if (is_covered_by
+	      (cache, blade->geom, blade->blob, blade->blob_sz, input_g,
+	       input->blob, input->blob_sz))
+	    {
+		/* Blade is completely Covered By Input */
+		g = gaiaGeometryIntersection_r (cache, input_g, blade->geom);
+		if (g != NULL)
+		  {
+		      do_add_cutter_polygons (worker, input, idx, g, -1);
+		      gaiaFreeGeomColl (g);
+		  }
+		continue;
+	    }
+	  n_geom = 0;
+	  pg = input_g->FirstPolygon;
+	  while (pg != NULL)
+	    {
+		unsigned char *pg_blob;
+		int pg_blob_sz;
+		gaiaGeomCollPtr pg_geom = do_prepare_polygon (pg, input_g->Srid);
+		gaiaToSpatiaLiteBlobWkbEx2 (pg_geom, &pg_blob, &pg_blob_sz,
+					    worker->gpkg_mode, 0);
+		n_geom++;
+		if (gaiaGeomCollPreparedIntersects
+		    (cache, pg_geom, pg_blob, pg_blob_sz, blade->geom,
+		     blade->blob, blade->blob_sz))
+		  {
+		      /* to be cut later */
+		      do_add_cutter_piece (input, idx, n_geom, 1, NULL, 0);
+		  }
+		free (pg_blob);
+		gaiaFreeGeomColl (pg_geom);
+		pg = pg->Next;
+	    }
+      }
+
+/* step #2 - cutting all pending Input/Blade intersections */
+    for (i = 0; i < input->n_pieces; i++)
+      {
+	  struct cutter_piece *piece = input->pieces + i;
+	  gaiaGeomCollPtr nth_g;
+	  if (!piece->pending)
+	      continue;
+	  piece->pending = 0;
+	  nth_g =
+	      do_blob_round_trip (worker,
+				  do_get_nth_polygon (input_g, piece->n_geom));
+	  if (nth_g == NULL)
+	      continue;
+	  g = gaiaGeometryIntersection_r (cache, nth_g,
+					  (blades->blades +
+					   piece->blade)->geom);
+	  gaiaFreeGeomColl (nth_g);
+	  if (g != NULL)
+	    {
+		gaiaToSpatiaLiteBlobWkbEx2 (g, &(piece->blob),
+					    &(piece->blob_sz),
+					    worker->gpkg_mode,
+					    worker->tiny_point);
+		gaiaFreeGeomColl (g);
+	    }
+      }
+
+/* step #3 - recovering all portions not covered by any Blade */
+    union_g = do_get_cutter_union (worker, input);
+    if (union_g == NULL)
+      {
+	  /* fully uncovered Input Geometry */
+	  do_add_cutter_polygons (worker, input, -1, input_g, -1);
+      }
+    else
+      {
+	  /* partialy uncovered Input Geometry */
+	  n_geom = 0;
+	  pg = input_g->FirstPolygon;
+	  while (pg != NULL)
+	    {
+		n_geom++;
+		g = do_get_cutter_difference (worker, pg, input_g->Srid,
+					      union_g);
+		if (g != NULL)
+		  {
+		      do_add_cutter_polygons (worker, input, -1, g, n_geom);
+		      gaiaFreeGeomColl (g);
+		  }
+		pg = pg->Next;
+	    }
+	  gaiaFreeGeomColl (union_g);
+      }
+    gaiaFreeGeomColl (input_g);
+
+/* step #4 - sorting all cut fragments in the final Output order */
+    for (i = 0; i < input->n_pieces; i++)
+      {
+	  struct cutter_piece *piece = input->pieces + i;
+	  if (piece->blob == NULL)
+	      continue;
+	  piece->geom =
+	      gaiaFromSpatiaLiteBlobWkbEx (piece->blob, piece->blob_sz,
+					   worker->gpkg_mode,
+					   worker->gpkg_amphibious);
+	  free (piece->blob);
+	  piece->blob = NULL;
+	  if (piece->geom != NULL)
+	      gaiaMbrGeometry (piece->geom);
+      }
+    qsort (input->pieces, input->n_pieces, sizeof (struct cutter_piece),
+	   cmp_cutter_pieces);
+}
+
+static void
+cutter_worker (void *arg)
+{
+/* cutting an interleaved subset of the current batch */
+    struct cutter_worker *worker = (struct cutter_worker *) arg;
+    int i;
+    for (i = worker->first; i < worker->n_inputs; i += worker->step)
+	do_cut_input_polygon (worker, worker->inputs + i);
+}
+
+static void
+do_reset_cutter_inputs (struct cutter_input *inputs, int count)
+{
+/* memory cleanup - resetting a batch of Input Polygons */
+    int i;
+    int j;
+    for (i = 0; i < count; i++)
+      {
+	  struct cutter_input *input = inputs + i;
+	  reset_temporary_row (&(input->row));
+	  if (input->blob != NULL)
+	      free (input->blob);
+	  for (j = 0; j < input->n_pieces; j++)
+	    {
+		struct cutter_piece *piece = input->pieces + j;
+		if (piece->blob != NULL)
+		    free (piece->blob);
+		if (piece->geom != NULL)
+		    gaiaFreeGeomColl (piece->geom);
+	    }
+	  if (input->pieces != NULL)
+	      free (input->pieces);
+      }
+}
+
+static int
+do_insert_output_cutter_input (struct output_table *tbl, sqlite3 * handle,
+			       const void *cache, sqlite3_stmt * stmt_out,
+			       struct cutter_blades *blades,
+			       struct cutter_input *input, char **message)
+{
+/* inserting all cut fragments of an Input Polygon into the Output table */
+    struct temporary_row row;
+    struct temporary_row *blade_row;
+    int prev_ngeom = -1;
+    int prog_res = 1;
+    int i;
+
+    if (input->error)
+      {
+	  do_update_message (message, "found unexpected NULL Input Geometry");
+	  return 0;
+      }
+    for (i = 0; i < input->n_pieces; i++)
+      {
+	  struct cutter_piece *piece = input->pieces + i;
+	  gaiaPolygonPtr pg;
+	  if (piece->geom == NULL)
+	      continue;
+	  if (piece->n_geom != prev_ngeom)
+	      prog_res = 1;
+	  prev_ngeom = piece->n_geom;
+	  if (piece->blade < 0)
+	      blade_row = &(blades->null_blade);
+	  else
+	      blade_row = &((blades->blades + piece->blade)->row);
+	  /* the row just borrows the Input and Blade PK values */
+	  row.first_input = input->row.first_input;
+	  row.last_input = input->row.last_input;
+	  row.first_blade = blade_row->first_blade;
+	  row.last_blade = blade_row->last_blade;
+	  pg = piece->geom->FirstPolygon;
+	  while (pg != NULL)
+	    {
+		if (!do_insert_output_row
+		    (tbl, cache, stmt_out, handle, &row, piece->n_geom,
+		     prog_res++, GAIA_CUTTER_POLYGON, pg, piece->geom->Srid,
+		     message))
+		    return 0;
+		pg = pg->Next;
+	    }
+      }
+    return 1;
+}
+
+static int
+do_cut_polygons_parallel (struct output_table *tbl, sqlite3 * handle,
+			  const void *cache, const char *input_db_prefix,
+			  const char *input_table, const char *input_geom,
+			  const char *blade_db_prefix, const char *blade_table,
+			  const char *blade_geom,
+			  const char *spatial_index_prefix,
+			  const char *spatial_index, const char *out_table,
+			  int threads, char **message)
+{
+/* 
+/ cutting Input POLYGONs - parallel mode
+/
+/ all Blades are loaded in memory and indexed by a packed STR tree;
+/ batches of Input Polygons (in PK order) are then cut by several
+/ worker threads, each one owning a private GEOS context, and all
+/ cut fragments are finally written by the calling thread preserving
+/ the same identical order of the serial mode
+*/
+    struct cutter_blades blades;
+    struct cutter_worker *workers = NULL;
+    struct cutter_input *inputs = NULL;
+    void *args[GAIA_CUTTER_MAX_THREADS];
+    sqlite3_stmt *stmt_in = NULL;
+    sqlite3_stmt *stmt_out = NULL;
+    char *sql;
+    int ret;
+    int i;
+    int count;
+    int max_inputs;
+    int n_inputs = 0;
+    int done = 0;
+    int retcode = 0;
+    int gpkg_mode = 0;
+    int gpkg_amphibious = 0;
+    int tiny_point = 0;
+
+    if (cache != NULL)
+      {
+	  struct splite_internal_cache *pcache =
+	      (struct splite_internal_cache *) cache;
+	  gpkg_mode = pcache->gpkg_mode;
+	  gpkg_amphibious = pcache->gpkg_amphibious_mode;
+	  tiny_point = pcache->tinyPointEnabled;
+      }
+    if (threads > GAIA_CUTTER_MAX_THREADS)
+	threads = GAIA_CUTTER_MAX_THREADS;
+
+    blades.blades = NULL;
+    blades.count = 0;
+    blades.n_levels = 0;
+    blades.null_blade.first_input = NULL;
+    blades.null_blade.last_input = NULL;
+    blades.null_blade.first_blade = NULL;
+    blades.null_blade.last_blade = NULL;
+
+/* loading and indexing all Blades */
+    if (!do_load_blades
+	(tbl, handle, blade_db_prefix, blade_table, blade_geom, gpkg_mode,
+	 gpkg_amphibious, &blades, message))
+	goto end;
+    do_build_blade_index (&blades);
+
+/* preparing the worker threads */
+    workers = malloc (sizeof (struct cutter_worker) * threads);
+    for (i = 0; i < threads; i++)
+      {
+	  struct cutter_worker *worker = workers + i;
+	  worker->blades = &blades;
+	  worker->inputs = NULL;
+	  worker->n_inputs = 0;
+	  worker->first = i;
+	  worker->step = threads;
+	  worker->cache = spatialite_alloc_connection ();
+	  worker->gpkg_mode = gpkg_mode;
+	  worker->gpkg_amphibious = gpkg_amphibious;
+	  worker->tiny_point = tiny_point;
+	  worker->snap_tolerance = 0.000000001;
+	  worker->candidates = NULL;
+	  worker->n_candidates = 0;
+	  worker->max_candidates = 0;
+      }
+    max_inputs = GAIA_CUTTER_BATCH_ROWS * threads;
+    inputs = malloc (sizeof (struct cutter_input) * max_inputs);
+
+/* creating the Prepared Statements */
+    sql =
+	do_compose_parallel_select (tbl, 'I', input_db_prefix, input_table,
+				    input_geom);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_in, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  do_update_sql_error (message, "SELECT FROM INPUT",
+			       sqlite3_errmsg (handle));
+	  goto end;
+      }
+    if (!do_create_output_statement (tbl, handle, out_table, &stmt_out, message))
+	goto end;
+
+    while (!done)
+      {
+	  /* loading a batch of Input Polygons */
+	  while (n_inputs < max_inputs)
+	    {
+		struct cutter_input *input;
+		int icol;
+		ret = sqlite3_step (stmt_in);
+		if (ret == SQLITE_DONE)
+		  {
+		      done = 1;
+		      break;
+		  }
+		if (ret != SQLITE_ROW)
+		  {
+		      do_update_sql_error (message, "step: SELECT FROM INPUT",
+					   sqlite3_errmsg (handle));
+		      goto end;
+		  }
+		input = inputs + n_inputs++;
+		input->row.first_input = NULL;
+		input->row.last_input = NULL;
+		input->row.first_blade = NULL;
+		input->row.last_blade = NULL;
+		input->blob = NULL;
+		input->blob_sz = 0;
+		input->pieces = NULL;
+		input->n_pieces = 0;
+		input->max_pieces = 0;
+		input->error = 0;
+		icol = do_fetch_pk_values (tbl, stmt_in, 'I', &(input->row));
+		if (sqlite3_column_type (stmt_in, icol) != SQLITE_BLOB)
+		  {
+		      do_update_message (message,
+					 "found unexpected NULL Input Geometry");
+		      goto end;
+		  }
+		input->blob_sz = sqlite3_column_bytes (stmt_in, icol);
+		input->blob = malloc (input->blob_sz);
+		memcpy (input->blob, sqlite3_column_blob (stmt_in, icol),
+			input->blob_sz);
+	    }
+	  if (n_inputs == 0)
+	      break;
+
+	  /* cutting the current batch in parallel */
+	  count = threads;
+	  if (count > n_inputs)
+	      count = n_inputs;
+	  for (i = 0; i < count; i++)
+	    {
+		struct cutter_worker *worker = workers + i;
+		worker->inputs = inputs;
+		worker->n_inputs = n_inputs;
+		worker->step = count;
+		args[i] = worker;
+	    }
+	  splite_run_threads (count, cutter_worker, args);
+
+	  /* writing all cut fragments in the Input order */
+	  for (i = 0; i < n_inputs; i++)
+	    {
+		if (!do_insert_output_cutter_input
+		    (tbl, handle, cache, stmt_out, &blades, inputs + i,
+		     message))
+		    goto end;
+	    }
+	  do_reset_cutter_inputs (inputs, n_inputs);
+	  n_inputs = 0;
+      }
+
+    do_finish_output (tbl, handle, out_table, input_geom, blade_db_prefix,
+		      blade_table, blade_geom, spatial_index_prefix,
+		      spatial_index);
+    retcode = 1;
+
+  end:
+    if (stmt_in != NULL)
+	sqlite3_finalize (stmt_in);
+    if (stmt_out != NULL)
+	sqlite3_finalize (stmt_out);
+    if (inputs != NULL)
+      {
+	  do_reset_cutter_inputs (inputs, n_inputs);
+	  free (inputs);
+      }
+    if (workers != NULL)
+      {
+	  for (i = 0; i < threads; i++)
+	    {
+		struct cutter_worker *worker = workers + i;
+		spatialite_internal_cleanup (worker->cache);
+		if (worker->candidates != NULL)
+		    free (worker->candidates);
+	    }
+	  free (workers);
+      }
+    do_free_blades (&blades);
+    return retcode;
+}
+
+static int
+do_cutter (sqlite3 * handle, const void *cache, const char *xin_db_prefix,
+	   const char *input_table, const char *xinput_geom,
+	   const char *xblade_db_prefix, const char *blade_table,
+	   const char *xblade_geom, const char *out_table, int transaction,
+	   int ram_tmp_store, int threads, char **message)
+{
+/* main Cutter tool implementation - threads=0 means serial mode */
     const char *in_db_prefix = "MAIN";
     const char *blade_db_prefix = "MAIN";
     char *input_geom = NULL;
@@ -7717,11 +8872,20 @@ gaiaCutter (sqlite3 * handle, const void *cache, const char *xin_db_prefix,
     if (pg_type)
       {
 	  /* processing Input of (multi)POLYGON type */
-	  if (!do_cut_polygons
-	      (tbl, handle, cache, in_db_prefix, input_table, input_geom,
-	       blade_db_prefix, blade_table, blade_geom, spatial_index_prefix,
-	       spatial_index, out_table, &tmp_table, &drop_tmp_table,
-	       input_type, message))
+	  if (threads > 0 && has_input_pk (tbl))
+	    {
+		if (!do_cut_polygons_parallel
+		    (tbl, handle, cache, in_db_prefix, input_table,
+		     input_geom, blade_db_prefix, blade_table, blade_geom,
+		     spatial_index_prefix, spatial_index, out_table, threads,
+		     message))
+		    goto end;
+	    }
+	  else if (!do_cut_polygons
+		   (tbl, handle, cache, in_db_prefix, input_table, input_geom,
+		    blade_db_prefix, blade_table, blade_geom,
+		    spatial_index_prefix, spatial_index, out_table, &tmp_table,
+		    &drop_tmp_table, input_type, message))
 	      goto end;
       }
 
@@ -7797,4 +8961,35 @@ gaiaCutter (sqlite3 * handle, const void *cache, const char *xin_db_prefix,
     return retcode;
 }
 
+SPATIALITE_DECLARE int
+gaiaCutter (sqlite3 * handle, const void *cache, const char *xin_db_prefix,
+	    const char *input_table, const char *xinput_geom,
+	    const char *xblade_db_prefix, const char *blade_table,
+	    const char *xblade_geom, const char *out_table, int transaction,
+	    int ram_tmp_store, char **message)
+{
+/* main Cutter tool implementation */
+    return do_cutter (handle, cache, xin_db_prefix, input_table, xinput_geom,
+		      xblade_db_prefix, blade_table, xblade_geom, out_table,
+		      transaction, ram_tmp_store, 0, message);
+}
+
+SPATIALITE_DECLARE int
+gaiaCutterParallel (sqlite3 * handle, const void *cache,
+		    const char *xin_db_prefix, const char *input_table,
+		    const char *xinput_geom, const char *xblade_db_prefix,
+		    const char *blade_table, const char *xblade_geom,
+		    const char *out_table, int transaction, int ram_tmp_store,
+		    int threads, char **message)
+{
+/* main Cutter tool implementation - parallel mode */
+    if (threads <= 0)
+	threads = splite_get_cpu_count ();
+    if (threads > GAIA_CUTTER_MAX_THREADS)
+	threads = GAIA_CUTTER_MAX_THREADS;
+    return do_cutter (handle, cache, xin_db_prefix, input_table, xinput_geom,
+		      xblade_db_prefix, blade_table, xblade_geom, out_table,
+		      transaction, ram_tmp_store, threads, message);
+}
+
 #endif /* end GEOS conditionals */
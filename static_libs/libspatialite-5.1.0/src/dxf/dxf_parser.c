@@ -69,6 +69,7 @@ Regione Toscana - Settore Sistema Informativo Territoriale ed Ambientale
 #include <spatialite/gaiageo.h>
 #include <spatialite/gg_dxf.h>
 #include <spatialite.h>
+#include <spatialite_private.h>
 
 #include "dxf_private.h"
 
@@ -714,6 +715,7 @@ insert_dxf_hatch (gaiaDxfParserPtr dxf, const char *layer_name,
 		if (lyr->last_hatch != NULL)
 		    lyr->last_hatch->next = hatch;
 		lyr->last_hatch = hatch;
+		dxf->batch_count++;
 		return;
 	    }
 	  lyr = lyr->next;
@@ -850,6 +852,7 @@ insert_dxf_text (gaiaDxfParserPtr dxf, const char *layer_name,
 		dxf->last_ext = NULL;
 		if (txt->first != NULL)
 		    lyr->hasExtraText = 1;
+		dxf->batch_count++;
 		return;
 	    }
 	  lyr = lyr->next;
@@ -1044,6 +1047,7 @@ insert_dxf_insert (gaiaDxfParserPtr dxf, const char *layer_name,
 			  lyr->hasExtraInsPolyg = 1;
 		  }
 		destroy_dxf_insert (ins);
+		dxf->batch_count++;
 		return;
 	    }
 	  lyr = lyr->next;
@@ -1122,6 +1126,7 @@ insert_dxf_point (gaiaDxfParserPtr dxf, const char *layer_name,
 		dxf->last_ext = NULL;
 		if (pt->first != NULL)
 		    lyr->hasExtraPoint = 1;
+		dxf->batch_count++;
 		return;
 	    }
 	  lyr = lyr->next;
@@ -1513,6 +1518,7 @@ insert_dxf_polyline (const void *p_cache, gaiaDxfParserPtr dxf,
 		    lyr->hasExtraPolyg = 1;
 		if (ln->is_closed == 0 && ln->first != NULL)
 		    lyr->hasExtraLine = 1;
+		dxf->batch_count++;
 		return;
 	    }
 	  lyr = lyr->next;
@@ -1866,6 +1872,17 @@ static void
 insert_dxf_layer (gaiaDxfParserPtr dxf, gaiaDxfLayerPtr lyr)
 {
 /* inserting a Layer object into the DXF struct */
+    gaiaDxfLayerPtr old = dxf->first_layer;
+    while (old != NULL)
+      {
+	  if (strcmp (old->layer_name, lyr->layer_name) == 0)
+	    {
+		/* already defined [e.g. by a preliminary scan] */
+		destroy_dxf_layer (lyr);
+		return;
+	    }
+	  old = old->next;
+      }
     if (dxf->first_layer == NULL)
 	dxf->first_layer = lyr;
     if (dxf->last_layer != NULL)
@@ -2312,8 +2329,9 @@ reset_dxf_entity (const void *p_cache, gaiaDxfParserPtr dxf)
 	    {
 		if (is_valid_dxf_hatch (dxf->curr_hatch))
 		  {
-		      create_dxf_hatch_lines (p_cache, dxf->curr_hatch,
-					      dxf->srid);
+		      if (!dxf->scan_only)
+			  create_dxf_hatch_lines (p_cache, dxf->curr_hatch,
+						  dxf->srid);
 		      if (dxf->is_block)
 			  insert_dxf_block_hatch (dxf, dxf->curr_hatch);
 		      else
@@ -3389,6 +3407,8 @@ gaiaCreateDxfParser (int srid,
     if (special_rings == GAIA_DXF_RING_UNLINKED)
 	dxf->unlinked_rings = 1;
     dxf->undeclared_layers = 1;
+    dxf->batch_count = 0;
+    dxf->scan_only = 0;
     return dxf;
 }
 
@@ -3495,31 +3515,18 @@ save_dxf_filename (gaiaDxfParserPtr dxf, const char *path)
 }
 
 static int
-gaiaParseDxfFileCommon (const void *p_cache, gaiaDxfParserPtr dxf,
-			const char *path)
+parse_dxf_stream (const void *p_cache, gaiaDxfParserPtr dxf, FILE * fl,
+		  int batch_size)
 {
-/* parsing the whole DXF file */
+/* 
+/ scanning the DXF file
+/ returns 0 on failure, 1 when a full batch of entities is ready
+/ (streaming mode) and 2 when the whole file has been parsed
+*/
     int c;
     char line[4192];
     char *p = line;
-    FILE *fl;
-
-    if (dxf == NULL)
-	return 0;
-    save_dxf_filename (dxf, path);
-    if (dxf->first_layer != NULL || dxf->first_block != NULL)
-	return 0;
 
-/* attempting to open the input file */
-#ifdef _WIN32
-    fl = gaia_win_fopen (path, "rb");
-#else
-    fl = fopen (path, "rb");
-#endif
-    if (fl == NULL)
-	return 0;
-
-/* scanning the DXF file */
     while ((c = getc (fl)) != EOF)
       {
 	  if (c == '\r')
@@ -3532,27 +3539,55 @@ gaiaParseDxfFileCommon (const void *p_cache, gaiaDxfParserPtr dxf,
 		/* end line found */
 		*p = '\0';
 		if (!parse_dxf_line (p_cache, dxf, line))
-		    goto stop;
+		    return 0;
 		if (dxf->eof)
 		  {
 		      /* EOF marker found - quitting */
-		      break;
+		      return 2;
 		  }
 		p = line;
+		if (batch_size > 0 && dxf->batch_count >= batch_size)
+		    return 1;
 		continue;
 	    }
 	  *p++ = (char) c;
 	  /* Even Rouault 2013-06-02 - avoiding a potential buffer overflow */
 	  if (p - line == sizeof (line) - 1)
-	      goto stop;
+	      return 0;
 	  /* END - Even Rouault 2013-06-02 */
       }
+    return 2;
+}
+
+static int
+gaiaParseDxfFileCommon (const void *p_cache, gaiaDxfParserPtr dxf,
+			const char *path)
+{
+/* parsing the whole DXF file */
+    int ret;
+    FILE *fl;
+
+    if (dxf == NULL)
+	return 0;
+    save_dxf_filename (dxf, path);
+    if (dxf->first_layer != NULL || dxf->first_block != NULL)
+	return 0;
+
+/* attempting to open the input file */
+#ifdef _WIN32
+    fl = gaia_win_fopen (path, "rb");
+#else
+    fl = fopen (path, "rb");
+#endif
+    if (fl == NULL)
+	return 0;
 
+/* scanning the DXF file */
+    ret = parse_dxf_stream (p_cache, dxf, fl, 0);
     fclose (fl);
+    if (ret == 0)
+	return 0;
     return 1;
-  stop:
-    fclose (fl);
-    return 0;
 }
 
 GAIAGEO_DECLARE int
@@ -3567,4 +3602,336 @@ gaiaParseDxfFile_r (const void *p_cache, gaiaDxfParserPtr dxf, const char *path)
     return gaiaParseDxfFileCommon (p_cache, dxf, path);
 }
 
+static gaiaDxfLayerPtr
+detach_dxf_layer (gaiaDxfLayerPtr lyr)
+{
+/* moving all entities of a Layer into a new Layer object */
+    int len;
+    gaiaDxfLayerPtr out = malloc (sizeof (gaiaDxfLayer));
+    *out = *lyr;
+    len = strlen (lyr->layer_name);
+    out->layer_name = malloc (len + 1);
+    strcpy (out->layer_name, lyr->layer_name);
+    out->next = NULL;
+    lyr->first_text = NULL;
+    lyr->last_text = NULL;
+    lyr->first_point = NULL;
+    lyr->last_point = NULL;
+    lyr->first_line = NULL;
+    lyr->last_line = NULL;
+    lyr->first_polyg = NULL;
+    lyr->last_polyg = NULL;
+    lyr->first_hatch = NULL;
+    lyr->last_hatch = NULL;
+    lyr->first_ins_text = NULL;
+    lyr->last_ins_text = NULL;
+    lyr->first_ins_point = NULL;
+    lyr->last_ins_point = NULL;
+    lyr->first_ins_line = NULL;
+    lyr->last_ins_line = NULL;
+    lyr->first_ins_polyg = NULL;
+    lyr->last_ins_polyg = NULL;
+    lyr->first_ins_hatch = NULL;
+    lyr->last_ins_hatch = NULL;
+    return out;
+}
+
+static gaiaDxfParserPtr
+detach_dxf_batch (gaiaDxfParserPtr dxf, int with_blocks)
+{
+/* 
+/ moving all entities parsed since the last batch into a
+/ new DXF parser object ready to be loaded into the DB
+*/
+    gaiaDxfLayerPtr lyr;
+    gaiaDxfParserPtr batch = malloc (sizeof (gaiaDxfParser));
+    memset (batch, 0, sizeof (gaiaDxfParser));
+    batch->filename = dxf->filename;
+    batch->srid = dxf->srid;
+    batch->force_dims = dxf->force_dims;
+    batch->prefix = dxf->prefix;
+    batch->selected_layer = dxf->selected_layer;
+    if (with_blocks)
+      {
+	  /* Blocks are loaded only once, together with the first batch */
+	  batch->first_block = dxf->first_block;
+	  batch->last_block = dxf->last_block;
+      }
+    lyr = dxf->first_layer;
+    while (lyr != NULL)
+      {
+	  gaiaDxfLayerPtr out = detach_dxf_layer (lyr);
+	  if (batch->first_layer == NULL)
+	      batch->first_layer = out;
+	  if (batch->last_layer != NULL)
+	      batch->last_layer->next = out;
+	  batch->last_layer = out;
+	  lyr = lyr->next;
+      }
+    dxf->batch_count = 0;
+    return batch;
+}
+
+static void
+destroy_dxf_batch (gaiaDxfParserPtr batch)
+{
+/* memory cleanup: destroying a batch of entities */
+    gaiaDxfLayerPtr lyr;
+    gaiaDxfLayerPtr n_lyr;
+    if (batch == NULL)
+	return;
+    lyr = batch->first_layer;
+    while (lyr != NULL)
+      {
+	  n_lyr = lyr->next;
+	  destroy_dxf_layer (lyr);
+	  lyr = n_lyr;
+      }
+    free (batch);
+}
+
+static FILE *
+open_dxf_stream (const char *path)
+{
+/* attempting to open the input file */
+#ifdef _WIN32
+    return gaia_win_fopen (path, "rb");
+#else
+    return fopen (path, "rb");
+#endif
+}
+
+static int
+scan_dxf_layers (const void *p_cache, gaiaDxfParserPtr dxf, const char *path,
+		 int batch_size, gaiaDxfBlockPtr * blocks)
+{
+/* 
+/ preliminary scan of the whole DXF file [streaming mode]
+/ all entities are immediately discarded, only the Layers
+/ (and their dimensions) and the Blocks will be retained
+*/
+    int ret;
+    int special_rings = GAIA_DXF_RING_NONE;
+    FILE *fl;
+    gaiaDxfParserPtr scan;
+    gaiaDxfLayerPtr lyr;
+    if (dxf->linked_rings)
+	special_rings = GAIA_DXF_RING_LINKED;
+    if (dxf->unlinked_rings)
+	special_rings = GAIA_DXF_RING_UNLINKED;
+    scan =
+	gaiaCreateDxfParser (dxf->srid, dxf->force_dims, dxf->prefix,
+			     dxf->selected_layer, special_rings);
+    scan->scan_only = 1;
+    fl = open_dxf_stream (path);
+    if (fl == NULL)
+      {
+	  gaiaDestroyDxfParser (scan);
+	  return 0;
+      }
+    while (1)
+      {
+	  ret = parse_dxf_stream (p_cache, scan, fl, batch_size);
+	  lyr = scan->first_layer;
+	  while (lyr != NULL)
+	    {
+		destroy_dxf_layer (detach_dxf_layer (lyr));
+		lyr = lyr->next;
+	    }
+	  scan->batch_count = 0;
+	  if (ret != 1)
+	      break;
+      }
+    fclose (fl);
+    if (ret == 2)
+      {
+	  /* handing over all Layers to the real parser */
+	  dxf->first_layer = scan->first_layer;
+	  dxf->last_layer = scan->last_layer;
+	  scan->first_layer = NULL;
+	  scan->last_layer = NULL;
+	  /* Blocks are only needed for their Insert references */
+	  *blocks = scan->first_block;
+	  scan->first_block = NULL;
+	  scan->last_block = NULL;
+      }
+    gaiaDestroyDxfParser (scan);
+    return (ret == 2) ? 1 : 0;
+}
+
+static void
+mark_dxf_blocks (gaiaDxfParserPtr dxf, gaiaDxfBlockPtr scanned)
+{
+/* 
+/ flagging the Blocks referenced by any Insert found in the
+/ whole file, then destroying the Blocks of the preliminary scan
+*/
+    gaiaDxfBlockPtr n_blk;
+    gaiaDxfBlockPtr blk = dxf->first_block;
+    while (scanned != NULL)
+      {
+	  /* both lists come from the same file, in the same order */
+	  n_blk = scanned->next;
+	  if (blk != NULL)
+	    {
+		if (strcmp (blk->block_id, scanned->block_id) == 0)
+		    blk->hasInsert = scanned->hasInsert;
+		blk = blk->next;
+	    }
+	  destroy_dxf_block (scanned);
+	  scanned = n_blk;
+      }
+}
+
+struct dxf_stream_job
+{
+/* helper struct: a step of a streaming DXF import */
+    int is_load;
+    const void *p_cache;
+    gaiaDxfParserPtr dxf;
+    FILE *fl;
+    int batch_size;
+    sqlite3 *handle;
+    int mode;
+    int append;
+    int ret;
+};
+
+static void
+dxf_stream_worker (void *arg)
+{
+/* parsing the next batch or loading the previous one */
+    struct dxf_stream_job *job = (struct dxf_stream_job *) arg;
+    if (job->is_load)
+	job->ret =
+	    gaiaLoadFromDxfParser (job->handle, job->dxf, job->mode,
+				   job->append);
+    else
+	job->ret =
+	    parse_dxf_stream (job->p_cache, job->dxf, job->fl,
+			      job->batch_size);
+}
+
+GAIAGEO_DECLARE int
+gaiaStreamDxfFile_r (const void *p_cache, sqlite3 * handle,
+		     gaiaDxfParserPtr dxf, const char *path, int mode,
+		     int append, int batch_size)
+{
+/* 
+/ parsing a DXF file and populating the DB in bounded batches
+/ each batch is loaded by the calling thread while the next one
+/ is being parsed by a worker thread owning a private connection
+/ cache, so that GEOS is never shared with the SQL functions
+*/
+    int ret = 0;
+    int eof = 0;
+    int with_blocks = 1;
+    int count;
+    int parsing;
+    int i;
+    void *parse_cache;
+    FILE *fl;
+    gaiaDxfParserPtr batch = NULL;
+    gaiaDxfBlockPtr scanned = NULL;
+    struct dxf_stream_job parse;
+    struct dxf_stream_job load;
+    void *args[2];
+
+    if (dxf == NULL || handle == NULL)
+	return 0;
+    if (batch_size <= 0)
+      {
+	  /* plain mode: parsing the whole file and then loading it */
+	  if (!gaiaParseDxfFileCommon (p_cache, dxf, path))
+	      return 0;
+	  return gaiaLoadFromDxfParser (handle, dxf, mode, append);
+      }
+    save_dxf_filename (dxf, path);
+    if (dxf->first_layer != NULL || dxf->first_block != NULL)
+	return 0;
+    parse_cache = spatialite_alloc_connection ();
+/* 
+/ preliminary scan: detecting the dimensions of each Layer and
+/ the Blocks to be loaded (any Insert may follow the first batch)
+*/
+    if (!scan_dxf_layers
+	(parse_cache != NULL ? parse_cache : p_cache, dxf, path,
+	 batch_size, &scanned))
+	goto stop;
+    fl = open_dxf_stream (path);
+    if (fl == NULL)
+	goto stop;
+
+    parse.is_load = 0;
+    parse.p_cache = (parse_cache != NULL) ? parse_cache : p_cache;
+    parse.dxf = dxf;
+    parse.fl = fl;
+    parse.batch_size = batch_size;
+    parse.ret = 0;
+    load.is_load = 1;
+    load.handle = handle;
+    load.mode = mode;
+    load.append = append;
+    load.dxf = NULL;
+    load.ret = 0;
+    while (1)
+      {
+	  /* the DB is always written by the calling thread */
+	  count = 0;
+	  parsing = 0;
+	  if (batch != NULL)
+	      args[count++] = &load;
+	  if (!eof && (batch == NULL || batch->first_block == NULL))
+	    {
+		/* Blocks are never loaded while the parser is running */
+		args[count++] = &parse;
+		parsing = 1;
+	    }
+	  if (count == 0)
+	      break;
+	  if (parse_cache != NULL)
+	      splite_run_threads (count, dxf_stream_worker, args);
+	  else
+	    {
+		/* no private cache: strictly sequential */
+		for (i = 0; i < count; i++)
+		    dxf_stream_worker (args[i]);
+	    }
+	  if (batch != NULL)
+	    {
+		destroy_dxf_batch (batch);
+		batch = NULL;
+		if (!load.ret)
+		    break;
+		/* any further batch will be appended */
+		load.append = 1;
+	    }
+	  if (parsing)
+	    {
+		if (parse.ret == 0)
+		    break;
+		if (parse.ret == 2)
+		    eof = 1;
+		if (with_blocks)
+		  {
+		      mark_dxf_blocks (dxf, scanned);
+		      scanned = NULL;
+		  }
+		batch = detach_dxf_batch (dxf, with_blocks);
+		with_blocks = 0;
+		load.dxf = batch;
+	    }
+	  else if (eof)
+	      ret = 1;
+      }
+    fclose (fl);
+    destroy_dxf_batch (batch);
+
+  stop:
+    mark_dxf_blocks (dxf, scanned);
+    if (parse_cache != NULL)
+	spatialite_internal_cleanup (parse_cache);
+    return ret;
+}
+
 #endif /* GEOS enabled */
@@ -2830,6 +2830,9 @@ gaiaGuessBlobType (const unsigned char *blob, int size)
 		else
 		    return GAIA_GEOMETRY_BLOB;
 	    default:
+		if (gtype > GAIA_TWKB_BLOB
+		    && gtype <= GAIA_TWKB_BLOB + GAIA_GEOMETRYCOLLECTIONZM)
+		    return GAIA_COMPRESSED_GEOMETRY_BLOB;	/* TWKB compressed */
 		return GAIA_GEOMETRY_BLOB;
 	    }
       }
@@ -60,6 +60,7 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #define fileno	_fileno
 #endif
 
+#include <spatialite_private.h>
 #include <spatialite/sqlite.h>
 #include <spatialite/debug.h>
 
@@ -1574,18 +1575,493 @@ geoJSONnormalize (const char *dirty)
     return clean;
 }
 
+/*
+** Fast path for plain GeoJSON geometries
+**
+** a {"type":"...","coordinates":[...]} object (no "bbox", no "crs")
+** is directly parsed here into preallocated coordinate arrays; any
+** other expression is always left to the full grammar.
+*/
+
+#define GEOJSON_FAST_POINTS	256
+#define GEOJSON_FAST_RINGS	16
+
+struct geoJson_fast_data
+{
+/* helper struct for the fast path */
+    const char *ptr;
+    int dims;
+    double *coords;
+    int points;
+    int max_points;
+    int *rings;
+    int num_rings;
+    int max_rings;
+    double stack_coords[GEOJSON_FAST_POINTS * 3];
+    int stack_rings[GEOJSON_FAST_RINGS];
+};
+
+static void
+geoJSON_fast_skip (struct geoJson_fast_data *data)
+{
+/* skipping any whitespace (as the lexer does) */
+    while (*(data->ptr) == ' ' || *(data->ptr) == '\t'
+	   || *(data->ptr) == '\n')
+	data->ptr++;
+}
+
+static int
+geoJSON_fast_grow (struct geoJson_fast_data *data)
+{
+/* ensuring room for one more vertex */
+    double *coords;
+    int max = data->max_points * 2;
+    if (data->points < data->max_points)
+	return 1;
+    if (data->coords == data->stack_coords)
+      {
+	  coords = malloc (sizeof (double) * max * data->dims);
+	  if (coords != NULL)
+	      memcpy (coords, data->coords,
+		      sizeof (double) * data->points * data->dims);
+      }
+    else
+	coords = realloc (data->coords, sizeof (double) * max * data->dims);
+    if (coords == NULL)
+	return 0;
+    data->coords = coords;
+    data->max_points = max;
+    return 1;
+}
+
+static int
+geoJSON_fast_add_ring (struct geoJson_fast_data *data, int points)
+{
+/* storing the number of vertices of one more ring */
+    int *rings;
+    int max = data->max_rings * 2;
+    if (data->num_rings >= data->max_rings)
+      {
+	  if (data->rings == data->stack_rings)
+	    {
+		rings = malloc (sizeof (int) * max);
+		if (rings != NULL)
+		    memcpy (rings, data->rings, sizeof (int) * data->num_rings);
+	    }
+	  else
+	      rings = realloc (data->rings, sizeof (int) * max);
+	  if (rings == NULL)
+	      return 0;
+	  data->rings = rings;
+	  data->max_rings = max;
+      }
+    data->rings[data->num_rings++] = points;
+    return 1;
+}
+
+static int
+geoJSON_fast_expect (struct geoJson_fast_data *data, char c)
+{
+/* consuming the expected punctuation mark */
+    geoJSON_fast_skip (data);
+    if (*(data->ptr) != c)
+	return 0;
+    data->ptr++;
+    return 1;
+}
+
+static int
+geoJSON_fast_point (struct geoJson_fast_data *data)
+{
+/* parsing a "[x, y]" or "[x, y, z]" position into the coordinate buffer */
+    double *out;
+    char c;
+    int iv;
+    if (!geoJSON_fast_expect (data, '['))
+	return 0;
+    if (!geoJSON_fast_grow (data))
+	return 0;
+    out = data->coords + (data->points * data->dims);
+    for (iv = 0; iv < data->dims; iv++)
+      {
+	  if (iv > 0 && !geoJSON_fast_expect (data, ','))
+	      return 0;
+	  geoJSON_fast_skip (data);
+	  if (!gaia_fast_parse_double (&(data->ptr), out + iv))
+	      return 0;
+	  c = *(data->ptr);
+	  if (c != ' ' && c != '\t' && c != '\n' && c != ',' && c != ']')
+	      return 0;
+      }
+    if (!geoJSON_fast_expect (data, ']'))
+	return 0;
+    data->points++;
+    return 1;
+}
+
+static int
+geoJSON_fast_list (struct geoJson_fast_data *data)
+{
+/* 
+/ parsing a "[[x, y], [x, y], ...]" list of positions
+/
+/ returns the number of vertices, -1 on failure
+*/
+    int count = 0;
+    if (!geoJSON_fast_expect (data, '['))
+	return -1;
+    while (1)
+      {
+	  if (!geoJSON_fast_point (data))
+	      return -1;
+	  count++;
+	  geoJSON_fast_skip (data);
+	  if (*(data->ptr) == ',')
+	    {
+		data->ptr++;
+		continue;
+	    }
+	  if (*(data->ptr) == ']')
+	    {
+		data->ptr++;
+		break;
+	    }
+	  return -1;
+      }
+    return count;
+}
+
+static int
+geoJSON_fast_rings (struct geoJson_fast_data *data)
+{
+/* parsing a "[[...], [...], ...]" list of rings */
+    int points;
+    data->points = 0;
+    data->num_rings = 0;
+    if (!geoJSON_fast_expect (data, '['))
+	return 0;
+    while (1)
+      {
+	  points = geoJSON_fast_list (data);
+	  if (points < 4)
+	      return 0;
+	  if (!geoJSON_fast_add_ring (data, points))
+	      return 0;
+	  geoJSON_fast_skip (data);
+	  if (*(data->ptr) == ',')
+	    {
+		data->ptr++;
+		continue;
+	    }
+	  if (*(data->ptr) == ']')
+	    {
+		data->ptr++;
+		break;
+	    }
+	  return 0;
+      }
+    return 1;
+}
+
+static void
+geoJSON_fast_add_points (struct geoJson_fast_data *data, gaiaGeomCollPtr geom)
+{
+/* adding all the buffered vertices as Points */
+    int iv;
+    double *in = data->coords;
+    for (iv = 0; iv < data->points; iv++)
+      {
+	  if (data->dims == 3)
+	      gaiaAddPointToGeomCollXYZ (geom, in[0], in[1], in[2]);
+	  else
+	      gaiaAddPointToGeomColl (geom, in[0], in[1]);
+	  in += data->dims;
+      }
+}
+
+static void
+geoJSON_fast_add_linestring (struct geoJson_fast_data *data,
+			     gaiaGeomCollPtr geom)
+{
+/* adding the buffered vertices as a Linestring */
+    gaiaLinestringPtr ln = gaiaAddLinestringToGeomColl (geom, data->points);
+    memcpy (ln->Coords, data->coords,
+	    sizeof (double) * data->points * data->dims);
+}
+
+static void
+geoJSON_fast_add_polygon (struct geoJson_fast_data *data,
+			  gaiaGeomCollPtr geom)
+{
+/* adding the buffered rings as a Polygon */
+    gaiaPolygonPtr pg;
+    gaiaRingPtr rng;
+    int ib;
+    double *in = data->coords;
+    pg = gaiaAddPolygonToGeomColl (geom, data->rings[0], data->num_rings - 1);
+    memcpy (pg->Exterior->Coords, in,
+	    sizeof (double) * data->rings[0] * data->dims);
+    in += data->rings[0] * data->dims;
+    for (ib = 1; ib < data->num_rings; ib++)
+      {
+	  rng = gaiaAddInteriorRing (pg, ib - 1, data->rings[ib]);
+	  memcpy (rng->Coords, in,
+		  sizeof (double) * data->rings[ib] * data->dims);
+	  in += data->rings[ib] * data->dims;
+      }
+}
+
+static int
+geoJSON_fast_type (const char **ptr)
+{
+/* identifying the Geometry class */
+    static const char *names[] = {
+	"\"Point\"", "\"LineString\"", "\"Polygon\"", "\"MultiPoint\"",
+	"\"MultiLineString\"", "\"MultiPolygon\"", NULL
+    };
+    static const int types[] = {
+	GAIA_POINT, GAIA_LINESTRING, GAIA_POLYGON, GAIA_MULTIPOINT,
+	GAIA_MULTILINESTRING, GAIA_MULTIPOLYGON
+    };
+    int i;
+    int len;
+    for (i = 0; names[i] != NULL; i++)
+      {
+	  len = strlen (names[i]);
+	  if (strncmp (*ptr, names[i], len) == 0)
+	    {
+		*ptr += len;
+		return types[i];
+	    }
+      }
+    return GAIA_UNKNOWN;
+}
+
+static const char *
+geoJSON_fast_skip_coords (const char *p, int *dims)
+{
+/* 
+/ skipping the "coordinates" value, also counting the dimensions
+/ of its first position
+*/
+    int depth = 0;
+    int commas = 0;
+    int first = 1;
+    while (1)
+      {
+	  switch (*p)
+	    {
+	    case '[':
+		depth++;
+		commas = 0;
+		break;
+	    case ']':
+		if (first)
+		  {
+		      *dims = commas + 1;
+		      first = 0;
+		  }
+		depth--;
+		break;
+	    case ',':
+		commas++;
+		break;
+	    case '\0':
+		return NULL;
+	    default:
+		if (!((*p >= '0' && *p <= '9') || *p == '.' || *p == '-'
+		      || *p == '+' || *p == 'e' || *p == 'E' || *p == ' '
+		      || *p == '\t' || *p == '\n'))
+		    return NULL;
+		break;
+	    };
+	  p++;
+	  if (depth == 0)
+	      return p;
+      }
+}
+
+static gaiaGeomCollPtr
+geoJSON_fast_parse (const unsigned char *buffer)
+{
+/* attempting to directly parse a plain GeoJSON geometry */
+    struct geoJson_fast_data data;
+    gaiaGeomCollPtr geom = NULL;
+    const char *p = (const char *) buffer;
+    const char *coords = NULL;
+    const char *coords_end = NULL;
+    int type = GAIA_UNKNOWN;
+    int dims = 0;
+    int member;
+    int ok = 0;
+
+/* checking the object's members: just "type" and "coordinates" */
+    data.ptr = p;
+    if (!geoJSON_fast_expect (&data, '{'))
+	return NULL;
+    for (member = 0; member < 2; member++)
+      {
+	  if (member > 0 && !geoJSON_fast_expect (&data, ','))
+	      return NULL;
+	  geoJSON_fast_skip (&data);
+	  if (type == GAIA_UNKNOWN && strncmp (data.ptr, "\"type\"", 6) == 0)
+	    {
+		data.ptr += 6;
+		if (!geoJSON_fast_expect (&data, ':'))
+		    return NULL;
+		geoJSON_fast_skip (&data);
+		type = geoJSON_fast_type (&(data.ptr));
+		if (type == GAIA_UNKNOWN)
+		    return NULL;
+	    }
+	  else if (coords == NULL
+		   && strncmp (data.ptr, "\"coordinates\"", 13) == 0)
+	    {
+		data.ptr += 13;
+		if (!geoJSON_fast_expect (&data, ':'))
+		    return NULL;
+		geoJSON_fast_skip (&data);
+		if (*(data.ptr) != '[')
+		    return NULL;
+		coords = data.ptr;
+		coords_end = geoJSON_fast_skip_coords (coords, &dims);
+		if (coords_end == NULL)
+		    return NULL;
+		data.ptr = coords_end;
+	    }
+	  else
+	      return NULL;
+      }
+    if (!geoJSON_fast_expect (&data, '}'))
+	return NULL;
+    geoJSON_fast_skip (&data);
+    if (*(data.ptr) != '\0')
+	return NULL;
+    if (dims != 2 && dims != 3)
+	return NULL;
+
+/* parsing the coordinates */
+    data.ptr = coords;
+    data.dims = dims;
+    data.coords = data.stack_coords;
+    data.points = 0;
+    data.max_points = GEOJSON_FAST_POINTS;
+    data.rings = data.stack_rings;
+    data.num_rings = 0;
+    data.max_rings = GEOJSON_FAST_RINGS;
+    if (dims == 3)
+	geom = gaiaAllocGeomCollXYZ ();
+    else
+	geom = gaiaAllocGeomColl ();
+    geom->DeclaredType = type;
+
+    switch (type)
+      {
+      case GAIA_POINT:
+	  if (!geoJSON_fast_point (&data))
+	      goto stop;
+	  geoJSON_fast_add_points (&data, geom);
+	  if (dims == 3)
+	      geom->DeclaredType = GAIA_POINTZ;
+	  geom->Srid = -1;
+	  break;
+      case GAIA_LINESTRING:
+	  if (geoJSON_fast_list (&data) < 2)
+	      goto stop;
+	  geoJSON_fast_add_linestring (&data, geom);
+	  geom->Srid = -1;
+	  break;
+      case GAIA_POLYGON:
+	  if (!geoJSON_fast_rings (&data))
+	      goto stop;
+	  geoJSON_fast_add_polygon (&data, geom);
+	  break;
+      case GAIA_MULTIPOINT:
+	  if (geoJSON_fast_list (&data) < 1)
+	      goto stop;
+	  geoJSON_fast_add_points (&data, geom);
+	  break;
+      case GAIA_MULTILINESTRING:
+      case GAIA_MULTIPOLYGON:
+	  if (!geoJSON_fast_expect (&data, '['))
+	      goto stop;
+	  while (1)
+	    {
+		if (type == GAIA_MULTILINESTRING)
+		  {
+		      data.points = 0;
+		      if (geoJSON_fast_list (&data) < 2)
+			  goto stop;
+		      geoJSON_fast_add_linestring (&data, geom);
+		  }
+		else
+		  {
+		      if (!geoJSON_fast_rings (&data))
+			  goto stop;
+		      geoJSON_fast_add_polygon (&data, geom);
+		  }
+		geoJSON_fast_skip (&data);
+		if (*(data.ptr) == ',')
+		  {
+		      data.ptr++;
+		      continue;
+		  }
+		if (*(data.ptr) == ']')
+		  {
+		      data.ptr++;
+		      break;
+		  }
+		goto stop;
+	    }
+	  break;
+      };
+    if (data.ptr == coords_end)
+	ok = 1;
+
+  stop:
+    if (data.coords != data.stack_coords)
+	free (data.coords);
+    if (data.rings != data.stack_rings)
+	free (data.rings);
+    if (!ok)
+      {
+	  gaiaFreeGeomColl (geom);
+	  return NULL;
+      }
+    return geom;
+}
+
 gaiaGeomCollPtr
 gaiaParseGeoJSON (const unsigned char *dirty_buffer)
 {
-    void *pParser = ParseAlloc (malloc);
+    void *pParser;
     /* Linked-list of token values */
-    geoJsonFlexToken *tokens = malloc (sizeof (geoJsonFlexToken));
+    geoJsonFlexToken *tokens;
     /* Pointer to the head of the list */
-    geoJsonFlexToken *head = tokens;
+    geoJsonFlexToken *head;
     int yv;
     yyscan_t scanner;
     struct geoJson_data str_data;
-    char *normalized_buffer = geoJSONnormalize ((const char *) dirty_buffer);
+    char *normalized_buffer;
+    gaiaGeomCollPtr geom;
+
+/* attempting first the fast path */
+    geom = geoJSON_fast_parse (dirty_buffer);
+    if (geom != NULL)
+      {
+	  if (!geoJsonCheckValidity (geom))
+	    {
+		gaiaFreeGeomColl (geom);
+		return NULL;
+	    }
+	  gaiaMbrGeometry (geom);
+	  return geom;
+      }
+
+    pParser = ParseAlloc (malloc);
+    tokens = malloc (sizeof (geoJsonFlexToken));
+    head = tokens;
+    normalized_buffer = geoJSONnormalize ((const char *) dirty_buffer);
 
 /* initializing the helper structs */
     str_data.geoJson_line = 1;
@@ -4820,4 +4820,194 @@ gaiaGeomCollPreparedCoveredBy (const void *p_cache, gaiaGeomCollPtr geom1,
     return ret;
 }
 
+#ifdef GEOS_3120		/* only if GEOS 3.12.0 (or later) is supported */
+
+static int
+sniffPointXY (const unsigned char *blob, int size, double *x, double *y)
+{
+/* directly reading X and Y from a BLOB-Point or BLOB-TinyPoint */
+    int little_endian;
+    int endian_arch = gaiaEndianArch ();
+    int type;
+    if (sniffTinyPointBlob (blob, size))
+      {
+	  little_endian =
+	      (*(blob + 1) == GAIA_TINYPOINT_LITTLE_ENDIAN) ? 1 : 0;
+	  *x = gaiaImport64 (blob + 7, little_endian, endian_arch);
+	  *y = gaiaImport64 (blob + 15, little_endian, endian_arch);
+	  return 1;
+      }
+    if (size == 60 || size == 68 || size == 76)
+	;
+    else
+	return 0;
+    if (*(blob + 0) != GAIA_MARK_START)
+	return 0;
+    if (*(blob + 1) == GAIA_LITTLE_ENDIAN)
+	little_endian = 1;
+    else if (*(blob + 1) == GAIA_BIG_ENDIAN)
+	little_endian = 0;
+    else
+	return 0;
+    if (*(blob + 38) != GAIA_MARK_MBR)
+	return 0;
+    if (*(blob + (size - 1)) != GAIA_MARK_END)
+	return 0;
+    type = gaiaImport32 (blob + 39, little_endian, endian_arch);
+    switch (type)
+      {
+      case GAIA_POINT:
+	  if (size != 60)
+	      return 0;
+	  break;
+      case GAIA_POINTZ:
+      case GAIA_POINTM:
+	  if (size != 68)
+	      return 0;
+	  break;
+      case GAIA_POINTZM:
+	  if (size != 76)
+	      return 0;
+	  break;
+      default:
+	  return 0;
+      };
+    *x = gaiaImport64 (blob + 43, little_endian, endian_arch);
+    *y = gaiaImport64 (blob + 51, little_endian, endian_arch);
+    return 1;
+}
+
+static GEOSPreparedGeometry *
+findPreparedGeosCache (struct splite_internal_cache *cache,
+		       const unsigned char *blob, int size)
+{
+/* searching the internal GEOS cache for an already Prepared Geometry */
+    struct splite_geos_cache_item *p1 = &(cache->cacheItem1);
+    struct splite_geos_cache_item *p2 = &(cache->cacheItem2);
+    uLong crc;
+    if (size < 46 || sniffTinyPointBlob (blob, size))
+	return NULL;
+    if (p1->preparedGeosGeom == NULL && p2->preparedGeosGeom == NULL)
+	return NULL;
+    crc = crc32 (0L, blob, size);
+    if (p1->preparedGeosGeom != NULL
+	&& evalGeosCacheItem ((unsigned char *) blob, size, crc, p1))
+	return p1->preparedGeosGeom;
+    if (p2->preparedGeosGeom != NULL
+	&& evalGeosCacheItem ((unsigned char *) blob, size, crc, p2))
+	return p2->preparedGeosGeom;
+    return NULL;
+}
+
+static int
+blobMbrContainsXY (const unsigned char *blob, double x, double y)
+{
+/* quick check based on the MBR stored into the BLOB-Geometry */
+    int little_endian;
+    int endian_arch = gaiaEndianArch ();
+    if (*(blob + 0) != GAIA_MARK_START || *(blob + 38) != GAIA_MARK_MBR)
+	return 1;		/* not a SpatiaLite BLOB: no quick check */
+    little_endian = (*(blob + 1) == GAIA_LITTLE_ENDIAN) ? 1 : 0;
+    if (x < gaiaImport64 (blob + 6, little_endian, endian_arch))
+	return 0;
+    if (y < gaiaImport64 (blob + 14, little_endian, endian_arch))
+	return 0;
+    if (x > gaiaImport64 (blob + 22, little_endian, endian_arch))
+	return 0;
+    if (y > gaiaImport64 (blob + 30, little_endian, endian_arch))
+	return 0;
+    return 1;
+}
+
+GAIAGEO_DECLARE int
+gaiaGeomCollPreparedPointXY (const void *p_cache, const unsigned char *blob1,
+			     int size1, const unsigned char *blob2, int size2,
+			     int predicate, int *result)
+{
+/* Point-in-Polygon fast path - never building any Geometry */
+    struct splite_internal_cache *cache =
+	(struct splite_internal_cache *) p_cache;
+    GEOSContextHandle_t handle = NULL;
+    GEOSPreparedGeometry *gPrep;
+    const unsigned char *prep_blob;
+    int prep_size;
+    double x;
+    double y;
+    int ret;
+    if (cache == NULL)
+	return 0;
+    if (cache->magic1 != SPATIALITE_CACHE_MAGIC1
+	|| cache->magic2 != SPATIALITE_CACHE_MAGIC2)
+	return 0;
+    handle = cache->GEOS_handle;
+    if (handle == NULL)
+	return 0;
+    if (blob1 == NULL || blob2 == NULL)
+	return 0;
+
+/* identifying the POINT and the (eventually) Prepared Geometry */
+    switch (predicate)
+      {
+      case GAIA_PREPARED_CONTAINS:
+      case GAIA_PREPARED_COVERS:
+	  /* the POINT is expected to be the second Geometry */
+	  if (!sniffPointXY (blob2, size2, &x, &y))
+	      return 0;
+	  prep_blob = blob1;
+	  prep_size = size1;
+	  break;
+      case GAIA_PREPARED_WITHIN:
+      case GAIA_PREPARED_COVEREDBY:
+	  /* the POINT is expected to be the first Geometry */
+	  if (!sniffPointXY (blob1, size1, &x, &y))
+	      return 0;
+	  prep_blob = blob2;
+	  prep_size = size2;
+	  break;
+      case GAIA_PREPARED_INTERSECTS:
+	  /* the POINT could indifferently be the first or second Geometry */
+	  if (sniffPointXY (blob2, size2, &x, &y))
+	    {
+		prep_blob = blob1;
+		prep_size = size1;
+	    }
+	  else if (sniffPointXY (blob1, size1, &x, &y))
+	    {
+		prep_blob = blob2;
+		prep_size = size2;
+	    }
+	  else
+	      return 0;
+	  break;
+      default:
+	  return 0;
+      };
+    gPrep = findPreparedGeosCache (cache, prep_blob, prep_size);
+    if (gPrep == NULL)
+	return 0;
+
+    gaiaResetGeosMsg_r (cache);
+/* quick check based on MBRs comparison */
+    if (!blobMbrContainsXY (prep_blob, x, y))
+      {
+	  *result = 0;
+	  return 1;
+      }
+
+    if (predicate == GAIA_PREPARED_CONTAINS
+	|| predicate == GAIA_PREPARED_WITHIN)
+	ret = GEOSPreparedContainsXY_r (handle, gPrep, x, y);
+    else
+      {
+	  /* for a POINT Covers and CoveredBy are the same as Intersects */
+	  ret = GEOSPreparedIntersectsXY_r (handle, gPrep, x, y);
+      }
+    if (ret == 2)
+	ret = -1;
+    *result = ret;
+    return 1;
+}
+
+#endif /* end GEOS_3120 conditional */
+
 #endif /* end including GEOS */
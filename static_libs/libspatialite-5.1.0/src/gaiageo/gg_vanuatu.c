@@ -48,6 +48,8 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <float.h>
+#include <locale.h>
 
 #include <assert.h>
 
@@ -57,11 +59,16 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include "config.h"
 #endif
 
+#include <spatialite_private.h>
 #include <spatialite/sqlite.h>
 #include <spatialite/debug.h>
 
 #include <spatialite/gaiageo.h>
 
+#ifdef _WIN32
+#define strncasecmp	_strnicmp
+#endif /* not WIN32 */
+
 #if defined(_WIN32) || defined(WIN32)
 #include <io.h>
 #ifndef isatty
@@ -1856,17 +1863,593 @@ vanuatu_cleanup (vanuatuFlexToken * token)
     return 0;
 }
 
+/*
+** Fast path for plain WKT coordinate lists
+**
+** nearly all the WKT expressions passed to GeomFromText() and alike
+** simply are POINT, LINESTRING, POLYGON or MULTI* coordinate lists;
+** they are directly parsed here into preallocated coordinate arrays,
+** so to avoid the Flex/Lemon overhead and the intermediate linked
+** lists of Points.
+** any other expression (GEOMETRYCOLLECTION, unusual number notations,
+** degenerated geometries, syntax errors ...) is always left to the
+** full grammar, that will then behave exactly as before.
+*/
+
+#define VANUATU_FAST_POINTS	256
+#define VANUATU_FAST_RINGS	16
+
+struct vanuatu_fast_data
+{
+/* helper struct for the fast path */
+    const char *ptr;
+    int dims;
+    double *coords;
+    int points;
+    int max_points;
+    int *rings;
+    int num_rings;
+    int max_rings;
+    double stack_coords[VANUATU_FAST_POINTS * 4];
+    int stack_rings[VANUATU_FAST_RINGS];
+};
+
+static const double vanuatu_fast_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+SPATIALITE_PRIVATE int
+gaia_fast_parse_double (const char **ptr, double *value)
+{
+/*
+/ parsing a single number token (same notation accepted by the
+/ WKT and GeoJSON lexers) into a correctly rounded double
+/
+/ returns 0 if the token isn't supported by the fast path
+*/
+    const char *start = *ptr;
+    const char *p = start;
+    sqlite3_uint64 mantissa = 0;
+    int negative = 0;
+    int too_long = 0;
+    int sig_digits = 0;
+    int int_digits = 0;
+    int frac_digits = 0;
+    int has_dot = 0;
+    int exponent = 0;
+    int exp_negative = 0;
+    int exp_digits = 0;
+    int exact = 0;
+    int scale;
+    double val = 0.0;
+    char buf[64];
+    int len;
+    int i;
+    struct lconv *lc;
+
+    if (*p == '-')
+      {
+	  negative = 1;
+	  p++;
+      }
+    else if (*p == '+')
+	p++;
+    while (*p >= '0' && *p <= '9')
+      {
+	  if (mantissa != 0 || *p != '0')
+	    {
+		if (sig_digits < 19)
+		  {
+		      mantissa = (mantissa * 10) + (*p - '0');
+		      sig_digits++;
+		  }
+		else
+		    too_long = 1;
+	    }
+	  int_digits++;
+	  p++;
+      }
+    if (*p == '.')
+      {
+	  has_dot = 1;
+	  p++;
+	  while (*p >= '0' && *p <= '9')
+	    {
+		if (mantissa != 0 || *p != '0')
+		  {
+		      if (sig_digits < 19)
+			{
+			    mantissa = (mantissa * 10) + (*p - '0');
+			    sig_digits++;
+			}
+		      else
+			  too_long = 1;
+		  }
+		frac_digits++;
+		p++;
+	    }
+      }
+    if (int_digits == 0 && frac_digits == 0)
+	return 0;
+    if (*p == 'e' || *p == 'E')
+      {
+	  if (has_dot && frac_digits == 0)
+	      return 0;		/* "1.e5" isn't a single lexer token */
+	  p++;
+	  if (*p == '-')
+	    {
+		exp_negative = 1;
+		p++;
+	    }
+	  else if (*p == '+')
+	      p++;
+	  while (*p >= '0' && *p <= '9')
+	    {
+		if (exponent < 100000)
+		    exponent = (exponent * 10) + (*p - '0');
+		exp_digits++;
+		p++;
+	    }
+	  if (exp_digits == 0)
+	      return 0;
+      }
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    if (!too_long)
+      {
+	  /* 
+	     / Clinger's fast path: both the mantissa and the power of ten
+	     / are exactly representable, so a single IEEE operation
+	     / returns the correctly rounded result
+	   */
+	  scale = (exp_negative ? -exponent : exponent) - frac_digits;
+	  if (mantissa == 0)
+	    {
+		val = 0.0;
+		exact = 1;
+	    }
+	  else if (mantissa <= ((sqlite3_uint64) 1 << 53) && scale >= -22
+		   && scale <= 22)
+	    {
+		val = (double) mantissa;
+		if (scale < 0)
+		    val /= vanuatu_fast_pow10[-scale];
+		else
+		    val *= vanuatu_fast_pow10[scale];
+		exact = 1;
+	    }
+      }
+#endif
+    if (exact)
+      {
+	  if (negative)
+	      val = -val;
+      }
+    else
+      {
+	  /* slow path: strtod() on a locale-neutral copy of the token */
+	  len = p - start;
+	  if (len >= (int) sizeof (buf))
+	      return 0;
+	  memcpy (buf, start, len);
+	  buf[len] = '\0';
+	  lc = localeconv ();
+	  if (lc != NULL && lc->decimal_point != NULL
+	      && strlen (lc->decimal_point) == 1 && *(lc->decimal_point) != '.')
+	    {
+		for (i = 0; i < len; i++)
+		  {
+		      if (buf[i] == '.')
+			  buf[i] = *(lc->decimal_point);
+		  }
+	    }
+	  val = strtod (buf, NULL);
+      }
+    *value = val;
+    *ptr = p;
+    return 1;
+}
+
+static void
+vanuatu_fast_skip (struct vanuatu_fast_data *data)
+{
+/* skipping any whitespace (as the lexer does) */
+    while (*(data->ptr) == ' ' || *(data->ptr) == '\t'
+	   || *(data->ptr) == '\n')
+	data->ptr++;
+}
+
+static int
+vanuatu_fast_grow (struct vanuatu_fast_data *data)
+{
+/* ensuring room for one more vertex */
+    double *coords;
+    int max = data->max_points * 2;
+    if (data->points < data->max_points)
+	return 1;
+    if (data->coords == data->stack_coords)
+      {
+	  coords = malloc (sizeof (double) * max * data->dims);
+	  if (coords != NULL)
+	      memcpy (coords, data->coords,
+		      sizeof (double) * data->points * data->dims);
+      }
+    else
+	coords = realloc (data->coords, sizeof (double) * max * data->dims);
+    if (coords == NULL)
+	return 0;
+    data->coords = coords;
+    data->max_points = max;
+    return 1;
+}
+
+static int
+vanuatu_fast_add_ring (struct vanuatu_fast_data *data, int points)
+{
+/* storing the number of vertices of one more ring */
+    int *rings;
+    int max = data->max_rings * 2;
+    if (data->num_rings >= data->max_rings)
+      {
+	  if (data->rings == data->stack_rings)
+	    {
+		rings = malloc (sizeof (int) * max);
+		if (rings != NULL)
+		    memcpy (rings, data->rings, sizeof (int) * data->num_rings);
+	    }
+	  else
+	      rings = realloc (data->rings, sizeof (int) * max);
+	  if (rings == NULL)
+	      return 0;
+	  data->rings = rings;
+	  data->max_rings = max;
+      }
+    data->rings[data->num_rings++] = points;
+    return 1;
+}
+
+static int
+vanuatu_fast_list (struct vanuatu_fast_data *data)
+{
+/* 
+/ parsing a "(x y, x y, ...)" list of vertices and appending
+/ them to the coordinate buffer
+/
+/ returns the number of vertices, -1 on failure
+*/
+    double *out;
+    char c;
+    int iv;
+    int count = 0;
+    vanuatu_fast_skip (data);
+    if (*(data->ptr) != '(')
+	return -1;
+    data->ptr++;
+    while (1)
+      {
+	  if (!vanuatu_fast_grow (data))
+	      return -1;
+	  out = data->coords + (data->points * data->dims);
+	  vanuatu_fast_skip (data);
+	  for (iv = 0; iv < data->dims; iv++)
+	    {
+		if (iv > 0)
+		  {
+		      c = *(data->ptr);
+		      if (c != ' ' && c != '\t' && c != '\n')
+			  return -1;
+		      vanuatu_fast_skip (data);
+		  }
+		if (!gaia_fast_parse_double (&(data->ptr), out + iv))
+		    return -1;
+		c = *(data->ptr);
+		if (c != ' ' && c != '\t' && c != '\n' && c != ','
+		    && c != ')')
+		    return -1;
+	    }
+	  data->points++;
+	  count++;
+	  vanuatu_fast_skip (data);
+	  if (*(data->ptr) == ',')
+	    {
+		data->ptr++;
+		continue;
+	    }
+	  if (*(data->ptr) == ')')
+	    {
+		data->ptr++;
+		break;
+	    }
+	  return -1;
+      }
+    return count;
+}
+
+static int
+vanuatu_fast_rings (struct vanuatu_fast_data *data)
+{
+/* parsing a "((...), (...), ...)" list of rings */
+    int points;
+    data->points = 0;
+    data->num_rings = 0;
+    vanuatu_fast_skip (data);
+    if (*(data->ptr) != '(')
+	return 0;
+    data->ptr++;
+    while (1)
+      {
+	  points = vanuatu_fast_list (data);
+	  if (points < 4)
+	      return 0;
+	  if (!vanuatu_fast_add_ring (data, points))
+	      return 0;
+	  vanuatu_fast_skip (data);
+	  if (*(data->ptr) == ',')
+	    {
+		data->ptr++;
+		continue;
+	    }
+	  if (*(data->ptr) == ')')
+	    {
+		data->ptr++;
+		break;
+	    }
+	  return 0;
+      }
+    return 1;
+}
+
+static void
+vanuatu_fast_add_points (struct vanuatu_fast_data *data, gaiaGeomCollPtr geom)
+{
+/* adding all the buffered vertices as Points */
+    int iv;
+    double *in = data->coords;
+    for (iv = 0; iv < data->points; iv++)
+      {
+	  if (geom->DimensionModel == GAIA_XY_Z)
+	      gaiaAddPointToGeomCollXYZ (geom, in[0], in[1], in[2]);
+	  else if (geom->DimensionModel == GAIA_XY_M)
+	      gaiaAddPointToGeomCollXYM (geom, in[0], in[1], in[2]);
+	  else if (geom->DimensionModel == GAIA_XY_Z_M)
+	      gaiaAddPointToGeomCollXYZM (geom, in[0], in[1], in[2], in[3]);
+	  else
+	      gaiaAddPointToGeomColl (geom, in[0], in[1]);
+	  in += data->dims;
+      }
+}
+
+static void
+vanuatu_fast_add_linestring (struct vanuatu_fast_data *data,
+			     gaiaGeomCollPtr geom)
+{
+/* adding the buffered vertices as a Linestring */
+    gaiaLinestringPtr ln = gaiaAddLinestringToGeomColl (geom, data->points);
+    memcpy (ln->Coords, data->coords,
+	    sizeof (double) * data->points * data->dims);
+}
+
+static void
+vanuatu_fast_add_polygon (struct vanuatu_fast_data *data,
+			  gaiaGeomCollPtr geom)
+{
+/* adding the buffered rings as a Polygon */
+    gaiaPolygonPtr pg;
+    gaiaRingPtr rng;
+    int ib;
+    double *in = data->coords;
+    pg = gaiaAddPolygonToGeomColl (geom, data->rings[0], data->num_rings - 1);
+    memcpy (pg->Exterior->Coords, in,
+	    sizeof (double) * data->rings[0] * data->dims);
+    in += data->rings[0] * data->dims;
+    for (ib = 1; ib < data->num_rings; ib++)
+      {
+	  rng = gaiaAddInteriorRing (pg, ib - 1, data->rings[ib]);
+	  memcpy (rng->Coords, in,
+		  sizeof (double) * data->rings[ib] * data->dims);
+	  in += data->rings[ib] * data->dims;
+      }
+}
+
+static int
+vanuatu_fast_keyword (struct vanuatu_fast_data *data, int *model)
+{
+/* identifying the Geometry class and its dimension model */
+    static const char *names[] = {
+	"MULTILINESTRING", "MULTIPOLYGON", "MULTIPOINT", "LINESTRING",
+	"POLYGON", "POINT", NULL
+    };
+    static const int types[] = {
+	GAIA_MULTILINESTRING, GAIA_MULTIPOLYGON, GAIA_MULTIPOINT,
+	GAIA_LINESTRING, GAIA_POLYGON, GAIA_POINT
+    };
+    int i;
+    int len;
+    int type = GAIA_UNKNOWN;
+    for (i = 0; names[i] != NULL; i++)
+      {
+	  len = strlen (names[i]);
+	  if (strncasecmp (data->ptr, names[i], len) == 0)
+	    {
+		type = types[i];
+		data->ptr += len;
+		break;
+	    }
+      }
+    if (type == GAIA_UNKNOWN)
+	return GAIA_UNKNOWN;
+    vanuatu_fast_skip (data);
+    *model = GAIA_XY;
+    data->dims = 2;
+    if (*(data->ptr) == 'Z' || *(data->ptr) == 'z')
+      {
+	  data->ptr++;
+	  if (*(data->ptr) == 'M' || *(data->ptr) == 'm')
+	    {
+		data->ptr++;
+		*model = GAIA_XY_Z_M;
+		data->dims = 4;
+	    }
+	  else
+	    {
+		*model = GAIA_XY_Z;
+		data->dims = 3;
+	    }
+      }
+    else if (*(data->ptr) == 'M' || *(data->ptr) == 'm')
+      {
+	  data->ptr++;
+	  *model = GAIA_XY_M;
+	  data->dims = 3;
+      }
+    return type;
+}
+
+static gaiaGeomCollPtr
+vanuatu_fast_parse (const unsigned char *buffer)
+{
+/* attempting to directly parse a plain WKT expression */
+    struct vanuatu_fast_data data;
+    gaiaGeomCollPtr geom = NULL;
+    int type;
+    int model;
+    int ok = 0;
+
+    data.ptr = (const char *) buffer;
+    data.dims = 2;
+    data.coords = data.stack_coords;
+    data.points = 0;
+    data.max_points = VANUATU_FAST_POINTS;
+    data.rings = data.stack_rings;
+    data.num_rings = 0;
+    data.max_rings = VANUATU_FAST_RINGS;
+
+    vanuatu_fast_skip (&data);
+    type = vanuatu_fast_keyword (&data, &model);
+    if (type == GAIA_UNKNOWN)
+	return NULL;
+    if (model == GAIA_XY_Z)
+	geom = gaiaAllocGeomCollXYZ ();
+    else if (model == GAIA_XY_M)
+	geom = gaiaAllocGeomCollXYM ();
+    else if (model == GAIA_XY_Z_M)
+	geom = gaiaAllocGeomCollXYZM ();
+    else
+	geom = gaiaAllocGeomColl ();
+    geom->DeclaredType = type;
+
+    switch (type)
+      {
+      case GAIA_POINT:
+	  if (vanuatu_fast_list (&data) != 1)
+	      goto stop;
+	  vanuatu_fast_add_points (&data, geom);
+	  if (model == GAIA_XY_Z)
+	      geom->DeclaredType = GAIA_POINTZ;
+	  else if (model == GAIA_XY_M)
+	      geom->DeclaredType = GAIA_POINTM;
+	  else if (model == GAIA_XY_Z_M)
+	      geom->DeclaredType = GAIA_POINTZM;
+	  break;
+      case GAIA_LINESTRING:
+	  if (vanuatu_fast_list (&data) < 2)
+	      goto stop;
+	  vanuatu_fast_add_linestring (&data, geom);
+	  break;
+      case GAIA_POLYGON:
+	  if (!vanuatu_fast_rings (&data))
+	      goto stop;
+	  vanuatu_fast_add_polygon (&data, geom);
+	  break;
+      case GAIA_MULTIPOINT:
+	  if (vanuatu_fast_list (&data) < 1)
+	      goto stop;
+	  vanuatu_fast_add_points (&data, geom);
+	  break;
+      case GAIA_MULTILINESTRING:
+      case GAIA_MULTIPOLYGON:
+	  vanuatu_fast_skip (&data);
+	  if (*(data.ptr) != '(')
+	      goto stop;
+	  data.ptr++;
+	  while (1)
+	    {
+		if (type == GAIA_MULTILINESTRING)
+		  {
+		      data.points = 0;
+		      if (vanuatu_fast_list (&data) < 2)
+			  goto stop;
+		      vanuatu_fast_add_linestring (&data, geom);
+		  }
+		else
+		  {
+		      if (!vanuatu_fast_rings (&data))
+			  goto stop;
+		      vanuatu_fast_add_polygon (&data, geom);
+		  }
+		vanuatu_fast_skip (&data);
+		if (*(data.ptr) == ',')
+		  {
+		      data.ptr++;
+		      continue;
+		  }
+		if (*(data.ptr) == ')')
+		  {
+		      data.ptr++;
+		      break;
+		  }
+		goto stop;
+	    }
+	  break;
+      };
+    vanuatu_fast_skip (&data);
+    if (*(data.ptr) == '\0')
+	ok = 1;
+
+  stop:
+    if (data.coords != data.stack_coords)
+	free (data.coords);
+    if (data.rings != data.stack_rings)
+	free (data.rings);
+    if (!ok)
+      {
+	  gaiaFreeGeomColl (geom);
+	  return NULL;
+      }
+    return geom;
+}
+
 gaiaGeomCollPtr
 gaiaParseWkt (const unsigned char *dirty_buffer, short type)
 {
-    void *pParser = ParseAlloc (malloc);
+    void *pParser;
     /* Linked-list of token values */
-    vanuatuFlexToken *tokens = malloc (sizeof (vanuatuFlexToken));
+    vanuatuFlexToken *tokens;
     /* Pointer to the head of the list */
-    vanuatuFlexToken *head = tokens;
+    vanuatuFlexToken *head;
     int yv;
     yyscan_t scanner;
     struct vanuatu_data str_data;
+    gaiaGeomCollPtr geom;
+
+/* attempting first the fast path */
+    geom = vanuatu_fast_parse (dirty_buffer);
+    if (geom != NULL)
+      {
+	  if (!vanuatuCheckValidity (geom)
+	      || (type >= 0 && geom->DeclaredType != type))
+	    {
+		gaiaFreeGeomColl (geom);
+		return NULL;
+	    }
+	  gaiaMbrGeometry (geom);
+	  return geom;
+      }
+
+    pParser = ParseAlloc (malloc);
+    tokens = malloc (sizeof (vanuatuFlexToken));
+    head = tokens;
 
 /* initializing the helper structs */
     str_data.vanuatu_line = 1;
@@ -123,6 +123,133 @@ struct concave_hull_str
     double count;
 };
 
+struct concave_hull_triangle
+{
+/* a struct representing a Delaunay triangle for Concave Hull */
+    double x1;			/* vertex #1 */
+    double y1;
+    double x2;			/* vertex #2 */
+    double y2;
+    double x3;			/* vertex #3 */
+    double y3;
+    double length_1_2;		/* edge lengths */
+    double length_2_3;
+    double length_3_1;
+    gaiaPolygonPtr polygon;	/* the original triangle */
+    int selected;		/* flag: inserted into the Concave Hull */
+};
+
+struct delaunay_edge
+{
+/* an auxiliary struct - edge of some Delaunay triangle */
+    double x1;			/* lesser vertex */
+    double y1;
+    double x2;			/* greater vertex */
+    double y2;
+    int triangle;		/* triangle index */
+    int which;			/* 12, 23 or 31 */
+};
+
+static void
+delaunay_set_edge (struct delaunay_edge *edge, double x1, double y1,
+		   double x2, double y2, int triangle, int which)
+{
+/* initializing a Delaunay edge (vertices always sorted) */
+    if (x1 < x2 || (x1 == x2 && y1 < y2))
+      {
+	  edge->x1 = x1;
+	  edge->y1 = y1;
+	  edge->x2 = x2;
+	  edge->y2 = y2;
+      }
+    else
+      {
+	  edge->x1 = x2;
+	  edge->y1 = y2;
+	  edge->x2 = x1;
+	  edge->y2 = y1;
+      }
+    edge->triangle = triangle;
+    edge->which = which;
+}
+
+static int
+delaunay_same_edge (const struct delaunay_edge *e1,
+		    const struct delaunay_edge *e2)
+{
+/* testing if two Delaunay edges are the same */
+    if (e1->x1 == e2->x1 && e1->y1 == e2->y1 && e1->x2 == e2->x2
+	&& e1->y2 == e2->y2)
+	return 1;
+    return 0;
+}
+
+static int
+delaunay_edge_compare (const void *p1, const void *p2)
+{
+/* comparison function for QSORT - Delaunay edges */
+    const struct delaunay_edge *e1 = (const struct delaunay_edge *) p1;
+    const struct delaunay_edge *e2 = (const struct delaunay_edge *) p2;
+    if (e1->x1 != e2->x1)
+	return (e1->x1 < e2->x1) ? -1 : 1;
+    if (e1->y1 != e2->y1)
+	return (e1->y1 < e2->y1) ? -1 : 1;
+    if (e1->x2 != e2->x2)
+	return (e1->x2 < e2->x2) ? -1 : 1;
+    if (e1->y2 != e2->y2)
+	return (e1->y2 < e2->y2) ? -1 : 1;
+    if (e1->triangle != e2->triangle)
+	return (e1->triangle < e2->triangle) ? -1 : 1;
+    if (e1->which != e2->which)
+	return (e1->which < e2->which) ? -1 : 1;
+    return 0;
+}
+
+static int
+delaunay_orientation (double ax, double ay, double bx, double by, double cx,
+		      double cy, int *sign)
+{
+/* 
+/ orientation of point C with respect to the AB segment
+/ the error bound of the floating point determinant is checked
+/ as in Shewchuk's orient2d filter; returns 0 when the sign
+/ can't be safely determined
+*/
+    double detleft = (ax - cx) * (by - cy);
+    double detright = (ay - cy) * (bx - cx);
+    double det = detleft - detright;
+    double detsum;
+    double errbound;
+
+    if (detleft > 0.0)
+      {
+	  if (detright <= 0.0)
+	      goto sure;
+	  detsum = detleft + detright;
+      }
+    else if (detleft < 0.0)
+      {
+	  if (detright >= 0.0)
+	      goto sure;
+	  detsum = -detleft - detright;
+      }
+    else
+	goto sure;
+    errbound = 3.3306690738754716e-16 * detsum;
+    if (det >= errbound || -det >= errbound)
+	goto sure;
+    return 0;
+
+  sure:
+    if (det > 0.0)
+	*sign = 1;
+    else if (det < 0.0)
+	*sign = -1;
+    else
+	*sign = 0;
+    return 1;
+}
+
 #ifndef GEOS_REENTRANT		/* GEOS >= 3.5.0 directly supports Voronoj */
 
 static double *
@@ -380,21 +507,9 @@ voronoj_add_frame_point (struct voronoj_aux *voronoj, double x, double y)
 }
 
 static int
-voronoj_same_edge (double ax1, double ay1, double ax2, double ay2, double bx1,
-		   double by1, double bx2, double by2)
+voronoj_internal_geos (const void *p_cache, struct voronoj_triangle *triangle)
 {
-/* testing if two segments are the same */
-    if (ax1 == bx1 && ay1 == by1 && ax2 == bx2 && ay2 == by2)
-	return 1;
-    if (ax1 == bx2 && ay1 == by2 && ax2 == bx1 && ay2 == by1)
-	return 1;
-    return 0;
-}
-
-static int
-voronoj_internal (const void *p_cache, struct voronoj_triangle *triangle)
-{
-/* checking if the circumcenter falls inside the triangle */
+/* checking if the circumcenter falls inside the triangle - GEOS */
     int ret;
     gaiaGeomCollPtr pt = gaiaAllocGeomColl ();
     gaiaGeomCollPtr tri = gaiaAllocGeomColl ();
@@ -416,65 +531,68 @@ voronoj_internal (const void *p_cache, struct voronoj_triangle *triangle)
     return ret;
 }
 
+static int
+voronoj_internal (const void *p_cache, struct voronoj_triangle *triangle)
+{
+/* checking if the circumcenter falls inside the triangle */
+    int o1;
+    int o2;
+    int o3;
+    if (!delaunay_orientation
+	(triangle->x1, triangle->y1, triangle->x2, triangle->y2, triangle->cx,
+	 triangle->cy, &o1))
+	goto ambiguous;
+    if (!delaunay_orientation
+	(triangle->x2, triangle->y2, triangle->x3, triangle->y3, triangle->cx,
+	 triangle->cy, &o2))
+	goto ambiguous;
+    if (!delaunay_orientation
+	(triangle->x3, triangle->y3, triangle->x1, triangle->y1, triangle->cx,
+	 triangle->cy, &o3))
+	goto ambiguous;
+    if ((o1 < 0 || o2 < 0 || o3 < 0) && (o1 > 0 || o2 > 0 || o3 > 0))
+	return 0;
+    return 1;
+
+  ambiguous:
+/* almost degenerate case: delegating to GEOS */
+    return voronoj_internal_geos (p_cache, triangle);
+}
+
 static double
-voronoj_test_point (const void *p_cache, double x1, double y1, double x2,
-		    double y2, double x, double y)
+voronoj_test_point (double x1, double y1, double x2, double y2, double x,
+		    double y)
 {
-/* point-segment distance */
-    double dist;
-    gaiaGeomCollPtr pt = gaiaAllocGeomColl ();
-    gaiaGeomCollPtr segm = gaiaAllocGeomColl ();
-    gaiaLinestringPtr ln = gaiaAddLinestringToGeomColl (segm, 2);
-    gaiaSetPoint (ln->Coords, 0, x1, y1);
-    gaiaSetPoint (ln->Coords, 1, x2, y2);
-    gaiaAddPointToGeomColl (pt, x, y);
-    if (p_cache != NULL)
-	gaiaGeomCollDistance_r (p_cache, segm, pt, &dist);
-    else
-	gaiaGeomCollDistance (segm, pt, &dist);
-    gaiaFreeGeomColl (pt);
-    gaiaFreeGeomColl (segm);
-    return dist;
+/* point-segment distance (same arithmetic as GEOS) */
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    double len2 = (dx * dx) + (dy * dy);
+    double r;
+    double s;
+    if (x1 == x2 && y1 == y2)
+	return sqrt (((x - x1) * (x - x1)) + ((y - y1) * (y - y1)));
+    r = (((x - x1) * dx) + ((y - y1) * dy)) / len2;
+    if (r <= 0.0)
+	return sqrt (((x - x1) * (x - x1)) + ((y - y1) * (y - y1)));
+    if (r >= 1.0)
+	return sqrt (((x - x2) * (x - x2)) + ((y - y2) * (y - y2)));
+    s = (((y1 - y) * dx) - ((x1 - x) * dy)) / len2;
+    return fabs (s) * sqrt (len2);
 }
 
 static int
-voronoj_check_nearest_edge (const void *p_cache, struct voronoj_triangle *tri,
-			    int which)
+voronoj_check_nearest_edge (struct voronoj_triangle *tri, int which)
 {
 /* testing if direction outside */
-    double d_1_2;
-    double d_2_3;
-    double d_3_1;
-    gaiaGeomCollPtr pt = gaiaAllocGeomColl ();
-    gaiaGeomCollPtr segm = gaiaAllocGeomColl ();
-    gaiaLinestringPtr ln = gaiaAddLinestringToGeomColl (segm, 2);
-    gaiaSetPoint (ln->Coords, 0, tri->x1, tri->y1);
-    gaiaSetPoint (ln->Coords, 1, tri->x2, tri->y2);
-    gaiaAddPointToGeomColl (pt, tri->cx, tri->cy);
-    if (p_cache != NULL)
-	gaiaGeomCollDistance_r (p_cache, segm, pt, &d_1_2);
-    else
-	gaiaGeomCollDistance (segm, pt, &d_1_2);
-    gaiaFreeGeomColl (segm);
-    segm = gaiaAllocGeomColl ();
-    ln = gaiaAddLinestringToGeomColl (segm, 2);
-    gaiaSetPoint (ln->Coords, 0, tri->x2, tri->y2);
-    gaiaSetPoint (ln->Coords, 1, tri->x3, tri->y3);
-    if (p_cache != NULL)
-	gaiaGeomCollDistance_r (p_cache, segm, pt, &d_2_3);
-    else
-	gaiaGeomCollDistance (segm, pt, &d_2_3);
-    gaiaFreeGeomColl (segm);
-    segm = gaiaAllocGeomColl ();
-    ln = gaiaAddLinestringToGeomColl (segm, 2);
-    gaiaSetPoint (ln->Coords, 0, tri->x3, tri->y3);
-    gaiaSetPoint (ln->Coords, 1, tri->x1, tri->y1);
-    if (p_cache != NULL)
-	gaiaGeomCollDistance_r (p_cache, segm, pt, &d_3_1);
-    else
-	gaiaGeomCollDistance (segm, pt, &d_3_1);
-    gaiaFreeGeomColl (segm);
-    gaiaFreeGeomColl (pt);
+    double d_1_2 =
+	voronoj_test_point (tri->x1, tri->y1, tri->x2, tri->y2, tri->cx,
+			    tri->cy);
+    double d_2_3 =
+	voronoj_test_point (tri->x2, tri->y2, tri->x3, tri->y3, tri->cx,
+			    tri->cy);
+    double d_3_1 =
+	voronoj_test_point (tri->x3, tri->y3, tri->x1, tri->y1, tri->cx,
+			    tri->cy);
 
     if (which == 12 && d_1_2 < d_2_3 && d_1_2 < d_3_1)
 	return 0;
@@ -501,7 +619,7 @@ voronoj_minmax (double x, double y, double *minx, double *miny, double *maxx,
 }
 
 static void
-voronoj_frame_point (const void *p_cache, double intercept, double slope,
+voronoj_frame_point (double intercept, double slope,
 		     struct voronoj_aux *voronoj, double cx, double cy,
 		     double mx, double my, int direct, double *x, double *y)
 {
@@ -589,8 +707,8 @@ voronoj_frame_point (const void *p_cache, double intercept, double slope,
     if (direct)
       {
 	  /* cutting the edge in two */
-	  d1 = voronoj_test_point (p_cache, cx, cy, pre_x1, pre_y1, mx, my);
-	  d2 = voronoj_test_point (p_cache, cx, cy, pre_x2, pre_y2, mx, my);
+	  d1 = voronoj_test_point (cx, cy, pre_x1, pre_y1, mx, my);
+	  d2 = voronoj_test_point (cx, cy, pre_x2, pre_y2, mx, my);
 	  if (d1 < d2)
 	    {
 		*x = pre_x1;
@@ -605,8 +723,8 @@ voronoj_frame_point (const void *p_cache, double intercept, double slope,
     else
       {
 	  /* going outside */
-	  d1 = voronoj_test_point (p_cache, cx, cy, pre_x1, pre_y1, mx, my);
-	  d2 = voronoj_test_point (p_cache, cx, cy, pre_x2, pre_y2, mx, my);
+	  d1 = voronoj_test_point (cx, cy, pre_x1, pre_y1, mx, my);
+	  d2 = voronoj_test_point (cx, cy, pre_x2, pre_y2, mx, my);
 	  if (d1 > d2)
 	    {
 		*x = pre_x1;
@@ -620,6 +738,36 @@ voronoj_frame_point (const void *p_cache, double intercept, double slope,
       }
 }
 
+static void
+voronoj_link_triangles (struct voronoj_aux *voronoj, struct delaunay_edge *e1,
+			struct delaunay_edge *e2)
+{
+/* linking two triangles sharing the same edge */
+    struct voronoj_triangle *tri1 = voronoj->array + e1->triangle;
+    struct voronoj_triangle *tri2 = voronoj->array + e2->triangle;
+    if (e1->which == 12)
+      {
+	  tri1->tri_1_2 = tri2;
+	  tri1->trace_1_2 = 1;
+      }
+    else if (e1->which == 23)
+      {
+	  tri1->tri_2_3 = tri2;
+	  tri1->trace_2_3 = 1;
+      }
+    else
+      {
+	  tri1->tri_3_1 = tri2;
+	  tri1->trace_3_1 = 1;
+      }
+    if (e2->which == 12)
+	tri2->tri_1_2 = tri1;
+    else if (e2->which == 23)
+	tri2->tri_2_3 = tri1;
+    else
+	tri2->tri_3_1 = tri1;
+}
+
 SPATIALITE_PRIVATE void *
 voronoj_build (int count, void *p_first, double extra_frame_size)
 {
@@ -634,11 +782,10 @@ voronoj_build_r (const void *p_cache, int count, void *p_first,
     gaiaPolygonPtr first = (gaiaPolygonPtr) p_first;
     struct voronoj_aux *voronoj = NULL;
     struct voronoj_triangle *triangle;
-    struct voronoj_triangle *tri2;
+    struct delaunay_edge *edges;
     gaiaPolygonPtr pg;
     gaiaRingPtr rng;
     int ind = 0;
-    int i2;
     int direct;
     double x;
     double y;
@@ -777,121 +924,37 @@ voronoj_build_r (const void *p_cache, int count, void *p_first,
     voronoj->maxy = maxy + delta;
 
 /* identifying triangles sharing the same edge */
+    edges = malloc (sizeof (struct delaunay_edge) * voronoj->count * 3);
     for (ind = 0; ind < voronoj->count; ind++)
       {
 	  triangle = voronoj->array + ind;
-	  for (i2 = ind + 1; i2 < voronoj->count; i2++)
+	  delaunay_set_edge (edges + (ind * 3), triangle->x1, triangle->y1,
+			     triangle->x2, triangle->y2, ind, 12);
+	  delaunay_set_edge (edges + (ind * 3) + 1, triangle->x2, triangle->y2,
+			     triangle->x3, triangle->y3, ind, 23);
+	  delaunay_set_edge (edges + (ind * 3) + 2, triangle->x3, triangle->y3,
+			     triangle->x1, triangle->y1, ind, 31);
+      }
+    qsort (edges, voronoj->count * 3, sizeof (struct delaunay_edge),
+	   delaunay_edge_compare);
+    ind = 0;
+    while (ind < (voronoj->count * 3) - 1)
+      {
+	  struct delaunay_edge *e1 = edges + ind;
+	  struct delaunay_edge *e2 = edges + ind + 1;
+	  if (delaunay_same_edge (e1, e2) && e1->triangle != e2->triangle)
 	    {
-		tri2 = voronoj->array + i2;
-		if (triangle->tri_1_2 == NULL && tri2->tri_1_2 == NULL)
-		  {
-		      if (voronoj_same_edge
-			  (triangle->x1, triangle->y1, triangle->x2,
-			   triangle->y2, tri2->x1, tri2->y1, tri2->x2,
-			   tri2->y2))
-			{
-			    triangle->tri_1_2 = tri2;
-			    triangle->trace_1_2 = 1;
-			    tri2->tri_1_2 = triangle;
-			}
-		  }
-		if (triangle->tri_1_2 == NULL && tri2->tri_2_3 == NULL)
-		  {
-		      if (voronoj_same_edge
-			  (triangle->x1, triangle->y1, triangle->x2,
-			   triangle->y2, tri2->x2, tri2->y2, tri2->x3,
-			   tri2->y3))
-			{
-			    triangle->tri_1_2 = tri2;
-			    triangle->trace_1_2 = 1;
-			    tri2->tri_2_3 = triangle;
-			}
-		  }
-		if (triangle->tri_1_2 == NULL && tri2->tri_3_1 == NULL)
-		  {
-		      if (voronoj_same_edge
-			  (triangle->x1, triangle->y1, triangle->x2,
-			   triangle->y2, tri2->x3, tri2->y3, tri2->x1,
-			   tri2->y1))
-			{
-			    triangle->tri_1_2 = tri2;
-			    triangle->trace_1_2 = 1;
-			    tri2->tri_3_1 = triangle;
-			}
-		  }
-		if (triangle->tri_2_3 == NULL && tri2->tri_1_2 == NULL)
-		  {
-		      if (voronoj_same_edge
-			  (triangle->x2, triangle->y2, triangle->x3,
-			   triangle->y3, tri2->x1, tri2->y1, tri2->x2,
-			   tri2->y2))
-			{
-			    triangle->tri_2_3 = tri2;
-			    triangle->trace_2_3 = 1;
-			    tri2->tri_1_2 = triangle;
-			}
-		  }
-		if (triangle->tri_2_3 == NULL && tri2->tri_2_3 == NULL)
-		  {
-		      if (voronoj_same_edge
-			  (triangle->x2, triangle->y2, triangle->x3,
-			   triangle->y3, tri2->x2, tri2->y2, tri2->x3,
-			   tri2->y3))
-			{
-			    triangle->tri_2_3 = tri2;
-			    triangle->trace_2_3 = 1;
-			    tri2->tri_2_3 = triangle;
-			}
-		  }
-		if (triangle->tri_2_3 == NULL && tri2->tri_3_1 == NULL)
-		  {
-		      if (voronoj_same_edge
-			  (triangle->x2, triangle->y2, triangle->x3,
-			   triangle->y3, tri2->x3, tri2->y3, tri2->x1,
-			   tri2->y1))
-			{
-			    triangle->tri_2_3 = tri2;
-			    triangle->trace_2_3 = 1;
-			    tri2->tri_3_1 = triangle;
-			}
-		  }
-		if (triangle->tri_3_1 == NULL && tri2->tri_1_2 == NULL)
-		  {
-		      if (voronoj_same_edge
-			  (triangle->x3, triangle->y3, triangle->x1,
-			   triangle->y1, tri2->x1, tri2->y1, tri2->x2,
-			   tri2->y2))
-			{
-			    triangle->tri_3_1 = tri2;
-			    triangle->trace_3_1 = 1;
-			    tri2->tri_1_2 = triangle;
-			}
-		  }
-		if (triangle->tri_3_1 == NULL && tri2->tri_2_3 == NULL)
-		  {
-		      if (voronoj_same_edge
-			  (triangle->x3, triangle->y3, triangle->x1,
-			   triangle->y1, tri2->x2, tri2->y2, tri2->x3,
-			   tri2->y3))
-			{
-			    triangle->tri_3_1 = tri2;
-			    triangle->trace_3_1 = 1;
-			    tri2->tri_2_3 = triangle;
-			}
-		  }
-		if (triangle->tri_3_1 == NULL && tri2->tri_3_1 == NULL)
-		  {
-		      if (voronoj_same_edge
-			  (triangle->x3, triangle->y3, triangle->x1,
-			   triangle->y1, tri2->x3, tri2->y3, tri2->x1,
-			   tri2->y1))
-			{
-			    triangle->tri_3_1 = tri2;
-			    triangle->trace_3_1 = 1;
-			    tri2->tri_3_1 = triangle;
-			}
-		  }
+		voronoj_link_triangles (voronoj, e1, e2);
+		ind += 2;
 	    }
+	  else
+	      ind++;
+      }
+    free (edges);
+
+    for (ind = 0; ind < voronoj->count; ind++)
+      {
+	  triangle = voronoj->array + ind;
 
 	  /* identifying vertices on the frame */
 	  if (triangle->tri_1_2 == NULL)
@@ -907,8 +970,8 @@ voronoj_build_r (const void *p_cache, int count, void *p_first,
 		  }
 		direct = 1;
 		if (!voronoj_internal (p_cache, triangle))
-		    direct = voronoj_check_nearest_edge (p_cache, triangle, 12);
-		voronoj_frame_point (p_cache, intercept, slope, voronoj,
+		    direct = voronoj_check_nearest_edge (triangle, 12);
+		voronoj_frame_point (intercept, slope, voronoj,
 				     triangle->cx, triangle->cy, mx, my, direct,
 				     &x, &y);
 		triangle->x_1_2 = x;
@@ -927,8 +990,8 @@ voronoj_build_r (const void *p_cache, int count, void *p_first,
 		  }
 		direct = 1;
 		if (!voronoj_internal (p_cache, triangle))
-		    direct = voronoj_check_nearest_edge (p_cache, triangle, 23);
-		voronoj_frame_point (p_cache, intercept, slope, voronoj,
+		    direct = voronoj_check_nearest_edge (triangle, 23);
+		voronoj_frame_point (intercept, slope, voronoj,
 				     triangle->cx, triangle->cy, mx, my, direct,
 				     &x, &y);
 		triangle->x_2_3 = x;
@@ -947,8 +1010,8 @@ voronoj_build_r (const void *p_cache, int count, void *p_first,
 		  }
 		direct = 1;
 		if (!voronoj_internal (p_cache, triangle))
-		    direct = voronoj_check_nearest_edge (p_cache, triangle, 31);
-		voronoj_frame_point (p_cache, intercept, slope, voronoj,
+		    direct = voronoj_check_nearest_edge (triangle, 31);
+		voronoj_frame_point (intercept, slope, voronoj,
 				     triangle->cx, triangle->cy, mx, my, direct,
 				     &x, &y);
 		triangle->x_3_1 = x;
@@ -1514,54 +1577,513 @@ concave_hull_stats (struct concave_hull_str *concave, double length)
     concave->mean = concave->mean + ((length - concave->mean) / concave->count);
 }
 
-static int
-concave_hull_filter (const void *p_cache, double x1, double y1,
-		     double x2, double y2, double x3, double y3, double limit)
+static double
+concave_hull_length (double x1, double y1, double x2, double y2)
 {
-/* filtering triangles to be inserted into the Concave Hull */
-    gaiaGeomCollPtr segm;
-    gaiaLinestringPtr ln;
-    double length;
+/* segment length (same arithmetic as GEOS) */
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    return sqrt ((dx * dx) + (dy * dy));
+}
 
-    segm = gaiaAllocGeomColl ();
-    ln = gaiaAddLinestringToGeomColl (segm, 2);
-    gaiaSetPoint (ln->Coords, 0, x1, y1);
-    gaiaSetPoint (ln->Coords, 1, x2, y2);
-    if (p_cache != NULL)
-	gaiaGeomCollLength_r (p_cache, segm, &length);
+static void
+concave_hull_copy_point (gaiaRingPtr rng, int iv, gaiaRingPtr out, int ov)
+{
+/* copying a triangle vertex */
+    double x;
+    double y;
+    double z;
+    double m;
+    if (rng->DimensionModel == GAIA_XY_Z)
+      {
+	  gaiaGetPointXYZ (rng->Coords, iv, &x, &y, &z);
+	  gaiaSetPointXYZ (out->Coords, ov, x, y, z);
+      }
+    else if (rng->DimensionModel == GAIA_XY_M)
+      {
+	  gaiaGetPointXYM (rng->Coords, iv, &x, &y, &m);
+	  gaiaSetPointXYM (out->Coords, ov, x, y, m);
+      }
+    else if (rng->DimensionModel == GAIA_XY_Z_M)
+      {
+	  gaiaGetPointXYZM (rng->Coords, iv, &x, &y, &z, &m);
+	  gaiaSetPointXYZM (out->Coords, ov, x, y, z, m);
+      }
     else
-	gaiaGeomCollLength (segm, &length);
-    gaiaFreeGeomColl (segm);
-    if (length >= limit)
-	return 0;
+      {
+	  gaiaGetPoint (rng->Coords, iv, &x, &y);
+	  gaiaSetPoint (out->Coords, ov, x, y);
+      }
+}
 
-    segm = gaiaAllocGeomColl ();
-    ln = gaiaAddLinestringToGeomColl (segm, 2);
-    gaiaSetPoint (ln->Coords, 0, x2, y2);
-    gaiaSetPoint (ln->Coords, 1, x3, y3);
-    if (p_cache != NULL)
-	gaiaGeomCollLength_r (p_cache, segm, &length);
-    else
-	gaiaGeomCollLength (segm, &length);
-    gaiaFreeGeomColl (segm);
-    if (length >= limit)
-	return 0;
+static gaiaGeomCollPtr
+concave_hull_alloc (int dimension_model)
+{
+/* allocating an empty Geometry */
+    if (dimension_model == GAIA_XY_Z)
+	return gaiaAllocGeomCollXYZ ();
+    if (dimension_model == GAIA_XY_M)
+	return gaiaAllocGeomCollXYM ();
+    if (dimension_model == GAIA_XY_Z_M)
+	return gaiaAllocGeomCollXYZM ();
+    return gaiaAllocGeomColl ();
+}
 
-    segm = gaiaAllocGeomColl ();
-    ln = gaiaAddLinestringToGeomColl (segm, 2);
-    gaiaSetPoint (ln->Coords, 0, x3, y3);
-    gaiaSetPoint (ln->Coords, 1, x1, y1);
-    if (p_cache != NULL)
-	gaiaGeomCollLength_r (p_cache, segm, &length);
-    else
-	gaiaGeomCollLength (segm, &length);
-    gaiaFreeGeomColl (segm);
-    if (length >= limit)
-	return 0;
+#define CONCAVE_HULL_2PI	6.2831853071795864769
+
+struct concave_hull_edge
+{
+/* an auxiliary struct - oriented boundary edge of the Concave Hull */
+    double x1;			/* start vertex */
+    double y1;
+    double x2;			/* end vertex */
+    double y2;
+    int triangle;		/* triangle index */
+    int vertex;			/* triangle index of the start vertex */
+    int node_start;		/* first edge starting from the start vertex */
+    int node_end;		/* first edge starting from the end vertex */
+    int visited;		/* flag: already assigned to some ring */
+};
+
+struct concave_hull_ring
+{
+/* an auxiliary struct - ring of the Concave Hull */
+    int first;			/* index of the first edge (ring ordered) */
+    int count;			/* number of edges */
+    double area;		/* signed area: > 0 shell, < 0 hole */
+    int shell;			/* holes only: index of the enclosing shell */
+    int n_holes;		/* shells only: number of holes */
+    gaiaPolygonPtr polygon;	/* shells only: the output Polygon */
+};
+
+static int
+concave_hull_edge_compare (const void *p1, const void *p2)
+{
+/* comparison function for QSORT - oriented edges */
+    const struct concave_hull_edge *e1 = (const struct concave_hull_edge *) p1;
+    const struct concave_hull_edge *e2 = (const struct concave_hull_edge *) p2;
+    if (e1->x1 != e2->x1)
+	return (e1->x1 < e2->x1) ? -1 : 1;
+    if (e1->y1 != e2->y1)
+	return (e1->y1 < e2->y1) ? -1 : 1;
+    if (e1->x2 != e2->x2)
+	return (e1->x2 < e2->x2) ? -1 : 1;
+    if (e1->y2 != e2->y2)
+	return (e1->y2 < e2->y2) ? -1 : 1;
+    return 0;
+}
+
+static int
+concave_hull_find_edge (struct concave_hull_edge *edges, int count, double x,
+			double y)
+{
+/* searching the first edge starting from the given vertex */
+    int lo = 0;
+    int hi = count;
+    while (lo < hi)
+      {
+	  int mid = (lo + hi) / 2;
+	  struct concave_hull_edge *edge = edges + mid;
+	  if (edge->x1 < x || (edge->x1 == x && edge->y1 < y))
+	      lo = mid + 1;
+	  else
+	      hi = mid;
+      }
+    if (lo < count && edges[lo].x1 == x && edges[lo].y1 == y)
+	return lo;
+    return -1;
+}
+
+static int
+concave_hull_next_edge (struct concave_hull_edge *edges, int count,
+			struct concave_hull_edge *edge)
+{
+/*
+/ searching the edge following the current one along the boundary
+/
+/ when two or more edges start from the same vertex (i.e. the
+/ Concave Hull touches itself) the one immediately following
+/ in clockwise order is choosen, so to always keep the interior
+/ on the left side
+*/
+    int ind;
+    int best = -1;
+    double best_angle = 0.0;
+    double back;
+    double angle;
+    int first = edge->node_end;
+    if (first + 1 >= count || edges[first + 1].x1 != edge->x2
+	|| edges[first + 1].y1 != edge->y2)
+	return first;
+
+    back = atan2 (edge->y1 - edge->y2, edge->x1 - edge->x2);
+    for (ind = first; ind < count; ind++)
+      {
+	  struct concave_hull_edge *next = edges + ind;
+	  if (next->x1 != edge->x2 || next->y1 != edge->y2)
+	      break;
+	  angle = back - atan2 (next->y2 - next->y1, next->x2 - next->x1);
+	  while (angle <= 0.0)
+	      angle += CONCAVE_HULL_2PI;
+	  while (angle > CONCAVE_HULL_2PI)
+	      angle -= CONCAVE_HULL_2PI;
+	  if (best < 0 || angle < best_angle)
+	    {
+		best = ind;
+		best_angle = angle;
+	    }
+      }
+    return best;
+}
 
+static int
+concave_hull_component (int *parent, int ind)
+{
+/* returning the connected component of some triangle (Union-Find) */
+    while (parent[ind] != ind)
+      {
+	  parent[ind] = parent[parent[ind]];
+	  ind = parent[ind];
+      }
+    return ind;
+}
+
+static int
+concave_hull_add_ring (struct concave_hull_edge *edges, int *stack, int count,
+		       int *order, int *n_order, struct concave_hull_ring *ring)
+{
+/* adding a closed ring */
+    int ind;
+    ring->first = *n_order;
+    ring->count = count;
+    ring->area = 0.0;
+    ring->shell = -1;
+    ring->n_holes = 0;
+    ring->polygon = NULL;
+    for (ind = 0; ind < count; ind++)
+      {
+	  struct concave_hull_edge *edge = edges + stack[ind];
+	  order[*n_order] = stack[ind];
+	  *n_order += 1;
+	  ring->area += (edge->x1 * edge->y2) - (edge->x2 * edge->y1);
+      }
+    if (count < 3 || ring->area == 0.0)
+	return 0;
     return 1;
 }
 
+static gaiaGeomCollPtr
+concave_hull_from_edges (struct concave_hull_triangle *triangles, int count,
+			 int dimension_model)
+{
+/*
+/ the Concave Hull is the union of all selected triangles: its boundary
+/ simply is the set of all edges belonging to a single selected triangle,
+/ so the rings can be directly assembled without computing any Union
+/
+/ returns NULL on any unexpected condition (ambiguous orientation, non
+/ manifold boundary and alike); the caller will then fall back to Union
+*/
+    struct delaunay_edge *all_edges = NULL;
+    struct concave_hull_edge *edges = NULL;
+    struct concave_hull_ring *rings = NULL;
+    struct concave_hull_triangle *tri;
+    struct concave_hull_edge *edge;
+    struct concave_hull_ring *ring;
+    struct concave_hull_ring *shell;
+    gaiaGeomCollPtr result = NULL;
+    gaiaRingPtr rng;
+    gaiaRingPtr rng_out;
+    int *order = NULL;
+    int *path = NULL;
+    int *stack = NULL;
+    int *position = NULL;
+    int *component = NULL;
+    int *component_shell = NULL;
+    int n_all = 0;
+    int n_edges = 0;
+    int n_rings = 0;
+    int n_order = 0;
+    int n_path;
+    int n_stack;
+    int ind;
+    int i2;
+    int cur;
+    int orientation;
+
+/* collecting all edges of the selected triangles */
+    all_edges = malloc (sizeof (struct delaunay_edge) * count * 3);
+    for (ind = 0; ind < count; ind++)
+      {
+	  tri = triangles + ind;
+	  if (!tri->selected)
+	      continue;
+	  delaunay_set_edge (all_edges + n_all++, tri->x1, tri->y1, tri->x2,
+			     tri->y2, ind, 12);
+	  delaunay_set_edge (all_edges + n_all++, tri->x2, tri->y2, tri->x3,
+			     tri->y3, ind, 23);
+	  delaunay_set_edge (all_edges + n_all++, tri->x3, tri->y3, tri->x1,
+			     tri->y1, ind, 31);
+      }
+    qsort (all_edges, n_all, sizeof (struct delaunay_edge),
+	   delaunay_edge_compare);
+
+/* extracting the boundary edges (oriented CCW) */
+    component = malloc (sizeof (int) * count);
+    for (ind = 0; ind < count; ind++)
+	component[ind] = ind;
+    edges = malloc (sizeof (struct concave_hull_edge) * n_all);
+    ind = 0;
+    while (ind < n_all)
+      {
+	  struct delaunay_edge *de = all_edges + ind;
+	  int shared = 1;
+	  int iv1;
+	  int iv2;
+	  for (i2 = ind + 1; i2 < n_all; i2++)
+	    {
+		if (!delaunay_same_edge (de, all_edges + i2))
+		    break;
+		shared++;
+	    }
+	  ind += shared;
+	  if (shared > 2)
+	      goto error;	/* not a regular triangulation */
+	  if (shared == 2)
+	    {
+		/* merging the connected components of both triangles */
+		int c1 = concave_hull_component (component, de->triangle);
+		int c2 = concave_hull_component (component, (de + 1)->triangle);
+		component[c1] = c2;
+		continue;
+	    }
+	  /* boundary edge */
+	  tri = triangles + de->triangle;
+	  if (!delaunay_orientation
+	      (tri->x1, tri->y1, tri->x2, tri->y2, tri->x3, tri->y3,
+	       &orientation))
+	      goto error;
+	  if (orientation == 0)
+	      goto error;
+	  if (de->which == 12)
+	    {
+		iv1 = 0;
+		iv2 = 1;
+	    }
+	  else if (de->which == 23)
+	    {
+		iv1 = 1;
+		iv2 = 2;
+	    }
+	  else
+	    {
+		iv1 = 2;
+		iv2 = 0;
+	    }
+	  if (orientation < 0)
+	    {
+		/* clockwise triangle: reversing the edge */
+		int swap = iv1;
+		iv1 = iv2;
+		iv2 = swap;
+	    }
+	  edge = edges + n_edges++;
+	  edge->x1 = (iv1 == 0) ? tri->x1 : ((iv1 == 1) ? tri->x2 : tri->x3);
+	  edge->y1 = (iv1 == 0) ? tri->y1 : ((iv1 == 1) ? tri->y2 : tri->y3);
+	  edge->x2 = (iv2 == 0) ? tri->x1 : ((iv2 == 1) ? tri->x2 : tri->x3);
+	  edge->y2 = (iv2 == 0) ? tri->y1 : ((iv2 == 1) ? tri->y2 : tri->y3);
+	  edge->triangle = de->triangle;
+	  edge->vertex = iv1;
+	  edge->visited = 0;
+      }
+    free (all_edges);
+    all_edges = NULL;
+    if (n_edges == 0)
+	goto error;
+    qsort (edges, n_edges, sizeof (struct concave_hull_edge),
+	   concave_hull_edge_compare);
+
+    for (ind = 0; ind < n_edges; ind++)
+      {
+	  /* identifying the vertices */
+	  edge = edges + ind;
+	  if (ind > 0 && edge->x1 == edges[ind - 1].x1
+	      && edge->y1 == edges[ind - 1].y1)
+	      edge->node_start = edges[ind - 1].node_start;
+	  else
+	      edge->node_start = ind;
+      }
+    for (ind = 0; ind < n_edges; ind++)
+      {
+	  edge = edges + ind;
+	  edge->node_end =
+	      concave_hull_find_edge (edges, n_edges, edge->x2, edge->y2);
+	  if (edge->node_end < 0)
+	      goto error;	/* unclosed boundary */
+      }
+
+/* assembling the rings */
+    order = malloc (sizeof (int) * n_edges);
+    path = malloc (sizeof (int) * n_edges);
+    stack = malloc (sizeof (int) * n_edges);
+    position = malloc (sizeof (int) * n_edges);
+    for (ind = 0; ind < n_edges; ind++)
+	position[ind] = -1;
+    rings = malloc (sizeof (struct concave_hull_ring) * n_edges);
+    for (ind = 0; ind < n_edges; ind++)
+      {
+	  if (edges[ind].visited)
+	      continue;
+	  /* following the boundary until it closes */
+	  n_path = 0;
+	  cur = ind;
+	  while (1)
+	    {
+		edge = edges + cur;
+		edge->visited = 1;
+		path[n_path++] = cur;
+		cur = concave_hull_next_edge (edges, n_edges, edge);
+		if (cur < 0)
+		    goto error;
+		if (cur == ind)
+		    break;
+		if (edges[cur].visited)
+		    goto error;
+	    }
+	  /* splitting the path into simple rings at any repeated vertex */
+	  n_stack = 0;
+	  for (i2 = 0; i2 < n_path; i2++)
+	    {
+		edge = edges + path[i2];
+		position[edge->node_start] = n_stack;
+		stack[n_stack++] = path[i2];
+		cur = position[edge->node_end];
+		if (cur < 0)
+		    continue;
+		if (!concave_hull_add_ring
+		    (edges, stack + cur, n_stack - cur, order, &n_order,
+		     rings + n_rings))
+		    goto error;
+		n_rings++;
+		while (n_stack > cur)
+		  {
+		      n_stack--;
+		      position[edges[stack[n_stack]].node_start] = -1;
+		  }
+	    }
+	  if (n_stack != 0)
+	      goto error;
+      }
+    free (path);
+    path = NULL;
+    free (stack);
+    stack = NULL;
+    free (position);
+    position = NULL;
+
+/*
+/ assigning each hole to its enclosing shell: any connected set of
+/ triangles has exactly one shell, and any hole is enclosed by the
+/ shell of the triangles it's adjacent to
+*/
+    component_shell = malloc (sizeof (int) * count);
+    for (ind = 0; ind < count; ind++)
+	component_shell[ind] = -1;
+    for (ind = 0; ind < n_rings; ind++)
+      {
+	  ring = rings + ind;
+	  if (ring->area < 0.0)
+	      continue;
+	  edge = edges + order[ring->first];
+	  cur = concave_hull_component (component, edge->triangle);
+	  if (component_shell[cur] >= 0)
+	      goto error;
+	  component_shell[cur] = ind;
+      }
+    for (ind = 0; ind < n_rings; ind++)
+      {
+	  ring = rings + ind;
+	  if (ring->area > 0.0)
+	      continue;
+	  edge = edges + order[ring->first];
+	  cur = concave_hull_component (component, edge->triangle);
+	  ring->shell = component_shell[cur];
+	  if (ring->shell < 0)
+	      goto error;
+	  rings[ring->shell].n_holes += 1;
+      }
+    free (component);
+    component = NULL;
+    free (component_shell);
+    component_shell = NULL;
+
+/* creating the Geometry representing the Concave Hull */
+    result = concave_hull_alloc (dimension_model);
+    for (ind = 0; ind < n_rings; ind++)
+      {
+	  ring = rings + ind;
+	  if (ring->area < 0.0)
+	      continue;
+	  ring->polygon =
+	      gaiaAddPolygonToGeomColl (result, ring->count + 1, ring->n_holes);
+	  ring->n_holes = 0;
+	  rng_out = ring->polygon->Exterior;
+	  for (i2 = 0; i2 < ring->count; i2++)
+	    {
+		edge = edges + order[ring->first + i2];
+		rng = (triangles + edge->triangle)->polygon->Exterior;
+		concave_hull_copy_point (rng, edge->vertex, rng_out, i2);
+	    }
+	  edge = edges + order[ring->first];
+	  rng = (triangles + edge->triangle)->polygon->Exterior;
+	  concave_hull_copy_point (rng, edge->vertex, rng_out, ring->count);
+      }
+    for (ind = 0; ind < n_rings; ind++)
+      {
+	  ring = rings + ind;
+	  if (ring->area > 0.0)
+	      continue;
+	  shell = rings + ring->shell;
+	  rng_out =
+	      gaiaAddInteriorRing (shell->polygon, shell->n_holes++,
+				   ring->count + 1);
+	  for (i2 = 0; i2 < ring->count; i2++)
+	    {
+		edge = edges + order[ring->first + i2];
+		rng = (triangles + edge->triangle)->polygon->Exterior;
+		concave_hull_copy_point (rng, edge->vertex, rng_out, i2);
+	    }
+	  edge = edges + order[ring->first];
+	  rng = (triangles + edge->triangle)->polygon->Exterior;
+	  concave_hull_copy_point (rng, edge->vertex, rng_out, ring->count);
+      }
+    free (edges);
+    free (order);
+    free (rings);
+    return result;
+
+  error:
+    if (all_edges != NULL)
+	free (all_edges);
+    if (edges != NULL)
+	free (edges);
+    if (order != NULL)
+	free (order);
+    if (rings != NULL)
+	free (rings);
+    if (path != NULL)
+	free (path);
+    if (stack != NULL)
+	free (stack);
+    if (position != NULL)
+	free (position);
+    if (component != NULL)
+	free (component);
+    if (component_shell != NULL)
+	free (component_shell);
+    return NULL;
+}
+
 static gaiaGeomCollPtr
 concave_hull_no_holes (gaiaGeomCollPtr in)
 {
@@ -1628,6 +2150,8 @@ concave_hull_build_common (const void *p_cache, void *p_first,
 {
 /* building the Concave Hull */
     struct concave_hull_str concave;
+    struct concave_hull_triangle *triangles;
+    struct concave_hull_triangle *tri;
     gaiaPolygonPtr first = (gaiaPolygonPtr) p_first;
     gaiaPolygonPtr pg;
     gaiaRingPtr rng;
@@ -1635,19 +2159,15 @@ concave_hull_build_common (const void *p_cache, void *p_first,
     gaiaRingPtr rng_out;
     gaiaGeomCollPtr segm;
     gaiaGeomCollPtr result;
-    gaiaLinestringPtr ln;
     double x;
     double y;
     double z;
     double m;
-    double x1;
-    double y1;
-    double x2;
-    double y2;
-    double x3;
-    double y3;
-    double length;
+    double limit;
     double std_dev;
+    int n_triangles = 0;
+    int ind;
+    int iv;
     int count;
 
 /* initializing the struct for mean and standard deviation */
@@ -1655,227 +2175,152 @@ concave_hull_build_common (const void *p_cache, void *p_first,
     concave.quot = 0.0;
     concave.count = 0.0;
 
+/* building the triangles array */
+    pg = first;
+    while (pg)
+      {
+	  n_triangles++;
+	  pg = pg->Next;
+      }
+    if (n_triangles == 0)
+	return NULL;
+    triangles = malloc (sizeof (struct concave_hull_triangle) * n_triangles);
+    ind = 0;
     pg = first;
     while (pg)
       {
 	  /* examining each triangle / computing statistics distribution */
+	  tri = triangles + ind++;
 	  rng = pg->Exterior;
 	  if (pg->DimensionModel == GAIA_XY_Z)
 	    {
 		gaiaGetPointXYZ (rng->Coords, 0, &x, &y, &z);
-		x1 = x;
-		y1 = y;
+		tri->x1 = x;
+		tri->y1 = y;
 		gaiaGetPointXYZ (rng->Coords, 1, &x, &y, &z);
-		x2 = x;
-		y2 = y;
+		tri->x2 = x;
+		tri->y2 = y;
 		gaiaGetPointXYZ (rng->Coords, 2, &x, &y, &z);
-		x3 = x;
-		y3 = y;
+		tri->x3 = x;
+		tri->y3 = y;
 	    }
 	  else if (pg->DimensionModel == GAIA_XY_M)
 	    {
 		gaiaGetPointXYM (rng->Coords, 0, &x, &y, &m);
-		x1 = x;
-		y1 = y;
+		tri->x1 = x;
+		tri->y1 = y;
 		gaiaGetPointXYM (rng->Coords, 1, &x, &y, &m);
-		x2 = x;
-		y2 = y;
+		tri->x2 = x;
+		tri->y2 = y;
 		gaiaGetPointXYM (rng->Coords, 2, &x, &y, &m);
-		x3 = x;
-		y3 = y;
+		tri->x3 = x;
+		tri->y3 = y;
 	    }
 	  else if (pg->DimensionModel == GAIA_XY_Z_M)
 	    {
 		gaiaGetPointXYZM (rng->Coords, 0, &x, &y, &z, &m);
-		x1 = x;
-		y1 = y;
+		tri->x1 = x;
+		tri->y1 = y;
 		gaiaGetPointXYZM (rng->Coords, 1, &x, &y, &z, &m);
-		x2 = x;
-		y2 = y;
+		tri->x2 = x;
+		tri->y2 = y;
 		gaiaGetPointXYZM (rng->Coords, 2, &x, &y, &z, &m);
-		x3 = x;
-		y3 = y;
+		tri->x3 = x;
+		tri->y3 = y;
 	    }
 	  else
 	    {
 		gaiaGetPoint (rng->Coords, 0, &x, &y);
-		x1 = x;
-		y1 = y;
+		tri->x1 = x;
+		tri->y1 = y;
 		gaiaGetPoint (rng->Coords, 1, &x, &y);
-		x2 = x;
-		y2 = y;
+		tri->x2 = x;
+		tri->y2 = y;
 		gaiaGetPoint (rng->Coords, 2, &x, &y);
-		x3 = x;
-		y3 = y;
+		tri->x3 = x;
+		tri->y3 = y;
 	    }
-
-	  segm = gaiaAllocGeomColl ();
-	  ln = gaiaAddLinestringToGeomColl (segm, 2);
-	  gaiaSetPoint (ln->Coords, 0, x1, y1);
-	  gaiaSetPoint (ln->Coords, 1, x2, y2);
-	  if (p_cache != NULL)
-	      gaiaGeomCollLength_r (p_cache, segm, &length);
-	  else
-	      gaiaGeomCollLength (segm, &length);
-	  gaiaFreeGeomColl (segm);
-	  concave_hull_stats (&concave, length);
-
-	  segm = gaiaAllocGeomColl ();
-	  ln = gaiaAddLinestringToGeomColl (segm, 2);
-	  gaiaSetPoint (ln->Coords, 0, x2, y2);
-	  gaiaSetPoint (ln->Coords, 1, x3, y3);
-	  if (p_cache != NULL)
-	      gaiaGeomCollLength_r (p_cache, segm, &length);
-	  else
-	      gaiaGeomCollLength (segm, &length);
-	  gaiaFreeGeomColl (segm);
-	  concave_hull_stats (&concave, length);
-
-	  segm = gaiaAllocGeomColl ();
-	  ln = gaiaAddLinestringToGeomColl (segm, 2);
-	  gaiaSetPoint (ln->Coords, 0, x3, y3);
-	  gaiaSetPoint (ln->Coords, 1, x1, y1);
-	  if (p_cache != NULL)
-	      gaiaGeomCollLength_r (p_cache, segm, &length);
-	  else
-	      gaiaGeomCollLength (segm, &length);
-	  gaiaFreeGeomColl (segm);
-	  concave_hull_stats (&concave, length);
-
+	  tri->length_1_2 = concave_hull_length (tri->x1, tri->y1, tri->x2,
+						 tri->y2);
+	  tri->length_2_3 = concave_hull_length (tri->x2, tri->y2, tri->x3,
+						 tri->y3);
+	  tri->length_3_1 = concave_hull_length (tri->x3, tri->y3, tri->x1,
+						 tri->y1);
+	  tri->polygon = pg;
+	  tri->selected = 0;
+	  concave_hull_stats (&concave, tri->length_1_2);
+	  concave_hull_stats (&concave, tri->length_2_3);
+	  concave_hull_stats (&concave, tri->length_3_1);
 	  pg = pg->Next;
       }
 
     std_dev = sqrt (concave.quot / concave.count);
 
-/* creating the Geometry representing the Concave Hull */
-    if (dimension_model == GAIA_XY_Z)
-	result = gaiaAllocGeomCollXYZ ();
-    else if (dimension_model == GAIA_XY_M)
-	result = gaiaAllocGeomCollXYM ();
-    else if (dimension_model == GAIA_XY_Z_M)
-	result = gaiaAllocGeomCollXYZM ();
-    else
-	result = gaiaAllocGeomColl ();
-
+/* selecting triangles to be inserted into the Concave Hull */
+    limit = std_dev * factor;
     count = 0;
-    pg = first;
-    while (pg)
+    for (ind = 0; ind < n_triangles; ind++)
       {
-	  /* selecting triangles to be inserted */
-	  rng = pg->Exterior;
-	  if (pg->DimensionModel == GAIA_XY_Z)
-	    {
-		gaiaGetPointXYZ (rng->Coords, 0, &x, &y, &z);
-		x1 = x;
-		y1 = y;
-		gaiaGetPointXYZ (rng->Coords, 1, &x, &y, &z);
-		x2 = x;
-		y2 = y;
-		gaiaGetPointXYZ (rng->Coords, 2, &x, &y, &z);
-		x3 = x;
-		y3 = y;
-	    }
-	  else if (pg->DimensionModel == GAIA_XY_M)
+	  tri = triangles + ind;
+	  if (tri->length_1_2 < limit && tri->length_2_3 < limit
+	      && tri->length_3_1 < limit)
 	    {
-		gaiaGetPointXYM (rng->Coords, 0, &x, &y, &m);
-		x1 = x;
-		y1 = y;
-		gaiaGetPointXYM (rng->Coords, 1, &x, &y, &m);
-		x2 = x;
-		y2 = y;
-		gaiaGetPointXYM (rng->Coords, 2, &x, &y, &m);
-		x3 = x;
-		y3 = y;
-	    }
-	  else if (pg->DimensionModel == GAIA_XY_Z_M)
-	    {
-		gaiaGetPointXYZM (rng->Coords, 0, &x, &y, &z, &m);
-		x1 = x;
-		y1 = y;
-		gaiaGetPointXYZM (rng->Coords, 1, &x, &y, &z, &m);
-		x2 = x;
-		y2 = y;
-		gaiaGetPointXYZM (rng->Coords, 2, &x, &y, &z, &m);
-		x3 = x;
-		y3 = y;
-	    }
-	  else
-	    {
-		gaiaGetPoint (rng->Coords, 0, &x, &y);
-		x1 = x;
-		y1 = y;
-		gaiaGetPoint (rng->Coords, 1, &x, &y);
-		x2 = x;
-		y2 = y;
-		gaiaGetPoint (rng->Coords, 2, &x, &y);
-		x3 = x;
-		y3 = y;
+		tri->selected = 1;
+		count++;
 	    }
+      }
+    if (count == 0)
+      {
+	  free (triangles);
+	  return NULL;
+      }
 
-	  if (concave_hull_filter
-	      (p_cache, x1, y1, x2, y2, x3, y3, std_dev * factor))
+/* directly building the Concave Hull from its boundary edges */
+    result = concave_hull_from_edges (triangles, n_triangles, dimension_model);
+    if (result != NULL)
+      {
+	  free (triangles);
+	  goto done;
+      }
+
+/* creating the Geometry representing the Concave Hull */
+    segm = concave_hull_alloc (dimension_model);
+    for (ind = 0; ind < n_triangles; ind++)
+      {
+	  tri = triangles + ind;
+	  if (!tri->selected)
+	      continue;
+	  /* inserting this triangle into the Concave Hull */
+	  rng = tri->polygon->Exterior;
+	  pg_out = gaiaAddPolygonToGeomColl (segm, 4, 0);
+	  rng_out = pg_out->Exterior;
+	  for (iv = 0; iv < 4; iv++)
 	    {
-		/* inserting this triangle into the Concave Hull */
-		pg_out = gaiaAddPolygonToGeomColl (result, 4, 0);
-		rng_out = pg_out->Exterior;
-		if (pg->DimensionModel == GAIA_XY_Z)
+		if (rng->DimensionModel == GAIA_XY_Z)
 		  {
-		      gaiaGetPointXYZ (rng->Coords, 0, &x, &y, &z);
-		      gaiaSetPointXYZ (rng_out->Coords, 0, x, y, z);
-		      gaiaGetPointXYZ (rng->Coords, 1, &x, &y, &z);
-		      gaiaSetPointXYZ (rng_out->Coords, 1, x, y, z);
-		      gaiaGetPointXYZ (rng->Coords, 2, &x, &y, &z);
-		      gaiaSetPointXYZ (rng_out->Coords, 2, x, y, z);
-		      gaiaGetPointXYZ (rng->Coords, 3, &x, &y, &z);
-		      gaiaSetPointXYZ (rng_out->Coords, 3, x, y, z);
+		      gaiaGetPointXYZ (rng->Coords, iv, &x, &y, &z);
+		      gaiaSetPointXYZ (rng_out->Coords, iv, x, y, z);
 		  }
-		else if (pg->DimensionModel == GAIA_XY_M)
+		else if (rng->DimensionModel == GAIA_XY_M)
 		  {
-		      gaiaGetPointXYM (rng->Coords, 0, &x, &y, &m);
-		      gaiaSetPointXYM (rng_out->Coords, 0, x, y, m);
-		      gaiaGetPointXYM (rng->Coords, 1, &x, &y, &m);
-		      gaiaSetPointXYM (rng_out->Coords, 1, x, y, m);
-		      gaiaGetPointXYM (rng->Coords, 2, &x, &y, &m);
-		      gaiaSetPointXYM (rng_out->Coords, 2, x, y, m);
-		      gaiaGetPointXYM (rng->Coords, 3, &x, &y, &m);
-		      gaiaSetPointXYM (rng_out->Coords, 3, x, y, m);
+		      gaiaGetPointXYM (rng->Coords, iv, &x, &y, &m);
+		      gaiaSetPointXYM (rng_out->Coords, iv, x, y, m);
 		  }
-		else if (pg->DimensionModel == GAIA_XY_Z_M)
+		else if (rng->DimensionModel == GAIA_XY_Z_M)
 		  {
-		      gaiaGetPointXYZM (rng->Coords, 0, &x, &y, &z, &m);
-		      gaiaSetPointXYZM (rng_out->Coords, 0, x, y, z, m);
-		      gaiaGetPointXYZM (rng->Coords, 1, &x, &y, &z, &m);
-		      gaiaSetPointXYZM (rng_out->Coords, 1, x, y, z, m);
-		      gaiaGetPointXYZM (rng->Coords, 2, &x, &y, &z, &m);
-		      gaiaSetPointXYZM (rng_out->Coords, 2, x, y, z, m);
-		      gaiaGetPointXYZM (rng->Coords, 3, &x, &y, &z, &m);
-		      gaiaSetPointXYZM (rng_out->Coords, 3, x, y, z, m);
+		      gaiaGetPointXYZM (rng->Coords, iv, &x, &y, &z, &m);
+		      gaiaSetPointXYZM (rng_out->Coords, iv, x, y, z, m);
 		  }
 		else
 		  {
-		      gaiaGetPoint (rng->Coords, 0, &x, &y);
-		      gaiaSetPoint (rng_out->Coords, 0, x, y);
-		      gaiaGetPoint (rng->Coords, 1, &x, &y);
-		      gaiaSetPoint (rng_out->Coords, 1, x, y);
-		      gaiaGetPoint (rng->Coords, 2, &x, &y);
-		      gaiaSetPoint (rng_out->Coords, 2, x, y);
-		      gaiaGetPoint (rng->Coords, 3, &x, &y);
-		      gaiaSetPoint (rng_out->Coords, 3, x, y);
+		      gaiaGetPoint (rng->Coords, iv, &x, &y);
+		      gaiaSetPoint (rng_out->Coords, iv, x, y);
 		  }
-		count++;
 	    }
-
-	  pg = pg->Next;
-      }
-
-    if (count == 0)
-      {
-	  gaiaFreeGeomColl (result);
-	  return NULL;
       }
+    free (triangles);
 
 /* merging all triangles into the Concave Hull */
-    segm = result;
     if (p_cache != NULL)
 	result = gaiaUnaryUnion_r (p_cache, segm);
     else
@@ -1888,6 +2333,8 @@ concave_hull_build_common (const void *p_cache, void *p_first,
 	  gaiaFreeGeomColl (result);
 	  return NULL;
       }
+
+  done:
     if (allow_holes)
 	return result;
 
@@ -48,6 +48,7 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include <stdio.h>
 #include <float.h>
 #include <string.h>
+#include <math.h>
 
 #if defined(_WIN32) && !defined(__MINGW32__)
 #include "config-msvc.h"
@@ -1148,6 +1149,394 @@ doParseTinyPointBlob (const unsigned char *blob, unsigned int size)
     return geo;
 }
 
+/*
+/ TWKB compressed BLOB-Geometries
+/
+/ the usual BLOB header (START, endian, SRID, MBR, MBR-end and CLASS)
+/ is followed by a TWKB payload: all coordinates are rounded to the
+/ declared precision and stored as zigzag/varint integer deltas
+*/
+
+struct twkb_reader
+{
+/* helper struct: parsing a TWKB payload */
+    const unsigned char *ptr;
+    const unsigned char *end;
+    int error;
+    int has_z;
+    int has_m;
+    int prec_xy;
+    double factor_xy;
+    double factor_z;
+    double factor_m;
+    sqlite3_int64 last[4];
+};
+
+static double
+twkb_power10 (int digits)
+{
+/* returns 10 raised to 0 - 7 */
+    static const double powers[8] =
+	{ 1.0, 10.0, 100.0, 1000.0, 10000.0, 100000.0, 1000000.0,
+	10000000.0
+    };
+    if (digits < 0 || digits > 7)
+	return 1.0;
+    return powers[digits];
+}
+
+static sqlite3_uint64
+twkb_read_uvarint (struct twkb_reader *rd)
+{
+/* reading an unsigned varint */
+    sqlite3_uint64 value = 0;
+    int shift = 0;
+    while (rd->ptr < rd->end && shift < 64)
+      {
+	  unsigned char byte = *(rd->ptr++);
+	  value |= (sqlite3_uint64) (byte & 0x7f) << shift;
+	  if ((byte & 0x80) == 0)
+	      return value;
+	  shift += 7;
+      }
+    rd->error = 1;
+    return 0;
+}
+
+static sqlite3_int64
+twkb_read_svarint (struct twkb_reader *rd)
+{
+/* reading a zigzag encoded signed varint */
+    sqlite3_uint64 value = twkb_read_uvarint (rd);
+    return (sqlite3_int64) (value >> 1) ^ -(sqlite3_int64) (value & 1);
+}
+
+static int
+twkb_read_count (struct twkb_reader *rd, int min_bytes)
+{
+/* reading an items count; each item requires at least min_bytes */
+    sqlite3_uint64 count = twkb_read_uvarint (rd);
+    if (rd->error)
+	return -1;
+    if (count > (sqlite3_uint64) ((rd->end - rd->ptr) / min_bytes))
+      {
+	  /* cannot possibly fit into the payload */
+	  rd->error = 1;
+	  return -1;
+      }
+    return (int) count;
+}
+
+static void
+twkb_read_coords (struct twkb_reader *rd, double *x, double *y, double *z,
+		  double *m)
+{
+/* reading a single vertex */
+    rd->last[0] += twkb_read_svarint (rd);
+    rd->last[1] += twkb_read_svarint (rd);
+    if (rd->prec_xy >= 0)
+      {
+	  *x = (double) (rd->last[0]) / rd->factor_xy;
+	  *y = (double) (rd->last[1]) / rd->factor_xy;
+      }
+    else
+      {
+	  *x = (double) (rd->last[0]) * rd->factor_xy;
+	  *y = (double) (rd->last[1]) * rd->factor_xy;
+      }
+    *z = 0.0;
+    *m = 0.0;
+    if (rd->has_z)
+      {
+	  rd->last[2] += twkb_read_svarint (rd);
+	  *z = (double) (rd->last[2]) / rd->factor_z;
+      }
+    if (rd->has_m)
+      {
+	  rd->last[3] += twkb_read_svarint (rd);
+	  *m = (double) (rd->last[3]) / rd->factor_m;
+      }
+}
+
+static void
+twkb_set_vertex (double *coords, int iv, int dims, double x, double y,
+		 double z, double m)
+{
+/* setting a vertex accordingly to the Dimension Model */
+    switch (dims)
+      {
+      case GAIA_XY_Z:
+	  gaiaSetPointXYZ (coords, iv, x, y, z);
+	  break;
+      case GAIA_XY_M:
+	  gaiaSetPointXYM (coords, iv, x, y, m);
+	  break;
+      case GAIA_XY_Z_M:
+	  gaiaSetPointXYZM (coords, iv, x, y, z, m);
+	  break;
+      default:
+	  gaiaSetPoint (coords, iv, x, y);
+	  break;
+      };
+}
+
+static int
+twkb_read_header (struct twkb_reader *rd, int *type, int *empty,
+		  int *has_idlist)
+{
+/* parsing the TWKB header */
+    unsigned char type_prec;
+    unsigned char meta;
+    unsigned char zigzag;
+    int prec_z = 0;
+    int prec_m = 0;
+    int ic;
+    int dims;
+    if (rd->end - rd->ptr < 2)
+	return 0;
+    type_prec = *(rd->ptr++);
+    meta = *(rd->ptr++);
+    *type = type_prec & 0x0f;
+    zigzag = (type_prec >> 4) & 0x0f;
+    rd->prec_xy = (zigzag >> 1) ^ -(zigzag & 1);
+    rd->has_z = 0;
+    rd->has_m = 0;
+    if (meta & 0x08)
+      {
+	  /* extended dimensions */
+	  unsigned char ext;
+	  if (rd->ptr >= rd->end)
+	      return 0;
+	  ext = *(rd->ptr++);
+	  rd->has_z = ext & 0x01;
+	  rd->has_m = (ext & 0x02) >> 1;
+	  prec_z = (ext >> 2) & 0x07;
+	  prec_m = (ext >> 5) & 0x07;
+      }
+    if (meta & 0x02)
+	twkb_read_uvarint (rd);	/* skipping the size */
+    if (meta & 0x01)
+      {
+	  /* skipping the bounding box */
+	  dims = 2 + rd->has_z + rd->has_m;
+	  for (ic = 0; ic < dims * 2; ic++)
+	      twkb_read_svarint (rd);
+      }
+    *has_idlist = (meta & 0x04) ? 1 : 0;
+    *empty = (meta & 0x10) ? 1 : 0;
+    rd->factor_xy =
+	twkb_power10 (rd->prec_xy >= 0 ? rd->prec_xy : -(rd->prec_xy));
+    rd->factor_z = twkb_power10 (prec_z);
+    rd->factor_m = twkb_power10 (prec_m);
+    rd->last[0] = 0;
+    rd->last[1] = 0;
+    rd->last[2] = 0;
+    rd->last[3] = 0;
+    return rd->error ? 0 : 1;
+}
+
+static int
+twkb_parse_point (struct twkb_reader *rd, gaiaGeomCollPtr geo)
+{
+/* parsing a TWKB Point */
+    double x;
+    double y;
+    double z;
+    double m;
+    twkb_read_coords (rd, &x, &y, &z, &m);
+    if (rd->error)
+	return 0;
+    switch (geo->DimensionModel)
+      {
+      case GAIA_XY_Z:
+	  gaiaAddPointToGeomCollXYZ (geo, x, y, z);
+	  break;
+      case GAIA_XY_M:
+	  gaiaAddPointToGeomCollXYM (geo, x, y, m);
+	  break;
+      case GAIA_XY_Z_M:
+	  gaiaAddPointToGeomCollXYZM (geo, x, y, z, m);
+	  break;
+      default:
+	  gaiaAddPointToGeomColl (geo, x, y);
+	  break;
+      };
+    return 1;
+}
+
+static int
+twkb_parse_vertices (struct twkb_reader *rd, double *coords, int points,
+		     int dims)
+{
+/* parsing a TWKB PointArray */
+    int iv;
+    double x;
+    double y;
+    double z;
+    double m;
+    for (iv = 0; iv < points; iv++)
+      {
+	  twkb_read_coords (rd, &x, &y, &z, &m);
+	  twkb_set_vertex (coords, iv, dims, x, y, z, m);
+      }
+    return rd->error ? 0 : 1;
+}
+
+static int
+twkb_parse_linestring (struct twkb_reader *rd, gaiaGeomCollPtr geo)
+{
+/* parsing a TWKB Linestring */
+    gaiaLinestringPtr ln;
+    int points = twkb_read_count (rd, 2);
+    if (points < 2)
+	return 0;
+    ln = gaiaAddLinestringToGeomColl (geo, points);
+    return twkb_parse_vertices (rd, ln->Coords, points, geo->DimensionModel);
+}
+
+static int
+twkb_parse_polygon (struct twkb_reader *rd, gaiaGeomCollPtr geo)
+{
+/* parsing a TWKB Polygon */
+    gaiaPolygonPtr pg;
+    gaiaRingPtr rng;
+    int ib;
+    int points;
+    int rings = twkb_read_count (rd, 1);
+    if (rings < 1)
+	return 0;
+    points = twkb_read_count (rd, 2);
+    if (points < 4)
+	return 0;
+    pg = gaiaAddPolygonToGeomColl (geo, points, rings - 1);
+    rng = pg->Exterior;
+    if (!twkb_parse_vertices (rd, rng->Coords, points, geo->DimensionModel))
+	return 0;
+    for (ib = 0; ib < rings - 1; ib++)
+      {
+	  points = twkb_read_count (rd, 2);
+	  if (points < 4)
+	      return 0;
+	  rng = gaiaAddInteriorRing (pg, ib, points);
+	  if (!twkb_parse_vertices
+	      (rd, rng->Coords, points, geo->DimensionModel))
+	      return 0;
+      }
+    return 1;
+}
+
+static int
+twkb_parse_geometry (struct twkb_reader *rd, gaiaGeomCollPtr geo,
+		     int nested)
+{
+/* parsing a TWKB Geometry */
+    int type;
+    int empty;
+    int has_idlist;
+    int count;
+    int ig;
+    if (!twkb_read_header (rd, &type, &empty, &has_idlist))
+	return 0;
+    if ((geo->DimensionModel == GAIA_XY_Z
+	 || geo->DimensionModel == GAIA_XY_Z_M) != rd->has_z)
+	return 0;		/* mismatching dimensions */
+    if ((geo->DimensionModel == GAIA_XY_M
+	 || geo->DimensionModel == GAIA_XY_Z_M) != rd->has_m)
+	return 0;		/* mismatching dimensions */
+    if (empty)
+	return 1;
+    switch (type)
+      {
+      case GAIA_POINT:
+	  return twkb_parse_point (rd, geo);
+      case GAIA_LINESTRING:
+	  return twkb_parse_linestring (rd, geo);
+      case GAIA_POLYGON:
+	  return twkb_parse_polygon (rd, geo);
+      case GAIA_MULTIPOINT:
+      case GAIA_MULTILINESTRING:
+      case GAIA_MULTIPOLYGON:
+      case GAIA_GEOMETRYCOLLECTION:
+	  if (type == GAIA_GEOMETRYCOLLECTION && nested)
+	      return 0;		/* nested collections aren't supported */
+	  count = twkb_read_count (rd, 1);
+	  if (count < 0)
+	      return 0;
+	  if (has_idlist)
+	    {
+		/* skipping the IDs list */
+		for (ig = 0; ig < count; ig++)
+		    twkb_read_svarint (rd);
+		if (rd->error)
+		    return 0;
+	    }
+	  for (ig = 0; ig < count; ig++)
+	    {
+		int ret = 0;
+		if (type == GAIA_MULTIPOINT)
+		    ret = twkb_parse_point (rd, geo);
+		else if (type == GAIA_MULTILINESTRING)
+		    ret = twkb_parse_linestring (rd, geo);
+		else if (type == GAIA_MULTIPOLYGON)
+		    ret = twkb_parse_polygon (rd, geo);
+		else
+		    ret = twkb_parse_geometry (rd, geo, 1);
+		if (!ret)
+		    return 0;
+	    }
+	  return 1;
+      };
+    return 0;
+}
+
+static gaiaGeomCollPtr
+doParseTwkbBlob (const unsigned char *blob, unsigned int size,
+		 int little_endian, int endian_arch, int type)
+{
+/* decoding from a TWKB compressed BLOB to GEOMETRY */
+    struct twkb_reader rd;
+    gaiaGeomCollPtr geo;
+    int base = type - GAIA_TWKB_BLOB;
+    int declared = base % 1000;
+    if (declared < GAIA_POINT || declared > GAIA_GEOMETRYCOLLECTION)
+	return NULL;
+    geo = gaiaAllocGeomColl ();
+    switch (base / 1000)
+      {
+      case 1:
+	  geo->DimensionModel = GAIA_XY_Z;
+	  break;
+      case 2:
+	  geo->DimensionModel = GAIA_XY_M;
+	  break;
+      case 3:
+	  geo->DimensionModel = GAIA_XY_Z_M;
+	  break;
+      case 0:
+	  geo->DimensionModel = GAIA_XY;
+	  break;
+      default:
+	  gaiaFreeGeomColl (geo);
+	  return NULL;
+      };
+    geo->Srid = gaiaImport32 (blob + 2, little_endian, endian_arch);
+    rd.ptr = blob + 43;
+    rd.end = blob + (size - 1);
+    rd.error = 0;
+    if (!twkb_parse_geometry (&rd, geo, 0) || rd.error || rd.ptr != rd.end)
+      {
+	  /* malformed TWKB payload */
+	  gaiaFreeGeomColl (geo);
+	  return NULL;
+      }
+    geo->MinX = gaiaImport64 (blob + 6, little_endian, endian_arch);
+    geo->MinY = gaiaImport64 (blob + 14, little_endian, endian_arch);
+    geo->MaxX = gaiaImport64 (blob + 22, little_endian, endian_arch);
+    geo->MaxY = gaiaImport64 (blob + 30, little_endian, endian_arch);
+    geo->DeclaredType = declared;
+    return geo;
+}
+
 GAIAGEO_DECLARE gaiaGeomCollPtr
 gaiaFromSpatiaLiteBlobWkbEx (const unsigned char *blob, unsigned int size,
 			     int gpkg_mode, int gpkg_amphibious)
@@ -1199,6 +1588,8 @@ gaiaFromSpatiaLiteBlobWkbEx (const unsigned char *blob, unsigned int size,
     else
 	return NULL;		/* unknown encoding; nor little-endian neither big-endian */
     type = gaiaImport32 (blob + 39, little_endian, endian_arch);
+    if (type > GAIA_TWKB_BLOB)
+	return doParseTwkbBlob (blob, size, little_endian, endian_arch, type);
     geo = gaiaAllocGeomColl ();
     geo->Srid = gaiaImport32 (blob + 2, little_endian, endian_arch);
     geo->endian_arch = (char) endian_arch;
@@ -1495,6 +1886,90 @@ gaiaFromSpatiaLiteBlobMbr (const unsigned char *blob, unsigned int size)
     return geo;
 }
 
+#ifdef ENABLE_GEOPACKAGE	/* GEOPACKAGE enabled: supporting GPKG geometries */
+static gaiaGeomCollPtr
+doParseGeoPackageBlobMbr (const unsigned char *blob, unsigned int size)
+{
+/* decoding from GPKG BLOB to GEOMETRY [MBR only] */
+    double minx;
+    double miny;
+    double maxx;
+    double maxy;
+    gaiaGeomCollPtr geo = NULL;
+    gaiaPolygonPtr polyg;
+    gaiaRingPtr ring;
+
+    if (!gaiaGetMbrFromGPB (blob, size, &minx, &maxx, &miny, &maxy))
+      {
+	  /*
+	     / no usable Envelope and the WKB scan failed as well:
+	     / lazily falling back to a full decode
+	   */
+	  geo = gaiaFromGeoPackageGeometryBlob (blob, size);
+	  if (geo == NULL)
+	      return NULL;
+	  if (geo->FirstPoint == NULL && geo->FirstLinestring == NULL
+	      && geo->FirstPolygon == NULL)
+	    {
+		/* EMPTY Geometry: there is no MBR at all */
+		gaiaFreeGeomColl (geo);
+		return NULL;
+	    }
+	  gaiaMbrGeometry (geo);
+	  minx = geo->MinX;
+	  miny = geo->MinY;
+	  maxx = geo->MaxX;
+	  maxy = geo->MaxY;
+	  gaiaFreeGeomColl (geo);
+      }
+    geo = gaiaAllocGeomColl ();
+    geo->Srid = gaiaGetSridFromGPB (blob, size);
+    polyg = gaiaAddPolygonToGeomColl (geo, 5, 0);
+    ring = polyg->Exterior;
+    gaiaSetPoint (ring->Coords, 0, minx, miny);	/* vertex # 1 */
+    gaiaSetPoint (ring->Coords, 1, maxx, miny);	/* vertex # 2 */
+    gaiaSetPoint (ring->Coords, 2, maxx, maxy);	/* vertex # 3 */
+    gaiaSetPoint (ring->Coords, 3, minx, maxy);	/* vertex # 4 */
+    gaiaSetPoint (ring->Coords, 4, minx, miny);	/* vertex # 5 [same as vertex # 1 to close the polygon] */
+    return geo;
+}
+#endif /* end GEOPACKAGE: supporting GPKG geometries */
+
+GAIAGEO_DECLARE gaiaGeomCollPtr
+gaiaFromSpatiaLiteBlobMbrEx (const unsigned char *blob, unsigned int size,
+			     int gpkg_mode, int gpkg_amphibious)
+{
+/* decoding from SpatiaLite (or GPKG) BLOB to GEOMETRY [MBR only] */
+    int little_endian;
+    int endian_arch = gaiaEndianArch ();
+    gaiaGeomCollPtr geo = NULL;
+
+    if (gpkg_amphibious || gpkg_mode)
+      {
+#ifdef ENABLE_GEOPACKAGE	/* GEOPACKAGE enabled: supporting GPKG geometries */
+	  if (gaiaIsValidGPB (blob, size))
+	    {
+		geo = doParseGeoPackageBlobMbr (blob, size);
+		if (geo != NULL)
+		    return geo;
+	    }
+	  if (gpkg_mode)
+	      return NULL;	/* must accept only GPKG geometries */
+#else
+	  ;
+#endif /* end GEOPACKAGE: supporting GPKG geometries */
+      }
+
+    geo = gaiaFromSpatiaLiteBlobMbr (blob, size);
+    if (geo == NULL)
+	return NULL;
+/* both the TinyPoint and the ordinary BLOB store the SRID at offset 2 */
+    little_endian = (*(blob + 1) == GAIA_LITTLE_ENDIAN
+		     || *(blob + 1) == GAIA_TINYPOINT_LITTLE_ENDIAN);
+    geo->Srid = gaiaImport32 (blob + 2, little_endian, endian_arch);
+    return geo;
+}
+
 GAIAGEO_DECLARE void
 gaiaToSpatiaLiteBlobWkbEx (gaiaGeomCollPtr geom, unsigned char **result,
 			   int *size, int gpkg_mode)
@@ -3706,6 +4181,430 @@ gaiaToCompressedBlobWkb (gaiaGeomCollPtr geom, unsigned char **result,
       };
 }
 
+struct twkb_writer
+{
+/* helper struct: building a TWKB payload */
+    unsigned char *buf;
+    int size;
+    int capacity;
+    int error;
+    int has_z;
+    int has_m;
+    int prec_xy;
+    int prec_z;
+    int prec_m;
+    double factor_xy;
+    double factor_z;
+    double factor_m;
+    sqlite3_int64 last[4];
+    double minx;
+    double miny;
+    double maxx;
+    double maxy;
+};
+
+static void
+twkb_write_byte (struct twkb_writer *wr, unsigned char byte)
+{
+/* appending a single byte into the output buffer */
+    if (wr->error)
+	return;
+    if (wr->size >= wr->capacity)
+      {
+	  int capacity = wr->capacity * 2;
+	  unsigned char *buf = realloc (wr->buf, capacity);
+	  if (buf == NULL)
+	    {
+		wr->error = 1;
+		return;
+	    }
+	  wr->buf = buf;
+	  wr->capacity = capacity;
+      }
+    wr->buf[wr->size++] = byte;
+}
+
+static void
+twkb_write_uvarint (struct twkb_writer *wr, sqlite3_uint64 value)
+{
+/* appending an unsigned varint */
+    while (value >= 0x80)
+      {
+	  twkb_write_byte (wr, (unsigned char) ((value & 0x7f) | 0x80));
+	  value >>= 7;
+      }
+    twkb_write_byte (wr, (unsigned char) value);
+}
+
+static void
+twkb_write_svarint (struct twkb_writer *wr, sqlite3_int64 value)
+{
+/* appending a zigzag encoded signed varint */
+    twkb_write_uvarint (wr,
+			((sqlite3_uint64) value << 1) ^ (sqlite3_uint64) (value
+									  >>
+									  63));
+}
+
+static int
+twkb_quantize (double value, double factor, int multiply,
+	       sqlite3_int64 * quantized)
+{
+/* rounding a coordinate to the declared precision */
+    double scaled = multiply ? value * factor : value / factor;
+    if (!(fabs (scaled) < 9007199254740992.0))
+	return 0;		/* NaN, Infinity or out of range */
+    *quantized = (sqlite3_int64) floor (scaled + 0.5);
+    return 1;
+}
+
+static int
+twkb_quantize_vertex (struct twkb_writer *wr, double *coords, int iv,
+		      int dims, sqlite3_int64 * q)
+{
+/* quantizing a vertex accordingly to the Dimension Model */
+    double x;
+    double y;
+    double z = 0.0;
+    double m = 0.0;
+    int mult = (wr->prec_xy >= 0) ? 1 : 0;
+    switch (dims)
+      {
+      case GAIA_XY_Z:
+	  gaiaGetPointXYZ (coords, iv, &x, &y, &z);
+	  break;
+      case GAIA_XY_M:
+	  gaiaGetPointXYM (coords, iv, &x, &y, &m);
+	  break;
+      case GAIA_XY_Z_M:
+	  gaiaGetPointXYZM (coords, iv, &x, &y, &z, &m);
+	  break;
+      default:
+	  gaiaGetPoint (coords, iv, &x, &y);
+	  break;
+      };
+    if (!twkb_quantize (x, wr->factor_xy, mult, q + 0))
+	return 0;
+    if (!twkb_quantize (y, wr->factor_xy, mult, q + 1))
+	return 0;
+    q[2] = 0;
+    q[3] = 0;
+    if (wr->has_z && !twkb_quantize (z, wr->factor_z, 1, q + 2))
+	return 0;
+    if (wr->has_m && !twkb_quantize (m, wr->factor_m, 1, q + 3))
+	return 0;
+    return 1;
+}
+
+static void
+twkb_write_vertex (struct twkb_writer *wr, const sqlite3_int64 * q)
+{
+/* appending a quantized vertex as deltas from the previous one */
+    double x;
+    double y;
+    twkb_write_svarint (wr, q[0] - wr->last[0]);
+    twkb_write_svarint (wr, q[1] - wr->last[1]);
+    if (wr->has_z)
+	twkb_write_svarint (wr, q[2] - wr->last[2]);
+    if (wr->has_m)
+	twkb_write_svarint (wr, q[3] - wr->last[3]);
+    memcpy (wr->last, q, sizeof (sqlite3_int64) * 4);
+/* the MBR must enclose the rounded coordinates */
+    if (wr->prec_xy >= 0)
+      {
+	  x = (double) (q[0]) / wr->factor_xy;
+	  y = (double) (q[1]) / wr->factor_xy;
+      }
+    else
+      {
+	  x = (double) (q[0]) * wr->factor_xy;
+	  y = (double) (q[1]) * wr->factor_xy;
+      }
+    if (x < wr->minx)
+	wr->minx = x;
+    if (x > wr->maxx)
+	wr->maxx = x;
+    if (y < wr->miny)
+	wr->miny = y;
+    if (y > wr->maxy)
+	wr->maxy = y;
+}
+
+static void
+twkb_write_header (struct twkb_writer *wr, int type)
+{
+/* appending a TWKB header */
+    unsigned char zigzag =
+	(unsigned char) ((wr->prec_xy << 1) ^ (wr->prec_xy >> 31));
+    twkb_write_byte (wr, (unsigned char) (type | (zigzag << 4)));
+    if (wr->has_z || wr->has_m)
+      {
+	  twkb_write_byte (wr, 0x08);
+	  twkb_write_byte (wr,
+			   (unsigned char) (wr->has_z | (wr->has_m << 1) |
+					    (wr->prec_z << 2) |
+					    (wr->prec_m << 5)));
+      }
+    else
+	twkb_write_byte (wr, 0x00);
+    wr->last[0] = 0;
+    wr->last[1] = 0;
+    wr->last[2] = 0;
+    wr->last[3] = 0;
+}
+
+static void
+twkb_write_point (struct twkb_writer *wr, gaiaPointPtr pt)
+{
+/* appending a Point */
+    double coords[4];
+    sqlite3_int64 q[4];
+    coords[0] = pt->X;
+    coords[1] = pt->Y;
+    coords[2] = (pt->DimensionModel == GAIA_XY_M) ? pt->M : pt->Z;
+    coords[3] = pt->M;
+    if (!twkb_quantize_vertex (wr, coords, 0, pt->DimensionModel, q))
+      {
+	  wr->error = 1;
+	  return;
+      }
+    twkb_write_vertex (wr, q);
+}
+
+static void
+twkb_write_vertices (struct twkb_writer *wr, double *coords, int points,
+		     int dims, int min_points)
+{
+/* 
+/ appending a PointArray
+/ runs of consecutive vertices collapsing into the same rounded position
+/ are reduced to a single vertex, unless this would leave too few vertices
+*/
+    int iv;
+    int kept = 0;
+    int skip_repeated;
+    sqlite3_int64 q[4];
+    sqlite3_int64 next[4];
+    if (points < 1)
+	return;
+    if (!twkb_quantize_vertex (wr, coords, 0, dims, next))
+      {
+	  wr->error = 1;
+	  return;
+      }
+    for (iv = 1; iv < points; iv++)
+      {
+	  /* counting how many vertices will survive */
+	  memcpy (q, next, sizeof (sqlite3_int64) * 4);
+	  if (!twkb_quantize_vertex (wr, coords, iv, dims, next))
+	    {
+		wr->error = 1;
+		return;
+	    }
+	  if (memcmp (q, next, sizeof (sqlite3_int64) * 4) != 0)
+	      kept++;
+      }
+    kept++;			/* the last vertex is always kept */
+    skip_repeated = (kept >= min_points) ? 1 : 0;
+    twkb_write_uvarint (wr, skip_repeated ? kept : points);
+    twkb_quantize_vertex (wr, coords, 0, dims, next);
+    for (iv = 0; iv < points; iv++)
+      {
+	  memcpy (q, next, sizeof (sqlite3_int64) * 4);
+	  if (iv < points - 1)
+	    {
+		twkb_quantize_vertex (wr, coords, iv + 1, dims, next);
+		if (skip_repeated
+		    && memcmp (q, next, sizeof (sqlite3_int64) * 4) == 0)
+		    continue;
+	    }
+	  twkb_write_vertex (wr, q);
+      }
+}
+
+static void
+twkb_write_linestring (struct twkb_writer *wr, gaiaLinestringPtr ln)
+{
+/* appending a Linestring */
+    twkb_write_vertices (wr, ln->Coords, ln->Points, ln->DimensionModel, 2);
+}
+
+static void
+twkb_write_polygon (struct twkb_writer *wr, gaiaPolygonPtr pg)
+{
+/* appending a Polygon */
+    int ib;
+    gaiaRingPtr rng;
+    twkb_write_uvarint (wr, pg->NumInteriors + 1);
+    rng = pg->Exterior;
+    twkb_write_vertices (wr, rng->Coords, rng->Points, rng->DimensionModel,
+			 4);
+    for (ib = 0; ib < pg->NumInteriors; ib++)
+      {
+	  rng = pg->Interiors + ib;
+	  twkb_write_vertices (wr, rng->Coords, rng->Points,
+			       rng->DimensionModel, 4);
+      }
+}
+
+GAIAGEO_DECLARE void
+gaiaToTwkbBlobWkb (gaiaGeomCollPtr geom, int precision_xy, int precision_z,
+		   int precision_m, unsigned char **result, int *size)
+{
+/* 
+/ builds the SpatiaLite BLOB representation for this GEOMETRY 
+/ coordinates will be encoded as TWKB (rounded integer deltas)
+*/
+    struct twkb_writer wr;
+    int n_points = 0;
+    int n_linestrings = 0;
+    int n_polygons = 0;
+    int type;
+    int dims = 0;
+    int count;
+    unsigned char *ptr;
+    gaiaPointPtr pt;
+    gaiaLinestringPtr ln;
+    gaiaPolygonPtr pg;
+    int endian_arch = gaiaEndianArch ();
+    *size = 0;
+    *result = NULL;
+    if (geom == NULL)
+	return;
+    if (precision_xy < -7 || precision_xy > 7)
+	return;
+    if (precision_z < 0 || precision_z > 7)
+	return;
+    if (precision_m < 0 || precision_m > 7)
+	return;
+/* how many entities, and of what kind, do we have ? */
+    pt = geom->FirstPoint;
+    while (pt)
+      {
+	  n_points++;
+	  pt = pt->Next;
+      }
+    ln = geom->FirstLinestring;
+    while (ln)
+      {
+	  n_linestrings++;
+	  ln = ln->Next;
+      }
+    pg = geom->FirstPolygon;
+    while (pg)
+      {
+	  n_polygons++;
+	  pg = pg->Next;
+      }
+    count = n_points + n_linestrings + n_polygons;
+    if (count == 0)
+	return;
+/* ok, we can determine the geometry class */
+    if (geom->DeclaredType == GAIA_GEOMETRYCOLLECTION)
+	type = GAIA_GEOMETRYCOLLECTION;
+    else if (n_points == count)
+	type = (n_points == 1 && geom->DeclaredType != GAIA_MULTIPOINT) ?
+	    GAIA_POINT : GAIA_MULTIPOINT;
+    else if (n_linestrings == count)
+	type = (n_linestrings == 1
+		&& geom->DeclaredType !=
+		GAIA_MULTILINESTRING) ? GAIA_LINESTRING : GAIA_MULTILINESTRING;
+    else if (n_polygons == count)
+	type = (n_polygons == 1 && geom->DeclaredType != GAIA_MULTIPOLYGON) ?
+	    GAIA_POLYGON : GAIA_MULTIPOLYGON;
+    else
+	type = GAIA_GEOMETRYCOLLECTION;
+    memset (&wr, 0, sizeof (struct twkb_writer));
+    if (geom->DimensionModel == GAIA_XY_Z)
+      {
+	  dims = 1000;
+	  wr.has_z = 1;
+      }
+    else if (geom->DimensionModel == GAIA_XY_M)
+      {
+	  dims = 2000;
+	  wr.has_m = 1;
+      }
+    else if (geom->DimensionModel == GAIA_XY_Z_M)
+      {
+	  dims = 3000;
+	  wr.has_z = 1;
+	  wr.has_m = 1;
+      }
+    wr.prec_xy = precision_xy;
+    wr.prec_z = wr.has_z ? precision_z : 0;
+    wr.prec_m = wr.has_m ? precision_m : 0;
+    wr.factor_xy =
+	twkb_power10 (precision_xy >= 0 ? precision_xy : -precision_xy);
+    wr.factor_z = twkb_power10 (wr.prec_z);
+    wr.factor_m = twkb_power10 (wr.prec_m);
+    wr.minx = DBL_MAX;
+    wr.miny = DBL_MAX;
+    wr.maxx = -DBL_MAX;
+    wr.maxy = -DBL_MAX;
+    wr.capacity = 1024;
+    wr.buf = malloc (wr.capacity);
+    if (wr.buf == NULL)
+	return;
+/* building the TWKB payload */
+    twkb_write_header (&wr, type);
+    if (type == GAIA_POINT)
+	twkb_write_point (&wr, geom->FirstPoint);
+    else if (type == GAIA_LINESTRING)
+	twkb_write_linestring (&wr, geom->FirstLinestring);
+    else if (type == GAIA_POLYGON)
+	twkb_write_polygon (&wr, geom->FirstPolygon);
+    else
+      {
+	  twkb_write_uvarint (&wr, count);
+	  pt = geom->FirstPoint;
+	  while (pt)
+	    {
+		if (type == GAIA_GEOMETRYCOLLECTION)
+		    twkb_write_header (&wr, GAIA_POINT);
+		twkb_write_point (&wr, pt);
+		pt = pt->Next;
+	    }
+	  ln = geom->FirstLinestring;
+	  while (ln)
+	    {
+		if (type == GAIA_GEOMETRYCOLLECTION)
+		    twkb_write_header (&wr, GAIA_LINESTRING);
+		twkb_write_linestring (&wr, ln);
+		ln = ln->Next;
+	    }
+	  pg = geom->FirstPolygon;
+	  while (pg)
+	    {
+		if (type == GAIA_GEOMETRYCOLLECTION)
+		    twkb_write_header (&wr, GAIA_POLYGON);
+		twkb_write_polygon (&wr, pg);
+		pg = pg->Next;
+	    }
+      }
+    if (wr.error)
+      {
+	  free (wr.buf);
+	  return;
+      }
+/* and finally we build the BLOB */
+    *size = 44 + wr.size;
+    *result = malloc (*size);
+    ptr = *result;
+    *ptr = GAIA_MARK_START;	/* START signature */
+    *(ptr + 1) = GAIA_LITTLE_ENDIAN;	/* byte ordering */
+    gaiaExport32 (ptr + 2, geom->Srid, 1, endian_arch);	/* the SRID */
+    gaiaExport64 (ptr + 6, wr.minx, 1, endian_arch);	/* MBR - minimum X */
+    gaiaExport64 (ptr + 14, wr.miny, 1, endian_arch);	/* MBR - minimum Y */
+    gaiaExport64 (ptr + 22, wr.maxx, 1, endian_arch);	/* MBR - maximum X */
+    gaiaExport64 (ptr + 30, wr.maxy, 1, endian_arch);	/* MBR - maximum Y */
+    *(ptr + 38) = GAIA_MARK_MBR;	/* MBR signature */
+    gaiaExport32 (ptr + 39, GAIA_TWKB_BLOB + dims + type, 1, endian_arch);	/* class TYPE */
+    memcpy (ptr + 43, wr.buf, wr.size);
+    *(ptr + 43 + wr.size) = GAIA_MARK_END;	/* END signature */
+    free (wr.buf);
+}
+
 GAIAGEO_DECLARE gaiaGeomCollPtr
 gaiaFromWkb (const unsigned char *blob, unsigned int size)
 {
@@ -48,6 +48,7 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <float.h>
 
 #if defined(_WIN32) && !defined(__MINGW32__)
 #include "config-msvc.h"
@@ -55,10 +56,14 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include "config.h"
 #endif
 
+#include <spatialite_private.h>
 #include <spatialite/sqlite.h>
 
 #include <spatialite/gaiageo.h>
 
+/* max length of a single formatted coordinate (%.18f of +/-DBL_MAX) */
+#define GAIA_OUT_COORD_LEN	512
+
 static void
 gaiaOutClean (char *buffer)
 {
@@ -109,6 +114,129 @@ gaiaOutClean (char *buffer)
       }
 }
 
+static void
+gaiaOutShortest (char *buf, int size, double value)
+{
+/*
+/ formats a double by using the fewest significant digits (never
+/ more than 17) reading back as exactly the same value
+/
+/ the result is always in plain decimal notation, and doesn't
+/ depend on the current locale
+*/
+    char tmp[64];
+    char digits[32];
+    char check[64];
+    const char *p;
+    const char *ptr;
+    char *out;
+    double value2;
+    int negative = 0;
+    int n_digits;
+    int exponent;
+    int prec;
+    int len;
+    int i;
+
+    if (value != value || (value - value) != 0.0)
+      {
+	  /* NaN or Infinity: same as any other coordinate */
+	  sqlite3_snprintf (size, buf, "%f", value);
+	  gaiaOutClean (buf);
+	  return;
+      }
+    if (value == 0.0)
+      {
+	  sqlite3_snprintf (size, buf, "0");
+	  return;
+      }
+
+/* any normal double up to 15 digits safely reads back the same */
+    prec = (value > -DBL_MIN && value < DBL_MIN) ? 1 : 15;
+    for (; prec <= 17; prec++)
+      {
+	  /* splitting "[-]d.ddde[+-]x" into digits and exponent */
+	  snprintf (tmp, sizeof (tmp), "%.*e", prec - 1, value);
+	  p = tmp;
+	  negative = 0;
+	  if (*p == '-')
+	    {
+		negative = 1;
+		p++;
+	    }
+	  n_digits = 0;
+	  while (*p != '\0' && *p != 'e' && *p != 'E')
+	    {
+		/* the decimal point is skipped, whatever the locale is */
+		if (*p >= '0' && *p <= '9' && n_digits < prec)
+		    digits[n_digits++] = *p;
+		p++;
+	    }
+	  digits[n_digits] = '\0';
+	  exponent = (*p == '\0') ? 0 : atoi (p + 1);
+	  sqlite3_snprintf (sizeof (check), check, "%c%s%se%d", digits[0],
+			    (n_digits > 1) ? "." : "", digits + 1, exponent);
+	  ptr = check;
+	  if (gaia_fast_parse_double (&ptr, &value2))
+	    {
+		if (negative)
+		    value2 = -value2;
+		if (value2 == value)
+		    break;
+	    }
+      }
+    while (n_digits > 1 && digits[n_digits - 1] == '0')
+	digits[--n_digits] = '\0';
+
+/* plain decimal notation */
+    if (exponent >= 0)
+	len = negative + ((exponent >= n_digits) ? exponent + 1 : n_digits + 1);
+    else
+	len = negative + 1 - exponent + n_digits;
+    if (len >= size)
+      {
+	  /* not expected to happen with GAIA_OUT_COORD_LEN buffers */
+	  sqlite3_snprintf (size, buf, "%s%s", negative ? "-" : "", check);
+	  return;
+      }
+    out = buf;
+    if (negative)
+	*out++ = '-';
+    if (exponent >= 0)
+      {
+	  for (i = 0; i <= exponent || i < n_digits; i++)
+	    {
+		if (i == exponent + 1)
+		    *out++ = '.';
+		*out++ = (i < n_digits) ? digits[i] : '0';
+	    }
+      }
+    else
+      {
+	  *out++ = '0';
+	  *out++ = '.';
+	  for (i = exponent + 1; i < 0; i++)
+	      *out++ = '0';
+	  for (i = 0; i < n_digits; i++)
+	      *out++ = digits[i];
+      }
+    *out = '\0';
+}
+
+static void
+gaiaOutCoord (char *buf, int precision, double value)
+{
+/* formats a single coordinate value (at least GAIA_OUT_COORD_LEN bytes) */
+    if (precision < 0)
+      {
+	  /* shortest round-trip representation */
+	  gaiaOutShortest (buf, GAIA_OUT_COORD_LEN, value);
+	  return;
+      }
+    sqlite3_snprintf (GAIA_OUT_COORD_LEN, buf, "%.*f", precision, value);
+    gaiaOutClean (buf);
+}
+
 GAIAGEO_DECLARE void
 gaiaOutBufferInitialize (gaiaOutBufferPtr buf)
 {
@@ -2836,51 +2964,39 @@ static void
 out_kml_point (gaiaOutBufferPtr out_buf, gaiaPointPtr point, int precision)
 {
 /* formats POINT as KML [x,y] */
-    char *buf_x = NULL;
-    char *buf_y = NULL;
-    char *buf_z = NULL;
-    char *buf = NULL;
-    buf_x = sqlite3_mprintf ("%.*f", precision, point->X);
-    gaiaOutClean (buf_x);
-    buf_y = sqlite3_mprintf ("%.*f", precision, point->Y);
-    gaiaOutClean (buf_y);
-    if (point->DimensionModel == GAIA_XY_Z
-	|| point->DimensionModel == GAIA_XY_Z_M)
-      {
-	  buf_z = sqlite3_mprintf ("%.*f", precision, point->Z);
-	  gaiaOutClean (buf_z);
-      }
+    char buf_x[GAIA_OUT_COORD_LEN];
+    char buf_y[GAIA_OUT_COORD_LEN];
+    char buf_z[GAIA_OUT_COORD_LEN];
+    char buf[(GAIA_OUT_COORD_LEN * 3) + 8];
+    gaiaOutCoord (buf_x, precision, point->X);
+    gaiaOutCoord (buf_y, precision, point->Y);
     gaiaAppendToOutBuffer (out_buf, "<Point><coordinates>");
     if (point->DimensionModel == GAIA_XY_Z
 	|| point->DimensionModel == GAIA_XY_Z_M)
       {
-	  buf = sqlite3_mprintf ("%s,%s,%s", buf_x, buf_y, buf_z);
-	  sqlite3_free (buf_z);
+	  gaiaOutCoord (buf_z, precision, point->Z);
+	  sqlite3_snprintf (sizeof (buf), buf, "%s,%s,%s", buf_x, buf_y, buf_z);
       }
     else
-	buf = sqlite3_mprintf ("%s,%s", buf_x, buf_y);
-    sqlite3_free (buf_x);
-    sqlite3_free (buf_y);
+	sqlite3_snprintf (sizeof (buf), buf, "%s,%s", buf_x, buf_y);
     gaiaAppendToOutBuffer (out_buf, buf);
-    sqlite3_free (buf);
     gaiaAppendToOutBuffer (out_buf, "</coordinates></Point>");
 }
 
 static void
-out_kml_linestring (gaiaOutBuffer * out_buf, int dims, int points,
-		    double *coords, int precision)
+out_kml_coords (gaiaOutBufferPtr out_buf, int dims, int points,
+		double *coords, int precision)
 {
-/* formats LINESTRING as KML [x,y] */
-    char *buf_x = NULL;
-    char *buf_y = NULL;
-    char *buf_z = NULL;
-    char *buf = NULL;
+/* formats a KML coordinates list [x,y] */
+    char buf_x[GAIA_OUT_COORD_LEN];
+    char buf_y[GAIA_OUT_COORD_LEN];
+    char buf_z[GAIA_OUT_COORD_LEN];
+    char buf[(GAIA_OUT_COORD_LEN * 3) + 8];
     int iv;
     double x = 0.0;
     double y = 0.0;
     double z = 0.0;
     double m = 0.0;
-    gaiaAppendToOutBuffer (out_buf, "<LineString><coordinates>");
     for (iv = 0; iv < points; iv++)
       {
 	  /* exporting vertices */
@@ -2900,32 +3016,29 @@ out_kml_linestring (gaiaOutBuffer * out_buf, int dims, int points,
 	    {
 		gaiaGetPoint (coords, iv, &x, &y);
 	    }
-	  buf_x = sqlite3_mprintf ("%.*f", precision, x);
-	  gaiaOutClean (buf_x);
-	  buf_y = sqlite3_mprintf ("%.*f", precision, y);
-	  gaiaOutClean (buf_y);
+	  gaiaOutCoord (buf_x, precision, x);
+	  gaiaOutCoord (buf_y, precision, y);
 	  if (dims == GAIA_XY_Z || dims == GAIA_XY_Z_M)
 	    {
-		buf_z = sqlite3_mprintf ("%.*f", precision, z);
-		gaiaOutClean (buf_z);
-		if (iv == 0)
-		    buf = sqlite3_mprintf ("%s,%s,%s", buf_x, buf_y, buf_z);
-		else
-		    buf = sqlite3_mprintf (" %s,%s,%s", buf_x, buf_y, buf_z);
-		sqlite3_free (buf_z);
+		gaiaOutCoord (buf_z, precision, z);
+		sqlite3_snprintf (sizeof (buf), buf,
+				  (iv == 0) ? "%s,%s,%s" : " %s,%s,%s", buf_x,
+				  buf_y, buf_z);
 	    }
 	  else
-	    {
-		if (iv == 0)
-		    buf = sqlite3_mprintf ("%s,%s", buf_x, buf_y);
-		else
-		    buf = sqlite3_mprintf (" %s,%s", buf_x, buf_y);
-	    }
-	  sqlite3_free (buf_x);
-	  sqlite3_free (buf_y);
+	      sqlite3_snprintf (sizeof (buf), buf,
+				(iv == 0) ? "%s,%s" : " %s,%s", buf_x, buf_y);
 	  gaiaAppendToOutBuffer (out_buf, buf);
-	  sqlite3_free (buf);
       }
+}
+
+static void
+out_kml_linestring (gaiaOutBuffer * out_buf, int dims, int points,
+		    double *coords, int precision)
+{
+/* formats LINESTRING as KML [x,y] */
+    gaiaAppendToOutBuffer (out_buf, "<LineString><coordinates>");
+    out_kml_coords (out_buf, dims, points, coords, precision);
     gaiaAppendToOutBuffer (out_buf, "</coordinates></LineString>");
 }
 
@@ -2934,67 +3047,14 @@ out_kml_polygon (gaiaOutBufferPtr out_buf, gaiaPolygonPtr polygon,
 		 int precision)
 {
 /* formats POLYGON as KML [x,y] */
-    char *buf_x = NULL;
-    char *buf_y = NULL;
-    char *buf_z = NULL;
-    char *buf = NULL;
     gaiaRingPtr ring;
-    int iv;
     int ib;
-    double x = 0.0;
-    double y = 0.0;
-    double z = 0.0;
-    double m = 0.0;
     gaiaAppendToOutBuffer (out_buf, "<Polygon>");
     gaiaAppendToOutBuffer (out_buf,
 			   "<outerBoundaryIs><LinearRing><coordinates>");
     ring = polygon->Exterior;
-    for (iv = 0; iv < ring->Points; iv++)
-      {
-	  /* exporting vertices [Exterior Ring] */
-	  if (ring->DimensionModel == GAIA_XY_Z)
-	    {
-		gaiaGetPointXYZ (ring->Coords, iv, &x, &y, &z);
-	    }
-	  else if (ring->DimensionModel == GAIA_XY_M)
-	    {
-		gaiaGetPointXYM (ring->Coords, iv, &x, &y, &m);
-	    }
-	  else if (ring->DimensionModel == GAIA_XY_Z_M)
-	    {
-		gaiaGetPointXYZM (ring->Coords, iv, &x, &y, &z, &m);
-	    }
-	  else
-	    {
-		gaiaGetPoint (ring->Coords, iv, &x, &y);
-	    }
-	  buf_x = sqlite3_mprintf ("%.*f", precision, x);
-	  gaiaOutClean (buf_x);
-	  buf_y = sqlite3_mprintf ("%.*f", precision, y);
-	  gaiaOutClean (buf_y);
-	  if (ring->DimensionModel == GAIA_XY_Z
-	      || ring->DimensionModel == GAIA_XY_Z_M)
-	    {
-		buf_z = sqlite3_mprintf ("%.*f", precision, z);
-		gaiaOutClean (buf_z);
-		if (iv == 0)
-		    buf = sqlite3_mprintf ("%s,%s,%s", buf_x, buf_y, buf_z);
-		else
-		    buf = sqlite3_mprintf (" %s,%s,%s", buf_x, buf_y, buf_z);
-		sqlite3_free (buf_z);
-	    }
-	  else
-	    {
-		if (iv == 0)
-		    buf = sqlite3_mprintf ("%s,%s", buf_x, buf_y);
-		else
-		    buf = sqlite3_mprintf (" %s,%s", buf_x, buf_y);
-	    }
-	  sqlite3_free (buf_x);
-	  sqlite3_free (buf_y);
-	  gaiaAppendToOutBuffer (out_buf, buf);
-	  sqlite3_free (buf);
-      }
+    out_kml_coords (out_buf, ring->DimensionModel, ring->Points, ring->Coords,
+		    precision);
     gaiaAppendToOutBuffer (out_buf,
 			   "</coordinates></LinearRing></outerBoundaryIs>");
     for (ib = 0; ib < polygon->NumInteriors; ib++)
@@ -3003,55 +3063,8 @@ out_kml_polygon (gaiaOutBufferPtr out_buf, gaiaPolygonPtr polygon,
 	  ring = polygon->Interiors + ib;
 	  gaiaAppendToOutBuffer (out_buf,
 				 "<innerBoundaryIs><LinearRing><coordinates>");
-	  for (iv = 0; iv < ring->Points; iv++)
-	    {
-		/* exporting vertices [Interior Ring] */
-		if (ring->DimensionModel == GAIA_XY_Z)
-		  {
-		      gaiaGetPointXYZ (ring->Coords, iv, &x, &y, &z);
-		  }
-		else if (ring->DimensionModel == GAIA_XY_M)
-		  {
-		      gaiaGetPointXYM (ring->Coords, iv, &x, &y, &m);
-		  }
-		else if (ring->DimensionModel == GAIA_XY_Z_M)
-		  {
-		      gaiaGetPointXYZM (ring->Coords, iv, &x, &y, &z, &m);
-		  }
-		else
-		  {
-		      gaiaGetPoint (ring->Coords, iv, &x, &y);
-		  }
-		buf_x = sqlite3_mprintf ("%.*f", precision, x);
-		gaiaOutClean (buf_x);
-		buf_y = sqlite3_mprintf ("%.*f", precision, y);
-		gaiaOutClean (buf_y);
-		if (ring->DimensionModel == GAIA_XY_Z
-		    || ring->DimensionModel == GAIA_XY_Z_M)
-		  {
-		      buf_z = sqlite3_mprintf ("%.*f", precision, z);
-		      gaiaOutClean (buf_z);
-		      if (iv == 0)
-			  buf =
-			      sqlite3_mprintf ("%s,%s,%s", buf_x, buf_y, buf_z);
-		      else
-			  buf =
-			      sqlite3_mprintf (" %s,%s,%s", buf_x, buf_y,
-					       buf_z);
-		      sqlite3_free (buf_z);
-		  }
-		else
-		  {
-		      if (iv == 0)
-			  buf = sqlite3_mprintf ("%s,%s", buf_x, buf_y);
-		      else
-			  buf = sqlite3_mprintf (" %s,%s", buf_x, buf_y);
-		  }
-		sqlite3_free (buf_x);
-		sqlite3_free (buf_y);
-		gaiaAppendToOutBuffer (out_buf, buf);
-		sqlite3_free (buf);
-	    }
+	  out_kml_coords (out_buf, ring->DimensionModel, ring->Points,
+			  ring->Coords, precision);
 	  gaiaAppendToOutBuffer (out_buf,
 				 "</coordinates></LinearRing></innerBoundaryIs>");
       }
@@ -4024,10 +4037,11 @@ gaiaOutGeoJSON (gaiaOutBufferPtr out_buf, gaiaGeomCollPtr geom, int precision,
     char *bbox;
     char crs[2048];
     char *buf;
-    char *buf_x;
-    char *buf_y;
-    char *buf_m;
-    char *buf_z = NULL;
+    char buf_x[GAIA_OUT_COORD_LEN];
+    char buf_y[GAIA_OUT_COORD_LEN];
+    char buf_m[GAIA_OUT_COORD_LEN];
+    char buf_z[GAIA_OUT_COORD_LEN];
+    char buf_pt[(GAIA_OUT_COORD_LEN * 3) + 8];
     char endJson[16];
     if (!geom)
 	return;
@@ -4059,21 +4073,13 @@ gaiaOutGeoJSON (gaiaOutBufferPtr out_buf, gaiaGeomCollPtr geom, int precision,
 	    {
 		/* including BBOX */
 		gaiaMbrGeometry (geom);
-		buf_x = sqlite3_mprintf ("%.*f", precision, geom->MinX);
-		gaiaOutClean (buf_x);
-		buf_y = sqlite3_mprintf ("%.*f", precision, geom->MinY);
-		gaiaOutClean (buf_y);
-		buf_z = sqlite3_mprintf ("%.*f", precision, geom->MaxX);
-		gaiaOutClean (buf_z);
-		buf_m = sqlite3_mprintf ("%.*f", precision, geom->MaxY);
-		gaiaOutClean (buf_m);
+		gaiaOutCoord (buf_x, precision, geom->MinX);
+		gaiaOutCoord (buf_y, precision, geom->MinY);
+		gaiaOutCoord (buf_z, precision, geom->MaxX);
+		gaiaOutCoord (buf_m, precision, geom->MaxY);
 		bbox =
 		    sqlite3_mprintf (",\"bbox\":[%s,%s,%s,%s]", buf_x, buf_y,
 				     buf_z, buf_m);
-		sqlite3_free (buf_x);
-		sqlite3_free (buf_y);
-		sqlite3_free (buf_z);
-		sqlite3_free (buf_m);
 	    }
 	  switch (geom->DeclaredType)
 	    {
@@ -4195,33 +4201,19 @@ gaiaOutGeoJSON (gaiaOutBufferPtr out_buf, gaiaGeomCollPtr geom, int precision,
 		/* adding a further Point */
 		gaiaAppendToOutBuffer (out_buf, ",");
 	    }
-	  buf_x = sqlite3_mprintf ("%.*f", precision, point->X);
-	  gaiaOutClean (buf_x);
-	  buf_y = sqlite3_mprintf ("%.*f", precision, point->Y);
-	  gaiaOutClean (buf_y);
-	  has_z = 0;
+	  gaiaOutCoord (buf_x, precision, point->X);
+	  gaiaOutCoord (buf_y, precision, point->Y);
 	  if (point->DimensionModel == GAIA_XY_Z
 	      || point->DimensionModel == GAIA_XY_Z_M)
 	    {
-		buf_z = sqlite3_mprintf ("%.*f", precision, point->Z);
-		gaiaOutClean (buf_z);
-		has_z = 1;
-	    }
-	  if (has_z)
-	    {
-		buf = sqlite3_mprintf ("[%s,%s,%s]", buf_x, buf_y, buf_z);
-		sqlite3_free (buf_x);
-		sqlite3_free (buf_y);
-		sqlite3_free (buf_z);
+		gaiaOutCoord (buf_z, precision, point->Z);
+		sqlite3_snprintf (sizeof (buf_pt), buf_pt, "[%s,%s,%s]", buf_x,
+				  buf_y, buf_z);
 	    }
 	  else
-	    {
-		buf = sqlite3_mprintf ("[%s,%s]", buf_x, buf_y);
-		sqlite3_free (buf_x);
-		sqlite3_free (buf_y);
-	    }
-	  gaiaAppendToOutBuffer (out_buf, buf);
-	  sqlite3_free (buf);
+	      sqlite3_snprintf (sizeof (buf_pt), buf_pt, "[%s,%s]", buf_x,
+				buf_y);
+	  gaiaAppendToOutBuffer (out_buf, buf_pt);
 	  if (is_multi)
 	    {
 		gaiaAppendToOutBuffer (out_buf, "}");
@@ -4271,39 +4263,29 @@ gaiaOutGeoJSON (gaiaOutBufferPtr out_buf, gaiaGeomCollPtr geom, int precision,
 		  }
 		if (has_z)
 		  {
-		      buf_x = sqlite3_mprintf ("%.*f", precision, x);
-		      gaiaOutClean (buf_x);
-		      buf_y = sqlite3_mprintf ("%.*f", precision, y);
-		      gaiaOutClean (buf_y);
-		      buf_z = sqlite3_mprintf ("%.*f", precision, z);
-		      gaiaOutClean (buf_z);
+		      gaiaOutCoord (buf_x, precision, x);
+		      gaiaOutCoord (buf_y, precision, y);
+		      gaiaOutCoord (buf_z, precision, z);
 		      if (iv == 0)
-			  buf =
-			      sqlite3_mprintf ("[%s,%s,%s]", buf_x, buf_y,
-					       buf_z);
+			  sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+					    "[%s,%s,%s]", buf_x, buf_y, buf_z);
 		      else
-			  buf =
-			      sqlite3_mprintf (",[%s,%s,%s]", buf_x, buf_y,
-					       buf_z);
-		      sqlite3_free (buf_x);
-		      sqlite3_free (buf_y);
-		      sqlite3_free (buf_z);
+			  sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+					    ",[%s,%s,%s]",
+					    buf_x, buf_y, buf_z);
 		  }
 		else
 		  {
-		      buf_x = sqlite3_mprintf ("%.*f", precision, x);
-		      gaiaOutClean (buf_x);
-		      buf_y = sqlite3_mprintf ("%.*f", precision, y);
-		      gaiaOutClean (buf_y);
+		      gaiaOutCoord (buf_x, precision, x);
+		      gaiaOutCoord (buf_y, precision, y);
 		      if (iv == 0)
-			  buf = sqlite3_mprintf ("[%s,%s]", buf_x, buf_y);
+			  sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+					    "[%s,%s]", buf_x, buf_y);
 		      else
-			  buf = sqlite3_mprintf (",[%s,%s]", buf_x, buf_y);
-		      sqlite3_free (buf_x);
-		      sqlite3_free (buf_y);
+			  sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+					    ",[%s,%s]", buf_x, buf_y);
 		  }
-		gaiaAppendToOutBuffer (out_buf, buf);
-		sqlite3_free (buf);
+		gaiaAppendToOutBuffer (out_buf, buf_pt);
 	    }
 	  /* closing the LineString */
 	  gaiaAppendToOutBuffer (out_buf, "]");
@@ -4357,39 +4339,30 @@ gaiaOutGeoJSON (gaiaOutBufferPtr out_buf, gaiaGeomCollPtr geom, int precision,
 		  }
 		if (has_z)
 		  {
-		      buf_x = sqlite3_mprintf ("%.*f", precision, x);
-		      gaiaOutClean (buf_x);
-		      buf_y = sqlite3_mprintf ("%.*f", precision, y);
-		      gaiaOutClean (buf_y);
-		      buf_z = sqlite3_mprintf ("%.*f", precision, z);
-		      gaiaOutClean (buf_z);
+		      gaiaOutCoord (buf_x, precision, x);
+		      gaiaOutCoord (buf_y, precision, y);
+		      gaiaOutCoord (buf_z, precision, z);
 		      if (iv == 0)
-			  buf =
-			      sqlite3_mprintf ("[[%s,%s,%s]", buf_x, buf_y,
-					       buf_z);
+			  sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+					    "[[%s,%s,%s]",
+					    buf_x, buf_y, buf_z);
 		      else
-			  buf =
-			      sqlite3_mprintf (",[%s,%s,%s]", buf_x, buf_y,
-					       buf_z);
-		      sqlite3_free (buf_x);
-		      sqlite3_free (buf_y);
-		      sqlite3_free (buf_z);
+			  sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+					    ",[%s,%s,%s]",
+					    buf_x, buf_y, buf_z);
 		  }
 		else
 		  {
-		      buf_x = sqlite3_mprintf ("%.*f", precision, x);
-		      gaiaOutClean (buf_x);
-		      buf_y = sqlite3_mprintf ("%.*f", precision, y);
-		      gaiaOutClean (buf_y);
+		      gaiaOutCoord (buf_x, precision, x);
+		      gaiaOutCoord (buf_y, precision, y);
 		      if (iv == 0)
-			  buf = sqlite3_mprintf ("[[%s,%s]", buf_x, buf_y);
+			  sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+					    "[[%s,%s]", buf_x, buf_y);
 		      else
-			  buf = sqlite3_mprintf (",[%s,%s]", buf_x, buf_y);
-		      sqlite3_free (buf_x);
-		      sqlite3_free (buf_y);
+			  sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+					    ",[%s,%s]", buf_x, buf_y);
 		  }
-		gaiaAppendToOutBuffer (out_buf, buf);
-		sqlite3_free (buf);
+		gaiaAppendToOutBuffer (out_buf, buf_pt);
 	    }
 	  /* closing the Exterior Ring */
 	  gaiaAppendToOutBuffer (out_buf, "]");
@@ -4422,41 +4395,30 @@ gaiaOutGeoJSON (gaiaOutBufferPtr out_buf, gaiaGeomCollPtr geom, int precision,
 			}
 		      if (has_z)
 			{
-			    buf_x = sqlite3_mprintf ("%.*f", precision, x);
-			    gaiaOutClean (buf_x);
-			    buf_y = sqlite3_mprintf ("%.*f", precision, y);
-			    gaiaOutClean (buf_y);
-			    buf_z = sqlite3_mprintf ("%.*f", precision, z);
-			    gaiaOutClean (buf_z);
+			    gaiaOutCoord (buf_x, precision, x);
+			    gaiaOutCoord (buf_y, precision, y);
+			    gaiaOutCoord (buf_z, precision, z);
 			    if (iv == 0)
-				buf =
-				    sqlite3_mprintf (",[[%s,%s,%s]", buf_x,
-						     buf_y, buf_z);
+				sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+						  ",[[%s,%s,%s]",
+						  buf_x, buf_y, buf_z);
 			    else
-				buf =
-				    sqlite3_mprintf (",[%s,%s,%s]", buf_x,
-						     buf_y, buf_z);
-			    sqlite3_free (buf_x);
-			    sqlite3_free (buf_y);
-			    sqlite3_free (buf_z);
+				sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+						  ",[%s,%s,%s]",
+						  buf_x, buf_y, buf_z);
 			}
 		      else
 			{
-			    buf_x = sqlite3_mprintf ("%.*f", precision, x);
-			    gaiaOutClean (buf_x);
-			    buf_y = sqlite3_mprintf ("%.*f", precision, y);
-			    gaiaOutClean (buf_y);
+			    gaiaOutCoord (buf_x, precision, x);
+			    gaiaOutCoord (buf_y, precision, y);
 			    if (iv == 0)
-				buf =
-				    sqlite3_mprintf (",[[%s,%s]", buf_x, buf_y);
+				sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+						  ",[[%s,%s]", buf_x, buf_y);
 			    else
-				buf =
-				    sqlite3_mprintf (",[%s,%s]", buf_x, buf_y);
-			    sqlite3_free (buf_x);
-			    sqlite3_free (buf_y);
+				sqlite3_snprintf (sizeof (buf_pt), buf_pt,
+						  ",[%s,%s]", buf_x, buf_y);
 			}
-		      gaiaAppendToOutBuffer (out_buf, buf);
-		      sqlite3_free (buf);
+		      gaiaAppendToOutBuffer (out_buf, buf_pt);
 		  }
 		/* closing the Interior Ring */
 		gaiaAppendToOutBuffer (out_buf, "]");
@@ -37,6 +37,8 @@ the terms of any one of the MPL, the GPL or the LGPL.
  
 */
 
+#include <float.h>
+
 #include "spatialite/geopackage.h"
 #include "geopackage_internal.h"
 
@@ -83,6 +85,8 @@ gaiaToGPB (gaiaGeomCollPtr geom, unsigned char **result, int *size)
     int endian_arch = gaiaEndianArch ();
 
     gaiaToWkb (geom, &wkbOnlyGeometry, &wkbOnlyLength);
+    /* the declared Envelope must always match the Geometry */
+    gaiaMbrGeometry (geom);
     /* Calculate output size */
     /* We only do 2D envelopes (MBR) irrespective of the input geometry dimensions */
     *size = GEOPACKAGE_HEADER_LEN + GEOPACKAGE_2D_ENVELOPE_LEN;
@@ -376,6 +380,189 @@ gaiaGetEnvelopeFromGPB (const unsigned char *gpb, int gpb_len, double *min_x,
     return 1;
 }
 
+static int
+scan_wkb_envelope (const unsigned char *wkb, unsigned int wkb_len,
+		   unsigned int *offset, int endian_arch, int depth,
+		   double *min_x, double *max_x, double *min_y, double *max_y,
+		   int *points)
+{
+/* 
+/ recursively scanning a WKB Geometry so to compute its 2D Envelope
+/ without building any Geometry object
+*/
+    int little_endian;
+    unsigned int type;
+    unsigned int dims = 2;
+    unsigned int n_items;
+    unsigned int n_points;
+    unsigned int ib;
+    unsigned int iv;
+    double x;
+    double y;
+
+    if (depth > 32)
+	return 0;		/* suspiciously deep nesting */
+    if (*offset + 5 > wkb_len)
+	return 0;
+    little_endian = (*(wkb + *offset) == 0x01) ? 1 : 0;
+    type =
+	(unsigned int) gaiaImport32 (wkb + *offset + 1, little_endian,
+				     endian_arch);
+    *offset += 5;
+    if (type & 0x80000000)
+	dims++;			/* EWKB style Z flag */
+    if (type & 0x40000000)
+	dims++;			/* EWKB style M flag */
+    if (type & 0x20000000)
+	*offset += 4;		/* EWKB style SRID */
+    type &= 0x0fffffff;
+    if (type >= 3000 && type < 4000)
+	dims += 2;		/* ISO ZM */
+    else if (type >= 1000 && type < 3000)
+	dims++;			/* ISO Z or M */
+    type %= 1000;
+
+    switch (type)
+      {
+      case 1:
+	  n_items = 0;
+	  n_points = 1;
+	  break;
+      case 2:
+      case 3:
+      case 4:
+      case 5:
+      case 6:
+      case 7:
+	  if (*offset + 4 > wkb_len)
+	      return 0;
+	  n_items =
+	      (unsigned int) gaiaImport32 (wkb + *offset, little_endian,
+					   endian_arch);
+	  *offset += 4;
+	  n_points = 0;
+	  break;
+      default:
+	  return 0;		/* unsupported WKB type */
+      };
+
+    if (type >= 4)
+      {
+	  /* MULTI-xxx or GEOMETRYCOLLECTION */
+	  for (ib = 0; ib < n_items; ib++)
+	    {
+		if (!scan_wkb_envelope
+		    (wkb, wkb_len, offset, endian_arch, depth + 1, min_x, max_x,
+		     min_y, max_y, points))
+		    return 0;
+	    }
+	  return 1;
+      }
+    for (ib = 0; ib < ((type == 3) ? n_items : 1); ib++)
+      {
+	  if (type == 3)
+	    {
+		/* reading the number of points of the current Ring */
+		if (*offset + 4 > wkb_len)
+		    return 0;
+		n_points =
+		    (unsigned int) gaiaImport32 (wkb + *offset, little_endian,
+						 endian_arch);
+		*offset += 4;
+	    }
+	  else if (type == 2)
+	      n_points = n_items;
+	  if (n_points > (wkb_len - *offset) / (dims * 8))
+	      return 0;		/* truncated WKB */
+	  for (iv = 0; iv < n_points; iv++)
+	    {
+		x = gaiaImport64 (wkb + *offset, little_endian, endian_arch);
+		y = gaiaImport64 (wkb + *offset + 8, little_endian,
+				  endian_arch);
+		*offset += dims * 8;
+		if (x != x || y != y)
+		    continue;	/* NaN coords: EMPTY Point */
+		if (x < *min_x)
+		    *min_x = x;
+		if (x > *max_x)
+		    *max_x = x;
+		if (y < *min_y)
+		    *min_y = y;
+		if (y > *max_y)
+		    *max_y = y;
+		*points += 1;
+	    }
+      }
+    return 1;
+}
+
+GEOPACKAGE_DECLARE int
+gaiaGetMbrFromGPB (const unsigned char *gpb, int gpb_len, double *min_x,
+		   double *max_x, double *min_y, double *max_y)
+{
+/* 
+/ fast path: retrieving the 2D Envelope (MBR) from a GPB
+/
+/ the Envelope declared by the GPB header will be directly used
+/ when present and consistent, otherwise it will be computed by
+/ scanning the WKB; in both cases no Geometry will be built
+*/
+    int srid;
+    unsigned int envelope_length;
+    int little_endian;
+    int endian_arch = gaiaEndianArch ();
+    unsigned int offset;
+    int points = 0;
+    double minx;
+    double maxx;
+    double miny;
+    double maxy;
+
+    if (gpb == NULL)
+	return 0;
+    if (!sanity_check_gpb (gpb, gpb_len, &srid, &envelope_length))
+	return 0;
+    if ((unsigned int) gpb_len < GEOPACKAGE_HEADER_LEN + envelope_length)
+	return 0;
+    if (envelope_length > 0)
+      {
+	  /* the first four values always are MinX, MaxX, MinY and MaxY */
+	  const unsigned char *ptr = gpb + GEOPACKAGE_HEADER_LEN;
+	  little_endian = *(gpb + 3) & GEOPACKAGE_WKB_LITTLEENDIAN;
+	  minx = gaiaImport64 (ptr, little_endian, endian_arch);
+	  maxx = gaiaImport64 (ptr + 8, little_endian, endian_arch);
+	  miny = gaiaImport64 (ptr + 16, little_endian, endian_arch);
+	  maxy = gaiaImport64 (ptr + 24, little_endian, endian_arch);
+	  if (minx <= maxx && miny <= maxy)
+	    {
+		/* NaN or inverted values will never pass this test */
+		*min_x = minx;
+		*max_x = maxx;
+		*min_y = miny;
+		*max_y = maxy;
+		return 1;
+	    }
+      }
+
+/* computing the Envelope from the WKB */
+    minx = DBL_MAX;
+    maxx = -DBL_MAX;
+    miny = DBL_MAX;
+    maxy = -DBL_MAX;
+    offset = GEOPACKAGE_HEADER_LEN + envelope_length;
+    if (!scan_wkb_envelope
+	(gpb, gpb_len, &offset, endian_arch, 0, &minx, &maxx, &miny, &maxy,
+	 &points))
+	return 0;
+    if (points == 0)
+	return 0;		/* EMPTY Geometry */
+    *min_x = minx;
+    *max_x = maxx;
+    *min_y = miny;
+    *max_y = maxy;
+    return 1;
+}
+
 GEOPACKAGE_DECLARE char *
 gaiaGetGeometryTypeFromGPB (const unsigned char *gpb, int gpb_len)
 {
@@ -38,6 +38,9 @@ the terms of any one of the MPL, the GPL or the LGPL.
  
 */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "spatialite/geopackage.h"
 #include "spatialite/gaiaaux.h"
 #include "geopackage_internal.h"
@@ -221,4 +224,527 @@ fnct_gpkgAddSpatialIndex (sqlite3_context * context, int argc,
 	  return;
       }
 }
+
+/* bytes per R*Tree cell: 64 bit ID plus four 32 bit floats */
+#define GPKG_RTREE_CELL_SZ	24
+/* max cells per node, as defined by the SQLite R*Tree */
+#define GPKG_RTREE_MAX_CELLS	51
+
+struct gpkg_rtree_item
+{
+/* a struct wrapping an R*Tree entry - bulk loader */
+    sqlite3_int64 id;
+    double minx;
+    double maxx;
+    double miny;
+    double maxy;
+};
+
+static int
+cmp_rtree_center_x (const void *p1, const void *p2)
+{
+/* comparing two R*Tree entries by the X coordinate of their center */
+    const struct gpkg_rtree_item *item1 = (const struct gpkg_rtree_item *) p1;
+    const struct gpkg_rtree_item *item2 = (const struct gpkg_rtree_item *) p2;
+    double x1 = item1->minx + item1->maxx;
+    double x2 = item2->minx + item2->maxx;
+    if (x1 < x2)
+	return -1;
+    if (x1 > x2)
+	return 1;
+    return 0;
+}
+
+static int
+cmp_rtree_center_y (const void *p1, const void *p2)
+{
+/* comparing two R*Tree entries by the Y coordinate of their center */
+    const struct gpkg_rtree_item *item1 = (const struct gpkg_rtree_item *) p1;
+    const struct gpkg_rtree_item *item2 = (const struct gpkg_rtree_item *) p2;
+    double y1 = item1->miny + item1->maxy;
+    double y2 = item2->miny + item2->maxy;
+    if (y1 < y2)
+	return -1;
+    if (y1 > y2)
+	return 1;
+    return 0;
+}
+
+static void
+sort_rtree_str (struct gpkg_rtree_item *items, int count, int node_sz)
+{
+/* 
+/ sorting all R*Tree entries in Sort-Tile-Recursive order: any
+/ sequence of node_sz consecutive entries will then fit a spatially
+/ compact node
+*/
+    int leaves = (count + node_sz - 1) / node_sz;
+    int slices = 1;
+    int slice_sz;
+    int i;
+
+    while (slices * slices < leaves)
+	slices++;
+    slice_sz = slices * node_sz;
+    qsort (items, count, sizeof (struct gpkg_rtree_item), cmp_rtree_center_x);
+    for (i = 0; i < count; i += slice_sz)
+      {
+	  /* each vertical slice is then sorted by Y */
+	  int sz = count - i;
+	  if (sz > slice_sz)
+	      sz = slice_sz;
+	  qsort (items + i, sz, sizeof (struct gpkg_rtree_item),
+		 cmp_rtree_center_y);
+      }
+}
+
+static float
+rtree_value_down (double d)
+{
+/* rounding down to float, exactly as the SQLite R*Tree does */
+    float f = (float) d;
+    if (f > d)
+	f = (float) (d * (d < 0 ? (1.0 + 1.0 / 8388608.0) :
+			  (1.0 - 1.0 / 8388608.0)));
+    return f;
+}
+
+static float
+rtree_value_up (double d)
+{
+/* rounding up to float, exactly as the SQLite R*Tree does */
+    float f = (float) d;
+    if (f < d)
+	f = (float) (d * (d < 0 ? (1.0 - 1.0 / 8388608.0) :
+			  (1.0 + 1.0 / 8388608.0)));
+    return f;
+}
+
+static void
+rtree_export_int64 (unsigned char *p, sqlite3_int64 value)
+{
+/* R*Tree nodes always are big-endian */
+    int i;
+    for (i = 7; i >= 0; i--)
+      {
+	  p[i] = (unsigned char) (value & 0xff);
+	  value >>= 8;
+      }
+}
+
+static void
+rtree_export_float (unsigned char *p, double value)
+{
+/* R*Tree nodes always are big-endian */
+    float f = (float) value;
+    unsigned int bits;
+    memcpy (&bits, &f, sizeof (float));
+    p[0] = (unsigned char) ((bits >> 24) & 0xff);
+    p[1] = (unsigned char) ((bits >> 16) & 0xff);
+    p[2] = (unsigned char) ((bits >> 8) & 0xff);
+    p[3] = (unsigned char) (bits & 0xff);
+}
+
+static int
+do_write_rtree_node (sqlite3_stmt * stmt, sqlite3_stmt * stmt_map,
+		     sqlite3_int64 nodeno, int depth, int is_root,
+		     struct gpkg_rtree_item *cells, int n_cells,
+		     unsigned char *buf, int buf_sz)
+{
+/* 
+/ writing a packed R*Tree node, then mapping all its children
+/ (Leaf entries into "_rowid", Nodes into "_parent")
+*/
+    int i;
+    int ret;
+    unsigned char *p;
+
+    memset (buf, 0, buf_sz);
+    if (is_root)
+      {
+	  buf[0] = (unsigned char) ((depth >> 8) & 0xff);
+	  buf[1] = (unsigned char) (depth & 0xff);
+      }
+    buf[2] = (unsigned char) ((n_cells >> 8) & 0xff);
+    buf[3] = (unsigned char) (n_cells & 0xff);
+    p = buf + 4;
+    for (i = 0; i < n_cells; i++)
+      {
+	  struct gpkg_rtree_item *cell = cells + i;
+	  rtree_export_int64 (p, cell->id);
+	  rtree_export_float (p + 8, cell->minx);
+	  rtree_export_float (p + 12, cell->maxx);
+	  rtree_export_float (p + 16, cell->miny);
+	  rtree_export_float (p + 20, cell->maxy);
+	  p += GPKG_RTREE_CELL_SZ;
+      }
+
+    sqlite3_reset (stmt);
+    sqlite3_clear_bindings (stmt);
+    sqlite3_bind_blob (stmt, 1, buf, buf_sz, SQLITE_STATIC);
+    sqlite3_bind_int64 (stmt, 2, nodeno);
+    ret = sqlite3_step (stmt);
+    if (ret != SQLITE_DONE && ret != SQLITE_ROW)
+	return 0;
+
+    for (i = 0; i < n_cells; i++)
+      {
+	  sqlite3_reset (stmt_map);
+	  sqlite3_clear_bindings (stmt_map);
+	  sqlite3_bind_int64 (stmt_map, 1, (cells + i)->id);
+	  sqlite3_bind_int64 (stmt_map, 2, nodeno);
+	  ret = sqlite3_step (stmt_map);
+	  if (ret != SQLITE_DONE && ret != SQLITE_ROW)
+	      return 0;
+      }
+    return 1;
+}
+
+static int
+do_prepare_rtree_stmt (sqlite3 * sqlite, const char *fmt, const char *xrtree,
+		       sqlite3_stmt ** stmt)
+{
+/* creating a Prepared Statement targeting an R*Tree shadow table */
+    int ret;
+    char *sql = sqlite3_mprintf (fmt, xrtree);
+    ret = sqlite3_prepare_v2 (sqlite, sql, -1, stmt, NULL);
+    sqlite3_free (sql);
+    return (ret == SQLITE_OK) ? 1 : 0;
+}
+
+static int
+do_rtree_packed_load (sqlite3 * sqlite, const char *rtree,
+		      const char *xrtree, struct gpkg_rtree_item *items,
+		      int count)
+{
+/* 
+/ bulk loading a packed R*Tree by directly writing its shadow tables
+/ (nodes are filled in STR order, bottom-up)
+/
+/ returns 1 on success, 0 on failure, and -1 if the R*Tree can't
+/ be directly written (so to fall back to plain INSERTs)
+*/
+    sqlite3_stmt *stmt = NULL;
+    sqlite3_stmt *stmt_node = NULL;
+    sqlite3_stmt *stmt_root = NULL;
+    sqlite3_stmt *stmt_rowid = NULL;
+    sqlite3_stmt *stmt_parent = NULL;
+    struct gpkg_rtree_item *level = items;
+    struct gpkg_rtree_item *parents = NULL;
+    unsigned char *buf = NULL;
+    char *sql;
+    int ret;
+    int retcode = -1;
+    int node_sz = 0;
+    int buf_sz = 0;
+    int n_level = count;
+    int depth = 0;
+    int i;
+    sqlite3_int64 next_nodeno = 2;
+
+/* checking for a genuine 2D floating point R*Tree */
+    sql =
+	sqlite3_mprintf
+	("SELECT Count(*) FROM sqlite_master WHERE type = 'table' "
+	 "AND Lower(name) = Lower(%Q) AND sql LIKE '%%USING rtree(%%'",
+	 rtree);
+    ret = sqlite3_prepare_v2 (sqlite, sql, -1, &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	goto end;
+    if (sqlite3_step (stmt) == SQLITE_ROW)
+	ret = sqlite3_column_int (stmt, 0);
+    else
+	ret = 0;
+    sqlite3_finalize (stmt);
+    stmt = NULL;
+    if (ret != 1)
+	goto end;
+
+/* retrieving the node size from the Root node */
+    if (!do_prepare_rtree_stmt
+	(sqlite, "SELECT length(data) FROM \"%s_node\" WHERE nodeno = 1",
+	 xrtree, &stmt))
+	goto end;
+    if (sqlite3_step (stmt) == SQLITE_ROW)
+	buf_sz = sqlite3_column_int (stmt, 0);
+    sqlite3_finalize (stmt);
+    stmt = NULL;
+    node_sz = (buf_sz - 4) / GPKG_RTREE_CELL_SZ;
+    if (node_sz < 4 || node_sz > 65535)
+	goto end;
+
+/* resetting the shadow tables; any failure here still is harmless */
+    sql = sqlite3_mprintf ("DELETE FROM \"%s_rowid\"", xrtree);
+    ret = sqlite3_exec (sqlite, sql, NULL, NULL, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	goto end;
+    retcode = 0;
+    sql =
+	sqlite3_mprintf
+	("DELETE FROM \"%s_parent\"; DELETE FROM \"%s_node\" WHERE nodeno <> 1",
+	 xrtree, xrtree);
+    ret = sqlite3_exec (sqlite, sql, NULL, NULL, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	goto end;
+    if (!do_prepare_rtree_stmt
+	(sqlite, "INSERT INTO \"%s_node\" (data, nodeno) VALUES (?, ?)",
+	 xrtree, &stmt_node))
+	goto end;
+    if (!do_prepare_rtree_stmt
+	(sqlite, "UPDATE \"%s_node\" SET data = ? WHERE nodeno = ?", xrtree,
+	 &stmt_root))
+	goto end;
+    if (!do_prepare_rtree_stmt
+	(sqlite, "INSERT INTO \"%s_rowid\" (rowid, nodeno) VALUES (?, ?)",
+	 xrtree, &stmt_rowid))
+	goto end;
+    if (!do_prepare_rtree_stmt
+	(sqlite,
+	 "INSERT INTO \"%s_parent\" (nodeno, parentnode) VALUES (?, ?)",
+	 xrtree, &stmt_parent))
+	goto end;
+
+/* the R*Tree stores outward rounded floats */
+    for (i = 0; i < count; i++)
+      {
+	  struct gpkg_rtree_item *item = items + i;
+	  item->minx = rtree_value_down (item->minx);
+	  item->maxx = rtree_value_up (item->maxx);
+	  item->miny = rtree_value_down (item->miny);
+	  item->maxy = rtree_value_up (item->maxy);
+      }
+
+    buf = malloc (buf_sz);
+    while (n_level > node_sz)
+      {
+	  /* packing the current level into full nodes */
+	  int n_nodes = (n_level + node_sz - 1) / node_sz;
+	  sort_rtree_str (level, n_level, node_sz);
+	  parents = malloc (sizeof (struct gpkg_rtree_item) * n_nodes);
+	  for (i = 0; i < n_nodes; i++)
+	    {
+		struct gpkg_rtree_item *node = parents + i;
+		struct gpkg_rtree_item *cells = level + (i * node_sz);
+		int n_cells = n_level - (i * node_sz);
+		int ic;
+		if (n_cells > node_sz)
+		    n_cells = node_sz;
+		node->id = next_nodeno++;
+		node->minx = cells->minx;
+		node->maxx = cells->maxx;
+		node->miny = cells->miny;
+		node->maxy = cells->maxy;
+		for (ic = 1; ic < n_cells; ic++)
+		  {
+		      struct gpkg_rtree_item *cell = cells + ic;
+		      if (cell->minx < node->minx)
+			  node->minx = cell->minx;
+		      if (cell->maxx > node->maxx)
+			  node->maxx = cell->maxx;
+		      if (cell->miny < node->miny)
+			  node->miny = cell->miny;
+		      if (cell->maxy > node->maxy)
+			  node->maxy = cell->maxy;
+		  }
+		if (!do_write_rtree_node
+		    (stmt_node, (depth == 0) ? stmt_rowid : stmt_parent,
+		     node->id, depth, 0, cells, n_cells, buf, buf_sz))
+		    goto end;
+	    }
+	  if (level != items)
+	      free (level);
+	  level = parents;
+	  parents = NULL;
+	  n_level = n_nodes;
+	  depth++;
+      }
+
+/* writing the Root node */
+    if (!do_write_rtree_node
+	(stmt_root, (depth == 0) ? stmt_rowid : stmt_parent, 1, depth, 1,
+	 level, n_level, buf, buf_sz))
+	goto end;
+    retcode = 1;
+
+  end:
+    if (stmt_node != NULL)
+	sqlite3_finalize (stmt_node);
+    if (stmt_root != NULL)
+	sqlite3_finalize (stmt_root);
+    if (stmt_rowid != NULL)
+	sqlite3_finalize (stmt_rowid);
+    if (stmt_parent != NULL)
+	sqlite3_finalize (stmt_parent);
+    if (level != items)
+	free (level);
+    if (parents != NULL)
+	free (parents);
+    if (buf != NULL)
+	free (buf);
+    return retcode;
+}
+
+static int
+do_rtree_sorted_insert (sqlite3 * sqlite, const char *xrtree,
+			struct gpkg_rtree_item *items, int count)
+{
+/* bulk loading the R*Tree by plain INSERTs (in STR order) */
+    sqlite3_stmt *stmt = NULL;
+    char *sql;
+    int ret;
+    int i;
+
+    sql = sqlite3_mprintf ("DELETE FROM \"%s\"", xrtree);
+    ret = sqlite3_exec (sqlite, sql, NULL, NULL, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return 0;
+    sort_rtree_str (items, count, GPKG_RTREE_MAX_CELLS);
+    if (!do_prepare_rtree_stmt
+	(sqlite,
+	 "INSERT INTO \"%s\" (id, minx, maxx, miny, maxy) VALUES (?, ?, ?, ?, ?)",
+	 xrtree, &stmt))
+	return 0;
+    for (i = 0; i < count; i++)
+      {
+	  struct gpkg_rtree_item *item = items + i;
+	  sqlite3_reset (stmt);
+	  sqlite3_clear_bindings (stmt);
+	  sqlite3_bind_int64 (stmt, 1, item->id);
+	  sqlite3_bind_double (stmt, 2, item->minx);
+	  sqlite3_bind_double (stmt, 3, item->maxx);
+	  sqlite3_bind_double (stmt, 4, item->miny);
+	  sqlite3_bind_double (stmt, 5, item->maxy);
+	  ret = sqlite3_step (stmt);
+	  if (ret != SQLITE_DONE && ret != SQLITE_ROW)
+	    {
+		sqlite3_finalize (stmt);
+		return 0;
+	    }
+      }
+    sqlite3_finalize (stmt);
+    return 1;
+}
+
+GEOPACKAGE_PRIVATE void
+fnct_gpkgRebuildSpatialIndex (sqlite3_context * context, int argc,
+			      sqlite3_value ** argv)
+{
+/* SQL function:
+/ gpkgRebuildSpatialIndex(table, column)
+/
+/ Rebuilds from scratch the "rtree_<T>_<C> Virtual Table:
+/ all Envelopes are directly read from the GPB headers, and
+/ a packed R*Tree (STR order) is then bulk loaded without
+/ firing any Trigger
+/ returns nothing on success, raises exception on error
+/
+*/
+    const char *table;
+    const char *column;
+    char *xtable;
+    char *xcolumn;
+    char *xrtree;
+    char *rtree;
+    char *sql_stmt = NULL;
+    sqlite3 *sqlite = NULL;
+    sqlite3_stmt *stmt = NULL;
+    struct gpkg_rtree_item *items = NULL;
+    int count = 0;
+    int max_items = 0;
+    int ret = 0;
+
+    if (argc == 0)
+	argc = 0;		/* suppressing stupid compiler warnings */
+
+    if (sqlite3_value_type (argv[0]) != SQLITE_TEXT)
+      {
+	  sqlite3_result_error (context,
+				"gpkgRebuildSpatialIndex() error: argument 1 [table] is not of the String type",
+				-1);
+	  return;
+      }
+    if (sqlite3_value_type (argv[1]) != SQLITE_TEXT)
+      {
+	  sqlite3_result_error (context,
+				"gpkgRebuildSpatialIndex() error: argument 2 [column] is not of the String type",
+				-1);
+	  return;
+      }
+    table = (const char *) sqlite3_value_text (argv[0]);
+    column = (const char *) sqlite3_value_text (argv[1]);
+    rtree = sqlite3_mprintf ("rtree_%s_%s", table, column);
+    xrtree = gaiaDoubleQuotedSql (rtree);
+    sqlite = sqlite3_context_db_handle (context);
+
+/* loading all Envelopes */
+    xtable = gaiaDoubleQuotedSql (table);
+    xcolumn = gaiaDoubleQuotedSql (column);
+    sql_stmt =
+	sqlite3_mprintf ("SELECT ROWID, \"%s\" FROM \"%s\"", xcolumn, xtable);
+    free (xtable);
+    free (xcolumn);
+    ret = sqlite3_prepare_v2 (sqlite, sql_stmt, -1, &stmt, NULL);
+    sqlite3_free (sql_stmt);
+    if (ret != SQLITE_OK)
+      {
+	  sqlite3_result_error (context, sqlite3_errmsg (sqlite), -1);
+	  goto end;
+      }
+    while (1)
+      {
+	  /* scrolling the result set rows */
+	  const unsigned char *gpb;
+	  int gpb_len;
+	  struct gpkg_rtree_item *item;
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;		/* end of result set */
+	  if (ret != SQLITE_ROW)
+	    {
+		sqlite3_result_error (context, sqlite3_errmsg (sqlite), -1);
+		goto end;
+	    }
+	  if (sqlite3_column_type (stmt, 1) != SQLITE_BLOB)
+	      continue;
+	  gpb = sqlite3_column_blob (stmt, 1);
+	  gpb_len = sqlite3_column_bytes (stmt, 1);
+	  if (gaiaIsEmptyGPB (gpb, gpb_len) != 0)
+	      continue;		/* invalid or EMPTY: never indexed */
+	  if (count >= max_items)
+	    {
+		max_items = (max_items == 0) ? 4096 : max_items * 2;
+		items =
+		    realloc (items,
+			     sizeof (struct gpkg_rtree_item) * max_items);
+	    }
+	  item = items + count;
+	  if (!gaiaGetMbrFromGPB
+	      (gpb, gpb_len, &(item->minx), &(item->maxx), &(item->miny),
+	       &(item->maxy)))
+	      continue;
+	  item->id = sqlite3_column_int64 (stmt, 0);
+	  count++;
+      }
+    sqlite3_finalize (stmt);
+    stmt = NULL;
+
+/* bulk loading the R*Tree */
+    ret = do_rtree_packed_load (sqlite, rtree, xrtree, items, count);
+    if (ret < 0)
+	ret = do_rtree_sorted_insert (sqlite, xrtree, items, count);
+    if (!ret)
+	sqlite3_result_error (context, sqlite3_errmsg (sqlite), -1);
+
+  end:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    if (items != NULL)
+	free (items);
+    sqlite3_free (rtree);
+    free (xrtree);
+}
 #endif
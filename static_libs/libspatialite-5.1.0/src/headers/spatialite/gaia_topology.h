@@ -687,6 +687,47 @@ extern "C"
 				  const char *column, double tolerance,
 				  int line_max_points, double max_length);
 
+/**
+ Populates a Topology by importing a whole GeoTable - Tiled mode
+
+ \param ptr pointer to the Topology Accessor Object.
+ \param db-prefix prefix of the DB containing the input GeoTable.
+ If NULL the "main" DB will be intended by default.
+ \param table name of the input GeoTable.
+ \param column name of the input Geometry Column.
+ Could be NULL is the input table has just a single Geometry Column.
+ \param tolerance approximation factor.
+ \param line_max_points if set to a positive number all input Linestrings
+ and/or Polygon Rings will be split into simpler Linestrings having no more 
+ than this maximum number of points. 
+ \param max_length if set to a positive value all input Linestrings 
+ and/or Polygon Rings will be split into simpler Lines having a length
+ not exceeding this threshold. 
+ \param tiles_per_side the input extent will be partitioned into a grid
+ of tiles_per_side x tiles_per_side Tiles.
+
+ \return 1 on success; -1 on failure (will raise an exception).
+ 
+ \note all features falling within a single Tile will be imported in
+ parallel (each Tile into a private temporary Topology); all features
+ crossing the Tile borders will then be imported so to heal the Topology.
+ When a positive tolerance is set the resulting Topology will be the same
+ created by gaiaTopoGeo_FromGeoTable() (apart from IDs); with a zero 
+ tolerance lines crossing at non-representable points could be noded
+ differently, just as it happens when changing the input order.
+ The input GeoTable will be entirely loaded in memory. If the target
+ Topology isn't empty, or if tiles_per_side is less than 2, this
+ function will fall back to gaiaTopoGeo_FromGeoTable().
+
+ \sa gaiaTopologyFromDBMS, gaiaTopoGeo_FromGeoTable
+ */
+    GAIATOPO_DECLARE int
+	gaiaTopoGeo_FromGeoTableTiled (GaiaTopologyAccessorPtr ptr,
+				       const char *db_prefix,
+				       const char *table, const char *column,
+				       double tolerance, int line_max_points,
+				       double max_length, int tiles_per_side);
+
 /**
  Populates a Topology by importing a whole GeoTable without 
  determining generated faces
@@ -157,6 +157,10 @@ extern "C"
 						   double *max_z, int *has_m,
 						   double *min_m,
 						   double *max_m);
+    GEOPACKAGE_DECLARE int gaiaGetMbrFromGPB (const unsigned char *gpb,
+					      int gpb_len, double *min_x,
+					      double *max_x, double *min_y,
+					      double *max_y);
     GEOPACKAGE_DECLARE char *gaiaGetGeometryTypeFromGPB (const unsigned char
 							 *gpb, int gpb_len);
     GEOPACKAGE_PRIVATE void fnct_IsValidGPB (sqlite3_context * context,
@@ -175,6 +179,10 @@ extern "C"
     GEOPACKAGE_PRIVATE void fnct_gpkgAddSpatialIndex (sqlite3_context *
 						      context, int argc,
 						      sqlite3_value ** argv);
+    GEOPACKAGE_PRIVATE void fnct_gpkgRebuildSpatialIndex (sqlite3_context *
+							  context, int argc,
+							  sqlite3_value **
+							  argv);
 /* end Sandro Furieri - 2014-05-19 */
 
 /* Sandro Furieri - 2015-06-14 */
@@ -635,6 +635,10 @@ extern "C"
 	gaiaDxfHatchPtr curr_hatch;
 /** internal parser variable */
 	int undeclared_layers;
+/** internal parser variable: Layer entities parsed since the last batch */
+	int batch_count;
+/** internal parser variable: preliminary scan [streaming mode] */
+	int scan_only;
     } gaiaDxfParser;
 /**
  Typedef for DXF Layer object
@@ -770,6 +774,45 @@ extern "C"
 					       gaiaDxfParserPtr parser,
 					       int mode, int append);
 
+/**
+ Parsing a DXF file and populating the DB in bounded batches
+
+ \param p_cache a memory pointer returned by spatialite_alloc_connection()
+ \param db_handle handle to a valid DB connection
+ \param parser pointer to DXF Parser object
+ \param dxf_path pathname of the DXF external file to be imported
+ \param mode should be one of GAIA_DXF_IMPORT_BY_LAYER or GAIA_DXF_IMPORT_MIXED
+ \param append boolean flag: if set and some required DB table already exists 
+  will attempt to append further rows into the existing table.
+  otherwise an error will be returned.
+ \param batch_size max number of DXF entities to be kept in memory
+  for each batch; zero or a negative value will parse the whole file
+  before loading it, exactly as gaiaParseDxfFile_r() followed by
+  gaiaLoadFromDxfParser() do.
+
+ \return 0 on failure, any other value on success
+
+ \sa gaiaCreateDxfParser, gaiaDestroyDxfParser, gaiaParseDxfFile_r,
+ gaiaLoadFromDxfParser
+
+ \note the pointer to the DXF Parser object is expected to be the one 
+ returned by a previous call to gaiaCreateDxfParser.\n
+ entities are loaded into the DB as soon as each batch has been parsed,
+ while the next batch is being parsed by a worker thread, so that memory
+ usage only depends on the batch size, on the Layers and on the Blocks
+ and never on the total number of entities.\n
+ a preliminary scan of the whole file will be performed so to detect
+ the dimensions of each Layer and the Blocks actually referenced by some
+ Insert, thus creating exactly the same tables created by
+ gaiaLoadFromDxfParser().\n
+ reentrant and thread-safe.
+ */
+    GAIAGEO_DECLARE int gaiaStreamDxfFile_r (const void *p_cache,
+					     sqlite3 * db_handle,
+					     gaiaDxfParserPtr parser,
+					     const char *dxf_path, int mode,
+					     int append, int batch_size);
+
 /**
  Initializing a DXF Writer Object
 
@@ -168,6 +168,39 @@ extern "C"
 							       unsigned int
 							       size);
 
+/**
+ Creates a Geometry object corresponding to the Envelope [MBR] for a
+ BLOB-Geometry, optionally supporting GPKG BLOB-Geometries as well
+
+ \param blob pointer to BLOB-Geometry
+ \param size the BLOB's size (in bytes)
+ \param gpkg_mode is set to TRUE will accept only GPKG Geometry-BLOBs
+ \param gpkg_amphibious is set to TRUE will indifferently accept
+ either SpatiaLite Geometry-BLOBs or GPKG Geometry-BLOBs
+
+ \return the pointer to the newly created Geometry object: NULL on failure
+
+ \sa gaiaFromSpatiaLiteBlobMbr, gaiaFreeGeomColl
+
+ \note the MBR of a GPKG Geometry will be directly read from the
+ GPKG header when available, or computed by scanning the WKB;
+ the Geometry will be fully decoded only if both fail.
+ \n the returned Geometry will always carry the SRID of the BLOB.
+ \n you are responsible to destroy (before or after) any allocated Geometry,
+ unless you've passed ownership of the Geometry object to some further object:
+ in this case destroying the higher order object will implicitly destroy any
+ contained child object.
+ */
+
+    GAIAGEO_DECLARE gaiaGeomCollPtr gaiaFromSpatiaLiteBlobMbrEx (const
+								 unsigned char
+								 *blob,
+								 unsigned int
+								 size,
+								 int gpkg_mode,
+								 int
+								 gpkg_amphibious);
+
 /**
  MBRs comparison: Contains
 
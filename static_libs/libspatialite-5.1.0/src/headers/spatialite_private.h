@@ -984,6 +984,15 @@ extern "C"
 
     SPATIALITE_PRIVATE void splite_cache_semaphore_unlock (void);
 
+    SPATIALITE_PRIVATE int splite_get_cpu_count (void);
+
+    SPATIALITE_PRIVATE void splite_run_threads (int count,
+						void (*worker) (void *arg),
+						void **args);
+
+    SPATIALITE_PRIVATE int gaia_fast_parse_double (const char **ptr,
+						   double *value);
+
     SPATIALITE_PRIVATE const void *gaiaAuxClonerCreate (const void *sqlite,
 							const char *db_prefix,
 							const char *in_table,
@@ -1142,6 +1151,12 @@ extern "C"
 							  int argc,
 							  const void *argv);
 
+    SPATIALITE_PRIVATE void fnctaux_TopoGeo_FromGeoTableTiled (const void
+							       *context,
+							       int argc,
+							       const void
+							       *argv);
+
     SPATIALITE_PRIVATE void fnctaux_TopoGeo_FromGeoTableNoFace (const void
 								*context,
 								int argc,
@@ -5519,6 +5519,453 @@ dump_dbf_ex2 (sqlite3 * sqlite, char *table, char *dbf_path, char *charset,
     return 0;
 }
 
+/*
+** Streaming export helpers (KML / GeoJSON)
+**
+** features are formatted in batches by several worker threads, each
+** one of them processing a contiguous slice of rows into its own
+** output buffer; the calling thread then writes all slices in order
+** through a fixed size output buffer, optionally gzip compressed.
+*/
+
+#define GAIA_EXPORT_BUFFER_SIZE	65536
+#define GAIA_EXPORT_BATCH_ROWS	1024
+#define GAIA_EXPORT_MIN_SLICE	64
+#define GAIA_EXPORT_MAX_THREADS	16
+
+struct gaia_export_writer
+{
+/* a streaming output file */
+    FILE *out;
+    gzFile gz;
+    int error;
+    int used;
+    char buffer[GAIA_EXPORT_BUFFER_SIZE];
+};
+
+struct gaia_export_value
+{
+/* a single result set value copied from the current row */
+    int type;
+    sqlite3_int64 int_value;
+    double dbl_value;
+    char *txt_value;
+    unsigned char *blob;
+    int size;
+};
+
+struct gaia_export_job
+{
+/* a batch of rows to be formatted */
+    int kml;
+    int precision;
+    int indented;
+    int columns;
+    char **prop_names;
+    struct gaia_export_value *values;
+    int rows;
+    int base_row;
+};
+
+struct gaia_export_worker
+{
+/* a worker formatting a slice of the current batch */
+    struct gaia_export_job *job;
+    int first_row;
+    int last_row;
+    gaiaOutBuffer out;
+};
+
+static struct gaia_export_writer *
+export_writer_open (const char *path)
+{
+/* creating the output file - a ".gz" suffix selects gzip compression */
+    struct gaia_export_writer *writer;
+    int len = strlen (path);
+    writer = malloc (sizeof (struct gaia_export_writer));
+    if (writer == NULL)
+	return NULL;
+    writer->out = NULL;
+    writer->gz = NULL;
+    writer->error = 0;
+    writer->used = 0;
+    if (len > 3 && strcasecmp (path + len - 3, ".gz") == 0)
+	writer->gz = gzopen (path, "wb");
+    else
+      {
+#ifdef _WIN32
+	  writer->out = gaia_win_fopen (path, "wb");
+#else
+	  writer->out = fopen (path, "wb");
+#endif
+      }
+    if (writer->out == NULL && writer->gz == NULL)
+      {
+	  free (writer);
+	  return NULL;
+      }
+    return writer;
+}
+
+static void
+export_writer_flush (struct gaia_export_writer *writer)
+{
+/* writing the buffered data to the output file */
+    if (writer->used == 0)
+	return;
+    if (writer->gz != NULL)
+      {
+	  if (gzwrite (writer->gz, writer->buffer, writer->used) !=
+	      writer->used)
+	      writer->error = 1;
+      }
+    else
+      {
+	  if (fwrite (writer->buffer, 1, writer->used, writer->out) !=
+	      (size_t) (writer->used))
+	      writer->error = 1;
+      }
+    writer->used = 0;
+}
+
+static void
+export_writer_append (struct gaia_export_writer *writer, const char *data,
+		      int len)
+{
+/* appending some data to the output buffer */
+    int sz;
+    while (len > 0)
+      {
+	  if (writer->used == GAIA_EXPORT_BUFFER_SIZE)
+	      export_writer_flush (writer);
+	  sz = GAIA_EXPORT_BUFFER_SIZE - writer->used;
+	  if (sz > len)
+	      sz = len;
+	  memcpy (writer->buffer + writer->used, data, sz);
+	  writer->used += sz;
+	  data += sz;
+	  len -= sz;
+      }
+}
+
+static void
+export_writer_puts (struct gaia_export_writer *writer, const char *text)
+{
+/* appending a text string to the output buffer */
+    export_writer_append (writer, text, strlen (text));
+}
+
+static int
+export_writer_close (struct gaia_export_writer *writer)
+{
+/* flushing and closing the output file */
+    int error;
+    export_writer_flush (writer);
+    if (writer->gz != NULL)
+      {
+	  if (gzclose (writer->gz) != Z_OK)
+	      writer->error = 1;
+      }
+    else
+      {
+	  if (fclose (writer->out) != 0)
+	      writer->error = 1;
+      }
+    error = writer->error;
+    free (writer);
+    return error ? 0 : 1;
+}
+
+static void
+export_copy_value (sqlite3_stmt * stmt, int icol,
+		   struct gaia_export_value *value)
+{
+/* copying a single value from the current row */
+    const char *text;
+    const void *blob;
+    value->type = sqlite3_column_type (stmt, icol);
+    value->txt_value = NULL;
+    value->blob = NULL;
+    value->size = 0;
+    switch (value->type)
+      {
+      case SQLITE_INTEGER:
+	  value->int_value = sqlite3_column_int64 (stmt, icol);
+	  break;
+      case SQLITE_FLOAT:
+	  value->dbl_value = sqlite3_column_double (stmt, icol);
+	  break;
+      case SQLITE_TEXT:
+	  text = (const char *) sqlite3_column_text (stmt, icol);
+	  value->size = sqlite3_column_bytes (stmt, icol);
+	  value->txt_value = malloc (value->size + 1);
+	  memcpy (value->txt_value, text, value->size + 1);
+	  break;
+      case SQLITE_BLOB:
+	  blob = sqlite3_column_blob (stmt, icol);
+	  value->size = sqlite3_column_bytes (stmt, icol);
+	  value->blob = malloc (value->size);
+	  memcpy (value->blob, blob, value->size);
+	  break;
+      };
+}
+
+static void
+export_free_values (struct gaia_export_job *job)
+{
+/* releasing all values of the current batch */
+    int i;
+    for (i = 0; i < job->rows * job->columns; i++)
+      {
+	  struct gaia_export_value *value = job->values + i;
+	  if (value->txt_value != NULL)
+	      free (value->txt_value);
+	  if (value->blob != NULL)
+	      free (value->blob);
+	  value->txt_value = NULL;
+	  value->blob = NULL;
+      }
+    job->rows = 0;
+}
+
+static gaiaGeomCollPtr
+export_get_geometry (struct gaia_export_value *value)
+{
+/* decoding an exported Geometry */
+    if (value->type != SQLITE_BLOB)
+	return NULL;
+    return gaiaFromSpatiaLiteBlobWkb (value->blob, value->size);
+}
+
+static const char *
+export_kml_text (struct gaia_export_value *value, char *buf, int size)
+{
+/* KML name and description - same conversions applied by AsKml() */
+    switch (value->type)
+      {
+      case SQLITE_TEXT:
+	  return value->txt_value;
+      case SQLITE_INTEGER:
+	  sqlite3_snprintf (size, buf, "%lld", value->int_value);
+	  return buf;
+      case SQLITE_FLOAT:
+	  sqlite3_snprintf (size, buf, "%1.6f", value->dbl_value);
+	  return buf;
+      case SQLITE_BLOB:
+	  return "BLOB";
+      };
+    return "NULL";
+}
+
+static void
+export_kml_row (struct gaia_export_job *job, int row, gaiaOutBufferPtr out)
+{
+/* formatting a KML Placemark */
+    struct gaia_export_value *values = job->values + (row * job->columns);
+    char name_buf[128];
+    char desc_buf[128];
+    const char *name;
+    const char *desc;
+    gaiaGeomCollPtr geom = export_get_geometry (values + 2);
+    if (geom == NULL)
+	return;
+    if (geom->Srid == 4326)
+      {
+	  name = export_kml_text (values + 0, name_buf, sizeof (name_buf));
+	  desc = export_kml_text (values + 1, desc_buf, sizeof (desc_buf));
+	  gaiaAppendToOutBuffer (out, "\t");
+	  gaiaOutFullKml (out, name, desc, geom, job->precision);
+	  gaiaAppendToOutBuffer (out, "\r\n");
+      }
+    gaiaFreeGeomColl (geom);
+}
+
+static void
+export_geojson_row (struct gaia_export_job *job, int row,
+		    gaiaOutBufferPtr out)
+{
+/* formatting a GeoJSON Feature */
+    struct gaia_export_value *values = job->values + (row * job->columns);
+    struct gaia_export_value *value;
+    gaiaGeomCollPtr geom;
+    char buf[128];
+    char *xtval;
+    int c;
+
+    if (job->base_row + row == 0)
+      {
+	  /* first Feature */
+	  if (job->indented)
+	      gaiaAppendToOutBuffer (out,
+				     "\t\t\"type\" : \"Feature\",\r\n\t\t\"properties\" : ");
+	  else
+	      gaiaAppendToOutBuffer (out, "\"type\":\"Feature\",\"properties\":");
+      }
+    else
+      {
+	  /* any other Feature except the first one */
+	  if (job->indented)
+	      gaiaAppendToOutBuffer (out,
+				     ", {\r\n\t\t\"type\" : \"Feature\",\r\n\t\t\"properties\" : ");
+	  else
+	      gaiaAppendToOutBuffer (out,
+				     ",{\"type\":\"Feature\",\"properties\":");
+      }
+    for (c = 1; c < job->columns; c++)
+      {
+	  /* Properties */
+	  gaiaAppendToOutBuffer (out, job->prop_names[c]);
+	  value = values + c;
+	  switch (value->type)
+	    {
+	    case SQLITE_INTEGER:
+		sqlite3_snprintf (sizeof (buf), buf, "%lld", value->int_value);
+		gaiaAppendToOutBuffer (out, buf);
+		break;
+	    case SQLITE_FLOAT:
+		sqlite3_snprintf (sizeof (buf), buf, "%f", value->dbl_value);
+		gaiaAppendToOutBuffer (out, buf);
+		break;
+	    case SQLITE_TEXT:
+		xtval = gaiaDoubleQuotedSql (value->txt_value);
+		gaiaAppendToOutBuffer (out, "\"");
+		gaiaAppendToOutBuffer (out, xtval);
+		gaiaAppendToOutBuffer (out, "\"");
+		free (xtval);
+		break;
+	    case SQLITE_BLOB:
+		gaiaAppendToOutBuffer (out, "\"BLOB value\"");
+		break;
+	    case SQLITE_NULL:
+	    default:
+		gaiaAppendToOutBuffer (out, "null");
+		break;
+	    };
+      }
+    /* geometry */
+    if (job->indented)
+	gaiaAppendToOutBuffer (out, "\r\n\t\t},\r\n\t\t\"geometry\" : ");
+    else
+	gaiaAppendToOutBuffer (out, "},\"geometry\":");
+    geom = export_get_geometry (values + 0);
+    if (geom == NULL)
+	gaiaAppendToOutBuffer (out, "null");
+    else
+      {
+	  gaiaOutGeoJSON (out, geom, job->precision, 0);
+	  gaiaFreeGeomColl (geom);
+      }
+    /* end Feature */
+    if (job->indented)
+	gaiaAppendToOutBuffer (out, "\r\n\t}");
+    else
+	gaiaAppendToOutBuffer (out, "}");
+}
+
+static void
+export_worker (void *arg)
+{
+/* formatting a contiguous slice of the current batch */
+    struct gaia_export_worker *worker = (struct gaia_export_worker *) arg;
+    int row;
+    for (row = worker->first_row; row < worker->last_row; row++)
+      {
+	  if (worker->job->kml)
+	      export_kml_row (worker->job, row, &(worker->out));
+	  else
+	      export_geojson_row (worker->job, row, &(worker->out));
+      }
+}
+
+static int
+export_flush_batch (struct gaia_export_job *job,
+		    struct gaia_export_worker *workers, int max_workers,
+		    struct gaia_export_writer *writer)
+{
+/* formatting the current batch, then writing it in the original order */
+    void *args[GAIA_EXPORT_MAX_THREADS];
+    int count;
+    int slice;
+    int i;
+    int ok = 1;
+
+    if (job->rows == 0)
+	return 1;
+    count = (job->rows + GAIA_EXPORT_MIN_SLICE - 1) / GAIA_EXPORT_MIN_SLICE;
+    if (count > max_workers)
+	count = max_workers;
+    slice = (job->rows + count - 1) / count;
+    for (i = 0; i < count; i++)
+      {
+	  struct gaia_export_worker *worker = workers + i;
+	  worker->job = job;
+	  worker->first_row = i * slice;
+	  worker->last_row = worker->first_row + slice;
+	  if (worker->last_row > job->rows)
+	      worker->last_row = job->rows;
+	  args[i] = worker;
+      }
+    splite_run_threads (count, export_worker, args);
+
+    for (i = 0; i < count; i++)
+      {
+	  gaiaOutBufferPtr out = &(workers[i].out);
+	  if (out->Error)
+	      ok = 0;
+	  else if (out->WriteOffset > 0)
+	      export_writer_append (writer, out->Buffer, out->WriteOffset);
+	  /* the buffer will be reused by the next batch */
+	  out->WriteOffset = 0;
+      }
+    job->base_row += job->rows;
+    export_free_values (job);
+    return ok;
+}
+
+static struct gaia_export_worker *
+export_alloc_workers (struct gaia_export_job *job, int columns, int *count)
+{
+/* allocating the formatting workers and the batch storage */
+    struct gaia_export_worker *workers;
+    int n = splite_get_cpu_count ();
+    int i;
+    if (n < 1)
+	n = 1;
+    if (n > GAIA_EXPORT_MAX_THREADS)
+	n = GAIA_EXPORT_MAX_THREADS;
+    workers = malloc (sizeof (struct gaia_export_worker) * n);
+    for (i = 0; i < n; i++)
+	gaiaOutBufferInitialize (&(workers[i].out));
+    job->columns = columns;
+    job->values =
+	malloc (sizeof (struct gaia_export_value) * columns *
+		GAIA_EXPORT_BATCH_ROWS);
+    job->rows = 0;
+    job->base_row = 0;
+    *count = n;
+    return workers;
+}
+
+static void
+export_free_workers (struct gaia_export_job *job,
+		     struct gaia_export_worker *workers, int count)
+{
+/* releasing the formatting workers and the batch storage */
+    int i;
+    if (workers != NULL)
+      {
+	  for (i = 0; i < count; i++)
+	      gaiaOutBufferReset (&(workers[i].out));
+	  free (workers);
+      }
+    if (job->values != NULL)
+      {
+	  export_free_values (job);
+	  free (job->values);
+      }
+    job->values = NULL;
+}
+
 SPATIALITE_DECLARE int
 is_kml_constant (sqlite3 * sqlite, char *table, char *column)
 {
@@ -5576,18 +6023,19 @@ dump_kml_ex (sqlite3 * sqlite, char *table, char *geom_col, char *kml_path,
     char *xgeom_col;
     char *xtable;
     sqlite3_stmt *stmt = NULL;
-    FILE *out = NULL;
+    struct gaia_export_writer *out = NULL;
+    struct gaia_export_job job;
+    struct gaia_export_worker *workers = NULL;
+    int n_workers = 0;
     int ret;
     int rows = 0;
     int is_const = 1;
+    int c;
 
     *xrows = -1;
+    job.values = NULL;
 /* opening/creating the KML file */
-#ifdef _WIN32
-    out = gaia_win_fopen (kml_path, "wb");
-#else
-    out = fopen (kml_path, "wb");
-#endif
+    out = export_writer_open (kml_path);
     if (!out)
 	goto no_file;
 
@@ -5624,9 +6072,12 @@ dump_kml_ex (sqlite3 * sqlite, char *table, char *geom_col, char *kml_path,
       }
     xgeom_col = gaiaDoubleQuotedSql (geom_col);
     xtable = gaiaDoubleQuotedSql (table);
-    sql = sqlite3_mprintf ("SELECT AsKML(%s, %s, %s, %d) FROM \"%s\" "
-			   "WHERE \"%s\" IS NOT NULL", xname, xdesc,
-			   xgeom_col, precision, xtable, xgeom_col);
+/* KML always is WGS84: Placemarks are then formatted by the workers */
+    sql = sqlite3_mprintf ("SELECT %s, %s, CASE WHEN ST_Srid(\"%s\") "
+			   "IN (0, 4326) THEN \"%s\" ELSE ST_Transform(\"%s\", 4326) "
+			   "END FROM \"%s\" WHERE \"%s\" IS NOT NULL", xname,
+			   xdesc, xgeom_col, xgeom_col, xgeom_col, xtable,
+			   xgeom_col);
     sqlite3_free (xname);
     sqlite3_free (xdesc);
     free (xgeom_col);
@@ -5637,6 +6088,11 @@ dump_kml_ex (sqlite3 * sqlite, char *table, char *geom_col, char *kml_path,
     if (ret != SQLITE_OK)
 	goto sql_error;
 
+    job.kml = 1;
+    job.precision = precision;
+    job.indented = 0;
+    job.prop_names = NULL;
+    workers = export_alloc_workers (&job, 3, &n_workers);
     while (1)
       {
 	  /* scrolling the result set */
@@ -5648,26 +6104,41 @@ dump_kml_ex (sqlite3 * sqlite, char *table, char *geom_col, char *kml_path,
 		/* processing a result set row */
 		if (rows == 0)
 		  {
-		      fprintf (out,
-			       "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n");
-		      fprintf (out,
-			       "<kml xmlns=\"http://www.opengis.net/kml/2.2\">\r\n");
-		      fprintf (out, "<Document>\r\n");
+		      export_writer_puts (out,
+					  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n");
+		      export_writer_puts (out,
+					  "<kml xmlns=\"http://www.opengis.net/kml/2.2\">\r\n");
+		      export_writer_puts (out, "<Document>\r\n");
 		  }
 		rows++;
-		fprintf (out, "\t%s\r\n", sqlite3_column_text (stmt, 0));
+		for (c = 0; c < 3; c++)
+		    export_copy_value (stmt, c,
+				       job.values + (job.rows * 3) + c);
+		job.rows++;
+		if (job.rows == GAIA_EXPORT_BATCH_ROWS)
+		  {
+		      if (!export_flush_batch (&job, workers, n_workers, out))
+			  goto write_error;
+		  }
 	    }
 	  else
 	      goto sql_error;
       }
     if (!rows)
 	goto empty_result_set;
+    if (!export_flush_batch (&job, workers, n_workers, out))
+	goto write_error;
 
 
-    fprintf (out, "</Document>\r\n");
-    fprintf (out, "</kml>\r\n");
+    export_writer_puts (out, "</Document>\r\n");
+    export_writer_puts (out, "</kml>\r\n");
     sqlite3_finalize (stmt);
-    fclose (out);
+    export_free_workers (&job, workers, n_workers);
+    if (!export_writer_close (out))
+      {
+	  out = NULL;
+	  goto write_error;
+      }
     *xrows = rows;
     return 1;
 
@@ -5675,8 +6146,9 @@ dump_kml_ex (sqlite3 * sqlite, char *table, char *geom_col, char *kml_path,
 /* some SQL error occurred */
     if (stmt)
 	sqlite3_finalize (stmt);
+    export_free_workers (&job, workers, n_workers);
     if (out)
-	fclose (out);
+	export_writer_close (out);
     spatialite_e ("Dump KML error: %s\n", sqlite3_errmsg (sqlite));
     return 0;
   no_file:
@@ -5684,15 +6156,25 @@ dump_kml_ex (sqlite3 * sqlite, char *table, char *geom_col, char *kml_path,
     if (stmt)
 	sqlite3_finalize (stmt);
     if (out)
-	fclose (out);
+	export_writer_close (out);
     spatialite_e ("ERROR: unable to open '%s' for writing\n", kml_path);
     return 0;
+  write_error:
+/* KML file can't be written */
+    if (stmt)
+	sqlite3_finalize (stmt);
+    export_free_workers (&job, workers, n_workers);
+    if (out)
+	export_writer_close (out);
+    spatialite_e ("ERROR: unable to write '%s'\n", kml_path);
+    return 0;
   empty_result_set:
 /* the result set is empty - nothing to do */
     if (stmt)
 	sqlite3_finalize (stmt);
+    export_free_workers (&job, workers, n_workers);
     if (out)
-	fclose (out);
+	export_writer_close (out);
     spatialite_e
 	("The SQL SELECT returned an empty result set\n... there is nothing to export ...\n");
     return 0;
@@ -5957,7 +6439,7 @@ do_check_geometry (sqlite3 * sqlite, const char *table, const char *geom_col,
 
 static char *
 do_prepare_sql (sqlite3 * sqlite, const char *table, const char *geom_col,
-		int srid, int dims, int precision, int lon_lat, int m_coords)
+		int srid, int dims, int lon_lat, int m_coords)
 {
 /* preparing the SQL statement */
     char *sql;
@@ -5983,129 +6465,33 @@ do_prepare_sql (sqlite3 * sqlite, const char *table, const char *geom_col,
 	  return 0;
       }
 
-/* defining the Geometry first */
+/* defining the Geometry first - GeoJSON is then formatted by the workers */
     x_col = gaiaDoubleQuotedSql (geom_col);
-    if (lon_lat)
+    sql = sqlite3_mprintf ("ST_ForcePolygonCCW(\"%s\")", x_col);
+    if (!m_coords && dims == GAIA_XY_M)
       {
-	  /* exporting Geographic coordinates (lon-lat) */
-	  if (srid == 0 || srid == 4326)
-	    {
-		/* already lon-lan, no transformation is required */
-		if (m_coords)
-		  {
-		      /* exporting eventual M-Values */
-		      sql =
-			  sqlite3_mprintf
-			  ("SELECT AsGeoJSON(ST_ForcePolygonCCW(\"%s\"), %d)",
-			   x_col, precision);
-		  }
-		else
-		  {
-		      if (dims == GAIA_XY_M)
-			{
-			    /* exporting XYM as XY */
-			    sql =
-				sqlite3_mprintf
-				("SELECT AsGeoJSON(CastToXY(ST_ForcePolygonCCW(\"%s\")), %d)",
-				 x_col, precision);
-			}
-		      else if (dims == GAIA_XY_Z_M)
-			{
-			    /* exporting XYZM as XYZ */
-			    sql =
-				sqlite3_mprintf
-				("SELECT AsGeoJSON(CastToXYZ(ST_ForcePolygonCCW(\"%s\")), %d)",
-				 x_col, precision);
-			}
-		      else
-			{
-			    /* unchanged dimensions */
-			    sql =
-				sqlite3_mprintf
-				("SELECT AsGeoJSON(ST_ForcePolygonCCW(\"%s\"), %d)",
-				 x_col, precision);
-			}
-		  }
-	    }
-	  else
-	    {
-		/* converting to lon-lat WGS84 */
-		if (m_coords)
-		  {
-		      /* exporting eventual M-Values */
-		      sql =
-			  sqlite3_mprintf
-			  ("SELECT AsGeoJSON(ST_Transform(ST_ForcePolygonCCW(\"%s\"), 4326), %d)",
-			   x_col, precision);
-		  }
-		else
-		  {
-		      if (dims == GAIA_XY_M)
-			{
-			    /* exporting XYM as XY */
-			    sql =
-				sqlite3_mprintf
-				("SELECT AsGeoJSON(ST_Transform(CastToXY(ST_ForcePolygonCCW(\"%s\")), 4326), %d)",
-				 x_col, precision);
-			}
-		      else if (dims == GAIA_XY_Z_M)
-			{
-			    /* exporting XYZM as XYZ */
-			    sql =
-				sqlite3_mprintf
-				("SELECT AsGeoJSON(ST_TransformCastToXYZ(ST_ForcePolygonCCW(\"%s\")), 4326), %d)",
-				 x_col, precision);
-			}
-		      else
-			{
-			    /* unchanged dimensions */
-			    sql =
-				sqlite3_mprintf
-				("SELECT AsGeoJSON(ST_Transform(ST_ForcePolygonCCW(\"%s\"), 4326), %d)",
-				 x_col, precision);
-			}
-		  }
-	    }
+	  /* exporting XYM as XY */
+	  prev = sql;
+	  sql = sqlite3_mprintf ("CastToXY(%s)", prev);
+	  sqlite3_free (prev);
       }
-    else
+    else if (!m_coords && dims == GAIA_XY_Z_M)
       {
-	  /* exporting coordinates as they are without any transformation */
-	  if (m_coords)
-	    {
-		/* exporting eventual M-Values */
-		sql =
-		    sqlite3_mprintf
-		    ("SELECT AsGeoJSON(ST_ForcePolygonCCW(\"%s\"), %d)", x_col,
-		     precision);
-	    }
-	  else
-	    {
-		if (dims == GAIA_XY_M)
-		  {
-		      /* exporting XYM as XY */
-		      sql =
-			  sqlite3_mprintf
-			  ("SELECT AsGeoJSON(CastToXY(ST_ForcePolygonCCW(\"%s\")), %d)",
-			   x_col, precision);
-		  }
-		else if (dims == GAIA_XY_Z_M)
-		  {
-		      /* exporting XYZM as XYZ */
-		      sql =
-			  sqlite3_mprintf
-			  ("SELECT AsGeoJSON(CastToXYZ(ST_ForcePolygonCCW(\"%s\")), %d)",
-			   x_col, precision);
-		  }
-		else
-		  {
-		      /* unchanged dimensions */
-		      sql =
-			  sqlite3_mprintf
-			  ("SELECT AsGeoJSON(ST_ForcePolygonCCW(\"%s\"), %d)",
-			   x_col, precision);
-		  }
-	    }
+	  /* exporting XYZM as XYZ */
+	  prev = sql;
+	  sql = sqlite3_mprintf ("CastToXYZ(%s)", prev);
+	  sqlite3_free (prev);
+      }
+    if (lon_lat && srid != 0 && srid != 4326)
+      {
+	  /* converting to lon-lat WGS84 */
+	  prev = sql;
+	  sql = sqlite3_mprintf ("ST_Transform(%s, 4326)", prev);
+	  sqlite3_free (prev);
       }
+    prev = sql;
+    sql = sqlite3_mprintf ("SELECT %s", prev);
+    sqlite3_free (prev);
     free (x_col);
 
     for (i = 1; i <= rows; i++)
@@ -6154,6 +6540,19 @@ do_normalize_case (const char *name, int colname_case)
     return clean;
 }
 
+static void
+do_free_prop_names (struct gaia_export_job *job, int cols)
+{
+/* releasing the GeoJSON Property names */
+    int c;
+    if (job->prop_names == NULL)
+	return;
+    for (c = 1; c < cols; c++)
+	sqlite3_free (job->prop_names[c]);
+    free (job->prop_names);
+    job->prop_names = NULL;
+}
+
 SPATIALITE_DECLARE int
 dump_geojson2 (sqlite3 * sqlite, char *table, char *geom_col,
 	       char *outfile_path, int precision, int lon_lat,
@@ -6164,18 +6563,20 @@ dump_geojson2 (sqlite3 * sqlite, char *table, char *geom_col,
 /* sandro furieri 2018-11-25 */
     char *sql;
     sqlite3_stmt *stmt = NULL;
-    FILE *out = NULL;
+    struct gaia_export_writer *out = NULL;
+    struct gaia_export_job job;
+    struct gaia_export_worker *workers = NULL;
+    int n_workers = 0;
     int ret;
     int rows = 0;
     char *geoname = NULL;
     int srid;
     int dims;
-    int first_feature = 1;
-    sqlite3_int64 ival;
-    double dval;
-    const char *tval;
-    char *xtval;
+    int cols = 0;
+    int c;
     *error_message = NULL;
+    job.values = NULL;
+    job.prop_names = NULL;
 
 /* checking Geometry Column, SRID and Dimensions */
     if (!do_check_geometry (sqlite, table, geom_col, &geoname, &srid, &dims))
@@ -6183,18 +6584,13 @@ dump_geojson2 (sqlite3 * sqlite, char *table, char *geom_col,
 
     *xrows = -1;
 /* opening/creating the GeoJSON output file */
-#ifdef _WIN32
-    out = gaia_win_fopen (outfile_path, "wb");
-#else
-    out = fopen (outfile_path, "wb");
-#endif
+    out = export_writer_open (outfile_path);
     if (!out)
 	goto no_file;
 
 /* preparing SQL statement */
-    sql =
-	do_prepare_sql (sqlite, table, geoname, srid, dims, precision, lon_lat,
-			m_coords);
+    sql = do_prepare_sql (sqlite, table, geoname, srid, dims, lon_lat,
+			  m_coords);
     if (sql == NULL)
 	goto no_sql;
     free (geoname);
@@ -6204,6 +6600,39 @@ dump_geojson2 (sqlite3 * sqlite, char *table, char *geom_col,
     if (ret != SQLITE_OK)
 	goto sql_error;
 
+/* Property names are the same for every Feature */
+    cols = sqlite3_column_count (stmt);
+    job.prop_names = malloc (sizeof (char *) * cols);
+    job.prop_names[0] = NULL;
+    for (c = 1; c < cols; c++)
+      {
+	  const char *col_name = sqlite3_column_name (stmt, c);
+	  char *norm_name = do_normalize_case (col_name, colname_case);
+	  char *xcol_name = gaiaDoubleQuotedSql (norm_name);
+	  free (norm_name);
+	  if (c == 1)
+	    {
+		if (indented)
+		    job.prop_names[c] =
+			sqlite3_mprintf ("{\r\n\t\t\t\"%s\" : ", xcol_name);
+		else
+		    job.prop_names[c] = sqlite3_mprintf ("{\"%s\":", xcol_name);
+	    }
+	  else
+	    {
+		if (indented)
+		    job.prop_names[c] =
+			sqlite3_mprintf (",\r\n\t\t\t\"%s\" : ", xcol_name);
+		else
+		    job.prop_names[c] = sqlite3_mprintf (",\"%s\":", xcol_name);
+	    }
+	  free (xcol_name);
+      }
+    job.kml = 0;
+    job.precision = precision;
+    job.indented = indented;
+    workers = export_alloc_workers (&job, cols, &n_workers);
+
     while (1)
       {
 	  /* scrolling the result set */
@@ -6214,109 +6643,26 @@ dump_geojson2 (sqlite3 * sqlite, char *table, char *geom_col,
 	    }
 	  if (ret == SQLITE_ROW)
 	    {
-		int c;
-		int cols = sqlite3_column_count (stmt);
-		if (first_feature)
-		  {
-		      /* FeatureCollection */
-		      if (indented)
-			  fprintf (out,
-				   "{\r\n\t\"type\" : \"FeatureCollection\",\r\n\t\"features\" : [{\r\n");
-		      else
-			  fprintf (out,
-				   "{\"type\":\"FeatureCollection\",\"features\":[{");
-		      first_feature = 0;
-		  }
-		/* Feature */
 		if (rows == 0)
 		  {
-		      /* first Feature */
+		      /* FeatureCollection */
 		      if (indented)
-			  fprintf (out,
-				   "\t\t\"type\" : \"Feature\",\r\n\t\t\"properties\" : ");
+			  export_writer_puts (out,
+					      "{\r\n\t\"type\" : \"FeatureCollection\",\r\n\t\"features\" : [{\r\n");
 		      else
-			  fprintf (out, "\"type\":\"Feature\",\"properties\":");
+			  export_writer_puts (out,
+					      "{\"type\":\"FeatureCollection\",\"features\":[{");
 		  }
-		else
+		/* Features will be formatted by the workers */
+		for (c = 0; c < cols; c++)
+		    export_copy_value (stmt, c,
+				       job.values + (job.rows * cols) + c);
+		job.rows++;
+		if (job.rows == GAIA_EXPORT_BATCH_ROWS)
 		  {
-		      /* any other Feature except the first one */
-		      if (indented)
-			  fprintf (out,
-				   ", {\r\n\t\t\"type\" : \"Feature\",\r\n\t\t\"properties\" : ");
-		      else
-			  fprintf (out,
-				   ",{\"type\":\"Feature\",\"properties\":");
+		      if (!export_flush_batch (&job, workers, n_workers, out))
+			  goto write_error;
 		  }
-		for (c = 1; c < cols; c++)
-		  {
-		      /* Properties */
-		      const char *col_name = sqlite3_column_name (stmt, c);
-		      char *norm_name =
-			  do_normalize_case (col_name, colname_case);
-		      char *xcol_name = gaiaDoubleQuotedSql (norm_name);
-		      free (norm_name);
-		      if (c == 1)
-			{
-			    if (indented)
-				fprintf (out, "{\r\n\t\t\t\"%s\" : ",
-					 xcol_name);
-			    else
-				fprintf (out, "{\"%s\":", xcol_name);
-			}
-		      else
-			{
-			    if (indented)
-				fprintf (out, ",\r\n\t\t\t\"%s\" : ",
-					 xcol_name);
-			    else
-				fprintf (out, ",\"%s\":", xcol_name);
-			}
-		      free (xcol_name);
-		      switch (sqlite3_column_type (stmt, c))
-			{
-			case SQLITE_INTEGER:
-			    ival = sqlite3_column_int64 (stmt, c);
-			    fprintf (out, "%lld", ival);
-			    break;
-			case SQLITE_FLOAT:
-			    dval = sqlite3_column_double (stmt, c);
-			    fprintf (out, "%f", dval);
-			    break;
-			case SQLITE_TEXT:
-			    tval = (const char *) sqlite3_column_text (stmt, c);
-			    xtval = gaiaDoubleQuotedSql (tval);
-			    fprintf (out, "\"%s\"", xtval);
-			    free (xtval);
-			    break;
-			case SQLITE_BLOB:
-			    fprintf (out, "\"BLOB value\"");
-			    break;
-			case SQLITE_NULL:
-			default:
-			    fprintf (out, "null");
-			    break;
-			};
-		  }
-		/* geometry */
-		if (indented)
-		    fprintf (out, "\r\n\t\t},\r\n\t\t\"geometry\" : ");
-		else
-		    fprintf (out, "},\"geometry\":");
-		switch (sqlite3_column_type (stmt, 0))
-		  {
-		  case SQLITE_NULL:
-		      fprintf (out, "null");
-		      break;
-		  default:
-		      tval = (const char *) sqlite3_column_text (stmt, 0);
-		      fprintf (out, "%s", tval);
-		      break;
-		  };
-		/* end Feature */
-		if (indented)
-		    fprintf (out, "\r\n\t}");
-		else
-		    fprintf (out, "}");
 		rows++;
 	    }
 	  else
@@ -6328,13 +6674,21 @@ dump_geojson2 (sqlite3 * sqlite, char *table, char *geom_col,
       {
 	  goto empty_result_set;
       }
+    if (!export_flush_batch (&job, workers, n_workers, out))
+	goto write_error;
     if (indented)
-	fprintf (out, "]\r\n}\r\n");
+	export_writer_puts (out, "]\r\n}\r\n");
     else
-	fprintf (out, "]}");
+	export_writer_puts (out, "]}");
 
     sqlite3_finalize (stmt);
-    fclose (out);
+    export_free_workers (&job, workers, n_workers);
+    do_free_prop_names (&job, cols);
+    if (!export_writer_close (out))
+      {
+	  out = NULL;
+	  goto write_error;
+      }
     *xrows = rows;
     return 1;
 
@@ -6344,9 +6698,11 @@ dump_geojson2 (sqlite3 * sqlite, char *table, char *geom_col,
       {
 	  sqlite3_finalize (stmt);
       }
+    export_free_workers (&job, workers, n_workers);
+    do_free_prop_names (&job, cols);
     if (out)
       {
-	  fclose (out);
+	  export_writer_close (out);
       }
     *error_message =
 	sqlite3_mprintf ("Dump GeoJSON2 error: %s\n", sqlite3_errmsg (sqlite));
@@ -6360,7 +6716,7 @@ dump_geojson2 (sqlite3 * sqlite, char *table, char *geom_col,
       }
     if (out)
       {
-	  fclose (out);
+	  export_writer_close (out);
       }
     if (geoname != NULL)
 	free (geoname);
@@ -6369,15 +6725,33 @@ dump_geojson2 (sqlite3 * sqlite, char *table, char *geom_col,
 			 outfile_path);
     return 0;
 
+  write_error:
+/* Output file could not be written */
+    if (stmt)
+      {
+	  sqlite3_finalize (stmt);
+      }
+    export_free_workers (&job, workers, n_workers);
+    do_free_prop_names (&job, cols);
+    if (out)
+      {
+	  export_writer_close (out);
+      }
+    *error_message =
+	sqlite3_mprintf ("ERROR: unable to write '%s'\n", outfile_path);
+    return 0;
+
   empty_result_set:
 /* the result set is empty - nothing to do */
     if (stmt)
       {
 	  sqlite3_finalize (stmt);
       }
+    export_free_workers (&job, workers, n_workers);
+    do_free_prop_names (&job, cols);
     if (out)
       {
-	  fclose (out);
+	  export_writer_close (out);
       }
     *error_message =
 	sqlite3_mprintf ("The SQL SELECT returned no data to export...\n");
@@ -6387,7 +6761,7 @@ dump_geojson2 (sqlite3 * sqlite, char *table, char *geom_col,
 /* not a valid Geometry Column */
     if (out)
       {
-	  fclose (out);
+	  export_writer_close (out);
       }
     *error_message = sqlite3_mprintf ("Not a valid Geometry Column.\n");
     return 0;
@@ -6396,7 +6770,7 @@ dump_geojson2 (sqlite3 * sqlite, char *table, char *geom_col,
 /* unable to create a valid SQL query */
     if (out)
       {
-	  fclose (out);
+	  export_writer_close (out);
       }
     *error_message = sqlite3_mprintf ("Unable to create a valid SQL query.\n");
     return 0;
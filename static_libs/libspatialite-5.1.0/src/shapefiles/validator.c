@@ -3668,6 +3668,696 @@ check_all_geometry_columns_r (const void *p_cache, sqlite3 * sqlite,
 					      x_invalids, err_msg);
 }
 
+/*
+/ table-level validation and repair
+/
+/ batches of rows (in ROWID order) are checked (and eventually repaired)
+/ by several worker threads, each one owning a private connection cache
+/ and thus a private GEOS / RTTOPO context; the Report table and the
+/ eventual in-place UPDATEs are then written by the calling thread
+/ preserving the same identical order of the input table
+*/
+
+#define GAIA_VALIDATOR_BATCH_ROWS	256
+#define GAIA_VALIDATOR_MAX_THREADS	64
+
+#define GAIA_VALIDATOR_CHECK_ONLY	0
+#define GAIA_VALIDATOR_LINEWORK		1
+#define GAIA_VALIDATOR_STRUCTURE	2
+#define GAIA_VALIDATOR_STRUCTURE_KEEP	3
+
+struct validator_item
+{
+/* a row of the current batch */
+    sqlite3_int64 rowid;
+    unsigned char *blob;
+    int blob_sz;
+    int valid;
+    char *reason;
+    unsigned char *location;
+    int location_sz;
+    unsigned char *repaired;
+    int repaired_sz;
+    int fits;
+};
+
+struct validator_worker
+{
+/* a worker thread */
+    const void *cache;
+    int first;
+    int step;
+    struct validator_item *items;
+    int n_items;
+    int method;
+    int declared_type;
+    int gpkg_mode;
+    int gpkg_amphibious;
+    int tiny_point;
+};
+
+static void
+set_validator_error (char **err_msg, const char *what, const char *detail)
+{
+/* returning an error message */
+    char *msg;
+    int len;
+    if (err_msg == NULL)
+	return;
+    if (*err_msg != NULL)
+	return;
+    if (detail == NULL)
+	msg = sqlite3_mprintf ("%s", what);
+    else
+	msg = sqlite3_mprintf ("%s: <%s>", what, detail);
+    len = strlen (msg);
+    *err_msg = malloc (len + 1);
+    strcpy (*err_msg, msg);
+    sqlite3_free (msg);
+}
+
+static int
+parse_validator_method (const char *method)
+{
+/* parsing the MakeValid method - returns -1 if not supported */
+    if (method == NULL)
+      {
+#ifdef ENABLE_RTTOPO		/* only if RTTOPO is enabled */
+	  return GAIA_VALIDATOR_LINEWORK;
+#else
+#ifdef GEOS_3100		/* only if GEOS 3.10.0 (or later) is supported */
+	  return GAIA_VALIDATOR_STRUCTURE;
+#else
+	  return -1;
+#endif
+#endif
+      }
+#ifdef ENABLE_RTTOPO		/* only if RTTOPO is enabled */
+    if (strcasecmp (method, "LINEWORK") == 0)
+	return GAIA_VALIDATOR_LINEWORK;
+#endif
+#ifdef GEOS_3100		/* only if GEOS 3.10.0 (or later) is supported */
+    if (strcasecmp (method, "STRUCTURE") == 0)
+	return GAIA_VALIDATOR_STRUCTURE;
+    if (strcasecmp (method, "STRUCTURE_KEEP_COLLAPSED") == 0)
+	return GAIA_VALIDATOR_STRUCTURE_KEEP;
+#endif
+    return -1;
+}
+
+static int
+check_validator_column (sqlite3 * sqlite, const char *table, const char *geom)
+{
+/* checks if a table-column effectively exists */
+    char *sql;
+    char *xtable;
+    int ret;
+    int i;
+    char **results;
+    int rows;
+    int columns;
+    int ok = 0;
+
+    xtable = gaiaDoubleQuotedSql (table);
+    sql = sqlite3_mprintf ("PRAGMA main.table_info(\"%s\")", xtable);
+    free (xtable);
+    ret = sqlite3_get_table (sqlite, sql, &results, &rows, &columns, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return 0;
+    for (i = 1; i <= rows; i++)
+      {
+	  const char *name = results[(i * columns) + 1];
+	  if (strcasecmp (name, geom) == 0)
+	      ok = 1;
+      }
+    sqlite3_free_table (results);
+    return ok;
+}
+
+static int
+do_fit_declared_type (gaiaGeomCollPtr geom, int gtype)
+{
+/* checks if a repaired Geometry fits the declared type of the column */
+    gaiaPointPtr pt;
+    gaiaLinestringPtr ln;
+    gaiaPolygonPtr pg;
+    int pts = 0;
+    int lns = 0;
+    int pgs = 0;
+    if (gtype < 0)
+	return 1;		/* unknown declared type */
+    pt = geom->FirstPoint;
+    while (pt != NULL)
+      {
+	  pts++;
+	  pt = pt->Next;
+      }
+    ln = geom->FirstLinestring;
+    while (ln != NULL)
+      {
+	  lns++;
+	  ln = ln->Next;
+      }
+    pg = geom->FirstPolygon;
+    while (pg != NULL)
+      {
+	  pgs++;
+	  pg = pg->Next;
+      }
+    switch (gtype % 1000)
+      {
+      case 0:
+	  return 1;
+      case 1:
+	  if (pts == 1 && lns == 0 && pgs == 0)
+	    {
+		geom->DeclaredType = GAIA_POINT;
+		return 1;
+	    }
+	  break;
+      case 2:
+	  if (pts == 0 && lns == 1 && pgs == 0)
+	    {
+		geom->DeclaredType = GAIA_LINESTRING;
+		return 1;
+	    }
+	  break;
+      case 3:
+	  if (pts == 0 && lns == 0 && pgs == 1)
+	    {
+		geom->DeclaredType = GAIA_POLYGON;
+		return 1;
+	    }
+	  break;
+      case 4:
+	  if (pts >= 1 && lns == 0 && pgs == 0)
+	    {
+		geom->DeclaredType = GAIA_MULTIPOINT;
+		return 1;
+	    }
+	  break;
+      case 5:
+	  if (pts == 0 && lns >= 1 && pgs == 0)
+	    {
+		geom->DeclaredType = GAIA_MULTILINESTRING;
+		return 1;
+	    }
+	  break;
+      case 6:
+	  if (pts == 0 && lns == 0 && pgs >= 1)
+	    {
+		geom->DeclaredType = GAIA_MULTIPOLYGON;
+		return 1;
+	    }
+	  break;
+      case 7:
+	  geom->DeclaredType = GAIA_GEOMETRYCOLLECTION;
+	  return 1;
+      };
+    return 0;
+}
+
+static gaiaGeomCollPtr
+do_validator_make_valid (struct validator_worker *worker,
+			 gaiaGeomCollPtr geom)
+{
+/* attempting to repair an invalid Geometry */
+    gaiaGeomCollPtr result = NULL;
+    switch (worker->method)
+      {
+#ifdef ENABLE_RTTOPO		/* only if RTTOPO is enabled */
+      case GAIA_VALIDATOR_LINEWORK:
+	  result = gaiaMakeValid (worker->cache, geom);
+	  break;
+#endif
+#ifdef GEOS_3100		/* only if GEOS 3.10.0 (or later) is supported */
+      case GAIA_VALIDATOR_STRUCTURE:
+	  result = gaiaGeosMakeValid_r (worker->cache, geom, 0);
+	  break;
+      case GAIA_VALIDATOR_STRUCTURE_KEEP:
+	  result = gaiaGeosMakeValid_r (worker->cache, geom, 1);
+	  break;
+#endif
+      };
+    if (result == NULL)
+	return NULL;
+    if (result->FirstPoint == NULL && result->FirstLinestring == NULL
+	&& result->FirstPolygon == NULL)
+      {
+	  /* empty result: beyond possible repair */
+	  gaiaFreeGeomColl (result);
+	  return NULL;
+      }
+    if (gaiaIsValid_r (worker->cache, result) != 1)
+      {
+	  gaiaFreeGeomColl (result);
+	  return NULL;
+      }
+    result->Srid = geom->Srid;
+    return result;
+}
+
+static void
+do_validate_item (struct validator_worker *worker,
+		  struct validator_item *item)
+{
+/* checking (and eventually repairing) a single Geometry */
+    gaiaGeomCollPtr geom;
+    gaiaGeomCollPtr location;
+    gaiaGeomCollPtr repaired;
+    geom =
+	gaiaFromSpatiaLiteBlobWkbEx (item->blob, item->blob_sz,
+				     worker->gpkg_mode, worker->gpkg_amphibious);
+    if (geom == NULL)
+      {
+	  const char *msg = "Invalid: not a BLOB-Geometry";
+	  item->valid = -1;
+	  item->reason = malloc (strlen (msg) + 1);
+	  strcpy (item->reason, msg);
+	  return;
+      }
+    item->valid = gaiaIsValid_r (worker->cache, geom);
+    if (item->valid == 1)
+      {
+	  gaiaFreeGeomColl (geom);
+	  return;
+      }
+    item->reason = gaiaIsValidReason_r (worker->cache, geom);
+    location = gaiaIsValidDetail_r (worker->cache, geom);
+    if (location != NULL)
+      {
+	  location->Srid = geom->Srid;
+	  gaiaToSpatiaLiteBlobWkbEx2 (location, &(item->location),
+				      &(item->location_sz), worker->gpkg_mode,
+				      worker->tiny_point);
+	  gaiaFreeGeomColl (location);
+      }
+    if (worker->method != GAIA_VALIDATOR_CHECK_ONLY)
+      {
+	  repaired = do_validator_make_valid (worker, geom);
+	  if (repaired != NULL)
+	    {
+		item->fits =
+		    do_fit_declared_type (repaired, worker->declared_type);
+		gaiaToSpatiaLiteBlobWkbEx2 (repaired, &(item->repaired),
+					    &(item->repaired_sz),
+					    worker->gpkg_mode,
+					    worker->tiny_point);
+		gaiaFreeGeomColl (repaired);
+	    }
+      }
+    gaiaFreeGeomColl (geom);
+}
+
+static void
+validator_worker (void *arg)
+{
+/* validating an interleaved subset of the current batch */
+    struct validator_worker *worker = (struct validator_worker *) arg;
+    int i;
+    for (i = worker->first; i < worker->n_items; i += worker->step)
+	do_validate_item (worker, worker->items + i);
+}
+
+static void
+do_reset_validator_items (struct validator_item *items, int count)
+{
+/* memory cleanup - resetting a batch of rows */
+    int i;
+    for (i = 0; i < count; i++)
+      {
+	  struct validator_item *item = items + i;
+	  if (item->blob != NULL)
+	      free (item->blob);
+	  if (item->reason != NULL)
+	      free (item->reason);
+	  if (item->location != NULL)
+	      free (item->location);
+	  if (item->repaired != NULL)
+	      free (item->repaired);
+      }
+}
+
+static int
+do_write_validator_item (sqlite3 * sqlite, sqlite3_stmt * stmt_report,
+			 sqlite3_stmt * stmt_update, int method,
+			 struct validator_item *item, int *n_repaired,
+			 int *n_failures, char **err_msg)
+{
+/* writing a single invalid row into the Report table */
+    int ret;
+    int updated = 0;
+    if (method != GAIA_VALIDATOR_CHECK_ONLY)
+      {
+	  if (item->repaired != NULL && item->fits && stmt_update != NULL)
+	    {
+		/* fixing the input row in place */
+		sqlite3_reset (stmt_update);
+		sqlite3_clear_bindings (stmt_update);
+		sqlite3_bind_blob (stmt_update, 1, item->repaired,
+				   item->repaired_sz, SQLITE_STATIC);
+		sqlite3_bind_int64 (stmt_update, 2, item->rowid);
+		ret = sqlite3_step (stmt_update);
+		if (ret == SQLITE_DONE || ret == SQLITE_ROW)
+		    updated = 1;
+		else
+		  {
+		      set_validator_error (err_msg, "UPDATE input table",
+					   sqlite3_errmsg (sqlite));
+		      return 0;
+		  }
+	    }
+	  if (item->repaired == NULL || (stmt_update != NULL && !updated))
+	      *n_failures += 1;
+	  else
+	      *n_repaired += 1;
+      }
+    sqlite3_reset (stmt_report);
+    sqlite3_clear_bindings (stmt_report);
+    sqlite3_bind_int64 (stmt_report, 1, item->rowid);
+    sqlite3_bind_int (stmt_report, 2, item->valid);
+    if (item->reason == NULL)
+	sqlite3_bind_null (stmt_report, 3);
+    else
+	sqlite3_bind_text (stmt_report, 3, item->reason,
+			   strlen (item->reason), SQLITE_STATIC);
+    if (item->location == NULL)
+	sqlite3_bind_null (stmt_report, 4);
+    else
+	sqlite3_bind_blob (stmt_report, 4, item->location,
+			   item->location_sz, SQLITE_STATIC);
+    if (method != GAIA_VALIDATOR_CHECK_ONLY)
+      {
+	  if (item->repaired == NULL)
+	      sqlite3_bind_null (stmt_report, 5);
+	  else
+	      sqlite3_bind_blob (stmt_report, 5, item->repaired,
+				 item->repaired_sz, SQLITE_STATIC);
+	  sqlite3_bind_int (stmt_report, 6, updated);
+      }
+    ret = sqlite3_step (stmt_report);
+    if (ret == SQLITE_DONE || ret == SQLITE_ROW)
+	return 1;
+    set_validator_error (err_msg, "INSERT INTO report table",
+			 sqlite3_errmsg (sqlite));
+    return 0;
+}
+
+static int
+do_validate_table (const void *p_cache, sqlite3 * sqlite, const char *table,
+		   const char *geom, const char *report_table, int method,
+		   int fix_in_place, int threads, int *x_rows,
+		   int *x_invalids, int *x_repaired, int *x_failures,
+		   char **err_msg)
+{
+/* validating (and eventually repairing) a whole table - parallel mode */
+    struct validator_worker *workers = NULL;
+    struct validator_item *items = NULL;
+    void *args[GAIA_VALIDATOR_MAX_THREADS];
+    sqlite3_stmt *stmt_in = NULL;
+    sqlite3_stmt *stmt_report = NULL;
+    sqlite3_stmt *stmt_update = NULL;
+    char *sql;
+    char *xtable;
+    char *xgeom;
+    char *xreport;
+    int ret;
+    int i;
+    int count;
+    int max_items;
+    int n_items = 0;
+    int done = 0;
+    int n_rows = 0;
+    int n_invalids = 0;
+    int n_repaired = 0;
+    int n_failures = 0;
+    int declared_type = -1;
+    int srid;
+    int retcode = 0;
+    int gpkg_mode = 0;
+    int gpkg_amphibious = 0;
+    int tiny_point = 0;
+    struct splite_internal_cache *cache =
+	(struct splite_internal_cache *) p_cache;
+
+    if (err_msg != NULL)
+	*err_msg = NULL;
+    if (cache == NULL)
+      {
+	  set_validator_error (err_msg, "invalid connection cache", NULL);
+	  return 0;
+      }
+    if (table == NULL || geom == NULL || report_table == NULL)
+      {
+	  set_validator_error (err_msg, "invalid arguments", NULL);
+	  return 0;
+      }
+    gpkg_mode = cache->gpkg_mode;
+    gpkg_amphibious = cache->gpkg_amphibious_mode;
+    tiny_point = cache->tinyPointEnabled;
+    if (threads <= 0)
+	threads = splite_get_cpu_count ();
+    if (threads > GAIA_VALIDATOR_MAX_THREADS)
+	threads = GAIA_VALIDATOR_MAX_THREADS;
+    if (!check_validator_column (sqlite, table, geom))
+      {
+	  set_validator_error (err_msg, "no such table-column", table);
+	  return 0;
+      }
+    if (fix_in_place && method != GAIA_VALIDATOR_CHECK_ONLY)
+      {
+	  /* repaired Geometries must fit the declared type */
+	  if (!check_table_column (sqlite, table, geom, &declared_type, &srid))
+	      declared_type = -1;
+      }
+
+/* creating the Report table */
+    xreport = gaiaDoubleQuotedSql (report_table);
+    if (method == GAIA_VALIDATOR_CHECK_ONLY)
+	sql = sqlite3_mprintf ("CREATE TABLE main.\"%s\" ("
+			       "origin_rowid INTEGER PRIMARY KEY, "
+			       "valid INTEGER NOT NULL, reason TEXT, "
+			       "location BLOB)", xreport);
+    else
+	sql = sqlite3_mprintf ("CREATE TABLE main.\"%s\" ("
+			       "origin_rowid INTEGER PRIMARY KEY, "
+			       "valid INTEGER NOT NULL, reason TEXT, "
+			       "location BLOB, repaired BLOB, "
+			       "updated INTEGER NOT NULL)", xreport);
+    ret = sqlite3_exec (sqlite, sql, NULL, NULL, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  free (xreport);
+	  set_validator_error (err_msg, "CREATE report table",
+			       sqlite3_errmsg (sqlite));
+	  return 0;
+      }
+    if (method == GAIA_VALIDATOR_CHECK_ONLY)
+	sql = sqlite3_mprintf ("INSERT INTO main.\"%s\" (origin_rowid, "
+			       "valid, reason, location) VALUES (?, ?, ?, ?)",
+			       xreport);
+    else
+	sql = sqlite3_mprintf ("INSERT INTO main.\"%s\" (origin_rowid, "
+			       "valid, reason, location, repaired, updated) "
+			       "VALUES (?, ?, ?, ?, ?, ?)", xreport);
+    free (xreport);
+    ret = sqlite3_prepare_v2 (sqlite, sql, strlen (sql), &stmt_report, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  set_validator_error (err_msg, "INSERT INTO report table",
+			       sqlite3_errmsg (sqlite));
+	  goto end;
+      }
+
+/* creating the input Prepared Statements */
+    xtable = gaiaDoubleQuotedSql (table);
+    xgeom = gaiaDoubleQuotedSql (geom);
+    sql = sqlite3_mprintf ("SELECT ROWID, \"%s\" FROM main.\"%s\" "
+			   "ORDER BY ROWID", xgeom, xtable);
+    ret = sqlite3_prepare_v2 (sqlite, sql, strlen (sql), &stmt_in, NULL);
+    sqlite3_free (sql);
+    if (ret == SQLITE_OK && fix_in_place
+	&& method != GAIA_VALIDATOR_CHECK_ONLY)
+      {
+	  sql = sqlite3_mprintf ("UPDATE main.\"%s\" SET \"%s\" = ? "
+				 "WHERE ROWID = ?", xtable, xgeom);
+	  ret =
+	      sqlite3_prepare_v2 (sqlite, sql, strlen (sql), &stmt_update,
+				  NULL);
+	  sqlite3_free (sql);
+      }
+    free (xtable);
+    free (xgeom);
+    if (ret != SQLITE_OK)
+      {
+	  set_validator_error (err_msg, "input table",
+			       sqlite3_errmsg (sqlite));
+	  goto end;
+      }
+
+/* preparing the worker threads */
+    workers = malloc (sizeof (struct validator_worker) * threads);
+    for (i = 0; i < threads; i++)
+      {
+	  struct validator_worker *worker = workers + i;
+	  if (i == 0)
+	      worker->cache = p_cache;
+	  else
+	      worker->cache = spatialite_alloc_connection ();
+	  worker->first = i;
+	  worker->step = threads;
+	  worker->items = NULL;
+	  worker->n_items = 0;
+	  worker->method = method;
+	  worker->declared_type = declared_type;
+	  worker->gpkg_mode = gpkg_mode;
+	  worker->gpkg_amphibious = gpkg_amphibious;
+	  worker->tiny_point = tiny_point;
+      }
+    max_items = GAIA_VALIDATOR_BATCH_ROWS * threads;
+    items = malloc (sizeof (struct validator_item) * max_items);
+
+    while (!done)
+      {
+	  /* loading a batch of rows */
+	  while (n_items < max_items)
+	    {
+		struct validator_item *item;
+		ret = sqlite3_step (stmt_in);
+		if (ret == SQLITE_DONE)
+		  {
+		      done = 1;
+		      break;
+		  }
+		if (ret != SQLITE_ROW)
+		  {
+		      set_validator_error (err_msg, "SELECT FROM input table",
+					   sqlite3_errmsg (sqlite));
+		      goto end;
+		  }
+		if (sqlite3_column_type (stmt_in, 1) != SQLITE_BLOB)
+		    continue;	/* skipping NULL Geometries */
+		item = items + n_items++;
+		item->rowid = sqlite3_column_int64 (stmt_in, 0);
+		item->blob_sz = sqlite3_column_bytes (stmt_in, 1);
+		item->blob = malloc (item->blob_sz);
+		memcpy (item->blob, sqlite3_column_blob (stmt_in, 1),
+			item->blob_sz);
+		item->valid = 1;
+		item->reason = NULL;
+		item->location = NULL;
+		item->location_sz = 0;
+		item->repaired = NULL;
+		item->repaired_sz = 0;
+		item->fits = 1;
+	    }
+	  if (n_items == 0)
+	      break;
+
+	  /* validating the current batch in parallel */
+	  count = threads;
+	  if (count > n_items)
+	      count = n_items;
+	  for (i = 0; i < count; i++)
+	    {
+		struct validator_worker *worker = workers + i;
+		worker->items = items;
+		worker->n_items = n_items;
+		worker->step = count;
+		args[i] = worker;
+	    }
+	  splite_run_threads (count, validator_worker, args);
+
+	  /* writing all invalid rows in the input order */
+	  for (i = 0; i < n_items; i++)
+	    {
+		struct validator_item *item = items + i;
+		n_rows++;
+		if (item->valid == 1)
+		    continue;
+		n_invalids++;
+		if (!do_write_validator_item
+		    (sqlite, stmt_report, stmt_update, method, item,
+		     &n_repaired, &n_failures, err_msg))
+		    goto end;
+	    }
+	  do_reset_validator_items (items, n_items);
+	  n_items = 0;
+      }
+    retcode = 1;
+
+  end:
+    if (stmt_in != NULL)
+	sqlite3_finalize (stmt_in);
+    if (stmt_report != NULL)
+	sqlite3_finalize (stmt_report);
+    if (stmt_update != NULL)
+	sqlite3_finalize (stmt_update);
+    if (items != NULL)
+      {
+	  do_reset_validator_items (items, n_items);
+	  free (items);
+      }
+    if (workers != NULL)
+      {
+	  for (i = 1; i < threads; i++)
+	    {
+		struct validator_worker *worker = workers + i;
+		spatialite_internal_cleanup (worker->cache);
+	    }
+	  free (workers);
+      }
+    if (retcode)
+      {
+	  if (x_rows != NULL)
+	      *x_rows = n_rows;
+	  if (x_invalids != NULL)
+	      *x_invalids = n_invalids;
+	  if (x_repaired != NULL)
+	      *x_repaired = n_repaired;
+	  if (x_failures != NULL)
+	      *x_failures = n_failures;
+      }
+    return retcode;
+}
+
+SPATIALITE_DECLARE int
+check_geometry_table_r (const void *p_cache, sqlite3 * sqlite,
+			const char *table, const char *geom,
+			const char *report_table, int threads, int *n_rows,
+			int *n_invalids, char **err_msg)
+{
+/* checking a whole table for validity - parallel mode */
+    return do_validate_table (p_cache, sqlite, table, geom, report_table,
+			      GAIA_VALIDATOR_CHECK_ONLY, 0, threads, n_rows,
+			      n_invalids, NULL, NULL, err_msg);
+}
+
+SPATIALITE_DECLARE int
+sanitize_geometry_table_r (const void *p_cache, sqlite3 * sqlite,
+			   const char *table, const char *geom,
+			   const char *report_table, const char *method,
+			   int fix_in_place, int threads, int *n_invalids,
+			   int *n_repaired, int *n_failures, char **err_msg)
+{
+/* repairing all invalid geometries of a whole table - parallel mode */
+    int mode = parse_validator_method (method);
+    if (err_msg != NULL)
+	*err_msg = NULL;
+    if (mode < 0)
+      {
+	  set_validator_error (err_msg, "unsupported MakeValid method",
+			       method);
+	  return 0;
+      }
+    return do_validate_table (p_cache, sqlite, table, geom, report_table,
+			      mode, fix_in_place, threads, NULL, n_invalids,
+			      n_repaired, n_failures, err_msg);
+}
+
 #else
 
 SPATIALITE_DECLARE int
@@ -3763,4 +4453,57 @@ check_geometry_column_r (const void *p_cache, sqlite3 * sqlite,
     return 0;
 }
 
+
+SPATIALITE_DECLARE int
+check_geometry_table_r (const void *p_cache, sqlite3 * sqlite,
+			const char *table, const char *geom,
+			const char *report_table, int threads, int *n_rows,
+			int *n_invalids, char **err_msg)
+{
+/* GEOS isn't enabled: always returning an error */
+    int len;
+    const char *msg = "Sorry ... libspatialite was built disabling GEOS\n"
+	"and is thus unable to support IsValid";
+
+/* silencing stupid compiler warnings */
+    if (p_cache == NULL || sqlite == NULL || table == NULL || geom == NULL ||
+	report_table == NULL || threads == 0 || n_rows == NULL
+	|| n_invalids == NULL)
+	table = NULL;
+
+    if (err_msg == NULL)
+	return 0;
+    len = strlen (msg);
+    *err_msg = malloc (len + 1);
+    strcpy (*err_msg, msg);
+    return 0;
+}
+
+SPATIALITE_DECLARE int
+sanitize_geometry_table_r (const void *p_cache, sqlite3 * sqlite,
+			   const char *table, const char *geom,
+			   const char *report_table, const char *method,
+			   int fix_in_place, int threads, int *n_invalids,
+			   int *n_repaired, int *n_failures, char **err_msg)
+{
+/* GEOS isn't enabled: always returning an error */
+    int len;
+    const char *msg = "Sorry ... libspatialite was built disabling GEOS\n"
+	"and is thus unable to support MakeValid";
+
+/* silencing stupid compiler warnings */
+    if (p_cache == NULL || sqlite == NULL || table == NULL || geom == NULL ||
+	report_table == NULL || method == NULL || fix_in_place == 0
+	|| threads == 0 || n_invalids == NULL || n_repaired == NULL
+	|| n_failures == NULL)
+	table = NULL;
+
+    if (err_msg == NULL)
+	return 0;
+    len = strlen (msg);
+    *err_msg = malloc (len + 1);
+    strcpy (*err_msg, msg);
+    return 0;
+}
+
 #endif /* end GEOS conditionals */
@@ -1442,6 +1442,12 @@ fnct_GeometryConstraints (sqlite3_context * context, int argc,
 	  break;
       default:
 	  geom_normalized_type = geom_type;
+	  if (geom_type > GAIA_TWKB_BLOB
+	      && geom_type <= GAIA_TWKB_BLOB + GAIA_GEOMETRYCOLLECTIONZM)
+	    {
+		/* adjusting TWKB compressed Geometries */
+		geom_normalized_type = geom_type - GAIA_TWKB_BLOB;
+	    }
 	  break;
       };
     if (strcasecmp ((char *) type, "GEOMETRY") == 0)
@@ -11892,6 +11898,7 @@ fnct_AsGeoJSON (sqlite3_context * context, int argc, sqlite3_value ** argv)
 / AsGeoJSON(BLOB encoded geometry, integer precision, integer options)
 /
 / *precision* is the number of output decimal digits
+/ (a negative value selects the shortest round-trip representation)
 / default *precision*: 15
 /
 / *options* may be one of the followings:
@@ -15172,15 +15179,26 @@ fnct_CompressGeometry (sqlite3_context * context, int argc,
 {
 /* SQL function:
 / CompressGeometry(BLOB encoded geometry)
+/ CompressGeometry(BLOB encoded geometry, int precision_xy)
+/ CompressGeometry(BLOB encoded geometry, int precision_xy,
+/                  int precision_z)
+/ CompressGeometry(BLOB encoded geometry, int precision_xy,
+/                  int precision_z, int precision_m)
 /
 / returns a COMPRESSED geometry [if a valid Geometry was supplied]
 / or NULL in any other case
+/ when a precision is set the TWKB compressed format will be used
+/ (coordinates rounded to the given number of decimal digits)
 */
     unsigned char *p_blob;
     int n_bytes;
     int len;
     unsigned char *p_result = NULL;
     gaiaGeomCollPtr geo = NULL;
+    int precision_xy = 0;
+    int precision_z = 0;
+    int precision_m = 0;
+    int ia;
     int gpkg_amphibious = 0;
     int gpkg_mode = 0;
     struct splite_internal_cache *cache = sqlite3_user_data (context);
@@ -15195,6 +15213,29 @@ fnct_CompressGeometry (sqlite3_context * context, int argc,
 	  sqlite3_result_null (context);
 	  return;
       }
+    for (ia = 1; ia < argc; ia++)
+      {
+	  if (sqlite3_value_type (argv[ia]) != SQLITE_INTEGER)
+	    {
+		sqlite3_result_null (context);
+		return;
+	    }
+      }
+    if (argc >= 2)
+      {
+	  precision_xy = sqlite3_value_int (argv[1]);
+	  /* Z and M precisions default to the XY one */
+	  precision_z = precision_xy;
+	  if (precision_z < 0)
+	      precision_z = 0;
+	  if (precision_z > 7)
+	      precision_z = 7;
+	  precision_m = precision_z;
+      }
+    if (argc >= 3)
+	precision_z = sqlite3_value_int (argv[2]);
+    if (argc >= 4)
+	precision_m = sqlite3_value_int (argv[3]);
     p_blob = (unsigned char *) sqlite3_value_blob (argv[0]);
     n_bytes = sqlite3_value_bytes (argv[0]);
     geo =
@@ -15204,8 +15245,15 @@ fnct_CompressGeometry (sqlite3_context * context, int argc,
 	sqlite3_result_null (context);
     else
       {
-	  gaiaToCompressedBlobWkb (geo, &p_result, &len);
-	  sqlite3_result_blob (context, p_result, len, free);
+	  if (argc >= 2)
+	      gaiaToTwkbBlobWkb (geo, precision_xy, precision_z, precision_m,
+				 &p_result, &len);
+	  else
+	      gaiaToCompressedBlobWkb (geo, &p_result, &len);
+	  if (p_result == NULL)
+	      sqlite3_result_null (context);
+	  else
+	      sqlite3_result_blob (context, p_result, len, free);
       }
     gaiaFreeGeomColl (geo);
 }
@@ -17949,7 +17997,7 @@ fnct_Envelope (sqlite3_context * context, int argc, sqlite3_value ** argv)
     p_blob = (unsigned char *) sqlite3_value_blob (argv[0]);
     n_bytes = sqlite3_value_bytes (argv[0]);
     geo =
-	gaiaFromSpatiaLiteBlobWkbEx (p_blob, n_bytes, gpkg_mode,
+	gaiaFromSpatiaLiteBlobMbrEx (p_blob, n_bytes, gpkg_mode,
 				     gpkg_amphibious);
     if (!geo)
 	sqlite3_result_null (context);
@@ -18467,7 +18515,7 @@ fnct_Extent_step (sqlite3_context * context, int argc, sqlite3_value ** argv)
     p_blob = (unsigned char *) sqlite3_value_blob (argv[0]);
     n_bytes = sqlite3_value_bytes (argv[0]);
     geom =
-	gaiaFromSpatiaLiteBlobWkbEx (p_blob, n_bytes, gpkg_mode,
+	gaiaFromSpatiaLiteBlobMbrEx (p_blob, n_bytes, gpkg_mode,
 				     gpkg_amphibious);
     if (!geom)
 	return;
@@ -18606,15 +18654,8 @@ fnct_MbrMinX (sqlite3_context * context, int argc, sqlite3_value ** argv)
 		double max_x;
 		double min_y;
 		double max_y;
-		int has_z;
-		double min_z;
-		double max_z;
-		int has_m;
-		double min_m;
-		double max_m;
-		if (gaiaGetEnvelopeFromGPB
-		    (p_blob, n_bytes, &min_x, &max_x, &min_y, &max_y, &has_z,
-		     &min_z, &max_z, &has_m, &min_m, &max_m))
+		if (gaiaGetMbrFromGPB
+		    (p_blob, n_bytes, &min_x, &max_x, &min_y, &max_y))
 		  {
 		      sqlite3_result_double (context, min_x);
 		  }
@@ -18656,15 +18697,8 @@ fnct_MbrMaxX (sqlite3_context * context, int argc, sqlite3_value ** argv)
 		double max_x;
 		double min_y;
 		double max_y;
-		int has_z;
-		double min_z;
-		double max_z;
-		int has_m;
-		double min_m;
-		double max_m;
-		if (gaiaGetEnvelopeFromGPB
-		    (p_blob, n_bytes, &min_x, &max_x, &min_y, &max_y, &has_z,
-		     &min_z, &max_z, &has_m, &min_m, &max_m))
+		if (gaiaGetMbrFromGPB
+		    (p_blob, n_bytes, &min_x, &max_x, &min_y, &max_y))
 		  {
 		      sqlite3_result_double (context, max_x);
 		  }
@@ -18706,15 +18740,8 @@ fnct_MbrMinY (sqlite3_context * context, int argc, sqlite3_value ** argv)
 		double max_x;
 		double min_y;
 		double max_y;
-		int has_z;
-		double min_z;
-		double max_z;
-		int has_m;
-		double min_m;
-		double max_m;
-		if (gaiaGetEnvelopeFromGPB
-		    (p_blob, n_bytes, &min_x, &max_x, &min_y, &max_y, &has_z,
-		     &min_z, &max_z, &has_m, &min_m, &max_m))
+		if (gaiaGetMbrFromGPB
+		    (p_blob, n_bytes, &min_x, &max_x, &min_y, &max_y))
 		  {
 		      sqlite3_result_double (context, min_y);
 		  }
@@ -18756,15 +18783,8 @@ fnct_MbrMaxY (sqlite3_context * context, int argc, sqlite3_value ** argv)
 		double max_x;
 		double min_y;
 		double max_y;
-		int has_z;
-		double min_z;
-		double max_z;
-		int has_m;
-		double min_m;
-		double max_m;
-		if (gaiaGetEnvelopeFromGPB
-		    (p_blob, n_bytes, &min_x, &max_x, &min_y, &max_y, &has_z,
-		     &min_z, &max_z, &has_m, &min_m, &max_m))
+		if (gaiaGetMbrFromGPB
+		    (p_blob, n_bytes, &min_x, &max_x, &min_y, &max_y))
 		  {
 		      sqlite3_result_double (context, max_y);
 		  }
@@ -21759,7 +21779,15 @@ mbrs_eval (sqlite3_context * context, int argc, sqlite3_value ** argv,
     int ret;
     gaiaGeomCollPtr geo1 = NULL;
     gaiaGeomCollPtr geo2 = NULL;
+    int gpkg_amphibious = 0;
+    struct splite_internal_cache *cache = sqlite3_user_data (context);
     GAIA_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (cache != NULL)
+      {
+	  /* SpatiaLite BLOBs always are accepted, even in GPKG mode */
+	  if (cache->gpkg_amphibious_mode || cache->gpkg_mode)
+	      gpkg_amphibious = 1;
+      }
     if (sqlite3_value_type (argv[0]) != SQLITE_BLOB)
       {
 	  sqlite3_result_int (context, -1);
@@ -21772,10 +21800,12 @@ mbrs_eval (sqlite3_context * context, int argc, sqlite3_value ** argv,
       }
     p_blob = (unsigned char *) sqlite3_value_blob (argv[0]);
     n_bytes = sqlite3_value_bytes (argv[0]);
-    geo1 = gaiaFromSpatiaLiteBlobMbr (p_blob, n_bytes);
+    geo1 =
+	gaiaFromSpatiaLiteBlobMbrEx (p_blob, n_bytes, 0, gpkg_amphibious);
     p_blob = (unsigned char *) sqlite3_value_blob (argv[1]);
     n_bytes = sqlite3_value_bytes (argv[1]);
-    geo2 = gaiaFromSpatiaLiteBlobMbr (p_blob, n_bytes);
+    geo2 =
+	gaiaFromSpatiaLiteBlobMbrEx (p_blob, n_bytes, 0, gpkg_amphibious);
     if (!geo1 || !geo2)
 	sqlite3_result_int (context, -1);
     else
@@ -21935,7 +21965,7 @@ fnct_EnvIntersects (sqlite3_context * context, int argc, sqlite3_value ** argv)
     p_blob = (unsigned char *) sqlite3_value_blob (argv[0]);
     n_bytes = sqlite3_value_bytes (argv[0]);
     geo1 =
-	gaiaFromSpatiaLiteBlobWkbEx (p_blob, n_bytes, gpkg_mode,
+	gaiaFromSpatiaLiteBlobMbrEx (p_blob, n_bytes, gpkg_mode,
 				     gpkg_amphibious);
     if (!geo1)
 	sqlite3_result_int (context, -1);
@@ -24805,6 +24835,154 @@ fnct_IsValidDetail (sqlite3_context * context, int argc, sqlite3_value ** argv)
 	gaiaFreeGeomColl (detail);
 }
 
+static void
+fnct_CheckGeometryTable (sqlite3_context * context, int argc,
+			 sqlite3_value ** argv)
+{
+/* SQL function:
+/ CheckGeometryTable(TEXT table, TEXT geom_column, TEXT report_table)
+/ CheckGeometryTable(TEXT table, TEXT geom_column, TEXT report_table,
+/                    INT threads)
+/
+/ checks all Geometries of a table for validity, splitting the work
+/ across several threads (zero or negative: as many threads as the
+/ available CPU cores); a row for each invalid Geometry will be
+/ inserted into the Report table (that will be created in MAIN)
+/
+/ returns the number of invalid Geometries
+/ -1 on failure, NULL on invalid arguments
+*/
+    const char *table;
+    const char *geom;
+    const char *report_table;
+    int threads = 0;
+    int n_invalids = 0;
+    char *err_msg = NULL;
+    sqlite3 *sqlite = sqlite3_context_db_handle (context);
+    void *cache = sqlite3_user_data (context);
+    GAIA_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) != SQLITE_TEXT
+	|| sqlite3_value_type (argv[1]) != SQLITE_TEXT
+	|| sqlite3_value_type (argv[2]) != SQLITE_TEXT)
+      {
+	  sqlite3_result_null (context);
+	  return;
+      }
+    table = (const char *) sqlite3_value_text (argv[0]);
+    geom = (const char *) sqlite3_value_text (argv[1]);
+    report_table = (const char *) sqlite3_value_text (argv[2]);
+    if (argc >= 4)
+      {
+	  if (sqlite3_value_type (argv[3]) != SQLITE_INTEGER)
+	    {
+		sqlite3_result_null (context);
+		return;
+	    }
+	  threads = sqlite3_value_int (argv[3]);
+      }
+    if (!check_geometry_table_r
+	(cache, sqlite, table, geom, report_table, threads, NULL,
+	 &n_invalids, &err_msg))
+      {
+	  if (err_msg != NULL)
+	    {
+		spatialite_e ("CheckGeometryTable error: %s\n", err_msg);
+		free (err_msg);
+	    }
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    sqlite3_result_int (context, n_invalids);
+}
+
+static void
+fnct_SanitizeGeometryTable (sqlite3_context * context, int argc,
+			    sqlite3_value ** argv)
+{
+/* SQL function:
+/ SanitizeGeometryTable(TEXT table, TEXT geom_column, TEXT report_table)
+/ SanitizeGeometryTable(TEXT table, TEXT geom_column, TEXT report_table,
+/                       TEXT method)
+/ SanitizeGeometryTable(TEXT table, TEXT geom_column, TEXT report_table,
+/                       TEXT method, INT fix_in_place)
+/ SanitizeGeometryTable(TEXT table, TEXT geom_column, TEXT report_table,
+/                       TEXT method, INT fix_in_place, INT threads)
+/
+/ attempts to repair all invalid Geometries of a table, splitting the
+/ work across several threads; method could be 'LINEWORK' (RTTOPO),
+/ 'STRUCTURE' or 'STRUCTURE_KEEP_COLLAPSED' (GEOS 3.10.0 or later)
+/ and NULL stands for the default method.
+/ a row for each invalid Geometry will be inserted into the Report
+/ table (that will be created in MAIN); when fix_in_place is set
+/ all repaired Geometries will be written back into the input table
+/
+/ returns the number of repaired Geometries
+/ -1 on failure, NULL on invalid arguments
+*/
+    const char *table;
+    const char *geom;
+    const char *report_table;
+    const char *method = NULL;
+    int fix_in_place = 0;
+    int threads = 0;
+    int n_repaired = 0;
+    char *err_msg = NULL;
+    sqlite3 *sqlite = sqlite3_context_db_handle (context);
+    void *cache = sqlite3_user_data (context);
+    GAIA_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) != SQLITE_TEXT
+	|| sqlite3_value_type (argv[1]) != SQLITE_TEXT
+	|| sqlite3_value_type (argv[2]) != SQLITE_TEXT)
+      {
+	  sqlite3_result_null (context);
+	  return;
+      }
+    table = (const char *) sqlite3_value_text (argv[0]);
+    geom = (const char *) sqlite3_value_text (argv[1]);
+    report_table = (const char *) sqlite3_value_text (argv[2]);
+    if (argc >= 4)
+      {
+	  if (sqlite3_value_type (argv[3]) == SQLITE_TEXT)
+	      method = (const char *) sqlite3_value_text (argv[3]);
+	  else if (sqlite3_value_type (argv[3]) != SQLITE_NULL)
+	    {
+		sqlite3_result_null (context);
+		return;
+	    }
+      }
+    if (argc >= 5)
+      {
+	  if (sqlite3_value_type (argv[4]) != SQLITE_INTEGER)
+	    {
+		sqlite3_result_null (context);
+		return;
+	    }
+	  fix_in_place = sqlite3_value_int (argv[4]);
+      }
+    if (argc >= 6)
+      {
+	  if (sqlite3_value_type (argv[5]) != SQLITE_INTEGER)
+	    {
+		sqlite3_result_null (context);
+		return;
+	    }
+	  threads = sqlite3_value_int (argv[5]);
+      }
+    if (!sanitize_geometry_table_r
+	(cache, sqlite, table, geom, report_table, method, fix_in_place,
+	 threads, NULL, &n_repaired, NULL, &err_msg))
+      {
+	  if (err_msg != NULL)
+	    {
+		spatialite_e ("SanitizeGeometryTable error: %s\n", err_msg);
+		free (err_msg);
+	    }
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    sqlite3_result_int (context, n_repaired);
+}
+
 static void
 fnct_Boundary (sqlite3_context * context, int argc, sqlite3_value ** argv)
 {
@@ -27473,10 +27651,23 @@ fnct_Intersects (sqlite3_context * context, int argc, sqlite3_value ** argv)
       }
     blob1 = (unsigned char *) sqlite3_value_blob (argv[0]);
     bytes1 = sqlite3_value_bytes (argv[0]);
-    geo1 =
-	gaiaFromSpatiaLiteBlobWkbEx (blob1, bytes1, gpkg_mode, gpkg_amphibious);
     blob2 = (unsigned char *) sqlite3_value_blob (argv[1]);
     bytes2 = sqlite3_value_bytes (argv[1]);
+#ifdef GEOS_3120		/* only if GEOS 3.12.0 (or later) is supported */
+    if (cache != NULL && (!gpkg_mode || gpkg_amphibious))
+      {
+	  /* Point-in-Polygon fast path */
+	  if (gaiaGeomCollPreparedPointXY
+	      (cache, blob1, bytes1, blob2, bytes2, GAIA_PREPARED_INTERSECTS,
+	       &ret))
+	    {
+		sqlite3_result_int (context, ret);
+		return;
+	    }
+      }
+#endif /* end GEOS_3120 conditional */
+    geo1 =
+	gaiaFromSpatiaLiteBlobWkbEx (blob1, bytes1, gpkg_mode, gpkg_amphibious);
     geo2 =
 	gaiaFromSpatiaLiteBlobWkbEx (blob2, bytes2, gpkg_mode, gpkg_amphibious);
     if (!geo1 || !geo2)
@@ -27783,10 +27974,23 @@ fnct_Within (sqlite3_context * context, int argc, sqlite3_value ** argv)
       }
     blob1 = (unsigned char *) sqlite3_value_blob (argv[0]);
     bytes1 = sqlite3_value_bytes (argv[0]);
-    geo1 =
-	gaiaFromSpatiaLiteBlobWkbEx (blob1, bytes1, gpkg_mode, gpkg_amphibious);
     blob2 = (unsigned char *) sqlite3_value_blob (argv[1]);
     bytes2 = sqlite3_value_bytes (argv[1]);
+#ifdef GEOS_3120		/* only if GEOS 3.12.0 (or later) is supported */
+    if (cache != NULL && (!gpkg_mode || gpkg_amphibious))
+      {
+	  /* Point-in-Polygon fast path */
+	  if (gaiaGeomCollPreparedPointXY
+	      (cache, blob1, bytes1, blob2, bytes2, GAIA_PREPARED_WITHIN,
+	       &ret))
+	    {
+		sqlite3_result_int (context, ret);
+		return;
+	    }
+      }
+#endif /* end GEOS_3120 conditional */
+    geo1 =
+	gaiaFromSpatiaLiteBlobWkbEx (blob1, bytes1, gpkg_mode, gpkg_amphibious);
     geo2 =
 	gaiaFromSpatiaLiteBlobWkbEx (blob2, bytes2, gpkg_mode, gpkg_amphibious);
     if (!geo1 || !geo2)
@@ -27845,10 +28049,23 @@ fnct_Contains (sqlite3_context * context, int argc, sqlite3_value ** argv)
       }
     blob1 = (unsigned char *) sqlite3_value_blob (argv[0]);
     bytes1 = sqlite3_value_bytes (argv[0]);
-    geo1 =
-	gaiaFromSpatiaLiteBlobWkbEx (blob1, bytes1, gpkg_mode, gpkg_amphibious);
     blob2 = (unsigned char *) sqlite3_value_blob (argv[1]);
     bytes2 = sqlite3_value_bytes (argv[1]);
+#ifdef GEOS_3120		/* only if GEOS 3.12.0 (or later) is supported */
+    if (cache != NULL && (!gpkg_mode || gpkg_amphibious))
+      {
+	  /* Point-in-Polygon fast path */
+	  if (gaiaGeomCollPreparedPointXY
+	      (cache, blob1, bytes1, blob2, bytes2, GAIA_PREPARED_CONTAINS,
+	       &ret))
+	    {
+		sqlite3_result_int (context, ret);
+		return;
+	    }
+      }
+#endif /* end GEOS_3120 conditional */
+    geo1 =
+	gaiaFromSpatiaLiteBlobWkbEx (blob1, bytes1, gpkg_mode, gpkg_amphibious);
     geo2 =
 	gaiaFromSpatiaLiteBlobWkbEx (blob2, bytes2, gpkg_mode, gpkg_amphibious);
     if (!geo1 || !geo2)
@@ -30558,10 +30775,23 @@ fnct_Covers (sqlite3_context * context, int argc, sqlite3_value ** argv)
       }
     blob1 = (unsigned char *) sqlite3_value_blob (argv[0]);
     bytes1 = sqlite3_value_bytes (argv[0]);
-    geo1 =
-	gaiaFromSpatiaLiteBlobWkbEx (blob1, bytes1, gpkg_mode, gpkg_amphibious);
     blob2 = (unsigned char *) sqlite3_value_blob (argv[1]);
     bytes2 = sqlite3_value_bytes (argv[1]);
+#ifdef GEOS_3120		/* only if GEOS 3.12.0 (or later) is supported */
+    if (cache != NULL && (!gpkg_mode || gpkg_amphibious))
+      {
+	  /* Point-in-Polygon fast path */
+	  if (gaiaGeomCollPreparedPointXY
+	      (cache, blob1, bytes1, blob2, bytes2, GAIA_PREPARED_COVERS,
+	       &ret))
+	    {
+		sqlite3_result_int (context, ret);
+		return;
+	    }
+      }
+#endif /* end GEOS_3120 conditional */
+    geo1 =
+	gaiaFromSpatiaLiteBlobWkbEx (blob1, bytes1, gpkg_mode, gpkg_amphibious);
     geo2 =
 	gaiaFromSpatiaLiteBlobWkbEx (blob2, bytes2, gpkg_mode, gpkg_amphibious);
     if (!geo1 || !geo2)
@@ -30620,10 +30850,23 @@ fnct_CoveredBy (sqlite3_context * context, int argc, sqlite3_value ** argv)
       }
     blob1 = (unsigned char *) sqlite3_value_blob (argv[0]);
     bytes1 = sqlite3_value_bytes (argv[0]);
-    geo1 =
-	gaiaFromSpatiaLiteBlobWkbEx (blob1, bytes1, gpkg_mode, gpkg_amphibious);
     blob2 = (unsigned char *) sqlite3_value_blob (argv[1]);
     bytes2 = sqlite3_value_bytes (argv[1]);
+#ifdef GEOS_3120		/* only if GEOS 3.12.0 (or later) is supported */
+    if (cache != NULL && (!gpkg_mode || gpkg_amphibious))
+      {
+	  /* Point-in-Polygon fast path */
+	  if (gaiaGeomCollPreparedPointXY
+	      (cache, blob1, bytes1, blob2, bytes2, GAIA_PREPARED_COVEREDBY,
+	       &ret))
+	    {
+		sqlite3_result_int (context, ret);
+		return;
+	    }
+      }
+#endif /* end GEOS_3120 conditional */
+    geo1 =
+	gaiaFromSpatiaLiteBlobWkbEx (blob1, bytes1, gpkg_mode, gpkg_amphibious);
     geo2 =
 	gaiaFromSpatiaLiteBlobWkbEx (blob2, bytes2, gpkg_mode, gpkg_amphibious);
     if (!geo1 || !geo2)
@@ -34143,6 +34386,10 @@ fnct_Cutter (sqlite3_context * context, int argc, sqlite3_value ** argv)
 / ST_Cutter(TEXT in_db_prefix, TEXT input_table, TEXT input_geom,
 /              TEXT blade_db_prefix, TEXT blade_table, TEXT blade_geom,
 /              TEXT output_table, INT transaction, INT ram_temp_store)
+/ ST_Cutter(TEXT in_db_prefix, TEXT input_table, TEXT input_geom,
+/              TEXT blade_db_prefix, TEXT blade_table, TEXT blade_geom,
+/              TEXT output_table, INT transaction, INT ram_temp_store,
+/              INT threads)
 /
 / the "input" table-geometry is expected to be declared as POINT,
 / LINESTRING, POLYGON, MULTIPOINT, MULTILINESTRING or MULTIPOLYGON
@@ -34162,6 +34409,9 @@ fnct_Cutter (sqlite3_context * context, int argc, sqlite3_value ** argv)
 / anyway when a table defines two or more Geometries declaring a
 / NULL geometry name will cause a failure.
 /
+/ when threads is set the input POLYGONs will be cut in parallel
+/ (zero or negative: as many threads as the available CPU cores)
+/
 ///////////////////////////////////////////////////////////////////
 /
 / will precisely cut the input dataset against polygonal blade(s)
@@ -34182,6 +34432,7 @@ fnct_Cutter (sqlite3_context * context, int argc, sqlite3_value ** argv)
     const char *output_table = NULL;
     int transaction = 0;
     int ram_tmp_store = 0;
+    int threads = 0;
     char **message = NULL;
     struct splite_internal_cache *cache = sqlite3_user_data (context);
     GAIA_UNUSED ();		/* LCOV_EXCL_LINE */
@@ -34255,7 +34506,7 @@ fnct_Cutter (sqlite3_context * context, int argc, sqlite3_value ** argv)
 		return;
 	    }
       }
-    if (argc == 9)
+    if (argc >= 9)
       {
 	  if (sqlite3_value_type (argv[8]) == SQLITE_INTEGER)
 	      ram_tmp_store = sqlite3_value_int (argv[8]);
@@ -34265,12 +34516,29 @@ fnct_Cutter (sqlite3_context * context, int argc, sqlite3_value ** argv)
 		return;
 	    }
       }
+    if (argc == 10)
+      {
+	  if (sqlite3_value_type (argv[9]) == SQLITE_INTEGER)
+	      threads = sqlite3_value_int (argv[9]);
+	  else
+	    {
+		sqlite3_result_int (context, -1);
+		return;
+	    }
+      }
 
     sqlite = sqlite3_context_db_handle (context);
-    ret =
-	gaiaCutter (sqlite, cache, in_db_prefix, input_table, input_geom,
-		    blade_db_prefix, blade_table, blade_geom, output_table,
-		    transaction, ram_tmp_store, message);
+    if (argc == 10)
+	ret =
+	    gaiaCutterParallel (sqlite, cache, in_db_prefix, input_table,
+				input_geom, blade_db_prefix, blade_table,
+				blade_geom, output_table, transaction,
+				ram_tmp_store, threads, message);
+    else
+	ret =
+	    gaiaCutter (sqlite, cache, in_db_prefix, input_table, input_geom,
+			blade_db_prefix, blade_table, blade_geom, output_table,
+			transaction, ram_tmp_store, message);
 
     sqlite3_result_int (context, ret);
 }
@@ -37474,7 +37742,7 @@ fnct_BlobToFile (sqlite3_context * context, int argc, sqlite3_value ** argv)
 static int
 load_dxf (sqlite3 * db_handle, struct splite_internal_cache *cache,
 	  char *filename, int srid, int append, int force_dims, int mode,
-	  int special_rings, char *prefix, char *layer_name)
+	  int special_rings, char *prefix, char *layer_name, int batch_size)
 {
 /* scanning a Directory and processing all DXF files */
     int ret;
@@ -37488,6 +37756,20 @@ load_dxf (sqlite3 * db_handle, struct splite_internal_cache *cache,
 	  ret = 0;
 	  goto stop_dxf;
       }
+    if (batch_size > 0)
+      {
+	  /* streaming mode: parsing and loading bounded batches */
+	  if (!gaiaStreamDxfFile_r
+	      (cache, db_handle, dxf, filename, mode, append, batch_size))
+	    {
+		ret = 0;
+		spatialite_e ("Unable to import: %s\n", filename);
+		goto stop_dxf;
+	    }
+	  spatialite_e ("\n*** DXF file successfully loaded\n");
+	  ret = 1;
+	  goto stop_dxf;
+      }
 /* attempting to parse the DXF input file */
     if (gaiaParseDxfFile_r (cache, dxf, filename))
       {
@@ -37522,6 +37804,10 @@ fnct_ImportDXF (sqlite3_context * context, int argc, sqlite3_value ** argv)
 / InportDXF(TEXT filename, INT srid, INT append, TEXT dims,
 /           TEXT mode, TEXT special_rings, TEXT table_prefix,
 /           TEXT layer_name)
+/     or
+/ InportDXF(TEXT filename, INT srid, INT append, TEXT dims,
+/           TEXT mode, TEXT special_rings, TEXT table_prefix,
+/           TEXT layer_name, INT batch_size)
 /
 / returns:
 / 1 on success
@@ -37537,6 +37823,7 @@ fnct_ImportDXF (sqlite3_context * context, int argc, sqlite3_value ** argv)
     int force_dims = GAIA_DXF_AUTO_2D_3D;
     char *prefix = NULL;
     char *layer_name = NULL;
+    int batch_size = 0;
     sqlite3 *db_handle = sqlite3_context_db_handle (context);
     struct splite_internal_cache *cache = sqlite3_user_data (context);
     GAIA_UNUSED ();		/* LCOV_EXCL_LINE */
@@ -37625,10 +37912,19 @@ fnct_ImportDXF (sqlite3_context * context, int argc, sqlite3_value ** argv)
 		return;
 	    }
       }
+    if (argc > 8)
+      {
+	  if (sqlite3_value_type (argv[8]) != SQLITE_INTEGER)
+	    {
+		sqlite3_result_null (context);
+		return;
+	    }
+	  batch_size = sqlite3_value_int (argv[8]);
+      }
 
     ret =
 	load_dxf (db_handle, cache, filename, srid, append, force_dims, mode,
-		  special_rings, prefix, layer_name);
+		  special_rings, prefix, layer_name, batch_size);
     sqlite3_result_int (context, ret);
 }
 
@@ -37649,7 +37945,7 @@ is_dxf_file (const char *filename)
 static int
 scan_dxf_dir (sqlite3 * db_handle, struct splite_internal_cache *cache,
 	      char *dir_path, int srid, int append, int force_dims, int mode,
-	      int special_rings, char *prefix, char *layer_name)
+	      int special_rings, char *prefix, char *layer_name, int batch_size)
 {
 /* scanning a Directory and processing all DXF files */
     int cnt = 0;
@@ -37677,7 +37973,8 @@ scan_dxf_dir (sqlite3 * db_handle, struct splite_internal_cache *cache,
 			    cnt +=
 				load_dxf (db_handle, cache, filepath, srid,
 					  append, force_dims, mode,
-					  special_rings, prefix, layer_name);
+					  special_rings, prefix, layer_name,
+					  batch_size);
 			    sqlite3_free (filepath);
 			}
 		  }
@@ -37704,7 +38001,7 @@ scan_dxf_dir (sqlite3 * db_handle, struct splite_internal_cache *cache,
 		cnt +=
 		    load_dxf (db_handle, cache, filepath, srid, append,
 			      force_dims, mode, special_rings, prefix,
-			      layer_name);
+			      layer_name, batch_size);
 		sqlite3_free (filepath);
 	    }
       }
@@ -37723,6 +38020,10 @@ fnct_ImportDXFfromDir (sqlite3_context * context, int argc,
 / InportDXFfromDir(TEXT dir_path, INT srid, INT append, TEXT dims,
 /                  TEXT mode, TEXT special_rings, TEXT table_prefix,
 /                  TEXT layer_name)
+/     or
+/ InportDXFfromDir(TEXT dir_path, INT srid, INT append, TEXT dims,
+/                  TEXT mode, TEXT special_rings, TEXT table_prefix,
+/                  TEXT layer_name, INT batch_size)
 /
 / returns:
 / 1 on success
@@ -37738,6 +38039,7 @@ fnct_ImportDXFfromDir (sqlite3_context * context, int argc,
     int force_dims = GAIA_DXF_AUTO_2D_3D;
     char *prefix = NULL;
     char *layer_name = NULL;
+    int batch_size = 0;
     sqlite3 *db_handle = sqlite3_context_db_handle (context);
     struct splite_internal_cache *cache = sqlite3_user_data (context);
     GAIA_UNUSED ();		/* LCOV_EXCL_LINE */
@@ -37826,10 +38128,19 @@ fnct_ImportDXFfromDir (sqlite3_context * context, int argc,
 		return;
 	    }
       }
+    if (argc > 8)
+      {
+	  if (sqlite3_value_type (argv[8]) != SQLITE_INTEGER)
+	    {
+		sqlite3_result_null (context);
+		return;
+	    }
+	  batch_size = sqlite3_value_int (argv[8]);
+      }
 
     ret =
 	scan_dxf_dir (db_handle, cache, dir_path, srid, append, force_dims,
-		      mode, special_rings, prefix, layer_name);
+		      mode, special_rings, prefix, layer_name, batch_size);
     sqlite3_result_int (context, ret);
 }
 
@@ -49272,6 +49583,13 @@ fnct_TopoGeo_FromGeoTable (sqlite3_context * context, int argc,
     fnctaux_TopoGeo_FromGeoTable (context, argc, argv);
 }
 
+static void
+fnct_TopoGeo_FromGeoTableTiled (sqlite3_context * context, int argc,
+				sqlite3_value ** argv)
+{
+    fnctaux_TopoGeo_FromGeoTableTiled (context, argc, argv);
+}
+
 static void
 fnct_TopoGeo_FromGeoTableNoFace (sqlite3_context * context, int argc,
 				 sqlite3_value ** argv)
@@ -50714,6 +51032,15 @@ register_spatialite_sql_functions (void *p_db, const void *p_cache)
     sqlite3_create_function_v2 (db, "CompressGeometry", 1,
 				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_CompressGeometry, 0, 0, 0);
+    sqlite3_create_function_v2 (db, "CompressGeometry", 2,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
+				fnct_CompressGeometry, 0, 0, 0);
+    sqlite3_create_function_v2 (db, "CompressGeometry", 3,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
+				fnct_CompressGeometry, 0, 0, 0);
+    sqlite3_create_function_v2 (db, "CompressGeometry", 4,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
+				fnct_CompressGeometry, 0, 0, 0);
     sqlite3_create_function_v2 (db, "UncompressGeometry", 1,
 				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_UncompressGeometry, 0, 0, 0);
@@ -51067,37 +51394,37 @@ register_spatialite_sql_functions (void *p_db, const void *p_cache)
 				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_GeometryN, 0, 0, 0);
     sqlite3_create_function_v2 (db, "MBRContains", 2,
-				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_MbrContains, 0, 0, 0);
     sqlite3_create_function_v2 (db, "MbrDisjoint", 2,
-				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_MbrDisjoint, 0, 0, 0);
     sqlite3_create_function_v2 (db, "MBREqual", 2,
-				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_MbrEqual, 0, 0, 0);
     sqlite3_create_function_v2 (db, "MbrIntersects", 2,
-				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_MbrIntersects, 0, 0, 0);
     sqlite3_create_function_v2 (db, "ST_EnvIntersects", 2,
-				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_MbrIntersects, 0, 0, 0);
     sqlite3_create_function_v2 (db, "ST_EnvIntersects", 5,
 				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_EnvIntersects, 0, 0, 0);
     sqlite3_create_function_v2 (db, "ST_EnvelopesIntersects", 2,
-				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_MbrIntersects, 0, 0, 0);
     sqlite3_create_function_v2 (db, "ST_EnvelopesIntersects", 5,
 				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_EnvIntersects, 0, 0, 0);
     sqlite3_create_function_v2 (db, "MBROverlaps", 2,
-				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_MbrOverlaps, 0, 0, 0);
     sqlite3_create_function_v2 (db, "MbrTouches", 2,
-				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_MbrTouches, 0, 0, 0);
     sqlite3_create_function_v2 (db, "MbrWithin", 2,
-				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_MbrWithin, 0, 0, 0);
     sqlite3_create_function_v2 (db, "ShiftCoords", 3,
 				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
@@ -52470,12 +52797,18 @@ register_spatialite_sql_functions (void *p_db, const void *p_cache)
 	  sqlite3_create_function_v2 (db, "ImportDXF", 8,
 				      SQLITE_UTF8 | SQLITE_DETERMINISTIC,
 				      cache, fnct_ImportDXF, 0, 0, 0);
+	  sqlite3_create_function_v2 (db, "ImportDXF", 9,
+				      SQLITE_UTF8 | SQLITE_DETERMINISTIC,
+				      cache, fnct_ImportDXF, 0, 0, 0);
 	  sqlite3_create_function_v2 (db, "ImportDXFfromDir", 1,
 				      SQLITE_UTF8 | SQLITE_DETERMINISTIC,
 				      cache, fnct_ImportDXFfromDir, 0, 0, 0);
 	  sqlite3_create_function_v2 (db, "ImportDXFfromDir", 8,
 				      SQLITE_UTF8 | SQLITE_DETERMINISTIC,
 				      cache, fnct_ImportDXFfromDir, 0, 0, 0);
+	  sqlite3_create_function_v2 (db, "ImportDXFfromDir", 9,
+				      SQLITE_UTF8 | SQLITE_DETERMINISTIC,
+				      cache, fnct_ImportDXFfromDir, 0, 0, 0);
 
 #endif /* GEOS enabled */
 
@@ -53235,6 +53568,24 @@ register_spatialite_sql_functions (void *p_db, const void *p_cache)
     sqlite3_create_function_v2 (db, "ST_IsValidDetail", 2,
 				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_IsValidDetail, 0, 0, 0);
+    sqlite3_create_function_v2 (db, "CheckGeometryTable", 3,
+				SQLITE_UTF8, cache, fnct_CheckGeometryTable,
+				0, 0, 0);
+    sqlite3_create_function_v2 (db, "CheckGeometryTable", 4,
+				SQLITE_UTF8, cache, fnct_CheckGeometryTable,
+				0, 0, 0);
+    sqlite3_create_function_v2 (db, "SanitizeGeometryTable", 3,
+				SQLITE_UTF8, cache, fnct_SanitizeGeometryTable,
+				0, 0, 0);
+    sqlite3_create_function_v2 (db, "SanitizeGeometryTable", 4,
+				SQLITE_UTF8, cache, fnct_SanitizeGeometryTable,
+				0, 0, 0);
+    sqlite3_create_function_v2 (db, "SanitizeGeometryTable", 5,
+				SQLITE_UTF8, cache, fnct_SanitizeGeometryTable,
+				0, 0, 0);
+    sqlite3_create_function_v2 (db, "SanitizeGeometryTable", 6,
+				SQLITE_UTF8, cache, fnct_SanitizeGeometryTable,
+				0, 0, 0);
 
     sqlite3_create_function_v2 (db, "Boundary", 1,
 				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
@@ -54081,6 +54432,9 @@ register_spatialite_sql_functions (void *p_db, const void *p_cache)
     sqlite3_create_function_v2 (db, "ST_Cutter", 9,
 				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				fnct_Cutter, 0, 0, 0);
+    sqlite3_create_function_v2 (db, "ST_Cutter", 10,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
+				fnct_Cutter, 0, 0, 0);
     sqlite3_create_function_v2 (db, "GetCutterMessage", 0,
 				SQLITE_UTF8, cache,
 				fnct_GetCutterMessage, 0, 0, 0);
@@ -54489,6 +54843,9 @@ register_spatialite_sql_functions (void *p_db, const void *p_cache)
     sqlite3_create_function_v2 (db, "gpkgAddSpatialIndex", 2,
 				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
 				fnct_gpkgAddSpatialIndex, 0, 0, 0);
+    sqlite3_create_function_v2 (db, "gpkgRebuildSpatialIndex", 2,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+				fnct_gpkgRebuildSpatialIndex, 0, 0, 0);
     sqlite3_create_function_v2 (db, "gpkgMakePoint", 2,
 				SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
 				fnct_gpkgMakePoint, 0, 0, 0);
@@ -54667,6 +55024,18 @@ register_spatialite_sql_functions (void *p_db, const void *p_cache)
 	  sqlite3_create_function_v2 (db, "TopoGeo_FromGeoTable", 7,
 				      SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				      fnct_TopoGeo_FromGeoTable, 0, 0, 0);
+	  sqlite3_create_function_v2 (db, "TopoGeo_FromGeoTableTiled", 5,
+				      SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
+				      fnct_TopoGeo_FromGeoTableTiled, 0, 0, 0);
+	  sqlite3_create_function_v2 (db, "TopoGeo_FromGeoTableTiled", 6,
+				      SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
+				      fnct_TopoGeo_FromGeoTableTiled, 0, 0, 0);
+	  sqlite3_create_function_v2 (db, "TopoGeo_FromGeoTableTiled", 7,
+				      SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
+				      fnct_TopoGeo_FromGeoTableTiled, 0, 0, 0);
+	  sqlite3_create_function_v2 (db, "TopoGeo_FromGeoTableTiled", 8,
+				      SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
+				      fnct_TopoGeo_FromGeoTableTiled, 0, 0, 0);
 	  sqlite3_create_function_v2 (db, "TopoGeo_FromGeoTableNoFace", 4,
 				      SQLITE_UTF8 | SQLITE_DETERMINISTIC, cache,
 				      fnct_TopoGeo_FromGeoTableNoFace, 0, 0, 0);
@@ -54993,7 +55362,7 @@ init_spatialite_virtualtables (void *p_db, const void *p_cache)
 /* initializing the VirtualSpatialIndex  extension */
     virtual_spatialindex_extension_init (db);
 /* initializing the VirtualElementary  extension */
-    virtual_elementary_extension_init (db);
+    virtual_elementary_extension_init (db, p_cache);
 /* initializing the (fake) VirtualKNN  extension */
     virtual_knn_extension_init (db);
 
@@ -55,6 +55,7 @@ the terms of any one of the MPL, the GPL or the LGPL.
 
 #include <spatialite/sqlite.h>
 
+#include <spatialite.h>
 #include <spatialite/spatialite_ext.h>
 #include <spatialite/gaiaaux.h>
 #include <spatialite/gaiageo.h>
@@ -1038,8 +1039,882 @@ velem_rename (sqlite3_vtab * pVTab, const char *zNew)
     return SQLITE_ERROR;
 }
 
+/******************************************************************************
+/
+/ table-valued functions: ST_ElementaryParts(), ST_SubdivideParts()
+/ and ST_SubdivideTable()
+/
+/ any elementary item (or any subdivided part) is encoded only when
+/ the corresponding row is actually fetched, so that no output table
+/ and no intermediate collection BLOB will ever be materialized
+/
+******************************************************************************/
+
+#define VPARTS_ELEMENTARY	0
+#define VPARTS_SUBDIVIDE	1
+
+#define VPARTS_PREFIX		1
+#define VPARTS_TABLE		2
+#define VPARTS_GEOMETRY		4
+#define VPARTS_VERTICES		8
+#define VPARTS_THREADS		16
+
+#define VPARTS_BATCH		16
+
+static struct sqlite3_module my_parts_module;
+#ifdef ENABLE_RTTOPO		/* only if RTTOPO is enabled */
+static struct sqlite3_module my_subdiv_module;
+static struct sqlite3_module my_subdiv_table_module;
+#endif /* end RTTOPO conditional */
+
+typedef struct VirtualPartsStruct
+{
+/* extends the sqlite3_vtab struct */
+    const sqlite3_module *pModule;	/* ptr to sqlite module: USED INTERNALLY BY SQLITE */
+    int nRef;			/* # references: USED INTERNALLY BY SQLITE */
+    char *zErrMsg;		/* error message: USE INTERNALLY BY SQLITE */
+    sqlite3 *db;		/* the sqlite db holding the virtual table */
+    const void *p_cache;	/* pointer to the internal cache */
+    int mode;			/* VPARTS_ELEMENTARY or VPARTS_SUBDIVIDE */
+} VirtualParts;
+typedef VirtualParts *VirtualPartsPtr;
+
+struct velem_items
+{
+/* helper struct: walking the elementary items of a Geometry */
+    gaiaGeomCollPtr geom;
+    gaiaPointPtr pt;
+    gaiaLinestringPtr ln;
+    gaiaPolygonPtr pg;
+    int item_no;
+};
+
+typedef struct VirtualPartsCursorStruct
+{
+/* extends the sqlite3_vtab_cursor struct */
+    VirtualPartsPtr pVtab;	/* Virtual table of this cursor */
+    int eof;			/* the EOF marker */
+    struct velem_items items;
+} VirtualPartsCursor;
+typedef VirtualPartsCursor *VirtualPartsCursorPtr;
+
+static void
+velem_items_rewind (struct velem_items *items)
+{
+/* positioning on the first elementary item */
+    items->pt = NULL;
+    items->ln = NULL;
+    items->pg = NULL;
+    items->item_no = 0;
+    if (items->geom == NULL)
+	return;
+    items->pt = items->geom->FirstPoint;
+    if (items->pt == NULL)
+	items->ln = items->geom->FirstLinestring;
+    if (items->pt == NULL && items->ln == NULL)
+	items->pg = items->geom->FirstPolygon;
+}
+
+static int
+velem_items_valid (struct velem_items *items)
+{
+/* checking if the current elementary item exists */
+    if (items->pt != NULL || items->ln != NULL || items->pg != NULL)
+	return 1;
+    return 0;
+}
+
+static void
+velem_items_next (struct velem_items *items)
+{
+/* moving to the next elementary item */
+    if (items->pt != NULL)
+      {
+	  items->pt = items->pt->Next;
+	  if (items->pt == NULL)
+	      items->ln = items->geom->FirstLinestring;
+	  if (items->pt == NULL && items->ln == NULL)
+	      items->pg = items->geom->FirstPolygon;
+      }
+    else if (items->ln != NULL)
+      {
+	  items->ln = items->ln->Next;
+	  if (items->ln == NULL)
+	      items->pg = items->geom->FirstPolygon;
+      }
+    else if (items->pg != NULL)
+	items->pg = items->pg->Next;
+    items->item_no += 1;
+}
+
+static void
+velem_items_result (struct velem_items *items, sqlite3_context * pContext,
+		    const void *p_cache)
+{
+/* returning the current elementary item as a BLOB Geometry */
+    struct splite_internal_cache *cache =
+	(struct splite_internal_cache *) p_cache;
+    gaiaGeomCollPtr elem = NULL;
+    unsigned char *blob;
+    int size;
+    int gpkg_mode = 0;
+    int tiny_point = 0;
+    if (cache != NULL)
+      {
+	  gpkg_mode = cache->gpkg_mode;
+	  tiny_point = cache->tinyPointEnabled;
+      }
+    if (items->pt != NULL)
+	elem = velem_from_point (items->pt, items->geom->Srid);
+    else if (items->ln != NULL)
+	elem = velem_from_linestring (items->ln, items->geom->Srid);
+    else if (items->pg != NULL)
+	elem = velem_from_polygon (items->pg, items->geom->Srid);
+    if (elem == NULL)
+      {
+	  sqlite3_result_null (pContext);
+	  return;
+      }
+    gaiaToSpatiaLiteBlobWkbEx2 (elem, &blob, &size, gpkg_mode, tiny_point);
+    gaiaFreeGeomColl (elem);
+    sqlite3_result_blob (pContext, blob, size, free);
+}
+
+static gaiaGeomCollPtr
+velem_parse_blob (const void *p_cache, sqlite3_value * value)
+{
+/* parsing an input BLOB Geometry */
+    struct splite_internal_cache *cache =
+	(struct splite_internal_cache *) p_cache;
+    int gpkg_mode = 0;
+    int gpkg_amphibious = 0;
+    if (sqlite3_value_type (value) != SQLITE_BLOB)
+	return NULL;
+    if (cache != NULL)
+      {
+	  gpkg_mode = cache->gpkg_mode;
+	  gpkg_amphibious = cache->gpkg_amphibious_mode;
+      }
+    return gaiaFromSpatiaLiteBlobWkbEx ((const unsigned char *)
+					sqlite3_value_blob (value),
+					sqlite3_value_bytes (value),
+					gpkg_mode, gpkg_amphibious);
+}
+
+static int
+vparts_connect_common (sqlite3 * db, void *pAux, int mode,
+		       sqlite3_vtab ** ppVTab, char **pzErr)
+{
+/* connects an ST_ElementaryParts() or ST_SubdivideParts() function */
+    VirtualPartsPtr p_vt;
+    const char *sql;
+    if (mode == VPARTS_SUBDIVIDE)
+	sql = "CREATE TABLE x (item_no INTEGER, geometry BLOB, "
+	    "input BLOB HIDDEN, max_vertices INTEGER HIDDEN)";
+    else
+	sql = "CREATE TABLE x (item_no INTEGER, geometry BLOB, "
+	    "input BLOB HIDDEN)";
+    if (sqlite3_declare_vtab (db, sql) != SQLITE_OK)
+      {
+	  *pzErr =
+	      sqlite3_mprintf
+	      ("[VirtualElementary module] invalid SQL statement \"%s\"", sql);
+	  return SQLITE_ERROR;
+      }
+    p_vt = (VirtualPartsPtr) sqlite3_malloc (sizeof (VirtualParts));
+    if (!p_vt)
+	return SQLITE_NOMEM;
+    p_vt->db = db;
+    p_vt->pModule = &my_parts_module;
+#ifdef ENABLE_RTTOPO		/* only if RTTOPO is enabled */
+    if (mode == VPARTS_SUBDIVIDE)
+	p_vt->pModule = &my_subdiv_module;
+#endif /* end RTTOPO conditional */
+    p_vt->nRef = 0;
+    p_vt->zErrMsg = NULL;
+    p_vt->p_cache = pAux;
+    p_vt->mode = mode;
+    *ppVTab = (sqlite3_vtab *) p_vt;
+    return SQLITE_OK;
+}
+
+static int
+vparts_connect (sqlite3 * db, void *pAux, int argc, const char *const *argv,
+		sqlite3_vtab ** ppVTab, char **pzErr)
+{
+/* connects the ST_ElementaryParts() function */
+    if (argc || argv)
+	argc = argc;		/* unused arg warning suppression */
+    return vparts_connect_common (db, pAux, VPARTS_ELEMENTARY, ppVTab, pzErr);
+}
+
+#ifdef ENABLE_RTTOPO		/* only if RTTOPO is enabled */
+static int
+vparts_subdiv_connect (sqlite3 * db, void *pAux, int argc,
+		       const char *const *argv, sqlite3_vtab ** ppVTab,
+		       char **pzErr)
+{
+/* connects the ST_SubdivideParts() function */
+    if (argc || argv)
+	argc = argc;		/* unused arg warning suppression */
+    return vparts_connect_common (db, pAux, VPARTS_SUBDIVIDE, ppVTab, pzErr);
+}
+#endif /* end RTTOPO conditional */
+
+static int
+vparts_best_index (sqlite3_vtab * pVTab, sqlite3_index_info * pIdxInfo)
+{
+/* best index selection */
+    int i;
+    int input = -1;
+    int vertices = -1;
+    if (pVTab)
+	pVTab = pVTab;		/* unused arg warning suppression */
+    for (i = 0; i < pIdxInfo->nConstraint; i++)
+      {
+	  /* searching the function arguments */
+	  struct sqlite3_index_constraint *p = &(pIdxInfo->aConstraint[i]);
+	  if (!p->usable || p->op != SQLITE_INDEX_CONSTRAINT_EQ)
+	      continue;
+	  if (p->iColumn == 2)
+	      input = i;
+	  else if (p->iColumn == 3)
+	      vertices = i;
+      }
+    if (input < 0)
+      {
+	  /* illegal query: the input Geometry is mandatory */
+	  pIdxInfo->idxNum = 0;
+	  return SQLITE_OK;
+      }
+    pIdxInfo->aConstraintUsage[input].argvIndex = 1;
+    pIdxInfo->aConstraintUsage[input].omit = 1;
+    pIdxInfo->idxNum = 1;
+    if (vertices >= 0)
+      {
+	  pIdxInfo->aConstraintUsage[vertices].argvIndex = 2;
+	  pIdxInfo->aConstraintUsage[vertices].omit = 1;
+	  pIdxInfo->idxNum = 2;
+      }
+    pIdxInfo->estimatedCost = 1.0;
+    return SQLITE_OK;
+}
+
 static int
-spliteVirtualElementaryInit (sqlite3 * db)
+vparts_disconnect (sqlite3_vtab * pVTab)
+{
+/* disconnects the virtual table */
+    sqlite3_free (pVTab);
+    return SQLITE_OK;
+}
+
+static int
+vparts_open (sqlite3_vtab * pVTab, sqlite3_vtab_cursor ** ppCursor)
+{
+/* opening a new cursor */
+    VirtualPartsCursorPtr cursor =
+	(VirtualPartsCursorPtr) sqlite3_malloc (sizeof (VirtualPartsCursor));
+    if (cursor == NULL)
+	return SQLITE_ERROR;
+    cursor->pVtab = (VirtualPartsPtr) pVTab;
+    cursor->eof = 1;
+    cursor->items.geom = NULL;
+    velem_items_rewind (&(cursor->items));
+    *ppCursor = (sqlite3_vtab_cursor *) cursor;
+    return SQLITE_OK;
+}
+
+static int
+vparts_close (sqlite3_vtab_cursor * pCursor)
+{
+/* closing the cursor */
+    VirtualPartsCursorPtr cursor = (VirtualPartsCursorPtr) pCursor;
+    if (cursor->items.geom != NULL)
+	gaiaFreeGeomColl (cursor->items.geom);
+    sqlite3_free (pCursor);
+    return SQLITE_OK;
+}
+
+static int
+vparts_filter (sqlite3_vtab_cursor * pCursor, int idxNum, const char *idxStr,
+	       int argc, sqlite3_value ** argv)
+{
+/* setting up a cursor filter */
+    VirtualPartsCursorPtr cursor = (VirtualPartsCursorPtr) pCursor;
+    VirtualPartsPtr parts = cursor->pVtab;
+    gaiaGeomCollPtr geom;
+    if (idxStr)
+	idxStr = idxStr;	/* unused arg warning suppression */
+    cursor->eof = 1;
+    if (cursor->items.geom != NULL)
+	gaiaFreeGeomColl (cursor->items.geom);
+    cursor->items.geom = NULL;
+    velem_items_rewind (&(cursor->items));
+    if (idxNum == 0 || argc < 1)
+	return SQLITE_OK;
+    geom = velem_parse_blob (parts->p_cache, argv[0]);
+    if (geom == NULL)
+	return SQLITE_OK;
+#ifdef ENABLE_RTTOPO		/* only if RTTOPO is enabled */
+    if (parts->mode == VPARTS_SUBDIVIDE)
+      {
+	  /* subdividing the input Geometry */
+	  gaiaGeomCollPtr result;
+	  int max_vertices = 128;
+	  if (idxNum == 2 && argc == 2)
+	    {
+		if (sqlite3_value_type (argv[1]) != SQLITE_INTEGER)
+		  {
+		      gaiaFreeGeomColl (geom);
+		      return SQLITE_OK;
+		  }
+		max_vertices = sqlite3_value_int (argv[1]);
+	    }
+	  result = gaiaSubdivide (parts->p_cache, geom, max_vertices);
+	  gaiaFreeGeomColl (geom);
+	  geom = result;
+	  if (geom == NULL)
+	      return SQLITE_OK;
+      }
+#endif /* end RTTOPO conditional */
+    cursor->items.geom = geom;
+    velem_items_rewind (&(cursor->items));
+    if (velem_items_valid (&(cursor->items)))
+	cursor->eof = 0;
+    return SQLITE_OK;
+}
+
+static int
+vparts_next (sqlite3_vtab_cursor * pCursor)
+{
+/* fetching next row from cursor */
+    VirtualPartsCursorPtr cursor = (VirtualPartsCursorPtr) pCursor;
+    velem_items_next (&(cursor->items));
+    if (!velem_items_valid (&(cursor->items)))
+	cursor->eof = 1;
+    return SQLITE_OK;
+}
+
+static int
+vparts_eof (sqlite3_vtab_cursor * pCursor)
+{
+/* cursor EOF */
+    VirtualPartsCursorPtr cursor = (VirtualPartsCursorPtr) pCursor;
+    return cursor->eof;
+}
+
+static int
+vparts_column (sqlite3_vtab_cursor * pCursor, sqlite3_context * pContext,
+	       int column)
+{
+/* fetching value for the Nth column */
+    VirtualPartsCursorPtr cursor = (VirtualPartsCursorPtr) pCursor;
+    if (column == 0)
+      {
+	  /* the "item_no" column */
+	  sqlite3_result_int (pContext, cursor->items.item_no);
+      }
+    else if (column == 1)
+      {
+	  /* the "geometry" column */
+	  velem_items_result (&(cursor->items), pContext,
+			      cursor->pVtab->p_cache);
+      }
+    else
+	sqlite3_result_null (pContext);
+    return SQLITE_OK;
+}
+
+static int
+vparts_rowid (sqlite3_vtab_cursor * pCursor, sqlite_int64 * pRowid)
+{
+/* fetching the ROWID */
+    VirtualPartsCursorPtr cursor = (VirtualPartsCursorPtr) pCursor;
+    *pRowid = cursor->items.item_no;
+    return SQLITE_OK;
+}
+
+#ifdef ENABLE_RTTOPO		/* only if RTTOPO is enabled */
+
+struct subdiv_input
+{
+/* helper struct: an input row to be subdivided */
+    sqlite3_int64 rowid;
+    unsigned char *blob;
+    int blob_sz;
+    gaiaGeomCollPtr result;
+};
+
+struct subdiv_worker
+{
+/* helper struct: a worker thread subdividing input rows */
+    const void *cache;
+    struct subdiv_input *inputs;
+    int n_inputs;
+    int first;
+    int step;
+    int max_vertices;
+    int gpkg_mode;
+    int gpkg_amphibious;
+};
+
+typedef struct VirtualSubdivCursorStruct
+{
+/* extends the sqlite3_vtab_cursor struct */
+    VirtualPartsPtr pVtab;	/* Virtual table of this cursor */
+    int eof;			/* the EOF marker */
+    sqlite3_stmt *stmt;		/* reading the input Table */
+    int done;			/* the input Table has been fully read */
+    int max_vertices;
+    int threads;
+    struct subdiv_worker *workers;
+    void **args;
+    struct subdiv_input *inputs;
+    int max_inputs;
+    int n_inputs;
+    int current;
+    sqlite3_int64 rowid;
+    struct velem_items items;
+} VirtualSubdivCursor;
+typedef VirtualSubdivCursor *VirtualSubdivCursorPtr;
+
+static void
+subdiv_worker (void *arg)
+{
+/* subdividing all input rows assigned to this worker */
+    struct subdiv_worker *worker = (struct subdiv_worker *) arg;
+    int i;
+    for (i = worker->first; i < worker->n_inputs; i += worker->step)
+      {
+	  struct subdiv_input *input = worker->inputs + i;
+	  gaiaGeomCollPtr geom =
+	      gaiaFromSpatiaLiteBlobWkbEx (input->blob, input->blob_sz,
+					   worker->gpkg_mode,
+					   worker->gpkg_amphibious);
+	  if (geom == NULL)
+	      continue;
+	  input->result =
+	      gaiaSubdivide (worker->cache, geom, worker->max_vertices);
+	  gaiaFreeGeomColl (geom);
+      }
+}
+
+static int
+vsubdiv_connect (sqlite3 * db, void *pAux, int argc, const char *const *argv,
+		 sqlite3_vtab ** ppVTab, char **pzErr)
+{
+/* connects the ST_SubdivideTable() function */
+    VirtualPartsPtr p_vt;
+    const char *sql =
+	"CREATE TABLE x (origin_rowid INTEGER, item_no INTEGER, "
+	"geometry BLOB, db_prefix TEXT HIDDEN, f_table_name TEXT HIDDEN, "
+	"f_geometry_column TEXT HIDDEN, max_vertices INTEGER HIDDEN, "
+	"threads INTEGER HIDDEN)";
+    if (argc || argv)
+	argc = argc;		/* unused arg warning suppression */
+    if (sqlite3_declare_vtab (db, sql) != SQLITE_OK)
+      {
+	  *pzErr =
+	      sqlite3_mprintf
+	      ("[VirtualElementary module] invalid SQL statement \"%s\"", sql);
+	  return SQLITE_ERROR;
+      }
+    p_vt = (VirtualPartsPtr) sqlite3_malloc (sizeof (VirtualParts));
+    if (!p_vt)
+	return SQLITE_NOMEM;
+    p_vt->db = db;
+    p_vt->pModule = &my_subdiv_table_module;
+    p_vt->nRef = 0;
+    p_vt->zErrMsg = NULL;
+    p_vt->p_cache = pAux;
+    p_vt->mode = VPARTS_SUBDIVIDE;
+    *ppVTab = (sqlite3_vtab *) p_vt;
+    return SQLITE_OK;
+}
+
+static int
+vsubdiv_best_index (sqlite3_vtab * pVTab, sqlite3_index_info * pIdxInfo)
+{
+/* best index selection */
+    int i;
+    int col;
+    int argv_index = 1;
+    int args[5];
+    if (pVTab)
+	pVTab = pVTab;		/* unused arg warning suppression */
+    for (col = 0; col < 5; col++)
+	args[col] = -1;
+    for (i = 0; i < pIdxInfo->nConstraint; i++)
+      {
+	  /* searching the function arguments */
+	  struct sqlite3_index_constraint *p = &(pIdxInfo->aConstraint[i]);
+	  if (!p->usable || p->op != SQLITE_INDEX_CONSTRAINT_EQ)
+	      continue;
+	  if (p->iColumn >= 3 && p->iColumn <= 7)
+	      args[p->iColumn - 3] = i;
+      }
+    pIdxInfo->idxNum = 0;
+    if (args[1] < 0)
+      {
+	  /* illegal query: the input Table is mandatory */
+	  return SQLITE_OK;
+      }
+    for (col = 0; col < 5; col++)
+      {
+	  /* the arguments are always passed in the same order */
+	  if (args[col] < 0)
+	      continue;
+	  pIdxInfo->aConstraintUsage[args[col]].argvIndex = argv_index++;
+	  pIdxInfo->aConstraintUsage[args[col]].omit = 1;
+	  pIdxInfo->idxNum |= (1 << col);
+      }
+    pIdxInfo->estimatedCost = 1000000.0;
+    return SQLITE_OK;
+}
+
+static void
+vsubdiv_reset_inputs (VirtualSubdivCursorPtr cursor)
+{
+/* cleaning the current batch of input rows */
+    int i;
+    for (i = 0; i < cursor->n_inputs; i++)
+      {
+	  struct subdiv_input *input = cursor->inputs + i;
+	  if (input->blob != NULL)
+	      free (input->blob);
+	  if (input->result != NULL)
+	      gaiaFreeGeomColl (input->result);
+      }
+    cursor->n_inputs = 0;
+    cursor->current = 0;
+    cursor->items.geom = NULL;
+    velem_items_rewind (&(cursor->items));
+}
+
+static void
+vsubdiv_reset (VirtualSubdivCursorPtr cursor)
+{
+/* cleaning the cursor's cache */
+    int i;
+    vsubdiv_reset_inputs (cursor);
+    if (cursor->stmt != NULL)
+	sqlite3_finalize (cursor->stmt);
+    if (cursor->inputs != NULL)
+	free (cursor->inputs);
+    if (cursor->workers != NULL)
+      {
+	  /* the first worker always uses the connection's own cache */
+	  for (i = 1; i < cursor->threads; i++)
+	    {
+		struct subdiv_worker *worker = cursor->workers + i;
+		if (worker->cache != NULL)
+		    spatialite_internal_cleanup (worker->cache);
+	    }
+	  free (cursor->workers);
+      }
+    if (cursor->args != NULL)
+	free (cursor->args);
+    cursor->stmt = NULL;
+    cursor->done = 1;
+    cursor->inputs = NULL;
+    cursor->max_inputs = 0;
+    cursor->workers = NULL;
+    cursor->args = NULL;
+    cursor->threads = 0;
+}
+
+static int
+vsubdiv_load_batch (VirtualSubdivCursorPtr cursor)
+{
+/* reading and subdividing the next batch of input rows */
+    int ret;
+    int i;
+    int count;
+    vsubdiv_reset_inputs (cursor);
+    while (!cursor->done && cursor->n_inputs < cursor->max_inputs)
+      {
+	  struct subdiv_input *input;
+	  ret = sqlite3_step (cursor->stmt);
+	  if (ret != SQLITE_ROW)
+	    {
+		/* SQLITE_DONE or any error: the input is exhausted */
+		cursor->done = 1;
+		break;
+	    }
+	  if (sqlite3_column_type (cursor->stmt, 1) != SQLITE_BLOB)
+	      continue;
+	  input = cursor->inputs + cursor->n_inputs++;
+	  input->rowid = sqlite3_column_int64 (cursor->stmt, 0);
+	  input->blob_sz = sqlite3_column_bytes (cursor->stmt, 1);
+	  input->blob = malloc (input->blob_sz);
+	  memcpy (input->blob, sqlite3_column_blob (cursor->stmt, 1),
+		  input->blob_sz);
+	  input->result = NULL;
+      }
+    if (cursor->n_inputs == 0)
+	return 0;
+
+/* subdividing the current batch in parallel */
+    count = cursor->threads;
+    if (count > cursor->n_inputs)
+	count = cursor->n_inputs;
+    for (i = 0; i < count; i++)
+      {
+	  struct subdiv_worker *worker = cursor->workers + i;
+	  worker->inputs = cursor->inputs;
+	  worker->n_inputs = cursor->n_inputs;
+	  worker->first = i;
+	  worker->step = count;
+	  cursor->args[i] = worker;
+      }
+    splite_run_threads (count, subdiv_worker, cursor->args);
+    return 1;
+}
+
+static void
+vsubdiv_fetch (VirtualSubdivCursorPtr cursor)
+{
+/* positioning on the next available subdivided part */
+    while (!velem_items_valid (&(cursor->items)))
+      {
+	  if (cursor->items.geom != NULL || cursor->n_inputs > 0)
+	      cursor->current += 1;
+	  if (cursor->current >= cursor->n_inputs)
+	    {
+		if (!vsubdiv_load_batch (cursor))
+		  {
+		      cursor->eof = 1;
+		      return;
+		  }
+	    }
+	  cursor->items.geom = (cursor->inputs + cursor->current)->result;
+	  velem_items_rewind (&(cursor->items));
+	  if (!velem_items_valid (&(cursor->items)))
+	      cursor->items.geom = NULL;
+      }
+}
+
+static int
+vsubdiv_open (sqlite3_vtab * pVTab, sqlite3_vtab_cursor ** ppCursor)
+{
+/* opening a new cursor */
+    VirtualSubdivCursorPtr cursor =
+	(VirtualSubdivCursorPtr) sqlite3_malloc (sizeof (VirtualSubdivCursor));
+    if (cursor == NULL)
+	return SQLITE_ERROR;
+    cursor->pVtab = (VirtualPartsPtr) pVTab;
+    cursor->eof = 1;
+    cursor->stmt = NULL;
+    cursor->done = 1;
+    cursor->max_vertices = 128;
+    cursor->threads = 0;
+    cursor->workers = NULL;
+    cursor->args = NULL;
+    cursor->inputs = NULL;
+    cursor->max_inputs = 0;
+    cursor->n_inputs = 0;
+    cursor->current = 0;
+    cursor->rowid = 0;
+    cursor->items.geom = NULL;
+    velem_items_rewind (&(cursor->items));
+    *ppCursor = (sqlite3_vtab_cursor *) cursor;
+    return SQLITE_OK;
+}
+
+static int
+vsubdiv_close (sqlite3_vtab_cursor * pCursor)
+{
+/* closing the cursor */
+    VirtualSubdivCursorPtr cursor = (VirtualSubdivCursorPtr) pCursor;
+    vsubdiv_reset (cursor);
+    sqlite3_free (pCursor);
+    return SQLITE_OK;
+}
+
+static int
+vsubdiv_filter (sqlite3_vtab_cursor * pCursor, int idxNum,
+		const char *idxStr, int argc, sqlite3_value ** argv)
+{
+/* setting up a cursor filter */
+    VirtualSubdivCursorPtr cursor = (VirtualSubdivCursorPtr) pCursor;
+    VirtualPartsPtr parts = cursor->pVtab;
+    struct splite_internal_cache *cache =
+	(struct splite_internal_cache *) parts->p_cache;
+    const char *db_prefix = NULL;
+    const char *table_name = NULL;
+    const char *geom_column = NULL;
+    char *xprefix = NULL;
+    char *xtable = NULL;
+    char *xgeom = NULL;
+    char *quoted_db;
+    char *quoted_table;
+    char *quoted_geom;
+    char *sql;
+    int max_vertices = 128;
+    int threads = 1;
+    int iarg = 0;
+    int i;
+    int ret;
+    if (idxStr)
+	idxStr = idxStr;	/* unused arg warning suppression */
+    vsubdiv_reset (cursor);
+    cursor->eof = 1;
+    cursor->rowid = 0;
+    if ((idxNum & VPARTS_TABLE) == 0)
+	return SQLITE_OK;
+
+/* retrieving the function arguments */
+    if (idxNum & VPARTS_PREFIX)
+      {
+	  if (sqlite3_value_type (argv[iarg]) == SQLITE_TEXT)
+	      db_prefix = (const char *) sqlite3_value_text (argv[iarg]);
+	  else if (sqlite3_value_type (argv[iarg]) != SQLITE_NULL)
+	      return SQLITE_OK;
+	  iarg++;
+      }
+    if (sqlite3_value_type (argv[iarg]) != SQLITE_TEXT)
+	return SQLITE_OK;
+    table_name = (const char *) sqlite3_value_text (argv[iarg++]);
+    if (idxNum & VPARTS_GEOMETRY)
+      {
+	  if (sqlite3_value_type (argv[iarg]) == SQLITE_TEXT)
+	      geom_column = (const char *) sqlite3_value_text (argv[iarg]);
+	  else if (sqlite3_value_type (argv[iarg]) != SQLITE_NULL)
+	      return SQLITE_OK;
+	  iarg++;
+      }
+    if (idxNum & VPARTS_VERTICES)
+      {
+	  if (sqlite3_value_type (argv[iarg]) != SQLITE_INTEGER)
+	      return SQLITE_OK;
+	  max_vertices = sqlite3_value_int (argv[iarg++]);
+      }
+    if (idxNum & VPARTS_THREADS)
+      {
+	  if (sqlite3_value_type (argv[iarg]) != SQLITE_INTEGER)
+	      return SQLITE_OK;
+	  threads = sqlite3_value_int (argv[iarg++]);
+	  if (threads <= 0)
+	      threads = splite_get_cpu_count ();
+      }
+    if (iarg != argc)
+	return SQLITE_OK;
+
+/* checking if the corresponding Table/Geometry exists */
+    if (!velem_find_geometry
+	(parts->db, db_prefix, table_name, geom_column, &xprefix, &xtable,
+	 &xgeom))
+	return SQLITE_OK;
+    quoted_db = gaiaDoubleQuotedSql (xprefix);
+    quoted_table = gaiaDoubleQuotedSql (xtable);
+    quoted_geom = gaiaDoubleQuotedSql (xgeom);
+    sql =
+	sqlite3_mprintf ("SELECT ROWID, \"%s\" FROM \"%s\".\"%s\"",
+			 quoted_geom, quoted_db, quoted_table);
+    free (quoted_db);
+    free (quoted_table);
+    free (quoted_geom);
+    free (xprefix);
+    free (xtable);
+    free (xgeom);
+    ret = sqlite3_prepare_v2 (parts->db, sql, strlen (sql), &(cursor->stmt),
+			      NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  cursor->stmt = NULL;
+	  return SQLITE_OK;
+      }
+
+/* allocating the worker threads */
+    cursor->done = 0;
+    cursor->max_vertices = max_vertices;
+    cursor->threads = threads;
+    cursor->max_inputs = threads * VPARTS_BATCH;
+    cursor->inputs = malloc (sizeof (struct subdiv_input) * cursor->max_inputs);
+    cursor->workers = malloc (sizeof (struct subdiv_worker) * threads);
+    cursor->args = malloc (sizeof (void *) * threads);
+    for (i = 0; i < threads; i++)
+      {
+	  struct subdiv_worker *worker = cursor->workers + i;
+	  if (i == 0)
+	      worker->cache = parts->p_cache;
+	  else
+	      worker->cache = spatialite_alloc_connection ();
+	  worker->max_vertices = max_vertices;
+	  worker->gpkg_mode = 0;
+	  worker->gpkg_amphibious = 0;
+	  if (cache != NULL)
+	    {
+		worker->gpkg_mode = cache->gpkg_mode;
+		worker->gpkg_amphibious = cache->gpkg_amphibious_mode;
+	    }
+      }
+    cursor->eof = 0;
+    vsubdiv_fetch (cursor);
+    return SQLITE_OK;
+}
+
+static int
+vsubdiv_next (sqlite3_vtab_cursor * pCursor)
+{
+/* fetching next row from cursor */
+    VirtualSubdivCursorPtr cursor = (VirtualSubdivCursorPtr) pCursor;
+    velem_items_next (&(cursor->items));
+    vsubdiv_fetch (cursor);
+    cursor->rowid += 1;
+    return SQLITE_OK;
+}
+
+static int
+vsubdiv_eof (sqlite3_vtab_cursor * pCursor)
+{
+/* cursor EOF */
+    VirtualSubdivCursorPtr cursor = (VirtualSubdivCursorPtr) pCursor;
+    return cursor->eof;
+}
+
+static int
+vsubdiv_column (sqlite3_vtab_cursor * pCursor, sqlite3_context * pContext,
+		int column)
+{
+/* fetching value for the Nth column */
+    VirtualSubdivCursorPtr cursor = (VirtualSubdivCursorPtr) pCursor;
+    if (column == 0)
+      {
+	  /* the "origin_rowid" column */
+	  sqlite3_result_int64 (pContext,
+				(cursor->inputs + cursor->current)->rowid);
+      }
+    else if (column == 1)
+      {
+	  /* the "item_no" column */
+	  sqlite3_result_int (pContext, cursor->items.item_no);
+      }
+    else if (column == 2)
+      {
+	  /* the "geometry" column */
+	  velem_items_result (&(cursor->items), pContext,
+			      cursor->pVtab->p_cache);
+      }
+    else
+	sqlite3_result_null (pContext);
+    return SQLITE_OK;
+}
+
+static int
+vsubdiv_rowid (sqlite3_vtab_cursor * pCursor, sqlite_int64 * pRowid)
+{
+/* fetching the ROWID */
+    VirtualSubdivCursorPtr cursor = (VirtualSubdivCursorPtr) pCursor;
+    *pRowid = cursor->rowid;
+    return SQLITE_OK;
+}
+
+#endif /* end RTTOPO conditional */
+
+static int
+spliteVirtualElementaryInit (sqlite3 * db, void *p_cache)
 {
     int rc = SQLITE_OK;
     my_elem_module.iVersion = 1;
@@ -1064,12 +1939,50 @@ spliteVirtualElementaryInit (sqlite3 * db)
     my_elem_module.xRename = &velem_rename;
     sqlite3_create_module_v2 (db, "VirtualElementary", &my_elem_module, NULL,
 			      0);
+
+/* eponymous-only modules: the table-valued functions */
+    my_parts_module.iVersion = 1;
+    my_parts_module.xCreate = NULL;
+    my_parts_module.xConnect = &vparts_connect;
+    my_parts_module.xBestIndex = &vparts_best_index;
+    my_parts_module.xDisconnect = &vparts_disconnect;
+    my_parts_module.xDestroy = &vparts_disconnect;
+    my_parts_module.xOpen = &vparts_open;
+    my_parts_module.xClose = &vparts_close;
+    my_parts_module.xFilter = &vparts_filter;
+    my_parts_module.xNext = &vparts_next;
+    my_parts_module.xEof = &vparts_eof;
+    my_parts_module.xColumn = &vparts_column;
+    my_parts_module.xRowid = &vparts_rowid;
+    sqlite3_create_module_v2 (db, "ST_ElementaryParts", &my_parts_module,
+			      p_cache, 0);
+#ifdef ENABLE_RTTOPO		/* only if RTTOPO is enabled */
+    my_subdiv_module = my_parts_module;
+    my_subdiv_module.xConnect = &vparts_subdiv_connect;
+    sqlite3_create_module_v2 (db, "ST_SubdivideParts", &my_subdiv_module,
+			      p_cache, 0);
+    my_subdiv_table_module.iVersion = 1;
+    my_subdiv_table_module.xCreate = NULL;
+    my_subdiv_table_module.xConnect = &vsubdiv_connect;
+    my_subdiv_table_module.xBestIndex = &vsubdiv_best_index;
+    my_subdiv_table_module.xDisconnect = &vparts_disconnect;
+    my_subdiv_table_module.xDestroy = &vparts_disconnect;
+    my_subdiv_table_module.xOpen = &vsubdiv_open;
+    my_subdiv_table_module.xClose = &vsubdiv_close;
+    my_subdiv_table_module.xFilter = &vsubdiv_filter;
+    my_subdiv_table_module.xNext = &vsubdiv_next;
+    my_subdiv_table_module.xEof = &vsubdiv_eof;
+    my_subdiv_table_module.xColumn = &vsubdiv_column;
+    my_subdiv_table_module.xRowid = &vsubdiv_rowid;
+    sqlite3_create_module_v2 (db, "ST_SubdivideTable",
+			      &my_subdiv_table_module, p_cache, 0);
+#endif /* end RTTOPO conditional */
     return rc;
 }
 
 SPATIALITE_PRIVATE int
-virtual_elementary_extension_init (void *xdb)
+virtual_elementary_extension_init (void *xdb, const void *p_cache)
 {
     sqlite3 *db = (sqlite3 *) xdb;
-    return spliteVirtualElementaryInit (db);
+    return spliteVirtualElementaryInit (db, (void *) p_cache);
 }
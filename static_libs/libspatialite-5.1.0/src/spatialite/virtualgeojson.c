@@ -44,6 +44,7 @@ the terms of any one of the MPL, the GPL or the LGPL.
 */
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -67,6 +68,17 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #define strcasecmp	_stricmp
 #endif /* not WIN32 */
 
+/* the persistent Features index ("sidecar" file) */
+#define VGEOJSON_INDEX_SUFFIX	".gjidx"
+#define VGEOJSON_INDEX_MAGIC	"SPLGJIDX"
+#define VGEOJSON_INDEX_END		"SPLGJEND"
+#define VGEOJSON_INDEX_VERSION	1
+
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+/* MbrIntersects(geometry, ?) pushed down into xBestIndex */
+#define VGEOJSON_MBR_INTERSECTS	(SQLITE_INDEX_CONSTRAINT_FUNCTION + 1)
+#endif
+
 static struct sqlite3_module my_geojson_module;
 
 typedef struct VirtualGeoJsonStruct
@@ -86,6 +98,7 @@ typedef struct VirtualGeoJsonStruct
     double MinY;
     double MaxX;
     double MaxY;
+    double *BBoxes;		/* the MBR of each Feature (MinX, MinY, MaxX, MaxY) */
 } VirtualGeoJson;
 typedef VirtualGeoJson *VirtualGeoJsonPtr;
 
@@ -98,6 +111,10 @@ typedef struct VirtualGeoJsonConstraintStruct
     sqlite3_int64 intValue;	/* Int64 comparison value */
     double dblValue;		/* Double comparison value */
     char *txtValue;		/* Text comparison value */
+    double MinX;		/* MBR comparison value */
+    double MinY;
+    double MaxX;
+    double MaxY;
     struct VirtualGeoJsonConstraintStruct *next;
 } VirtualGeoJsonConstraint;
 typedef VirtualGeoJsonConstraint *VirtualGeoJsonConstraintPtr;
@@ -2175,12 +2192,26 @@ vgeojson_get_extent (VirtualGeoJsonPtr p_vt)
     geojson_feature_ptr ft;
     char *error_message;
     gaiaGeomCollPtr geom;
+    double *bbox;
     if (!(p_vt->Valid))
 	return;
 
+    if (p_vt->BBoxes != NULL)
+	free (p_vt->BBoxes);
+    p_vt->BBoxes = malloc (sizeof (double) * 4 * p_vt->Parser->count);
     for (fid = 0; fid < p_vt->Parser->count; fid++)
       {
 	  ft = p_vt->Parser->features + fid;
+	  bbox = NULL;
+	  if (p_vt->BBoxes != NULL)
+	    {
+		/* NULL Geometry: an empty (inverted) MBR */
+		bbox = p_vt->BBoxes + (fid * 4);
+		bbox[0] = DBL_MAX;
+		bbox[1] = DBL_MAX;
+		bbox[2] = -DBL_MAX;
+		bbox[3] = -DBL_MAX;
+	    }
 	  if (!geojson_init_feature (p_vt->Parser, ft, &error_message))
 	    {
 		/* an error occurred */
@@ -2200,12 +2231,317 @@ vgeojson_get_extent (VirtualGeoJsonPtr p_vt)
 		    p_vt->MinY = geom->MinY;
 		if (geom->MaxY > p_vt->MaxY)
 		    p_vt->MaxY = geom->MaxY;
+		if (bbox != NULL)
+		  {
+		      bbox[0] = geom->MinX;
+		      bbox[1] = geom->MinY;
+		      bbox[2] = geom->MaxX;
+		      bbox[3] = geom->MaxY;
+		  }
 		gaiaFreeGeomColl (geom);
 	    }
 	  geojson_reset_feature (ft);
       }
 }
 
+static int
+vgeojson_file_stamp (const char *path, sqlite3_int64 * size,
+		     sqlite3_int64 * mtime)
+{
+/* retrieving size and last modification time of the GeoJSON file */
+    struct stat st;
+    if (stat (path, &st) != 0)
+	return 0;
+    *size = st.st_size;
+    *mtime = st.st_mtime;
+    return 1;
+}
+
+static int
+vgeojson_write_int (FILE * out, int value)
+{
+    return fwrite (&value, sizeof (int), 1, out) == 1;
+}
+
+static int
+vgeojson_write_int64 (FILE * out, sqlite3_int64 value)
+{
+    return fwrite (&value, sizeof (sqlite3_int64), 1, out) == 1;
+}
+
+static int
+vgeojson_write_double (FILE * out, double value)
+{
+    return fwrite (&value, sizeof (double), 1, out) == 1;
+}
+
+static int
+vgeojson_read_int (FILE * in, int *value)
+{
+    return fread (value, sizeof (int), 1, in) == 1;
+}
+
+static int
+vgeojson_read_int64 (FILE * in, sqlite3_int64 * value)
+{
+    return fread (value, sizeof (sqlite3_int64), 1, in) == 1;
+}
+
+static int
+vgeojson_read_double (FILE * in, double *value)
+{
+    return fread (value, sizeof (double), 1, in) == 1;
+}
+
+static void
+vgeojson_save_index (VirtualGeoJsonPtr p_vt, const char *path)
+{
+/* 
+/ attempting to store the Features index into a sidecar file
+/ (just a cache: any failure is silently ignored)
+/
+/ the sidecar file is written in the native byte order; an 
+/ endianness marker invalidates it on any other platform
+*/
+    FILE *out;
+    char *idx_path;
+    int i;
+    sqlite3_int64 size;
+    sqlite3_int64 mtime;
+    geojson_parser_ptr parser = p_vt->Parser;
+    geojson_column_ptr col;
+    int ncols = 0;
+    int ok = 1;
+
+    if (!(p_vt->Valid) || p_vt->BBoxes == NULL)
+	return;
+    if (!vgeojson_file_stamp (path, &size, &mtime))
+	return;
+    idx_path = sqlite3_mprintf ("%s%s", path, VGEOJSON_INDEX_SUFFIX);
+#ifdef _WIN32
+    out = gaia_win_fopen (idx_path, "wb");
+#else
+    out = fopen (idx_path, "wb");
+#endif
+    if (out == NULL)
+      {
+	  sqlite3_free (idx_path);
+	  return;
+      }
+
+/* the header */
+    if (fwrite (VGEOJSON_INDEX_MAGIC, 1, 8, out) != 8)
+	ok = 0;
+    ok = ok && vgeojson_write_int (out, VGEOJSON_INDEX_VERSION);
+    ok = ok && vgeojson_write_int (out, 0x01020304);
+    ok = ok && vgeojson_write_int64 (out, size);
+    ok = ok && vgeojson_write_int64 (out, mtime);
+    ok = ok && vgeojson_write_int (out, parser->count);
+    ok = ok && vgeojson_write_int (out, parser->n_points);
+    ok = ok && vgeojson_write_int (out, parser->n_linestrings);
+    ok = ok && vgeojson_write_int (out, parser->n_polygons);
+    ok = ok && vgeojson_write_int (out, parser->n_mpoints);
+    ok = ok && vgeojson_write_int (out, parser->n_mlinestrings);
+    ok = ok && vgeojson_write_int (out, parser->n_mpolygons);
+    ok = ok && vgeojson_write_int (out, parser->n_geomcolls);
+    ok = ok && vgeojson_write_int (out, parser->n_geom_null);
+    ok = ok && vgeojson_write_int (out, parser->n_geom_2d);
+    ok = ok && vgeojson_write_int (out, parser->n_geom_3d);
+    ok = ok && vgeojson_write_int (out, parser->n_geom_4d);
+    ok = ok && vgeojson_write_double (out, p_vt->MinX);
+    ok = ok && vgeojson_write_double (out, p_vt->MinY);
+    ok = ok && vgeojson_write_double (out, p_vt->MaxX);
+    ok = ok && vgeojson_write_double (out, p_vt->MaxY);
+
+/* the Properties schema */
+    for (col = parser->first_col; col != NULL; col = col->next)
+	ncols++;
+    ok = ok && vgeojson_write_int (out, ncols);
+    for (col = parser->first_col; ok && col != NULL; col = col->next)
+      {
+	  int len = strlen (col->name);
+	  ok = vgeojson_write_int (out, len);
+	  ok = ok && (int) fwrite (col->name, 1, len, out) == len;
+	  ok = ok && vgeojson_write_int (out, col->n_text);
+	  ok = ok && vgeojson_write_int (out, col->n_int);
+	  ok = ok && vgeojson_write_int (out, col->n_double);
+	  ok = ok && vgeojson_write_int (out, col->n_bool);
+	  ok = ok && vgeojson_write_int (out, col->n_null);
+      }
+
+/* the Features: byte offsets and MBR */
+    for (i = 0; ok && i < parser->count; i++)
+      {
+	  geojson_feature_ptr ft = parser->features + i;
+	  double *bbox = p_vt->BBoxes + (i * 4);
+	  ok = vgeojson_write_int64 (out, ft->geom_offset_start);
+	  ok = ok && vgeojson_write_int64 (out, ft->geom_offset_end);
+	  ok = ok && vgeojson_write_int64 (out, ft->prop_offset_start);
+	  ok = ok && vgeojson_write_int64 (out, ft->prop_offset_end);
+	  ok = ok && fwrite (bbox, sizeof (double), 4, out) == 4;
+      }
+    if (ok && fwrite (VGEOJSON_INDEX_END, 1, 8, out) != 8)
+	ok = 0;
+    if (fclose (out) != 0)
+	ok = 0;
+    if (!ok)
+	remove (idx_path);
+    sqlite3_free (idx_path);
+}
+
+static int
+vgeojson_load_index (VirtualGeoJsonPtr p_vt, geojson_parser_ptr parser,
+		     const char *path)
+{
+/* attempting to reuse the Features index stored into a sidecar file */
+    FILE *in;
+    char *idx_path;
+    char magic[8];
+    int i;
+    int version;
+    int endian;
+    int count;
+    int ncols;
+    sqlite3_int64 size;
+    sqlite3_int64 mtime;
+    sqlite3_int64 idx_size;
+    sqlite3_int64 idx_mtime;
+    geojson_column_ptr col;
+    double *bboxes = NULL;
+    int ok = 1;
+
+    if (!vgeojson_file_stamp (path, &size, &mtime))
+	return 0;
+    idx_path = sqlite3_mprintf ("%s%s", path, VGEOJSON_INDEX_SUFFIX);
+#ifdef _WIN32
+    in = gaia_win_fopen (idx_path, "rb");
+#else
+    in = fopen (idx_path, "rb");
+#endif
+    sqlite3_free (idx_path);
+    if (in == NULL)
+	return 0;
+
+/* checking the header */
+    if (fread (magic, 1, 8, in) != 8
+	|| memcmp (magic, VGEOJSON_INDEX_MAGIC, 8) != 0)
+	goto stale;
+    if (!vgeojson_read_int (in, &version)
+	|| version != VGEOJSON_INDEX_VERSION)
+	goto stale;
+    if (!vgeojson_read_int (in, &endian) || endian != 0x01020304)
+	goto stale;
+    if (!vgeojson_read_int64 (in, &idx_size) || idx_size != size)
+	goto stale;
+    if (!vgeojson_read_int64 (in, &idx_mtime) || idx_mtime != mtime)
+	goto stale;
+    if (!vgeojson_read_int (in, &count) || count <= 0)
+	goto stale;
+    ok = vgeojson_read_int (in, &(parser->n_points));
+    ok = ok && vgeojson_read_int (in, &(parser->n_linestrings));
+    ok = ok && vgeojson_read_int (in, &(parser->n_polygons));
+    ok = ok && vgeojson_read_int (in, &(parser->n_mpoints));
+    ok = ok && vgeojson_read_int (in, &(parser->n_mlinestrings));
+    ok = ok && vgeojson_read_int (in, &(parser->n_mpolygons));
+    ok = ok && vgeojson_read_int (in, &(parser->n_geomcolls));
+    ok = ok && vgeojson_read_int (in, &(parser->n_geom_null));
+    ok = ok && vgeojson_read_int (in, &(parser->n_geom_2d));
+    ok = ok && vgeojson_read_int (in, &(parser->n_geom_3d));
+    ok = ok && vgeojson_read_int (in, &(parser->n_geom_4d));
+    ok = ok && vgeojson_read_double (in, &(p_vt->MinX));
+    ok = ok && vgeojson_read_double (in, &(p_vt->MinY));
+    ok = ok && vgeojson_read_double (in, &(p_vt->MaxX));
+    ok = ok && vgeojson_read_double (in, &(p_vt->MaxY));
+    if (!ok)
+	goto stale;
+
+/* restoring the Properties schema */
+    if (!vgeojson_read_int (in, &ncols) || ncols < 0)
+	goto stale;
+    for (i = 0; i < ncols; i++)
+      {
+	  int len;
+	  if (!vgeojson_read_int (in, &len) || len < 0 || len > GEOJSON_MAX)
+	      goto stale;
+	  col = malloc (sizeof (geojson_column));
+	  col->name = malloc (len + 1);
+	  col->next = NULL;
+	  if (parser->first_col == NULL)
+	      parser->first_col = col;
+	  if (parser->last_col != NULL)
+	      parser->last_col->next = col;
+	  parser->last_col = col;
+	  ok = (int) fread (col->name, 1, len, in) == len;
+	  *(col->name + len) = '\0';
+	  ok = ok && vgeojson_read_int (in, &(col->n_text));
+	  ok = ok && vgeojson_read_int (in, &(col->n_int));
+	  ok = ok && vgeojson_read_int (in, &(col->n_double));
+	  ok = ok && vgeojson_read_int (in, &(col->n_bool));
+	  ok = ok && vgeojson_read_int (in, &(col->n_null));
+	  if (!ok)
+	      goto stale;
+      }
+
+/* restoring the Features: byte offsets and MBR */
+    parser->features = malloc (sizeof (geojson_feature) * count);
+    bboxes = malloc (sizeof (double) * 4 * count);
+    if (parser->features == NULL || bboxes == NULL)
+	goto stale;
+    parser->count = count;
+    for (i = 0; i < count; i++)
+      {
+	  geojson_feature_ptr ft = parser->features + i;
+	  sqlite3_int64 offsets[4];
+	  ft->fid = i + 1;
+	  ft->geometry = NULL;
+	  ft->first = NULL;
+	  ft->last = NULL;
+	  ok = vgeojson_read_int64 (in, offsets + 0);
+	  ok = ok && vgeojson_read_int64 (in, offsets + 1);
+	  ok = ok && vgeojson_read_int64 (in, offsets + 2);
+	  ok = ok && vgeojson_read_int64 (in, offsets + 3);
+	  ok = ok && fread (bboxes + (i * 4), sizeof (double), 4, in) == 4;
+	  ft->geom_offset_start = (long) offsets[0];
+	  ft->geom_offset_end = (long) offsets[1];
+	  ft->prop_offset_start = (long) offsets[2];
+	  ft->prop_offset_end = (long) offsets[3];
+	  if (!ok)
+	      goto stale;
+      }
+    if (fread (magic, 1, 8, in) != 8
+	|| memcmp (magic, VGEOJSON_INDEX_END, 8) != 0)
+	goto stale;
+    fclose (in);
+    p_vt->BBoxes = bboxes;
+    return 1;
+
+  stale:
+/* missing, truncated or outdated index: the GeoJSON file will be parsed */
+    fclose (in);
+    if (bboxes != NULL)
+	free (bboxes);
+    if (parser->features != NULL)
+      {
+	  free (parser->features);
+	  parser->features = NULL;
+      }
+    parser->count = 0;
+    parser->n_geom_null = 0;
+    while (parser->first_col != NULL)
+      {
+	  col = parser->first_col->next;
+	  free (parser->first_col->name);
+	  free (parser->first_col);
+	  parser->first_col = col;
+      }
+    parser->last_col = NULL;
+    p_vt->MinX = DBL_MAX;
+    p_vt->MinY = DBL_MAX;
+    p_vt->MaxX = -DBL_MAX;
+    p_vt->MaxY = -DBL_MAX;
+    return 0;
+}
+
 static int
 vgeojson_create (sqlite3 * db, void *pAux, int argc, const char *const *argv,
 		 sqlite3_vtab ** ppVTab, char **pzErr)
@@ -2291,6 +2627,8 @@ vgeojson_create (sqlite3 * db, void *pAux, int argc, const char *const *argv,
     p_vt->db = db;
     p_vt->Srid = srid;
     p_vt->Valid = 0;
+    p_vt->Parser = NULL;
+    p_vt->BBoxes = NULL;
     p_vt->DeclaredType = GAIA_GEOMETRYCOLLECTION;
     p_vt->DimensionModel = GAIA_XY;
     len = strlen (argv[2]);
@@ -2316,6 +2654,14 @@ vgeojson_create (sqlite3 * db, void *pAux, int argc, const char *const *argv,
       }
 /* creating the GeoJSON parser */
     parser = geojson_create_parser (in);
+    parser->n_geom_null = 0;
+    p_vt->Parser = parser;
+    if (vgeojson_load_index (p_vt, parser, path))
+      {
+	  /* reusing a still valid Features index: no parsing at all */
+	  p_vt->Valid = 1;
+	  goto indexed;
+      }
     if (!geojson_parser_init (parser, &error_message))
 	goto err;
     if (!geojson_create_features_index (parser, &error_message))
@@ -2333,6 +2679,8 @@ vgeojson_create (sqlite3 * db, void *pAux, int argc, const char *const *argv,
       }
   ok:
     vgeojson_get_extent (p_vt);
+    vgeojson_save_index (p_vt, path);
+  indexed:
     if (!(p_vt->Valid))
       {
 	  /* something is going the wrong way; creating a stupid default table */
@@ -2697,6 +3045,24 @@ vgeojson_best_index (sqlite3_vtab * pVTab, sqlite3_index_info * pIndex)
 			 pIndex->aConstraint[i].op);
 		strcat (str, buf);
 	    }
+#ifdef VGEOJSON_MBR_INTERSECTS
+	  else if (pIndex->aConstraint[i].usable
+		   && pIndex->aConstraint[i].op == VGEOJSON_MBR_INTERSECTS
+		   && pIndex->aConstraint[i].iColumn == 1)
+	    {
+		/* 
+		/ MbrIntersects(geometry, ?): Features whose MBR is disjoint
+		/ are skipped before being read; SQLite will still evaluate
+		/ the function on any other row
+		*/
+		iArg++;
+		pIndex->aConstraintUsage[i].argvIndex = iArg;
+		pIndex->aConstraintUsage[i].omit = 0;
+		sprintf (buf, "%d:%d,", pIndex->aConstraint[i].iColumn,
+			 pIndex->aConstraint[i].op);
+		strcat (str, buf);
+	    }
+#endif
       }
     if (*str != '\0')
       {
@@ -2731,6 +3097,10 @@ vgeojson_disconnect (sqlite3_vtab * pVTab)
 
     if (p_vt->TableName != NULL)
 	free (p_vt->TableName);
+    if (p_vt->Parser != NULL)
+	geojson_destroy_parser (p_vt->Parser);
+    if (p_vt->BBoxes != NULL)
+	free (p_vt->BBoxes);
     sqlite3_free (p_vt);
 
     return SQLITE_OK;
@@ -2946,6 +3316,12 @@ vgeojson_eval_constraints (VirtualGeoJsonCursorPtr cursor)
 			    if (cursor->Feature->geometry != NULL)
 				ok = 1;
 			    break;
+#ifdef VGEOJSON_MBR_INTERSECTS
+			case VGEOJSON_MBR_INTERSECTS:
+			    /* already checked by vgeojson_skip_feature() */
+			    ok = 1;
+			    break;
+#endif
 			};
 
 		  }
@@ -2953,6 +3329,10 @@ vgeojson_eval_constraints (VirtualGeoJsonCursorPtr cursor)
 		  {
 		      if (pC->op == SQLITE_INDEX_CONSTRAINT_ISNULL)
 			  ok = 1;
+#ifdef VGEOJSON_MBR_INTERSECTS
+		      if (pC->op == VGEOJSON_MBR_INTERSECTS)
+			  ok = 1;
+#endif
 		  }
 		goto done;
 	    }
@@ -3142,6 +3522,37 @@ vgeojson_eval_constraints (VirtualGeoJsonCursorPtr cursor)
     return 1;
 }
 
+static int
+vgeojson_skip_feature (VirtualGeoJsonCursorPtr cursor)
+{
+/* 
+/ testing the current Feature against any MBR constraint 
+/ using the Features index alone (no file access at all)
+*/
+    VirtualGeoJsonConstraintPtr pC;
+    double *bbox;
+    int fid = cursor->current_fid;
+    if (cursor->pVtab->BBoxes == NULL)
+	return 0;
+    if (fid < 0 || fid >= cursor->pVtab->Parser->count)
+	return 0;
+    bbox = cursor->pVtab->BBoxes + (fid * 4);
+    if (bbox[0] > bbox[2])
+	return 0;		/* NULL Geometry: left to the SQL function */
+    pC = cursor->firstConstraint;
+    while (pC)
+      {
+	  if (pC->iColumn == 1 && pC->valueType == 'B')
+	    {
+		if (bbox[0] > pC->MaxX || bbox[2] < pC->MinX
+		    || bbox[1] > pC->MaxY || bbox[3] < pC->MinY)
+		    return 1;
+	    }
+	  pC = pC->next;
+      }
+    return 0;
+}
+
 static int
 vgeojson_filter (sqlite3_vtab_cursor * pCursor, int idxNum, const char *idxStr,
 		 int argc, sqlite3_value ** argv)
@@ -3182,6 +3593,27 @@ vgeojson_filter (sqlite3_vtab_cursor * pCursor, int idxNum, const char *idxStr,
 		pC->valueType = 'D';
 		pC->dblValue = sqlite3_value_double (argv[i]);
 	    }
+#ifdef VGEOJSON_MBR_INTERSECTS
+	  if (op == VGEOJSON_MBR_INTERSECTS
+	      && sqlite3_value_type (argv[i]) == SQLITE_BLOB)
+	    {
+		/* the MBR of some Geometry */
+		const unsigned char *blob =
+		    (const unsigned char *) sqlite3_value_blob (argv[i]);
+		int size = sqlite3_value_bytes (argv[i]);
+		gaiaGeomCollPtr mbr = gaiaFromSpatiaLiteBlobMbr (blob, size);
+		if (mbr != NULL)
+		  {
+		      gaiaMbrGeometry (mbr);
+		      pC->valueType = 'B';
+		      pC->MinX = mbr->MinX;
+		      pC->MinY = mbr->MinY;
+		      pC->MaxX = mbr->MaxX;
+		      pC->MaxY = mbr->MaxY;
+		      gaiaFreeGeomColl (mbr);
+		  }
+	    }
+#endif
 	  if (sqlite3_value_type (argv[i]) == SQLITE_TEXT)
 	    {
 		pC->valueType = 'T';
@@ -3202,6 +3634,11 @@ vgeojson_filter (sqlite3_vtab_cursor * pCursor, int idxNum, const char *idxStr,
     cursor->eof = 0;
     while (1)
       {
+	  if (vgeojson_skip_feature (cursor))
+	    {
+		cursor->current_fid += 1;
+		continue;
+	    }
 	  vgeojson_read_row (cursor);
 	  if (cursor->eof)
 	      break;
@@ -3220,6 +3657,11 @@ vgeojson_next (sqlite3_vtab_cursor * pCursor)
     cursor->current_fid += 1;
     while (1)
       {
+	  if (vgeojson_skip_feature (cursor))
+	    {
+		cursor->current_fid += 1;
+		continue;
+	    }
 	  vgeojson_read_row (cursor);
 	  if (cursor->eof)
 	      break;
@@ -3410,6 +3852,62 @@ vgeojson_rename (sqlite3_vtab * pVTab, const char *zNew)
     return SQLITE_ERROR;
 }
 
+#ifdef VGEOJSON_MBR_INTERSECTS
+static void
+vgeojson_mbr_intersects (sqlite3_context * context, int argc,
+			 sqlite3_value ** argv)
+{
+/* MbrIntersects() overloaded for VirtualGeoJSON - same as the SQL function */
+    gaiaGeomCollPtr geo1 = NULL;
+    gaiaGeomCollPtr geo2 = NULL;
+    if (argc)
+	argc = argc;		/* unused arg warning suppression */
+    if (sqlite3_value_type (argv[0]) == SQLITE_BLOB)
+	geo1 =
+	    gaiaFromSpatiaLiteBlobMbr ((const unsigned char *)
+				       sqlite3_value_blob (argv[0]),
+				       sqlite3_value_bytes (argv[0]));
+    if (sqlite3_value_type (argv[1]) == SQLITE_BLOB)
+	geo2 =
+	    gaiaFromSpatiaLiteBlobMbr ((const unsigned char *)
+				       sqlite3_value_blob (argv[1]),
+				       sqlite3_value_bytes (argv[1]));
+    if (geo1 == NULL || geo2 == NULL)
+	sqlite3_result_int (context, -1);
+    else
+      {
+	  gaiaMbrGeometry (geo1);
+	  gaiaMbrGeometry (geo2);
+	  sqlite3_result_int (context, gaiaMbrsIntersects (geo1, geo2));
+      }
+    if (geo1 != NULL)
+	gaiaFreeGeomColl (geo1);
+    if (geo2 != NULL)
+	gaiaFreeGeomColl (geo2);
+}
+
+static int
+vgeojson_find_function (sqlite3_vtab * pVTab, int nArg, const char *zName,
+			void (**pxFunc) (sqlite3_context *, int,
+					 sqlite3_value **), void **ppArg)
+{
+/* overloading the MBR functions supporting a spatial filter */
+    if (pVTab)
+	pVTab = pVTab;		/* unused arg warning suppression */
+    if (nArg != 2)
+	return 0;
+    if (strcasecmp (zName, "MbrIntersects") == 0
+	|| strcasecmp (zName, "ST_EnvIntersects") == 0
+	|| strcasecmp (zName, "ST_EnvelopesIntersects") == 0)
+      {
+	  *pxFunc = vgeojson_mbr_intersects;
+	  *ppArg = NULL;
+	  return VGEOJSON_MBR_INTERSECTS;
+      }
+    return 0;
+}
+#endif
+
 static int
 spliteVirtualGeoJsonInit (sqlite3 * db)
 {
@@ -3432,7 +3930,11 @@ spliteVirtualGeoJsonInit (sqlite3 * db)
     my_geojson_module.xSync = &vgeojson_sync;
     my_geojson_module.xCommit = &vgeojson_commit;
     my_geojson_module.xRollback = &vgeojson_rollback;
+#ifdef VGEOJSON_MBR_INTERSECTS
+    my_geojson_module.xFindFunction = &vgeojson_find_function;
+#else
     my_geojson_module.xFindFunction = NULL;
+#endif
     my_geojson_module.xRename = &vgeojson_rename;
     sqlite3_create_module_v2 (db, "VirtualGeoJSON", &my_geojson_module, NULL,
 			      0);
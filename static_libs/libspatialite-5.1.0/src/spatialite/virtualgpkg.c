@@ -83,6 +83,11 @@ the terms of any one of the MPL, the GPL or the LGPL.
 
 struct sqlite3_module my_gpkg_module;
 
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+/* MbrIntersects(geometry, ?) pushed down into xBestIndex */
+#define VGPKG_MBR_INTERSECTS	(SQLITE_INDEX_CONSTRAINT_FUNCTION + 1)
+#endif
+
 typedef struct SqliteValue
 {
 /* a multitype storing a column value */
@@ -92,6 +97,7 @@ typedef struct SqliteValue
     char *Text;
     unsigned char *Blob;
     int Size;
+    int Gpb;			/* TRUE if the Blob still is a GPKG Geometry */
 } SqliteValue;
 typedef SqliteValue *SqliteValuePtr;
 
@@ -122,6 +128,12 @@ typedef struct VirtualGPKGCursorStruct
     sqlite3_stmt *stmt;
     sqlite3_int64 current_row;	/* the current row ID */
     int eof;			/* the EOF marker */
+    int GeoIndex;		/* index of the Geometry column */
+    int MbrFilter;		/* TRUE if an MBR spatial filter is active */
+    double MinX;		/* the MBR spatial filter */
+    double MinY;
+    double MaxX;
+    double MaxY;
 } VirtualGPKGCursor;
 typedef VirtualGPKGCursor *VirtualGPKGCursorPtr;
 
@@ -133,6 +145,7 @@ value_alloc (void)
     p->Type = SQLITE_NULL;
     p->Text = NULL;
     p->Blob = NULL;
+    p->Gpb = 0;
     return p;
 }
 
@@ -228,6 +241,64 @@ value_set_blob (SqliteValuePtr p, const unsigned char *value, int size)
     p->Blob = malloc (size);
     memcpy (p->Blob, value, size);
     p->Size = size;
+    p->Gpb = 0;
+}
+
+static void
+value_set_gpb (SqliteValuePtr p, const unsigned char *value, int size)
+{
+/* 
+/ setting a GPKG Geometry to the multitype: it will be lazily
+/ converted into a SpatiaLite Geometry by vgpkg_column()
+*/
+    if (!p)
+	return;
+    value_set_blob (p, value, size);
+    p->Gpb = 1;
+}
+
+static int
+vgpkg_geometry_index (VirtualGPKGPtr p_vt)
+{
+/* returns the index of the Geometry column (-1 if not found) */
+    int ic;
+    if (p_vt->GeoColumn == NULL)
+	return -1;
+    for (ic = 0; ic < p_vt->nColumns; ic++)
+      {
+	  if (strcasecmp (*(p_vt->Column + ic), p_vt->GeoColumn) == 0)
+	      return ic;
+      }
+    return -1;
+}
+
+static int
+vgpkg_mbr_skip (VirtualGPKGCursorPtr cursor, sqlite3_stmt * stmt)
+{
+/* 
+/ checking the MBR spatial filter against the GPKG header
+/ (no Geometry will be decoded at all)
+/
+/ returns TRUE if the current row has to be skipped
+*/
+    const unsigned char *blob;
+    int size;
+    double minx;
+    double maxx;
+    double miny;
+    double maxy;
+    if (!cursor->MbrFilter || cursor->GeoIndex < 0)
+	return 0;
+    if (sqlite3_column_type (stmt, cursor->GeoIndex + 1) != SQLITE_BLOB)
+	return 0;
+    blob = sqlite3_column_blob (stmt, cursor->GeoIndex + 1);
+    size = sqlite3_column_bytes (stmt, cursor->GeoIndex + 1);
+    if (!gaiaGetMbrFromGPB (blob, size, &minx, &maxx, &miny, &maxy))
+	return 0;		/* undecidable: MbrIntersects() returns -1 */
+    if (minx > cursor->MaxX || maxx < cursor->MinX || miny > cursor->MaxY
+	|| maxy < cursor->MinY)
+	return 1;
+    return 0;
 }
 
 static void
@@ -243,7 +314,12 @@ vgpkg_read_row (VirtualGPKGCursorPtr cursor)
     sqlite3_int64 pk;
     stmt = cursor->stmt;
     sqlite3_bind_int64 (stmt, 1, cursor->current_row);
-    ret = sqlite3_step (stmt);
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret != SQLITE_ROW || !vgpkg_mbr_skip (cursor, stmt))
+	      break;
+      }
     if (ret == SQLITE_ROW)
       {
 	  pk = sqlite3_column_int64 (stmt, 0);
@@ -268,7 +344,12 @@ vgpkg_read_row (VirtualGPKGCursorPtr cursor)
 		  case SQLITE_BLOB:
 		      blob = sqlite3_column_blob (stmt, ic + 1);
 		      size = sqlite3_column_bytes (stmt, ic + 1);
-		      value_set_blob (*(cursor->pVtab->Value + ic), blob, size);
+		      if (ic == cursor->GeoIndex)
+			  value_set_gpb (*(cursor->pVtab->Value + ic), blob,
+					 size);
+		      else
+			  value_set_blob (*(cursor->pVtab->Value + ic), blob,
+					  size);
 		      break;
 		  case SQLITE_NULL:
 		  default:
@@ -837,8 +918,33 @@ static int
 vgpkg_best_index (sqlite3_vtab * pVTab, sqlite3_index_info * pIndex)
 {
 /* best index selection */
+#ifdef VGPKG_MBR_INTERSECTS
+    int i;
+    int geo_index = vgpkg_geometry_index ((VirtualGPKGPtr) pVTab);
+    for (i = 0; i < pIndex->nConstraint; i++)
+      {
+	  if (pIndex->aConstraint[i].usable
+	      && pIndex->aConstraint[i].op == VGPKG_MBR_INTERSECTS
+	      && pIndex->aConstraint[i].iColumn == geo_index)
+	    {
+		/* 
+		/ MbrIntersects(geometry, ?): the MBR test is fully resolved
+		/ by vgpkg_filter() on the GPKG header, so SQLite doesn't
+		/ need to decode the Geometry and to evaluate the function
+		*/
+		pIndex->idxNum = 1;
+		pIndex->aConstraintUsage[i].argvIndex = 1;
+		pIndex->aConstraintUsage[i].omit = 1;
+		pIndex->estimatedCost = 1000.0;
+		return SQLITE_OK;
+	    }
+      }
+    pIndex->idxNum = 0;
+    pIndex->estimatedCost = 1000000.0;
+#else
     if (pVTab || pIndex)
 	pVTab = pVTab;		/* unused arg warning suppression */
+#endif
     return SQLITE_OK;
 }
 
@@ -874,20 +980,16 @@ vgpkg_open (sqlite3_vtab * pVTab, sqlite3_vtab_cursor ** ppCursor)
     if (cursor == NULL)
 	return SQLITE_ERROR;
     cursor->pVtab = (VirtualGPKGPtr) pVTab;
+/* the Geometry column is fetched as raw GPKG BLOB */
+    cursor->GeoIndex = vgpkg_geometry_index (cursor->pVtab);
+    cursor->MbrFilter = 0;
     gaiaOutBufferInitialize (&sql_statement);
     gaiaAppendToOutBuffer (&sql_statement, "SELECT ROWID");
     for (ic = 0; ic < cursor->pVtab->nColumns; ic++)
       {
 	  value_set_null (*(cursor->pVtab->Value + ic));
 	  xname = gaiaDoubleQuotedSql (*(cursor->pVtab->Column + ic));
-	  if (strcasecmp
-	      (*(cursor->pVtab->Column + ic), cursor->pVtab->GeoColumn) == 0)
-	    {
-		/* this is the geometry column */
-		sql = sqlite3_mprintf (",GeomFromGPB(\"%s\")", xname);
-	    }
-	  else
-	      sql = sqlite3_mprintf (",\"%s\"", xname);
+	  sql = sqlite3_mprintf (",\"%s\"", xname);
 	  free (xname);
 	  gaiaAppendToOutBuffer (&sql_statement, sql);
 	  sqlite3_free (sql);
@@ -939,8 +1041,34 @@ vgpkg_filter (sqlite3_vtab_cursor * pCursor, int idxNum, const char *idxStr,
 	      int argc, sqlite3_value ** argv)
 {
 /* setting up a cursor filter */
-    if (pCursor || idxNum || idxStr || argc || argv)
-	pCursor = pCursor;	/* unused arg warning suppression */
+    VirtualGPKGCursorPtr cursor = (VirtualGPKGCursorPtr) pCursor;
+    gaiaGeomCollPtr mbr;
+    if (idxStr)
+	idxStr = idxStr;	/* unused arg warning suppression */
+    cursor->MbrFilter = 0;
+    if (idxNum == 1 && argc == 1
+	&& sqlite3_value_type (argv[0]) == SQLITE_BLOB)
+      {
+	  /* MbrIntersects(geometry, ?) spatial filter */
+	  mbr =
+	      gaiaFromSpatiaLiteBlobMbr ((const unsigned char *)
+					 sqlite3_value_blob (argv[0]),
+					 sqlite3_value_bytes (argv[0]));
+	  if (mbr != NULL)
+	    {
+		gaiaMbrGeometry (mbr);
+		cursor->MbrFilter = 1;
+		cursor->MinX = mbr->MinX;
+		cursor->MinY = mbr->MinY;
+		cursor->MaxX = mbr->MaxX;
+		cursor->MaxY = mbr->MaxY;
+		gaiaFreeGeomColl (mbr);
+	    }
+      }
+/* restarting from the first row */
+    sqlite3_reset (cursor->stmt);
+    cursor->current_row = LONG64_MIN;
+    vgpkg_read_row (cursor);
     return SQLITE_OK;
 }
 
@@ -969,9 +1097,28 @@ vgpkg_column (sqlite3_vtab_cursor * pCursor, sqlite3_context * pContext,
 /* fetching value for the Nth column */
     VirtualGPKGCursorPtr cursor = (VirtualGPKGCursorPtr) pCursor;
     SqliteValuePtr value;
+    gaiaGeomCollPtr geom;
+    unsigned char *p_blob;
+    int n_bytes;
     if (column >= 0 && column < cursor->pVtab->nColumns)
       {
 	  value = *(cursor->pVtab->Value + column);
+	  if (value->Type == SQLITE_BLOB && value->Gpb)
+	    {
+		/* lazily converting the GPKG Geometry - same as GeomFromGPB() */
+		geom = gaiaFromGeoPackageGeometryBlob (value->Blob, value->Size);
+		if (geom == NULL)
+		    value_set_null (value);
+		else
+		  {
+		      gaiaToSpatiaLiteBlobWkb (geom, &p_blob, &n_bytes);
+		      gaiaFreeGeomColl (geom);
+		      free (value->Blob);
+		      value->Blob = p_blob;
+		      value->Size = n_bytes;
+		      value->Gpb = 0;
+		  }
+	    }
 	  switch (value->Type)
 	    {
 	    case SQLITE_INTEGER:
@@ -1092,6 +1239,62 @@ vgpkg_rename (sqlite3_vtab * pVTab, const char *zNew)
     return SQLITE_ERROR;
 }
 
+#ifdef VGPKG_MBR_INTERSECTS
+static void
+vgpkg_mbr_intersects (sqlite3_context * context, int argc,
+		      sqlite3_value ** argv)
+{
+/* MbrIntersects() overloaded for VirtualGPKG - same as the SQL function */
+    gaiaGeomCollPtr geo1 = NULL;
+    gaiaGeomCollPtr geo2 = NULL;
+    if (argc)
+	argc = argc;		/* unused arg warning suppression */
+    if (sqlite3_value_type (argv[0]) == SQLITE_BLOB)
+	geo1 =
+	    gaiaFromSpatiaLiteBlobMbr ((const unsigned char *)
+				       sqlite3_value_blob (argv[0]),
+				       sqlite3_value_bytes (argv[0]));
+    if (sqlite3_value_type (argv[1]) == SQLITE_BLOB)
+	geo2 =
+	    gaiaFromSpatiaLiteBlobMbr ((const unsigned char *)
+				       sqlite3_value_blob (argv[1]),
+				       sqlite3_value_bytes (argv[1]));
+    if (geo1 == NULL || geo2 == NULL)
+	sqlite3_result_int (context, -1);
+    else
+      {
+	  gaiaMbrGeometry (geo1);
+	  gaiaMbrGeometry (geo2);
+	  sqlite3_result_int (context, gaiaMbrsIntersects (geo1, geo2));
+      }
+    if (geo1 != NULL)
+	gaiaFreeGeomColl (geo1);
+    if (geo2 != NULL)
+	gaiaFreeGeomColl (geo2);
+}
+
+static int
+vgpkg_find_function (sqlite3_vtab * pVTab, int nArg, const char *zName,
+		     void (**pxFunc) (sqlite3_context *, int,
+				      sqlite3_value **), void **ppArg)
+{
+/* overloading the MBR functions supporting a spatial filter */
+    if (pVTab)
+	pVTab = pVTab;		/* unused arg warning suppression */
+    if (nArg != 2)
+	return 0;
+    if (strcasecmp (zName, "MbrIntersects") == 0
+	|| strcasecmp (zName, "ST_EnvIntersects") == 0
+	|| strcasecmp (zName, "ST_EnvelopesIntersects") == 0)
+      {
+	  *pxFunc = vgpkg_mbr_intersects;
+	  *ppArg = NULL;
+	  return VGPKG_MBR_INTERSECTS;
+      }
+    return 0;
+}
+#endif
+
 static int
 spliteVirtualGPKGInit (sqlite3 * db)
 {
@@ -1114,7 +1317,11 @@ spliteVirtualGPKGInit (sqlite3 * db)
     my_gpkg_module.xSync = &vgpkg_sync;
     my_gpkg_module.xCommit = &vgpkg_commit;
     my_gpkg_module.xRollback = &vgpkg_rollback;
+#ifdef VGPKG_MBR_INTERSECTS
+    my_gpkg_module.xFindFunction = &vgpkg_find_function;
+#else
     my_gpkg_module.xFindFunction = NULL;
+#endif
     my_gpkg_module.xRename = &vgpkg_rename;
     sqlite3_create_module_v2 (db, "VirtualGPKG", &my_gpkg_module, NULL, 0);
     return rc;
@@ -63,6 +63,7 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include <spatialite/sqlite.h>
 
 #include <spatialite.h>
+#include <spatialite_private.h>
 #include <spatialite/spatialite_ext.h>
 #include <spatialite/gaiaaux.h>
 #include <spatialite/gaiageo.h>
@@ -77,6 +78,7 @@ static struct sqlite3_module my_route_module;
 #define VROUTE_POINT2POINT_ERROR	0xca
 #define VROUTE_RANGE_SOLUTION		0xbb
 #define VROUTE_TSP_SOLUTION			0xee
+#define VROUTE_MATRIX_SOLUTION		0xaa
 
 #define VROUTE_SHORTEST_PATH_FULL		0x70
 #define VROUTE_SHORTEST_PATH_NO_LINKS	0x71
@@ -87,6 +89,7 @@ static struct sqlite3_module my_route_module;
 #define VROUTE_SHORTEST_PATH			0x91
 #define VROUTE_TSP_NN					0x92
 #define VROUTE_TSP_GA					0x93
+#define VROUTE_MATRIX					0x94
 
 #define VROUTE_INVALID_SRID	-1234
 
@@ -179,6 +182,17 @@ typedef struct RoutingStruct
     int HasZ;
     int Srid;
     RouteNodePtr Nodes;
+    int NumLinks;
+    RouteLinkPtr LinksPool;	/* all Links, stored node after node */
+    char *CodesPool;		/* all Node Codes, fixed width */
+/* sharing the same NETWORK between many connections */
+    char *DbPath;
+    char *DataTable;
+    sqlite3_int64 SchemaVersion;
+    sqlite3_int64 NumBlocks;
+    sqlite3_int64 DataSize;
+    int RefCount;
+    struct RoutingStruct *Next;
 } Routing;
 typedef Routing *RoutingPtr;
 
@@ -274,13 +288,29 @@ typedef struct RoutingMultiDestStruct
 } RoutingMultiDest;
 typedef RoutingMultiDest *RoutingMultiDestPtr;
 
+typedef struct RoutingMatrixStruct
+{
+/* a many-to-many Cost Matrix */
+    RoutingPtr Graph;
+    int NumFrom;
+    RouteNodePtr *From;
+    int NumTo;
+    RouteNodePtr *To;
+    char *IsTarget;
+    int NumTargets;
+    double *Costs;
+} RoutingMatrix;
+typedef RoutingMatrix *RoutingMatrixPtr;
+
 typedef struct MultiSolutionStruct
 {
 /* multiple shortest path solutions */
     unsigned char Mode;
     RouteNodePtr From;
     double MaxCost;
+    RoutingMultiDestPtr MultiFrom;
     RoutingMultiDestPtr MultiTo;
+    RoutingMatrixPtr Matrix;
     ResultsetRowPtr FirstRow;
     ResultsetRowPtr LastRow;
     ResultsetRowPtr CurrentRow;
@@ -467,6 +497,28 @@ typedef struct RoutingHeapStruct
 } RoutingHeap;
 typedef RoutingHeap *RoutingHeapPtr;
 
+typedef struct MatrixHeapNodeStruct
+{
+    int Index;
+    double Distance;
+} MatrixHeapNode;
+typedef MatrixHeapNode *MatrixHeapNodePtr;
+
+typedef struct RoutingMatrixWorkerStruct
+{
+/* a thread computing some rows of the Cost Matrix */
+    RoutingMatrixPtr Matrix;
+    int FirstRow;
+    int RowStep;
+    double *Distance;
+    unsigned int *Reached;
+    unsigned int *Settled;
+    unsigned int Pass;
+    MatrixHeapNodePtr Heap;
+    int HeapCount;
+} RoutingMatrixWorker;
+typedef RoutingMatrixWorker *RoutingMatrixWorkerPtr;
+
 /******************************************************************************
 /
 / VirtualTable structs
@@ -675,6 +727,246 @@ routing_dequeue (RoutingHeapPtr heap)
 
 /* END of Luigi Costalli Dijkstra Shortest Path implementation */
 
+/******************************************************************************
+/
+/ many-to-many Cost Matrix
+/
+/ a plain Dijkstra tree is grown from each origin directly on top of the
+/ (read-only) NETWORK; every thread owns its own Distance array and heap, so
+/ that the origins can be safely spread between several threads
+/
+******************************************************************************/
+
+static void
+matrix_heap_push (RoutingMatrixWorkerPtr worker, int index, double distance)
+{
+/* inserting a new Node into the heap */
+    MatrixHeapNodePtr heap = worker->Heap;
+    MatrixHeapNode tmp;
+    int i;
+    worker->HeapCount += 1;
+    i = worker->HeapCount;
+    heap[i].Index = index;
+    heap[i].Distance = distance;
+    while (i > 1 && heap[i].Distance < heap[i / 2].Distance)
+      {
+	  tmp = heap[i];
+	  heap[i] = heap[i / 2];
+	  heap[i / 2] = tmp;
+	  i /= 2;
+      }
+}
+
+static int
+matrix_heap_pop (RoutingMatrixWorkerPtr worker, double *distance)
+{
+/* removing the min-priority Node from the heap */
+    MatrixHeapNodePtr heap = worker->Heap;
+    MatrixHeapNode tmp;
+    int size;
+    int index = heap[1].Index;
+    int i = 1;
+    int c;
+    *distance = heap[1].Distance;
+    heap[1] = heap[worker->HeapCount];
+    worker->HeapCount -= 1;
+    size = worker->HeapCount;
+    for (;;)
+      {
+	  c = i * 2;
+	  if (c > size)
+	      break;
+	  if (c < size && heap[c].Distance > heap[c + 1].Distance)
+	      ++c;
+	  if (heap[c].Distance >= heap[i].Distance)
+	      break;
+	  tmp = heap[c];
+	  heap[c] = heap[i];
+	  heap[i] = tmp;
+	  i = c;
+      }
+    return index;
+}
+
+static void
+routing_matrix_row (RoutingMatrixWorkerPtr worker, int row)
+{
+/* computing a single row of the Cost Matrix */
+    RoutingMatrixPtr matrix = worker->Matrix;
+    RouteNodePtr from = *(matrix->From + row);
+    double *costs = matrix->Costs + ((size_t) row * matrix->NumTo);
+    unsigned int pass;
+    int settled = 0;
+    int j;
+
+    for (j = 0; j < matrix->NumTo; j++)
+	*(costs + j) = DBL_MAX;
+    if (from == NULL)
+	return;
+
+/* a new pass silently invalidates all values set by the previous one */
+    worker->Pass += 1;
+    pass = worker->Pass;
+    worker->HeapCount = 0;
+    worker->Distance[from->InternalIndex] = 0.0;
+    worker->Reached[from->InternalIndex] = pass;
+    matrix_heap_push (worker, from->InternalIndex, 0.0);
+    while (worker->HeapCount > 0)
+      {
+	  /* Dijkstra loop */
+	  double distance;
+	  RouteNodePtr node;
+	  int index = matrix_heap_pop (worker, &distance);
+	  if (worker->Settled[index] == pass)
+	      continue;		/* stale heap entry */
+	  worker->Settled[index] = pass;
+	  if (matrix->IsTarget[index])
+	    {
+		/* testing for end (all targets already reached) */
+		settled++;
+		if (settled >= matrix->NumTargets)
+		    break;
+	    }
+	  node = matrix->Graph->Nodes + index;
+	  for (j = 0; j < node->NumLinks; j++)
+	    {
+		RouteLinkPtr link = node->Links + j;
+		int to = link->NodeTo->InternalIndex;
+		double cost = distance + link->Cost;
+		if (worker->Settled[to] == pass)
+		    continue;
+		if (worker->Reached[to] != pass
+		    || cost < worker->Distance[to])
+		  {
+		      worker->Reached[to] = pass;
+		      worker->Distance[to] = cost;
+		      matrix_heap_push (worker, to, cost);
+		  }
+	    }
+      }
+
+    for (j = 0; j < matrix->NumTo; j++)
+      {
+	  RouteNodePtr to = *(matrix->To + j);
+	  if (to == NULL)
+	      continue;
+	  if (worker->Settled[to->InternalIndex] == pass)
+	      *(costs + j) = worker->Distance[to->InternalIndex];
+      }
+}
+
+static void
+routing_matrix_worker (void *arg)
+{
+/* thread entry point: computing every RowStep-th row of the Matrix */
+    RoutingMatrixWorkerPtr worker = (RoutingMatrixWorkerPtr) arg;
+    int row;
+    for (row = worker->FirstRow; row < worker->Matrix->NumFrom;
+	 row += worker->RowStep)
+	routing_matrix_row (worker, row);
+}
+
+static void
+routing_matrix_free (RoutingMatrixPtr matrix)
+{
+/* memory cleanup - destroying a Cost Matrix */
+    if (matrix == NULL)
+	return;
+    if (matrix->IsTarget != NULL)
+	free (matrix->IsTarget);
+    if (matrix->Costs != NULL)
+	free (matrix->Costs);
+    free (matrix);
+}
+
+static RoutingMatrixPtr
+routing_matrix_solve (RoutingPtr graph, RouteNodePtr * from, int num_from,
+		      RouteNodePtr * to, int num_to)
+{
+/* computing a many-to-many Cost Matrix (Dijkstra) */
+    RoutingMatrixPtr matrix;
+    RoutingMatrixWorkerPtr workers;
+    void **args;
+    int threads;
+    int i;
+    int ok = 1;
+
+    if (graph == NULL || num_from <= 0 || num_to <= 0)
+	return NULL;
+    matrix = malloc (sizeof (RoutingMatrix));
+    matrix->Graph = graph;
+    matrix->NumFrom = num_from;
+    matrix->From = from;
+    matrix->NumTo = num_to;
+    matrix->To = to;
+    matrix->NumTargets = 0;
+    matrix->IsTarget = calloc (graph->NumNodes, sizeof (char));
+    matrix->Costs = malloc (sizeof (double) * num_from * num_to);
+    if (matrix->IsTarget == NULL || matrix->Costs == NULL)
+      {
+	  routing_matrix_free (matrix);
+	  return NULL;
+      }
+    for (i = 0; i < num_to; i++)
+      {
+	  /* marking all distinct targets */
+	  RouteNodePtr node = *(to + i);
+	  if (node == NULL)
+	      continue;
+	  if (matrix->IsTarget[node->InternalIndex])
+	      continue;
+	  matrix->IsTarget[node->InternalIndex] = 1;
+	  matrix->NumTargets += 1;
+      }
+
+/* spreading the origins between the available CPUs */
+    threads = splite_get_cpu_count ();
+    if (threads > num_from)
+	threads = num_from;
+    workers = calloc (threads, sizeof (RoutingMatrixWorker));
+    args = malloc (sizeof (void *) * threads);
+    for (i = 0; i < threads; i++)
+      {
+	  RoutingMatrixWorkerPtr worker = workers + i;
+	  worker->Matrix = matrix;
+	  worker->FirstRow = i;
+	  worker->RowStep = threads;
+	  worker->Pass = 0;
+	  worker->HeapCount = 0;
+	  worker->Distance = malloc (sizeof (double) * graph->NumNodes);
+	  worker->Reached = calloc (graph->NumNodes, sizeof (unsigned int));
+	  worker->Settled = calloc (graph->NumNodes, sizeof (unsigned int));
+	  worker->Heap =
+	      malloc (sizeof (MatrixHeapNode) * (graph->NumLinks + 2));
+	  if (worker->Distance == NULL || worker->Reached == NULL
+	      || worker->Settled == NULL || worker->Heap == NULL)
+	      ok = 0;
+	  *(args + i) = worker;
+      }
+    if (ok)
+	splite_run_threads (threads, routing_matrix_worker, args);
+    for (i = 0; i < threads; i++)
+      {
+	  RoutingMatrixWorkerPtr worker = workers + i;
+	  if (worker->Distance != NULL)
+	      free (worker->Distance);
+	  if (worker->Reached != NULL)
+	      free (worker->Reached);
+	  if (worker->Settled != NULL)
+	      free (worker->Settled);
+	  if (worker->Heap != NULL)
+	      free (worker->Heap);
+      }
+    free (workers);
+    free (args);
+    if (!ok)
+      {
+	  routing_matrix_free (matrix);
+	  return NULL;
+      }
+    return matrix;
+}
+
 static void
 delete_solution (ShortestPathSolutionPtr solution)
 {
@@ -2102,126 +2394,6 @@ dijkstra_multi_shortest_path (sqlite3 * handle, int options, RoutingPtr graph,
     routing_heap_free (heap);
 }
 
-static RouteNodePtr
-check_targets (RoutingNodePtr node, TspTargetsPtr targets)
-{
-/* testing targets */
-    int i;
-    for (i = 0; i < targets->Count; i++)
-      {
-	  RouteNodePtr to = *(targets->To + i);
-	  if (to == NULL)
-	      continue;
-	  if (*(targets->Found + i) == 'Y')
-	      continue;
-	  if (node->Id == to->InternalIndex)
-	    {
-		*(targets->Found + i) = 'Y';
-		return to;
-	    }
-      }
-    return NULL;
-}
-
-static void
-update_targets (TspTargetsPtr targets, RouteNodePtr destination, double cost,
-		int *stop)
-{
-/* tupdating targets */
-    int i;
-    *stop = 1;
-    for (i = 0; i < targets->Count; i++)
-      {
-	  RouteNodePtr to = *(targets->To + i);
-	  if (to == NULL)
-	      continue;
-	  if (to == destination)
-	      *(targets->Costs + i) = cost;
-	  if (*(targets->Found + i) == 'Y')
-	      continue;
-	  *stop = 0;
-      }
-}
-
-
-static void
-dijkstra_targets_solve (RoutingNodesPtr e, TspTargetsPtr targets)
-{
-/* Shortest Path (multiple destinations) for TSP GA */
-    int from;
-    int i;
-    RouteNodePtr destination;
-    RoutingNodePtr n;
-    RoutingNodePtr p_to;
-    RouteLinkPtr p_link;
-    RoutingHeapPtr heap;
-/* setting From */
-    from = targets->From->InternalIndex;
-/* initializing the heap */
-    heap = routing_heap_init (e->DimLink);
-/* initializing the graph */
-    for (i = 0; i < e->Dim; i++)
-      {
-	  n = e->Nodes + i;
-	  n->PreviousNode = NULL;
-	  n->xLink = NULL;
-	  n->Inspected = 0;
-	  n->Distance = DBL_MAX;
-      }
-/* queuing the From node into the heap */
-    e->Nodes[from].Distance = 0.0;
-    dijkstra_enqueue (heap, e->Nodes + from);
-    while (heap->Count > 0)
-      {
-	  /* Dijsktra loop */
-	  n = routing_dequeue (heap);
-	  destination = check_targets (n, targets);
-	  if (destination != NULL)
-	    {
-		/* reached one of the targets */
-		int stop = 0;
-		double totalCost = 0.0;
-		int to = destination->InternalIndex;
-		n = e->Nodes + to;
-		while (n->PreviousNode != NULL)
-		  {
-		      /* computing the total Cost */
-		      totalCost += n->xLink->Cost;
-		      n = n->PreviousNode;
-		  }
-		/* updating targets */
-		update_targets (targets, destination, totalCost, &stop);
-		if (stop)
-		    break;
-	    }
-	  n->Inspected = 1;
-	  for (i = 0; i < n->DimTo; i++)
-	    {
-		p_to = *(n->To + i);
-		p_link = *(n->Link + i);
-		if (p_to->Inspected == 0)
-		  {
-		      if (p_to->Distance == DBL_MAX)
-			{
-			    /* queuing a new node into the heap */
-			    p_to->Distance = n->Distance + p_link->Cost;
-			    p_to->PreviousNode = n;
-			    p_to->xLink = p_link;
-			    dijkstra_enqueue (heap, p_to);
-			}
-		      else if (p_to->Distance > n->Distance + p_link->Cost)
-			{
-			    /* updating an already inserted node */
-			    p_to->Distance = n->Distance + p_link->Cost;
-			    p_to->PreviousNode = n;
-			    p_to->xLink = p_link;
-			}
-		  }
-	    }
-      }
-    routing_heap_free (heap);
-}
-
 static void
 destroy_tsp_targets (TspTargetsPtr targets)
 {
@@ -3153,8 +3325,12 @@ delete_multiSolution (MultiSolutionPtr multiSolution)
     gaiaGeomCollPtr pGn;
     if (!multiSolution)
 	return;
+    if (multiSolution->MultiFrom != NULL)
+	vroute_delete_multiple_destinations (multiSolution->MultiFrom);
     if (multiSolution->MultiTo != NULL)
 	vroute_delete_multiple_destinations (multiSolution->MultiTo);
+    if (multiSolution->Matrix != NULL)
+	routing_matrix_free (multiSolution->Matrix);
     pS = multiSolution->First;
     while (pS != NULL)
       {
@@ -3213,8 +3389,12 @@ reset_multiSolution (MultiSolutionPtr multiSolution)
     gaiaGeomCollPtr pGn;
     if (!multiSolution)
 	return;
+    if (multiSolution->MultiFrom != NULL)
+	vroute_delete_multiple_destinations (multiSolution->MultiFrom);
     if (multiSolution->MultiTo != NULL)
 	vroute_delete_multiple_destinations (multiSolution->MultiTo);
+    if (multiSolution->Matrix != NULL)
+	routing_matrix_free (multiSolution->Matrix);
     pS = multiSolution->First;
     while (pS != NULL)
       {
@@ -3255,7 +3435,9 @@ reset_multiSolution (MultiSolutionPtr multiSolution)
 	  pG = pGn;
       }
     multiSolution->From = NULL;
+    multiSolution->MultiFrom = NULL;
     multiSolution->MultiTo = NULL;
+    multiSolution->Matrix = NULL;
     multiSolution->First = NULL;
     multiSolution->Last = NULL;
     multiSolution->FirstRow = NULL;
@@ -3277,7 +3459,9 @@ alloc_multiSolution (void)
 /* allocates and initializes the current multiple-destinations solution */
     MultiSolutionPtr p = malloc (sizeof (MultiSolution));
     p->From = NULL;
+    p->MultiFrom = NULL;
     p->MultiTo = NULL;
+    p->Matrix = NULL;
     p->First = NULL;
     p->Last = NULL;
     p->FirstRow = NULL;
@@ -4721,6 +4905,8 @@ tsp_ga_solve (sqlite3 * handle, int options, RoutingPtr graph,
     RoutingMultiDestPtr multi;
     TspTargetsPtr targets;
     TspGaDistancePtr dist;
+    RouteNodePtr *cities = NULL;
+    RoutingMatrixPtr matrix = NULL;
 
     if (multiSolution == NULL)
 	return;
@@ -4731,14 +4917,27 @@ tsp_ga_solve (sqlite3 * handle, int options, RoutingPtr graph,
 /* initialinzing the TSP GA helper struct */
     ga = build_tsp_ga_population (multi->Items + 1);
 
+/* 
+/ determining all City-to-City distances (costs) at once
+/ City #0 is From, City #i+1 is the i-th destination
+*/
+    cities = malloc (sizeof (RouteNodePtr) * (multi->Items + 1));
+    *(cities + 0) = multiSolution->From;
+    for (i = 0; i < multi->Items; i++)
+	*(cities + i + 1) = *(multi->To + i);
+    matrix =
+	routing_matrix_solve (graph, cities, multi->Items + 1, cities,
+			      multi->Items + 1);
+
     for (i = -1; i < multi->Items; i++)
       {
-	  /* determining all City-to-City distances (costs) */
+	  /* retrieving the distances (costs) from the Matrix */
+	  double *costs;
 	  targets = tsp_ga_permuted_targets (multiSolution->From, multi, i);
 	  for (j = 0; j < targets->Count; j++)
 	    {
 		/* checking for undefined targets */
-		if (*(targets->To + j) == NULL)
+		if (*(targets->To + j) == NULL || matrix == NULL)
 		  {
 		      int k;
 		      for (k = 0; k < targets->Count; k++)
@@ -4751,7 +4950,16 @@ tsp_ga_solve (sqlite3 * handle, int options, RoutingPtr graph,
 		      goto invalid;
 		  }
 	    }
-	  dijkstra_targets_solve (routing, targets);
+	  costs = matrix->Costs + ((i + 1) * matrix->NumTo);
+	  for (j = 0; j < targets->Count; j++)
+	    {
+		/* permuted targets: City #i+1 is replaced by From */
+		double cost = (j == i) ? *(costs + 0) : *(costs + j + 1);
+		if (cost == DBL_MAX)
+		    continue;
+		*(targets->Found + j) = 'Y';
+		*(targets->Costs + j) = cost;
+	    }
 	  for (j = 0; j < targets->Count; j++)
 	    {
 		/* checking for unreachable targets */
@@ -4767,6 +4975,10 @@ tsp_ga_solve (sqlite3 * handle, int options, RoutingPtr graph,
 	  *(ga->Distances + i + 1) = dist;
 	  destroy_tsp_targets (targets);
       }
+    routing_matrix_free (matrix);
+    matrix = NULL;
+    free (cities);
+    cities = NULL;
     tsp_ga_sort_distances (ga);
 
     for (i = -1; i < multi->Items; i++)
@@ -4837,6 +5049,10 @@ tsp_ga_solve (sqlite3 * handle, int options, RoutingPtr graph,
     return;
 
   invalid:
+    if (matrix != NULL)
+	routing_matrix_free (matrix);
+    if (cities != NULL)
+	free (cities);
     destroy_tsp_ga_population (ga);
 }
 
@@ -4844,20 +5060,14 @@ static void
 network_free (RoutingPtr p)
 {
 /* memory cleanup; freeing any allocation for the network struct */
-    RouteNodePtr pN;
-    int i;
     if (!p)
 	return;
-    for (i = 0; i < p->NumNodes; i++)
-      {
-	  pN = p->Nodes + i;
-	  if (pN->Code)
-	      free (pN->Code);
-	  if (pN->Links)
-	      free (pN->Links);
-      }
     if (p->Nodes)
 	free (p->Nodes);
+    if (p->LinksPool)
+	free (p->LinksPool);
+    if (p->CodesPool)
+	free (p->CodesPool);
     if (p->TableName)
 	free (p->TableName);
     if (p->FromColumn)
@@ -4868,6 +5078,10 @@ network_free (RoutingPtr p)
 	free (p->GeometryColumn);
     if (p->NameColumn)
 	free (p->NameColumn);
+    if (p->DbPath)
+	free (p->DbPath);
+    if (p->DataTable)
+	free (p->DataTable);
     free (p);
 }
 
@@ -4981,6 +5195,22 @@ network_init (const unsigned char *blob, int size)
 	  graph->Nodes[i].NumLinks = 0;
 	  graph->Nodes[i].Links = NULL;
       }
+    graph->NumLinks = 0;
+    graph->LinksPool = NULL;
+    if (node_code)
+      {
+	  /* all Codes share a single fixed-width buffer, just as in the BLOB */
+	  graph->CodesPool = malloc ((size_t) nodes * (max_code_length + 1));
+      }
+    else
+	graph->CodesPool = NULL;
+    graph->DbPath = NULL;
+    graph->DataTable = NULL;
+    graph->SchemaVersion = 0;
+    graph->NumBlocks = 0;
+    graph->DataSize = 0;
+    graph->RefCount = 1;
+    graph->Next = NULL;
     len = strlen (table);
     graph->TableName = malloc (len + 1);
     strcpy (graph->TableName, table);
@@ -5019,7 +5249,8 @@ network_init (const unsigned char *blob, int size)
 }
 
 static int
-network_block (RoutingPtr graph, const unsigned char *blob, int size)
+network_block (RoutingPtr graph, const unsigned char *blob, int size,
+	       int *link_offsets, int *max_links)
 {
 /* parsing a NETWORK Block */
     const unsigned char *in = blob;
@@ -5034,10 +5265,10 @@ network_block (RoutingPtr graph, const unsigned char *blob, int size)
     int links;
     RouteNodePtr pN;
     RouteLinkPtr pA;
-    int len;
     sqlite3_int64 linkId;
     int nodeToIdx;
     double cost;
+    RouteLinkPtr pool;
     if (size < 3)
 	goto error;
     if (*in++ != GAIA_NET_BLOCK)	/* signature */
@@ -5113,8 +5344,9 @@ network_block (RoutingPtr graph, const unsigned char *blob, int size)
 	    {
 		/* Nodes are identified by a TEXT Code */
 		pN->Id = -1;
-		len = strlen (code);
-		pN->Code = malloc (len + 1);
+		pN->Code =
+		    graph->CodesPool + ((size_t) index *
+					(graph->MaxCodeLength + 1));
 		strcpy (pN->Code, code);
 	    }
 	  else
@@ -5126,10 +5358,25 @@ network_block (RoutingPtr graph, const unsigned char *blob, int size)
 	  pN->CoordX = x;
 	  pN->CoordY = y;
 	  pN->NumLinks = links;
+	  pN->Links = NULL;
+	  link_offsets[index] = graph->NumLinks;
 	  if (links)
 	    {
 		/* parsing the Links */
-		pN->Links = malloc (sizeof (RouteLink) * links);
+		if (graph->NumLinks + links > *max_links)
+		  {
+		      /* growing the Links pool */
+		      int new_max = *max_links * 2;
+		      if (new_max < graph->NumLinks + links)
+			  new_max = graph->NumLinks + links;
+		      pool =
+			  realloc (graph->LinksPool,
+				   sizeof (RouteLink) * new_max);
+		      if (pool == NULL)
+			  goto error;
+		      graph->LinksPool = pool;
+		      *max_links = new_max;
+		  }
 		for (ia = 0; ia < links; ia++)
 		  {
 		      /* parsing each Link */
@@ -5161,7 +5408,7 @@ network_block (RoutingPtr graph, const unsigned char *blob, int size)
 		      in += 8;
 		      if (*in++ != GAIA_NET_END)	/* signature */
 			  goto error;
-		      pA = pN->Links + ia;
+		      pA = graph->LinksPool + graph->NumLinks + ia;
 		      /* initializing the Link */
 		      if (nodeToIdx < 0 || nodeToIdx >= graph->NumNodes)
 			  goto error;
@@ -5170,9 +5417,8 @@ network_block (RoutingPtr graph, const unsigned char *blob, int size)
 		      pA->LinkRowid = linkId;
 		      pA->Cost = cost;
 		  }
+		graph->NumLinks += links;
 	    }
-	  else
-	      pN->Links = NULL;
 	  if ((size - (in - blob)) < 1)
 	      goto error;
 	  if (*in++ != GAIA_NET_END)	/* signature */
@@ -5186,6 +5432,22 @@ network_block (RoutingPtr graph, const unsigned char *blob, int size)
     return 0;
 }
 
+static void
+network_set_links (RoutingPtr graph, const int *link_offsets)
+{
+/* pointing each Node to its own slice of the Links pool */
+    int i;
+    RouteNodePtr pN;
+    for (i = 0; i < graph->NumNodes; i++)
+      {
+	  pN = graph->Nodes + i;
+	  if (pN->NumLinks > 0)
+	      pN->Links = graph->LinksPool + link_offsets[i];
+	  else
+	      pN->Links = NULL;
+      }
+}
+
 static RoutingPtr
 load_network (sqlite3 * handle, const char *table)
 {
@@ -5198,6 +5460,9 @@ load_network (sqlite3 * handle, const char *table)
     const unsigned char *blob;
     int size;
     char *xname;
+    int *link_offsets = NULL;
+    int max_links = 0;
+    RouteLinkPtr pool;
     xname = gaiaDoubleQuotedSql (table);
     sql = sqlite3_mprintf ("SELECT NetworkData FROM \"%s\" ORDER BY Id", xname);
     free (xname);
@@ -5222,6 +5487,15 @@ load_network (sqlite3 * handle, const char *table)
 			    /* parsing the HEADER block */
 			    graph = network_init (blob, size);
 			    header = 0;
+			    if (graph != NULL)
+			      {
+				  /* road networks usually have about 3 Links per Node */
+				  link_offsets =
+				      malloc (sizeof (int) * graph->NumNodes);
+				  max_links = graph->NumNodes * 3;
+				  graph->LinksPool =
+				      malloc (sizeof (RouteLink) * max_links);
+			      }
 			}
 		      else
 			{
@@ -5231,7 +5505,8 @@ load_network (sqlite3 * handle, const char *table)
 				  sqlite3_finalize (stmt);
 				  goto abort;
 			      }
-			    if (!network_block (graph, blob, size))
+			    if (!network_block
+				(graph, blob, size, link_offsets, &max_links))
 			      {
 				  sqlite3_finalize (stmt);
 				  goto abort;
@@ -5251,13 +5526,243 @@ load_network (sqlite3 * handle, const char *table)
 	    }
       }
     sqlite3_finalize (stmt);
+    if (graph == NULL)
+	goto abort;
+    if (graph->NumLinks < max_links)
+      {
+	  /* trimming the Links pool to its actual size */
+	  if (graph->NumLinks == 0)
+	    {
+		free (graph->LinksPool);
+		graph->LinksPool = NULL;
+	    }
+	  else
+	    {
+		pool =
+		    realloc (graph->LinksPool,
+			     sizeof (RouteLink) * graph->NumLinks);
+		if (pool != NULL)
+		    graph->LinksPool = pool;
+	    }
+      }
+    network_set_links (graph, link_offsets);
+    free (link_offsets);
     find_srid (handle, graph);
     return graph;
   abort:
+    if (link_offsets != NULL)
+	free (link_offsets);
     network_free (graph);
     return NULL;
 }
 
+/*
+/ the decoded NETWORK is strictly read-only, so all connections to the
+/ same DB-file can safely share a single copy of it.
+/ a shared NETWORK is identified by the DB-file path and by the name of
+/ the NETWORK-DATA table; the current Schema Version, the number of
+/ NetworkData Blocks and their total size are checked so to detect any
+/ NETWORK being rebuilt in the meanwhile.
+*/
+static RoutingPtr shared_networks = NULL;
+
+static int
+network_fingerprint (sqlite3 * handle, const char *table,
+		     sqlite3_int64 * schema_version, sqlite3_int64 * blocks,
+		     sqlite3_int64 * data_size)
+{
+/* checking the current state of some NETWORK-DATA table */
+    sqlite3_stmt *stmt;
+    char *sql;
+    char *xname;
+    int ret;
+    int ok = 0;
+
+    ret =
+	sqlite3_prepare_v2 (handle, "PRAGMA main.schema_version", -1, &stmt,
+			    NULL);
+    if (ret != SQLITE_OK)
+	return 0;
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	    {
+		*schema_version = sqlite3_column_int64 (stmt, 0);
+		ok = 1;
+	    }
+	  else
+	    {
+		ok = 0;
+		break;
+	    }
+      }
+    sqlite3_finalize (stmt);
+    if (!ok)
+	return 0;
+
+/* Length() on BLOBs doesn't require loading the whole payload */
+    ok = 0;
+    xname = gaiaDoubleQuotedSql (table);
+    sql =
+	sqlite3_mprintf
+	("SELECT Count(*), Sum(Length(NetworkData)) FROM main.\"%s\"", xname);
+    free (xname);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return 0;
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	    {
+		*blocks = sqlite3_column_int64 (stmt, 0);
+		*data_size = sqlite3_column_int64 (stmt, 1);
+		ok = 1;
+	    }
+	  else
+	    {
+		ok = 0;
+		break;
+	    }
+      }
+    sqlite3_finalize (stmt);
+    return ok;
+}
+
+static RoutingPtr
+find_shared_network (const char *db_path, const char *table,
+		     sqlite3_int64 schema_version, sqlite3_int64 blocks,
+		     sqlite3_int64 data_size)
+{
+/* searching a shared NETWORK - the caller is expected to hold the lock */
+    RoutingPtr graph = shared_networks;
+    while (graph != NULL)
+      {
+	  if (strcmp (graph->DbPath, db_path) == 0
+	      && strcasecmp (graph->DataTable, table) == 0
+	      && graph->SchemaVersion == schema_version
+	      && graph->NumBlocks == blocks && graph->DataSize == data_size)
+	      return graph;
+	  graph = graph->Next;
+      }
+    return NULL;
+}
+
+static RoutingPtr
+acquire_network (sqlite3 * handle, const char *table)
+{
+/* returns a (possibly shared) NETWORK struct */
+    RoutingPtr graph;
+    RoutingPtr shared;
+    const char *db_path;
+    sqlite3_int64 schema_version;
+    sqlite3_int64 blocks;
+    sqlite3_int64 data_size;
+    int len;
+
+    db_path = sqlite3_db_filename (handle, "main");
+    if (db_path == NULL || *db_path == '\0')
+      {
+	  /* MEMORY or TEMPORARY DB: sharing is not possible */
+	  return load_network (handle, table);
+      }
+    if (!network_fingerprint
+	(handle, table, &schema_version, &blocks, &data_size))
+	return load_network (handle, table);
+
+    splite_cache_semaphore_lock ();
+    graph =
+	find_shared_network (db_path, table, schema_version, blocks,
+			     data_size);
+    if (graph != NULL)
+	graph->RefCount += 1;
+    splite_cache_semaphore_unlock ();
+    if (graph != NULL)
+	return graph;
+
+/* not yet loaded; decoding the NETWORK without holding the lock */
+    graph = load_network (handle, table);
+    if (graph == NULL)
+	return NULL;
+    len = strlen (db_path);
+    graph->DbPath = malloc (len + 1);
+    strcpy (graph->DbPath, db_path);
+    len = strlen (table);
+    graph->DataTable = malloc (len + 1);
+    strcpy (graph->DataTable, table);
+    graph->SchemaVersion = schema_version;
+    graph->NumBlocks = blocks;
+    graph->DataSize = data_size;
+
+    splite_cache_semaphore_lock ();
+    shared =
+	find_shared_network (db_path, table, schema_version, blocks,
+			     data_size);
+    if (shared != NULL)
+      {
+	  /* some other connection was faster than us */
+	  shared->RefCount += 1;
+      }
+    else
+      {
+	  graph->Next = shared_networks;
+	  shared_networks = graph;
+      }
+    splite_cache_semaphore_unlock ();
+    if (shared != NULL)
+      {
+	  network_free (graph);
+	  return shared;
+      }
+    return graph;
+}
+
+static void
+release_network (RoutingPtr graph)
+{
+/* releasing a (possibly shared) NETWORK struct */
+    RoutingPtr prev = NULL;
+    RoutingPtr p;
+    int unused = 0;
+    if (graph == NULL)
+	return;
+    if (graph->DbPath == NULL)
+      {
+	  /* not shared */
+	  network_free (graph);
+	  return;
+      }
+    splite_cache_semaphore_lock ();
+    graph->RefCount -= 1;
+    if (graph->RefCount <= 0)
+      {
+	  p = shared_networks;
+	  while (p != NULL)
+	    {
+		if (p == graph)
+		  {
+		      if (prev == NULL)
+			  shared_networks = p->Next;
+		      else
+			  prev->Next = p->Next;
+		      break;
+		  }
+		prev = p;
+		p = p->Next;
+	    }
+	  unused = 1;
+      }
+    splite_cache_semaphore_unlock ();
+    if (unused)
+	network_free (graph);
+}
+
 static void
 set_multi_by_id (RoutingMultiDestPtr multiple, RoutingPtr graph)
 {
@@ -7197,7 +7702,7 @@ vroute_create (sqlite3 * db, void *pAux, int argc, const char *const *argv,
     p_vt = (virtualroutingPtr) sqlite3_malloc (sizeof (virtualrouting));
     if (!p_vt)
 	return SQLITE_NOMEM;
-    graph = load_network (db, table);
+    graph = acquire_network (db, table);
     if (!graph)
       {
 	  /* something is going the wrong way */
@@ -7426,7 +7931,7 @@ vroute_disconnect (sqlite3_vtab * pVTab)
     if (p_vt->routing)
 	routing_free (p_vt->routing);
     if (p_vt->graph)
-	network_free (p_vt->graph);
+	release_network (p_vt->graph);
     sqlite3_free (p_vt);
     return SQLITE_OK;
 }
@@ -7442,7 +7947,17 @@ static void
 vroute_read_row (virtualroutingCursorPtr cursor)
 {
 /* trying to read a "row" from Shortest Path solution */
-    if (cursor->pVtab->multiSolution->Mode == VROUTE_RANGE_SOLUTION)
+    if (cursor->pVtab->multiSolution->Mode == VROUTE_MATRIX_SOLUTION)
+      {
+	  RoutingMatrixPtr matrix = cursor->pVtab->multiSolution->Matrix;
+	  if (matrix == NULL
+	      || cursor->pVtab->multiSolution->CurrentRowId >=
+	      (sqlite3_int64) matrix->NumFrom * matrix->NumTo)
+	      cursor->pVtab->eof = 1;
+	  else
+	      cursor->pVtab->eof = 0;
+      }
+    else if (cursor->pVtab->multiSolution->Mode == VROUTE_RANGE_SOLUTION)
       {
 	  if (cursor->pVtab->multiSolution->CurrentNodeRow == NULL)
 	      cursor->pVtab->eof = 1;
@@ -7498,6 +8013,43 @@ vroute_close (sqlite3_vtab_cursor * pCursor)
     return SQLITE_OK;
 }
 
+static RoutingMultiDestPtr
+vroute_get_matrix_origins (virtualroutingPtr net, sqlite3_value * value)
+{
+/* parsing the NodeFrom list of a Matrix request */
+    RoutingMultiDestPtr multiple = NULL;
+    if (net->graph->NodeCode)
+      {
+	  /* Nodes are identified by TEXT Codes */
+	  if (sqlite3_value_type (value) == SQLITE_TEXT)
+	    {
+		multiple =
+		    vroute_get_multiple_destinations (1, net->currentDelimiter,
+						      (const char *)
+						      sqlite3_value_text
+						      (value));
+		if (multiple != NULL)
+		    set_multi_by_code (multiple, net->graph);
+	    }
+      }
+    else
+      {
+	  /* Nodes are identified by INT Ids */
+	  if (sqlite3_value_type (value) == SQLITE_TEXT)
+	      multiple =
+		  vroute_get_multiple_destinations (0, net->currentDelimiter,
+						    (const char *)
+						    sqlite3_value_text (value));
+	  else if (sqlite3_value_type (value) == SQLITE_INTEGER)
+	      multiple =
+		  vroute_as_multiple_destinations (sqlite3_value_int64
+						   (value));
+	  if (multiple != NULL)
+	      set_multi_by_id (multiple, net->graph);
+      }
+    return multiple;
+}
+
 static int
 vroute_filter (sqlite3_vtab_cursor * pCursor, int idxNum, const char *idxStr,
 	       int argc, sqlite3_value ** argv)
@@ -7645,6 +8197,13 @@ vroute_filter (sqlite3_vtab_cursor * pCursor, int idxNum, const char *idxStr,
 					 sqlite3_value_int (argv[1]));
 	    }
       }
+    if ((idxNum == 1 || idxNum == 2) && argc == 2
+	&& net->currentRequest == VROUTE_MATRIX)
+      {
+	  /* Matrix request: NodeFrom could list many origins as well */
+	  multiSolution->MultiFrom =
+	      vroute_get_matrix_origins (net, argv[(idxNum == 1) ? 0 : 1]);
+      }
     if (idxNum == 3 && argc == 2)
       {
 	  /* retrieving the From and Cost param */
@@ -7856,6 +8415,19 @@ vroute_filter (sqlite3_vtab_cursor * pCursor, int idxNum, const char *idxStr,
 	  cursor->pVtab->eof = 0;
 	  return SQLITE_OK;
       }
+    if (multiSolution->MultiFrom && multiSolution->MultiTo)
+      {
+	  multiSolution->Mode = VROUTE_MATRIX_SOLUTION;
+	  /* always defaulting to Dijkstra's Shortest Path */
+	  multiSolution->Matrix =
+	      routing_matrix_solve (net->graph, multiSolution->MultiFrom->To,
+				    multiSolution->MultiFrom->Items,
+				    multiSolution->MultiTo->To,
+				    multiSolution->MultiTo->Items);
+	  multiSolution->CurrentRowId = 0;
+	  vroute_read_row (cursor);
+	  return SQLITE_OK;
+      }
     if (multiSolution->From && multiSolution->MultiTo)
       {
 	  cursor->pVtab->eof = 0;
@@ -7908,7 +8480,6 @@ vroute_filter (sqlite3_vtab_cursor * pCursor, int idxNum, const char *idxStr,
       }
     if (multiSolution->From && multiSolution->MaxCost > 0.0)
       {
-	  find_srid (net->db, net->graph);
 	  cursor->pVtab->eof = 0;
 	  multiSolution->Mode = VROUTE_RANGE_SOLUTION;
 	  /* always defaulting to Dijkstra's Shortest Path */
@@ -7952,7 +8523,9 @@ vroute_next (sqlite3_vtab_cursor * pCursor)
 		return SQLITE_OK;
 	    }
       }
-    if (multiSolution->Mode == VROUTE_RANGE_SOLUTION)
+    if (multiSolution->Mode == VROUTE_MATRIX_SOLUTION)
+	;			/* Matrix rows are simply numbered */
+    else if (multiSolution->Mode == VROUTE_RANGE_SOLUTION)
       {
 	  if (multiSolution->CurrentNodeRow == NULL)
 	    {
@@ -7993,6 +8566,175 @@ vroute_eof (sqlite3_vtab_cursor * pCursor)
     return cursor->pVtab->eof;
 }
 
+static void
+do_matrix_node_column (sqlite3_context * pContext, int node_code,
+		       RoutingMultiDestPtr multiple, int index)
+{
+/* returning a Matrix NodeFrom or NodeTo value */
+    RouteNodePtr node = *(multiple->To + index);
+    if (node != NULL)
+      {
+	  if (node_code)
+	      sqlite3_result_text (pContext, node->Code, strlen (node->Code),
+				   SQLITE_STATIC);
+	  else
+	      sqlite3_result_int64 (pContext, node->Id);
+      }
+    else
+      {
+	  /* undefined Node: echoing back the requested value */
+	  if (multiple->CodeNode)
+	    {
+		const char *code = *(multiple->Codes + index);
+		if (code == NULL)
+		    sqlite3_result_null (pContext);
+		else
+		    sqlite3_result_text (pContext, code, strlen (code),
+					 SQLITE_STATIC);
+	    }
+	  else
+	      sqlite3_result_int64 (pContext, *(multiple->Ids + index));
+      }
+}
+
+static void
+do_matrix_column (virtualroutingCursorPtr cursor, sqlite3_context * pContext,
+		  int node_code, int column)
+{
+/* processing a many-to-many Cost Matrix row */
+    const char *algorithm;
+    char delimiter[128];
+    const char *role;
+    MultiSolutionPtr multiSolution = cursor->pVtab->multiSolution;
+    RoutingMatrixPtr matrix = multiSolution->Matrix;
+    sqlite3_int64 rowid = multiSolution->CurrentRowId;
+    int from = (int) (rowid / matrix->NumTo);
+    int to = (int) (rowid % matrix->NumTo);
+    double cost = *(matrix->Costs + rowid);
+
+    if (column == 0)
+      {
+	  /* the currently used Algorithm */
+	  algorithm = "Dijkstra";
+	  if (rowid != 0)
+	      sqlite3_result_null (pContext);
+	  else
+	      sqlite3_result_text (pContext, algorithm, strlen (algorithm),
+				   SQLITE_TRANSIENT);
+      }
+    if (column == 1)
+      {
+	  /* the current Request type */
+	  algorithm = "Matrix";
+	  if (rowid != 0)
+	      sqlite3_result_null (pContext);
+	  else
+	      sqlite3_result_text (pContext, algorithm, strlen (algorithm),
+				   SQLITE_TRANSIENT);
+      }
+    if (column == 2)
+      {
+	  /* the currently set Options */
+	  algorithm = "Simple";
+	  if (rowid != 0)
+	      sqlite3_result_null (pContext);
+	  else
+	      sqlite3_result_text (pContext, algorithm, strlen (algorithm),
+				   SQLITE_TRANSIENT);
+      }
+    if (column == 3)
+      {
+	  /* the currently set delimiter char */
+	  if (isprint (cursor->pVtab->currentDelimiter))
+	      sprintf (delimiter, "%c [dec=%d, hex=%02x]",
+		       cursor->pVtab->currentDelimiter,
+		       cursor->pVtab->currentDelimiter,
+		       cursor->pVtab->currentDelimiter);
+	  else
+	      sprintf (delimiter, "[dec=%d, hex=%02x]",
+		       cursor->pVtab->currentDelimiter,
+		       cursor->pVtab->currentDelimiter);
+	  if (rowid != 0)
+	      sqlite3_result_null (pContext);
+	  else
+	      sqlite3_result_text (pContext, delimiter, strlen (delimiter),
+				   SQLITE_TRANSIENT);
+      }
+    if (column == 4)
+      {
+	  /* the RouteNum column: NodeFrom position */
+	  sqlite3_result_int (pContext, from);
+      }
+    if (column == 5)
+      {
+	  /* the RouteRow column: NodeTo position */
+	  sqlite3_result_int (pContext, to);
+      }
+    if (column == 6)
+      {
+	  /* role of this row */
+	  if (*(matrix->From + from) == NULL)
+	      role = "Undefined NodeFrom";
+	  else if (*(matrix->To + to) == NULL)
+	      role = "Undefined NodeTo";
+	  else if (cost == DBL_MAX)
+	      role = "Unreachable NodeTo";
+	  else
+	      role = "Matrix";
+	  sqlite3_result_text (pContext, role, strlen (role), SQLITE_TRANSIENT);
+      }
+    if (column == 7)
+      {
+	  /* the LinkRowId column */
+	  sqlite3_result_null (pContext);
+      }
+    if (column == 8)
+      {
+	  /* the NodeFrom column */
+	  do_matrix_node_column (pContext, node_code, multiSolution->MultiFrom,
+				 from);
+      }
+    if (column == 9)
+      {
+	  /* the NodeTo column */
+	  do_matrix_node_column (pContext, node_code, multiSolution->MultiTo,
+				 to);
+      }
+    if (column == 10)
+      {
+	  /* the PointFrom column */
+	  sqlite3_result_null (pContext);
+      }
+    if (column == 11)
+      {
+	  /* the PointTo column */
+	  sqlite3_result_null (pContext);
+      }
+    if (column == 12)
+      {
+	  /* the Tolerance column */
+	  sqlite3_result_null (pContext);
+      }
+    if (column == 13)
+      {
+	  /* the Cost column */
+	  if (cost == DBL_MAX)
+	      sqlite3_result_null (pContext);
+	  else
+	      sqlite3_result_double (pContext, cost);
+      }
+    if (column == 14)
+      {
+	  /* the Geometry column */
+	  sqlite3_result_null (pContext);
+      }
+    if (column == 15)
+      {
+	  /* the [optional] Name column */
+	  sqlite3_result_null (pContext);
+      }
+}
+
 static void
 do_cost_range_column (virtualroutingCursorPtr cursor,
 		      sqlite3_context * pContext, int node_code,
@@ -8188,6 +8930,8 @@ do_common_column (virtualroutingCursorPtr cursor, virtualroutingPtr net,
 		    algorithm = "TSP NN";
 		else if (net->currentRequest == VROUTE_TSP_GA)
 		    algorithm = "TSP GA";
+		else if (net->currentRequest == VROUTE_MATRIX)
+		    algorithm = "Matrix";
 		else
 		    algorithm = "Shortest Path";
 		if (row != first)
@@ -8266,6 +9010,8 @@ do_common_column (virtualroutingCursorPtr cursor, virtualroutingPtr net,
 		    algorithm = "TSP NN";
 		else if (net->currentRequest == VROUTE_TSP_GA)
 		    algorithm = "TSP GA";
+		else if (net->currentRequest == VROUTE_MATRIX)
+		    algorithm = "Matrix";
 		else
 		    algorithm = "Shortest Path";
 		if (row != first)
@@ -8429,6 +9175,8 @@ do_common_column (virtualroutingCursorPtr cursor, virtualroutingPtr net,
 		    algorithm = "TSP NN";
 		else if (net->currentRequest == VROUTE_TSP_GA)
 		    algorithm = "TSP GA";
+		else if (net->currentRequest == VROUTE_MATRIX)
+		    algorithm = "Matrix";
 		else
 		    algorithm = "Shortest Path";
 		if (row != first)
@@ -9025,6 +9773,12 @@ vroute_column (sqlite3_vtab_cursor * pCursor, sqlite3_context * pContext,
     virtualroutingCursorPtr cursor = (virtualroutingCursorPtr) pCursor;
     virtualroutingPtr net = (virtualroutingPtr) cursor->pVtab;
     node_code = net->graph->NodeCode;
+    if (cursor->pVtab->multiSolution->Mode == VROUTE_MATRIX_SOLUTION)
+      {
+	  /* processing a many-to-many Cost Matrix */
+	  do_matrix_column (cursor, pContext, node_code, column);
+	  return SQLITE_OK;
+      }
     if (cursor->pVtab->multiSolution->Mode == VROUTE_RANGE_SOLUTION)
       {
 	  /* processing "within Cost range" solution */
@@ -9114,6 +9868,9 @@ vroute_update (sqlite3_vtab * pVTab, int argc, sqlite3_value ** argv,
 			    else if (strcasecmp ((char *) request, "TSP GA") ==
 				     0)
 				p_vtab->currentRequest = VROUTE_TSP_GA;
+			    else if (strcasecmp ((char *) request, "MATRIX") ==
+				     0)
+				p_vtab->currentRequest = VROUTE_MATRIX;
 			    else if (strcasecmp
 				     ((char *) request, "SHORTEST PATH") == 0)
 				p_vtab->currentRequest = VROUTE_SHORTEST_PATH;
@@ -2267,6 +2267,7 @@ gaiaTopologyFromDBMS (sqlite3 * handle, const void *p_cache,
     ptr->tolerance = 0;
     ptr->has_z = 0;
     ptr->last_error_message = NULL;
+    ptr->working_set = gaiatopo_create_working_set ();
     ptr->rtt_iface = rtt_CreateBackendIface (ctx, (const RTT_BE_DATA *) ptr);
     ptr->prev = cache->lastTopology;
     ptr->next = NULL;
@@ -2379,6 +2380,7 @@ gaiaTopologyDestroy (GaiaTopologyAccessorPtr topo_ptr)
 	free (ptr->last_error_message);
 
     finalize_topogeo_prepared_stmts (topo_ptr);
+    gaiatopo_free_working_set (ptr->working_set);
     free (ptr);
 
 /* unregistering from the Internal Cache double linked list */
@@ -2454,6 +2456,7 @@ finalize_topogeo_prepared_stmts (GaiaTopologyAccessorPtr accessor)
     ptr->stmt_deleteFacesById = NULL;
     ptr->stmt_deleteNodesById = NULL;
     ptr->stmt_getRingEdges = NULL;
+    gaiatopo_reset_working_set (accessor);
 }
 
 TOPOLOGY_PRIVATE void
@@ -2960,6 +2963,8 @@ do_check_mod_split_edge3d (struct gaia_topology *topo, gaiaPointPtr pt,
 
   fixme:
     sqlite3_finalize (stmt);
+/* the Edges are about to be directly updated */
+    gaiatopo_flush_working_set ((GaiaTopologyAccessorPtr) topo);
     table = sqlite3_mprintf ("%s_edge", topo->topology_name);
     xtable = gaiaDoubleQuotedSql (table);
     sql =
@@ -3113,6 +3118,8 @@ do_check_mod_split_edge (struct gaia_topology *topo, gaiaPointPtr pt,
 
   fixme:
     sqlite3_finalize (stmt);
+/* the Edges are about to be directly updated */
+    gaiatopo_flush_working_set ((GaiaTopologyAccessorPtr) topo);
     table = sqlite3_mprintf ("%s_edge", topo->topology_name);
     xtable = gaiaDoubleQuotedSql (table);
     sql =
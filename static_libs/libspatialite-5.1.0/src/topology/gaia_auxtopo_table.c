@@ -213,6 +213,871 @@ gaiaTopoGeo_FromGeoTable (GaiaTopologyAccessorPtr accessor,
     return 0;
 }
 
+/*
+/ TopoGeo_FromGeoTable - tiled mode
+/
+/ the input extent is partitioned into a grid of Tiles; any feature
+/ whose MBR (expanded by the snapping tolerance) falls strictly within
+/ a single Tile cannot interact with features belonging to other Tiles,
+/ so each Tile is imported into a private Topology (stored on its own
+/ temporary MemoryDB) by some worker thread
+/ all Tile Topologies are then copied into the target Topology (simply
+/ renumbering Nodes, Edges and Faces), and finally all features crossing
+/ the Tile borders are imported in the usual way, so to heal the
+/ Topology along the Tile borders
+*/
+
+struct topo_tile_feature
+{
+/* a struct wrapping an input feature of the tiled import */
+    gaiaGeomCollPtr geom;
+    struct topo_tile_feature *next;
+};
+
+struct topo_tile
+{
+/* a struct wrapping a Tile of the tiled import */
+    struct topo_tile_feature *first;
+    struct topo_tile_feature *last;
+    gaiaGeomCollPtr *crossing;
+    int n_crossing;
+    int max_crossing;
+    sqlite3 *handle;
+    void *cache;
+    GaiaTopologyAccessorPtr accessor;
+    char *error_message;
+};
+
+struct topo_tiles_worker
+{
+/* a struct wrapping a worker thread of the tiled import */
+    struct topo_tile **tiles;
+    int n_tiles;
+    int first;
+    int step;
+    int has_z;
+    double topo_tolerance;
+    double tolerance;
+    int line_max_points;
+    double max_length;
+};
+
+static void
+add_tile_feature (struct topo_tile *tile, gaiaGeomCollPtr geom)
+{
+/* appending a feature to some Tile */
+    struct topo_tile_feature *ft = malloc (sizeof (struct topo_tile_feature));
+    ft->geom = geom;
+    ft->next = NULL;
+    if (tile->first == NULL)
+	tile->first = ft;
+    if (tile->last != NULL)
+	tile->last->next = ft;
+    tile->last = ft;
+}
+
+static void
+free_tile_features (struct topo_tile *tile)
+{
+/* freeing all features of some Tile */
+    struct topo_tile_feature *ft;
+    struct topo_tile_feature *ft_n;
+    ft = tile->first;
+    while (ft != NULL)
+      {
+	  ft_n = ft->next;
+	  gaiaFreeGeomColl (ft->geom);
+	  free (ft);
+	  ft = ft_n;
+      }
+    tile->first = NULL;
+    tile->last = NULL;
+    if (tile->crossing != NULL)
+	free (tile->crossing);
+    tile->crossing = NULL;
+    tile->n_crossing = 0;
+    tile->max_crossing = 0;
+}
+
+static void
+add_tile_crossing (struct topo_tile *tile, gaiaGeomCollPtr geom)
+{
+/* registering a border feature crossing some Tile */
+    if (tile->n_crossing == tile->max_crossing)
+      {
+	  tile->max_crossing += 256;
+	  tile->crossing =
+	      realloc (tile->crossing,
+		       sizeof (gaiaGeomCollPtr) * tile->max_crossing);
+      }
+    *(tile->crossing + tile->n_crossing) = geom;
+    tile->n_crossing += 1;
+}
+
+static int
+check_tile_crossing (struct topo_tile *tile, gaiaGeomCollPtr geom,
+		     double margin)
+{
+/* checking if some feature could interact with a border feature */
+    int i;
+    for (i = 0; i < tile->n_crossing; i++)
+      {
+	  gaiaGeomCollPtr border = *(tile->crossing + i);
+	  if (geom->MinX - margin > border->MaxX + margin)
+	      continue;
+	  if (geom->MaxX + margin < border->MinX - margin)
+	      continue;
+	  if (geom->MinY - margin > border->MaxY + margin)
+	      continue;
+	  if (geom->MaxY + margin < border->MinY - margin)
+	      continue;
+	  return 1;
+      }
+    return 0;
+}
+
+static void
+close_tile (struct topo_tile *tile)
+{
+/* releasing the private Topology of some Tile */
+    if (tile->accessor != NULL)
+	gaiaTopologyDestroy (tile->accessor);
+    tile->accessor = NULL;
+    if (tile->handle != NULL)
+	sqlite3_close (tile->handle);
+    tile->handle = NULL;
+    if (tile->cache != NULL)
+	spatialite_internal_cleanup (tile->cache);
+    tile->cache = NULL;
+}
+
+static void
+do_build_tile (struct topo_tiles_worker *worker, struct topo_tile *tile)
+{
+/* building the private Topology of some Tile */
+    int ret;
+    char *err_msg = NULL;
+    struct topo_tile_feature *ft;
+
+/* creating a Temporary MemoryDB */
+    ret =
+	sqlite3_open_v2 (":memory:", &(tile->handle),
+			 SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL);
+    if (ret != SQLITE_OK)
+      {
+	  tile->error_message =
+	      sqlite3_mprintf ("TopoGeo_FromGeoTableTiled: %s",
+			       sqlite3_errmsg (tile->handle));
+	  return;
+      }
+    tile->cache = spatialite_alloc_connection ();
+    spatialite_internal_init (tile->handle, tile->cache);
+
+/* initializing a minimal SpatiaLite DB */
+    ret =
+	sqlite3_exec (tile->handle, "SELECT InitSpatialMetadata(1, 'NONE')",
+		      NULL, NULL, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  tile->error_message =
+	      sqlite3_mprintf ("TopoGeo_FromGeoTableTiled: %s", err_msg);
+	  sqlite3_free (err_msg);
+	  return;
+      }
+
+/* creating the private Topology */
+    if (!gaiaTopologyCreate
+	(tile->handle, "tile", 0, worker->topo_tolerance, worker->has_z))
+      {
+	  tile->error_message =
+	      sqlite3_mprintf
+	      ("TopoGeo_FromGeoTableTiled: unable to create a Tile Topology");
+	  return;
+      }
+    tile->accessor = gaiaTopologyFromDBMS (tile->handle, tile->cache, "tile");
+    if (tile->accessor == NULL)
+      {
+	  tile->error_message =
+	      sqlite3_mprintf
+	      ("TopoGeo_FromGeoTableTiled: unable to access a Tile Topology");
+	  return;
+      }
+
+/* importing all Tile features */
+    start_topo_savepoint (tile->handle, tile->cache);
+    ft = tile->first;
+    while (ft != NULL)
+      {
+	  if (!auxtopo_insert_into_topology
+	      (tile->accessor, ft->geom, worker->tolerance,
+	       worker->line_max_points, worker->max_length,
+	       GAIA_MODE_TOPO_FACE, NULL))
+	    {
+		const char *msg = gaiaGetRtTopoErrorMsg (tile->cache);
+		if (msg == NULL)
+		    msg = "unable to import a feature";
+		tile->error_message =
+		    sqlite3_mprintf ("TopoGeo_FromGeoTableTiled: %s", msg);
+		rollback_topo_savepoint (tile->handle, tile->cache);
+		return;
+	    }
+	  ft = ft->next;
+      }
+    release_topo_savepoint (tile->handle, tile->cache);
+}
+
+static void
+tiles_worker (void *arg)
+{
+/* a worker thread building Tile Topologies */
+    struct topo_tiles_worker *worker = (struct topo_tiles_worker *) arg;
+    int i;
+    for (i = worker->first; i < worker->n_tiles; i += worker->step)
+	do_build_tile (worker, *(worker->tiles + i));
+}
+
+static sqlite3_int64
+tile_shift_id (sqlite3_int64 id, sqlite3_int64 offset)
+{
+/* renumbering some ID (0 stands for the Universe Face) */
+    if (id > 0)
+	return id + offset;
+    if (id < 0)
+	return id - offset;
+    return 0;
+}
+
+static int
+tile_copy_geometry (sqlite3_stmt * stmt_in, int icol, sqlite3_stmt * stmt_out,
+		    int ocol, int srid, int gpkg_mode, int tiny_point)
+{
+/* copying a Tile Geometry (setting the target SRID) */
+    const unsigned char *blob;
+    int blob_sz;
+    unsigned char *p_blob;
+    int n_bytes;
+    gaiaGeomCollPtr geom;
+    if (sqlite3_column_type (stmt_in, icol) != SQLITE_BLOB)
+      {
+	  sqlite3_bind_null (stmt_out, ocol);
+	  return 1;
+      }
+    blob = sqlite3_column_blob (stmt_in, icol);
+    blob_sz = sqlite3_column_bytes (stmt_in, icol);
+    geom = gaiaFromSpatiaLiteBlobWkb (blob, blob_sz);
+    if (geom == NULL)
+	return 0;
+    geom->Srid = srid;
+    gaiaToSpatiaLiteBlobWkbEx2 (geom, &p_blob, &n_bytes, gpkg_mode,
+				tiny_point);
+    gaiaFreeGeomColl (geom);
+    sqlite3_bind_blob (stmt_out, ocol, p_blob, n_bytes, free);
+    return 1;
+}
+
+static int
+do_merge_tile (struct gaia_topology *topo, struct topo_tile *tile,
+	       sqlite3_stmt * stmt_face, sqlite3_stmt * stmt_node,
+	       sqlite3_stmt * stmt_edge, sqlite3_int64 * face_offset,
+	       sqlite3_int64 * node_offset, sqlite3_int64 * edge_offset)
+{
+/* copying a Tile Topology into the target Topology */
+    sqlite3_stmt *stmt = NULL;
+    int ret;
+    const char *sql;
+    char *msg;
+    sqlite3_int64 max_face = 0;
+    sqlite3_int64 max_node = 0;
+    sqlite3_int64 max_edge = 0;
+    int gpkg_mode = 0;
+    int tiny_point = 0;
+    struct splite_internal_cache *cache =
+	(struct splite_internal_cache *) (topo->cache);
+    if (cache != NULL)
+      {
+	  gpkg_mode = cache->gpkg_mode;
+	  tiny_point = cache->tinyPointEnabled;
+      }
+
+/* copying all Faces */
+    sql = "SELECT face_id, mbr FROM MAIN.\"tile_face\" WHERE face_id > 0";
+    ret = sqlite3_prepare_v2 (tile->handle, sql, strlen (sql), &stmt, NULL);
+    if (ret != SQLITE_OK)
+	goto tile_error;
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret != SQLITE_ROW)
+	      goto tile_error;
+	  sqlite3_reset (stmt_face);
+	  sqlite3_clear_bindings (stmt_face);
+	  if (sqlite3_column_int64 (stmt, 0) > max_face)
+	      max_face = sqlite3_column_int64 (stmt, 0);
+	  sqlite3_bind_int64 (stmt_face, 1,
+			      sqlite3_column_int64 (stmt, 0) + *face_offset);
+	  if (!tile_copy_geometry
+	      (stmt, 1, stmt_face, 2, topo->srid, gpkg_mode, tiny_point))
+	      goto tile_error;
+	  ret = sqlite3_step (stmt_face);
+	  if (ret != SQLITE_DONE && ret != SQLITE_ROW)
+	      goto error;
+      }
+    sqlite3_finalize (stmt);
+    stmt = NULL;
+
+/* copying all Nodes */
+    sql = "SELECT node_id, containing_face, geom FROM MAIN.\"tile_node\"";
+    ret = sqlite3_prepare_v2 (tile->handle, sql, strlen (sql), &stmt, NULL);
+    if (ret != SQLITE_OK)
+	goto tile_error;
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret != SQLITE_ROW)
+	      goto tile_error;
+	  sqlite3_reset (stmt_node);
+	  sqlite3_clear_bindings (stmt_node);
+	  if (sqlite3_column_int64 (stmt, 0) > max_node)
+	      max_node = sqlite3_column_int64 (stmt, 0);
+	  sqlite3_bind_int64 (stmt_node, 1,
+			      sqlite3_column_int64 (stmt, 0) + *node_offset);
+	  if (sqlite3_column_type (stmt, 1) == SQLITE_NULL)
+	      sqlite3_bind_null (stmt_node, 2);
+	  else
+	      sqlite3_bind_int64 (stmt_node, 2,
+				  tile_shift_id (sqlite3_column_int64
+						 (stmt, 1), *face_offset));
+	  if (!tile_copy_geometry
+	      (stmt, 2, stmt_node, 3, topo->srid, gpkg_mode, tiny_point))
+	      goto tile_error;
+	  ret = sqlite3_step (stmt_node);
+	  if (ret != SQLITE_DONE && ret != SQLITE_ROW)
+	      goto error;
+      }
+    sqlite3_finalize (stmt);
+    stmt = NULL;
+
+/* copying all Edges */
+    sql = "SELECT edge_id, start_node, end_node, next_left_edge, "
+	"next_right_edge, left_face, right_face, geom FROM MAIN.\"tile_edge\"";
+    ret = sqlite3_prepare_v2 (tile->handle, sql, strlen (sql), &stmt, NULL);
+    if (ret != SQLITE_OK)
+	goto tile_error;
+    while (1)
+      {
+	  int icol;
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret != SQLITE_ROW)
+	      goto tile_error;
+	  sqlite3_reset (stmt_edge);
+	  sqlite3_clear_bindings (stmt_edge);
+	  if (sqlite3_column_int64 (stmt, 0) > max_edge)
+	      max_edge = sqlite3_column_int64 (stmt, 0);
+	  sqlite3_bind_int64 (stmt_edge, 1,
+			      sqlite3_column_int64 (stmt, 0) + *edge_offset);
+	  sqlite3_bind_int64 (stmt_edge, 2,
+			      sqlite3_column_int64 (stmt, 1) + *node_offset);
+	  sqlite3_bind_int64 (stmt_edge, 3,
+			      sqlite3_column_int64 (stmt, 2) + *node_offset);
+	  sqlite3_bind_int64 (stmt_edge, 4,
+			      tile_shift_id (sqlite3_column_int64 (stmt, 3),
+					     *edge_offset));
+	  sqlite3_bind_int64 (stmt_edge, 5,
+			      tile_shift_id (sqlite3_column_int64 (stmt, 4),
+					     *edge_offset));
+	  for (icol = 5; icol <= 6; icol++)
+	    {
+		if (sqlite3_column_type (stmt, icol) == SQLITE_NULL)
+		    sqlite3_bind_null (stmt_edge, icol + 1);
+		else
+		    sqlite3_bind_int64 (stmt_edge, icol + 1,
+					tile_shift_id (sqlite3_column_int64
+						       (stmt, icol),
+						       *face_offset));
+	    }
+	  if (!tile_copy_geometry
+	      (stmt, 7, stmt_edge, 8, topo->srid, gpkg_mode, tiny_point))
+	      goto tile_error;
+	  ret = sqlite3_step (stmt_edge);
+	  if (ret != SQLITE_DONE && ret != SQLITE_ROW)
+	      goto error;
+      }
+    sqlite3_finalize (stmt);
+
+    *face_offset += max_face;
+    *node_offset += max_node;
+    *edge_offset += max_edge;
+    return 1;
+
+  tile_error:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    gaiaSetRtTopoErrorMsg (topo->cache,
+			   "TopoGeo_FromGeoTableTiled: unable to read a Tile Topology");
+    return 0;
+
+  error:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    msg = sqlite3_mprintf ("TopoGeo_FromGeoTableTiled error: \"%s\"",
+			   sqlite3_errmsg (topo->db_handle));
+    gaiaSetRtTopoErrorMsg (topo->cache, msg);
+    sqlite3_free (msg);
+    return 0;
+}
+
+static void
+tiled_error (struct gaia_topology *topo, const char *msg)
+{
+/* reporting an error of the tiled import */
+    gaiatopo_set_last_error_msg ((GaiaTopologyAccessorPtr) topo, msg);
+    gaiaSetRtTopoErrorMsg (topo->cache, msg);
+}
+
+static int
+check_empty_topology (struct gaia_topology *topo)
+{
+/* checking if the target Topology is still empty */
+    char *sql;
+    char *table;
+    char *xnode;
+    char *xedge;
+    char *xface;
+    int ret;
+    int i;
+    char **results;
+    int rows;
+    int columns;
+    int empty = 0;
+
+    table = sqlite3_mprintf ("%s_node", topo->topology_name);
+    xnode = gaiaDoubleQuotedSql (table);
+    sqlite3_free (table);
+    table = sqlite3_mprintf ("%s_edge", topo->topology_name);
+    xedge = gaiaDoubleQuotedSql (table);
+    sqlite3_free (table);
+    table = sqlite3_mprintf ("%s_face", topo->topology_name);
+    xface = gaiaDoubleQuotedSql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf
+	("SELECT (SELECT Count(*) FROM MAIN.\"%s\") + "
+	 "(SELECT Count(*) FROM MAIN.\"%s\") + "
+	 "(SELECT Count(*) FROM MAIN.\"%s\" WHERE face_id <> 0)", xnode,
+	 xedge, xface);
+    free (xnode);
+    free (xedge);
+    free (xface);
+    ret = sqlite3_get_table (topo->db_handle, sql, &results, &rows, &columns,
+			     NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return 0;
+    for (i = 1; i <= rows; i++)
+      {
+	  if (atoi (results[(i * columns) + 0]) == 0)
+	      empty = 1;
+      }
+    sqlite3_free_table (results);
+    return empty;
+}
+
+static sqlite3_stmt *
+prepare_tile_insert (struct gaia_topology *topo, const char *suffix,
+		     const char *columns, const char *values)
+{
+/* preparing an INSERT statement copying Tile rows */
+    sqlite3_stmt *stmt = NULL;
+    int ret;
+    char *sql;
+    char *table;
+    char *xtable;
+
+    table = sqlite3_mprintf ("%s_%s", topo->topology_name, suffix);
+    xtable = gaiaDoubleQuotedSql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf ("INSERT INTO MAIN.\"%s\" (%s) VALUES (%s)", xtable,
+			 columns, values);
+    free (xtable);
+    ret = sqlite3_prepare_v2 (topo->db_handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return NULL;
+    return stmt;
+}
+
+GAIATOPO_DECLARE int
+gaiaTopoGeo_FromGeoTableTiled (GaiaTopologyAccessorPtr accessor,
+			       const char *db_prefix, const char *table,
+			       const char *column, double tolerance,
+			       int line_max_points, double max_length,
+			       int tiles_per_side)
+{
+/* attempting to import a whole GeoTable into a Topology-Geometry - tiled mode */
+    struct gaia_topology *topo = (struct gaia_topology *) accessor;
+    sqlite3_stmt *stmt = NULL;
+    sqlite3_stmt *stmt_face = NULL;
+    sqlite3_stmt *stmt_node = NULL;
+    sqlite3_stmt *stmt_edge = NULL;
+    int ret;
+    char *sql;
+    char *xprefix;
+    char *xtable;
+    char *xcolumn;
+    int gpkg_amphibious = 0;
+    int gpkg_mode = 0;
+    struct topo_tile all;
+    struct topo_tile border;
+    struct topo_tile *tiles = NULL;
+    struct topo_tile **busy = NULL;
+    struct topo_tile_feature *ft;
+    struct topo_tile_feature *ft_n;
+    struct topo_tiles_worker *workers = NULL;
+    void **args = NULL;
+    int n_tiles = 0;
+    int n_busy = 0;
+    int n_threads;
+    int i;
+    int ok_extent = 0;
+    double minx = DBL_MAX;
+    double miny = DBL_MAX;
+    double maxx = -DBL_MAX;
+    double maxy = -DBL_MAX;
+    double tile_w;
+    double tile_h;
+    double margin;
+    double max_coord;
+    sqlite3_int64 face_offset = 0;
+    sqlite3_int64 node_offset = 0;
+    sqlite3_int64 edge_offset = 0;
+
+    if (topo == NULL)
+	return 0;
+    if (tiles_per_side < 2 || !check_empty_topology (topo))
+      {
+	  /* falling back to the plain serial import */
+	  return gaiaTopoGeo_FromGeoTable (accessor, db_prefix, table, column,
+					   tolerance, line_max_points,
+					   max_length);
+      }
+    if (topo->cache != NULL)
+      {
+	  struct splite_internal_cache *cache =
+	      (struct splite_internal_cache *) (topo->cache);
+	  gpkg_amphibious = cache->gpkg_amphibious_mode;
+	  gpkg_mode = cache->gpkg_mode;
+      }
+    memset (&all, 0, sizeof (struct topo_tile));
+    memset (&border, 0, sizeof (struct topo_tile));
+
+/* building the SQL statement */
+    xprefix = gaiaDoubleQuotedSql (db_prefix);
+    xtable = gaiaDoubleQuotedSql (table);
+    xcolumn = gaiaDoubleQuotedSql (column);
+    sql =
+	sqlite3_mprintf ("SELECT \"%s\" FROM \"%s\".\"%s\"", xcolumn,
+			 xprefix, xtable);
+    free (xprefix);
+    free (xtable);
+    free (xcolumn);
+    ret = sqlite3_prepare_v2 (topo->db_handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  char *msg = sqlite3_mprintf ("TopoGeo_FromGeoTableTiled error: \"%s\"",
+				       sqlite3_errmsg (topo->db_handle));
+	  tiled_error (topo, msg);
+	  sqlite3_free (msg);
+	  goto error;
+      }
+
+/* loading all input features */
+    while (1)
+      {
+	  /* scrolling the result set rows */
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;		/* end of result set */
+	  if (ret == SQLITE_ROW)
+	    {
+		if (sqlite3_column_type (stmt, 0) == SQLITE_NULL)
+		    continue;
+		if (sqlite3_column_type (stmt, 0) == SQLITE_BLOB)
+		  {
+		      const unsigned char *blob = sqlite3_column_blob (stmt, 0);
+		      int blob_sz = sqlite3_column_bytes (stmt, 0);
+		      gaiaGeomCollPtr geom =
+			  gaiaFromSpatiaLiteBlobWkbEx (blob, blob_sz, gpkg_mode,
+						       gpkg_amphibious);
+		      if (geom == NULL)
+			{
+			    tiled_error (topo,
+					 "TopoGeo_FromGeoTableTiled error: Invalid Geometry");
+			    goto error;
+			}
+		      gaiaMbrGeometry (geom);
+		      if (geom->MinX < minx)
+			  minx = geom->MinX;
+		      if (geom->MinY < miny)
+			  miny = geom->MinY;
+		      if (geom->MaxX > maxx)
+			  maxx = geom->MaxX;
+		      if (geom->MaxY > maxy)
+			  maxy = geom->MaxY;
+		      ok_extent = 1;
+		      add_tile_feature (&all, geom);
+		  }
+		else
+		  {
+		      tiled_error (topo,
+				   "TopoGeo_FromGeoTableTiled error: not a BLOB value");
+		      goto error;
+		  }
+	    }
+	  else
+	    {
+		char *msg =
+		    sqlite3_mprintf ("TopoGeo_FromGeoTableTiled error: \"%s\"",
+				     sqlite3_errmsg (topo->db_handle));
+		tiled_error (topo, msg);
+		sqlite3_free (msg);
+		goto error;
+	    }
+      }
+    sqlite3_finalize (stmt);
+    stmt = NULL;
+    if (!ok_extent)
+	return 1;		/* empty input table */
+
+/*
+/ assigning each feature to a Tile; the margin must cover the snapping
+/ tolerance and the minimal tolerance internally applied by RTTOPO
+/
+/ RTTOPO is sensitive to the insertion order, so any feature directly
+/ interacting with some preceding border feature will be imported during
+/ the healing pass as well, thus preserving the same relative order of
+/ the serial mode
+*/
+    n_tiles = tiles_per_side * tiles_per_side;
+    tiles = calloc (n_tiles, sizeof (struct topo_tile));
+    tile_w = (maxx - minx) / tiles_per_side;
+    tile_h = (maxy - miny) / tiles_per_side;
+    max_coord = fabs (minx);
+    if (fabs (miny) > max_coord)
+	max_coord = fabs (miny);
+    if (fabs (maxx) > max_coord)
+	max_coord = fabs (maxx);
+    if (fabs (maxy) > max_coord)
+	max_coord = fabs (maxy);
+    margin = ((tolerance < 0.0) ? topo->tolerance : tolerance);
+    margin += max_coord * 0.000000001;
+    ft = all.first;
+    while (ft != NULL)
+      {
+	  gaiaGeomCollPtr geom = ft->geom;
+	  int ix = -1;
+	  int iy = -1;
+	  ft_n = ft->next;
+	  free (ft);
+	  if (tile_w > 0.0 && tile_h > 0.0)
+	    {
+		ix = (int) floor ((geom->MinX - minx) / tile_w);
+		iy = (int) floor ((geom->MinY - miny) / tile_h);
+		if (ix >= tiles_per_side)
+		    ix = tiles_per_side - 1;
+		if (iy >= tiles_per_side)
+		    iy = tiles_per_side - 1;
+		if (ix > 0 && geom->MinX - margin <= minx + (ix * tile_w))
+		    ix = -1;
+		else if (ix < tiles_per_side - 1
+			 && geom->MaxX + margin >= minx + ((ix + 1) * tile_w))
+		    ix = -1;
+		if (iy > 0 && geom->MinY - margin <= miny + (iy * tile_h))
+		    iy = -1;
+		else if (iy < tiles_per_side - 1
+			 && geom->MaxY + margin >= miny + ((iy + 1) * tile_h))
+		    iy = -1;
+	    }
+	  if (ix >= 0 && iy >= 0)
+	    {
+		struct topo_tile *tile = tiles + (iy * tiles_per_side) + ix;
+		if (check_tile_crossing (tile, geom, margin))
+		  {
+		      /* interacting with some preceding border feature */
+		      add_tile_feature (&border, geom);
+		  }
+		else
+		    add_tile_feature (tile, geom);
+	    }
+	  else
+	    {
+		/* registering a border feature on all Tiles it crosses */
+		int ix1 = 0;
+		int iy1 = 0;
+		int ix2 = tiles_per_side - 1;
+		int iy2 = tiles_per_side - 1;
+		if (tile_w > 0.0 && tile_h > 0.0)
+		  {
+		      ix1 = (int) floor ((geom->MinX - margin - minx) / tile_w);
+		      iy1 = (int) floor ((geom->MinY - margin - miny) / tile_h);
+		      ix2 = (int) floor ((geom->MaxX + margin - minx) / tile_w);
+		      iy2 = (int) floor ((geom->MaxY + margin - miny) / tile_h);
+		      if (ix1 < 0)
+			  ix1 = 0;
+		      if (iy1 < 0)
+			  iy1 = 0;
+		      if (ix2 >= tiles_per_side)
+			  ix2 = tiles_per_side - 1;
+		      if (iy2 >= tiles_per_side)
+			  iy2 = tiles_per_side - 1;
+		  }
+		for (iy = iy1; iy <= iy2; iy++)
+		  {
+		      for (ix = ix1; ix <= ix2; ix++)
+			  add_tile_crossing (tiles + (iy * tiles_per_side) + ix,
+					     geom);
+		  }
+		add_tile_feature (&border, geom);
+	    }
+	  ft = ft_n;
+      }
+    all.first = NULL;
+    all.last = NULL;
+
+/* building all Tile Topologies in parallel */
+    busy = malloc (sizeof (struct topo_tile *) * n_tiles);
+    for (i = 0; i < n_tiles; i++)
+      {
+	  if ((tiles + i)->first != NULL)
+	      busy[n_busy++] = tiles + i;
+      }
+    n_threads = splite_get_cpu_count ();
+    if (n_threads > n_busy)
+	n_threads = n_busy;
+    if (n_threads > 0)
+      {
+	  workers = malloc (sizeof (struct topo_tiles_worker) * n_threads);
+	  args = malloc (sizeof (void *) * n_threads);
+	  for (i = 0; i < n_threads; i++)
+	    {
+		struct topo_tiles_worker *worker = workers + i;
+		worker->tiles = busy;
+		worker->n_tiles = n_busy;
+		worker->first = i;
+		worker->step = n_threads;
+		worker->has_z = topo->has_z;
+		worker->topo_tolerance = topo->tolerance;
+		worker->tolerance = tolerance;
+		worker->line_max_points = line_max_points;
+		worker->max_length = max_length;
+		args[i] = worker;
+	    }
+	  splite_run_threads (n_threads, tiles_worker, args);
+      }
+    for (i = 0; i < n_busy; i++)
+      {
+	  if (busy[i]->error_message != NULL)
+	    {
+		tiled_error (topo, busy[i]->error_message);
+		goto error;
+	    }
+      }
+
+/* copying all Tile Topologies into the target Topology */
+    stmt_face = prepare_tile_insert (topo, "face", "face_id, mbr", "?, ?");
+    stmt_node =
+	prepare_tile_insert (topo, "node", "node_id, containing_face, geom",
+			     "?, ?, ?");
+    stmt_edge =
+	prepare_tile_insert (topo, "edge",
+			     "edge_id, start_node, end_node, next_left_edge, "
+			     "next_right_edge, left_face, right_face, geom",
+			     "?, ?, ?, ?, ?, ?, ?, ?");
+    if (stmt_face == NULL || stmt_node == NULL || stmt_edge == NULL)
+      {
+	  char *msg = sqlite3_mprintf ("TopoGeo_FromGeoTableTiled error: \"%s\"",
+				       sqlite3_errmsg (topo->db_handle));
+	  tiled_error (topo, msg);
+	  sqlite3_free (msg);
+	  goto error;
+      }
+    for (i = 0; i < n_busy; i++)
+      {
+	  if (!do_merge_tile
+	      (topo, busy[i], stmt_face, stmt_node, stmt_edge, &face_offset,
+	       &node_offset, &edge_offset))
+	      goto error;
+	  close_tile (busy[i]);
+	  free_tile_features (busy[i]);
+      }
+    sqlite3_finalize (stmt_face);
+    sqlite3_finalize (stmt_node);
+    sqlite3_finalize (stmt_edge);
+    stmt_face = NULL;
+    stmt_node = NULL;
+    stmt_edge = NULL;
+    gaiatopo_flush_working_set (accessor);
+
+/* healing the Topology by importing all features crossing the Tile borders */
+    ft = border.first;
+    while (ft != NULL)
+      {
+	  if (!auxtopo_insert_into_topology
+	      (accessor, ft->geom, tolerance, line_max_points, max_length,
+	       GAIA_MODE_TOPO_FACE, NULL))
+	      goto error;
+	  ft = ft->next;
+      }
+
+    free_tile_features (&border);
+    for (i = 0; i < n_tiles; i++)
+	free_tile_features (tiles + i);
+    free (tiles);
+    free (busy);
+    if (workers != NULL)
+	free (workers);
+    if (args != NULL)
+	free (args);
+    return 1;
+
+  error:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    if (stmt_face != NULL)
+	sqlite3_finalize (stmt_face);
+    if (stmt_node != NULL)
+	sqlite3_finalize (stmt_node);
+    if (stmt_edge != NULL)
+	sqlite3_finalize (stmt_edge);
+    free_tile_features (&all);
+    free_tile_features (&border);
+    if (tiles != NULL)
+      {
+	  for (i = 0; i < n_tiles; i++)
+	    {
+		close_tile (tiles + i);
+		free_tile_features (tiles + i);
+		if ((tiles + i)->error_message != NULL)
+		    sqlite3_free ((tiles + i)->error_message);
+	    }
+	  free (tiles);
+      }
+    if (busy != NULL)
+	free (busy);
+    if (workers != NULL)
+	free (workers);
+    if (args != NULL)
+	free (args);
+    return 0;
+}
+
 GAIATOPO_DECLARE int
 gaiaTopoGeo_FromGeoTableNoFace (GaiaTopologyAccessorPtr accessor,
 				const char *db_prefix, const char *table,
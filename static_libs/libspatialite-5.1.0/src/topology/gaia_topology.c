@@ -214,6 +214,9 @@ start_topo_savepoint (const void *handle, const void *data)
     if (sqlite == NULL || cache == NULL)
 	return;
 
+/* the Topology Working Sets are only valid within a SavePoint */
+    gaiatopo_flush_all_working_sets (cache);
+
 /* creating an unique SavePoint name */
     p_svpt = push_topo_savepoint (cache);
     p_svpt->savepoint_name =
@@ -246,6 +249,9 @@ release_topo_savepoint (const void *handle, const void *data)
     struct splite_internal_cache *cache = (struct splite_internal_cache *) data;
     if (sqlite == NULL || cache == NULL)
 	return;
+
+/* flushing the Topology Working Sets */
+    gaiatopo_flush_all_working_sets (cache);
     p_svpt = cache->last_topo_svpt;
     if (p_svpt == NULL)
 	return;
@@ -276,6 +282,9 @@ rollback_topo_savepoint (const void *handle, const void *data)
     struct splite_internal_cache *cache = (struct splite_internal_cache *) data;
     if (sqlite == NULL || cache == NULL)
 	return;
+
+/* flushing the Topology Working Sets */
+    gaiatopo_flush_all_working_sets (cache);
     p_svpt = cache->last_topo_svpt;
     if (p_svpt == NULL)
 	return;
@@ -4714,6 +4723,242 @@ fnctaux_TopoGeo_FromGeoTable (const void *xcontext, int argc, const void *xargv)
     return;
 }
 
+SPATIALITE_PRIVATE void
+fnctaux_TopoGeo_FromGeoTableTiled (const void *xcontext, int argc,
+				   const void *xargv)
+{
+/* SQL function:
+/ TopoGeo_FromGeoTableTiled ( text topology-name, text db-prefix,
+/                             text table, text column, int tiles_per_side )
+/ TopoGeo_FromGeoTableTiled ( text topology-name, text db-prefix,
+/                             text table, text column, int tiles_per_side,
+/                             int line_max_points )
+/ TopoGeo_FromGeoTableTiled ( text topology-name, text db-prefix,
+/                             text table, text column, int tiles_per_side,
+/                             int line_max_points, double max_length )
+/ TopoGeo_FromGeoTableTiled ( text topology-name, text db-prefix,
+/                             text table, text column, int tiles_per_side,
+/                             int line_max_points, double max_length,
+/                             double tolerance )
+/
+/ returns: 1 on success
+/ raises an exception on failure
+*/
+    const char *msg;
+    int ret;
+    const char *topo_name;
+    const char *db_prefix;
+    const char *table;
+    const char *column;
+    char *xtable = NULL;
+    char *xcolumn = NULL;
+    int srid;
+    int family;
+    int dims;
+    int tiles_per_side;
+    int line_max_points = -1;
+    double max_length = -1.0;
+    double tolerance = -1;
+    GaiaTopologyAccessorPtr accessor = NULL;
+    sqlite3_context *context = (sqlite3_context *) xcontext;
+    sqlite3_value **argv = (sqlite3_value **) xargv;
+    sqlite3 *sqlite = sqlite3_context_db_handle (context);
+    struct splite_internal_cache *cache = sqlite3_user_data (context);
+    GAIA_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) == SQLITE_NULL)
+	goto null_arg;
+    else if (sqlite3_value_type (argv[0]) == SQLITE_TEXT)
+	topo_name = (const char *) sqlite3_value_text (argv[0]);
+    else
+	goto invalid_arg;
+    if (sqlite3_value_type (argv[1]) == SQLITE_NULL)
+	db_prefix = "main";
+    else if (sqlite3_value_type (argv[1]) == SQLITE_TEXT)
+	db_prefix = (const char *) sqlite3_value_text (argv[1]);
+    else
+	goto invalid_arg;
+    if (sqlite3_value_type (argv[2]) == SQLITE_NULL)
+	goto null_arg;
+    else if (sqlite3_value_type (argv[2]) == SQLITE_TEXT)
+	table = (const char *) sqlite3_value_text (argv[2]);
+    else
+	goto invalid_arg;
+    if (sqlite3_value_type (argv[3]) == SQLITE_NULL)
+	column = NULL;
+    else if (sqlite3_value_type (argv[3]) == SQLITE_TEXT)
+	column = (const char *) sqlite3_value_text (argv[3]);
+    else
+	goto invalid_arg;
+    if (sqlite3_value_type (argv[4]) == SQLITE_INTEGER)
+	tiles_per_side = sqlite3_value_int (argv[4]);
+    else
+	goto invalid_arg;
+    if (argc >= 6)
+      {
+	  if (sqlite3_value_type (argv[5]) == SQLITE_NULL)
+	      ;
+	  else if (sqlite3_value_type (argv[5]) == SQLITE_INTEGER)
+	    {
+		line_max_points = sqlite3_value_int (argv[5]);
+		if (line_max_points < 2)
+		    goto illegal_max_points;
+	    }
+	  else
+	      goto invalid_arg;
+      }
+    if (argc >= 7)
+      {
+	  if (sqlite3_value_type (argv[6]) == SQLITE_NULL)
+	      ;
+	  else
+	    {
+		if (sqlite3_value_type (argv[6]) == SQLITE_INTEGER)
+		  {
+		      int max = sqlite3_value_int (argv[6]);
+		      max_length = max;
+		  }
+		else if (sqlite3_value_type (argv[6]) == SQLITE_FLOAT)
+		    max_length = sqlite3_value_double (argv[6]);
+		else
+		    goto invalid_arg;
+		if (max_length <= 0.0)
+		    goto nonpositive_max_length;
+	    }
+      }
+    if (argc >= 8)
+      {
+	  if (sqlite3_value_type (argv[7]) == SQLITE_NULL)
+	      goto null_arg;
+	  else if (sqlite3_value_type (argv[7]) == SQLITE_INTEGER)
+	    {
+		int t = sqlite3_value_int (argv[7]);
+		tolerance = t;
+	    }
+	  else if (sqlite3_value_type (argv[7]) == SQLITE_FLOAT)
+	      tolerance = sqlite3_value_double (argv[7]);
+	  else
+	      goto invalid_arg;
+	  if (tolerance < 0.0)
+	      goto negative_tolerance;
+      }
+
+/* attempting to get a Topology Accessor */
+    accessor = gaiaGetTopology (sqlite, cache, topo_name);
+    if (accessor == NULL)
+	goto no_topo;
+    gaiatopo_reset_last_error_msg (accessor);
+
+/* checking the input GeoTable */
+    if (!check_input_geo_table
+	(sqlite, db_prefix, table, column, &xtable, &xcolumn, &srid, &family,
+	 &dims))
+	goto no_input;
+    if (!check_matching_srid_dims (accessor, srid, dims))
+	goto invalid_geom;
+
+    start_topo_savepoint (sqlite, cache);
+    ret =
+	gaiaTopoGeo_FromGeoTableTiled (accessor, db_prefix, xtable, xcolumn,
+				       tolerance, line_max_points, max_length,
+				       tiles_per_side);
+    if (!ret)
+	rollback_topo_savepoint (sqlite, cache);
+    else
+	release_topo_savepoint (sqlite, cache);
+    free (xtable);
+    free (xcolumn);
+    if (!ret)
+      {
+	  msg = gaiaGetRtTopoErrorMsg (cache);
+	  gaiatopo_set_last_error_msg (accessor, msg);
+	  sqlite3_result_error (context, msg, -1);
+	  return;
+      }
+    sqlite3_result_int (context, 1);
+    return;
+
+  no_topo:
+    if (xtable != NULL)
+	free (xtable);
+    if (xcolumn != NULL)
+	free (xcolumn);
+    msg = "SQL/MM Spatial exception - invalid topology name.";
+    gaiatopo_set_last_error_msg (accessor, msg);
+    sqlite3_result_error (context, msg, -1);
+    return;
+
+  no_input:
+    if (xtable != NULL)
+	free (xtable);
+    if (xcolumn != NULL)
+	free (xcolumn);
+    msg = "SQL/MM Spatial exception - invalid input GeoTable.";
+    gaiatopo_set_last_error_msg (accessor, msg);
+    sqlite3_result_error (context, msg, -1);
+    return;
+
+  null_arg:
+    if (xtable != NULL)
+	free (xtable);
+    if (xcolumn != NULL)
+	free (xcolumn);
+    msg = "SQL/MM Spatial exception - null argument.";
+    gaiatopo_set_last_error_msg (accessor, msg);
+    sqlite3_result_error (context, msg, -1);
+    return;
+
+  invalid_arg:
+    if (xtable != NULL)
+	free (xtable);
+    if (xcolumn != NULL)
+	free (xcolumn);
+    msg = "SQL/MM Spatial exception - invalid argument.";
+    gaiatopo_set_last_error_msg (accessor, msg);
+    sqlite3_result_error (context, msg, -1);
+    return;
+
+  invalid_geom:
+    if (xtable != NULL)
+	free (xtable);
+    if (xcolumn != NULL)
+	free (xcolumn);
+    msg =
+	"SQL/MM Spatial exception - invalid GeoTable (mismatching SRID or dimensions).";
+    gaiatopo_set_last_error_msg (accessor, msg);
+    sqlite3_result_error (context, msg, -1);
+    return;
+
+  negative_tolerance:
+    if (xtable != NULL)
+	free (xtable);
+    if (xcolumn != NULL)
+	free (xcolumn);
+    msg = "SQL/MM Spatial exception - illegal negative tolerance.";
+    gaiatopo_set_last_error_msg (accessor, msg);
+    sqlite3_result_error (context, msg, -1);
+    return;
+
+  illegal_max_points:
+    if (xtable != NULL)
+	free (xtable);
+    if (xcolumn != NULL)
+	free (xcolumn);
+    msg = "SQL/MM Spatial exception - max_points should be >= 2.";
+    gaiatopo_set_last_error_msg (accessor, msg);
+    sqlite3_result_error (context, msg, -1);
+    return;
+
+  nonpositive_max_length:
+    if (xtable != NULL)
+	free (xtable);
+    if (xcolumn != NULL)
+	free (xcolumn);
+    msg = "SQL/MM Spatial exception - max_length should be > 0.0.";
+    gaiatopo_set_last_error_msg (accessor, msg);
+    sqlite3_result_error (context, msg, -1);
+    return;
+}
+
 SPATIALITE_PRIVATE void
 fnctaux_TopoGeo_FromGeoTableNoFace (const void *xcontext, int argc,
 				    const void *xargv)
@@ -1348,6 +1348,54 @@ do_read_edge_by_face (sqlite3_stmt * stmt, struct topo_edges_list *list,
     return 1;
 }
 
+static char *
+do_prepare_read_face (const char *topology_name, int fields)
+{
+/* preparing the auxiliary "read_face" SQL statement */
+    char *sql;
+    char *prev;
+    char *table;
+    char *xtable;
+    int comma = 0;
+
+    sql = sqlite3_mprintf ("SELECT ");
+    prev = sql;
+    if (fields & RTT_COL_FACE_FACE_ID)
+      {
+	  if (comma)
+	      sql = sqlite3_mprintf ("%s, face_id", prev);
+	  else
+	      sql = sqlite3_mprintf ("%s face_id", prev);
+	  comma = 1;
+	  sqlite3_free (prev);
+	  prev = sql;
+      }
+    if (fields & RTT_COL_FACE_MBR)
+      {
+	  if (comma)
+	      sql =
+		  sqlite3_mprintf
+		  ("%s, MbrMinX(mbr), MbrMinY(mbr), MbrMaxX(mbr), MbrMaxY(mbr)",
+		   prev);
+	  else
+	      sql =
+		  sqlite3_mprintf
+		  ("%s MbrMinX(mbr), MbrMinY(mbr), MbrMaxX(mbr), MbrMaxY(mbr)",
+		   prev);
+	  comma = 1;
+	  sqlite3_free (prev);
+	  prev = sql;
+      }
+    table = sqlite3_mprintf ("%s_face", topology_name);
+    xtable = gaiaDoubleQuotedSql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf ("%s FROM MAIN.\"%s\" WHERE face_id = ?", prev, xtable);
+    sqlite3_free (prev);
+    free (xtable);
+    return sql;
+}
+
 static int
 do_read_face (sqlite3_stmt * stmt, struct topo_faces_list *list,
 	      sqlite3_int64 id, int fields, const char *callback_name,
@@ -1463,6 +1511,727 @@ do_read_face (sqlite3_stmt * stmt, struct topo_faces_list *list,
     return 1;
 }
 
+/*
+/ the in-memory Working Set
+/
+/ while a Topology SavePoint is open the Accessor keeps a copy of
+/ every Node, Edge and Face already decoded by the "ById" callbacks;
+/ any callback updating or deleting Topology primitives will invalidate
+/ the affected items, and the whole Working Set will be flushed on
+/ SavePoint boundaries or when exceeding GAIA_TOPO_WS_MAX_MEMORY
+/
+/ getRingEdges walks the Rings directly on the Working Set, so that
+/ the following getEdgeById (always requesting the same Edges) will
+/ be fully resolved in memory
+/
+/ all items are carved from a few large memory blocks released in a
+/ single pass when flushing, so to avoid scattering thousands of tiny
+/ allocations all over the heap used by SQLite itself
+*/
+
+#define GAIA_TOPO_WS_MIN_BUCKETS	1024
+#define GAIA_TOPO_WS_BLOCK_SIZE		(1024 * 1024)
+#define GAIA_TOPO_WS_MAX_MEMORY		(32 * 1024 * 1024)
+
+struct topo_ws_block
+{
+/* a struct wrapping a memory block of the Working Set */
+    struct topo_ws_block *next;
+    size_t size;
+    size_t used;
+};
+
+struct topo_ws_item
+{
+/* a struct wrapping an item of the Working Set */
+    sqlite3_int64 id;
+    void *data;
+    unsigned int mark_pos;	/* stamp of the last visiting callback */
+    unsigned int mark_neg;	/* same, for a reversed Edge */
+    struct topo_ws_item *next;
+};
+
+struct topo_ws_table
+{
+/* a struct wrapping an hash table of Working Set items */
+    struct topo_ws_item **buckets;
+    int n_buckets;
+    int count;
+};
+
+struct topo_working_set
+{
+/* a struct wrapping the Working Set of a Topology Accessor */
+    struct topo_ws_table nodes;
+    struct topo_ws_table edges;
+    struct topo_ws_table faces;
+    struct topo_ws_block *blocks;
+    size_t memory;
+    unsigned int stamp;
+    unsigned int flushes;
+    sqlite3_stmt *stmt_read_node;
+    sqlite3_stmt *stmt_read_edge;
+    sqlite3_stmt *stmt_read_face;
+};
+
+static void
+ws_clear_table (struct topo_ws_table *table)
+{
+/* removing all items from a Working Set hash table */
+    if (table->buckets != NULL)
+	free (table->buckets);
+    table->buckets = NULL;
+    table->n_buckets = 0;
+    table->count = 0;
+}
+
+static void
+ws_flush (struct topo_working_set *ws)
+{
+/* removing all items from the Working Set */
+    struct topo_ws_block *blk;
+    struct topo_ws_block *blk_n;
+    ws_clear_table (&(ws->nodes));
+    ws_clear_table (&(ws->edges));
+    ws_clear_table (&(ws->faces));
+    blk = ws->blocks;
+    while (blk != NULL)
+      {
+	  blk_n = blk->next;
+	  free (blk);
+	  blk = blk_n;
+      }
+    ws->blocks = NULL;
+    ws->memory = 0;
+    ws->flushes += 1;
+}
+
+static void *
+ws_alloc (struct topo_working_set *ws, size_t size)
+{
+/* carving some memory from the Working Set blocks */
+    struct topo_ws_block *blk = ws->blocks;
+    void *ptr;
+    size = (size + 7) & ~((size_t) 7);
+    if (blk == NULL || blk->used + size > blk->size)
+      {
+	  /* a further block is required */
+	  size_t blk_size = GAIA_TOPO_WS_BLOCK_SIZE;
+	  if (size > blk_size)
+	      blk_size = size;
+	  if (ws->memory + blk_size > GAIA_TOPO_WS_MAX_MEMORY)
+	    {
+		/* the memory budget has been exhausted */
+		ws_flush (ws);
+	    }
+	  blk = malloc (sizeof (struct topo_ws_block) + blk_size);
+	  if (blk == NULL)
+	      return NULL;
+	  blk->next = ws->blocks;
+	  blk->size = blk_size;
+	  blk->used = 0;
+	  ws->blocks = blk;
+	  ws->memory += blk_size;
+      }
+    ptr = (unsigned char *) (blk + 1) + blk->used;
+    blk->used += size;
+    return ptr;
+}
+
+static int
+ws_hash (sqlite3_int64 id, int n_buckets)
+{
+/* computing the hash bucket of some ID (Fibonacci hashing) */
+    sqlite3_uint64 h = (sqlite3_uint64) id * 0x9E3779B97F4A7C15ULL;
+    return (int) ((h >> 32) & (sqlite3_uint64) (n_buckets - 1));
+}
+
+static struct topo_ws_item *
+ws_find_item (struct topo_ws_table *table, sqlite3_int64 id)
+{
+/* searching an item into a Working Set hash table */
+    struct topo_ws_item *item;
+    if (table->buckets == NULL)
+	return NULL;
+    item = table->buckets[ws_hash (id, table->n_buckets)];
+    while (item != NULL)
+      {
+	  if (item->id == id)
+	      return item;
+	  item = item->next;
+      }
+    return NULL;
+}
+
+static void *
+ws_find (struct topo_ws_table *table, sqlite3_int64 id)
+{
+/* searching the data of an item into a Working Set hash table */
+    struct topo_ws_item *item = ws_find_item (table, id);
+    if (item == NULL)
+	return NULL;
+    return item->data;
+}
+
+static void
+ws_remove (struct topo_ws_table *table, sqlite3_int64 id)
+{
+/* removing an item from a Working Set hash table */
+    struct topo_ws_item *item;
+    struct topo_ws_item *prev = NULL;
+    int bucket;
+    if (table->buckets == NULL)
+	return;
+    bucket = ws_hash (id, table->n_buckets);
+    item = table->buckets[bucket];
+    while (item != NULL)
+      {
+	  if (item->id == id)
+	    {
+		/* the memory will be reclaimed by the next flush */
+		if (prev == NULL)
+		    table->buckets[bucket] = item->next;
+		else
+		    prev->next = item->next;
+		table->count -= 1;
+		return;
+	    }
+	  prev = item;
+	  item = item->next;
+      }
+}
+
+static void
+ws_rehash (struct topo_ws_table *table, int n_buckets)
+{
+/* resizing a Working Set hash table */
+    int i;
+    struct topo_ws_item *item;
+    struct topo_ws_item *item_n;
+    struct topo_ws_item **buckets =
+	calloc (n_buckets, sizeof (struct topo_ws_item *));
+    for (i = 0; i < table->n_buckets; i++)
+      {
+	  item = table->buckets[i];
+	  while (item != NULL)
+	    {
+		int bucket = ws_hash (item->id, n_buckets);
+		item_n = item->next;
+		item->next = buckets[bucket];
+		buckets[bucket] = item;
+		item = item_n;
+	    }
+      }
+    if (table->buckets != NULL)
+	free (table->buckets);
+    table->buckets = buckets;
+    table->n_buckets = n_buckets;
+}
+
+static void *
+ws_insert (struct topo_working_set *ws, struct topo_ws_table *table,
+	   sqlite3_int64 id, size_t size)
+{
+/*
+/ inserting an item into a Working Set hash table
+/ returns the memory area to be filled by the caller
+*/
+    struct topo_ws_item *item;
+    int bucket;
+    ws_remove (table, id);
+    item = ws_alloc (ws, sizeof (struct topo_ws_item) + size);
+    if (item == NULL)
+	return NULL;
+    if (table->buckets == NULL)
+	ws_rehash (table, GAIA_TOPO_WS_MIN_BUCKETS);
+    else if (table->count >= table->n_buckets * 2)
+	ws_rehash (table, table->n_buckets * 4);
+
+    item->id = id;
+    item->data = item + 1;
+    item->mark_pos = 0;
+    item->mark_neg = 0;
+    bucket = ws_hash (id, table->n_buckets);
+    item->next = table->buckets[bucket];
+    table->buckets[bucket] = item;
+    table->count += 1;
+    return item->data;
+}
+
+static void
+ws_cache_node (struct topo_working_set *ws, const struct topo_node *nd)
+{
+/* copying a Node into the Working Set */
+    struct topo_node *copy =
+	ws_insert (ws, &(ws->nodes), nd->node_id, sizeof (struct topo_node));
+    if (copy == NULL)
+	return;
+    *copy = *nd;
+    copy->next = NULL;
+}
+
+static void
+ws_cache_edge (struct topo_working_set *ws, const struct topo_edge *ed)
+{
+/* copying an Edge into the Working Set */
+    struct topo_edge *copy;
+    gaiaLinestringPtr ln;
+    size_t coords = 0;
+    size_t size = sizeof (struct topo_edge);
+    if (ed->geom != NULL)
+      {
+	  int dims = 3;
+	  if (ed->geom->DimensionModel == GAIA_XY)
+	      dims = 2;
+	  else if (ed->geom->DimensionModel == GAIA_XY_Z_M)
+	      dims = 4;
+	  coords = ed->geom->Points * dims * sizeof (double);
+	  size += sizeof (gaiaLinestring) + coords;
+      }
+    copy = ws_insert (ws, &(ws->edges), ed->edge_id, size);
+    if (copy == NULL)
+	return;
+    *copy = *ed;
+    copy->next = NULL;
+    if (ed->geom != NULL)
+      {
+	  /* the Linestring and its Coords follow the Edge itself */
+	  ln = (gaiaLinestringPtr) (copy + 1);
+	  *ln = *(ed->geom);
+	  ln->Coords = (double *) (ln + 1);
+	  ln->Next = NULL;
+	  memcpy (ln->Coords, ed->geom->Coords, coords);
+	  copy->geom = ln;
+      }
+}
+
+static void
+ws_cache_face (struct topo_working_set *ws, const struct topo_face *fc)
+{
+/* copying a Face into the Working Set */
+    struct topo_face *copy =
+	ws_insert (ws, &(ws->faces), fc->id, sizeof (struct topo_face));
+    if (copy == NULL)
+	return;
+    *copy = *fc;
+    copy->next = NULL;
+}
+
+static int
+ws_list_has_edge (struct topo_edges_list *list, sqlite3_int64 edge_id)
+{
+/* checking if some Edge is already in the list */
+    struct topo_edge *p_ed = list->first;
+    while (p_ed != NULL)
+      {
+	  if (p_ed->edge_id == edge_id)
+	      return 1;
+	  p_ed = p_ed->next;
+      }
+    return 0;
+}
+
+static void
+ws_forget_node (struct gaia_topology *accessor, sqlite3_int64 node_id)
+{
+/* removing an updated or deleted Node from the Working Set */
+    struct topo_working_set *ws =
+	(struct topo_working_set *) (accessor->working_set);
+    if (ws != NULL)
+	ws_remove (&(ws->nodes), node_id);
+}
+
+static void
+ws_forget_edge (struct gaia_topology *accessor, sqlite3_int64 edge_id)
+{
+/* removing an updated or deleted Edge from the Working Set */
+    struct topo_working_set *ws =
+	(struct topo_working_set *) (accessor->working_set);
+    if (ws != NULL)
+	ws_remove (&(ws->edges), edge_id);
+}
+
+static void
+ws_forget_face (struct gaia_topology *accessor, sqlite3_int64 face_id)
+{
+/* removing an updated or deleted Face from the Working Set */
+    struct topo_working_set *ws =
+	(struct topo_working_set *) (accessor->working_set);
+    if (ws != NULL)
+	ws_remove (&(ws->faces), face_id);
+}
+
+static int
+ws_match_face (sqlite3_int64 cached, sqlite3_int64 sel)
+{
+/* checking a Face selector (negative values stand for NULL) */
+    if (sel < 0)
+	return (cached < 0) ? 1 : 0;
+    return (cached == sel) ? 1 : 0;
+}
+
+static int
+ws_match_edge (const struct topo_edge *ed, const RTT_ISO_EDGE * sel_edge,
+	       int sel_fields)
+{
+/* checking if a Working Set Edge could match some selection */
+    if ((sel_fields & RTT_COL_EDGE_EDGE_ID)
+	&& ed->edge_id != sel_edge->edge_id)
+	return 0;
+    if ((sel_fields & RTT_COL_EDGE_START_NODE)
+	&& ed->start_node != sel_edge->start_node)
+	return 0;
+    if ((sel_fields & RTT_COL_EDGE_END_NODE)
+	&& ed->end_node != sel_edge->end_node)
+	return 0;
+    if ((sel_fields & RTT_COL_EDGE_FACE_LEFT)
+	&& !ws_match_face (ed->face_left, sel_edge->face_left))
+	return 0;
+    if ((sel_fields & RTT_COL_EDGE_FACE_RIGHT)
+	&& !ws_match_face (ed->face_right, sel_edge->face_right))
+	return 0;
+    if ((sel_fields & RTT_COL_EDGE_NEXT_LEFT)
+	&& ed->next_left != sel_edge->next_left)
+	return 0;
+    if ((sel_fields & RTT_COL_EDGE_NEXT_RIGHT)
+	&& ed->next_right != sel_edge->next_right)
+	return 0;
+    return 1;
+}
+
+static void
+ws_forget_nodes (struct gaia_topology *accessor, const RTT_ISO_NODE * sel_node,
+		 int sel_fields)
+{
+/* removing from the Working Set all Nodes matching some selection */
+    struct topo_working_set *ws =
+	(struct topo_working_set *) (accessor->working_set);
+    int i;
+    struct topo_ws_item *item;
+    struct topo_ws_item *item_n;
+    struct topo_node *nd;
+    if (ws == NULL)
+	return;
+    if (sel_node == NULL || (sel_fields & RTT_COL_NODE_GEOM))
+      {
+	  ws_clear_table (&(ws->nodes));
+	  return;
+      }
+    if (sel_fields == RTT_COL_NODE_NODE_ID)
+      {
+	  ws_remove (&(ws->nodes), sel_node->node_id);
+	  return;
+      }
+    for (i = 0; i < ws->nodes.n_buckets; i++)
+      {
+	  item = ws->nodes.buckets[i];
+	  while (item != NULL)
+	    {
+		item_n = item->next;
+		nd = (struct topo_node *) (item->data);
+		if ((sel_fields & RTT_COL_NODE_NODE_ID)
+		    && nd->node_id != sel_node->node_id)
+		    ;
+		else if ((sel_fields & RTT_COL_NODE_CONTAINING_FACE)
+			 && !ws_match_face (nd->containing_face,
+					    sel_node->containing_face))
+		    ;
+		else
+		    ws_remove (&(ws->nodes), item->id);
+		item = item_n;
+	    }
+      }
+}
+
+static void
+ws_forget_edges (struct gaia_topology *accessor, const RTT_ISO_EDGE * sel_edge,
+		 int sel_fields)
+{
+/* removing from the Working Set all Edges matching some selection */
+    struct topo_working_set *ws =
+	(struct topo_working_set *) (accessor->working_set);
+    int i;
+    struct topo_ws_item *item;
+    struct topo_ws_item *item_n;
+    if (ws == NULL)
+	return;
+    if (sel_edge == NULL || (sel_fields & RTT_COL_EDGE_GEOM))
+      {
+	  ws_clear_table (&(ws->edges));
+	  return;
+      }
+    if (sel_fields == RTT_COL_EDGE_EDGE_ID)
+      {
+	  ws_remove (&(ws->edges), sel_edge->edge_id);
+	  return;
+      }
+    for (i = 0; i < ws->edges.n_buckets; i++)
+      {
+	  item = ws->edges.buckets[i];
+	  while (item != NULL)
+	    {
+		item_n = item->next;
+		if (ws_match_edge
+		    ((struct topo_edge *) (item->data), sel_edge, sel_fields))
+		    ws_remove (&(ws->edges), item->id);
+		item = item_n;
+	    }
+      }
+}
+
+static struct topo_working_set *
+get_working_set (struct gaia_topology *accessor)
+{
+/* returning the Working Set only when a Topology SavePoint is open */
+    struct splite_internal_cache *cache =
+	(struct splite_internal_cache *) accessor->cache;
+    if (accessor->working_set == NULL || cache == NULL)
+	return NULL;
+    if (cache->last_topo_svpt == NULL)
+	return NULL;
+    return (struct topo_working_set *) (accessor->working_set);
+}
+
+static void
+ws_append_edge (struct topo_edges_list *list, sqlite3_int64 edge_id,
+		const struct topo_edge *ed)
+{
+/* appending an Edge to the list (no check for duplicates) */
+    struct topo_edge *ptr;
+    if (ed == NULL)
+	ptr = create_topo_edge (edge_id, -1, -1, -1, -1, -1, -1, NULL);
+    else
+	ptr =
+	    create_topo_edge (edge_id, ed->start_node, ed->end_node,
+			      ed->face_left, ed->face_right, ed->next_left,
+			      ed->next_right, (ed->geom == NULL) ? NULL :
+			      gaiaCloneLinestring (ed->geom));
+    if (list->first == NULL)
+	list->first = ptr;
+    if (list->last != NULL)
+	list->last->next = ptr;
+    list->last = ptr;
+    list->count++;
+}
+
+static int
+ws_fetch_edge (struct gaia_topology *accessor, struct topo_working_set *ws,
+	       sqlite3_int64 edge_id, const char *callback_name,
+	       struct topo_ws_item **item, char **errmsg)
+{
+/*
+/ fetching an Edge from the Working Set, reading it from the DBMS
+/ when not yet cached; *item will be NULL for a not existing Edge
+*/
+    struct topo_edges_list tmp;
+    int ret;
+    char *sql;
+
+    *errmsg = NULL;
+    *item = ws_find_item (&(ws->edges), edge_id);
+    if (*item != NULL)
+	return 1;
+
+    if (ws->stmt_read_edge == NULL)
+      {
+	  /* preparing the SQL statement */
+	  sql =
+	      do_prepare_read_edge (accessor->topology_name, RTT_COL_EDGE_ALL);
+	  ret =
+	      sqlite3_prepare_v2 (accessor->db_handle, sql, strlen (sql),
+				  &(ws->stmt_read_edge), NULL);
+	  sqlite3_free (sql);
+	  if (ret != SQLITE_OK)
+	    {
+		*errmsg =
+		    sqlite3_mprintf ("%s: Prepare AUX error: \"%s\"",
+				     callback_name,
+				     sqlite3_errmsg (accessor->db_handle));
+		ws->stmt_read_edge = NULL;
+		return 0;
+	    }
+      }
+
+    tmp.first = NULL;
+    tmp.last = NULL;
+    tmp.count = 0;
+    if (!do_read_edge
+	(ws->stmt_read_edge, &tmp, edge_id, RTT_COL_EDGE_ALL, callback_name,
+	 errmsg))
+      {
+	  if (tmp.first != NULL)
+	      destroy_topo_edge (tmp.first);
+	  return 0;
+      }
+    if (tmp.first == NULL)
+	return 1;		/* not existing Edge */
+    ws_cache_edge (ws, tmp.first);
+    destroy_topo_edge (tmp.first);
+    *item = ws_find_item (&(ws->edges), edge_id);
+    if (*item == NULL)
+      {
+	  *errmsg =
+	      sqlite3_mprintf ("%s: insufficient memory", callback_name);
+	  return 0;
+      }
+    return 1;
+}
+
+static struct topo_edges_list *
+ws_get_ring_edges (struct gaia_topology *accessor, sqlite3_int64 edge,
+		   int limit, int *count, char **errmsg)
+{
+/*
+/ walking a whole Ring by following the next_left/next_right links
+/ of the Working Set Edges (reading from the DBMS any missing Edge);
+/ exactly as the SQL recursive query the walk stops as soon as some
+/ signed Edge is visited twice or when the next Edge doesn't exist
+/
+/ NULL will be returned on failure (*errmsg set) or when the Working
+/ Set has been flushed during the walk, so to fall back to SQL
+*/
+    struct topo_working_set *ws = get_working_set (accessor);
+    struct topo_edges_list *list;
+    struct topo_ws_item *item;
+    struct topo_edge *p_ed;
+    unsigned int *mark;
+    unsigned int stamp;
+    unsigned int flushes;
+    sqlite3_int64 signed_id = edge;
+    int n = 0;
+
+    *errmsg = NULL;
+    if (ws == NULL)
+	return NULL;
+    ws->stamp += 1;
+    stamp = ws->stamp;
+    flushes = ws->flushes;
+
+    list = create_edges_list ();
+    while (1)
+      {
+	  if (!ws_fetch_edge
+	      (accessor, ws, (signed_id < 0) ? -signed_id : signed_id,
+	       "callback_getRingEdges", &item, errmsg))
+	      goto error;
+	  if (ws->flushes != flushes)
+	      goto error;	/* the memory budget has been exhausted */
+	  if (item == NULL)
+	      break;		/* not existing Edge */
+	  mark = (signed_id < 0) ? &(item->mark_neg) : &(item->mark_pos);
+	  if (*mark == stamp)
+	      break;		/* already visited */
+	  *mark = stamp;
+	  ws_append_edge (list, signed_id, NULL);
+	  n++;
+	  if (limit > 0 && n > limit)
+	      break;
+	  p_ed = (struct topo_edge *) (item->data);
+	  signed_id = (signed_id < 0) ? p_ed->next_right : p_ed->next_left;
+      }
+    *count = n;
+    return list;
+
+  error:
+    destroy_edges_list (list);
+    return NULL;
+}
+
+TOPOLOGY_PRIVATE void *
+gaiatopo_create_working_set (void)
+{
+/* creating an empty Working Set */
+    struct topo_working_set *ws = malloc (sizeof (struct topo_working_set));
+    ws->nodes.buckets = NULL;
+    ws->nodes.n_buckets = 0;
+    ws->nodes.count = 0;
+    ws->edges.buckets = NULL;
+    ws->edges.n_buckets = 0;
+    ws->edges.count = 0;
+    ws->faces.buckets = NULL;
+    ws->faces.n_buckets = 0;
+    ws->faces.count = 0;
+    ws->blocks = NULL;
+    ws->memory = 0;
+    ws->stamp = 0;
+    ws->flushes = 0;
+    ws->stmt_read_node = NULL;
+    ws->stmt_read_edge = NULL;
+    ws->stmt_read_face = NULL;
+    return ws;
+}
+
+static void
+ws_finalize_stmts (struct topo_working_set *ws)
+{
+/* finalizing the Working Set prepared statements */
+    if (ws->stmt_read_node != NULL)
+	sqlite3_finalize (ws->stmt_read_node);
+    if (ws->stmt_read_edge != NULL)
+	sqlite3_finalize (ws->stmt_read_edge);
+    if (ws->stmt_read_face != NULL)
+	sqlite3_finalize (ws->stmt_read_face);
+    ws->stmt_read_node = NULL;
+    ws->stmt_read_edge = NULL;
+    ws->stmt_read_face = NULL;
+}
+
+TOPOLOGY_PRIVATE void
+gaiatopo_free_working_set (void *working_set)
+{
+/* destroying a Working Set */
+    struct topo_working_set *ws = (struct topo_working_set *) working_set;
+    if (ws == NULL)
+	return;
+    ws_flush (ws);
+    ws_finalize_stmts (ws);
+    free (ws);
+}
+
+TOPOLOGY_PRIVATE void
+gaiatopo_reset_working_set (GaiaTopologyAccessorPtr accessor)
+{
+/* flushing the Working Set and finalizing its prepared statements */
+    struct gaia_topology *topo = (struct gaia_topology *) accessor;
+    struct topo_working_set *ws;
+    if (topo == NULL || topo->working_set == NULL)
+	return;
+    ws = (struct topo_working_set *) (topo->working_set);
+    ws_flush (ws);
+    ws_finalize_stmts (ws);
+}
+
+TOPOLOGY_PRIVATE void
+gaiatopo_flush_working_set (GaiaTopologyAccessorPtr accessor)
+{
+/* discarding all Nodes, Edges and Faces from the Working Set */
+    struct gaia_topology *topo = (struct gaia_topology *) accessor;
+    if (topo == NULL || topo->working_set == NULL)
+	return;
+    ws_flush ((struct topo_working_set *) (topo->working_set));
+}
+
+TOPOLOGY_PRIVATE void
+gaiatopo_flush_all_working_sets (const void *p_cache)
+{
+/* flushing the Working Sets of all Topologies registered into the Cache */
+    struct gaia_topology *p_topo;
+    struct splite_internal_cache *cache =
+	(struct splite_internal_cache *) p_cache;
+    if (cache == NULL)
+	return;
+    if (cache->magic1 != SPATIALITE_CACHE_MAGIC1
+	|| cache->magic2 != SPATIALITE_CACHE_MAGIC2)
+	return;
+
+    p_topo = (struct gaia_topology *) cache->firstTopology;
+    while (p_topo != NULL)
+      {
+	  gaiatopo_flush_working_set ((GaiaTopologyAccessorPtr) p_topo);
+	  p_topo = p_topo->next;
+      }
+}
+
 const char *
 callback_lastErrorMessage (const RTT_BE_DATA * be)
 {
@@ -1529,6 +2298,8 @@ callback_getNodeById (const RTT_BE_TOPOLOGY * rtt_topo,
     RTPOINT4D pt4d;
     struct topo_nodes_list *list = NULL;
     RTT_ISO_NODE *result = NULL;
+    struct topo_working_set *ws = NULL;
+    int read_fields = fields;
     if (accessor == NULL)
       {
 	  *numelems = -1;
@@ -1545,35 +2316,69 @@ callback_getNodeById (const RTT_BE_TOPOLOGY * rtt_topo,
     if (ctx == NULL)
 	return NULL;
 
-    /* preparing the SQL statement */
-    sql =
-	do_prepare_read_node (accessor->topology_name, fields, accessor->has_z);
-    ret =
-	sqlite3_prepare_v2 (accessor->db_handle, sql, strlen (sql), &stmt_aux,
-			    NULL);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
+    ws = get_working_set (accessor);
+    if (ws != NULL)
       {
-	  char *msg = sqlite3_mprintf ("Prepare_getNodeById AUX error: \"%s\"",
-				       sqlite3_errmsg (accessor->db_handle));
-	  gaiatopo_set_last_error_msg (topo, msg);
-	  sqlite3_free (msg);
-	  *numelems = -1;
-	  return NULL;
+	  /* reading all columns, so to feed the Working Set */
+	  read_fields = RTT_COL_NODE_ALL;
+	  stmt_aux = ws->stmt_read_node;
+      }
+    if (stmt_aux == NULL)
+      {
+	  /* preparing the SQL statement */
+	  sql =
+	      do_prepare_read_node (accessor->topology_name, read_fields,
+				    accessor->has_z);
+	  ret =
+	      sqlite3_prepare_v2 (accessor->db_handle, sql, strlen (sql),
+				  &stmt_aux, NULL);
+	  sqlite3_free (sql);
+	  if (ret != SQLITE_OK)
+	    {
+		char *msg =
+		    sqlite3_mprintf ("Prepare_getNodeById AUX error: \"%s\"",
+				     sqlite3_errmsg (accessor->db_handle));
+		gaiatopo_set_last_error_msg (topo, msg);
+		sqlite3_free (msg);
+		*numelems = -1;
+		return NULL;
+	    }
+	  if (ws != NULL)
+	      ws->stmt_read_node = stmt_aux;
       }
 
     list = create_nodes_list ();
     for (i = 0; i < *numelems; i++)
       {
 	  char *msg;
+	  int count = list->count;
+	  if (ws != NULL)
+	    {
+		struct topo_node *p_nd = ws_find (&(ws->nodes), *(ids + i));
+		if (p_nd != NULL)
+		  {
+		      /* found in the Working Set */
+		      if (p_nd->has_z)
+			  add_node_3D (list, p_nd->node_id,
+				       p_nd->containing_face, p_nd->x,
+				       p_nd->y, p_nd->z);
+		      else
+			  add_node_2D (list, p_nd->node_id,
+				       p_nd->containing_face, p_nd->x,
+				       p_nd->y);
+		      continue;
+		  }
+	    }
 	  if (!do_read_node
-	      (stmt_aux, list, *(ids + i), fields, accessor->has_z,
+	      (stmt_aux, list, *(ids + i), read_fields, accessor->has_z,
 	       "callback_getNodeById", &msg))
 	    {
 		gaiatopo_set_last_error_msg (topo, msg);
 		sqlite3_free (msg);
 		goto error;
 	    }
+	  if (ws != NULL && list->count > count)
+	      ws_cache_node (ws, list->last);
       }
 
     if (list->count == 0)
@@ -1610,12 +2415,13 @@ callback_getNodeById (const RTT_BE_TOPOLOGY * rtt_topo,
 	    }
 	  *numelems = list->count;
       }
-    sqlite3_finalize (stmt_aux);
+    if (ws == NULL)
+	sqlite3_finalize (stmt_aux);
     destroy_nodes_list (list);
     return result;
 
   error:
-    if (stmt_aux != NULL)
+    if (stmt_aux != NULL && ws == NULL)
 	sqlite3_finalize (stmt_aux);
     if (list != NULL)
 	destroy_nodes_list (list);
@@ -1930,6 +2736,7 @@ callback_getEdgeById (const RTT_BE_TOPOLOGY * rtt_topo,
     char *sql;
     struct topo_edges_list *list = NULL;
     RTT_ISO_EDGE *result = NULL;
+    struct topo_working_set *ws = NULL;
     if (accessor == NULL)
       {
 	  *numelems = -1;
@@ -1946,6 +2753,46 @@ callback_getEdgeById (const RTT_BE_TOPOLOGY * rtt_topo,
     if (ctx == NULL)
 	return NULL;
 
+    ws = get_working_set (accessor);
+    if (ws != NULL)
+      {
+	  /* reading from the Working Set */
+	  unsigned int stamp;
+	  unsigned int flushes;
+	  struct topo_ws_item *item;
+	  struct topo_edge *p_ed;
+	  char *msg;
+	  ws->stamp += 1;
+	  stamp = ws->stamp;
+	  flushes = ws->flushes;
+	  list = create_edges_list ();
+	  for (i = 0; i < *numelems; i++)
+	    {
+		if (!ws_fetch_edge
+		    (accessor, ws, *(ids + i), "callback_getEdgeById", &item,
+		     &msg))
+		  {
+		      gaiatopo_set_last_error_msg (topo, msg);
+		      sqlite3_free (msg);
+		      goto error;
+		  }
+		if (item == NULL)
+		    continue;
+		p_ed = (struct topo_edge *) (item->data);
+		if (ws->flushes != flushes)
+		  {
+		      /* the stamps are no longer reliable */
+		      if (ws_list_has_edge (list, p_ed->edge_id))
+			  continue;
+		  }
+		else if (item->mark_pos == stamp)
+		    continue;	/* already in the list */
+		item->mark_pos = stamp;
+		ws_append_edge (list, p_ed->edge_id, p_ed);
+	    }
+	  goto done;
+      }
+
     /* preparing the SQL statement */
     sql = do_prepare_read_edge (accessor->topology_name, fields);
     ret =
@@ -1976,6 +2823,7 @@ callback_getEdgeById (const RTT_BE_TOPOLOGY * rtt_topo,
 	    }
       }
 
+  done:
     if (list->count == 0)
       {
 	  /* no edge was found */
@@ -2014,12 +2862,13 @@ callback_getEdgeById (const RTT_BE_TOPOLOGY * rtt_topo,
 	    }
 	  *numelems = list->count;
       }
-    sqlite3_finalize (stmt_aux);
+    if (ws == NULL)
+	sqlite3_finalize (stmt_aux);
     destroy_edges_list (list);
     return result;
 
   error:
-    if (stmt_aux != NULL)
+    if (stmt_aux != NULL && ws == NULL)
 	sqlite3_finalize (stmt_aux);
     if (list != NULL)
 	destroy_edges_list (list);
@@ -2426,6 +3275,7 @@ callback_updateEdges (const RTT_BE_TOPOLOGY * rtt_topo,
     int changed = 0;
     if (accessor == NULL)
 	return -1;
+    ws_forget_edges (accessor, sel_edge, sel_fields);
 
     cache = (struct splite_internal_cache *) accessor->cache;
     if (cache == NULL)
@@ -2961,12 +3811,10 @@ callback_getFaceById (const RTT_BE_TOPOLOGY * rtt_topo,
     int ret;
     int i;
     char *sql;
-    char *prev;
-    char *table;
-    char *xtable;
-    int comma = 0;
     struct topo_faces_list *list = NULL;
     RTT_ISO_FACE *result = NULL;
+    struct topo_working_set *ws = NULL;
+    int read_fields = fields;
     if (accessor == NULL)
       {
 	  *numelems = -1;
@@ -2983,68 +3831,61 @@ callback_getFaceById (const RTT_BE_TOPOLOGY * rtt_topo,
     if (ctx == NULL)
 	return 0;
 
-    /* preparing the SQL statement */
-    sql = sqlite3_mprintf ("SELECT ");
-    prev = sql;
-    if (fields & RTT_COL_FACE_FACE_ID)
+    ws = get_working_set (accessor);
+    if (ws != NULL)
       {
-	  if (comma)
-	      sql = sqlite3_mprintf ("%s, face_id", prev);
-	  else
-	      sql = sqlite3_mprintf ("%s face_id", prev);
-	  comma = 1;
-	  sqlite3_free (prev);
-	  prev = sql;
+	  /* reading all columns, so to feed the Working Set */
+	  read_fields = RTT_COL_FACE_ALL;
+	  stmt_aux = ws->stmt_read_face;
       }
-    if (fields & RTT_COL_FACE_MBR)
-      {
-	  if (comma)
-	      sql =
-		  sqlite3_mprintf
-		  ("%s, MbrMinX(mbr), MbrMinY(mbr), MbrMaxX(mbr), MbrMaxY(mbr)",
-		   prev);
-	  else
-	      sql =
-		  sqlite3_mprintf
-		  ("%s MbrMinX(mbr), MbrMinY(mbr), MbrMaxX(mbr), MbrMaxY(mbr)",
-		   prev);
-	  comma = 1;
-	  sqlite3_free (prev);
-	  prev = sql;
-      }
-    table = sqlite3_mprintf ("%s_face", accessor->topology_name);
-    xtable = gaiaDoubleQuotedSql (table);
-    sqlite3_free (table);
-    sql =
-	sqlite3_mprintf ("%s FROM MAIN.\"%s\" WHERE face_id = ?", prev, xtable);
-    sqlite3_free (prev);
-    free (xtable);
-    ret =
-	sqlite3_prepare_v2 (accessor->db_handle, sql, strlen (sql), &stmt_aux,
-			    NULL);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
+    if (stmt_aux == NULL)
       {
-	  char *msg = sqlite3_mprintf ("Prepare_getFaceById AUX error: \"%s\"",
-				       sqlite3_errmsg (accessor->db_handle));
-	  gaiatopo_set_last_error_msg (topo, msg);
-	  sqlite3_free (msg);
-	  *numelems = -1;
-	  return NULL;
+	  /* preparing the SQL statement */
+	  sql = do_prepare_read_face (accessor->topology_name, read_fields);
+	  ret =
+	      sqlite3_prepare_v2 (accessor->db_handle, sql, strlen (sql),
+				  &stmt_aux, NULL);
+	  sqlite3_free (sql);
+	  if (ret != SQLITE_OK)
+	    {
+		char *msg =
+		    sqlite3_mprintf ("Prepare_getFaceById AUX error: \"%s\"",
+				     sqlite3_errmsg (accessor->db_handle));
+		gaiatopo_set_last_error_msg (topo, msg);
+		sqlite3_free (msg);
+		*numelems = -1;
+		return NULL;
+	    }
+	  if (ws != NULL)
+	      ws->stmt_read_face = stmt_aux;
       }
 
     list = create_faces_list ();
     for (i = 0; i < *numelems; i++)
       {
 	  char *msg;
+	  int count = list->count;
+	  if (ws != NULL && *(ids + i) > 0)
+	    {
+		struct topo_face *p_fc = ws_find (&(ws->faces), *(ids + i));
+		if (p_fc != NULL)
+		  {
+		      /* found in the Working Set */
+		      add_face (list, p_fc->id, p_fc->face_id, p_fc->minx,
+				p_fc->miny, p_fc->maxx, p_fc->maxy);
+		      continue;
+		  }
+	    }
 	  if (!do_read_face
-	      (stmt_aux, list, *(ids + i), fields, "callback_getFaceById",
+	      (stmt_aux, list, *(ids + i), read_fields, "callback_getFaceById",
 	       &msg))
 	    {
 		gaiatopo_set_last_error_msg (topo, msg);
 		sqlite3_free (msg);
 		goto error;
 	    }
+	  if (ws != NULL && *(ids + i) > 0 && list->count > count)
+	      ws_cache_face (ws, list->last);
       }
 
     if (list->count == 0)
@@ -3081,12 +3922,13 @@ callback_getFaceById (const RTT_BE_TOPOLOGY * rtt_topo,
 	    }
 	  *numelems = list->count;
       }
-    sqlite3_finalize (stmt_aux);
+    if (ws == NULL)
+	sqlite3_finalize (stmt_aux);
     destroy_faces_list (list);
     return result;
 
   error:
-    if (stmt_aux != NULL)
+    if (stmt_aux != NULL && ws == NULL)
 	sqlite3_finalize (stmt_aux);
     if (list != NULL)
 	destroy_faces_list (list);
@@ -3251,6 +4093,7 @@ callback_deleteEdges (const RTT_BE_TOPOLOGY * rtt_topo,
     int changed = 0;
     if (accessor == NULL)
 	return -1;
+    ws_forget_edges (accessor, sel_edge, sel_fields);
 
 /* composing the SQL prepared statement */
     table = sqlite3_mprintf ("%s_edge", accessor->topology_name);
@@ -4199,6 +5042,7 @@ callback_updateNodes (const RTT_BE_TOPOLOGY * rtt_topo,
     double z;
     if (accessor == NULL)
 	return -1;
+    ws_forget_nodes (accessor, sel_node, sel_fields);
 
     cache = (struct splite_internal_cache *) accessor->cache;
     if (cache == NULL)
@@ -4537,6 +5381,8 @@ callback_updateFacesById (const RTT_BE_TOPOLOGY * rtt_topo,
     int changed = 0;
     if (accessor == NULL)
 	return -1;
+    for (i = 0; i < numfaces; i++)
+	ws_forget_face (accessor, (faces + i)->face_id);
 
     stmt = accessor->stmt_updateFacesById;
     if (stmt == NULL)
@@ -4585,6 +5431,8 @@ callback_deleteFacesById (const RTT_BE_TOPOLOGY * rtt_topo,
     int changed = 0;
     if (accessor == NULL)
 	return -1;
+    for (i = 0; i < numelems; i++)
+	ws_forget_face (accessor, *(ids + i));
 
     stmt = accessor->stmt_deleteFacesById;
     if (stmt == NULL)
@@ -4633,6 +5481,8 @@ callback_deleteNodesById (const RTT_BE_TOPOLOGY * rtt_topo,
     int changed = 0;
     if (accessor == NULL)
 	return -1;
+    for (i = 0; i < numelems; i++)
+	ws_forget_node (accessor, *(ids + i));
 
     stmt = accessor->stmt_deleteNodesById;
     if (stmt == NULL)
@@ -4684,6 +5534,7 @@ callback_getRingEdges (const RTT_BE_TOPOLOGY * rtt_topo,
 
     struct topo_edges_list *list = NULL;
     RTT_ELEMID *result = NULL;
+    char *msg;
     if (accessor == NULL)
       {
 	  *numedges = -1;
@@ -4707,6 +5558,16 @@ callback_getRingEdges (const RTT_BE_TOPOLOGY * rtt_topo,
     if (ctx == NULL)
 	return NULL;
 
+    list = ws_get_ring_edges (accessor, edge, limit, &count, &msg);
+    if (list != NULL)
+	goto done;
+    if (msg != NULL)
+      {
+	  gaiatopo_set_last_error_msg (topo, msg);
+	  sqlite3_free (msg);
+	  goto error;
+      }
+
 /* setting up the prepared statement */
     sqlite3_reset (stmt);
     sqlite3_clear_bindings (stmt);
@@ -4742,6 +5603,7 @@ callback_getRingEdges (const RTT_BE_TOPOLOGY * rtt_topo,
 	    }
       }
 
+  done:
     if (limit < 0)
       {
 	  result = NULL;
@@ -4806,6 +5668,8 @@ callback_updateEdgesById (const RTT_BE_TOPOLOGY * rtt_topo,
     int tiny_point = 0;
     if (accessor == NULL)
 	return -1;
+    for (i = 0; i < numedges; i++)
+	ws_forget_edge (accessor, (edges + i)->edge_id);
 
     cache = (struct splite_internal_cache *) accessor->cache;
     if (cache == NULL)
@@ -5421,6 +6285,8 @@ callback_updateNodesById (const RTT_BE_TOPOLOGY * rtt_topo,
     int changed = 0;
     if (accessor == NULL)
 	return -1;
+    for (i = 0; i < numnodes; i++)
+	ws_forget_node (accessor, (nodes + i)->node_id);
 
     cache = (struct splite_internal_cache *) accessor->cache;
     if (cache == NULL)
@@ -91,6 +91,7 @@ struct gaia_topology
     sqlite3_stmt *stmt_getRingEdges;
     sqlite3_stmt *stmt_deleteFacesById;
     sqlite3_stmt *stmt_deleteNodesById;
+    void *working_set;
     void *callbacks;
     void *rtt_iface;
     void *rtt_topology;
@@ -277,6 +278,19 @@ create_topogeo_prepared_stmts (GaiaTopologyAccessorPtr accessor);
 
 TOPOLOGY_PRIVATE void finalize_all_topo_prepared_stmts (const void *cache);
 
+/* prototypes for functions handling the in-memory Working Set */
+TOPOLOGY_PRIVATE void *gaiatopo_create_working_set (void);
+
+TOPOLOGY_PRIVATE void gaiatopo_free_working_set (void *working_set);
+
+TOPOLOGY_PRIVATE void gaiatopo_reset_working_set (GaiaTopologyAccessorPtr
+						  accessor);
+
+TOPOLOGY_PRIVATE void gaiatopo_flush_working_set (GaiaTopologyAccessorPtr
+						  accessor);
+
+TOPOLOGY_PRIVATE void gaiatopo_flush_all_working_sets (const void *cache);
+
 TOPOLOGY_PRIVATE void create_all_topo_prepared_stmts (const void *cache);
 
 
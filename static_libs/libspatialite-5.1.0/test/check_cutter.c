@@ -2502,6 +2502,60 @@ create_blades_xy (sqlite3 * handle, int *retcode)
     return 1;
 }
 
+static int
+check_cutter_parallel (sqlite3 * handle, int *retcode)
+{
+/* testing ST_Cutter - parallel mode vs serial mode */
+    const char *inputs[] = { "polygs_xy", "polygs_xyz", "polygs_xym",
+	"polygs_xyzm", NULL
+    };
+    const char *blades[] = { "blades_xy", "blades_xyz", "blades_xym",
+	"blades_xyzm", NULL
+    };
+    char *sql;
+    int ret;
+    int i;
+    int j;
+
+    for (i = 0; inputs[i] != NULL; i++)
+      {
+	  for (j = 0; blades[j] != NULL; j++)
+	    {
+		/* cutting in parallel mode */
+		sql =
+		    sqlite3_mprintf
+		    ("SELECT ST_Cutter(NULL, '%s', 'geometry', NULL, '%s', NULL, "
+		     "'par_%s_%s', 1, 1, 3)", inputs[i], blades[j],
+		     inputs[i] + 7, blades[j] + 7);
+		ret = test_query (handle, sql);
+		sqlite3_free (sql);
+		if (!ret)
+		  {
+		      *retcode -= 1;
+		      return 0;
+		  }
+
+		/* the Output tables are expected to be identical */
+		sql =
+		    sqlite3_mprintf
+		    ("SELECT (SELECT Count(*) FROM (SELECT * FROM out_%s_%s "
+		     "EXCEPT SELECT * FROM par_%s_%s)) + (SELECT Count(*) FROM "
+		     "(SELECT * FROM par_%s_%s EXCEPT SELECT * FROM out_%s_%s)) "
+		     "= 0", inputs[i], blades[j] + 7, inputs[i] + 7,
+		     blades[j] + 7, inputs[i] + 7, blades[j] + 7, inputs[i],
+		     blades[j] + 7);
+		ret = test_query (handle, sql);
+		sqlite3_free (sql);
+		if (!ret)
+		  {
+		      *retcode -= 2;
+		      return 0;
+		  }
+	    }
+      }
+    return 1;
+}
+
 static int
 check_cutter_attached (int *retcode)
 {
@@ -2743,6 +2797,11 @@ main (int argc, char *argv[])
     if (!check_cutter_main (handle, &retcode))
 	return retcode;
 
+/* testing ST_Cutter - parallel mode */
+    retcode = -780;
+    if (!check_cutter_parallel (handle, &retcode))
+	return retcode;
+
     ret = sqlite3_close (handle);
     if (ret != SQLITE_OK)
       {
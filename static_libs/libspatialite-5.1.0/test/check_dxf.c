@@ -1395,6 +1395,182 @@ check_symbol_legacy (int cache_mode)
     return 0;
 }
 
+static int
+compare_streamed_tables (sqlite3 * handle)
+{
+/* comparing all "a_" tables (plain mode) against "b_" (streaming mode) */
+    int ret;
+    char **results;
+    int rows;
+    int columns;
+    int i;
+    int count_a;
+    int count_b;
+    const char *sql;
+
+    sql = "SELECT Sum(name LIKE 'a\\_%' ESCAPE '\\'), "
+	"Sum(name LIKE 'b\\_%' ESCAPE '\\') FROM sqlite_master WHERE type = 'table'";
+    ret = sqlite3_get_table (handle, sql, &results, &rows, &columns, NULL);
+    if (ret != SQLITE_OK || rows != 1)
+	return -1;
+    count_a = atoi (results[2]);
+    count_b = atoi (results[3]);
+    sqlite3_free_table (results);
+    if (count_a == 0 || count_a != count_b)
+      {
+	  fprintf (stderr, "streaming: %d tables, expected %d\n", count_b,
+		   count_a);
+	  return -2;
+      }
+
+    sql = "SELECT name FROM sqlite_master WHERE type = 'table' "
+	"AND name LIKE 'a\\_%' ESCAPE '\\'";
+    ret = sqlite3_get_table (handle, sql, &results, &rows, &columns, NULL);
+    if (ret != SQLITE_OK)
+	return -3;
+    for (i = 1; i <= rows; i++)
+      {
+	  const char *name = results[i] + 2;
+	  char **results2;
+	  int rows2;
+	  int columns2;
+	  char *cols;
+	  char *sql2 =
+	      sqlite3_mprintf ("SELECT group_concat('\"' || name || '\"') "
+			       "FROM pragma_table_info('a_%q') "
+			       "WHERE name NOT IN ('feature_id', 'attr_id')",
+			       name);
+	  ret =
+	      sqlite3_get_table (handle, sql2, &results2, &rows2, &columns2,
+				 NULL);
+	  sqlite3_free (sql2);
+	  if (ret != SQLITE_OK || rows2 != 1)
+	    {
+		sqlite3_free_table (results);
+		return -4;
+	    }
+	  cols = sqlite3_mprintf ("%s", results2[1]);
+	  sqlite3_free_table (results2);
+	  /* feature IDs depend on the writing order (MIXED mode) */
+	  sql2 =
+	      sqlite3_mprintf ("SELECT (SELECT Count(*) FROM \"a_%w\"), "
+			       "(SELECT Count(*) FROM \"b_%w\"), "
+			       "(SELECT Count(*) FROM (SELECT %s FROM \"a_%w\" "
+			       "EXCEPT SELECT %s FROM \"b_%w\"))", name, name,
+			       cols, name, cols, name);
+	  sqlite3_free (cols);
+	  ret =
+	      sqlite3_get_table (handle, sql2, &results2, &rows2, &columns2,
+				 NULL);
+	  sqlite3_free (sql2);
+	  if (ret != SQLITE_OK || rows2 != 1)
+	    {
+		fprintf (stderr, "streaming: unable to compare \"%s\"\n", name);
+		sqlite3_free_table (results);
+		return -4;
+	    }
+	  if (strcmp (results2[3], results2[4]) != 0
+	      || atoi (results2[5]) != 0)
+	    {
+		fprintf (stderr, "streaming: mismatching \"%s\"\n", name);
+		sqlite3_free_table (results2);
+		sqlite3_free_table (results);
+		return -5;
+	    }
+	  sqlite3_free_table (results2);
+      }
+    sqlite3_free_table (results);
+    return 0;
+}
+
+static int
+check_streaming (const char *path, int force_dims, int special_rings,
+		 int mode)
+{
+/* testing the streaming mode against the plain mode */
+    int ret;
+    sqlite3 *handle;
+    char *err_msg = NULL;
+    gaiaDxfParserPtr dxf;
+    void *cache = spatialite_alloc_connection ();
+
+    ret =
+	sqlite3_open_v2 (":memory:", &handle,
+			 SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "cannot open in-memory database: %s\n",
+		   sqlite3_errmsg (handle));
+	  sqlite3_close (handle);
+	  return -1;
+      }
+    spatialite_init_ex (handle, cache, 0);
+
+    ret =
+	sqlite3_exec (handle, "SELECT InitSpatialMetadataFull(1)", NULL, NULL,
+		      &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "InitSpatialMetadataFull() error: %s\n", err_msg);
+	  sqlite3_free (err_msg);
+	  sqlite3_close (handle);
+	  return -2;
+      }
+
+/* plain mode */
+    dxf = gaiaCreateDxfParser (3003, force_dims, "a_", NULL, special_rings);
+    ret = gaiaStreamDxfFile_r (cache, handle, dxf, path, mode, 0, 0);
+    gaiaDestroyDxfParser (dxf);
+    if (ret == 0)
+      {
+	  fprintf (stderr, "Unable to load \"%s\" plain\n", path);
+	  return -3;
+      }
+
+/* streaming mode: a single entity for each batch */
+    dxf = gaiaCreateDxfParser (3003, force_dims, "b_", NULL, special_rings);
+    ret = gaiaStreamDxfFile_r (cache, handle, dxf, path, mode, 0, 1);
+    gaiaDestroyDxfParser (dxf);
+    if (ret == 0)
+      {
+	  fprintf (stderr, "Unable to load \"%s\" streaming\n", path);
+	  return -4;
+      }
+
+    ret = compare_streamed_tables (handle);
+    if (ret != 0)
+      {
+	  fprintf (stderr, "\"%s\" streaming mismatch %d\n", path, ret);
+	  return -5;
+      }
+
+/* a parser can be used only a single time */
+    dxf = gaiaCreateDxfParser (3003, force_dims, "c_", NULL, special_rings);
+    ret = gaiaStreamDxfFile_r (cache, handle, dxf, path, mode, 0, 100);
+    if (ret == 0)
+      {
+	  fprintf (stderr, "Unable to load \"%s\" streaming\n", path);
+	  return -6;
+      }
+    ret = gaiaStreamDxfFile_r (cache, handle, dxf, path, mode, 1, 100);
+    gaiaDestroyDxfParser (dxf);
+    if (ret != 0)
+      {
+	  fprintf (stderr, "\"%s\" streaming: unexpected reuse\n", path);
+	  return -7;
+      }
+
+    ret = sqlite3_close (handle);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "sqlite3_close() error: %s\n",
+		   sqlite3_errmsg (handle));
+	  return -8;
+      }
+    spatialite_cleanup_ex (cache);
+    return 0;
+}
+
 #endif /* GEOS enabled */
 
 int
@@ -1453,6 +1629,32 @@ main (int argc, char *argv[])
 	      return -12;
       }
 
+    fprintf (stderr, "\n******* Testing DXF in streaming mode\n\n");
+    if (check_streaming
+	("./22.dxf", GAIA_DXF_AUTO_2D_3D, GAIA_DXF_RING_NONE,
+	 GAIA_DXF_IMPORT_BY_LAYER) != 0)
+	return -13;
+    if (check_streaming
+	("./22.dxf", GAIA_DXF_FORCE_3D, GAIA_DXF_RING_NONE,
+	 GAIA_DXF_IMPORT_MIXED) != 0)
+	return -14;
+    if (check_streaming
+	("./symbol.dxf", GAIA_DXF_AUTO_2D_3D, GAIA_DXF_RING_LINKED,
+	 GAIA_DXF_IMPORT_BY_LAYER) != 0)
+	return -15;
+    if (check_streaming
+	("./hatch.dxf", GAIA_DXF_AUTO_2D_3D, GAIA_DXF_RING_NONE,
+	 GAIA_DXF_IMPORT_MIXED) != 0)
+	return -16;
+    if (check_streaming
+	("./f06.dxf", GAIA_DXF_AUTO_2D_3D, GAIA_DXF_RING_UNLINKED,
+	 GAIA_DXF_IMPORT_BY_LAYER) != 0)
+	return -17;
+    if (check_streaming
+	("./archaic.dxf", GAIA_DXF_AUTO_2D_3D, GAIA_DXF_RING_NONE,
+	 GAIA_DXF_IMPORT_BY_LAYER) != 0)
+	return -18;
+
 #endif /* GEOS enabled */
 
     spatialite_shutdown ();
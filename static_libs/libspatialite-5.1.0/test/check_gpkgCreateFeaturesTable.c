@@ -57,6 +57,9 @@ main (int argc UNUSED, char *argv[]UNUSED)
     sqlite3 *db_handle = NULL;
     int ret;
     char *err_msg = NULL;
+    char **results;
+    int rows;
+    int columns;
     void *cache = spatialite_alloc_connection ();
 
     ret =
@@ -519,6 +522,140 @@ main (int argc UNUSED, char *argv[]UNUSED)
       }
     sqlite3_free (err_msg);
 
+    /* bulk loading the GPKG Spatial Index */
+    ret =
+	sqlite3_exec (db_handle,
+		      "CREATE TABLE bulkfeats (id INTEGER PRIMARY KEY, geom BLOB)",
+		      NULL, NULL, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Unexpected create bulkfeats table result: %i, (%s)\n",
+		   ret, err_msg);
+	  sqlite3_free (err_msg);
+	  return -250;
+      }
+    ret =
+	sqlite3_exec (db_handle,
+		      "WITH RECURSIVE c(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM c WHERE i < 999) "
+		      "INSERT INTO bulkfeats (geom) SELECT AsGPB(BuildMbr(i % 40, i / 40, "
+		      "(i % 40) + 0.5, (i / 40) + 0.5, 4326)) FROM c",
+		      NULL, NULL, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Unexpected populate bulkfeats table result: %i, (%s)\n",
+		   ret, err_msg);
+	  sqlite3_free (err_msg);
+	  return -251;
+      }
+    ret =
+	sqlite3_exec (db_handle,
+		      "INSERT INTO bulkfeats (geom) VALUES (NULL), (gpkgMakePoint(100, 200, 4326))",
+		      NULL, NULL, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Unexpected populate bulkfeats table result: %i, (%s)\n",
+		   ret, err_msg);
+	  sqlite3_free (err_msg);
+	  return -252;
+      }
+    ret =
+	sqlite3_exec (db_handle,
+		      "SELECT gpkgAddSpatialIndex('bulkfeats', 'geom')", NULL,
+		      NULL, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Unexpected gpkgAddSpatialIndex() result: %i, (%s)\n",
+		   ret, err_msg);
+	  sqlite3_free (err_msg);
+	  return -253;
+      }
+    ret =
+	sqlite3_exec (db_handle,
+		      "SELECT gpkgRebuildSpatialIndex('bulkfeats', 'geom')",
+		      NULL, NULL, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr,
+		   "Unexpected gpkgRebuildSpatialIndex() result: %i, (%s)\n",
+		   ret, err_msg);
+	  sqlite3_free (err_msg);
+	  return -254;
+      }
+    ret =
+	sqlite3_exec (db_handle,
+		      "INSERT INTO bulkfeats (geom) VALUES (gpkgMakePoint(-1, -2, 4326))",
+		      NULL, NULL, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Unexpected rtree trigger result: %i, (%s)\n", ret,
+		   err_msg);
+	  sqlite3_free (err_msg);
+	  return -255;
+      }
+    ret =
+	sqlite3_get_table (db_handle,
+			   "SELECT Count(*), Sum(r.minx > ST_MinX(b.geom) OR r.maxx < ST_MaxX(b.geom) "
+			   "OR r.miny > ST_MinY(b.geom) OR r.maxy < ST_MaxY(b.geom)) "
+			   "FROM rtree_bulkfeats_geom AS r JOIN bulkfeats AS b ON (r.id = b.id)",
+			   &results, &rows, &columns, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Error rtree check: %s\n", err_msg);
+	  sqlite3_free (err_msg);
+	  return -256;
+      }
+    if (rows != 1 || strcmp (results[columns + 0], "1002") != 0
+	|| strcmp (results[columns + 1], "0") != 0)
+      {
+	  fprintf (stderr, "Unexpected rtree content: %s / %s\n",
+		   results[columns + 0], results[columns + 1]);
+	  sqlite3_free_table (results);
+	  return -257;
+      }
+    sqlite3_free_table (results);
+    ret =
+	sqlite3_get_table (db_handle,
+			   "SELECT rtreecheck('rtree_bulkfeats_geom')",
+			   &results, &rows, &columns, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Error rtreecheck: %s\n", err_msg);
+	  sqlite3_free (err_msg);
+	  return -260;
+      }
+    if (rows != 1 || strcmp (results[columns + 0], "ok") != 0)
+      {
+	  fprintf (stderr, "Unexpected rtreecheck result: %s\n",
+		   results[columns + 0]);
+	  sqlite3_free_table (results);
+	  return -261;
+      }
+    sqlite3_free_table (results);
+    ret =
+	sqlite3_exec (db_handle,
+		      "SELECT gpkgRebuildSpatialIndex(1, 'geom')", NULL, NULL,
+		      &err_msg);
+    if (ret != SQLITE_ERROR)
+      {
+	  fprintf (stderr,
+		   "Expected error for gpkgRebuildSpatialIndex bad table type, got %i\n",
+		   ret);
+	  sqlite3_free (err_msg);
+	  return -258;
+      }
+    if (strcmp
+	(err_msg,
+	 "gpkgRebuildSpatialIndex() error: argument 1 [table] is not of the String type")
+	!= 0)
+      {
+	  fprintf (stderr,
+		   "Unexpected error message for gpkgRebuildSpatialIndex arg 1: %s\n",
+		   err_msg);
+	  sqlite3_free (err_msg);
+	  return -259;
+      }
+    sqlite3_free (err_msg);
+
     ret = sqlite3_close (db_handle);
     if (ret != SQLITE_OK)
       {
@@ -357,6 +357,58 @@ test_vtable (sqlite3 * handle, const char *table, int mode)
     return 0;
 }
 
+static int
+test_vtable_mbr (sqlite3 * handle, const char *table)
+{
+/* testing the VirtualGPKG MBR filter and the GPKG MBR functions */
+    char *sql;
+    int ret;
+    sqlite3_stmt *stmt = NULL;
+    int filtered;
+    int evaluated;
+    int amphibious;
+
+    sql = sqlite3_mprintf ("SELECT (SELECT Count(*) FROM vgpkg_%s "
+			   "WHERE MbrIntersects(geom, BuildMbr(1, 1, 21, 21))), "
+			   "(SELECT Count(*) FROM vgpkg_%s WHERE geom IS NULL "
+			   "OR MbrIntersects(geom, BuildMbr(1, 1, 21, 21)) = 1), "
+			   "(SELECT Count(*) FROM %s WHERE geom IS NULL "
+			   "OR MbrIntersects(geom, BuildMbr(1, 1, 21, 21)) = 1)",
+			   table, table, table);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "MBR filter \"vgpkg_%s\" error: %s\n", table,
+		   sqlite3_errmsg (handle));
+	  goto stop;
+      }
+    ret = sqlite3_step (stmt);
+    if (ret != SQLITE_ROW)
+      {
+	  fprintf (stderr, "MBR filter \"vgpkg_%s\" error: %s\n", table,
+		   sqlite3_errmsg (handle));
+	  goto stop;
+      }
+    filtered = sqlite3_column_int (stmt, 0);
+    evaluated = sqlite3_column_int (stmt, 1);
+    amphibious = sqlite3_column_int (stmt, 2);
+    if (filtered != evaluated || filtered != amphibious)
+      {
+	  fprintf (stderr,
+		   "Unexpected MBR filter \"vgpkg_%s\": %d, %d, %d\n", table,
+		   filtered, evaluated, amphibious);
+	  goto stop;
+      }
+    sqlite3_finalize (stmt);
+    return 1;
+
+  stop:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    return 0;
+}
+
 static int
 test_vtable_out (sqlite3 * handle)
 {
@@ -652,6 +704,69 @@ main (int argc, char *argv[])
 	  return -1;
       }
 
+/* testing the MBR filters: GPKG geometries are accepted in amphibious mode */
+    sql = "SELECT EnableGpkgAmphibiousMode()";
+    ret = sqlite3_exec (db_handle, sql, NULL, NULL, &sql_err);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "EnableGpkgAmphibiousMode error: %s\n", sql_err);
+	  sqlite3_free (sql_err);
+	  do_unlink_all ();
+	  sqlite3_close (db_handle);
+	  spatialite_cleanup_ex (cache);
+	  spatialite_shutdown ();
+	  return -1;
+      }
+
+    if (!test_vtable_mbr (db_handle, "pt2d"))
+      {
+	  do_unlink_all ();
+	  sqlite3_close (db_handle);
+	  spatialite_cleanup_ex (cache);
+	  spatialite_shutdown ();
+	  return -1;
+      }
+
+    if (!test_vtable_mbr (db_handle, "ln3dz"))
+      {
+	  do_unlink_all ();
+	  sqlite3_close (db_handle);
+	  spatialite_cleanup_ex (cache);
+	  spatialite_shutdown ();
+	  return -1;
+      }
+
+    if (!test_vtable_mbr (db_handle, "mpg3dz"))
+      {
+	  do_unlink_all ();
+	  sqlite3_close (db_handle);
+	  spatialite_cleanup_ex (cache);
+	  spatialite_shutdown ();
+	  return -1;
+      }
+
+    if (!test_vtable_mbr (db_handle, "gc3dz"))
+      {
+	  do_unlink_all ();
+	  sqlite3_close (db_handle);
+	  spatialite_cleanup_ex (cache);
+	  spatialite_shutdown ();
+	  return -1;
+      }
+
+    sql = "SELECT DisableGpkgAmphibiousMode()";
+    ret = sqlite3_exec (db_handle, sql, NULL, NULL, &sql_err);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "DisableGpkgAmphibiousMode error: %s\n", sql_err);
+	  sqlite3_free (sql_err);
+	  do_unlink_all ();
+	  sqlite3_close (db_handle);
+	  spatialite_cleanup_ex (cache);
+	  spatialite_shutdown ();
+	  return -1;
+      }
+
     if (!test_vtable_out (db_handle))
       {
 	  do_unlink_all ();
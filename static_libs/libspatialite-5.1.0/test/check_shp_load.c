@@ -53,6 +53,137 @@ the terms of any one of the MPL, the GPL or the LGPL.
 
 #ifndef OMIT_ICONV		/* only if ICONV is supported */
 
+#ifndef OMIT_GEOS		/* only if GEOS is supported */
+
+static int
+query_int (sqlite3 * handle, const char *sql, int *value)
+{
+/* executing an SQL query returning a single INTEGER value */
+    int ret;
+    int rows;
+    int columns;
+    char **results;
+    char *err_msg = NULL;
+
+    ret = sqlite3_get_table (handle, sql, &results, &rows, &columns, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Error: %s\n%s\n", sql, err_msg);
+	  sqlite3_free (err_msg);
+	  return 0;
+      }
+    if (rows != 1 || columns != 1 || results[1] == NULL)
+      {
+	  fprintf (stderr, "Unexpected result: %s\n", sql);
+	  sqlite3_free_table (results);
+	  return 0;
+      }
+    *value = atoi (results[1]);
+    sqlite3_free_table (results);
+    return 1;
+}
+
+static int
+do_test_table (sqlite3 * handle, const void *p_cache)
+{
+/* testing table-level validation in parallel mode */
+    int ret;
+    int value;
+    int n_invalids = -1;
+    int n_repaired = -1;
+    int n_failures = -1;
+    char *err_msg = NULL;
+    const char *sql;
+
+    sql = "SELECT AddGeometryColumn('vt', 'geom', 4326, 'MULTIPOLYGON', 'XY')";
+    ret = sqlite3_exec (handle, "CREATE TABLE vt (id INTEGER PRIMARY KEY)",
+			NULL, NULL, &err_msg);
+    if (ret == SQLITE_OK)
+	ret = sqlite3_exec (handle, sql, NULL, NULL, &err_msg);
+    if (ret == SQLITE_OK)
+	ret =
+	    sqlite3_exec (handle,
+			  "WITH RECURSIVE c(i) AS (SELECT 1 UNION ALL "
+			  "SELECT i + 1 FROM c WHERE i < 200) "
+			  "INSERT INTO vt (id, geom) SELECT i, CASE "
+			  "WHEN i % 10 = 0 THEN MPolyFromText('MULTIPOLYGON((("
+			  "0 0, 10 10, 10 0, 0 10, 0 0)))', 4326) "
+			  "WHEN i % 7 = 0 THEN NULL "
+			  "ELSE CastToMulti(BuildMbr(i, 0, i + 1, 1, 4326)) "
+			  "END FROM c", NULL, NULL, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "populating vt error: %s\n", err_msg);
+	  sqlite3_free (err_msg);
+	  return -11;
+      }
+
+    if (!query_int
+	(handle, "SELECT CheckGeometryTable('vt', 'geom', 'vt_check1', 1)",
+	 &value) || value != 20)
+      {
+	  fprintf (stderr, "CheckGeometryTable(threads=1) unexpected %d\n",
+		   value);
+	  return -12;
+      }
+    if (!query_int
+	(handle, "SELECT CheckGeometryTable('vt', 'geom', 'vt_check3', 3)",
+	 &value) || value != 20)
+      {
+	  fprintf (stderr, "CheckGeometryTable(threads=3) unexpected %d\n",
+		   value);
+	  return -13;
+      }
+    if (!query_int
+	(handle,
+	 "SELECT Count(*) FROM (SELECT * FROM vt_check1 EXCEPT "
+	 "SELECT * FROM vt_check3)", &value) || value != 0)
+      {
+	  fprintf (stderr, "CheckGeometryTable: mismatching reports\n");
+	  return -14;
+      }
+    if (!query_int
+	(handle, "SELECT CheckGeometryTable('vt', 'none', 'vt_check0')",
+	 &value) || value != -1)
+      {
+	  fprintf (stderr, "CheckGeometryTable(bad column) unexpected %d\n",
+		   value);
+	  return -15;
+      }
+
+#if defined(ENABLE_RTTOPO) || defined(GEOS_3100)
+    ret =
+	sanitize_geometry_table_r (p_cache, handle, "vt", "geom", "vt_fix",
+				   NULL, 1, 3, &n_invalids, &n_repaired,
+				   &n_failures, &err_msg);
+    if (!ret)
+      {
+	  fprintf (stderr, "sanitize_geometry_table_r() error: %s\n",
+		   err_msg);
+	  free (err_msg);
+	  return -16;
+      }
+    if (n_invalids != 20 || n_repaired != 20 || n_failures != 0)
+      {
+	  fprintf (stderr,
+		   "sanitize_geometry_table_r() unexpected %d/%d/%d\n",
+		   n_invalids, n_repaired, n_failures);
+	  return -17;
+      }
+    if (!query_int
+	(handle, "SELECT CheckGeometryTable('vt', 'geom', 'vt_check4', 2)",
+	 &value) || value != 0)
+      {
+	  fprintf (stderr, "CheckGeometryTable(repaired) unexpected %d\n",
+		   value);
+	  return -18;
+      }
+#endif
+    return 0;
+}
+
+#endif /* end GEOS conditionals */
+
 static int
 do_test (sqlite3 * handle, const void *p_cache)
 {
@@ -147,6 +278,18 @@ do_test (sqlite3 * handle, const void *p_cache)
       }
 
 #endif /* end RTTOPO conditionals */
+
+#ifndef OMIT_GEOS		/* only if GEOS is supported */
+    if (p_cache != NULL)
+      {
+	  ret = do_test_table (handle, p_cache);
+	  if (ret != 0)
+	    {
+		sqlite3_close (handle);
+		return ret;
+	    }
+      }
+#endif
     return 0;
 }
 
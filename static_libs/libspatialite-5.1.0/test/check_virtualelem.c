@@ -74,6 +74,45 @@ create_table (sqlite3 * sqlite, const char *table)
     return 1;
 }
 
+static int
+test_parts (sqlite3 * sqlite, const char *table)
+{
+/* testing ST_ElementaryParts() against ElementaryGeometries */
+    int ret;
+    char *sql;
+    char **results;
+    int rows;
+    int columns;
+    int count;
+    int equal;
+
+    sql = sqlite3_mprintf ("SELECT Count(*), (SELECT group_concat(hex(p.geometry)) "
+			   "FROM %s AS t, ST_ElementaryParts(t.geom) AS p) = "
+			   "(SELECT group_concat(hex(e.geometry)) FROM %s AS t "
+			   "JOIN ElementaryGeometries AS e ON "
+			   "(e.f_table_name = %Q AND e.origin_rowid = t.ROWID)) "
+			   "FROM %s AS t, ST_ElementaryParts(t.geom) AS p",
+			   table, table, table, table);
+    ret = sqlite3_get_table (sqlite, sql, &results, &rows, &columns, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK || rows != 1 || results[3] == NULL)
+      {
+	  fprintf (stderr, "ST_ElementaryParts \"%s\": \"%s\"\n", table,
+		   sqlite3_errmsg (sqlite));
+	  return 0;
+      }
+    count = atoi (results[2]);
+    equal = atoi (results[3]);
+    sqlite3_free_table (results);
+    if (count != 6 || equal != 1)
+      {
+	  fprintf (stderr, "Unexpected ST_ElementaryParts \"%s\": %d %d\n",
+		   table, count, equal);
+	  return 0;
+      }
+    return 1;
+}
+
 static int
 test_table (sqlite3 * sqlite, const char *prefix, const char *table,
 	    const char *column)
@@ -172,7 +211,7 @@ test_table (sqlite3 * sqlite, const char *prefix, const char *table,
 	  row_no++;
       }
     sqlite3_finalize (stmt);
-    return 1;
+    return test_parts (sqlite, table);
 
   error:
     if (stmt != NULL)
@@ -1012,6 +1051,114 @@ test_polygon_xyzm (sqlite3 * sqlite)
     return 1;
 }
 
+#ifdef ENABLE_RTTOPO		/* only if RTTOPO is enabled */
+static int
+test_subdivide_table (sqlite3 * sqlite, int threads)
+{
+/* testing ST_SubdivideTable() against ST_SubdivideParts() */
+    int ret;
+    char *sql;
+    char **results;
+    int rows;
+    int columns;
+    int count;
+    int equal;
+    int expected;
+
+    ret =
+	sqlite3_get_table (sqlite,
+			   "SELECT Sum(ST_NumGeometries(ST_Subdivide(geom, 32))) "
+			   "FROM subdiv", &results, &rows, &columns, NULL);
+    if (ret != SQLITE_OK || rows != 1 || results[1] == NULL)
+      {
+	  fprintf (stderr, "ST_Subdivide: \"%s\"\n", sqlite3_errmsg (sqlite));
+	  return 0;
+      }
+    expected = atoi (results[1]);
+    sqlite3_free_table (results);
+
+    sql = sqlite3_mprintf ("SELECT Count(*), Sum(s.geometry = p.geometry) "
+			   "FROM ST_SubdivideTable(NULL, 'subdiv', 'geom', 32, %d) AS s "
+			   "JOIN (SELECT t.ROWID AS rid, x.item_no AS item_no, "
+			   "x.geometry AS geometry FROM subdiv AS t, "
+			   "ST_SubdivideParts(t.geom, 32) AS x) AS p "
+			   "ON (p.rid = s.origin_rowid AND p.item_no = s.item_no)",
+			   threads);
+    ret = sqlite3_get_table (sqlite, sql, &results, &rows, &columns, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK || rows != 1 || results[3] == NULL)
+      {
+	  fprintf (stderr, "ST_SubdivideTable: \"%s\"\n",
+		   sqlite3_errmsg (sqlite));
+	  return 0;
+      }
+    count = atoi (results[2]);
+    equal = atoi (results[3]);
+    sqlite3_free_table (results);
+    if (count != expected || equal != expected || expected <= 20)
+      {
+	  fprintf (stderr,
+		   "Unexpected ST_SubdivideTable (threads=%d): %d %d %d\n",
+		   threads, count, equal, expected);
+	  return 0;
+      }
+    return 1;
+}
+
+static int
+test_subdivide (sqlite3 * sqlite)
+{
+/* testing the ST_SubdivideTable() table-valued function */
+    int ret;
+    char *err_msg = NULL;
+
+    ret = create_table (sqlite, "subdiv");
+    if (!ret)
+	return 0;
+    ret =
+	sqlite3_exec (sqlite,
+		      "SELECT AddGeometryColumn('subdiv', 'geom', 4326, "
+		      "'POLYGON', 'XY')", NULL, NULL, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "AddGeometryColumn \"subdiv\" error: %s\n",
+		   err_msg);
+	  sqlite3_free (err_msg);
+	  return 0;
+      }
+    ret =
+	sqlite3_exec (sqlite,
+		      "INSERT INTO subdiv (id, name, geom) "
+		      "WITH RECURSIVE c(i) AS (SELECT 1 UNION ALL "
+		      "SELECT i + 1 FROM c WHERE i < 20) "
+		      "SELECT NULL, 'circle', MakePolygon(MakeCircle(i * 10, 0, "
+		      "4, 4326, 1)) FROM c", NULL, NULL, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "INSERT INTO \"subdiv\" error: %s\n", err_msg);
+	  sqlite3_free (err_msg);
+	  return 0;
+      }
+    ret =
+	sqlite3_exec (sqlite,
+		      "INSERT INTO subdiv (id, name, geom) "
+		      "VALUES (NULL, 'null', NULL)", NULL, NULL, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "INSERT INTO \"subdiv\" error: %s\n", err_msg);
+	  sqlite3_free (err_msg);
+	  return 0;
+      }
+
+/* sequential and parallel modes */
+    if (!test_subdivide_table (sqlite, 1))
+	return 0;
+    if (!test_subdivide_table (sqlite, 3))
+	return 0;
+    return 1;
+}
+#endif /* end RTTOPO conditional */
+
 int
 main (int argc, char *argv[])
 {
@@ -1126,6 +1273,16 @@ main (int argc, char *argv[])
 	  return -14;
       }
 
+#ifdef ENABLE_RTTOPO		/* only if RTTOPO is enabled */
+/* Testing ST_SubdivideTable() */
+    ret = test_subdivide (db_handle);
+    if (!ret)
+      {
+	  sqlite3_close (db_handle);
+	  return -15;
+      }
+#endif /* end RTTOPO conditional */
+
     sqlite3_close (db_handle);
     spatialite_cleanup_ex (cache);
     spatialite_shutdown ();
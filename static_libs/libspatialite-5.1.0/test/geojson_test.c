@@ -50,6 +50,112 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include "sqlite3.h"
 #include "spatialite.h"
 
+static int
+do_count (sqlite3 * handle, const char *sql, int *count)
+{
+/* executing a SELECT Count(*) query */
+    int ret;
+    int i;
+    char **results;
+    int rows;
+    int columns;
+    char *err_msg = NULL;
+
+    ret = sqlite3_get_table (handle, sql, &results, &rows, &columns, &err_msg);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "%s error: %s\n", sql, err_msg);
+	  sqlite3_free (err_msg);
+	  return 0;
+      }
+    *count = -1;
+    for (i = 1; i <= rows; i++)
+	*count = atoi (results[(i * columns) + 0]);
+    sqlite3_free_table (results);
+    return 1;
+}
+
+static int
+do_test_virtual (sqlite3 * handle)
+{
+/* testing VirtualGeoJSON - first parsing, then reusing the Features index */
+    int ret;
+    int pass;
+    int count;
+    char *err_msg = NULL;
+
+    remove ("./test.geojson.gjidx");
+    for (pass = 0; pass < 2; pass++)
+      {
+	  ret =
+	      sqlite3_exec (handle,
+			    "CREATE VIRTUAL TABLE vgeojson USING VirtualGeoJSON('./test.geojson')",
+			    NULL, NULL, &err_msg);
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr, "VirtualGeoJSON #%d error: %s\n", pass,
+			 err_msg);
+		sqlite3_free (err_msg);
+		return -1;
+	    }
+	  if (pass == 0)
+	    {
+		/* the Features index is expected to be already there */
+		FILE *idx = fopen ("./test.geojson.gjidx", "rb");
+		if (idx == NULL)
+		  {
+		      fprintf (stderr, "VirtualGeoJSON: missing index\n");
+		      return -9;
+		  }
+		fclose (idx);
+	    }
+	  if (!do_count (handle, "SELECT Count(*) FROM vgeojson", &count))
+	      return -2;
+	  if (count != 19)
+	    {
+		fprintf (stderr, "VirtualGeoJSON #%d: unexpected %d rows\n",
+			 pass, count);
+		return -3;
+	    }
+	  if (!do_count
+	      (handle,
+	       "SELECT Count(*) FROM vgeojson WHERE "
+	       "MbrIntersects(geometry, BuildMbr(0, 45, 10, 55))", &count))
+	      return -4;
+	  if (count != 7)
+	    {
+		fprintf (stderr,
+			 "VirtualGeoJSON #%d: unexpected %d rows (MBR)\n",
+			 pass, count);
+		return -5;
+	    }
+	  if (!do_count
+	      (handle,
+	       "SELECT Count(*) FROM vgeojson WHERE name = 'Paris' AND "
+	       "MbrIntersects(geometry, BuildMbr(2, 48, 3, 49)) = 1", &count))
+	      return -6;
+	  if (count != 1)
+	    {
+		fprintf (stderr,
+			 "VirtualGeoJSON #%d: unexpected %d rows (Paris)\n",
+			 pass, count);
+		return -7;
+	    }
+	  ret =
+	      sqlite3_exec (handle, "DROP TABLE vgeojson", NULL, NULL,
+			    &err_msg);
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr, "DROP VirtualGeoJSON #%d error: %s\n", pass,
+			 err_msg);
+		sqlite3_free (err_msg);
+		return -8;
+	    }
+      }
+    remove ("./test.geojson.gjidx");
+    return 0;
+}
+
 static int
 do_test (sqlite3 * handle)
 {
@@ -128,6 +234,15 @@ do_test (sqlite3 * handle)
 	  return -7;
       }
 
+/* testing VirtualGeoJSON */
+    ret = do_test_virtual (handle);
+    if (ret != 0)
+      {
+	  fprintf (stderr, "VirtualGeoJSON error %d\n", ret);
+	  sqlite3_close (handle);
+	  return -8;
+      }
+
     return 0;
 }
 
@@ -1141,6 +1141,209 @@ do_test (sqlite3 * handle, const char *base_name, int srid, int has_z,
     return 0;
 }
 
+static int
+do_shared_route (sqlite3 * handle, double *cost)
+{
+/* computing a Shortest Path on some already existing VirtualRouting */
+    const char *sql;
+    sqlite3_stmt *stmt = NULL;
+    int ret;
+    int count = 0;
+
+    sql = "SELECT Role, Cost FROM test_3003_2d_iyyy "
+	"WHERE NodeFrom = 273 AND NodeTo = 352";
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Shared Routing #1: %s\n", sqlite3_errmsg (handle));
+	  return 0;
+      }
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	    {
+		const char *role =
+		    (const char *) sqlite3_column_text (stmt, 0);
+		if (strcmp (role, "Route") == 0)
+		  {
+		      *cost = sqlite3_column_double (stmt, 1);
+		      count++;
+		  }
+	    }
+	  else
+	    {
+		fprintf (stderr, "Shared Routing #2: %s\n",
+			 sqlite3_errmsg (handle));
+		count = 0;
+		break;
+	    }
+      }
+    sqlite3_finalize (stmt);
+    return count;
+}
+
+static int
+do_test_shared (sqlite3 * handle)
+{
+/* testing many connections sharing the same NETWORK */
+    sqlite3 *handle2;
+    sqlite3 *handle3;
+    void *cache2 = spatialite_alloc_connection ();
+    void *cache3 = spatialite_alloc_connection ();
+    double cost1 = 0.0;
+    double cost2 = 0.0;
+    double cost3 = 0.0;
+    int ret;
+    int result = 0;
+
+    ret =
+	sqlite3_open_v2 ("copy-orbetello.sqlite", &handle2,
+			 SQLITE_OPEN_READWRITE, NULL);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "cannot open copy-orbetello.sqlite #2: %s\n",
+		   sqlite3_errmsg (handle2));
+	  sqlite3_close (handle2);
+	  return -1;
+      }
+    spatialite_init_ex (handle2, cache2, 0);
+    ret =
+	sqlite3_open_v2 ("copy-orbetello.sqlite", &handle3,
+			 SQLITE_OPEN_READWRITE, NULL);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "cannot open copy-orbetello.sqlite #3: %s\n",
+		   sqlite3_errmsg (handle3));
+	  sqlite3_close (handle3);
+	  sqlite3_close (handle2);
+	  return -2;
+      }
+    spatialite_init_ex (handle3, cache3, 0);
+
+    ret =
+	sqlite3_exec (handle,
+		      "UPDATE test_3003_2d_iyyy SET Algorithm = 'DIJKSTRA', "
+		      "Request = 'SHORTEST PATH', Options = 'FULL'", NULL, NULL,
+		      NULL);
+    if (ret != SQLITE_OK)
+	result = -9;
+    else if (do_shared_route (handle, &cost1) <= 0)
+	result = -3;
+    else if (do_shared_route (handle2, &cost2) <= 0)
+	result = -4;
+    else if (do_shared_route (handle3, &cost3) <= 0)
+	result = -5;
+    else if (cost1 != cost2 || cost1 != cost3)
+      {
+	  fprintf (stderr, "Shared Routing: mismatching costs %f %f %f\n",
+		   cost1, cost2, cost3);
+	  result = -6;
+      }
+
+/* the NETWORK must survive any other connection being closed */
+    sqlite3_close (handle2);
+    spatialite_cleanup_ex (cache2);
+    if (result == 0)
+      {
+	  cost3 = 0.0;
+	  if (do_shared_route (handle3, &cost3) <= 0)
+	      result = -7;
+	  else if (cost1 != cost3)
+	      result = -8;
+      }
+    sqlite3_close (handle3);
+    spatialite_cleanup_ex (cache3);
+    return result;
+}
+
+static int
+do_test_matrix (sqlite3 * handle)
+{
+/* testing a many-to-many Cost Matrix */
+    const char *sql;
+    sqlite3_stmt *stmt = NULL;
+    double route_cost = 0.0;
+    int ret;
+    int count = 0;
+    int result = 0;
+
+    ret =
+	sqlite3_exec (handle,
+		      "UPDATE test_3003_2d_iyyy SET Algorithm = 'DIJKSTRA', "
+		      "Request = 'SHORTEST PATH', Options = 'FULL'", NULL, NULL,
+		      NULL);
+    if (ret != SQLITE_OK)
+	return -1;
+    if (do_shared_route (handle, &route_cost) <= 0)
+	return -2;
+    ret =
+	sqlite3_exec (handle,
+		      "UPDATE test_3003_2d_iyyy SET Request = 'MATRIX'", NULL,
+		      NULL, NULL);
+    if (ret != SQLITE_OK)
+	return -3;
+
+    sql = "SELECT RouteId, RouteRow, Role, NodeFrom, NodeTo, Cost "
+	"FROM test_3003_2d_iyyy WHERE NodeFrom = '273,352' "
+	"AND NodeTo = '352,273,999999'";
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Matrix #1: %s\n", sqlite3_errmsg (handle));
+	  return -4;
+      }
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	    {
+		int from = sqlite3_column_int (stmt, 0);
+		int to = sqlite3_column_int (stmt, 1);
+		const char *role = (const char *) sqlite3_column_text (stmt, 2);
+		if (from != count / 3 || to != count % 3)
+		    result = -5;
+		else if (to == 2)
+		  {
+		      if (strcmp (role, "Undefined NodeTo") != 0
+			  || sqlite3_column_type (stmt, 5) != SQLITE_NULL)
+			  result = -6;
+		  }
+		else if (strcmp (role, "Matrix") != 0)
+		    result = -7;
+		else if (from == 0 && to == 0
+			 && sqlite3_column_double (stmt, 5) != route_cost)
+		    result = -8;
+		else if (from != to && sqlite3_column_double (stmt, 5) != 0.0)
+		    result = -9;
+		count++;
+	    }
+	  else
+	    {
+		fprintf (stderr, "Matrix #2: %s\n", sqlite3_errmsg (handle));
+		result = -10;
+		break;
+	    }
+      }
+    sqlite3_finalize (stmt);
+    if (result == 0 && count != 6)
+	result = -11;
+    if (result != 0)
+	fprintf (stderr, "Matrix: unexpected results (%d rows)\n", count);
+
+    ret =
+	sqlite3_exec (handle,
+		      "UPDATE test_3003_2d_iyyy SET Request = 'SHORTEST PATH'",
+		      NULL, NULL, NULL);
+    if (ret != SQLITE_OK && result == 0)
+	result = -12;
+    return result;
+}
+
 #endif
 
 int
@@ -1505,6 +1708,22 @@ main (int argc, char *argv[])
 	  return -45;
       }
 
+/* testing many connections sharing the same NETWORK */
+    ret = do_test_shared (handle);
+    if (ret != 0)
+      {
+	  fprintf (stderr, "Test Shared NETWORK error %d\n", ret);
+	  return -46;
+      }
+
+/* testing a many-to-many Cost Matrix */
+    ret = do_test_matrix (handle);
+    if (ret != 0)
+      {
+	  fprintf (stderr, "Test Cost Matrix error %d\n", ret);
+	  return -48;
+      }
+
 /* testing invalid cases */
     ret = do_test_invalid (handle);
     if (ret != 0)